@@ -0,0 +1,216 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Extracts per-dispatch aggregate statistics from a .tracy capture.
+//
+// Zones are aggregated by name (the names injected from executable debug
+// info) across the entire capture and emitted either as a ranked statistics
+// table or in Brendan Gregg collapsed-stack format for flamegraph/pprof
+// tooling. GPU zones additionally report the queue latency between host
+// submission and device execution.
+//
+// Usage:
+//   iree-tracy-extract capture.tracy
+//   iree-tracy-extract --format=collapsed --filter=_dispatch_ capture.tracy |
+//       flamegraph.pl > dispatches.svg
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../../third_party/tracy/server/TracyFileRead.hpp"
+#include "../../../third_party/tracy/server/TracyWorker.hpp"
+
+namespace {
+
+struct ZoneStatistics {
+  int64_t count = 0;
+  int64_t total_ns = 0;
+  int64_t min_ns = INT64_MAX;
+  int64_t max_ns = 0;
+  // GPU zones only: sum of (device begin - host submit) across invocations.
+  int64_t total_queue_gap_ns = 0;
+  int64_t queue_gap_count = 0;
+
+  void AddInvocation(int64_t duration_ns) {
+    ++count;
+    total_ns += duration_ns;
+    min_ns = std::min(min_ns, duration_ns);
+    max_ns = std::max(max_ns, duration_ns);
+  }
+};
+
+using ZoneStatisticsMap = std::map<std::string, ZoneStatistics>;
+
+bool MatchesFilter(const char* name, const char* filter) {
+  return !filter || strstr(name, filter) != nullptr;
+}
+
+// Aggregates all CPU zones by source location name.
+void AggregateCpuZones(const tracy::Worker& worker, const char* filter,
+                       ZoneStatisticsMap& statistics_map) {
+  for (const auto& pair : worker.GetSourceLocationZones()) {
+    const auto& srcloc = worker.GetSourceLocation(pair.first);
+    const char* name =
+        worker.GetString(srcloc.name.active ? srcloc.name : srcloc.function);
+    if (!MatchesFilter(name, filter)) continue;
+    auto& statistics = statistics_map[name];
+    for (const auto& zone_data : pair.second.zones) {
+      const auto& zone = *zone_data.Zone();
+      const int64_t end = worker.GetZoneEnd(zone);
+      if (end <= zone.Start()) continue;  // incomplete zone at capture end
+      statistics.AddInvocation(end - zone.Start());
+    }
+  }
+}
+
+// Aggregates a GPU zone timeline (and children) by zone name.
+// GPU zones carry both host-side submission and device-side execution
+// timestamps letting us report the queue gap alongside execution time.
+template <typename TimelineT>
+void AggregateGpuTimeline(const tracy::Worker& worker,
+                          const TimelineT& timeline, const char* filter,
+                          ZoneStatisticsMap& statistics_map) {
+  for (const auto& event_ptr : timeline) {
+    const auto& event = *event_ptr;
+    if (event.GpuEnd() < 0) continue;  // still in flight at capture end
+    const auto& srcloc = worker.GetSourceLocation(event.SrcLoc());
+    const char* name =
+        worker.GetString(srcloc.name.active ? srcloc.name : srcloc.function);
+    if (MatchesFilter(name, filter)) {
+      auto& statistics = statistics_map[name];
+      statistics.AddInvocation(event.GpuEnd() - event.GpuStart());
+      if (event.CpuStart() >= 0 && event.GpuStart() >= event.CpuStart()) {
+        statistics.total_queue_gap_ns += event.GpuStart() - event.CpuStart();
+        ++statistics.queue_gap_count;
+      }
+    }
+    if (event.Child() >= 0) {
+      AggregateGpuTimeline(worker, worker.GetGpuChildren(event.Child()),
+                           filter, statistics_map);
+    }
+  }
+}
+
+void AggregateGpuZones(const tracy::Worker& worker, const char* filter,
+                       ZoneStatisticsMap& statistics_map) {
+  for (const auto* ctx : worker.GetGpuData()) {
+    for (const auto& thread_data : ctx->threadData) {
+      AggregateGpuTimeline(worker, thread_data.second.timeline, filter,
+                           statistics_map);
+    }
+  }
+}
+
+void PrintStatisticsTable(const ZoneStatisticsMap& statistics_map) {
+  // Rank by total time so the output reads as an optimization worklist.
+  std::vector<const ZoneStatisticsMap::value_type*> entries;
+  entries.reserve(statistics_map.size());
+  for (const auto& entry : statistics_map) entries.push_back(&entry);
+  std::sort(entries.begin(), entries.end(), [](const auto* a, const auto* b) {
+    return a->second.total_ns > b->second.total_ns;
+  });
+  printf("name,count,total_ns,mean_ns,min_ns,max_ns,mean_queue_gap_ns\n");
+  for (const auto* entry : entries) {
+    const auto& statistics = entry->second;
+    if (!statistics.count) continue;
+    printf("\"%s\",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64
+           ",%" PRId64 "\n",
+           entry->first.c_str(), statistics.count, statistics.total_ns,
+           statistics.total_ns / statistics.count, statistics.min_ns,
+           statistics.max_ns,
+           statistics.queue_gap_count
+               ? statistics.total_queue_gap_ns / statistics.queue_gap_count
+               : 0);
+  }
+}
+
+// Emits one collapsed-stack line per zone name with the total time as the
+// sample value; feed to flamegraph.pl or pprof-compatible converters.
+void PrintCollapsedStacks(const ZoneStatisticsMap& statistics_map) {
+  for (const auto& entry : statistics_map) {
+    if (!entry.second.count) continue;
+    printf("%s %" PRId64 "\n", entry.first.c_str(), entry.second.total_ns);
+  }
+}
+
+void PrintUsage() {
+  fprintf(stderr,
+          "Usage: iree-tracy-extract [options] capture.tracy\n"
+          "  --format=stats      ranked per-zone statistics CSV (default)\n"
+          "  --format=collapsed  collapsed-stack totals for flamegraph "
+          "tooling\n"
+          "  --filter=SUBSTR     only include zones whose name contains "
+          "SUBSTR\n"
+          "                      (e.g. --filter=_dispatch_)\n"
+          "  --cpu / --gpu       restrict to CPU or GPU zones (default "
+          "both)\n");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const char* filename = nullptr;
+  const char* filter = nullptr;
+  bool collapsed = false;
+  bool include_cpu = true;
+  bool include_gpu = true;
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--format=stats") == 0) {
+      collapsed = false;
+    } else if (strcmp(argv[i], "--format=collapsed") == 0) {
+      collapsed = true;
+    } else if (strncmp(argv[i], "--filter=", 9) == 0) {
+      filter = argv[i] + 9;
+    } else if (strcmp(argv[i], "--cpu") == 0) {
+      include_gpu = false;
+    } else if (strcmp(argv[i], "--gpu") == 0) {
+      include_cpu = false;
+    } else if (strcmp(argv[i], "--help") == 0) {
+      PrintUsage();
+      return 0;
+    } else if (argv[i][0] == '-') {
+      fprintf(stderr, "Unknown option: %s\n", argv[i]);
+      PrintUsage();
+      return 1;
+    } else {
+      filename = argv[i];
+    }
+  }
+  if (!filename) {
+    PrintUsage();
+    return 1;
+  }
+
+  auto file =
+      std::unique_ptr<tracy::FileRead>(tracy::FileRead::Open(filename));
+  if (!file) {
+    fprintf(stderr, "Could not open capture file: %s\n", filename);
+    return 1;
+  }
+  tracy::Worker worker(*file);
+  while (!worker.AreSourceLocationZonesReady()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+
+  ZoneStatisticsMap statistics_map;
+  if (include_cpu) AggregateCpuZones(worker, filter, statistics_map);
+  if (include_gpu) AggregateGpuZones(worker, filter, statistics_map);
+
+  if (collapsed) {
+    PrintCollapsedStacks(statistics_map);
+  } else {
+    PrintStatisticsTable(statistics_map);
+  }
+  return 0;
+}
@@ -50,6 +50,7 @@
 #include "iree/compiler/Tools/init_passes.h"
 #include "iree/compiler/Tools/version.h"
 #include "iree/compiler/Utils/ModuleUtils.h"
+#include "iree/compiler/Utils/PassTelemetry.h"
 #include "iree/compiler/Utils/TracingUtils.h"
 #include "iree/compiler/embedding_api.h"
 #include "iree/compiler/mlir_interop.h"
@@ -751,6 +752,10 @@ std::unique_ptr<PassManager> Invocation::createPassManager() {
     mlir::applyDefaultTimingPassManagerCLOptions(*passManager);
   }
   passManager->addInstrumentation(std::make_unique<PassTracing>());
+  if (auto telemetryCollector = PassTelemetryCollector::getFromFlags()) {
+    passManager->addInstrumentation(
+        std::make_unique<PassTelemetry>(std::move(telemetryCollector)));
+  }
   passManager->enableVerifier(enableVerifier);
   for (auto &init : passManagerInitializers) {
     init(*passManager);
@@ -35,9 +35,17 @@ getInvocationModel(Operation *op, IREE::ABI::InvocationModel defaultModel) {
   }
 }
 
+// Returns true if |op| opted into the raw buffer ABI with `iree.abi.raw`.
+// Raw exports marshal tensors as bare !hal.buffers without the shape/type
+// metadata (and validation) that buffer views carry; only valid when all
+// tensor I/O is statically shaped.
+static bool isRawABI(Operation *op) { return op->hasAttr("iree.abi.raw"); }
+
 // Maps a source type to the native ABI type.
-static Type mapToABIType(Type type) {
+static Type mapToABIType(Type type, bool rawBuffers = false) {
   if (llvm::isa<TensorType>(type)) {
+    if (rawBuffers)
+      return IREE::HAL::BufferType::get(type.getContext());
     return IREE::HAL::BufferViewType::get(type.getContext());
   }
   return type;
@@ -411,6 +419,12 @@ static void populateReflectionAttrs(IREE::ABI::InvocationModel invocationModel,
     attrs.emplace_back(StringAttr::get(context, "iree.abi"), abiAttr);
   }
 
+  // Mark raw exports so bindings know to pass bare buffers instead of views.
+  if (isRawABI(exportOp)) {
+    attrs.emplace_back(StringAttr::get(context, "iree.abi.raw"),
+                       StringAttr::get(context, "1"));
+  }
+
   switch (invocationModel) {
   default:
   case IREE::ABI::InvocationModel::Sync:
@@ -454,6 +468,22 @@ createExportWrapperFunc(IREE::ABI::InvocationModel invocationModel,
   exportOp.getAllResultAttrs(resultAttrDict);
   stripABIAttrs(resultAttrDict);
 
+  // Raw exports trade buffer view metadata for bare buffers and as such have
+  // no way to carry dynamic dimensions across the ABI boundary.
+  const bool rawBuffers = isRawABI(exportOp);
+  if (rawBuffers) {
+    for (auto type : llvm::concat<const Type>(exportOp.getArgumentTypes(),
+                                              exportOp.getResultTypes())) {
+      auto tensorType = llvm::dyn_cast<TensorType>(type);
+      if (tensorType && !tensorType.hasStaticShape()) {
+        exportOp.emitError()
+            << "iree.abi.raw requires statically-shaped tensor I/O; " << type
+            << " has dynamic dimensions that need buffer view metadata";
+        return {};
+      }
+    }
+  }
+
   // Convert argument types to those required by the binding ABI.
   //
   // NOTE: this is where we could change our signature to provide additional
@@ -461,7 +491,7 @@ createExportWrapperFunc(IREE::ABI::InvocationModel invocationModel,
   // async behavior or cancellation.
   SmallVector<Type> inputTypes;
   for (auto oldType : exportOp.getArgumentTypes()) {
-    inputTypes.push_back(mapToABIType(oldType));
+    inputTypes.push_back(mapToABIType(oldType, rawBuffers));
   }
   auto fenceType = IREE::HAL::FenceType::get(exportOp.getContext());
   switch (invocationModel) {
@@ -477,7 +507,7 @@ createExportWrapperFunc(IREE::ABI::InvocationModel invocationModel,
   }
   SmallVector<Type> resultTypes;
   for (auto oldType : exportOp.getResultTypes()) {
-    resultTypes.push_back(mapToABIType(oldType));
+    resultTypes.push_back(mapToABIType(oldType, rawBuffers));
   }
   auto newExportType =
       FunctionType::get(exportOp.getContext(), inputTypes, resultTypes);
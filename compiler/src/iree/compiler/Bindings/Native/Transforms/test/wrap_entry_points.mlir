@@ -200,3 +200,28 @@ util.func private @importEncodingsCaller(%arg0: tensor<?x2xi32>) -> tensor<2x?xi
   %0 = util.call @importEncodings(%arg0) : (tensor<?x2xi32>) -> tensor<2x?xi32>
   util.return %0 : tensor<2x?xi32>
 }
+
+// -----
+
+// Tests that raw exports marshal tensors as bare buffers without view
+// metadata and are marked for runtime detection.
+
+// CHECK-LABEL: util.func public @rawEntry(
+//  CHECK-SAME:   %[[ARG0:.+]]: !hal.buffer
+//  CHECK-SAME: -> !hal.buffer
+//  CHECK-SAME: attributes {
+//  CHECK-SAME:   iree.abi.stub
+//  CHECK-SAME:   iree.abi.raw = "1"
+//  CHECK-SAME: } {
+//  CHECK-NEXT:   %[[ARG0_TENSOR:.+]] = hal.tensor.import %[[ARG0]] "input0" : !hal.buffer -> tensor<4x8xf32>
+//  CHECK-NEXT:   %[[RET_TENSOR:.+]] = util.call @_rawEntry(%[[ARG0_TENSOR]])
+//  CHECK-NEXT:   %[[RET_BUFFER:.+]] = hal.tensor.export %[[RET_TENSOR]] "output0" : tensor<4x8xf32> -> !hal.buffer
+//  CHECK-NEXT:   util.return %[[RET_BUFFER]] : !hal.buffer
+//  CHECK-NEXT: }
+
+// CHECK-LABEL: util.func private @_rawEntry(
+util.func public @rawEntry(%arg0: tensor<4x8xf32>) -> tensor<4x8xf32>
+    attributes {iree.abi.raw} {
+  %0 = arith.addf %arg0, %arg0 : tensor<4x8xf32>
+  util.return %0 : tensor<4x8xf32>
+}
@@ -13,6 +13,7 @@
 #include "iree/compiler/Codegen/Dialect/Codegen/IR/UKernelOps.h"
 #include "iree/compiler/Codegen/Utils/Utils.h"
 #include "iree/compiler/Dialect/Encoding/IR/EncodingOps.h"
+#include "llvm/Support/CommandLine.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/Dialect/Linalg/IR/Linalg.h"
 #include "mlir/Dialect/Linalg/Utils/Utils.h"
@@ -25,6 +26,19 @@
 #include "mlir/IR/TypeRange.h"
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
 
+// When set, ukernel calls are left as dynamically resolved imports instead of
+// being linked against the ukernel bitcode library. The imports are then
+// serviced at load time by a runtime plugin (see
+// runtime/src/iree/builtins/ukernel/plugin/) carrying all CPU-feature variants
+// of the ukernels, so a single compiled artifact runs at native speed across
+// microarchitectures.
+static llvm::cl::opt<bool> clUKernelPluginABI(
+    "iree-codegen-ukernel-plugin-abi",
+    llvm::cl::desc("Lower CPU ukernel calls as dynamically resolved imports "
+                   "serviced by the runtime ukernel plugin instead of linking "
+                   "ukernel bitcode into each executable."),
+    llvm::cl::init(false));
+
 namespace mlir::iree_compiler {
 
 // Returns the CastOpInterface op of the body, if
@@ -119,8 +133,12 @@ getFnNameAndDefAttrs(const char *ukernelName, RewriterBase &rewriter,
     result.defAttrs.emplace_back(
         rewriter.getStringAttr("hal.import.fields"),
         rewriter.getArrayAttr({rewriter.getStringAttr("processor_data")}));
-    result.defAttrs.emplace_back(rewriter.getStringAttr("hal.import.bitcode"),
-                                 rewriter.getBoolAttr(true));
+    // Without the bitcode attribute the call is lowered to a dynamic import
+    // resolved at load time, e.g. by the runtime ukernel plugin.
+    if (!clUKernelPluginABI) {
+      result.defAttrs.emplace_back(rewriter.getStringAttr("hal.import.bitcode"),
+                                   rewriter.getBoolAttr(true));
+    }
   }
   return result;
 }
@@ -274,9 +274,22 @@ enumerateMatmulTileX86_64(TypeRange elementTypes, ExecutableTargetAttr target) {
       ((lhs.isSignlessInteger(8) && rhs.isSignlessInteger(8)) ||
        (lhs.isSignlessInteger(16) && rhs.isSignlessInteger(16)))) {
     if (hasFeature(target, "+avx512vnni")) {
+      if (hasUkernel(target) && lhs.isSignlessInteger(8)) {
+        // The mmt4d ukernel uses VPDPBUSD here, working around its
+        // unsigned*signed semantics by biasing the LHS and subtracting the
+        // correction term, which is hard to do in codegen.
+        return {
+            TileMxNxK{16, 16, 4}, // Aim to use VPDPBUSD (zmm).
+            TileMxNxK{8, 16, 4},  // Truncation of the above.
+            TileMxNxK{4, 16, 4},  // Truncation of the above.
+            TileMxNxK{2, 16, 4},  // Truncation of the above.
+            TileMxNxK{1, 16, 4},  // Truncation of the above.
+        };
+      }
       // This is the same tile size as with VPMADDWD as the only difference
       // is that VPDPWSSD accumulates. VPDPBUSD would call for {16, 16, 4} but
-      // we can't easily use it because of its unsigned*signed semantics.
+      // we can't easily use it in codegen because of its unsigned*signed
+      // semantics.
       return {
           TileMxNxK{16, 16, 2}, // Aim to use VPDPWSSD (zmm).
           TileMxNxK{8, 16, 2},  // Truncation of the above.
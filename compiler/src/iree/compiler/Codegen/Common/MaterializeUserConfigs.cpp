@@ -10,13 +10,18 @@
 #include "iree/compiler/Codegen/Common/UserConfig.h"
 #include "iree/compiler/Codegen/Dialect/Codegen/IR/IREECodegenAttrs.h"
 #include "iree/compiler/Codegen/Dialect/Codegen/IR/IREECodegenDialect.h"
+#include "iree/compiler/Dialect/HAL/IR/HALTypes.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/iterator_range.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SHA256.h"
+#include "mlir/AsmParser/AsmParser.h"
 #include "mlir/Dialect/Linalg/Transforms/Transforms.h"
 #include "mlir/Dialect/Transform/IR/TransformDialect.h"
 #include "mlir/Dialect/Transform/IR/TransformOps.h"
 #include "mlir/Dialect/Transform/Transforms/TransformInterpreterUtils.h"
+#include "mlir/Interfaces/TilingInterface.h"
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
 
 #define DEBUG_TYPE "iree-codegen-materialize-user-configs"
@@ -35,10 +40,63 @@ llvm::cl::opt<std::string> clCodegenTransformDialectLibraryFileName(
         "this will default to `__kernel_config`."),
     llvm::cl::init(""));
 
+llvm::cl::opt<std::string> clCodegenTuningDatabaseFileName(
+    "iree-codegen-tuning-database",
+    llvm::cl::desc(
+        "File path to a tuning database holding a dictionary attribute that"
+        "maps dispatch fingerprints to #iree_codegen.compilation_info entries"
+        "applied before the target lowering heuristics run. Dispatches without"
+        "an entry are annotated with their fingerprint so autotuners can"
+        "populate the database from dumped executable sources."),
+    llvm::cl::init(""));
+
 namespace {
 
 static const char kTranslationInfoAttrName[] = "translation_info";
 
+// Annotation left on dispatch functions that have no tuning database entry so
+// autotuners can associate dumped executable sources with the database keys
+// they should populate.
+static const char kTuningKeyAttrName[] = "iree_codegen.tuning_key";
+
+// Returns the tuning database key for |funcOp|: a SHA-256 fingerprint of the
+// printed dispatch function qualified by the executable target format, so
+// entries are keyed on both the dispatch contents and the target
+// architecture.
+static std::string computeTuningDatabaseKey(FunctionOpInterface funcOp) {
+  std::string ir;
+  llvm::raw_string_ostream os(ir);
+  OpPrintingFlags flags;
+  flags.useLocalScope();
+  funcOp->print(os, flags);
+  llvm::SHA256 hasher;
+  hasher.update(ir);
+  std::string key = llvm::toHex(hasher.final(), /*LowerCase=*/true);
+  if (auto targetAttr = IREE::HAL::ExecutableTargetAttr::lookup(funcOp)) {
+    key += "@";
+    key += targetAttr.getFormat().getValue();
+  }
+  return key;
+}
+
+// Loads the tuning database at |path|: a file holding a single dictionary
+// attribute mapping tuning keys to #iree_codegen.compilation_info entries.
+// Emits an error on |moduleOp| and returns nullptr on failure.
+static DictionaryAttr loadTuningDatabase(ModuleOp moduleOp, StringRef path) {
+  auto fileOr = llvm::MemoryBuffer::getFile(path, /*IsText=*/true);
+  if (!fileOr) {
+    moduleOp.emitError() << "failed to open tuning database '" << path << "'";
+    return {};
+  }
+  auto databaseAttr = dyn_cast_if_present<DictionaryAttr>(
+      mlir::parseAttribute(fileOr.get()->getBuffer(), moduleOp.getContext()));
+  if (!databaseAttr) {
+    moduleOp.emitError() << "tuning database '" << path
+                         << "' must hold a single dictionary attribute";
+  }
+  return databaseAttr;
+}
+
 enum StrategyRunResult {
   Success = 0,
   NotFound = 1,
@@ -75,6 +133,16 @@ struct MaterializeUserConfigsPass
   void runOnOperation() override {
     auto moduleOp = getOperation();
     MLIRContext *context = &getContext();
+
+    DictionaryAttr tuningDatabase;
+    if (!clCodegenTuningDatabaseFileName.empty()) {
+      tuningDatabase =
+          loadTuningDatabase(moduleOp, clCodegenTuningDatabaseFileName);
+      if (!tuningDatabase) {
+        return signalPassFailure();
+      }
+    }
+
     for (auto funcOp : moduleOp.getOps<FunctionOpInterface>()) {
 
       // Parse the file path and kernel config strategy from flags. There are
@@ -170,6 +238,27 @@ struct MaterializeUserConfigsPass
         return signalPassFailure();
       }
 
+      /// Next consult the tuning database (if any) for a measured
+      /// configuration before falling through to the target heuristics.
+      if (tuningDatabase && !getTranslationInfo(funcOp)) {
+        std::string tuningKey = computeTuningDatabaseKey(funcOp);
+        if (auto compilationInfo =
+                tuningDatabase.getAs<IREE::Codegen::CompilationInfoAttr>(
+                    tuningKey)) {
+          Operation *rootOp = nullptr;
+          funcOp.walk([&](TilingInterface op) { rootOp = op; });
+          if (rootOp &&
+              failed(setUserConfig(funcOp, rootOp, compilationInfo))) {
+            funcOp.emitOpError("error in setting tuning database config");
+            return signalPassFailure();
+          }
+          LDBG("--applied tuning database entry " << tuningKey);
+        } else {
+          funcOp->setAttr(kTuningKeyAttrName,
+                          StringAttr::get(context, tuningKey));
+        }
+      }
+
       translationInfo = getTranslationInfo(funcOp);
       LDBG("--guaranteed unique translationInfo: " << translationInfo);
       /// We only need to resolve symbols for transform dialect based
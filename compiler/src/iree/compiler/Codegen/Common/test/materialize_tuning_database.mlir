@@ -0,0 +1,23 @@
+// RUN: echo '{}' > %t.tuningdb
+// RUN: iree-opt --pass-pipeline='builtin.module(iree-codegen-materialize-user-configs)' --iree-codegen-tuning-database=%t.tuningdb %s | FileCheck %s
+
+// With no matching database entry the dispatch keeps its heuristic path and
+// is annotated with the fingerprint an autotuner should populate. Database
+// hits apply the stored #iree_codegen.compilation_info and are covered by the
+// autotuner integration since the fingerprint is content-derived.
+
+#executable_target_system_elf_x86_64_ = #hal.executable.target<"llvm-cpu", "system-elf-x86_64", {target_triple = "x86_64-xyz-xyz"}>
+module {
+  // CHECK: func.func @missing_entry()
+  // CHECK-SAME: iree_codegen.tuning_key = "{{[0-9a-f]+}}@system-elf-x86_64"
+  func.func @missing_entry() attributes {hal.executable.target = #executable_target_system_elf_x86_64_} {
+    %cst = arith.constant 0.000000e+00 : f32
+    %0 = hal.interface.binding.subspan set(0) binding(0) type(storage_buffer) : !flow.dispatch.tensor<readonly:tensor<128x256xf32>>
+    %1 = hal.interface.binding.subspan set(0) binding(1) type(storage_buffer) : !flow.dispatch.tensor<writeonly:tensor<128x256xf32>>
+    %2 = flow.dispatch.tensor.load %0, offsets = [0, 0], sizes = [128, 256], strides = [1, 1] : !flow.dispatch.tensor<readonly:tensor<128x256xf32>> -> tensor<128x256xf32>
+    %3 = tensor.empty() : tensor<128x256xf32>
+    %4 = linalg.fill ins(%cst : f32) outs(%3 : tensor<128x256xf32>) -> tensor<128x256xf32>
+    flow.dispatch.tensor.store %4, %1, offsets = [0, 0], sizes = [128, 256], strides = [1, 1] : tensor<128x256xf32> -> !flow.dispatch.tensor<writeonly:tensor<128x256xf32>>
+    return
+  }
+}
@@ -991,7 +991,7 @@ static SmallVector<int64_t> getDefaultMatmulCacheSizes(linalg::LinalgOp op,
 }
 
 static LogicalResult setMatmulPeelingRootConfig(
-    mlir::FunctionOpInterface entryPointFn, linalg::ContractionOpInterface op,
+    mlir::FunctionOpInterface entryPointFn, linalg::LinalgOp op,
     ArrayRef<int64_t> distTileSizes, ArrayRef<int64_t> cacheTileSizes,
     ArrayRef<bool> inputVecScalableTileFlags, ArrayRef<int64_t> vecTileSizes,
     int vectorSize) {
@@ -1064,13 +1064,11 @@ static LogicalResult setMatmulPeelingRootConfig(
 }
 
 static LogicalResult
-setMatmulRootConfig(mlir::FunctionOpInterface entryPointFn,
-                    linalg::ContractionOpInterface op,
+setMatmulRootConfig(mlir::FunctionOpInterface entryPointFn, linalg::LinalgOp op,
                     const TileSizesListTypeRef inputTileSizes,
                     const ScalableTileFlagsListTypeRef inputScalableTileFlags,
                     int vectorSize, VectorPreProcStrategy vecPreProcStrategy) {
-  auto linalgOp = cast<linalg::LinalgOp>(op.getOperation());
-  SmallVector<int64_t> shape = linalgOp.getStaticLoopRanges();
+  SmallVector<int64_t> shape = op.getStaticLoopRanges();
 
   // The tiling for parallel dims and reduction dims are separated.
   const SmallVectorImpl<int64_t> &inputVecTileSizes = inputTileSizes.back();
@@ -1098,17 +1096,16 @@ setMatmulRootConfig(mlir::FunctionOpInterface entryPointFn,
     // fallback to fixed vectorization if they occur:
     parallelScalableFlags.push_back(sz > 1 ? isScalable : false);
   }
-  limitVectorTileSizes(cast<linalg::LinalgOp>(op.getOperation()), vecTileSizes);
+  limitVectorTileSizes(op, vecTileSizes);
   SmallVector<int64_t> parallelTileSizes = vecTileSizes;
   SmallVector<int64_t> reductionTileSizes;
   SmallVector<bool> reductionScalableFlags;
-  splitParallelAndReductionTiles(
-      cast<linalg::LinalgOp>(op.getOperation()), parallelTileSizes,
-      reductionTileSizes, &parallelScalableFlags, &reductionScalableFlags);
+  splitParallelAndReductionTiles(op, parallelTileSizes, reductionTileSizes,
+                                 &parallelScalableFlags,
+                                 &reductionScalableFlags);
 
   if (vecPreProcStrategy == VectorPreProcStrategy::None) {
-    setVectorSizesForDynamicShapes(cast<linalg::LinalgOp>(op.getOperation()),
-                                   vecPreProcStrategy, parallelTileSizes,
+    setVectorSizesForDynamicShapes(op, vecPreProcStrategy, parallelTileSizes,
                                    reductionTileSizes);
   }
 
@@ -1383,20 +1380,43 @@ getMatmulCacheTileSizesForShape(ArrayRef<int64_t> inputTileSizes,
   return outputTileSizes;
 }
 
+/// Returns the static extent of the outermost parallel dimension when `op` is
+/// a horizontally fused contraction, i.e. a batch-style contraction whose LHS
+/// is shared across the fused heads and therefore not indexed by the batch
+/// dimension. FuseHorizontalContractions produces this form when merging
+/// parallel matmuls that read the same LHS (e.g. grouped QKV projections).
+static std::optional<int64_t> getSharedLhsFusedDimSize(linalg::LinalgOp op) {
+  if (op.getNumLoops() < 4) {
+    return std::nullopt;
+  }
+  AffineMap lhsMap = op.getMatchingIndexingMap(op.getDpsInputOperand(0));
+  AffineMap rhsMap = op.getMatchingIndexingMap(op.getDpsInputOperand(1));
+  AffineMap outMap = op.getMatchingIndexingMap(op.getDpsInitOperand(0));
+  if (lhsMap.isFunctionOfDim(0) || !rhsMap.isFunctionOfDim(0) ||
+      !outMap.isFunctionOfDim(0)) {
+    return std::nullopt;
+  }
+  int64_t fusedDimSize = op.getStaticLoopRanges()[0];
+  if (ShapedType::isDynamic(fusedDimSize)) {
+    return std::nullopt;
+  }
+  return fusedDimSize;
+}
+
 /// Sets the lowering configuration for dispatch region with root op that
-/// implements the contraction operation interface.
+/// implements the contraction operation interface. Also handles contractions
+/// that only exist as linalg.generic ops, e.g. the horizontally fused
+/// contractions produced by FuseHorizontalContractions.
 static LogicalResult
-setRootConfig(mlir::FunctionOpInterface entryPointFn,
-              linalg::ContractionOpInterface contractionOp) {
-  assert(!getLoweringConfig(contractionOp) &&
-         "expected lowering_config is not set");
-  auto linalgOp = cast<linalg::LinalgOp>(contractionOp.getOperation());
+setContractionRootConfig(mlir::FunctionOpInterface entryPointFn,
+                         linalg::LinalgOp linalgOp) {
+  assert(!getLoweringConfig(linalgOp) && "expected lowering_config is not set");
   unsigned numLoops = linalgOp.getNumLoops();
   {
     SmallVector<unsigned> dims;
     linalgOp.getReductionDims(dims);
     if (dims.size() != 1 || dims[0] != numLoops - 1) {
-      return contractionOp.emitOpError(
+      return linalgOp.emitOpError(
           "expected to have exactly one reduction dim, and it is the innermost "
           "dim");
     }
@@ -1404,8 +1424,10 @@ setRootConfig(mlir::FunctionOpInterface entryPointFn,
 
   // Consider all element types and use the smallest vector size. The tiling
   // sizes are chosen based on the vector size.
-  auto lhsShapedType = llvm::cast<ShapedType>(contractionOp.lhs().getType());
-  auto rhsShapedType = llvm::cast<ShapedType>(contractionOp.rhs().getType());
+  auto lhsShapedType =
+      llvm::cast<ShapedType>(linalgOp.getDpsInputOperand(0)->get().getType());
+  auto rhsShapedType =
+      llvm::cast<ShapedType>(linalgOp.getDpsInputOperand(1)->get().getType());
   auto resShapedType =
       llvm::cast<ShapedType>(linalgOp.getDpsInitOperand(0)->get().getType());
   int64_t vectorSize = getVectorSize(entryPointFn, lhsShapedType);
@@ -1429,12 +1451,34 @@ setRootConfig(mlir::FunctionOpInterface entryPointFn,
   distConfig.allowIncompleteTile =
       vecPreProcStrategy != VectorPreProcStrategy::None;
   distConfig.vectorSizeHints.resize(numLoops, vectorSize);
-  bool isBM = isa<linalg::BatchMatmulOp>(contractionOp.getOperation());
+  bool isBM = isa<linalg::BatchMatmulOp>(linalgOp.getOperation());
   if (isBM) {
     distConfig.maxTileSizes[0] = 1;
     distConfig.vectorSizeHints[0] = 1;
   }
 
+  // Horizontally fused contractions share the LHS across the fused heads: the
+  // outermost parallel dimension only indexes the concatenated RHS and
+  // accumulators. Keep all heads within one distribution tile and unroll them
+  // at the vector level so a single traversal of the shared LHS feeds the
+  // interleaved FMAs of every head instead of re-streaming the LHS per head.
+  // The N/K tiles are narrowed to pay for the extra accumulator sets;
+  // limitVectorTileSizes rebalances if the resulting footprint still exceeds
+  // the register budget.
+  constexpr int64_t kMaxFusedHeadUnrollFactor = 4;
+  if (std::optional<int64_t> fusedDimSize = getSharedLhsFusedDimSize(linalgOp);
+      fusedDimSize && *fusedDimSize <= kMaxFusedHeadUnrollFactor) {
+    distConfig.maxTileSizes[0] = *fusedDimSize;
+    distConfig.vectorSizeHints[0] = 1;
+    int64_t unrollFactor = llvm::PowerOf2Ceil(*fusedDimSize);
+    vecTileSizes[0] = *fusedDimSize;
+    vecScalableFlags[0] = false;
+    vecTileSizes[numLoops - 2] =
+        std::max<int64_t>(vecTileSizes[numLoops - 2] / unrollFactor, 1);
+    vecTileSizes[numLoops - 1] =
+        std::max<int64_t>(vecTileSizes[numLoops - 1] / unrollFactor, 1);
+  }
+
   // Compute cache-level tile sizes. Cache a dimension only if there are
   // enough iterations.
   SmallVector<int64_t> cacheTileSizes;
@@ -1476,12 +1520,12 @@ setRootConfig(mlir::FunctionOpInterface entryPointFn,
 
   if (usePeelingPipeline) {
     return setMatmulPeelingRootConfig(
-        entryPointFn, contractionOp, distTileSizes, cacheTileSizes,
+        entryPointFn, linalgOp, distTileSizes, cacheTileSizes,
         vecScalableFlags, vecTileSizes, vectorSize);
   }
 
   TileSizesListType tileSizes = {distTileSizes, vecTileSizes};
-  return setMatmulRootConfig(entryPointFn, contractionOp, tileSizes,
+  return setMatmulRootConfig(entryPointFn, linalgOp, tileSizes,
                              scalableTileFlags, vectorSize, vecPreProcStrategy);
 }
 
@@ -2055,6 +2099,21 @@ setRootConfig(mlir::FunctionOpInterface entryPointFn,
     return success();
   }
 
+  // Horizontally fused contractions (e.g. grouped QKV projections) only exist
+  // as linalg.generic ops since the shared LHS is not indexed by the fused
+  // head dimension. Route them through the contraction configuration so they
+  // keep matmul-style tiling instead of the default generic heuristics.
+  if (linalg::isaContractionOpInterface(genericOp) &&
+      getSharedLhsFusedDimSize(genericOp)) {
+    SmallVector<unsigned> reductionDims;
+    genericOp.getReductionDims(reductionDims);
+    if (reductionDims.size() == 1 &&
+        reductionDims[0] == genericOp.getNumLoops() - 1) {
+      return setContractionRootConfig(
+          entryPointFn, cast<linalg::LinalgOp>(genericOp.getOperation()));
+    }
+  }
+
   if (succeeded(setTransposeLikeOpRootConfig(
           entryPointFn, genericOp, linalgOpInfo, targetMLTransInfo))) {
     return success();
@@ -2329,8 +2388,10 @@ setRootConfigImpl(mlir::FunctionOpInterface entryPointFn, Operation *op,
             [&](auto op) {
               return setConvInterfaceRootConfig(entryPointFn, op);
             })
-        .Case<linalg::ContractionOpInterface>(
-            [&](auto op) { return setRootConfig(entryPointFn, op); })
+        .Case<linalg::ContractionOpInterface>([&](auto op) {
+          return setContractionRootConfig(
+              entryPointFn, cast<linalg::LinalgOp>(op.getOperation()));
+        })
         .Case<TilingInterface>(
             [&](auto op) { return setRootConfig(entryPointFn, op); })
         .Default([&](Operation *op) { return success(); });
@@ -0,0 +1,145 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/compiler/Codegen/LLVMCPU/PassDetail.h"
+#include "iree/compiler/Codegen/LLVMCPU/Passes.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Vector/IR/VectorOps.h"
+#include "mlir/Pass/Pass.h"
+
+#define DEBUG_TYPE "iree-llvmcpu-insert-prefetches"
+
+namespace mlir::iree_compiler {
+namespace {
+
+// A memory access within an innermost loop that streams with the induction
+// variable and is worth covering with a software prefetch.
+struct PrefetchableAccess {
+  Operation *op;
+  Value memref;
+  SmallVector<Value> indices;
+  bool isWrite;
+};
+
+// Collects loads/stores within |forOp| that index directly off the induction
+// variable. Accesses whose indices are all loop-invariant (or derived through
+// arithmetic we don't trace) are left to the hardware prefetchers.
+static void collectPrefetchableAccesses(
+    scf::ForOp forOp, SmallVectorImpl<PrefetchableAccess> &accesses) {
+  Value iv = forOp.getInductionVar();
+  auto usesIv = [&](ValueRange indices) {
+    return llvm::is_contained(indices, iv);
+  };
+  for (Operation &op : forOp.getBody()->without_terminator()) {
+    if (auto loadOp = dyn_cast<memref::LoadOp>(op)) {
+      if (usesIv(loadOp.getIndices())) {
+        accesses.push_back({&op, loadOp.getMemRef(),
+                            llvm::to_vector(loadOp.getIndices()),
+                            /*isWrite=*/false});
+      }
+    } else if (auto storeOp = dyn_cast<memref::StoreOp>(op)) {
+      if (usesIv(storeOp.getIndices())) {
+        accesses.push_back({&op, storeOp.getMemRef(),
+                            llvm::to_vector(storeOp.getIndices()),
+                            /*isWrite=*/true});
+      }
+    } else if (auto loadOp = dyn_cast<vector::LoadOp>(op)) {
+      if (usesIv(loadOp.getIndices())) {
+        accesses.push_back({&op, loadOp.getBase(),
+                            llvm::to_vector(loadOp.getIndices()),
+                            /*isWrite=*/false});
+      }
+    } else if (auto storeOp = dyn_cast<vector::StoreOp>(op)) {
+      if (usesIv(storeOp.getIndices())) {
+        accesses.push_back({&op, storeOp.getBase(),
+                            llvm::to_vector(storeOp.getIndices()),
+                            /*isWrite=*/true});
+      }
+    } else if (auto readOp = dyn_cast<vector::TransferReadOp>(op)) {
+      if (isa<MemRefType>(readOp.getSource().getType()) &&
+          usesIv(readOp.getIndices())) {
+        accesses.push_back({&op, readOp.getSource(),
+                            llvm::to_vector(readOp.getIndices()),
+                            /*isWrite=*/false});
+      }
+    }
+  }
+}
+
+class LLVMCPUInsertPrefetchesPass
+    : public LLVMCPUInsertPrefetchesBase<LLVMCPUInsertPrefetchesPass> {
+public:
+  using LLVMCPUInsertPrefetchesBase::LLVMCPUInsertPrefetchesBase;
+
+  void getDependentDialects(DialectRegistry &registry) const override {
+    registry.insert<arith::ArithDialect, memref::MemRefDialect>();
+  }
+  void runOnOperation() override;
+};
+
+void LLVMCPUInsertPrefetchesPass::runOnOperation() {
+  auto funcOp = getOperation();
+
+  // Gather the innermost loops first so the walk doesn't observe the prefetch
+  // ops we insert.
+  SmallVector<scf::ForOp> innermostLoops;
+  funcOp.walk([&](scf::ForOp forOp) {
+    bool isInnermost =
+        !forOp.getBody()
+             ->walk([&](LoopLikeOpInterface nestedOp) {
+               return nestedOp != forOp ? WalkResult::interrupt()
+                                        : WalkResult::advance();
+             })
+             .wasInterrupted();
+    if (isInnermost)
+      innermostLoops.push_back(forOp);
+  });
+
+  for (auto forOp : innermostLoops) {
+    SmallVector<PrefetchableAccess> accesses;
+    collectPrefetchableAccesses(forOp, accesses);
+    if (accesses.empty())
+      continue;
+
+    // Compute the prefetch lead once per loop: the induction variable advanced
+    // by |prefetchDistance| iterations. The address may run past the end of
+    // the stream for the last iterations which is fine - prefetches are hints
+    // and faulting addresses are dropped by the hardware.
+    Location loc = forOp.getLoc();
+    OpBuilder builder = OpBuilder::atBlockBegin(forOp.getBody());
+    Value iv = forOp.getInductionVar();
+    Value distance =
+        builder.create<arith::ConstantIndexOp>(loc, prefetchDistance);
+    Value lead = builder.create<arith::MulIOp>(loc, forOp.getStep(), distance);
+    Value leadingIv = builder.create<arith::AddIOp>(loc, iv, lead);
+
+    for (auto &access : accesses) {
+      builder.setInsertionPoint(access.op);
+      SmallVector<Value> indices = access.indices;
+      for (auto &index : indices) {
+        if (index == iv)
+          index = leadingIv;
+      }
+      // Locality hint 3 keeps the line in all cache levels; streams narrow
+      // enough to want non-temporal hints should use ukernels instead.
+      builder.create<memref::PrefetchOp>(access.op->getLoc(), access.memref,
+                                         indices, access.isWrite,
+                                         /*localityHint=*/3,
+                                         /*isDataCache=*/true);
+    }
+  }
+}
+
+} // namespace
+
+std::unique_ptr<InterfacePass<mlir::FunctionOpInterface>>
+createLLVMCPUInsertPrefetchesPass() {
+  return std::make_unique<LLVMCPUInsertPrefetchesPass>();
+}
+
+} // namespace mlir::iree_compiler
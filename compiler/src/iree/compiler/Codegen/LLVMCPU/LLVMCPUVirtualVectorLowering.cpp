@@ -6,6 +6,7 @@
 
 #include "iree/compiler/Codegen/LLVMCPU/PassDetail.h"
 #include "iree/compiler/Codegen/LLVMCPU/Passes.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/Dialect/ArmNeon/ArmNeonDialect.h"
 #include "mlir/Dialect/ArmNeon/Transforms.h"
 #include "mlir/Dialect/Linalg/IR/Linalg.h"
@@ -18,20 +19,56 @@
 
 namespace mlir::iree_compiler {
 namespace {
+
+/// Unrolls the leading dimension of rank > 1 vector.gather ops into rank-1
+/// gathers. Rank-1 gathers are deliberately left intact so they convert to
+/// llvm.masked.gather intrinsics from which the backend selects hardware
+/// gather instructions. This replaces the upstream gather lowering (which
+/// decomposes rank-1 gathers into conditional scalar loads) on targets with
+/// native gather support.
+struct UnrollGatherToRank1 : OpRewritePattern<vector::GatherOp> {
+  using OpRewritePattern::OpRewritePattern;
+  LogicalResult matchAndRewrite(vector::GatherOp op,
+                                PatternRewriter &rewriter) const override {
+    VectorType resultType = op.getVectorType();
+    if (resultType.getRank() <= 1 || resultType.isScalable()) {
+      return failure();
+    }
+    Location loc = op.getLoc();
+    Value result = rewriter.create<arith::ConstantOp>(
+        loc, resultType, rewriter.getZeroAttr(resultType));
+    for (int64_t i = 0, e = resultType.getDimSize(0); i < e; ++i) {
+      Value indexVec =
+          rewriter.create<vector::ExtractOp>(loc, op.getIndexVec(), i);
+      Value mask = rewriter.create<vector::ExtractOp>(loc, op.getMask(), i);
+      Value passThru =
+          rewriter.create<vector::ExtractOp>(loc, op.getPassThru(), i);
+      Value subGather = rewriter.create<vector::GatherOp>(
+          loc, passThru.getType(), op.getBase(), op.getIndices(), indexVec,
+          mask, passThru);
+      result = rewriter.create<vector::InsertOp>(loc, subGather, result, i);
+    }
+    rewriter.replaceOp(op, result);
+    return success();
+  }
+};
+
 class LLVMCPUVirtualVectorLoweringPass
     : public LLVMCPUVirtualVectorLoweringBase<
           LLVMCPUVirtualVectorLoweringPass> {
 public:
   using LLVMCPUVirtualVectorLoweringBase::LLVMCPUVirtualVectorLoweringBase;
   LLVMCPUVirtualVectorLoweringPass(std::string splitVectorTransfersTo,
-                                   bool enableArmI8mm) {
+                                   bool enableArmI8mm,
+                                   bool enableNativeGathers) {
     this->splitVectorTransfersTo = splitVectorTransfersTo;
     this->enableArmI8mm = enableArmI8mm;
+    this->enableNativeGathers = enableNativeGathers;
   }
 
   void getDependentDialects(DialectRegistry &registry) const override {
-    registry.insert<linalg::LinalgDialect, vector::VectorDialect,
-                    arm_neon::ArmNeonDialect>();
+    registry.insert<arith::ArithDialect, linalg::LinalgDialect,
+                    vector::VectorDialect, arm_neon::ArmNeonDialect>();
   }
   void runOnOperation() override;
 };
@@ -70,7 +107,14 @@ void LLVMCPUVirtualVectorLoweringPass::runOnOperation() {
   {
     RewritePatternSet patterns(ctx);
     vector::populateVectorToVectorCanonicalizationPatterns(patterns);
-    vector::populateVectorGatherLoweringPatterns(patterns);
+    if (enableNativeGathers) {
+      // Targets with hardware gather support get rank-1 vector.gather ops
+      // that survive through to llvm.masked.gather; everything else is
+      // decomposed into conditional scalar loads by the upstream patterns.
+      patterns.add<UnrollGatherToRank1>(ctx);
+    } else {
+      vector::populateVectorGatherLoweringPatterns(patterns);
+    }
     vector::populateVectorContractLoweringPatterns(
         patterns, vectorTransformOptions,
         /*benefit=*/1,
@@ -91,9 +135,10 @@ void LLVMCPUVirtualVectorLoweringPass::runOnOperation() {
 
 std::unique_ptr<InterfacePass<mlir::FunctionOpInterface>>
 createLLVMCPUVirtualVectorLoweringPass(std::string splitVectorTransfersTo,
-                                       bool enableArmI8mm) {
+                                       bool enableArmI8mm,
+                                       bool enableNativeGathers) {
   return std::make_unique<LLVMCPUVirtualVectorLoweringPass>(
-      splitVectorTransfersTo, enableArmI8mm);
+      splitVectorTransfersTo, enableArmI8mm, enableNativeGathers);
 }
 
 } // namespace mlir::iree_compiler
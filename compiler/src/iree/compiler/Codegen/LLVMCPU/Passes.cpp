@@ -48,6 +48,15 @@ static llvm::cl::opt<bool> clCheckLinalgVectorization(
         "Runs the pass to check if all the Linalg ops are vectorized"),
     llvm::cl::init(false));
 
+static llvm::cl::opt<int64_t> clAttentionKVTileSize(
+    "iree-llvmcpu-attention-kv-tile-size",
+    llvm::cl::desc(
+        "Tile size for the key/value sequence dimension when decomposing "
+        "attention with online softmax. Bounds the materialized score "
+        "tensors for long sequences. Zero processes the full sequence in "
+        "one block."),
+    llvm::cl::init(64));
+
 static llvm::cl::opt<bool> clUseFastMinMaxOps(
     "iree-llvmcpu-use-fast-min-max-ops",
     llvm::cl::desc(
@@ -89,6 +98,14 @@ static llvm::cl::opt<bool> clUseSoftmaxInterFusion(
     llvm::cl::desc("Enables inter-pass fusion for the DecomposeSoftmax pass."),
     llvm::cl::init(true));
 
+static llvm::cl::opt<bool> clEnablePrefetches(
+    "iree-llvmcpu-enable-prefetches",
+    llvm::cl::desc("Inserts software prefetches for streaming accesses in "
+                   "innermost loops. Profitable for bandwidth-bound "
+                   "dispatches on targets whose hardware prefetchers are "
+                   "defeated by tiled access patterns."),
+    llvm::cl::init(false));
+
 static llvm::cl::opt<bool> clEnableVectorContractCustomKernels(
     "iree-llvmcpu-enable-vector-contract-custom-kernels",
     llvm::cl::desc("Enables vector contract custom kernels for "
@@ -289,7 +306,8 @@ void buildLLVMCPUVectorLoweringPipeline(
     const LLVMCPUVectorLoweringPassOptions &options) {
   funcPassManager.addPass(createLLVMCPUDropVectorUnitDimsPass());
   funcPassManager.addPass(createLLVMCPUVirtualVectorLoweringPass(
-      options.splitVectorTransfersTo, options.enableArmI8mm));
+      options.splitVectorTransfersTo, options.enableArmI8mm,
+      options.enableNativeGathers));
 
   // Make sure we remove redundant vector ops (e.g., vector tranposes) before we
   // lower them and can't be optimized away anymore.
@@ -339,6 +357,7 @@ void addCPUBufferOpsTileAndVectorizePipeline(
     options.lowerVectorTransposeToAVX2 = pipelineOpt.lowerToAVX2;
     options.splitVectorTransfersTo = "linalg-copy";
     options.enableArmI8mm = pipelineOpt.enableAArch64I8mm;
+    options.enableNativeGathers = pipelineOpt.enableNativeGathers;
     buildLLVMCPUVectorLoweringPipeline(funcPassManager, options);
   }
 
@@ -416,6 +435,7 @@ void addMultiTilingExpertPassPipeline(OpPassManager &funcPassManager,
     options.lowerVectorTransposeToAVX2 = pipelineOpt.lowerToAVX2;
     options.splitVectorTransfersTo = "linalg-copy";
     options.enableArmI8mm = pipelineOpt.enableAArch64I8mm;
+    options.enableNativeGathers = pipelineOpt.enableNativeGathers;
     buildLLVMCPUVectorLoweringPipeline(funcPassManager, options);
   }
 
@@ -474,6 +494,7 @@ void addConvTileAndDecomposeExpertPassPipeline(
     options.lowerVectorTransposeToAVX2 = pipelineOpt.lowerToAVX2;
     options.splitVectorTransfersTo = "shuffle";
     options.enableArmI8mm = pipelineOpt.enableAArch64I8mm;
+    options.enableNativeGathers = pipelineOpt.enableNativeGathers;
     buildLLVMCPUVectorLoweringPipeline(funcPassManager, options);
   }
 
@@ -550,6 +571,7 @@ void addMmt4dTilingExpertPassPipeline(OpPassManager &funcPassManager,
   options.lowerVectorTransposeToAVX2 = pipelineOpt.lowerToAVX2;
   options.splitVectorTransfersTo = "linalg-copy";
   options.enableArmI8mm = pipelineOpt.enableAArch64I8mm;
+  options.enableNativeGathers = pipelineOpt.enableNativeGathers;
   buildLLVMCPUVectorLoweringPipeline(funcPassManager, options);
 }
 
@@ -579,6 +601,7 @@ void addCPUDataTilingPipeline(OpPassManager &funcPassManager,
     options.lowerVectorTransposeToAVX2 = pipelineOpt.lowerToAVX2;
     options.splitVectorTransfersTo = "linalg-copy";
     options.enableArmI8mm = pipelineOpt.enableAArch64I8mm;
+    options.enableNativeGathers = pipelineOpt.enableNativeGathers;
     buildLLVMCPUVectorLoweringPipeline(funcPassManager, options);
   }
 }
@@ -590,8 +613,8 @@ void addCPULinalgExtTileAndVectorizePipeline(
   funcPassManager.addPass(
       createLLVMCPUTilePass(tilingConfig.getVectorCommonParallelLevel()));
   // TODO: Should only apply decomposition here?
-  funcPassManager.addPass(
-      IREE::LinalgExt::createTileAndDecomposeAttentionPass());
+  funcPassManager.addPass(IREE::LinalgExt::createTileAndDecomposeAttentionPass(
+      /*onlyTile=*/false, /*tileSize=*/clAttentionKVTileSize));
   funcPassManager.addPass(
       IREE::LinalgExt::createDecomposeWinogradTransformPass());
 
@@ -612,6 +635,7 @@ void addCPULinalgExtTileAndVectorizePipeline(
     options.lowerVectorTransposeToAVX2 = pipelineOpt.lowerToAVX2;
     options.splitVectorTransfersTo = "linalg-copy";
     options.enableArmI8mm = pipelineOpt.enableAArch64I8mm;
+    options.enableNativeGathers = pipelineOpt.enableNativeGathers;
     buildLLVMCPUVectorLoweringPipeline(funcPassManager, options);
   }
 }
@@ -679,6 +703,9 @@ static void addLowerToLLVMPasses(OpPassManager &modulePassManager,
       // must conclude before this point.
       .addPass(createIREEExpandStridedMetadataPass)
       .addPass(createCleanupBufferAllocViewPass)
+      // Insert software prefetches while loop structure is still visible;
+      // SCF->CF erases the induction variables we key off of.
+      .addPredicatedPass(clEnablePrefetches, createLLVMCPUInsertPrefetchesPass)
       // Checking stack allocation before converting to CF dialect is easier.
       .addPass([&]() {
         return createLLVMCPUCheckIRBeforeLLVMConversionPass(
@@ -79,6 +79,11 @@ createLLVMCPUTilePass(int64_t tilingLevel = -1);
 std::unique_ptr<InterfacePass<mlir::FunctionOpInterface>>
 createLLVMCPUUnfuseFMAOpsPass();
 
+/// Inserts software prefetches ahead of streaming accesses in innermost
+/// loops for bandwidth-bound dispatches.
+std::unique_ptr<InterfacePass<mlir::FunctionOpInterface>>
+createLLVMCPUInsertPrefetchesPass();
+
 //------------------------------------------------------------------------------
 // Passes to lower Vector ops before conversion to LLVM.
 //------------------------------------------------------------------------------
@@ -87,6 +92,7 @@ struct LLVMCPUVectorLoweringPassOptions {
   std::string splitVectorTransfersTo = "";
   bool lowerVectorTransposeToAVX2 = false;
   bool enableArmI8mm = false;
+  bool enableNativeGathers = false;
 };
 
 std::unique_ptr<InterfacePass<mlir::FunctionOpInterface>>
@@ -94,7 +100,8 @@ createLLVMCPUDropVectorUnitDimsPass();
 
 std::unique_ptr<InterfacePass<mlir::FunctionOpInterface>>
 createLLVMCPUVirtualVectorLoweringPass(std::string splitVectorTransfersTo = "",
-                                       bool enableArmI8mm = false);
+                                       bool enableArmI8mm = false,
+                                       bool enableNativeGathers = false);
 
 std::unique_ptr<InterfacePass<mlir::FunctionOpInterface>>
 createLLVMCPUVectorTransferLoweringPass();
@@ -145,6 +152,7 @@ struct LLVMCPUPipelineOptions {
   bool enableAArch64I8mm = false;
   bool enableUkernels = false;
   bool lowerToAVX2 = false;
+  bool enableNativeGathers = false;
 };
 
 /// Populates the passes to lower linalg ops on buffers. Currenly this
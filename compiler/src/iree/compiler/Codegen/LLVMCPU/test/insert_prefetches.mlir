@@ -0,0 +1,80 @@
+// RUN: iree-opt --pass-pipeline="builtin.module(func.func(iree-llvmcpu-insert-prefetches))" --split-input-file %s | FileCheck %s
+
+// Streaming loads and stores indexed by the innermost induction variable get
+// a prefetch one distance ahead; loop-invariant accesses are left alone.
+
+func.func @streaming_copy(%src: memref<4096xf32>, %dst: memref<4096xf32>) {
+  %c0 = arith.constant 0 : index
+  %c8 = arith.constant 8 : index
+  %c4096 = arith.constant 4096 : index
+  scf.for %i = %c0 to %c4096 step %c8 {
+    %v = vector.load %src[%i] : memref<4096xf32>, vector<8xf32>
+    vector.store %v, %dst[%i] : memref<4096xf32>, vector<8xf32>
+  }
+  return
+}
+
+// CHECK-LABEL: func.func @streaming_copy
+//       CHECK:   scf.for %[[IV:.+]] = %c0 to %c4096 step %c8
+//   CHECK-DAG:     %[[DIST:.+]] = arith.constant 4 : index
+//       CHECK:     %[[LEAD:.+]] = arith.muli %c8{{.*}}, %[[DIST]]
+//       CHECK:     %[[LEADIV:.+]] = arith.addi %[[IV]], %[[LEAD]]
+//       CHECK:     memref.prefetch %{{.+}}[%[[LEADIV]]], read, locality<3>, data
+//  CHECK-NEXT:     vector.load
+//       CHECK:     memref.prefetch %{{.+}}[%[[LEADIV]]], write, locality<3>, data
+//  CHECK-NEXT:     vector.store
+
+// -----
+
+// Indirect streams: the index buffer load is prefetched ahead while the
+// gathered data access (not directly indexed by the IV) is untouched.
+
+func.func @embedding_sum(%indices: memref<1024xindex>,
+                         %table: memref<100000xf32>,
+                         %out: memref<f32>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c1024 = arith.constant 1024 : index
+  %zero = arith.constant 0.0 : f32
+  %sum = scf.for %i = %c0 to %c1024 step %c1 iter_args(%acc = %zero) -> (f32) {
+    %idx = memref.load %indices[%i] : memref<1024xindex>
+    %val = memref.load %table[%idx] : memref<100000xf32>
+    %next = arith.addf %acc, %val : f32
+    scf.yield %next : f32
+  }
+  memref.store %sum, %out[] : memref<f32>
+  return
+}
+
+// CHECK-LABEL: func.func @embedding_sum
+//       CHECK:   scf.for %[[IV:.+]] =
+//       CHECK:     %[[LEADIV:.+]] = arith.addi %[[IV]],
+//       CHECK:     memref.prefetch %{{.+}}[%[[LEADIV]]], read, locality<3>, data
+//  CHECK-NEXT:     memref.load %{{.+}}[%[[IV]]]
+//   CHECK-NOT:     memref.prefetch
+//       CHECK:     memref.load
+
+// -----
+
+// Only innermost loops are touched.
+
+func.func @nested(%src: memref<64x64xf32>, %dst: memref<64x64xf32>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c64 = arith.constant 64 : index
+  scf.for %i = %c0 to %c64 step %c1 {
+    scf.for %j = %c0 to %c64 step %c1 {
+      %v = memref.load %src[%i, %j] : memref<64x64xf32>
+      memref.store %v, %dst[%i, %j] : memref<64x64xf32>
+    }
+  }
+  return
+}
+
+// CHECK-LABEL: func.func @nested
+//       CHECK:   scf.for %[[I:.+]] =
+//   CHECK-NOT:     arith.muli
+//       CHECK:     scf.for %[[J:.+]] =
+//       CHECK:       %[[LEADJ:.+]] = arith.addi %[[J]],
+//       CHECK:       memref.prefetch %{{.+}}[%[[I]], %[[LEADJ]]], read, locality<3>, data
+//       CHECK:       memref.prefetch %{{.+}}[%[[I]], %[[LEADJ]]], write, locality<3>, data
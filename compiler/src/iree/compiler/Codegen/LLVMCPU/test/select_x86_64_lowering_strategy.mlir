@@ -1655,3 +1655,39 @@ module {
 //     CHECK:    linalg.generic
 // CHECK-SAME:     {lowering_config = #[[CONFIG]]}
 
+
+// -----
+
+#executable_target_embedded_elf_x86_64_ = #hal.executable.target<"llvm-cpu", "embedded-elf-x86_64", {cpu_features = "+avx512f", data_layout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128",
+      native_vector_size = 64 : index, target_triple = "x86_64-none-elf"}>
+module {
+  func.func @horizontally_fused_matmul() attributes {hal.executable.target = #executable_target_embedded_elf_x86_64_} {
+    %c0 = arith.constant 0 : index
+    %cst = arith.constant 0.000000e+00 : f32
+    %0 = hal.interface.binding.subspan set(0) binding(0) type(storage_buffer) alignment(64) offset(%c0) : !flow.dispatch.tensor<readonly:tensor<384x512xf32>>
+    %1 = hal.interface.binding.subspan set(0) binding(1) type(storage_buffer) alignment(64) offset(%c0) : !flow.dispatch.tensor<readonly:tensor<3x512x64xf32>>
+    %2 = hal.interface.binding.subspan set(0) binding(2) type(storage_buffer) alignment(64) offset(%c0) : !flow.dispatch.tensor<writeonly:tensor<3x384x64xf32>>
+    %3 = flow.dispatch.tensor.load %0, offsets = [0, 0], sizes = [384, 512], strides = [1, 1] : !flow.dispatch.tensor<readonly:tensor<384x512xf32>> -> tensor<384x512xf32>
+    %4 = flow.dispatch.tensor.load %1, offsets = [0, 0, 0], sizes = [3, 512, 64], strides = [1, 1, 1] : !flow.dispatch.tensor<readonly:tensor<3x512x64xf32>> -> tensor<3x512x64xf32>
+    %5 = tensor.empty() : tensor<3x384x64xf32>
+    %6 = linalg.fill ins(%cst : f32) outs(%5 : tensor<3x384x64xf32>) -> tensor<3x384x64xf32>
+    %7 = linalg.generic {indexing_maps = [affine_map<(d0, d1, d2, d3) -> (d1, d3)>, affine_map<(d0, d1, d2, d3) -> (d0, d3, d2)>, affine_map<(d0, d1, d2, d3) -> (d0, d1, d2)>], iterator_types = ["parallel", "parallel", "parallel", "reduction"]} ins(%3, %4 : tensor<384x512xf32>, tensor<3x512x64xf32>) outs(%6 : tensor<3x384x64xf32>) {
+    ^bb0(%in: f32, %in_0: f32, %out: f32):
+      %8 = arith.mulf %in, %in_0 : f32
+      %9 = arith.addf %out, %8 : f32
+      linalg.yield %9 : f32
+    } -> tensor<3x384x64xf32>
+    flow.dispatch.tensor.store %7, %2, offsets = [0, 0, 0], sizes = [3, 384, 64], strides = [1, 1, 1] : tensor<3x384x64xf32> -> !flow.dispatch.tensor<writeonly:tensor<3x384x64xf32>>
+    return
+  }
+}
+
+// The horizontally fused contraction (shared LHS, fused head dimension d0)
+// gets matmul-style tiling with all heads kept within one distribution tile
+// and unrolled at the vector level.
+//  CHECK-DAG: #[[CONFIG:.+]] = #iree_codegen.lowering_config<tile_sizes = {{\[}}[3, 64, 64, 0], [3, 8, 8, 0], [0, 0, 0, 4], [0, 0, 0, 0]]>
+//  CHECK-DAG: #[[TRANSLATION:.+]] = #iree_codegen.translation_info<CPUDoubleTilingExpert>
+//      CHECK: func.func @horizontally_fused_matmul()
+// CHECK-SAME:     translation_info = #[[TRANSLATION]]
+//      CHECK: linalg.generic
+// CHECK-SAME:     lowering_config = #[[CONFIG]]
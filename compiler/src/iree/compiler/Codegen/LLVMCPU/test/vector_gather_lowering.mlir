@@ -0,0 +1,16 @@
+// RUN: iree-opt --pass-pipeline="builtin.module(func.func(iree-llvmcpu-virtual-vector-lowering))" --split-input-file %s | FileCheck %s --check-prefixes=CHECK,SCALAR
+// RUN: iree-opt --pass-pipeline="builtin.module(func.func(iree-llvmcpu-virtual-vector-lowering{enable-native-gathers=true}))" --split-input-file %s | FileCheck %s --check-prefixes=CHECK,NATIVE
+
+// With native gathers enabled the rank-2 gather is unrolled into rank-1
+// gathers that lower to hardware gather instructions; otherwise it is
+// decomposed into conditional scalar loads.
+
+func.func @gather_2d(%base: memref<64x64xf32>, %indices: vector<2x8xindex>, %mask: vector<2x8xi1>, %pass_thru: vector<2x8xf32>) -> vector<2x8xf32> {
+  %c0 = arith.constant 0 : index
+  %0 = vector.gather %base[%c0, %c0] [%indices], %mask, %pass_thru : memref<64x64xf32>, vector<2x8xindex>, vector<2x8xi1>, vector<2x8xf32> into vector<2x8xf32>
+  return %0 : vector<2x8xf32>
+}
+//          CHECK-LABEL: func.func @gather_2d
+// NATIVE-COUNT-2: vector.gather {{.+}} into vector<8xf32>
+//     NATIVE-NOT: vector.gather {{.+}} into vector<2x8xf32>
+//     SCALAR-NOT: vector.gather
@@ -162,6 +162,25 @@ getTensorCoreConfig(SmallVectorImpl<TileWorkgroupSizePair> &tileSizes,
   }
 }
 
+/// Returns the number of software pipeline stages the shared memory budget of
+/// the target can sustain for the given tensorcore tile sizes. Each stage
+/// double-buffers the LHS and RHS workgroup tiles in shared memory, so deep
+/// pipelines on large tiles can exceed the limit reported by the target
+/// description; trim stages (down to no pipelining) until the buffers fit.
+static unsigned adjustPipelineDepthForSharedMemory(
+    const TileWorkgroupSizePair &config, Type elementType,
+    int64_t sharedMemoryLimitInBytes) {
+  unsigned elementBits = elementType.getIntOrFloatBitWidth();
+  int64_t stageBytes = (config.tileSize[0] * config.tileSize[2] +
+                        config.tileSize[2] * config.tileSize[1]) *
+                       elementBits / 8;
+  int64_t depth = config.pipelineDepth;
+  while (depth > 1 && depth * stageBytes > sharedMemoryLimitInBytes) {
+    --depth;
+  }
+  return depth;
+}
+
 // Get the target arch associated with the immediate parent.
 static StringRef getTargetArch(mlir::FunctionOpInterface entryPoint) {
   if (auto targetAttr = IREE::HAL::ExecutableTargetAttr::lookup(entryPoint)) {
@@ -833,10 +852,12 @@ static LogicalResult setContractConfig(mlir::FunctionOpInterface entryPoint,
             sizeM % config.tileSize[0] == 0) {
           IREE::Codegen::DispatchLoweringPassPipeline codegenPipeline =
               getTensorCorePipeline(elementType);
+          unsigned pipelineDepth = adjustPipelineDepthForSharedMemory(
+              config, elementType, targetInfo.sharedMemoryLimitInBytes);
           return setMatmulConfig(
               config.tileSize[0], config.tileSize[1], config.tileSize[2],
               config.workgroupSize, targetInfo.supportedSubgroupSizes,
-              sizeK == config.tileSize[2] ? 1 : config.pipelineDepth,
+              sizeK == config.tileSize[2] ? 1 : pipelineDepth,
               codegenPipeline);
         }
       }
@@ -67,6 +67,12 @@ static llvm::cl::opt<unsigned> clReorderWorkgroupsLogSwizzleTile(
     llvm::cl::desc("Reorder workgroups: log tile size to use"),
     llvm::cl::init(3));
 
+static llvm::cl::opt<bool> clEnableAttentionDecomposition(
+    "iree-llvmgpu-enable-attention-decomposition",
+    llvm::cl::desc("Decomposes attention ops with the built-in online-softmax "
+                   "lowering instead of relying on transform scripts"),
+    llvm::cl::init(false));
+
 static llvm::cl::opt<int64_t> clLLVMGPUSharedMemoryLimit(
     "iree-llvmgpu-shared-memory-limit",
     llvm::cl::desc("specify the maximum amount of shared memory allowed to be "
@@ -186,9 +192,11 @@ tileAndDistributeToWorkgroup(OpPassManager &funcPassManager,
 
   funcPassManager.addPass(createConvertToDestinationPassingStylePass(
       useWARForCooperativeMatrixCodegen));
-  // TODO(#16421): Disable decomposition due to failure in bufferization.
-  // funcPassManager.addPass(
-  //     IREE::LinalgExt::createTileAndDecomposeAttentionPass());
+  // TODO(#16421): Enable by default once the bufferization failure is fixed.
+  if (clEnableAttentionDecomposition) {
+    funcPassManager.addPass(
+        IREE::LinalgExt::createTileAndDecomposeAttentionPass());
+  }
   funcPassManager.addPass(createCanonicalizerPass());
   funcPassManager.addPass(createCSEPass());
 }
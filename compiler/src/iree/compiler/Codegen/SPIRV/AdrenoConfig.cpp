@@ -21,14 +21,21 @@
 namespace mlir::iree_compiler::detail {
 
 static LogicalResult setAdrenoMatmulConfig(linalg::LinalgOp op,
-                                           spirv::ResourceLimitsAttr limits) {
+                                           const spirv::TargetEnv &targetEnv) {
+  spirv::ResourceLimitsAttr limits = targetEnv.getResourceLimits();
   const int subgroupSize = limits.getSubgroupSize();
   const std::array<int64_t, 2> workgroupXY = {subgroupSize / 2, 2};
   std::array<int64_t, 3> threadMNK;
   auto inputType =
       llvm::cast<ShapedType>(op.getDpsInputOperand(0)->get().getType());
-  if (IREE::Util::getTypeBitWidth(inputType.getElementType()) == 16) {
+  Type elementType = inputType.getElementType();
+  if (IREE::Util::getTypeBitWidth(elementType) == 16) {
     threadMNK = {16, 8, 8};
+  } else if (elementType.isInteger(8) &&
+             allowsIntegerDotProductOps(targetEnv)) {
+    // Deepen the K tile so each thread accumulates full 4xi8 dot product ops
+    // along the reduction dimension.
+    threadMNK = {16, 4, 16};
   } else {
     threadMNK = {16, 4, 4};
   }
@@ -49,7 +56,7 @@ LogicalResult setAdrenoCodeGenConfig(const spirv::TargetEnv &targetEnv,
 
   auto linalgOp = cast<linalg::LinalgOp>(rootOp);
   if (isMatmulOrBatchMatmul(linalgOp))
-    return setAdrenoMatmulConfig(linalgOp, limits);
+    return setAdrenoMatmulConfig(linalgOp, targetEnv);
 
   if (auto convOp = dyn_cast<linalg::ConvolutionOpInterface>(rootOp)) {
     // Use the result type in case of larger bitwidth for accumulators.
@@ -778,6 +778,15 @@ LogicalResult setMatmulOpConfig(spirv::ResourceLimitsAttr limits,
       CodeGenPipeline::SPIRVBaseVectorize, workgroupSize);
 }
 
+bool allowsIntegerDotProductOps(const spirv::TargetEnv &targetEnv) {
+  // Query all the dot prod capabilities except for the packed one -- none of
+  // the vectorization patterns need it.
+  return targetEnv.allows(spirv::Extension::SPV_KHR_integer_dot_product) &&
+         targetEnv.allows(spirv::Capability::DotProduct) &&
+         targetEnv.allows(spirv::Capability::DotProductInput4x8Bit) &&
+         targetEnv.allows(spirv::Capability::DotProductInputAll);
+}
+
 } // namespace detail
 
 //===----------------------------------------------------------------------===//
@@ -1624,8 +1633,14 @@ static LogicalResult setSPIRVOpConfig(const spirv::TargetEnv &targetEnv,
         std::array<int64_t, 2> workgroupXY = {32, 2};
         std::array<int64_t, 3> threadMNK;
         auto inputType = llvm::cast<ShapedType>(op.getInputs()[0].getType());
-        if (IREE::Util::getTypeBitWidth(inputType.getElementType()) == 16) {
+        Type elementType = inputType.getElementType();
+        if (IREE::Util::getTypeBitWidth(elementType) == 16) {
           threadMNK = {8, 8, 8};
+        } else if (elementType.isInteger(8) &&
+                   detail::allowsIntegerDotProductOps(targetEnv)) {
+          // Deepen the K tile so each thread accumulates full 4xi8 dot
+          // product ops along the reduction dimension.
+          threadMNK = {8, 8, 16};
         } else {
           threadMNK = {8, 8, 4};
         }
@@ -71,6 +71,11 @@ LogicalResult setMatmulOpConfig(
     unsigned softwarePipelineStoreStage =
         defaultSimtSoftwarePipelineStoreStage);
 
+/// Returns true when the given target environment supports the full set of
+/// SPV_KHR_integer_dot_product capabilities used when vectorizing i8 matmuls
+/// to dot product ops.
+bool allowsIntegerDotProductOps(const spirv::TargetEnv &targetEnv);
+
 /// Sets CodeGen configurations via attributes to the given matmul `linalgOp`
 /// with tile sizes for cooperative matrix, if possible for the given matmul
 /// size.
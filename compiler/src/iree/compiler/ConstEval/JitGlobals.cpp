@@ -15,8 +15,13 @@
 #include "iree/compiler/Utils/PassUtils.h"
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA256.h"
 #include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
+#include "mlir/AsmParser/AsmParser.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/IR/Builders.h"
 #include "mlir/IR/BuiltinAttributes.h"
@@ -43,6 +48,14 @@ static llvm::cl::opt<bool> clEnableDebug(
         "don't want to run a debug compiler)."),
     llvm::cl::init(false));
 
+static llvm::cl::opt<std::string> clCacheDir(
+    "iree-consteval-jit-cache-dir",
+    llvm::cl::desc(
+        "Directory for a persistent cache of evaluated initializer results "
+        "keyed on the serialized IR and target configuration. Cache hits skip "
+        "JIT'ing and evaluation entirely. Empty disables caching."),
+    llvm::cl::init(""));
+
 namespace {
 
 static bool isDebugEnabled() {
@@ -405,8 +418,114 @@ struct JitFunctionDesc {
   std::string name;
   llvm::SmallVector<ArgumentBinding> argumentBindings;
   llvm::SmallVector<ResultBinding> resultBindings;
+  // Content hash of the function IR, argument values, and target
+  // configuration used to address the persistent cache. Empty if the function
+  // could not be keyed (or caching is disabled).
+  std::string cacheKey;
 };
 
+// Computes a content hash uniquely identifying a JIT function: the target
+// device configuration, the serialized IR of the extracted function, and the
+// contents of all bound arguments. Returns an empty string if the function
+// cannot be keyed (e.g. an argument global has no value yet).
+static std::string computeJitFunctionCacheKey(StringRef targetDevice,
+                                              Operation *funcOp,
+                                              JitFunctionDesc &desc) {
+  llvm::SHA256 hasher;
+  auto updateString = [&](StringRef value) {
+    hasher.update(value);
+    hasher.update(StringRef("\0", 1));
+  };
+  updateString(targetDevice);
+  {
+    std::string ir;
+    llvm::raw_string_ostream os(ir);
+    funcOp->print(os);
+    updateString(os.str());
+  }
+  for (ArgumentBinding &arg : desc.argumentBindings) {
+    Attribute valueAttr;
+    switch (arg.getType()) {
+    case ArgumentBinding::Type::ElementsAttr:
+      valueAttr = arg.getElementsAttr();
+      break;
+    case ArgumentBinding::Type::GlobalOp:
+      valueAttr = arg.getGlobalOp().getGlobalInitialValue();
+      break;
+    }
+    if (!valueAttr)
+      return "";
+    std::string text;
+    llvm::raw_string_ostream os(text);
+    valueAttr.print(os);
+    updateString(os.str());
+  }
+  return llvm::toHex(hasher.final(), /*LowerCase=*/true);
+}
+
+static void getCacheEntryPath(StringRef cacheDir, JitFunctionDesc &desc,
+                              llvm::SmallVectorImpl<char> &path) {
+  path.assign(cacheDir.begin(), cacheDir.end());
+  llvm::sys::path::append(path, desc.cacheKey + ".consteval");
+}
+
+// Attempts to load previously evaluated results for |desc| from |cacheDir|.
+// On a hit the result values are applied directly to the bound globals (the
+// same thing evaluation would do) and true is returned. Unparseable or
+// mismatched entries are treated as misses.
+static bool tryApplyCachedResults(MLIRContext *context, StringRef cacheDir,
+                                  JitFunctionDesc &desc) {
+  if (desc.cacheKey.empty())
+    return false;
+  llvm::SmallString<128> path;
+  getCacheEntryPath(cacheDir, desc, path);
+  auto fileOr = llvm::MemoryBuffer::getFile(path, /*IsText=*/true);
+  if (!fileOr)
+    return false;
+  auto arrayAttr = llvm::dyn_cast_or_null<ArrayAttr>(
+      mlir::parseAttribute(fileOr.get()->getBuffer(), context));
+  if (!arrayAttr || arrayAttr.size() != desc.resultBindings.size())
+    return false;
+  for (auto [attr, resultBinding] :
+       llvm::zip_equal(arrayAttr.getValue(), desc.resultBindings)) {
+    auto typedAttr = llvm::dyn_cast<TypedAttr>(attr);
+    if (!typedAttr ||
+        typedAttr.getType() != resultBinding.getGlobalOp().getGlobalType()) {
+      return false;
+    }
+  }
+  for (auto [attr, resultBinding] :
+       llvm::zip_equal(arrayAttr.getValue(), desc.resultBindings)) {
+    resultBinding.getGlobalOp().setGlobalInitialValue(cast<TypedAttr>(attr));
+  }
+  return true;
+}
+
+// Stores the evaluated results of |desc| (read back from the globals they
+// were applied to) into |cacheDir|. Failures are silently ignored: the cache
+// is purely an optimization and must never fail compilation.
+static void storeCachedResults(MLIRContext *context, StringRef cacheDir,
+                               JitFunctionDesc &desc) {
+  if (desc.cacheKey.empty())
+    return;
+  SmallVector<Attribute> resultAttrs;
+  for (ResultBinding &resultBinding : desc.resultBindings) {
+    auto valueAttr = resultBinding.getGlobalOp().getGlobalInitialValue();
+    if (!valueAttr)
+      return;
+    resultAttrs.push_back(valueAttr);
+  }
+  if (llvm::sys::fs::create_directories(cacheDir))
+    return;
+  llvm::SmallString<128> path;
+  getCacheEntryPath(cacheDir, desc, path);
+  std::error_code ec;
+  llvm::raw_fd_ostream os(path, ec);
+  if (ec)
+    return;
+  os << ArrayAttr::get(context, resultAttrs);
+}
+
 // Clones all object-like symbols used within the function.
 // Objects are only cloned once if used by multiple functions.
 // All object contents are cloned and symbol DCE is relied on to remove any
@@ -818,8 +937,37 @@ struct JitGlobalsPass : public JitGlobalsBase<JitGlobalsPass> {
                      << initializerOp << "\n";
       }
     }
+    // Consult the persistent cache (if enabled) before compiling anything:
+    // functions whose IR and argument contents hash to a previously evaluated
+    // entry have their results applied directly and drop out of the JIT
+    // program.
+    if (!clCacheDir.empty()) {
+      SymbolTable jitSymbolTable(programBuilder.getTargetModule());
+      llvm::SmallVector<JitFunctionDesc> missedFunctions;
+      for (JitFunctionDesc &jitFunction : programBuilder.getJitFunctions()) {
+        auto *funcOp = jitSymbolTable.lookup(jitFunction.name);
+        jitFunction.cacheKey =
+            funcOp ? computeJitFunctionCacheKey(requestedTargetDevice, funcOp,
+                                                jitFunction)
+                   : std::string();
+        if (tryApplyCachedResults(&getContext(), clCacheDir, jitFunction)) {
+          if (debugEnabled) {
+            llvm::dbgs() << "::: Loaded cached consteval results for "
+                         << jitFunction.name << "\n";
+          }
+          funcOp->erase();
+        } else {
+          missedFunctions.push_back(std::move(jitFunction));
+        }
+      }
+      programBuilder.getJitFunctions() = std::move(missedFunctions);
+    }
+
     if (programBuilder.getJitFunctions().empty()) {
       programBuilder.getTargetModule()->erase();
+      for (auto deadOp : deadInitOps) {
+        deadOp.erase();
+      }
       return;
     }
 
@@ -853,6 +1001,13 @@ struct JitGlobalsPass : public JitGlobalsBase<JitGlobalsPass> {
       return;
     }
 
+    // Persist the freshly evaluated results for future compilations.
+    if (!clCacheDir.empty()) {
+      for (JitFunctionDesc &jitFunction : programBuilder.getJitFunctions()) {
+        storeCachedResults(&getContext(), clCacheDir, jitFunction);
+      }
+    }
+
     // Cleanup any initializers we replaced.
     // We do this after running the JIT-ed functions because we have deep
     // references into ops and attributes that need to be converted to
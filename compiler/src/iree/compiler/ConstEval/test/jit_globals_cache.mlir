@@ -0,0 +1,21 @@
+// RUN: rm -rf %t && iree-opt --iree-consteval-jit-globals --iree-consteval-jit-cache-dir=%t %s | FileCheck %s
+// RUN: iree-opt --iree-consteval-jit-globals --iree-consteval-jit-cache-dir=%t --iree-consteval-jit-debug %s 2>&1 | FileCheck --check-prefix=CACHED %s
+
+// The first run populates the cache; the second run must produce identical
+// results from the cached entry without compiling or invoking anything.
+
+// CHECK: util.global private @hoisted = dense<4> : tensor<2xi32>
+// CACHED: Loaded cached consteval results for jit_eval
+// CACHED: util.global private @hoisted = dense<4> : tensor<2xi32>
+module @eval_cached {
+  util.global private @hoisted : tensor<2xi32>
+  util.func public @main() -> tensor<2xi32> {
+    %hoisted = util.global.load @hoisted : tensor<2xi32>
+    util.return %hoisted : tensor<2xi32>
+  }
+  util.initializer {
+    %cst = arith.constant dense<[4, 4]> : tensor<2xi32>
+    util.global.store %cst, @hoisted : tensor<2xi32>
+    util.return
+  }
+}
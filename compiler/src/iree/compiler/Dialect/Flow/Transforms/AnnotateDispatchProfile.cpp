@@ -0,0 +1,124 @@
+// Copyright 2026 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/compiler/Dialect/Flow/IR/FlowOps.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/Pass/Pass.h"
+
+namespace mlir::iree_compiler::IREE::Flow {
+
+#define GEN_PASS_DEF_ANNOTATEDISPATCHPROFILEPASS
+#include "iree/compiler/Dialect/Flow/Transforms/Passes.h.inc"
+
+// Attribute carrying the measured execution time of a dispatch in
+// microseconds. Attached to flow.executable.export ops and their dispatch
+// sites so later heuristics can prefer measured costs over static estimates.
+static constexpr char kProfileAttrName[] = "flow.dispatch.profile_us";
+
+namespace {
+
+// Parses a dispatch profile file into a map of dispatch name to measured
+// microseconds. The format is one `<dispatch name>,<microseconds>` entry per
+// line with `#` comments; names may optionally be qualified as
+// `<executable>::<export>` to disambiguate. When a name is measured multiple
+// times the fastest sample wins.
+static LogicalResult parseDispatchProfile(StringRef contents,
+                                          llvm::StringMap<int64_t> &profile) {
+  SmallVector<StringRef> lines;
+  contents.split(lines, '\n', /*MaxSplit=*/-1, /*KeepEmpty=*/false);
+  for (auto line : lines) {
+    line = line.trim();
+    if (line.empty() || line.starts_with("#"))
+      continue;
+    auto [name, timeStr] = line.rsplit(',');
+    name = name.trim();
+    int64_t timeUs = 0;
+    if (name.empty() || timeStr.trim().getAsInteger(10, timeUs) || timeUs < 0)
+      return failure();
+    auto it = profile.find(name);
+    if (it == profile.end() || timeUs < it->second) {
+      profile[name] = timeUs;
+    }
+  }
+  return success();
+}
+
+struct AnnotateDispatchProfilePass
+    : public IREE::Flow::impl::AnnotateDispatchProfilePassBase<
+          AnnotateDispatchProfilePass> {
+  using IREE::Flow::impl::AnnotateDispatchProfilePassBase<
+      AnnotateDispatchProfilePass>::AnnotateDispatchProfilePassBase;
+
+  void runOnOperation() override {
+    auto moduleOp = getOperation();
+    if (profilePath.empty())
+      return;
+
+    auto fileOr = llvm::MemoryBuffer::getFile(profilePath, /*IsText=*/true);
+    if (!fileOr) {
+      moduleOp.emitError() << "failed to open dispatch profile file '"
+                           << profilePath << "'";
+      return signalPassFailure();
+    }
+    llvm::StringMap<int64_t> profile;
+    if (failed(parseDispatchProfile(fileOr.get()->getBuffer(), profile))) {
+      moduleOp.emitError() << "failed to parse dispatch profile file '"
+                           << profilePath
+                           << "' (expected `<dispatch name>,<microseconds>` "
+                              "per line)";
+      return signalPassFailure();
+    }
+
+    // Annotate exports whose (possibly qualified) name was measured and
+    // remember the refs so dispatch sites can be annotated below.
+    Builder builder(&getContext());
+    DenseMap<Attribute, int64_t> annotatedRefs;
+    for (auto executableOp :
+         moduleOp.getBody()->getOps<IREE::Flow::ExecutableOp>()) {
+      for (auto exportOp :
+           executableOp.getBlock().getOps<ExecutableExportOp>()) {
+        auto qualifiedName =
+            (executableOp.getName() + "::" + exportOp.getSymName()).str();
+        auto it = profile.find(qualifiedName);
+        if (it == profile.end())
+          it = profile.find(exportOp.getSymName());
+        if (it == profile.end())
+          continue;
+        exportOp->setAttr(kProfileAttrName,
+                          builder.getI64IntegerAttr(it->second));
+        auto refAttr = SymbolRefAttr::get(
+            &getContext(), executableOp.getName(),
+            {SymbolRefAttr::get(&getContext(), exportOp.getSymName())});
+        annotatedRefs[refAttr] = it->second;
+      }
+    }
+
+    // Annotate dispatch sites with the fastest measured entry point they may
+    // resolve to.
+    for (auto funcOp : moduleOp.getOps<mlir::FunctionOpInterface>()) {
+      funcOp->walk([&](IREE::Flow::DispatchOp dispatchOp) {
+        std::optional<int64_t> timeUs;
+        for (auto entryPointRef : dispatchOp.getEntryPointRefs()) {
+          auto it = annotatedRefs.find(entryPointRef);
+          if (it == annotatedRefs.end())
+            continue;
+          timeUs = timeUs ? std::min(*timeUs, it->second) : it->second;
+        }
+        if (timeUs) {
+          dispatchOp->setAttr(kProfileAttrName,
+                              builder.getI64IntegerAttr(*timeUs));
+        }
+      });
+    }
+  }
+};
+
+} // namespace
+
+} // namespace mlir::iree_compiler::IREE::Flow
@@ -0,0 +1,173 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/compiler/Dialect/Flow/IR/FlowOps.h"
+#include "iree/compiler/Dialect/Flow/Transforms/RegionOpUtils.h"
+#include "llvm/Support/Debug.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Interfaces/FunctionInterfaces.h"
+#include "mlir/Pass/Pass.h"
+
+#define DEBUG_TYPE "iree-flow-balance-dispatch-granularity"
+
+namespace mlir::iree_compiler::IREE::Flow {
+
+#define GEN_PASS_DEF_BALANCEDISPATCHGRANULARITYPASS
+#include "iree/compiler/Dialect/Flow/Transforms/Passes.h.inc"
+
+namespace {
+
+// Sentinel cost for regions containing dynamic shapes or ops we cannot model.
+// Such regions are never considered "trivially small".
+static constexpr int64_t kUnknownCost = INT64_MAX;
+
+static int64_t saturatingAdd(int64_t lhs, int64_t rhs) {
+  if (lhs == kUnknownCost || rhs == kUnknownCost ||
+      lhs > kUnknownCost - rhs) {
+    return kUnknownCost;
+  }
+  return lhs + rhs;
+}
+
+static int64_t costOfDomain(ArrayRef<int64_t> domain) {
+  int64_t product = 1;
+  for (int64_t size : domain) {
+    if (ShapedType::isDynamic(size))
+      return kUnknownCost;
+    if (size != 0 && product > kUnknownCost / size)
+      return kUnknownCost;
+    product *= size;
+  }
+  return product;
+}
+
+// Estimates the evaluation cost of a dispatch region as the sum of the
+// iteration domains of the structured ops it contains. This mirrors the cost
+// model used by --iree-flow-annotate-dispatches for dispatch naming: it is a
+// coarse proxy for dispatch duration but is monotonic enough to separate
+// overhead-dominated microdispatches from well-sized ones.
+static int64_t
+estimateDispatchRegionCost(IREE::Flow::DispatchRegionOp regionOp) {
+  int64_t totalCost = 0;
+  regionOp.getBody().walk([&](Operation *op) {
+    int64_t opCost = 0;
+    if (auto linalgOp = dyn_cast<linalg::LinalgOp>(op)) {
+      opCost = costOfDomain(linalgOp.getStaticLoopRanges());
+    } else if (isa<TilingInterface>(op)) {
+      // Unmodeled tileable op; assume it dominates the dispatch.
+      opCost = kUnknownCost;
+    }
+    totalCost = saturatingAdd(totalCost, opCost);
+  });
+  return totalCost;
+}
+
+// Returns true if |sourceOp| can be folded into the later |targetOp| without
+// breaking dominance: every use of its results must be inside of or dominated
+// by |targetOp| and it must not carry its own workload/workgroup count that
+// would be lost in the merge.
+static bool canMergeDispatchRegions(IREE::Flow::DispatchRegionOp sourceOp,
+                                    IREE::Flow::DispatchRegionOp targetOp) {
+  if (!sourceOp.getWorkload().empty() ||
+      !sourceOp.getWorkgroupCount().empty()) {
+    return false;
+  }
+  if (sourceOp->getBlock() != targetOp->getBlock() ||
+      !sourceOp->isBeforeInBlock(targetOp)) {
+    return false;
+  }
+  for (Value result : sourceOp.getResults()) {
+    for (Operation *user : result.getUsers()) {
+      // Direct operand uses on the target (workload/result dims) would become
+      // self-references after the merge.
+      if (user == targetOp)
+        return false;
+      Operation *ancestor = sourceOp->getBlock()->findAncestorOpInBlock(*user);
+      if (!ancestor)
+        return false;
+      if (ancestor != targetOp && !targetOp->isBeforeInBlock(ancestor))
+        return false;
+    }
+  }
+  return true;
+}
+
+// Merges |sourceOp| into the later |targetOp| by inlining its body into the
+// parent block and then moving the inlined ops into |targetOp|. Returns the
+// merged dispatch region (a new op replacing |targetOp|).
+static FailureOr<IREE::Flow::DispatchRegionOp>
+mergeDispatchRegions(RewriterBase &rewriter,
+                     IREE::Flow::DispatchRegionOp sourceOp,
+                     IREE::Flow::DispatchRegionOp targetOp) {
+  Block &bodyBlock = sourceOp.getBody().front();
+  auto returnOp = cast<IREE::Flow::ReturnOp>(bodyBlock.getTerminator());
+  SmallVector<Value> yieldedValues(returnOp.getOperands());
+  SmallVector<Operation *> inlinedOps;
+  for (Operation &op : bodyBlock.without_terminator()) {
+    inlinedOps.push_back(&op);
+  }
+  rewriter.eraseOp(returnOp);
+  rewriter.inlineBlockBefore(&bodyBlock, sourceOp);
+  rewriter.replaceOp(sourceOp, yieldedValues);
+  return movePrecedingOpsIntoDispatchRegion(rewriter, inlinedOps, targetOp);
+}
+
+struct BalanceDispatchGranularityPass
+    : public IREE::Flow::impl::BalanceDispatchGranularityPassBase<
+          BalanceDispatchGranularityPass> {
+  using IREE::Flow::impl::BalanceDispatchGranularityPassBase<
+      BalanceDispatchGranularityPass>::BalanceDispatchGranularityPassBase;
+  void runOnOperation() override {
+    mlir::FunctionOpInterface funcOp = getOperation();
+    IRRewriter rewriter(&getContext());
+
+    // Step 1: Merge runs of trivially small neighboring regions. Merging the
+    // previous region into the current one keeps the walk order valid and
+    // allows chains of microdispatches to collapse into a single region while
+    // the accumulated cost stays below the threshold.
+    SmallVector<IREE::Flow::DispatchRegionOp> regionOps;
+    funcOp.walk([&](IREE::Flow::DispatchRegionOp regionOp) {
+      regionOps.push_back(regionOp);
+    });
+    IREE::Flow::DispatchRegionOp previousOp;
+    int64_t previousCost = kUnknownCost;
+    for (auto regionOp : regionOps) {
+      int64_t cost = estimateDispatchRegionCost(regionOp);
+      if (previousOp && previousCost < smallDispatchCost &&
+          cost < smallDispatchCost &&
+          canMergeDispatchRegions(previousOp, regionOp)) {
+        auto mergedOp = mergeDispatchRegions(rewriter, previousOp, regionOp);
+        if (failed(mergedOp)) {
+          return signalPassFailure();
+        }
+        regionOp = *mergedOp;
+        cost = saturatingAdd(previousCost, cost);
+        LLVM_DEBUG(llvm::dbgs() << "// merged dispatch regions; new cost: "
+                                << cost << "\n");
+      }
+      previousOp = regionOp;
+      previousCost = cost;
+    }
+
+    // Step 2: Annotate the final regions with their estimated cost so that
+    // later phases (and developers reading dumps) have granularity feedback.
+    // Regions with dynamic shapes have no static estimate and are skipped.
+    funcOp.walk([&](IREE::Flow::DispatchRegionOp regionOp) {
+      int64_t cost = estimateDispatchRegionCost(regionOp);
+      if (cost != kUnknownCost) {
+        regionOp->setAttr("flow.dispatch.cost",
+                          rewriter.getI64IntegerAttr(cost));
+      }
+    });
+  }
+};
+
+} // namespace
+
+} // namespace mlir::iree_compiler::IREE::Flow
@@ -750,7 +750,13 @@ isFusableWithProducer(OpOperand &operand,
 
   if (!options.aggressiveFusion) {
     auto consumerLinalgOp = cast<linalg::LinalgOp>(consumer);
-    if (!consumerLinalgOp.isDpsInit(&operand)) {
+    // Elementwise chains (norm scalings, rope, residual adds) feeding a root
+    // through regular input operands are cheap to recompute in-dispatch and
+    // each saved dispatch is a saved kernel launch; fuse them when requested.
+    bool isFusableElementwiseChain =
+        options.fuseElementwiseChains &&
+        linalg::isElementwise(cast<linalg::LinalgOp>(producer));
+    if (!consumerLinalgOp.isDpsInit(&operand) && !isFusableElementwiseChain) {
       return false;
     }
   }
@@ -778,9 +784,17 @@ fuseRootsWithProducers(MLIRContext *context, Operation *root, unsigned groupNum,
         continue;
       }
 
+      // Multi-use elementwise producers may still fuse into their dominating
+      // consumer when chain fusion is requested; other uses read the value
+      // from the dispatch result.
+      auto producerLinalgOp = dyn_cast<linalg::LinalgOp>(producer);
+      bool relaxMultiUse =
+          options.aggressiveFusion ||
+          (options.fuseElementwiseChains && producerLinalgOp &&
+           linalg::isElementwise(producerLinalgOp));
       std::optional<OpOperand *> fusableUse =
           getFusableUse(producer, dominanceInfo,
-                        /*aggressiveFusion=*/options.aggressiveFusion);
+                        /*aggressiveFusion=*/relaxMultiUse);
       if (!fusableUse || fusableUse.value()->getOwner() != candidate)
         continue;
 
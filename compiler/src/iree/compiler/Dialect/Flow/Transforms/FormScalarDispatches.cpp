@@ -197,10 +197,24 @@ void FormScalarDispatchesPass::runOnOperation() {
       }
 
       if (!isSliceRoot(scalarWorkloadLimit, prevOp)) {
-        if (isClonableIntoDispatchOp(prevOp)) {
-          continue;
-        }
-        break;
+        // Scan past non-scalar operations instead of ending the dispatch at
+        // the first one: scalar islands separated by heavy compute ops can
+        // then still merge into a single dispatch instead of paying a
+        // dispatch each. Legality of moving ops past them is guaranteed by
+        // the use check below.
+        continue;
+      }
+
+      // Fused ops sink to the position of the root so all of their users must
+      // either move into a dispatch as well or come after the root.
+      if (!llvm::all_of(prevOp->getUsers(), [&](Operation *user) {
+            if (opToRootMap.count(user)) {
+              return true;
+            }
+            Operation *ancestorOp = currBlock->findAncestorOpInBlock(*user);
+            return ancestorOp && op->isBeforeInBlock(ancestorOp);
+          })) {
+        continue;
       }
 
       didHorizontalFusion = true;
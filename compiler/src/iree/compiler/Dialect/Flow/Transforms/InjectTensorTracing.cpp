@@ -10,11 +10,14 @@
 #include "iree/compiler/Dialect/Flow/IR/FlowOps.h"
 #include "iree/compiler/Dialect/Flow/Transforms/Passes.h"
 #include "iree/compiler/Dialect/Util/IR/UtilDialect.h"
+#include "iree/compiler/Dialect/Util/IR/UtilOps.h"
+#include "llvm/ADT/TypeSwitch.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
 #include "mlir/Dialect/Tensor/IR/Tensor.h"
 #include "mlir/IR/Builders.h"
 #include "mlir/IR/BuiltinTypes.h"
-#include "mlir/IR/Diagnostics.h"
 #include "mlir/Pass/Pass.h"
 #include "mlir/Transforms/RegionUtils.h"
 
@@ -49,31 +52,140 @@ static SmallVector<Value> getTensorOperands(Operation *op) {
   return filterTensorValues(op->getOperands());
 }
 
-static void injectTracingOnOp(Operation *op, StringRef traceKey) {
-  OpBuilder builder(op);
-  auto inputTensors = getTensorOperands(op);
-  if (!inputTensors.empty()) {
-    builder.create<IREE::Flow::TensorTraceOp>(
-        op->getLoc(), builder.getStringAttr(traceKey + " inputs"),
-        inputTensors);
+// Returns true if an on-device statistical summary can be computed for
+// |tensor| (ranked with a floating-point element type).
+static bool canSummarizeTensor(Value tensor) {
+  auto tensorType = dyn_cast<RankedTensorType>(tensor.getType());
+  return tensorType && isa<FloatType>(tensorType.getElementType());
+}
+
+// Converts scalar |value| of float type to f32.
+static Value castToF32(Location loc, OpBuilder &builder, Value value) {
+  auto f32Type = builder.getF32Type();
+  if (value.getType() == f32Type)
+    return value;
+  if (cast<FloatType>(value.getType()).getWidth() < 32)
+    return builder.create<arith::ExtFOp>(loc, f32Type, value);
+  return builder.create<arith::TruncFOp>(loc, f32Type, value);
+}
+
+// Builds a reduction of |tensor| to a tensor<4xf32> holding
+// [min, max, mean, nan-count]. NaN elements are excluded from min/max/mean so
+// that the summary stays informative even when a few elements have gone bad;
+// their count is reported separately.
+static Value buildTensorSummary(Location loc, OpBuilder &builder,
+                                Value tensor) {
+  auto tensorType = cast<RankedTensorType>(tensor.getType());
+  auto elementType = cast<FloatType>(tensorType.getElementType());
+  int64_t rank = tensorType.getRank();
+  auto *context = builder.getContext();
+
+  // Scalar init values: min starts at +inf, max at -inf.
+  auto &semantics = elementType.getFloatSemantics();
+  Value posInf = builder.create<arith::ConstantOp>(
+      loc, builder.getFloatAttr(elementType,
+                                APFloat::getInf(semantics, /*Negative=*/false)));
+  Value negInf = builder.create<arith::ConstantOp>(
+      loc, builder.getFloatAttr(elementType,
+                                APFloat::getInf(semantics, /*Negative=*/true)));
+  Value zero = builder.create<arith::ConstantOp>(
+      loc, builder.getFloatAttr(elementType, 0.0));
+  auto makeAccumulator = [&](Value initValue) {
+    Value emptyOp = builder.create<tensor::EmptyOp>(loc, ArrayRef<int64_t>{},
+                                                    elementType);
+    return builder
+        .create<linalg::FillOp>(loc, ValueRange{initValue},
+                                ValueRange{emptyOp})
+        .result();
+  };
+  SmallVector<Value> accumulators = {
+      makeAccumulator(posInf),  // min
+      makeAccumulator(negInf),  // max
+      makeAccumulator(zero),    // sum
+      makeAccumulator(zero),    // nan-count
+  };
+
+  // Single full reduction computing all four statistics in one pass.
+  SmallVector<AffineMap> indexingMaps;
+  indexingMaps.push_back(builder.getMultiDimIdentityMap(rank));
+  for (int i = 0; i < 4; ++i) {
+    indexingMaps.push_back(AffineMap::get(rank, 0, context));
   }
+  SmallVector<utils::IteratorType> iteratorTypes(
+      rank, utils::IteratorType::reduction);
+  auto scalarTensorType = RankedTensorType::get({}, elementType);
+  auto genericOp = builder.create<linalg::GenericOp>(
+      loc,
+      TypeRange{scalarTensorType, scalarTensorType, scalarTensorType,
+                scalarTensorType},
+      ValueRange{tensor}, accumulators, indexingMaps, iteratorTypes,
+      [&](OpBuilder &b, Location nestedLoc, ValueRange args) {
+        Value element = args[0];
+        Value isNan = b.create<arith::CmpFOp>(
+            nestedLoc, arith::CmpFPredicate::UNO, element, element);
+        Value one = b.create<arith::ConstantOp>(
+            nestedLoc, b.getFloatAttr(elementType, 1.0));
+        Value zeroValue = b.create<arith::ConstantOp>(
+            nestedLoc, b.getFloatAttr(elementType, 0.0));
+        // Ordered comparisons are false for NaN so NaN elements keep the
+        // running min/max instead of poisoning them.
+        Value isLess = b.create<arith::CmpFOp>(
+            nestedLoc, arith::CmpFPredicate::OLT, element, args[1]);
+        Value newMin =
+            b.create<arith::SelectOp>(nestedLoc, isLess, element, args[1]);
+        Value isGreater = b.create<arith::CmpFOp>(
+            nestedLoc, arith::CmpFPredicate::OGT, element, args[2]);
+        Value newMax =
+            b.create<arith::SelectOp>(nestedLoc, isGreater, element, args[2]);
+        Value summand =
+            b.create<arith::SelectOp>(nestedLoc, isNan, zeroValue, element);
+        Value newSum = b.create<arith::AddFOp>(nestedLoc, args[3], summand);
+        Value nanIncrement =
+            b.create<arith::SelectOp>(nestedLoc, isNan, one, zeroValue);
+        Value newNanCount =
+            b.create<arith::AddFOp>(nestedLoc, args[4], nanIncrement);
+        b.create<linalg::YieldOp>(nestedLoc,
+                                  ValueRange{newMin, newMax, newSum,
+                                             newNanCount});
+      });
 
-  builder.setInsertionPointAfter(op);
-  auto outputTensors = filterTensorValues(op->getResults());
-  if (!outputTensors.empty()) {
-    builder.create<IREE::Flow::TensorTraceOp>(
-        op->getLoc(), builder.getStringAttr(traceKey + " outputs"),
-        outputTensors);
+  auto extractScalar = [&](Value scalarTensor) {
+    return builder.create<tensor::ExtractOp>(loc, scalarTensor, ValueRange{});
+  };
+  Value minValue = castToF32(loc, builder, extractScalar(genericOp->getResult(0)));
+  Value maxValue = castToF32(loc, builder, extractScalar(genericOp->getResult(1)));
+  Value sumValue = castToF32(loc, builder, extractScalar(genericOp->getResult(2)));
+  Value nanCount = castToF32(loc, builder, extractScalar(genericOp->getResult(3)));
+
+  // mean = sum / element-count (folds to a constant for static shapes).
+  Value elementCount = builder.create<arith::ConstantIndexOp>(loc, 1);
+  for (int64_t i = 0; i < rank; ++i) {
+    Value dim = builder.create<tensor::DimOp>(loc, tensor, i);
+    elementCount = builder.create<arith::MulIOp>(loc, elementCount, dim);
   }
+  Value elementCountI64 = builder.create<arith::IndexCastOp>(
+      loc, builder.getI64Type(), elementCount);
+  Value elementCountF32 = builder.create<arith::SIToFPOp>(
+      loc, builder.getF32Type(), elementCountI64);
+  Value meanValue =
+      builder.create<arith::DivFOp>(loc, sumValue, elementCountF32);
+
+  return builder.create<tensor::FromElementsOp>(
+      loc, ValueRange{minValue, maxValue, meanValue, nanCount});
 }
 
 struct InjectTensorTracingPass
     : public IREE::Flow::impl::InjectTensorTracingPassBase<
           InjectTensorTracingPass> {
+  using IREE::Flow::impl::InjectTensorTracingPassBase<
+      InjectTensorTracingPass>::InjectTensorTracingPassBase;
   void runOnOperation() override {
+    auto moduleOp = getOperation();
+    if (moduleOp.getBody()->empty())
+      return;
+    moduleBuilder = OpBuilder(&moduleOp.getBody()->front());
     auto attrName = StringAttr::get(&getContext(), "iree.tensor.trace");
-    auto funcOp = getOperation();
-    funcOp.walk([&](Operation *op) {
+    moduleOp.walk([&](Operation *op) {
       if (auto attr = op->getAttr(attrName)) {
         std::string traceKey;
         if (auto stringAttr = dyn_cast<StringAttr>(attr))
@@ -85,6 +197,94 @@ struct InjectTensorTracingPass
       }
     });
   }
+
+private:
+  // Emits trace ops for |tensors| with the given |key|. When statistics are
+  // requested float tensors are reduced on-device to a [min, max, mean,
+  // nan-count] summary traced under a derived key so only 16 bytes per tensor
+  // leave the device; tensors that cannot be summarized trace in full.
+  void buildTraceOps(Location loc, OpBuilder &builder, const Twine &key,
+                     ArrayRef<Value> tensors) {
+    SmallVector<Value> fullTensors;
+    SmallVector<Value> summaryTensors;
+    for (auto tensor : tensors) {
+      if (statistics && canSummarizeTensor(tensor)) {
+        summaryTensors.push_back(buildTensorSummary(loc, builder, tensor));
+      } else {
+        fullTensors.push_back(tensor);
+      }
+    }
+    if (!summaryTensors.empty()) {
+      builder.create<IREE::Flow::TensorTraceOp>(
+          loc,
+          builder.getStringAttr(key + " stats(min,max,mean,nan-count)"),
+          summaryTensors);
+    }
+    if (!fullTensors.empty()) {
+      builder.create<IREE::Flow::TensorTraceOp>(
+          loc, builder.getStringAttr(key), fullTensors);
+    }
+  }
+
+  // Emits a per-trace-point invocation counter and returns an i1 that is true
+  // once every |sampleRate| executions.
+  Value buildSamplePredicate(Location loc, OpBuilder &builder) {
+    auto globalName = (StringRef("__tensor_trace_sample_") +
+                       std::to_string(nextUniqueSampleCounterId++))
+                          .str();
+    auto i64Type = moduleBuilder.getI64Type();
+    auto globalOp = moduleBuilder.create<IREE::Util::GlobalOp>(
+        loc, globalName, /*isMutable=*/true, i64Type,
+        moduleBuilder.getI64IntegerAttr(0));
+    globalOp.setPrivate();
+
+    Value counter =
+        globalOp.createLoadOp(loc, builder).getLoadedGlobalValue();
+    Value one = builder.create<arith::ConstantIntOp>(loc, 1, 64);
+    Value next = builder.create<arith::AddIOp>(loc, counter, one);
+    globalOp.createStoreOp(loc, next, builder);
+    Value rate = builder.create<arith::ConstantIntOp>(loc, sampleRate, 64);
+    Value rem = builder.create<arith::RemUIOp>(loc, counter, rate);
+    Value zero = builder.create<arith::ConstantIntOp>(loc, 0, 64);
+    return builder.create<arith::CmpIOp>(loc, arith::CmpIPredicate::eq, rem,
+                                         zero);
+  }
+
+  void injectTracingOnOp(Operation *op, StringRef traceKey) {
+    auto loc = op->getLoc();
+    OpBuilder builder(op);
+
+    // When sampling, a single predicate guards both the input and output
+    // traces of the op so a sampled invocation is always captured whole.
+    Value samplePredicate;
+    if (sampleRate > 1)
+      samplePredicate = buildSamplePredicate(loc, builder);
+    auto buildGuardedTraceOps = [&](OpBuilder &builder, const Twine &key,
+                                    ArrayRef<Value> tensors) {
+      if (!samplePredicate) {
+        buildTraceOps(loc, builder, key, tensors);
+        return;
+      }
+      auto ifOp = builder.create<scf::IfOp>(loc, samplePredicate,
+                                            /*withElseRegion=*/false);
+      auto thenBuilder = ifOp.getThenBodyBuilder();
+      buildTraceOps(loc, thenBuilder, key, tensors);
+    };
+
+    auto inputTensors = getTensorOperands(op);
+    if (!inputTensors.empty()) {
+      buildGuardedTraceOps(builder, traceKey + " inputs", inputTensors);
+    }
+
+    builder.setInsertionPointAfter(op);
+    auto outputTensors = filterTensorValues(op->getResults());
+    if (!outputTensors.empty()) {
+      buildGuardedTraceOps(builder, traceKey + " outputs", outputTensors);
+    }
+  }
+
+  OpBuilder moduleBuilder{static_cast<MLIRContext *>(nullptr)};
+  int nextUniqueSampleCounterId = 0;
 };
 
 } // namespace mlir::iree_compiler::IREE::Flow
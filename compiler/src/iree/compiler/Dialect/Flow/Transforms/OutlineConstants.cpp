@@ -107,6 +107,21 @@ static std::string getConstantName(ConstantDef &def) {
   return str;
 }
 
+// Returns true if two globals are interchangeable: identical in all attributes
+// (initial value, hoisted attrs such as affinities, etc) besides their name.
+static bool areGlobalsInterchangeable(IREE::Util::GlobalOp lhs,
+                                      IREE::Util::GlobalOp rhs) {
+  auto getAttrsExceptName = [](Operation *op) {
+    SmallVector<NamedAttribute> attrs;
+    for (auto attr : op->getAttrs()) {
+      if (attr.getName() != SymbolTable::getSymbolAttrName())
+        attrs.push_back(attr);
+    }
+    return attrs;
+  };
+  return getAttrsExceptName(lhs) == getAttrsExceptName(rhs);
+}
+
 //===----------------------------------------------------------------------===//
 // --iree-flow-outline-constants
 //===----------------------------------------------------------------------===//
@@ -120,6 +135,11 @@ struct OutlineConstantsPass
 
     SymbolTable moduleSymbols(moduleOp);
 
+    // Pool of already-outlined globals bucketed by constant value so that
+    // identical constants (common when several models are linked into one
+    // program and share weights) get a single rodata entry.
+    DenseMap<Attribute, SmallVector<IREE::Util::GlobalOp>> constantPool;
+
     // Create all top-level util.globals from constants in the module.
     std::vector<std::pair<Operation *, IREE::Util::GlobalOp>> replacements;
     for (auto &def : findConstantsInModule(moduleOp)) {
@@ -138,8 +158,6 @@ struct OutlineConstantsPass
       globalOp.setPrivate();
       IREE::Util::HoistableAttrInterface::gatherHoistableAttrs(def.op,
                                                                globalOp);
-      moduleSymbols.insert(globalOp); // uniques name
-      replacements.emplace_back(def.op, globalOp);
 
       // Prevent the variable from being re-inlined if the canonicalizer runs.
       // By the time we've outlined things here we are sure we want them
@@ -147,6 +165,23 @@ struct OutlineConstantsPass
       // now and when we may use that information (HAL constant pooling, etc).
       globalOp.setInliningPolicyAttr(
           moduleBuilder.getAttr<IREE::Util::InlineNeverAttr>());
+
+      // Reuse an existing global if one carries the same value and attrs.
+      // Constants that differ only in hoisted attrs (affinities, etc) are kept
+      // distinct as later placement passes rely on them.
+      auto &pooledOps = constantPool[def.value];
+      auto it = llvm::find_if(pooledOps, [&](IREE::Util::GlobalOp pooledOp) {
+        return areGlobalsInterchangeable(pooledOp, globalOp);
+      });
+      if (it != pooledOps.end()) {
+        globalOp.erase();
+        replacements.emplace_back(def.op, *it);
+        continue;
+      }
+
+      moduleSymbols.insert(globalOp); // uniques name
+      pooledOps.push_back(globalOp);
+      replacements.emplace_back(def.op, globalOp);
     }
 
     // Replace all of the constants with lookups for the new variables.
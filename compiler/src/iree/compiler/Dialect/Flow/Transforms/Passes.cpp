@@ -13,6 +13,7 @@
 #include "iree/compiler/Utils/PassUtils.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ToolOutputFile.h"
+#include "mlir/Conversion/SCFToControlFlow/SCFToControlFlow.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/Dialect/Linalg/Passes.h"
 #include "mlir/Dialect/MemRef/Transforms/Passes.h"
@@ -51,6 +52,31 @@ static llvm::cl::opt<std::string> clTraceDispatch(
                    "deduplication (@function_name:<index>) and tracing all "
                    "occurrences of the dispatch symbol."),
     llvm::cl::init(""));
+static llvm::cl::opt<int64_t> clTensorTraceSampleRate(
+    "iree-flow-tensor-trace-sample-rate",
+    llvm::cl::desc("Only trace 1 of every N invocations of each "
+                   "`iree.tensor.trace` point (1 = trace every invocation)."),
+    llvm::cl::init(1));
+static llvm::cl::opt<bool> clTensorTraceStatistics(
+    "iree-flow-tensor-trace-statistics",
+    llvm::cl::desc("Trace on-device min/max/mean/nan-count summaries of float "
+                   "tensors at `iree.tensor.trace` points instead of full "
+                   "tensor contents."),
+    llvm::cl::init(false));
+
+static llvm::cl::list<int64_t> clSpecializeDispatchShapeBuckets(
+    "iree-flow-specialize-dispatch-shape-buckets",
+    llvm::cl::desc("Dynamic dimension sizes to emit shape-specialized dispatch "
+                   "variants for, selected at runtime with a generic fallback "
+                   "for unmatched sizes."),
+    llvm::cl::CommaSeparated);
+
+static llvm::cl::opt<std::string> clDispatchProfileFile(
+    "iree-flow-dispatch-profile-file",
+    llvm::cl::desc("Path to a `<dispatch name>,<microseconds>` profile file "
+                   "captured from a previous run used to annotate dispatches "
+                   "with measured timings."),
+    llvm::cl::init(""));
 
 static llvm::cl::opt<bool> clDetensoring(
     "iree-flow-enable-detensoring",
@@ -247,6 +273,9 @@ void addDispatchRegionCreationPasses(OpPassManager &passManager,
       .addPass(IREE::Flow::createCloneProducersIntoDispatchRegionsPass)
       // Collapse dimensions of linalg Ops.
       .addPass(IREE::Flow::createCollapseDimensionsPass)
+      // Merge overhead-dominated microdispatches and annotate dispatch costs
+      // before committing to the final dispatch granularity.
+      .addPass(IREE::Flow::createBalanceDispatchGranularityPass)
       // Convert dispatch regions into dispatch workgroups by capturing values.
       .addPass(IREE::Flow::createFormDispatchWorkgroupsPass);
 }
@@ -258,8 +287,11 @@ void buildFlowTransformPassPipeline(OpPassManager &passManager,
 
   // Inject tensor tracing early as we need to have the tracers in the IR
   // prior to dispatch region formation where we may lose access to them.
-  FunctionLikeNest(passManager)
-      .addPass(IREE::Flow::createInjectTensorTracingPass);
+  InjectTensorTracingPassOptions injectTensorTracingOptions;
+  injectTensorTracingOptions.sampleRate = clTensorTraceSampleRate;
+  injectTensorTracingOptions.statistics = clTensorTraceStatistics;
+  passManager.addPass(
+      IREE::Flow::createInjectTensorTracingPass(injectTensorTracingOptions));
 
   // Transform pad operations into linalg.fill + tensor.insert_slice.
   // This is a WAR for not having native pad handling.
@@ -288,6 +320,21 @@ void buildFlowTransformPassPipeline(OpPassManager &passManager,
 
   addDispatchRegionCreationPasses(passManager, transformOptions);
 
+  // Expand dispatches over declared hot shape buckets into guarded
+  // specializations selected by the actual dimension at record time.
+  if (!clSpecializeDispatchShapeBuckets.empty()) {
+    FunctionLikeNest(passManager)
+        .addPass([&]() {
+          SpecializeDispatchShapesPassOptions options;
+          options.bucketSizes = llvm::to_vector(
+              clSpecializeDispatchShapeBuckets);
+          return IREE::Flow::createSpecializeDispatchShapesPass(options);
+        })
+        // Later Flow/Stream phases only expect unstructured control flow in
+        // host functions so lower the selection chains immediately.
+        .addPass(mlir::createConvertSCFToCFPass);
+  }
+
   FunctionLikeNest(passManager)
       .addPass(IREE::Flow::createCaptureDynamicDimsPass)
       .addPass(mlir::createCanonicalizerPass)
@@ -307,6 +354,13 @@ void buildFlowTransformPassPipeline(OpPassManager &passManager,
   // runtime profiling/tracing.
   passManager.addPass(IREE::Flow::createAnnotateDispatchesPass());
 
+  // Feed back measured per-dispatch timings (keyed by the names assigned
+  // above) from a prior profiling run, if provided.
+  if (!clDispatchProfileFile.empty()) {
+    passManager.addPass(IREE::Flow::createAnnotateDispatchProfilePass(
+        AnnotateDispatchProfilePassOptions{clDispatchProfileFile}));
+  }
+
   // Trace/break dispatches by ordinal in the specified region. There is a
   // similar version of the pass run both before and after deduplication
   // depending on if the target is specified by ordinal or by symbol.
@@ -366,10 +420,14 @@ void buildFlowTransformPassPipeline(OpPassManager &passManager,
       // dispatches. We do this after deduping so that the executable names
       // match later stages.
       .addPredicatedPass(clTraceDispatchTensors,
-                         IREE::Flow::createInjectDispatchTracingPass)
-      // Inject tensor tracing late for any attributes that were added by the
-      // passes above after we've formed dispatch regions.
-      .addPass(IREE::Flow::createInjectTensorTracingPass)
+                         IREE::Flow::createInjectDispatchTracingPass);
+
+  // Inject tensor tracing late for any attributes that were added by the
+  // passes above after we've formed dispatch regions.
+  passManager.addPass(
+      IREE::Flow::createInjectTensorTracingPass(injectTensorTracingOptions));
+
+  FunctionLikeNest(passManager)
       // Cleanup the IR after we are done.
       .addPass(IREE::Flow::createCleanupTensorShapesPass);
 
@@ -0,0 +1,109 @@
+// Copyright 2026 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/compiler/Dialect/Flow/IR/FlowDialect.h"
+#include "iree/compiler/Dialect/Flow/IR/FlowOps.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/IRMapping.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/Pass/Pass.h"
+
+namespace mlir::iree_compiler::IREE::Flow {
+
+#define GEN_PASS_DEF_SPECIALIZEDISPATCHSHAPESPASS
+#include "iree/compiler/Dialect/Flow/Transforms/Passes.h.inc"
+
+namespace {
+
+// Returns the first non-constant workload dimension of |dispatchOp| or
+// nullptr if the workload is fully static. Specialization keys on a single
+// dimension today; the leading dynamic dimension is almost always the
+// data-dependent one (batch/sequence length) on decode-style dispatches.
+static Value selectSpecializationDim(
+    IREE::Flow::DispatchWorkgroupsOp dispatchOp) {
+  for (Value workload : dispatchOp.getWorkload()) {
+    if (workload.getType().isIndex() && !matchPattern(workload, m_Constant()))
+      return workload;
+  }
+  return nullptr;
+}
+
+// Expands |dispatchOp| into a guarded chain that selects a shape-specialized
+// clone when the dynamic dimension matches one of |bucketSizes| and falls
+// back to the original generic dispatch otherwise:
+//   %r = scf.if %dim == 128 {
+//     specialized dispatch with %dim pinned to 128
+//   } else {
+//     ... next bucket or the generic dispatch ...
+//   }
+// Each specialized clone sees a constant dimension which closure optimization
+// inlines into the region, so the clones are outlined into their own
+// executables and compiled as static-shape code. Selection happens in host
+// code at command buffer record time.
+static void specializeDispatchOp(IREE::Flow::DispatchWorkgroupsOp dispatchOp,
+                                 ArrayRef<int64_t> bucketSizes) {
+  Value dim = selectSpecializationDim(dispatchOp);
+  if (!dim)
+    return;
+
+  auto loc = dispatchOp.getLoc();
+  OpBuilder builder(dispatchOp);
+  scf::IfOp outerIfOp;
+  for (int64_t bucketSize : bucketSizes) {
+    Value bucket = builder.create<arith::ConstantIndexOp>(loc, bucketSize);
+    Value cond = builder.create<arith::CmpIOp>(loc, arith::CmpIPredicate::eq,
+                                               dim, bucket);
+    auto ifOp = builder.create<scf::IfOp>(loc, dispatchOp.getResultTypes(),
+                                          cond, /*addThenBlock=*/true,
+                                          /*addElseBlock=*/true);
+    if (outerIfOp) {
+      builder.create<scf::YieldOp>(loc, ifOp.getResults());
+    } else {
+      outerIfOp = ifOp;
+    }
+
+    // Specialized clone with the selected dimension pinned to the bucket.
+    auto thenBuilder = OpBuilder::atBlockBegin(ifOp.thenBlock());
+    IRMapping mapping;
+    mapping.map(dim, bucket);
+    auto *specializedOp = thenBuilder.clone(*dispatchOp, mapping);
+    thenBuilder.create<scf::YieldOp>(loc, specializedOp->getResults());
+
+    builder = OpBuilder::atBlockBegin(ifOp.elseBlock());
+  }
+
+  // Generic fallback for dimensions outside all buckets.
+  auto *fallbackOp = builder.clone(*dispatchOp);
+  builder.create<scf::YieldOp>(loc, fallbackOp->getResults());
+
+  dispatchOp->replaceAllUsesWith(outerIfOp.getResults());
+  dispatchOp->erase();
+}
+
+struct SpecializeDispatchShapesPass
+    : public IREE::Flow::impl::SpecializeDispatchShapesPassBase<
+          SpecializeDispatchShapesPass> {
+  using IREE::Flow::impl::SpecializeDispatchShapesPassBase<
+      SpecializeDispatchShapesPass>::SpecializeDispatchShapesPassBase;
+
+  void runOnOperation() override {
+    if (bucketSizes.empty())
+      return;
+    SmallVector<IREE::Flow::DispatchWorkgroupsOp> dispatchOps;
+    getOperation()->walk([&](IREE::Flow::DispatchWorkgroupsOp dispatchOp) {
+      dispatchOps.push_back(dispatchOp);
+    });
+    for (auto dispatchOp : dispatchOps) {
+      specializeDispatchOp(dispatchOp, bucketSizes);
+    }
+  }
+};
+
+} // namespace
+
+} // namespace mlir::iree_compiler::IREE::Flow
@@ -32,8 +32,25 @@ static llvm::cl::list<int64_t> topkSplitReductionRatio(
     llvm::cl::desc("comma separated list of split ratios"),
     llvm::cl::CommaSeparated);
 
-static LogicalResult splitReductionOnMatmul(
-    RewriterBase &rewriter, linalg::MatmulOp op,
+static llvm::cl::opt<int64_t> genericSplitReductionThreshold(
+    "iree-flow-split-generic-reduction-threshold",
+    llvm::cl::desc("minimum static reduction size at which single-combiner "
+                   "generic reductions are split into a partial stage and a "
+                   "final combine stage; 0 disables"),
+    llvm::cl::init(0));
+
+static llvm::cl::opt<int64_t> genericSplitReductionRatio(
+    "iree-flow-split-generic-reduction-ratio",
+    llvm::cl::desc("split ratio for long generic reductions; 0 derives one "
+                   "from the reduction size"),
+    llvm::cl::init(0));
+
+// Largest split ratio derived by the size heuristic. Bounds the number of
+// partial results so the combine stage stays a single small dispatch.
+static constexpr int64_t kMaxDerivedSplitRatio = 128;
+
+static LogicalResult splitReductionOnOp(
+    RewriterBase &rewriter, linalg::LinalgOp op,
     linalg::ControlSplitReductionFn controlSplitReductionFn) {
   // Since user information about compilation are passed through attributes we
   // need to make sure to propagate those.
@@ -55,7 +72,8 @@ struct SplitReductionPass
     : public IREE::Flow::impl::SplitReductionPassBase<SplitReductionPass> {
   void runOnOperation() override {
     if (splitReductionRatio.getValue() <= 1 &&
-        topkSplitReductionRatio.empty()) {
+        topkSplitReductionRatio.empty() &&
+        genericSplitReductionThreshold.getValue() <= 0) {
       return;
     }
 
@@ -71,9 +89,63 @@ struct SplitReductionPass
 
     SmallVector<linalg::MatmulOp> matmulCandidates;
     IRRewriter rewriter(context);
-    funcOp->walk([&](linalg::MatmulOp op) { matmulCandidates.push_back(op); });
+    if (splitReductionRatio.getValue() > 1) {
+      funcOp->walk(
+          [&](linalg::MatmulOp op) { matmulCandidates.push_back(op); });
+    }
     for (auto op : matmulCandidates) {
-      (void)splitReductionOnMatmul(rewriter, op, matmulSplitReductionControlFn);
+      (void)splitReductionOnOp(rewriter, op, matmulSplitReductionControlFn);
+    }
+
+    // Long single-combiner reductions (softmax denominators, norm layers)
+    // otherwise lower to a single workgroup per row and leave the device
+    // mostly idle. Split them into a wide partial-reduction stage and a small
+    // final combine stage; each becomes its own dispatch.
+    auto genericSplitReductionControlFn =
+        [&](linalg::LinalgOp op) -> linalg::SplitReductionOptions {
+      linalg::SplitReductionOptions noSplit = {0, 0, /*innerParallel=*/false};
+      SmallVector<int64_t> bounds = op.getStaticLoopRanges();
+      SmallVector<unsigned> reductionDims;
+      op.getReductionDims(reductionDims);
+      int64_t reductionSize = 1;
+      for (unsigned dim : reductionDims) {
+        if (ShapedType::isDynamic(bounds[dim]))
+          return noSplit;
+        reductionSize *= bounds[dim];
+      }
+      int64_t threshold = genericSplitReductionThreshold.getValue();
+      if (reductionSize < threshold)
+        return noSplit;
+      int64_t ratio = genericSplitReductionRatio.getValue();
+      if (ratio <= 1) {
+        // Derive the split from the reduction size: as many partials as the
+        // ratio cap allows while each partial stays at least threshold-sized
+        // so the combine stage remains negligible.
+        ratio = 1;
+        while (ratio * 2 <= kMaxDerivedSplitRatio &&
+               reductionSize % (ratio * 2) == 0 &&
+               reductionSize / (ratio * 2) >= threshold) {
+          ratio *= 2;
+        }
+      }
+      if (ratio <= 1 || reductionSize % ratio != 0)
+        return noSplit;
+      // As with matmul the new parallel dimension leads so the partial stage
+      // distributes across workgroups on it.
+      return {ratio, 0, /*innerParallel=*/false};
+    };
+
+    SmallVector<linalg::GenericOp> genericCandidates;
+    if (genericSplitReductionThreshold.getValue() > 0) {
+      funcOp->walk([&](linalg::GenericOp op) {
+        if (op.getNumReductionLoops() > 0)
+          genericCandidates.push_back(op);
+      });
+    }
+    for (auto op : genericCandidates) {
+      // Ops without a supported neutral-element combiner fail to split and
+      // are left untouched.
+      (void)splitReductionOnOp(rewriter, op, genericSplitReductionControlFn);
     }
 
     LinalgExt::TopkSplitReductionControlFn topkSplitReductionControlFn =
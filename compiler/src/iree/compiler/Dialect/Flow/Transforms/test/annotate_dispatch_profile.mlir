@@ -0,0 +1,50 @@
+// RUN: printf '# measured with iree-benchmark-module\nex0::dispatch0,123\ndispatch1,500\ndispatch1,450\n' > %t.csv
+// RUN: iree-opt --pass-pipeline='builtin.module(iree-flow-annotate-dispatch-profile{profile-path=%t.csv})' %s | FileCheck %s
+
+// Profile entries match exports by qualified or bare dispatch name; repeated
+// measurements keep the fastest sample. Unmeasured dispatches are untouched.
+
+flow.executable private @ex0 {
+  // CHECK: flow.executable.export public @dispatch0
+  // CHECK-SAME: flow.dispatch.profile_us = 123
+  flow.executable.export public @dispatch0
+  builtin.module {
+    func.func @dispatch0() {
+      return
+    }
+  }
+}
+flow.executable private @ex1 {
+  // CHECK: flow.executable.export public @dispatch1
+  // CHECK-SAME: flow.dispatch.profile_us = 450
+  flow.executable.export public @dispatch1
+  builtin.module {
+    func.func @dispatch1() {
+      return
+    }
+  }
+}
+flow.executable private @ex2 {
+  // CHECK: flow.executable.export public @dispatch2
+  // CHECK-NOT: flow.dispatch.profile_us
+  flow.executable.export public @dispatch2
+  builtin.module {
+    func.func @dispatch2() {
+      return
+    }
+  }
+}
+util.func public @main() -> (tensor<4x8xf32>, tensor<8x4xf32>, tensor<4xf32>) {
+  %c100 = arith.constant 100 : index
+  %c50 = arith.constant 50 : index
+  // CHECK: flow.dispatch @ex0::@dispatch0
+  // CHECK-SAME: flow.dispatch.profile_us = 123
+  %0 = flow.dispatch @ex0::@dispatch0[%c100, %c50]() : () -> tensor<4x8xf32>
+  // CHECK: flow.dispatch @ex1::@dispatch1
+  // CHECK-SAME: flow.dispatch.profile_us = 450
+  %1 = flow.dispatch @ex1::@dispatch1[%c100, %c50]() : () -> tensor<8x4xf32>
+  // CHECK: flow.dispatch @ex2::@dispatch2
+  // CHECK-NOT: flow.dispatch.profile_us
+  %2 = flow.dispatch @ex2::@dispatch2[%c100, %c50]() : () -> tensor<4xf32>
+  util.return %0, %1, %2 : tensor<4x8xf32>, tensor<8x4xf32>, tensor<4xf32>
+}
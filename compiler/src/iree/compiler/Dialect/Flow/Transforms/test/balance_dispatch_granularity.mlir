@@ -0,0 +1,84 @@
+// RUN: iree-opt --split-input-file --pass-pipeline="builtin.module(util.func(iree-flow-balance-dispatch-granularity))" %s | FileCheck %s
+
+#map = affine_map<(d0, d1) -> (d0, d1)>
+util.func public @mergeSmallNeighbors(%arg0: tensor<4x8xf32>) -> tensor<4x8xf32> {
+  %0 = flow.dispatch.region -> (tensor<4x8xf32>) {
+    %empty = tensor.empty() : tensor<4x8xf32>
+    %1 = linalg.generic {indexing_maps = [#map, #map], iterator_types = ["parallel", "parallel"]} ins(%arg0 : tensor<4x8xf32>) outs(%empty : tensor<4x8xf32>) {
+    ^bb0(%in: f32, %out: f32):
+      %2 = arith.addf %in, %in : f32
+      linalg.yield %2 : f32
+    } -> tensor<4x8xf32>
+    flow.return %1 : tensor<4x8xf32>
+  }
+  %3 = flow.dispatch.region -> (tensor<4x8xf32>) {
+    %empty_0 = tensor.empty() : tensor<4x8xf32>
+    %4 = linalg.generic {indexing_maps = [#map, #map], iterator_types = ["parallel", "parallel"]} ins(%0 : tensor<4x8xf32>) outs(%empty_0 : tensor<4x8xf32>) {
+    ^bb0(%in: f32, %out: f32):
+      %5 = arith.mulf %in, %in : f32
+      linalg.yield %5 : f32
+    } -> tensor<4x8xf32>
+    flow.return %4 : tensor<4x8xf32>
+  }
+  util.return %3 : tensor<4x8xf32>
+}
+// Both regions are far below the cost threshold so they collapse into a
+// single dispatch annotated with the combined cost.
+// CHECK-LABEL: @mergeSmallNeighbors
+// CHECK:       %[[REGION:.+]] = flow.dispatch.region
+// CHECK-SAME:    flow.dispatch.cost = 64
+// CHECK:         linalg.generic
+// CHECK:         linalg.generic
+// CHECK-NOT:   flow.dispatch.region
+// CHECK:       util.return %[[REGION]]
+
+// -----
+
+#map = affine_map<(d0, d1) -> (d0, d1)>
+util.func public @keepLargeDispatches(%arg0: tensor<128x128xf32>) -> tensor<128x128xf32> {
+  %0 = flow.dispatch.region -> (tensor<128x128xf32>) {
+    %empty = tensor.empty() : tensor<128x128xf32>
+    %1 = linalg.generic {indexing_maps = [#map, #map], iterator_types = ["parallel", "parallel"]} ins(%arg0 : tensor<128x128xf32>) outs(%empty : tensor<128x128xf32>) {
+    ^bb0(%in: f32, %out: f32):
+      %2 = arith.addf %in, %in : f32
+      linalg.yield %2 : f32
+    } -> tensor<128x128xf32>
+    flow.return %1 : tensor<128x128xf32>
+  }
+  %3 = flow.dispatch.region -> (tensor<128x128xf32>) {
+    %empty_0 = tensor.empty() : tensor<128x128xf32>
+    %4 = linalg.generic {indexing_maps = [#map, #map], iterator_types = ["parallel", "parallel"]} ins(%0 : tensor<128x128xf32>) outs(%empty_0 : tensor<128x128xf32>) {
+    ^bb0(%in: f32, %out: f32):
+      %5 = arith.mulf %in, %in : f32
+      linalg.yield %5 : f32
+    } -> tensor<128x128xf32>
+    flow.return %4 : tensor<128x128xf32>
+  }
+  util.return %3 : tensor<128x128xf32>
+}
+// Well-sized dispatches stay separate but still get cost annotations.
+// CHECK-LABEL: @keepLargeDispatches
+// CHECK:       flow.dispatch.region
+// CHECK-SAME:    flow.dispatch.cost = 16384
+// CHECK:       flow.dispatch.region
+// CHECK-SAME:    flow.dispatch.cost = 16384
+
+// -----
+
+#map = affine_map<(d0) -> (d0)>
+util.func public @skipDynamicCost(%arg0: tensor<?xf32>, %dim: index) -> tensor<?xf32> {
+  %0 = flow.dispatch.region -> (tensor<?xf32>{%dim}) {
+    %empty = tensor.empty(%dim) : tensor<?xf32>
+    %1 = linalg.generic {indexing_maps = [#map, #map], iterator_types = ["parallel"]} ins(%arg0 : tensor<?xf32>) outs(%empty : tensor<?xf32>) {
+    ^bb0(%in: f32, %out: f32):
+      %2 = arith.addf %in, %in : f32
+      linalg.yield %2 : f32
+    } -> tensor<?xf32>
+    flow.return %1 : tensor<?xf32>
+  }
+  util.return %0 : tensor<?xf32>
+}
+// Dynamic shapes have no static cost estimate and are left unannotated.
+// CHECK-LABEL: @skipDynamicCost
+// CHECK:       flow.dispatch.region
+// CHECK-NOT:   flow.dispatch.cost
@@ -0,0 +1,76 @@
+// RUN: iree-opt --pass-pipeline="builtin.module(util.func(iree-flow-form-dispatch-regions{fuse-elementwise-chains=true}))" --split-input-file %s | FileCheck %s
+
+#map = affine_map<(d0, d1) -> (d0, d1)>
+#map1 = affine_map<(d0, d1) -> (d0)>
+util.func public @elementwise_chain_into_reduction(%arg0: tensor<64x128xf32>,
+    %arg1: tensor<64x128xf32>, %arg2: tensor<64xf32>) -> tensor<64xf32> {
+  %0 = tensor.empty() : tensor<64x128xf32>
+  %1 = linalg.generic {
+      indexing_maps = [#map, #map, #map],
+      iterator_types = ["parallel", "parallel"]}
+      ins(%arg0, %arg1 : tensor<64x128xf32>, tensor<64x128xf32>)
+      outs(%0 : tensor<64x128xf32>) {
+  ^bb0(%b0: f32, %b1: f32, %b2: f32):
+    %m = arith.mulf %b0, %b1 : f32
+    linalg.yield %m : f32
+  } -> tensor<64x128xf32>
+  %2 = linalg.generic {
+      indexing_maps = [#map, #map1],
+      iterator_types = ["parallel", "reduction"]}
+      ins(%1 : tensor<64x128xf32>) outs(%arg2 : tensor<64xf32>) {
+  ^bb0(%b0: f32, %b1: f32):
+    %a = arith.addf %b0, %b1 : f32
+    linalg.yield %a : f32
+  } -> tensor<64xf32>
+  util.return %2 : tensor<64xf32>
+}
+// CHECK-LABEL: util.func public @elementwise_chain_into_reduction
+//       CHECK:   flow.dispatch.region
+//       CHECK:     linalg.generic
+//       CHECK:     linalg.generic
+//       CHECK:     flow.return
+//   CHECK-NOT:   flow.dispatch.region
+
+// -----
+
+#map = affine_map<(d0, d1) -> (d0, d1)>
+util.func public @multi_use_elementwise_producer(%arg0: tensor<64x128xf32>,
+    %arg1: tensor<64x128xf32>) -> (tensor<64x128xf32>, tensor<64x128xf32>) {
+  %0 = tensor.empty() : tensor<64x128xf32>
+  %1 = linalg.generic {
+      indexing_maps = [#map, #map],
+      iterator_types = ["parallel", "parallel"]}
+      ins(%arg0 : tensor<64x128xf32>) outs(%0 : tensor<64x128xf32>) {
+  ^bb0(%b0: f32, %b1: f32):
+    %s = arith.negf %b0 : f32
+    linalg.yield %s : f32
+  } -> tensor<64x128xf32>
+  %2 = linalg.generic {
+      indexing_maps = [#map, #map, #map],
+      iterator_types = ["parallel", "parallel"]}
+      ins(%1, %arg1 : tensor<64x128xf32>, tensor<64x128xf32>)
+      outs(%0 : tensor<64x128xf32>) {
+  ^bb0(%b0: f32, %b1: f32, %b2: f32):
+    %a = arith.addf %b0, %b1 : f32
+    linalg.yield %a : f32
+  } -> tensor<64x128xf32>
+  %3 = linalg.generic {
+      indexing_maps = [#map, #map, #map],
+      iterator_types = ["parallel", "parallel"]}
+      ins(%1, %arg1 : tensor<64x128xf32>, tensor<64x128xf32>)
+      outs(%0 : tensor<64x128xf32>) {
+  ^bb0(%b0: f32, %b1: f32, %b2: f32):
+    %s = arith.subf %b0, %b1 : f32
+    linalg.yield %s : f32
+  } -> tensor<64x128xf32>
+  util.return %2, %3 : tensor<64x128xf32>, tensor<64x128xf32>
+}
+// The multi-use producer fuses with its dominating consumer; the remaining
+// consumer reads the producer result from the first region.
+// CHECK-LABEL: util.func public @multi_use_elementwise_producer
+//       CHECK:   flow.dispatch.region
+// CHECK-COUNT-2:   linalg.generic
+//       CHECK:     flow.return
+//       CHECK:   flow.dispatch.region
+//       CHECK:     linalg.generic
+//       CHECK:     flow.return
@@ -157,3 +157,88 @@ util.func public @interleaving(
 //  CHECK-SAME:         outs(%[[EMPTY1]] :
 //       CHECK:    flow.return %[[GENERIC3]], %[[GENERIC2]]
 //       CHECK:  util.return %[[DISPATCH1]]#0, %[[DISPATCH1]]#1
+
+// -----
+
+// Scalar operations separated by non-scalar compute ops still merge into a
+// single dispatch when no dependency crosses the gap.
+
+#map = affine_map<() -> ()>
+#map1 = affine_map<(d0, d1) -> (d0, d1)>
+util.func public @horizontalAcrossBarrier(
+    %arg0 : tensor<f32>, %arg1 : tensor<f32>, %arg2 : tensor<64x64xf32>)
+    -> (tensor<f32>, tensor<f32>, tensor<64x64xf32>) {
+  %0 = tensor.empty() : tensor<f32>
+  %1 = linalg.generic {indexing_maps = [#map, #map, #map], iterator_types = []}
+      ins(%arg0, %arg1 : tensor<f32>, tensor<f32>) outs(%0 : tensor<f32>) {
+    ^bb0(%b0: f32, %b1 : f32, %b2 : f32) :
+      %2 = arith.addf %b0, %b1 : f32
+      linalg.yield %2 : f32
+    } -> tensor<f32>
+  %3 = tensor.empty() : tensor<64x64xf32>
+  %4 = linalg.generic {indexing_maps = [#map1, #map1], iterator_types = ["parallel", "parallel"]}
+      ins(%arg2 : tensor<64x64xf32>) outs(%3 : tensor<64x64xf32>) {
+    ^bb0(%b0: f32, %b1 : f32) :
+      %5 = arith.mulf %b0, %b0 : f32
+      linalg.yield %5 : f32
+    } -> tensor<64x64xf32>
+  %6 = linalg.generic {indexing_maps = [#map, #map, #map], iterator_types = []}
+      ins(%arg0, %arg1 : tensor<f32>, tensor<f32>) outs(%0 : tensor<f32>) {
+    ^bb0(%b0: f32, %b1 : f32, %b2 : f32) :
+      %7 = arith.subf %b0, %b1 : f32
+      linalg.yield %7 : f32
+    } -> tensor<f32>
+  util.return %1, %6, %4 : tensor<f32>, tensor<f32>, tensor<64x64xf32>
+}
+// CHECK-LABEL: util.func public @horizontalAcrossBarrier(
+//       CHECK:   %[[BIG:.+]] = linalg.generic
+//  CHECK-SAME:       iterator_types = ["parallel", "parallel"]
+//       CHECK:   %[[DISPATCH:.+]]:2 = flow.dispatch.region
+//       CHECK:     arith.addf
+//       CHECK:     arith.subf
+//       CHECK:     flow.return
+//       CHECK:   util.return %[[DISPATCH]]#1, %[[DISPATCH]]#0, %[[BIG]]
+
+// -----
+
+// A scalar operation feeding a non-scalar consumer cannot sink past it and
+// stays in its own dispatch.
+
+#map = affine_map<() -> ()>
+#map1 = affine_map<(d0, d1) -> (d0, d1)>
+#map2 = affine_map<(d0, d1) -> ()>
+util.func public @scalarProducerOfBarrier(
+    %arg0 : tensor<f32>, %arg1 : tensor<f32>, %arg2 : tensor<64x64xf32>)
+    -> (tensor<f32>, tensor<64x64xf32>) {
+  %0 = tensor.empty() : tensor<f32>
+  %1 = linalg.generic {indexing_maps = [#map, #map, #map], iterator_types = []}
+      ins(%arg0, %arg1 : tensor<f32>, tensor<f32>) outs(%0 : tensor<f32>) {
+    ^bb0(%b0: f32, %b1 : f32, %b2 : f32) :
+      %2 = arith.addf %b0, %b1 : f32
+      linalg.yield %2 : f32
+    } -> tensor<f32>
+  %3 = tensor.empty() : tensor<64x64xf32>
+  %4 = linalg.generic {indexing_maps = [#map1, #map2, #map1], iterator_types = ["parallel", "parallel"]}
+      ins(%arg2, %1 : tensor<64x64xf32>, tensor<f32>) outs(%3 : tensor<64x64xf32>) {
+    ^bb0(%b0: f32, %b1 : f32, %b2 : f32) :
+      %5 = arith.mulf %b0, %b1 : f32
+      linalg.yield %5 : f32
+    } -> tensor<64x64xf32>
+  %6 = linalg.generic {indexing_maps = [#map, #map, #map], iterator_types = []}
+      ins(%arg0, %arg1 : tensor<f32>, tensor<f32>) outs(%0 : tensor<f32>) {
+    ^bb0(%b0: f32, %b1 : f32, %b2 : f32) :
+      %7 = arith.subf %b0, %b1 : f32
+      linalg.yield %7 : f32
+    } -> tensor<f32>
+  util.return %6, %4 : tensor<f32>, tensor<64x64xf32>
+}
+// CHECK-LABEL: util.func public @scalarProducerOfBarrier(
+//       CHECK:   %[[DISPATCH0:.+]] = flow.dispatch.region
+//       CHECK:     arith.addf
+//       CHECK:     flow.return
+//       CHECK:   %[[BIG:.+]] = linalg.generic
+//  CHECK-SAME:       ins(%{{.+}}, %[[DISPATCH0]]
+//       CHECK:   %[[DISPATCH1:.+]] = flow.dispatch.region
+//       CHECK:     arith.subf
+//       CHECK:     flow.return
+//       CHECK:   util.return %[[DISPATCH1]], %[[BIG]]
@@ -0,0 +1,53 @@
+// RUN: iree-opt --split-input-file --pass-pipeline='builtin.module(iree-flow-inject-tensor-tracing{sample-rate=4})' --allow-unregistered-dialect %s | FileCheck %s --check-prefix=SAMPLE
+// RUN: iree-opt --split-input-file --pass-pipeline='builtin.module(iree-flow-inject-tensor-tracing{statistics=true})' --allow-unregistered-dialect %s | FileCheck %s --check-prefix=STATS
+
+// SAMPLE: util.global private mutable @__tensor_trace_sample_0 = 0 : i64
+
+// SAMPLE-LABEL: util.func public @traceFloat
+// STATS-LABEL: util.func public @traceFloat
+// SAMPLE-SAME: (%[[ARG0:.+]]: tensor<4xf32>, %[[ARG1:.+]]: tensor<4xf32>)
+util.func public @traceFloat(%arg0: tensor<4xf32>, %arg1: tensor<4xf32>) -> tensor<4xf32> {
+  //      SAMPLE: %[[COUNTER:.+]] = util.global.load @__tensor_trace_sample_0 : i64
+  //      SAMPLE: %[[NEXT:.+]] = arith.addi %[[COUNTER]], %c1
+  //      SAMPLE: util.global.store %[[NEXT]], @__tensor_trace_sample_0 : i64
+  //      SAMPLE: %[[REM:.+]] = arith.remui %[[COUNTER]], %c4
+  //      SAMPLE: %[[PRED:.+]] = arith.cmpi eq, %[[REM]], %c0
+  //      SAMPLE: scf.if %[[PRED]] {
+  // SAMPLE-NEXT:   flow.tensor.trace "arith.addf inputs" = [%[[ARG0]] : tensor<4xf32>, %[[ARG1]] : tensor<4xf32>]
+  //      SAMPLE: %[[RESULT:.+]] = arith.addf
+  //      SAMPLE: scf.if %[[PRED]] {
+  // SAMPLE-NEXT:   flow.tensor.trace "arith.addf outputs" = [%[[RESULT]] : tensor<4xf32>]
+
+  // Float tensors reduce to [min, max, mean, nan-count] summaries on-device;
+  // only the 4-element summaries are traced.
+  //      STATS: linalg.generic
+  //      STATS: flow.tensor.trace "arith.addf inputs stats(min,max,mean,nan-count)" = [%{{.+}} : tensor<4xf32>, %{{.+}} : tensor<4xf32>]
+  //      STATS: %[[RESULT:.+]] = arith.addf
+  //      STATS: flow.tensor.trace "arith.addf outputs stats(min,max,mean,nan-count)" = [%{{.+}} : tensor<4xf32>]
+  %result = arith.addf %arg0, %arg1 {iree.tensor.trace} : tensor<4xf32>
+  util.return %result : tensor<4xf32>
+}
+
+// -----
+
+// Non-float tensors cannot be summarized and trace in full even when
+// statistics are requested; a mixed op emits both trace flavors.
+
+// SAMPLE-LABEL: util.func public @traceMixed
+// STATS-LABEL: util.func public @traceMixed
+// STATS-SAME: (%[[ARG0:.+]]: tensor<4xf32>, %[[ARG1:.+]]: tensor<4xi32>)
+util.func public @traceMixed(%arg0: tensor<4xf32>, %arg1: tensor<4xi32>) -> tensor<4xi32> {
+  //      SAMPLE: %[[PRED:.+]] = arith.cmpi eq
+  //      SAMPLE: scf.if %[[PRED]] {
+  //      SAMPLE:   flow.tensor.trace "some.op inputs"
+  //      SAMPLE: %[[RESULT:.+]] = "some.op"
+  //      SAMPLE: scf.if %[[PRED]] {
+  // SAMPLE-NEXT:   flow.tensor.trace "some.op outputs" = [%[[RESULT]] : tensor<4xi32>]
+
+  //      STATS: flow.tensor.trace "some.op inputs stats(min,max,mean,nan-count)" = [%{{.+}} : tensor<4xf32>]
+  //      STATS: flow.tensor.trace "some.op inputs" = [%[[ARG1]] : tensor<4xi32>]
+  //      STATS: %[[RESULT:.+]] = "some.op"
+  //      STATS: flow.tensor.trace "some.op outputs" = [%[[RESULT]] : tensor<4xi32>]
+  %result = "some.op"(%arg0, %arg1) {iree.tensor.trace} : (tensor<4xf32>, tensor<4xi32>) -> tensor<4xi32>
+  util.return %result : tensor<4xi32>
+}
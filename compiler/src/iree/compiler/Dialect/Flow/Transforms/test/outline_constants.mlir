@@ -77,3 +77,32 @@ util.func private @set_affinity() attributes {
   %cst = arith.constant dense<[0, 1]> : tensor<2xi32>
   util.return
 }
+
+// -----
+
+// Tests that identical constants are deduplicated into a single global while
+// those differing in hoistable attrs (such as affinities) are kept distinct.
+
+//      CHECK: util.global private @__constant_tensor_2xi32 {inlining_policy = #util.inline.never} = dense<[5, 6]> : tensor<2xi32>
+// CHECK-NEXT: util.func private @dedup_user_a
+util.func private @dedup_user_a() {
+  // CHECK-NEXT: = util.global.load immutable @__constant_tensor_2xi32 : tensor<2xi32>
+  %cst = arith.constant dense<[5, 6]> : tensor<2xi32>
+  util.return
+}
+// CHECK: util.func private @dedup_user_b
+util.func private @dedup_user_b() {
+  // CHECK-NEXT: = util.global.load immutable @__constant_tensor_2xi32 : tensor<2xi32>
+  %cst = flow.tensor.constant dense<[5, 6]> : tensor<2xi32>
+  util.return
+}
+// CHECK: util.global private @__constant_tensor_2xi32_0
+// CHECK-SAME:   stream.affinity = #hal.affinity.queue<[1]>
+// CHECK-NEXT: util.func private @dedup_other_affinity
+util.func private @dedup_other_affinity() attributes {
+  stream.affinity = #hal.affinity.queue<[1]>
+} {
+  // CHECK-NEXT: = util.global.load immutable @__constant_tensor_2xi32_0 : tensor<2xi32>
+  %cst = arith.constant dense<[5, 6]> : tensor<2xi32>
+  util.return
+}
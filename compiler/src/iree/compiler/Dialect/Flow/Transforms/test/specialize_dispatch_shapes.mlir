@@ -0,0 +1,51 @@
+// RUN: iree-opt --split-input-file --pass-pipeline="builtin.module(util.func(iree-flow-specialize-dispatch-shapes{bucket-sizes=128,512}))" %s | FileCheck %s
+
+// Dynamic dispatches are expanded into a guarded chain of shape-specialized
+// clones (dimension pinned to each bucket) with the generic dispatch as the
+// fallback for unmatched sizes.
+
+// CHECK-LABEL: @specializeDynamicDispatch
+// CHECK-SAME: (%[[ARG0:.+]]: tensor<?xf32>, %[[DIM:.+]]: index)
+util.func public @specializeDynamicDispatch(%arg0: tensor<?xf32>, %dim: index) -> tensor<?xf32> {
+  // CHECK-DAG: %[[C128:.+]] = arith.constant 128 : index
+  // CHECK: %[[EQ128:.+]] = arith.cmpi eq, %[[DIM]], %[[C128]]
+  // CHECK: %[[RESULT:.+]] = scf.if %[[EQ128]]
+  // CHECK:   flow.dispatch.workgroups[%[[C128]]](%[[ARG0]], %[[C128]])
+  // CHECK: } else {
+  // CHECK:   %[[C512:.+]] = arith.constant 512 : index
+  // CHECK:   %[[EQ512:.+]] = arith.cmpi eq, %[[DIM]], %[[C512]]
+  // CHECK:   scf.if %[[EQ512]]
+  // CHECK:     flow.dispatch.workgroups[%[[C512]]](%[[ARG0]], %[[C512]])
+  // CHECK:   } else {
+  // CHECK:     flow.dispatch.workgroups[%[[DIM]]](%[[ARG0]], %[[DIM]])
+  %0 = flow.dispatch.workgroups[%dim](%arg0, %dim) : (tensor<?xf32>{%dim}, index) -> tensor<?xf32>{%dim} = (
+    %arg: !flow.dispatch.tensor<readonly:tensor<?xf32>>, %arg_dim: index, %ret: !flow.dispatch.tensor<writeonly:tensor<?xf32>>
+  ) {
+    %arg_value = flow.dispatch.tensor.load %arg, offsets=[0], sizes=[%arg_dim], strides=[1] : !flow.dispatch.tensor<readonly:tensor<?xf32>>{%arg_dim} -> tensor<?xf32>
+    %ret_value = "test.sink"(%arg_value) : (tensor<?xf32>) -> (tensor<?xf32>)
+    flow.dispatch.tensor.store %ret_value, %ret, offsets=[0], sizes=[%arg_dim], strides=[1] : tensor<?xf32> -> !flow.dispatch.tensor<writeonly:tensor<?xf32>>{%arg_dim}
+    flow.return
+  }
+  // CHECK: util.return %[[RESULT]]
+  util.return %0 : tensor<?xf32>
+}
+
+// -----
+
+// Fully static dispatches are left untouched.
+
+// CHECK-LABEL: @skipStaticDispatch
+util.func public @skipStaticDispatch(%arg0: tensor<8xf32>) -> tensor<8xf32> {
+  %c8 = arith.constant 8 : index
+  // CHECK-NOT: scf.if
+  // CHECK: flow.dispatch.workgroups
+  %0 = flow.dispatch.workgroups[%c8](%arg0) : (tensor<8xf32>) -> tensor<8xf32> = (
+    %arg: !flow.dispatch.tensor<readonly:tensor<8xf32>>, %ret: !flow.dispatch.tensor<writeonly:tensor<8xf32>>
+  ) {
+    %arg_value = flow.dispatch.tensor.load %arg, offsets=[0], sizes=[8], strides=[1] : !flow.dispatch.tensor<readonly:tensor<8xf32>> -> tensor<8xf32>
+    %ret_value = "test.sink"(%arg_value) : (tensor<8xf32>) -> (tensor<8xf32>)
+    flow.dispatch.tensor.store %ret_value, %ret, offsets=[0], sizes=[8], strides=[1] : tensor<8xf32> -> !flow.dispatch.tensor<writeonly:tensor<8xf32>>
+    flow.return
+  }
+  util.return %0 : tensor<8xf32>
+}
@@ -15,3 +15,44 @@ util.func public @matmul(%arg0: tensor<100x200xf32>, %arg1: tensor<200x300xf32>,
 // CHECK:       util.func public @matmul
 // CHECK:         linalg.generic
 // CHECK-SAME:      {compilation_info = #[[INFO]]}
+
+// RUN: iree-opt --pass-pipeline='builtin.module(util.func(iree-flow-split-reduction-ops))' --iree-flow-split-generic-reduction-threshold=4096 %s | FileCheck %s --check-prefix=LONG
+
+util.func public @long_softmax_denominator(%arg0: tensor<8x131072xf32>) -> tensor<8xf32> {
+  %cst = arith.constant 0.0 : f32
+  %empty = tensor.empty() : tensor<8xf32>
+  %fill = linalg.fill ins(%cst : f32) outs(%empty : tensor<8xf32>) -> tensor<8xf32>
+  %0 = linalg.generic {
+      indexing_maps = [affine_map<(d0, d1) -> (d0, d1)>,
+                       affine_map<(d0, d1) -> (d0)>],
+      iterator_types = ["parallel", "reduction"]}
+      ins(%arg0 : tensor<8x131072xf32>) outs(%fill : tensor<8xf32>) {
+  ^bb0(%in: f32, %out: f32):
+    %1 = arith.addf %in, %out : f32
+    linalg.yield %1 : f32
+  } -> tensor<8xf32>
+  util.return %0 : tensor<8xf32>
+}
+// LONG-LABEL: util.func public @long_softmax_denominator
+// LONG:         tensor.expand_shape
+// LONG:         linalg.generic
+// LONG:         linalg.generic
+// LONG:         util.return
+
+util.func public @short_softmax_denominator(%arg0: tensor<8x512xf32>) -> tensor<8xf32> {
+  %cst = arith.constant 0.0 : f32
+  %empty = tensor.empty() : tensor<8xf32>
+  %fill = linalg.fill ins(%cst : f32) outs(%empty : tensor<8xf32>) -> tensor<8xf32>
+  %0 = linalg.generic {
+      indexing_maps = [affine_map<(d0, d1) -> (d0, d1)>,
+                       affine_map<(d0, d1) -> (d0)>],
+      iterator_types = ["parallel", "reduction"]}
+      ins(%arg0 : tensor<8x512xf32>) outs(%fill : tensor<8xf32>) {
+  ^bb0(%in: f32, %out: f32):
+    %1 = arith.addf %in, %out : f32
+    linalg.yield %1 : f32
+  } -> tensor<8xf32>
+  util.return %0 : tensor<8xf32>
+}
+// LONG-LABEL: util.func public @short_softmax_denominator
+// LONG-NOT:     tensor.expand_shape
@@ -82,6 +82,14 @@ void TargetOptions::bindOptions(OptionsBinder &binder) {
       llvm::cl::desc(
           "Path to write translated and serialized executable binaries into."),
       llvm::cl::cat(halTargetOptionsCategory));
+
+  binder.opt<std::string>(
+      "iree-hal-executable-cache-path", executableCachePath,
+      llvm::cl::desc("Path to a persistent executable compilation cache keyed "
+                     "on the configured executable IR and target attributes. "
+                     "Variants hitting the cache skip translation, linking, "
+                     "and serialization."),
+      llvm::cl::cat(halTargetOptionsCategory));
 }
 
 } // namespace mlir::iree_compiler::IREE::HAL
@@ -49,6 +49,11 @@ struct TargetOptions {
   // A path to write translated and serialized executable binaries into.
   std::string executableBinariesPath;
 
+  // A path to a persistent cache of serialized executable binaries keyed on
+  // the configured executable IR and target attributes. Cache hits skip
+  // translation, linking, and serialization for the matching variants.
+  std::string executableCachePath;
+
   void bindOptions(OptionsBinder &binder);
   using FromFlags = OptionsFromFlags<TargetOptions>;
 };
@@ -0,0 +1,168 @@
+// Copyright 2026 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <memory>
+#include <utility>
+
+#include "iree/compiler/Dialect/HAL/IR/HALDialect.h"
+#include "iree/compiler/Dialect/HAL/IR/HALOps.h"
+#include "iree/compiler/Dialect/HAL/Transforms/Passes.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA256.h"
+#include "llvm/Support/raw_ostream.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/Pass/Pass.h"
+
+namespace mlir::iree_compiler::IREE::HAL {
+
+#define GEN_PASS_DEF_LOADEXECUTABLECACHEPASS
+#define GEN_PASS_DEF_STOREEXECUTABLECACHEPASS
+#include "iree/compiler/Dialect/HAL/Transforms/Passes.h.inc"
+
+// Name of the dictionary attribute mapping variant names to cache keys.
+// Attached to hal.executable ops by the load pass and consumed (and removed)
+// by the store pass after serialization has produced binaries.
+static constexpr char kCacheKeysAttrName[] = "hal.executable.cache_keys";
+
+// Marker attached to hal.executable.variant ops whose binary was loaded from
+// the cache. Marked variants are skipped by translation and erased without
+// serialization; their exports are kept so host-side conversion can still
+// resolve dispatch symbols.
+static constexpr char kCacheHitAttrName[] = "hal.executable.cache_hit";
+
+namespace {
+
+// Returns a stable content-derived key for the given configured variant.
+// The key covers the printed variant IR which includes the full
+// #hal.executable.target attribute; the parent executable name is explicitly
+// excluded so that identical dispatches cache-hit across programs.
+static std::string
+computeVariantCacheKey(IREE::HAL::ExecutableVariantOp variantOp) {
+  std::string ir;
+  llvm::raw_string_ostream os(ir);
+  OpPrintingFlags flags;
+  flags.useLocalScope();
+  variantOp->print(os, flags);
+  llvm::SHA256 hasher;
+  hasher.update(ir);
+  return llvm::toHex(hasher.final(), /*LowerCase=*/true);
+}
+
+static SmallString<256> getCacheEntryPath(StringRef cachePath, StringRef key) {
+  SmallString<256> filePath(cachePath);
+  llvm::sys::path::append(filePath, key + ".bin");
+  return filePath;
+}
+
+//===----------------------------------------------------------------------===//
+// --iree-hal-load-executable-cache
+//===----------------------------------------------------------------------===//
+
+struct LoadExecutableCachePass
+    : public IREE::HAL::impl::LoadExecutableCachePassBase<
+          LoadExecutableCachePass> {
+  using IREE::HAL::impl::LoadExecutableCachePassBase<
+      LoadExecutableCachePass>::LoadExecutableCachePassBase;
+  void runOnOperation() override {
+    auto executableOp = getOperation();
+
+    NamedAttrList cacheKeys;
+    auto variantOps = llvm::to_vector(
+        executableOp.getBlock().getOps<IREE::HAL::ExecutableVariantOp>());
+    for (auto variantOp : variantOps) {
+      // Externally defined variants have no contents to key on and are
+      // serialized from their object files as usual.
+      if (variantOp.isExternal())
+        continue;
+
+      // Record the key so the store pass can file the serialized binary even
+      // on a miss.
+      auto key = computeVariantCacheKey(variantOp);
+      cacheKeys.set(variantOp.getSymName(),
+                    StringAttr::get(&getContext(), key));
+
+      // Probe the cache; misses proceed through translation as normal.
+      auto filePath = getCacheEntryPath(path, key);
+      auto fileOr = llvm::MemoryBuffer::getFile(filePath);
+      if (!fileOr)
+        continue;
+      auto &file = *fileOr.get();
+
+      // Materialize the cached binary up-front. The binary is named after the
+      // variant with a suffix to avoid colliding with the variant symbol that
+      // must remain live until host-side conversion completes; binaries are
+      // selected by format at runtime so the name is purely diagnostic.
+      OpBuilder executableBuilder(variantOp);
+      std::vector<uint8_t> data(file.getBufferStart(), file.getBufferEnd());
+      executableBuilder.create<IREE::HAL::ExecutableBinaryOp>(
+          variantOp.getLoc(), variantOp.getSymName().str() + "_cached",
+          variantOp.getTarget().getFormat().getValue(), data);
+
+      // Drop the variant contents (the expensive part) but keep the variant
+      // and its exports around for dispatch symbol resolution. Serialization
+      // erases the marked variant instead of invoking the target backend.
+      auto &innerBlock = *variantOp.getInnerModule().getBody();
+      while (!innerBlock.empty())
+        innerBlock.front().erase();
+      variantOp->setAttr(kCacheHitAttrName,
+                         UnitAttr::get(&getContext()));
+    }
+    if (!cacheKeys.empty()) {
+      executableOp->setAttr(
+          kCacheKeysAttrName,
+          cacheKeys.getDictionary(&getContext()));
+    }
+  }
+};
+
+//===----------------------------------------------------------------------===//
+// --iree-hal-store-executable-cache
+//===----------------------------------------------------------------------===//
+
+struct StoreExecutableCachePass
+    : public IREE::HAL::impl::StoreExecutableCachePassBase<
+          StoreExecutableCachePass> {
+  using IREE::HAL::impl::StoreExecutableCachePassBase<
+      StoreExecutableCachePass>::StoreExecutableCachePassBase;
+  void runOnOperation() override {
+    auto executableOp = getOperation();
+    auto cacheKeysAttr =
+        executableOp->getAttrOfType<DictionaryAttr>(kCacheKeysAttrName);
+    if (!cacheKeysAttr)
+      return;
+    executableOp->removeAttr(kCacheKeysAttrName);
+
+    for (auto binaryOp :
+         executableOp.getBlock().getOps<IREE::HAL::ExecutableBinaryOp>()) {
+      // Backends name the binaries they produce after the originating variant
+      // so cache-loaded "_cached" binaries naturally have no key and are
+      // skipped here.
+      auto keyAttr = cacheKeysAttr.getAs<StringAttr>(binaryOp.getSymName());
+      if (!keyAttr)
+        continue;
+
+      // Cache entries are immutable once written; all I/O failures are
+      // ignored as the cache is purely an optimization.
+      auto filePath = getCacheEntryPath(path, keyAttr.getValue());
+      if (llvm::sys::fs::exists(filePath))
+        continue;
+      llvm::sys::fs::create_directories(path);
+      std::error_code ec;
+      llvm::raw_fd_ostream file(filePath, ec);
+      if (ec)
+        continue;
+      auto rawData = binaryOp.getData().getRawData();
+      file.write(rawData.data(), rawData.size());
+    }
+  }
+};
+
+} // namespace
+
+} // namespace mlir::iree_compiler::IREE::HAL
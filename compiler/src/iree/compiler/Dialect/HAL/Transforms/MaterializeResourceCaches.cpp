@@ -12,6 +12,7 @@
 #include "iree/compiler/Dialect/HAL/Transforms/Passes.h"
 #include "iree/compiler/Dialect/Util/IR/UtilDialect.h"
 #include "iree/compiler/Dialect/Util/IR/UtilOps.h"
+#include "llvm/ADT/StringMap.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/Dialect/SCF/IR/SCF.h"
 #include "mlir/IR/Attributes.h"
@@ -27,6 +28,28 @@ namespace mlir::iree_compiler::IREE::HAL {
 
 namespace {
 
+// Returns a relative capability score for |variantOp| used to order variant
+// selection. Variants gated on device capabilities score above unconditional
+// fallbacks and among CPU variants more required features means a more
+// specialized (and presumed faster) binary. The score only orders variants
+// within one executable; absolute values are meaningless.
+static int64_t getVariantSpecificity(IREE::HAL::ExecutableVariantOp variantOp) {
+  int64_t score = 0;
+  if (variantOp.getConditionOp()) {
+    score += 1 << 16;
+  }
+  if (auto configAttr = variantOp.getTarget().getConfiguration()) {
+    if (auto cpuFeaturesAttr =
+            configAttr.getAs<StringAttr>("cpu_features")) {
+      SmallVector<StringRef> features;
+      cpuFeaturesAttr.getValue().split(features, ',', /*MaxSplit=*/-1,
+                                       /*KeepEmpty=*/false);
+      score += features.size();
+    }
+  }
+  return score;
+}
+
 // TODO(multi-device): rewrite this to shard resources per device.
 struct MaterializeResourceCachesPass
     : public IREE::HAL::impl::MaterializeResourceCachesPassBase<
@@ -187,12 +210,6 @@ private:
     globalOp.setPrivate();
     executableCache_.try_emplace(executableOp.getSymName(), globalOp);
 
-    auto initializerOp = moduleBuilder.create<IREE::Util::InitializerOp>(loc);
-    OpBuilder blockBuilder =
-        OpBuilder::atBlockEnd(initializerOp.addEntryBlock());
-    // TODO(multi-device): pass in resolve info to the call and reuse.
-    Value device = IREE::HAL::DeviceType::resolveAny(loc, blockBuilder);
-
     // Create a switch statement with a case for each variant.
     // Each case should then cache only executables which contain a matching
     // ExecutableVariantOp.
@@ -205,6 +222,39 @@ private:
       caseVariantOps.push_back(variantOp);
     }
 
+    // Selection below is first-match so order variants most-capable first:
+    // a variant gated on specific device capabilities beats an unconditional
+    // fallback (native binaries over JIT'ed portable formats) and variants
+    // requiring more CPU features beat ones requiring fewer (AVX-512 over
+    // AVX2). Ties keep their declaration order so single-target modules are
+    // unaffected.
+    llvm::stable_sort(caseVariantOps, [](IREE::HAL::ExecutableVariantOp lhs,
+                                         IREE::HAL::ExecutableVariantOp rhs) {
+      return getVariantSpecificity(lhs) > getVariantSpecificity(rhs);
+    });
+
+    // Outline and memoize the constant blocks of each variant before creating
+    // the executable initializer below so that the one-time block initializers
+    // run first. Structurally identical blocks (common when many executables
+    // derive the same CPU feature/layout constants) share the same globals and
+    // are only evaluated once per module load.
+    SmallVector<SmallVector<IREE::Util::GlobalOp>> caseConstantGlobalOps;
+    for (auto variantOp : caseVariantOps) {
+      SmallVector<IREE::Util::GlobalOp> constantGlobalOps;
+      for (auto blockOp :
+           llvm::make_early_inc_range(variantOp.getConstantBlockOps())) {
+        llvm::append_range(constantGlobalOps, defineConstantBlockOp(blockOp));
+        blockOp.erase();
+      }
+      caseConstantGlobalOps.push_back(std::move(constantGlobalOps));
+    }
+
+    auto initializerOp = moduleBuilder.create<IREE::Util::InitializerOp>(loc);
+    OpBuilder blockBuilder =
+        OpBuilder::atBlockEnd(initializerOp.addEntryBlock());
+    // TODO(multi-device): pass in resolve info to the call and reuse.
+    Value device = IREE::HAL::DeviceType::resolveAny(loc, blockBuilder);
+
     // Select the variant index.
     Value selectedIndex = buildIfElseTree(
         loc, caseVariantOps.size(),
@@ -231,15 +281,12 @@ private:
                 .getLoadedGlobalValue());
       }
 
-      // Inline constant initializer from the variant.
-      // We want these to all happen inside of this device switch case; they'll
-      // get deduplicated/hoisted if possible in future canonicalization passes.
+      // Load the memoized constant block results for the variant.
       SmallVector<Value> constantValues;
-      for (auto blockOp :
-           llvm::make_early_inc_range(variantOp.getConstantBlockOps())) {
-        constantValues.append(
-            inlineConstantBlockOp(blockOp, moduleBuilder, caseBuilder, device));
-        blockOp.erase();
+      for (auto constantGlobalOp : caseConstantGlobalOps[i]) {
+        constantValues.push_back(
+            constantGlobalOp.createLoadOp(loc, caseBuilder)
+                .getLoadedGlobalValue());
       }
 
       Value executable = caseBuilder.createOrFold<ExecutableCreateOp>(
@@ -269,18 +316,39 @@ private:
     blockBuilder.create<IREE::Util::ReturnOp>(loc);
   }
 
-  // Inlines a constant block as a function in |moduleBuilder| and then inserts
-  // a call to it in |callerBuilder|.
-  SmallVector<Value> inlineConstantBlockOp(ExecutableConstantBlockOp blockOp,
-                                           OpBuilder &moduleBuilder,
-                                           OpBuilder &callerBuilder,
-                                           Value device) {
+  // Returns a key uniquely identifying the contents of |blockOp| such that two
+  // structurally identical blocks produce the same key regardless of which
+  // executable variant they are nested in.
+  static std::string getConstantBlockKey(ExecutableConstantBlockOp blockOp) {
+    std::string key;
+    llvm::raw_string_ostream os(key);
+    OpPrintingFlags printFlags;
+    printFlags.printGenericOpForm();
+    blockOp->print(os, printFlags);
+    return key;
+  }
+
+  // Outlines a constant block as a module-level function that is evaluated
+  // once at initialization time with its results memoized in globals.
+  // Structurally identical blocks share the same function and globals so that
+  // blocks repeated across executables are both emitted and evaluated only
+  // once.
+  SmallVector<IREE::Util::GlobalOp>
+  defineConstantBlockOp(ExecutableConstantBlockOp blockOp) {
+    auto key = getConstantBlockKey(blockOp);
+    auto existingIt = constantBlockCache_.find(key);
+    if (existingIt != constantBlockCache_.end()) {
+      return existingIt->second;
+    }
+
+    auto loc = blockOp.getLoc();
+
     // Create the function with the region contents of the constant block.
     auto funcName = (StringRef("__constant_block_") +
                      std::to_string(nextUniqueConstantBlockId++))
                         .str();
     auto funcOp = moduleBuilder.create<IREE::Util::FuncOp>(
-        blockOp.getLoc(), funcName, blockOp.getFunctionType());
+        loc, funcName, blockOp.getFunctionType());
     funcOp.setPrivate();
     funcOp.getRegion().takeBody(blockOp.getRegion());
 
@@ -292,16 +360,36 @@ private:
       returnOp.erase();
     }
 
-    // Create the call passing in the device if needed.
+    // One immutable global per result holding the memoized value.
+    SmallVector<IREE::Util::GlobalOp> resultGlobalOps;
+    for (auto [i, resultType] : llvm::enumerate(funcOp.getResultTypes())) {
+      auto globalName = funcName + "_result_" + std::to_string(i);
+      auto globalOp = moduleBuilder.create<IREE::Util::GlobalOp>(
+          loc, globalName, /*isMutable=*/false, resultType);
+      globalOp.setPrivate();
+      resultGlobalOps.push_back(globalOp);
+    }
+
+    // Evaluate the block once at initialization time and store the results.
+    auto initializerOp = moduleBuilder.create<IREE::Util::InitializerOp>(loc);
+    OpBuilder blockBuilder =
+        OpBuilder::atBlockEnd(initializerOp.addEntryBlock());
     SmallVector<Value> callOperands;
     if (funcOp.getNumArguments() > 0) {
-      callOperands.push_back(device);
+      // TODO(multi-device): pass in resolve info to the call and reuse.
+      callOperands.push_back(
+          IREE::HAL::DeviceType::resolveAny(loc, blockBuilder));
     }
-    auto callOp = callerBuilder.create<IREE::Util::CallOp>(
-        blockOp.getLoc(), funcOp, callOperands);
+    auto callOp =
+        blockBuilder.create<IREE::Util::CallOp>(loc, funcOp, callOperands);
+    for (auto [globalOp, result] :
+         llvm::zip_equal(resultGlobalOps, callOp.getResults())) {
+      globalOp.createStoreOp(loc, result, blockBuilder);
+    }
+    blockBuilder.create<IREE::Util::ReturnOp>(loc);
 
-    return llvm::map_to_vector(callOp.getResults(),
-                               [](OpResult result) -> Value { return result; });
+    return constantBlockCache_.try_emplace(key, std::move(resultGlobalOps))
+        .first->second;
   }
 
   void replacePipelineLayoutLookupOp(PipelineLayoutLookupOp &lookupOp) {
@@ -332,6 +420,7 @@ private:
       descriptorSetLayoutCache_;
   DenseMap<Attribute, IREE::Util::GlobalOp> pipelineLayoutCache_;
   DenseMap<StringRef, IREE::Util::GlobalOp> executableCache_;
+  llvm::StringMap<SmallVector<IREE::Util::GlobalOp>> constantBlockCache_;
 
   int nextUniqueConstantBlockId = 0;
   int nextUniquePipelineLayoutId = 0;
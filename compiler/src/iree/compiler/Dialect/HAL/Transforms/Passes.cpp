@@ -363,6 +363,13 @@ void buildHALTransformPassPipeline(OpPassManager &passManager,
     hooks.beforePhase(PipelinePhase::ExecutableTargets, passManager);
 
   if (compileFrom < PipelinePhase::ExecutableTargets) {
+    // Probe the persistent executable cache (if enabled) before translation so
+    // that unchanged variants skip the expensive backend work entirely.
+    if (!targetOptions.executableCachePath.empty()) {
+      passManager.addNestedPass<IREE::HAL::ExecutableOp>(
+          IREE::HAL::createLoadExecutableCachePass(
+              {targetOptions.executableCachePath}));
+    }
     passManager.addNestedPass<IREE::HAL::ExecutableOp>(
         IREE::HAL::createTranslateExecutablesPass({targetRegistry}));
   }
@@ -485,6 +492,14 @@ void buildHALTransformPassPipeline(OpPassManager &passManager,
              targetOptions.executableIntermediatesPath,
              targetOptions.executableBinariesPath}));
 
+    // Populate the persistent executable cache (if enabled) with the binaries
+    // serialized for the variants that missed it above.
+    if (!targetOptions.executableCachePath.empty()) {
+      passManager.addNestedPass<IREE::HAL::ExecutableOp>(
+          IREE::HAL::createStoreExecutableCachePass(
+              {targetOptions.executableCachePath}));
+    }
+
     // NOTE: symbol DCE will destroy executable target contents, so only run
     // it if we serialized things.
     passManager.addPass(IREE::HAL::createPruneExecutablesPass());
@@ -17,7 +17,10 @@
 #include "llvm/Support/FileSystem.h"
 #include "mlir/IR/Attributes.h"
 #include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
 #include "mlir/IR/Diagnostics.h"
+#include "mlir/IR/OwningOpRef.h"
+#include "mlir/IR/Threading.h"
 #include "mlir/Pass/Pass.h"
 #include "mlir/Pass/PassManager.h"
 
@@ -75,20 +78,87 @@ struct SerializeTargetExecutablesPass
       llvm::sys::fs::create_directories(dumpBinariesPath);
     }
 
-    auto variantOps = llvm::to_vector(
-        executableOp.getBlock().getOps<IREE::HAL::ExecutableVariantOp>());
-    for (auto variantOp : variantOps) {
+    SmallVector<IREE::HAL::ExecutableVariantOp> pendingVariantOps;
+    for (auto variantOp : llvm::to_vector(
+             executableOp.getBlock().getOps<IREE::HAL::ExecutableVariantOp>())) {
       if (variantOp.getTarget().getBackend().getValue() != target)
         continue;
-      OpBuilder executableBuilder(variantOp);
-      // Ask the target backend to serialize the executable. Note that it
-      // may create one or more hal.executable.binary ops in the case of
-      // multi-architecture binaries.
-      if (failed(targetBackend->serializeExecutable(
-              serializationOptions, variantOp, executableBuilder))) {
-        variantOp.emitError()
-            << "failed to serialize executable for target backend " << target;
-        return signalPassFailure();
+      // Variants satisfied from the executable cache already have their
+      // binary materialized (see the iree-hal-load-executable-cache pass).
+      if (variantOp->hasAttr("hal.executable.cache_hit")) {
+        variantOp.erase();
+        continue;
+      }
+      pendingVariantOps.push_back(variantOp);
+    }
+
+    // Serialize in-place when there's no parallelism to exploit. The pass
+    // manager already distributes executables across threads; this path is
+    // only serial when an executable (usually post-linking) holds the bulk of
+    // the program in many variants.
+    if (pendingVariantOps.size() <= 1 ||
+        !getContext().isMultithreadingEnabled()) {
+      for (auto variantOp : pendingVariantOps) {
+        OpBuilder executableBuilder(variantOp);
+        // Ask the target backend to serialize the executable. Note that it
+        // may create one or more hal.executable.binary ops in the case of
+        // multi-architecture binaries.
+        if (failed(targetBackend->serializeExecutable(
+                serializationOptions, variantOp, executableBuilder))) {
+          variantOp.emitError()
+              << "failed to serialize executable for target backend " << target;
+          return signalPassFailure();
+        }
+        variantOp.erase();
+      }
+      return;
+    }
+
+    // Clone each variant into a detached scratch executable so that workers
+    // can build their hal.executable.binary ops without contending on the
+    // shared executable block.
+    SmallVector<OwningOpRef<mlir::ModuleOp>> scratchModules;
+    SmallVector<IREE::HAL::ExecutableVariantOp> scratchVariantOps;
+    for (auto variantOp : pendingVariantOps) {
+      OwningOpRef<mlir::ModuleOp> scratchModule =
+          mlir::ModuleOp::create(variantOp.getLoc());
+      auto clonedExecutableOp = executableOp.cloneWithoutRegions();
+      OpBuilder::atBlockBegin(scratchModule->getBody())
+          .insert(clonedExecutableOp);
+      OpBuilder clonedBuilder =
+          OpBuilder::atBlockBegin(&clonedExecutableOp.getBody().emplaceBlock());
+      scratchVariantOps.push_back(cast<IREE::HAL::ExecutableVariantOp>(
+          clonedBuilder.clone(*variantOp)));
+      clonedBuilder.create<IREE::HAL::ExecutableEndOp>(
+          clonedBuilder.getUnknownLoc());
+      scratchModules.push_back(std::move(scratchModule));
+    }
+
+    // Serialize all variants in parallel on the context thread pool. Errors
+    // are emitted on the source variants by the backends themselves.
+    if (failed(mlir::failableParallelForEach(
+            &getContext(), scratchVariantOps,
+            [&](IREE::HAL::ExecutableVariantOp clonedVariantOp) {
+              OpBuilder executableBuilder(clonedVariantOp);
+              return targetBackend->serializeExecutable(
+                  serializationOptions, clonedVariantOp, executableBuilder);
+            }))) {
+      executableOp.emitError()
+          << "failed to serialize executable for target backend " << target;
+      return signalPassFailure();
+    }
+
+    // Splice the produced binaries back into the real executable in variant
+    // order so the output is deterministic regardless of scheduling.
+    for (auto [variantOp, clonedVariantOp] :
+         llvm::zip_equal(pendingVariantOps, scratchVariantOps)) {
+      for (auto &op : llvm::make_early_inc_range(
+               *clonedVariantOp->getBlock())) {
+        if (&op == clonedVariantOp.getOperation() ||
+            isa<IREE::HAL::ExecutableEndOp>(op)) {
+          continue;
+        }
+        op.moveBefore(variantOp);
       }
       variantOp.erase();
     }
@@ -55,6 +55,10 @@ struct TranslateTargetExecutableVariantsPass
       return;
     if (variantOp.isExternal())
       return;
+    // Variants with a cached binary already materialized have no contents to
+    // translate (see the iree-hal-load-executable-cache pass).
+    if (variantOp->hasAttr("hal.executable.cache_hit"))
+      return;
 
     auto targetBackend = targetRegistry->getTargetBackend(target);
     if (!targetBackend) {
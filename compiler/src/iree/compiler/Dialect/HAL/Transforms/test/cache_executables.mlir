@@ -0,0 +1,52 @@
+// RUN: rm -rf %t && iree-opt --pass-pipeline='builtin.module(hal.executable(iree-hal-load-executable-cache{path=%t}))' %s | FileCheck --check-prefix=LOAD %s
+// RUN: iree-opt --pass-pipeline='builtin.module(hal.executable(iree-hal-store-executable-cache{path=%t}))' %s | FileCheck --check-prefix=STORE %s
+
+// The load pass probes an (empty) cache here: the variant misses and is left
+// untouched for translation but its content-derived key is recorded so the
+// store pass can file the serialized binary. The cache hit path requires the
+// serialized output of a target backend and is exercised end-to-end.
+
+#executable_target = #hal.executable.target<"llvm-cpu", "embedded-elf-x86_64">
+#pipeline_layout = #hal.pipeline.layout<push_constants = 0, sets = [
+  #hal.descriptor_set.layout<0, bindings = [
+    #hal.descriptor_set.binding<0, storage_buffer>,
+    #hal.descriptor_set.binding<1, storage_buffer>
+  ]>
+]>
+
+// LOAD: hal.executable private @ex_miss
+// LOAD-SAME: hal.executable.cache_keys = {variant0 = "{{[0-9a-f]+}}"}
+hal.executable private @ex_miss {
+  // LOAD: hal.executable.variant public @variant0
+  // LOAD-NOT: hal.executable.cache_hit
+  hal.executable.variant public @variant0 target(#executable_target) {
+    hal.executable.export public @dispatch0 ordinal(0) layout(#pipeline_layout) {
+    ^bb0(%device: !hal.device, %arg0: index):  // no predecessors
+      %c1 = arith.constant 1 : index
+      hal.return %c1, %c1, %c1 : index, index, index
+    }
+    // LOAD: builtin.module
+    // LOAD: func.func @dispatch0
+    builtin.module {
+      func.func @dispatch0() {
+        func.return
+      }
+    }
+  }
+}
+
+// The store pass writes binaries whose symbol matches a recorded key into the
+// cache directory and drops the bookkeeping attribute from the executable.
+
+// STORE: hal.executable private @ex_store
+// STORE-NOT: hal.executable.cache_keys
+hal.executable private @ex_store attributes {
+  hal.executable.cache_keys = {variant0 = "0011eeff"}
+} {
+  // STORE: hal.executable.binary public @variant0
+  // STORE-SAME: data = dense<1> : vector<16xi8>
+  hal.executable.binary public @variant0 attributes {
+    data = dense<1> : vector<16xi8>,
+    format = "embedded-elf-x86_64"
+  }
+}
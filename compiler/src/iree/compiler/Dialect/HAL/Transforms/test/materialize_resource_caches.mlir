@@ -82,7 +82,35 @@ hal.executable @exe {
 // CHECK-DAG: util.global private @_pipeline_layout_1
 
 // CHECK: util.global private @_executable_exe : !hal.executable
-// CHECK-NEXT: util.initializer {
+
+// Outlined constant blocks evaluated once at initialization time with their
+// results memoized in globals (structurally identical blocks are shared):
+// CHECK: util.func private @__constant_block_0() -> (i32, i32)
+// CHECK-DAG: %[[C123:.+]] = arith.constant 123
+// CHECK-DAG: %[[C456:.+]] = arith.constant 456
+// CHECK: util.return %[[C123]], %[[C456]]
+// CHECK: util.global private @__constant_block_0_result_0 : i32
+// CHECK: util.global private @__constant_block_0_result_1 : i32
+// CHECK: util.initializer {
+// CHECK:   %[[RET01:.+]]:2 = util.call @__constant_block_0()
+// CHECK-DAG:   util.global.store %[[RET01]]#0, @__constant_block_0_result_0
+// CHECK-DAG:   util.global.store %[[RET01]]#1, @__constant_block_0_result_1
+
+// CHECK: util.func private @__constant_block_1(%[[BLOCK_DEVICE:.+]]: !hal.device) -> i32
+// CHECK:   %[[OK:.+]], %[[VALUE:.+]] = hal.device.query<%[[BLOCK_DEVICE]] : !hal.device> key("sys" :: "baz")
+// CHECK:   cf.cond_br %[[OK]], ^bb1, ^bb2
+// CHECK: ^bb1:
+// CHECK:   util.return %[[VALUE]]
+// CHECK: ^bb2:
+// CHECK:   %[[DUMMY:.+]] = arith.constant 0
+// CHECK:   util.return %[[DUMMY]]
+// CHECK: util.global private @__constant_block_1_result_0 : i32
+// CHECK: util.initializer {
+// CHECK:   %[[ANY_DEVICE:.+]] = hal.devices.get %{{.+}}
+// CHECK:   %[[RET2:.+]] = util.call @__constant_block_1(%[[ANY_DEVICE]])
+// CHECK:   util.global.store %[[RET2]], @__constant_block_1_result_0
+
+// CHECK: util.initializer {
 
 // Switch on the supported formats:
 // CHECK:   %[[DEVICE:.+]] = hal.devices.get %{{.+}}
@@ -103,16 +131,17 @@ hal.executable @exe {
 // CHECK:     %[[LAYOUT0_2:.+]] = util.global.load @_pipeline_layout_0 : !hal.pipeline_layout
 // CHECK:     %[[LAYOUT1:.+]] = util.global.load @_pipeline_layout_1 : !hal.pipeline_layout
 
-// Constant block initializers:
-// CHECK:     %[[CONST_01:.+]]:2 = util.call @__constant_block_0()
-// CHECK:     %[[CONST_2:.+]] = util.call @__constant_block_1(%[[DEVICE]])
+// Memoized constant block results:
+// CHECK:     %[[CONST_0:.+]] = util.global.load @__constant_block_0_result_0 : i32
+// CHECK:     %[[CONST_1:.+]] = util.global.load @__constant_block_0_result_1 : i32
+// CHECK:     %[[CONST_2:.+]] = util.global.load @__constant_block_1_result_0 : i32
 
 // Executable creation:
 // CHECK:     %[[EXE:.+]] = hal.executable.create
 // CHECK-SAME:  device(%[[DEVICE]] : !hal.device)
 // CHECK-SAME:  target(@exe::@vmvx)
 // CHECK-SAME:  layouts([%[[LAYOUT0]], %[[LAYOUT0_2]], %[[LAYOUT1]]])
-// CHECK-SAME:  constants([%[[CONST_01]]#0, %[[CONST_01]]#1, %[[CONST_2]]])
+// CHECK-SAME:  constants([%[[CONST_0]], %[[CONST_1]], %[[CONST_2]]])
 // CHECK-SAME:  : !hal.executable
 
 // CHECK:     scf.yield %[[EXE]] : !hal.executable
@@ -125,20 +154,6 @@ hal.executable @exe {
 // CHECK:   }
 // CHECK:   util.global.store %[[RET]], @_executable_exe : !hal.executable
 
-// Inlined constant block functions (here we ensure all blocks are cloned):
-// CHECK: util.func private @__constant_block_0() -> (i32, i32)
-// CHECK-DAG: %[[C0:.+]] = arith.constant 123
-// CHECK-DAG: %[[C1:.+]] = arith.constant 456
-// CHECK: util.return %[[C0]], %[[C1]]
-// CHECK: util.func private @__constant_block_1(%[[BLOCK_DEVICE:.+]]: !hal.device) -> i32
-// CHECK:   %[[OK:.+]], %[[VALUE:.+]] = hal.device.query<%[[BLOCK_DEVICE]] : !hal.device> key("sys" :: "baz")
-// CHECK:   cf.cond_br %[[OK]], ^bb1, ^bb2
-// CHECK: ^bb1:
-// CHECK:   util.return %[[VALUE]]
-// CHECK: ^bb2:
-// CHECK:   %[[DUMMY:.+]] = arith.constant 0
-// CHECK:   util.return %[[DUMMY]]
-
 // CHECK-LABEL: @exeLookup
 util.func public @exeLookup(%device : !hal.device) -> !hal.executable {
   // CHECK: %[[EXE:.+]] = util.global.load @_executable_exe : !hal.executable
@@ -150,6 +165,69 @@ util.func public @exeLookup(%device : !hal.device) -> !hal.executable {
 
 // -----
 
+// Tests that structurally identical constant blocks across executables are
+// deduplicated into a single function/global set evaluated once.
+
+#pipeline_layout = #hal.pipeline.layout<push_constants = 0, sets = [
+  #hal.descriptor_set.layout<0, bindings = [
+    #hal.descriptor_set.binding<0, storage_buffer>
+  ]>
+]>
+
+hal.executable @exe0 {
+  hal.executable.variant @vmvx target(<"vmvx", "vmvx-bytecode-fb">) {
+    hal.executable.export @entry ordinal(0) layout(#pipeline_layout) attributes {
+      workgroup_size = [32 : index, 1 : index, 1 : index]
+    }
+    hal.executable.constant.block() -> i32 as "foo" {
+      %c123 = arith.constant 123 : i32
+      hal.return %c123 : i32
+    }
+  }
+}
+hal.executable @exe1 {
+  hal.executable.variant @vmvx target(<"vmvx", "vmvx-bytecode-fb">) {
+    hal.executable.export @entry ordinal(0) layout(#pipeline_layout) attributes {
+      workgroup_size = [32 : index, 1 : index, 1 : index]
+    }
+    hal.executable.constant.block() -> i32 as "foo" {
+      %c123 = arith.constant 123 : i32
+      hal.return %c123 : i32
+    }
+  }
+}
+
+// The block is outlined and evaluated exactly once:
+// CHECK: util.func private @__constant_block_0() -> i32
+// CHECK: util.global private @__constant_block_0_result_0 : i32
+// CHECK: util.initializer {
+// CHECK:   %[[RET:.+]] = util.call @__constant_block_0()
+// CHECK:   util.global.store %[[RET]], @__constant_block_0_result_0
+// CHECK-NOT: util.func private @__constant_block_1
+
+// Both executables load the shared memoized result:
+// CHECK: util.initializer
+// CHECK:   %[[CONST0:.+]] = util.global.load @__constant_block_0_result_0 : i32
+// CHECK:   hal.executable.create
+// CHECK-SAME:  target(@exe0::@vmvx)
+// CHECK-SAME:  constants([%[[CONST0]]])
+// CHECK: util.initializer
+// CHECK:   %[[CONST1:.+]] = util.global.load @__constant_block_0_result_0 : i32
+// CHECK:   hal.executable.create
+// CHECK-SAME:  target(@exe1::@vmvx)
+// CHECK-SAME:  constants([%[[CONST1]]])
+
+// CHECK-LABEL: @exesLookup
+util.func public @exesLookup(%device : !hal.device) -> (!hal.executable, !hal.executable) {
+  %0 = hal.executable.lookup device(%device : !hal.device)
+                             executable(@exe0) : !hal.executable
+  %1 = hal.executable.lookup device(%device : !hal.device)
+                             executable(@exe1) : !hal.executable
+  util.return %0, %1 : !hal.executable, !hal.executable
+}
+
+// -----
+
 // Tests that materialization no-ops when resource caches have already been
 // materialized. Today this is rather simplistic and just bails if the names
 // match with the expectation being that users are mostly just running through
@@ -219,3 +297,51 @@ util.func public @exeLookup(%device : !hal.device) -> !hal.executable {
   // CHECK-NEXT: util.return %[[EXE]]
   util.return %0 : !hal.executable
 }
+
+// -----
+
+// Tests that more specific variants (here one carrying a condition region) are
+// tried before unconditional fallbacks regardless of declaration order so that
+// devices supporting the optional features prefer the specialized binary.
+
+#pipeline_layout = #hal.pipeline.layout<push_constants = 0, sets = [
+  #hal.descriptor_set.layout<0, bindings = [
+    #hal.descriptor_set.binding<0, storage_buffer>
+  ]>
+]>
+
+hal.executable @exe_ranked {
+  hal.executable.variant @generic target(<"vmvx", "vmvx-bytecode-fb">) {
+    hal.executable.export @entry ordinal(0) layout(#pipeline_layout) attributes {
+      workgroup_size = [32 : index, 1 : index, 1 : index]
+    }
+  }
+  hal.executable.variant @featured target(<"vmvx", "vmvx-bytecode-fb">) {
+    hal.executable.condition(%device: !hal.device) -> i1 {
+      %ok, %selected = hal.device.query<%device : !hal.device> key("some" :: "feature") : i1, i1
+      hal.return %selected : i1
+    }
+    hal.executable.export @entry ordinal(0) layout(#pipeline_layout) attributes {
+      workgroup_size = [32 : index, 1 : index, 1 : index]
+    }
+  }
+}
+
+// The conditioned variant is selected first even though it is declared second:
+// CHECK: util.global private @_executable_exe_ranked : !hal.executable
+// CHECK: util.initializer
+// CHECK:   scf.index_switch
+// CHECK:   case 0 {
+// CHECK:     hal.executable.create
+// CHECK-SAME:  target(@exe_ranked::@featured)
+// CHECK:   case 1 {
+// CHECK:     hal.executable.create
+// CHECK-SAME:  target(@exe_ranked::@generic)
+
+// CHECK-LABEL: @rankedExeLookup
+util.func public @rankedExeLookup(%device : !hal.device) -> !hal.executable {
+  // CHECK: util.global.load @_executable_exe_ranked : !hal.executable
+  %0 = hal.executable.lookup device(%device : !hal.device)
+                             executable(@exe_ranked) : !hal.executable
+  util.return %0 : !hal.executable
+}
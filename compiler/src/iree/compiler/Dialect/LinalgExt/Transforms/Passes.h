@@ -65,6 +65,8 @@ void decomposeTiledAttention(IREE::LinalgExt::AttentionOp tiledAttnOp,
 // Creates a pass to convert the attention op into a sequence of
 // linalg ops.
 std::unique_ptr<Pass> createTileAndDecomposeAttentionPass();
+std::unique_ptr<Pass> createTileAndDecomposeAttentionPass(bool onlyTile,
+                                                          uint64_t tileSize);
 
 //===---------------------------------------------------------------------===//
 // Codegen Strategy passes that are moved into IREE.
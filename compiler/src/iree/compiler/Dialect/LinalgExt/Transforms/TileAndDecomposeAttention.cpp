@@ -599,11 +599,24 @@ namespace {
 ///
 LogicalResult reifyAttentionTransform(mlir::FunctionOpInterface funcOp,
                                       bool onlyTile,
-                                      std::optional<uint64_t> tileSize) {
+                                      std::optional<uint64_t> tileSize,
+                                      bool onlyDivisibleTileSize) {
   IRRewriter rewriter(funcOp.getContext());
   funcOp.walk([&](IREE::LinalgExt::AttentionOp attnOp) {
     SmallVector<Operation *> ops;
-    tileAndDecomposeAttention(attnOp, ops, rewriter, onlyTile, tileSize);
+    // The key/value slices are extracted without bounds checking, so callers
+    // setting a default tile size request a fallback to a single full-length
+    // tile whenever the tile size does not evenly divide a static sequence
+    // length.
+    std::optional<uint64_t> opTileSize = tileSize;
+    if (opTileSize && onlyDivisibleTileSize) {
+      int64_t sequenceLength = attnOp.getKeyType().getDimSize(1);
+      if (ShapedType::isDynamic(sequenceLength) ||
+          sequenceLength % static_cast<int64_t>(*opTileSize) != 0) {
+        opTileSize = std::nullopt;
+      }
+    }
+    tileAndDecomposeAttention(attnOp, ops, rewriter, onlyTile, opTileSize);
     return WalkResult::advance();
   });
   return success();
@@ -622,11 +635,16 @@ struct TileAndDecomposeAttentionPass
   TileAndDecomposeAttentionPass() = default;
   TileAndDecomposeAttentionPass(bool onlyTile, uint64_t tileSize) {
     this->onlyTile = onlyTile;
-    this->tileSize = tileSize;
+    // Zero means no tiling of the sequence dimension was requested.
+    if (tileSize != 0) {
+      this->tileSize = tileSize;
+      this->onlyDivisibleTileSize = true;
+    }
   }
   TileAndDecomposeAttentionPass(const TileAndDecomposeAttentionPass &pass) {
     onlyTile = pass.onlyTile;
     tileSize = pass.tileSize;
+    onlyDivisibleTileSize = pass.onlyDivisibleTileSize;
   }
   void runOnOperation() override;
 };
@@ -640,7 +658,8 @@ void TileAndDecomposeAttentionPass::runOnOperation() {
     optionalTileSize = tileSize.getValue();
   }
   if (failed(reifyAttentionTransform(getOperation(), onlyTile,
-                                     optionalTileSize))) {
+                                     optionalTileSize,
+                                     onlyDivisibleTileSize))) {
     return signalPassFailure();
   }
 }
@@ -649,6 +668,11 @@ std::unique_ptr<Pass> createTileAndDecomposeAttentionPass() {
   return std::make_unique<TileAndDecomposeAttentionPass>();
 }
 
+std::unique_ptr<Pass> createTileAndDecomposeAttentionPass(bool onlyTile,
+                                                          uint64_t tileSize) {
+  return std::make_unique<TileAndDecomposeAttentionPass>(onlyTile, tileSize);
+}
+
 } // namespace LinalgExt
 } // namespace IREE
 } // namespace iree_compiler
@@ -0,0 +1,110 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/compiler/Dialect/Stream/IR/StreamDialect.h"
+#include "iree/compiler/Dialect/Stream/IR/StreamOps.h"
+#include "iree/compiler/Dialect/Stream/IR/StreamTypes.h"
+#include "iree/compiler/Dialect/Stream/Transforms/Passes.h"
+#include "mlir/IR/Attributes.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/Pass/Pass.h"
+
+namespace mlir::iree_compiler::IREE::Stream {
+
+#define GEN_PASS_DEF_ANNOTATESMALLTRANSIENTSPASS
+#include "iree/compiler/Dialect/Stream/Transforms/Passes.h.inc"
+
+namespace {
+
+// Attribute carrying the result ordinals of a dispatch that produce small
+// transients consumed by exactly one other dispatch. Consumed by tooling and
+// fusion heuristics upstream of stream formation.
+static const char kPromotableAttrName[] = "stream.promotable";
+
+static std::optional<int64_t> matchConstant(Value value) {
+  if (!value)
+    return std::nullopt;
+  APInt constant;
+  if (!matchPattern(value, m_ConstantInt(&constant)))
+    return std::nullopt;
+  return constant.getSExtValue();
+}
+
+// Returns true if |result| is a freshly allocated transient of statically
+// known size <= |maxSize| whose only consumer is a single other dispatch.
+// Such results round-trip through device memory between two dispatches that
+// a shifted fusion boundary could have kept in workgroup-local storage.
+static bool isSmallHandoffResult(IREE::Stream::AsyncDispatchOp dispatchOp,
+                                 OpResult result, Value resultSize,
+                                 int64_t maxSize) {
+  // Tied results alias an operand and are not fresh transients.
+  if (dispatchOp.getTiedResultOperandIndex(result.getResultNumber())
+          .has_value()) {
+    return false;
+  }
+
+  auto resourceType =
+      llvm::dyn_cast<IREE::Stream::ResourceType>(result.getType());
+  if (!resourceType ||
+      resourceType.getLifetime() != IREE::Stream::Lifetime::Transient) {
+    return false;
+  }
+
+  auto size = matchConstant(resultSize);
+  if (!size || *size > maxSize)
+    return false;
+
+  // All uses must be reads by one single other dispatch; anything else
+  // (transfers, exports, multiple consumers) keeps the resource live in
+  // device memory anyway.
+  Operation *consumerOp = nullptr;
+  for (Operation *userOp : result.getUsers()) {
+    auto userDispatchOp = dyn_cast<IREE::Stream::AsyncDispatchOp>(userOp);
+    if (!userDispatchOp || userDispatchOp == dispatchOp)
+      return false;
+    if (consumerOp && consumerOp != userOp)
+      return false;
+    consumerOp = userOp;
+    // The consumer must not tie the resource to one of its own results; a
+    // tied use extends the lifetime beyond the handoff.
+    for (OpOperand &use : userOp->getOpOperands()) {
+      if (use.get() != result)
+        continue;
+      if (userDispatchOp.isOperandTied(use.getOperandNumber()))
+        return false;
+    }
+  }
+  return consumerOp != nullptr;
+}
+
+struct AnnotateSmallTransientsPass
+    : public IREE::Stream::impl::AnnotateSmallTransientsPassBase<
+          AnnotateSmallTransientsPass> {
+  using IREE::Stream::impl::AnnotateSmallTransientsPassBase<
+      AnnotateSmallTransientsPass>::AnnotateSmallTransientsPassBase;
+  void runOnOperation() override {
+    getOperation()->walk([&](IREE::Stream::AsyncDispatchOp dispatchOp) {
+      SmallVector<int64_t> promotableOrdinals;
+      for (auto [result, resultSize] : llvm::zip_equal(
+               dispatchOp.getResults(), dispatchOp.getResultSizes())) {
+        if (isSmallHandoffResult(dispatchOp, result, resultSize, maxSize)) {
+          promotableOrdinals.push_back(result.getResultNumber());
+        }
+      }
+      if (promotableOrdinals.empty())
+        return;
+      Builder builder(dispatchOp.getContext());
+      dispatchOp->setAttr(kPromotableAttrName,
+                          builder.getI64ArrayAttr(promotableOrdinals));
+    });
+  }
+};
+
+} // namespace
+
+} // namespace mlir::iree_compiler::IREE::Stream
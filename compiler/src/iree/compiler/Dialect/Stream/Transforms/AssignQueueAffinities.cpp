@@ -0,0 +1,171 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/compiler/Dialect/HAL/IR/HALDialect.h"
+#include "iree/compiler/Dialect/HAL/IR/HALTypes.h"
+#include "iree/compiler/Dialect/Stream/IR/StreamDialect.h"
+#include "iree/compiler/Dialect/Stream/IR/StreamOps.h"
+#include "iree/compiler/Dialect/Stream/Transforms/Passes.h"
+#include "iree/compiler/Dialect/Util/IR/UtilTypes.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/Debug.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/Pass/Pass.h"
+
+#define DEBUG_TYPE "iree-stream-assign-queue-affinities"
+
+namespace mlir::iree_compiler::IREE::Stream {
+
+#define GEN_PASS_DEF_ASSIGNQUEUEAFFINITIESPASS
+#include "iree/compiler/Dialect/Stream/Transforms/Passes.h.inc"
+
+namespace {
+
+//===----------------------------------------------------------------------===//
+// Cost model
+//===----------------------------------------------------------------------===//
+
+// Estimate used for resources whose size is not statically known.
+// Dynamic sizes are usually data-dependent activations; weigh them as
+// moderately large rather than free so they still participate in balancing.
+static constexpr int64_t kDynamicSizeEstimate = 64 * 1024;
+
+// Estimates the relative execution cost of a streamable |op| as the total
+// byte volume moved through it. Without target codegen statistics available
+// at this phase bytes in/out is the best stable proxy we have: dispatch time
+// on memory-bound ML workloads tracks bytes touched and transfer time is
+// bytes over link bandwidth.
+static int64_t estimateStreamableCost(Operation *op) {
+  int64_t byteVolume = 0;
+  if (auto sizeAwareOp = dyn_cast<IREE::Util::SizeAwareOpInterface>(op)) {
+    auto accumulate = [&](Value size) {
+      if (!size)
+        return;
+      APInt staticSize;
+      if (matchPattern(size, m_ConstantInt(&staticSize))) {
+        byteVolume += staticSize.getSExtValue();
+      } else {
+        byteVolume += kDynamicSizeEstimate;
+      }
+    };
+    for (unsigned i = 0; i < op->getNumOperands(); ++i) {
+      if (isa<IREE::Stream::ResourceType>(op->getOperand(i).getType())) {
+        accumulate(sizeAwareOp.getOperandSize(i));
+      }
+    }
+    for (unsigned i = 0; i < op->getNumResults(); ++i) {
+      if (isa<IREE::Stream::ResourceType>(op->getResult(i).getType())) {
+        accumulate(sizeAwareOp.getResultSize(i));
+      }
+    }
+  }
+  return byteVolume + 1; // non-zero so op count still balances
+}
+
+//===----------------------------------------------------------------------===//
+// Balanced contiguous partitioning
+//===----------------------------------------------------------------------===//
+
+// Returns the number of contiguous stages required to keep every stage's cost
+// sum <= |capacity|.
+static int64_t countStagesForCapacity(ArrayRef<int64_t> costs,
+                                      int64_t capacity) {
+  int64_t stageCount = 1;
+  int64_t stageCost = 0;
+  for (int64_t cost : costs) {
+    if (stageCost + cost > capacity) {
+      ++stageCount;
+      stageCost = 0;
+    }
+    stageCost += cost;
+  }
+  return stageCount;
+}
+
+// Assigns each cost index a stage in [0, stageCount) such that stages are
+// contiguous in program order and the maximum stage cost is minimized.
+// Contiguity keeps the number of cross-stage SSA (and thus timepoint) edges
+// at stageCount - 1 for straight-line programs - the pipeline-parallel shape.
+static SmallVector<int64_t> partitionBalanced(ArrayRef<int64_t> costs,
+                                              int64_t stageCount) {
+  // Binary search the smallest per-stage capacity that fits in stageCount
+  // stages; the greedy fill below is optimal for the min-max contiguous
+  // partitioning problem when paired with this search.
+  int64_t low = *std::max_element(costs.begin(), costs.end());
+  int64_t high = 0;
+  for (int64_t cost : costs)
+    high += cost;
+  while (low < high) {
+    int64_t mid = low + (high - low) / 2;
+    if (countStagesForCapacity(costs, mid) <= stageCount) {
+      high = mid;
+    } else {
+      low = mid + 1;
+    }
+  }
+  int64_t capacity = low;
+
+  SmallVector<int64_t> assignments(costs.size());
+  int64_t stage = 0;
+  int64_t stageCost = 0;
+  for (auto [i, cost] : llvm::enumerate(costs)) {
+    if (stageCost + cost > capacity && stage + 1 < stageCount) {
+      ++stage;
+      stageCost = 0;
+    }
+    stageCost += cost;
+    assignments[i] = stage;
+  }
+  return assignments;
+}
+
+//===----------------------------------------------------------------------===//
+// --iree-stream-assign-queue-affinities
+//===----------------------------------------------------------------------===//
+
+struct AssignQueueAffinitiesPass
+    : public IREE::Stream::impl::AssignQueueAffinitiesPassBase<
+          AssignQueueAffinitiesPass> {
+  using IREE::Stream::impl::AssignQueueAffinitiesPassBase<
+      AssignQueueAffinitiesPass>::AssignQueueAffinitiesPassBase;
+  void runOnOperation() override {
+    auto parentOp = getOperation();
+    if (queueCount < 2 || !parentOp.getCallableRegion() ||
+        parentOp.getCallableRegion()->empty()) {
+      return;
+    }
+
+    // Gather unpinned streamable ops in program order along with their cost
+    // estimates. Ops the user has already pinned keep their affinities and
+    // don't participate in balancing.
+    SmallVector<IREE::Stream::AffinityOpInterface> placeableOps;
+    SmallVector<int64_t> costs;
+    parentOp.walk([&](Operation *op) {
+      if (!isa<IREE::Stream::StreamableOpInterface>(op))
+        return;
+      auto affinityOp = dyn_cast<IREE::Stream::AffinityOpInterface>(op);
+      if (!affinityOp || !affinityOp.requiresAffinity() ||
+          affinityOp.getAffinity()) {
+        return;
+      }
+      placeableOps.push_back(affinityOp);
+      costs.push_back(estimateStreamableCost(op));
+    });
+    if (placeableOps.empty())
+      return;
+
+    auto assignments =
+        partitionBalanced(costs, std::min<int64_t>(queueCount, costs.size()));
+    for (auto [affinityOp, stage] : llvm::zip_equal(placeableOps, assignments)) {
+      affinityOp.setAffinity(
+          IREE::HAL::AffinityQueueAttr::get(&getContext(), 1ll << stage));
+    }
+  }
+};
+
+} // namespace
+
+} // namespace mlir::iree_compiler::IREE::Stream
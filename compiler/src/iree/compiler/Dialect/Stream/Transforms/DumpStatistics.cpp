@@ -57,6 +57,10 @@ struct UsageInfo {
   // stream.timepoint.await ops indicating host/device synchronization.
   SmallVector<IREE::Stream::TimepointAwaitOp> awaitOps;
 
+  // Aggregate transient slab packing results recorded by LayoutSlices.
+  int64_t packedSlabSize = 0;
+  int64_t packedMinSize = 0;
+
   void analyze(mlir::ModuleOp moduleOp) {
     SymbolTable symbolTable(moduleOp);
     for (auto globalOp : moduleOp.getOps<IREE::Util::GlobalOp>()) {
@@ -68,6 +72,14 @@ struct UsageInfo {
       executableOps[executableOp.getName()] = executableOp;
     }
     for (auto funcOp : moduleOp.getOps<mlir::FunctionOpInterface>()) {
+      if (auto slabSizeAttr =
+              funcOp->getAttrOfType<IntegerAttr>("stream.packing.slab_size")) {
+        packedSlabSize += slabSizeAttr.getInt();
+      }
+      if (auto minSizeAttr =
+              funcOp->getAttrOfType<IntegerAttr>("stream.packing.min_size")) {
+        packedMinSize += minSizeAttr.getInt();
+      }
       funcOp.walk([&](Operation *op) {
         TypeSwitch<Operation *>(op)
             .Case<IREE::Util::BufferConstantOp>(
@@ -112,6 +124,8 @@ struct Statistics {
   size_t submissionCount = 0;
   int64_t transientSize = 0;
   bool transientSizeDynamic = false;
+  int64_t packedSlabSize = 0;
+  int64_t packedMinSize = 0;
   // TODO(benvanik): add fill/copy sizes (when possible).
   size_t fillCount = 0;
   size_t copyCount = 0;
@@ -153,6 +167,8 @@ struct Statistics {
 
     // Execution:
     submissionCount = usageInfo.executeOps.size();
+    packedSlabSize = usageInfo.packedSlabSize;
+    packedMinSize = usageInfo.packedMinSize;
     for (auto allocaOp : usageInfo.allocaOps) {
       APInt allocaSize;
       if (matchPattern(allocaOp.getStorageSize(), m_ConstantInt(&allocaSize))) {
@@ -243,6 +259,13 @@ static void prettyPrintStatistics(const UsageInfo &usageInfo,
   os << llvm::formatv(
       "{0}{1} B ({2:F2} MiB)\n", stats.transientSizeDynamic ? "minimum " : "",
       stats.transientSize, stats.transientSize / (1 * 1024 * 1024.0f));
+  if (stats.packedSlabSize > 0) {
+    os << llvm::formatv(
+        "//  Pack Slabs: {0} B packed, {1} B minimum live, {2}% utilization\n",
+        stats.packedSlabSize, stats.packedMinSize,
+        (int)std::roundf(stats.packedMinSize / (float)stats.packedSlabSize *
+                         100.0f));
+  }
 
   os << llvm::formatv("//   DMA Fills: {0}\n", stats.fillCount);
   os << llvm::formatv("//  DMA Copies: {0}\n", stats.copyCount);
@@ -0,0 +1,199 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <memory>
+#include <string>
+
+#include "iree/compiler/Dialect/Stream/IR/StreamDialect.h"
+#include "iree/compiler/Dialect/Stream/IR/StreamOps.h"
+#include "iree/compiler/Dialect/Stream/IR/StreamTypes.h"
+#include "iree/compiler/Dialect/Stream/Transforms/Passes.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/Interfaces/FunctionInterfaces.h"
+#include "mlir/Pass/Pass.h"
+
+namespace mlir::iree_compiler::IREE::Stream {
+
+#define GEN_PASS_DEF_DUMPTIMEPOINTGRAPHPASS
+#include "iree/compiler/Dialect/Stream/Transforms/Passes.h.inc"
+
+namespace {
+
+//===----------------------------------------------------------------------===//
+// Timepoint graph printing
+//===----------------------------------------------------------------------===//
+
+static bool isTimepointType(Type type) {
+  return llvm::isa<IREE::Stream::TimepointType>(type);
+}
+
+// Returns true if |op| produces or consumes !stream.timepoint values and
+// should appear as a node in the dependency graph.
+static bool isTimepointNode(Operation *op) {
+  return llvm::any_of(op->getResultTypes(), isTimepointType) ||
+         llvm::any_of(op->getOperandTypes(), isTimepointType);
+}
+
+// Emits one DOT digraph per function containing the timepoint dependency
+// edges as they exist after all scheduling optimization has completed.
+// Nodes with no path between them are expected to execute concurrently;
+// observed runtime waits along absent edges indicate over-serialization.
+class TimepointGraphPrinter {
+public:
+  explicit TimepointGraphPrinter(llvm::raw_ostream &os) : os(os) {}
+
+  void print(mlir::FunctionOpInterface funcOp) {
+    SmallVector<Operation *> nodeOps;
+    funcOp.walk([&](Operation *op) {
+      if (isTimepointNode(op))
+        nodeOps.push_back(op);
+    });
+    if (nodeOps.empty())
+      return;
+
+    os << "digraph \"";
+    printEscaped(funcOp.getName());
+    os << "\" {\n";
+    os << "  node [shape=box, fontname=\"monospace\"];\n";
+
+    // Declare all operation nodes before emitting edges so that producers
+    // referenced across blocks resolve to their real node.
+    for (auto *op : nodeOps)
+      declareOpNode(op);
+    for (auto *op : nodeOps) {
+      for (auto operand : op->getOperands()) {
+        if (!isTimepointType(operand.getType()))
+          continue;
+        os << "  n" << getValueNode(operand) << " -> n" << opNodes[op]
+           << ";\n";
+      }
+    }
+
+    os << "}\n";
+  }
+
+private:
+  // Declares a node for |op| and claims its timepoint results.
+  void declareOpNode(Operation *op) {
+    int id = nextNodeId++;
+    opNodes[op] = id;
+    for (auto result : op->getResults()) {
+      if (isTimepointType(result.getType()))
+        valueNodes[result] = id;
+    }
+    os << "  n" << id << " [label=\"";
+    printEscaped(op->getName().getStringRef());
+    printLocation(op->getLoc());
+    if (auto affinityAttr = op->getAttr("affinity")) {
+      std::string affinityStr;
+      llvm::raw_string_ostream affinityOS(affinityStr);
+      affinityAttr.print(affinityOS);
+      os << "\\n";
+      printEscaped(affinityStr);
+    }
+    os << "\"";
+    // Host synchronization points are the places serialization is observed;
+    // highlight them so graph consumers can match them against runtime waits.
+    if (isa<IREE::Stream::TimepointAwaitOp>(op)) {
+      os << ", style=filled, fillcolor=lightyellow";
+    }
+    os << "];\n";
+  }
+
+  // Returns the node producing |value|, synthesizing a source node for
+  // timepoints entering the function (arguments/loop-carried values).
+  int getValueNode(Value value) {
+    auto it = valueNodes.find(value);
+    if (it != valueNodes.end())
+      return it->second;
+    int id = nextNodeId++;
+    valueNodes[value] = id;
+    os << "  n" << id << " [label=\"external timepoint\", shape=ellipse];\n";
+    return id;
+  }
+
+  // Appends a short source location when one survives in the final IR;
+  // fused/unknown locations are elided to keep the graph readable.
+  void printLocation(Location loc) {
+    if (auto fileLoc = llvm::dyn_cast<FileLineColLoc>(loc)) {
+      std::string locStr;
+      llvm::raw_string_ostream locOS(locStr);
+      locOS << fileLoc.getFilename().getValue() << ":" << fileLoc.getLine();
+      os << "\\n";
+      printEscaped(locStr);
+    } else if (auto nameLoc = llvm::dyn_cast<NameLoc>(loc)) {
+      os << "\\n";
+      printEscaped(nameLoc.getName().getValue());
+    }
+  }
+
+  // Writes |str| with DOT label metacharacters escaped.
+  void printEscaped(StringRef str) {
+    for (char c : str) {
+      if (c == '"' || c == '\\')
+        os << '\\';
+      os << c;
+    }
+  }
+
+  llvm::raw_ostream &os;
+  int nextNodeId = 0;
+  DenseMap<Value, int> valueNodes;
+  DenseMap<Operation *, int> opNodes;
+};
+
+//===----------------------------------------------------------------------===//
+// --iree-stream-dump-timepoint-graph
+//===----------------------------------------------------------------------===//
+
+// Opens a canonical |filePath| for text output.
+// An empty path can be used to target stderr and `-` will go to stdout.
+// If the file cannot be opened stderr will be used.
+static std::unique_ptr<llvm::raw_fd_ostream>
+openOutputFile(StringRef filePath) {
+  if (filePath.empty()) {
+    return std::make_unique<llvm::raw_fd_ostream>(2, false); // stderr
+  } else if (filePath == "-") {
+    return std::make_unique<llvm::raw_fd_ostream>(1, false); // stdout
+  } else {
+    std::error_code ec;
+    auto result = std::make_unique<llvm::raw_fd_ostream>(
+        filePath, ec, llvm::sys::fs::OF_TextWithCRLF);
+    if (!ec)
+      return result;
+    llvm::errs()
+        << "Error opening iree-stream-dump-timepoint-graph output file '"
+        << filePath << "'\n";
+    return std::make_unique<llvm::raw_fd_ostream>(2, false); // stderr.
+  }
+}
+
+struct DumpTimepointGraphPass
+    : public IREE::Stream::impl::DumpTimepointGraphPassBase<
+          DumpTimepointGraphPass> {
+  using IREE::Stream::impl::DumpTimepointGraphPassBase<
+      DumpTimepointGraphPass>::DumpTimepointGraphPassBase;
+  void runOnOperation() override {
+    // Open the output file we'll be streaming to.
+    // Since we are processing the entire module at once we overwrite the file.
+    auto os = openOutputFile(outputFile);
+
+    for (auto funcOp : getOperation().getOps<mlir::FunctionOpInterface>()) {
+      if (funcOp.isExternal())
+        continue;
+      TimepointGraphPrinter(*os).print(funcOp);
+    }
+
+    os->flush();
+  }
+};
+
+} // namespace
+
+} // namespace mlir::iree_compiler::IREE::Stream
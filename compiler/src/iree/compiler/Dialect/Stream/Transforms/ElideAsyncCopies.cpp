@@ -23,6 +23,7 @@
 #include "mlir/IR/Builders.h"
 #include "mlir/IR/BuiltinTypes.h"
 #include "mlir/IR/Diagnostics.h"
+#include "mlir/IR/Dominance.h"
 #include "mlir/Interfaces/FunctionInterfaces.h"
 #include "mlir/Pass/Pass.h"
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
@@ -307,6 +308,7 @@ public:
   }
 
   AsmState &getAsmState() { return solver.getAsmState(); }
+  Explorer &getExplorer() { return explorer; }
 
   // Runs analysis and populates the state cache.
   // May fail if analysis cannot be completed due to unsupported or unknown IR.
@@ -443,6 +445,100 @@ static void elideCloneOp(IREE::Stream::AsyncCloneOp cloneOp) {
   cloneOp.erase();
 }
 
+//===----------------------------------------------------------------------===//
+// IREE::Stream::AsyncTransferOp elision
+//===----------------------------------------------------------------------===//
+
+// Returns true if any user of |value| may mutate it in-place via a tied
+// operand. Extending the live range of such a value past the mutation would
+// observe the new contents instead of the snapshot a transfer captured.
+static bool mayBeMutatedByUsers(Value value) {
+  for (auto &use : value.getUses()) {
+    if (auto tiedOp = dyn_cast<IREE::Util::TiedOpInterface>(use.getOwner())) {
+      if (tiedOp.isOperandTied(use.getOperandNumber()))
+        return true;
+    }
+  }
+  return false;
+}
+
+// Returns the origin value of a transfer round trip completed by |transferOp|
+// or nullptr if the source does not provably originate as a transfer of a
+// single value from the target affinity/type. The transfer op folders handle
+// the trivial same-block case; here we use whole-program analysis to walk
+// through block arguments and calls so that staged host readbacks inside loops
+// (read scores on host, continue with the device value) don't round trip:
+//
+//   %0 device ---> %1 = transfer(%0) to host ---> host reads %1
+//                                           \--> %2 = transfer(%1) to device
+//
+// %2 can be replaced with %0; the device->host transfer remains for the host
+// reads (and is cleaned up later if unused).
+static Value
+findTransferRoundTripOrigin(IREE::Stream::AsyncTransferOp transferOp,
+                            ElisionAnalysis &analysis, DominanceInfo &domInfo) {
+  LLVM_DEBUG({
+    llvm::dbgs() << "findTransferRoundTripOrigin:\n";
+    llvm::dbgs() << "  ";
+    transferOp.print(llvm::dbgs(), analysis.getAsmState());
+    llvm::dbgs() << "\n";
+  });
+
+  // Find all possible definitions of the transfer source. All must be
+  // transfers of the same origin value from the affinity/type this transfer
+  // is returning to.
+  auto resultType = transferOp.getResult().getType();
+  Value origin;
+  bool allMatch = true;
+  auto traversalResult = analysis.getExplorer().walkDefiningOps(
+      transferOp.getSource(), [&](OpResult result) -> WalkResult {
+        auto sourceTransferOp =
+            dyn_cast<IREE::Stream::AsyncTransferOp>(result.getOwner());
+        if (!sourceTransferOp ||
+            sourceTransferOp.getSource().getType() != resultType ||
+            sourceTransferOp.getSourceAffinityAttr() !=
+                transferOp.getResultAffinityAttr() ||
+            (origin && origin != sourceTransferOp.getSource())) {
+          allMatch = false;
+          return WalkResult::interrupt();
+        }
+        origin = sourceTransferOp.getSource();
+        return WalkResult::advance();
+      });
+  if (!allMatch || !origin ||
+      traversalResult == TraversalResult::INCOMPLETE) {
+    LLVM_DEBUG(llvm::dbgs() << "  - source is not a round trip of a single "
+                               "matching transfer; cannot elide\n");
+    return {};
+  }
+
+  // The origin must be reusable at the site of this transfer.
+  if (!domInfo.properlyDominates(origin, transferOp)) {
+    LLVM_DEBUG(llvm::dbgs()
+               << "  - origin does not dominate transfer; cannot elide\n");
+    return {};
+  }
+
+  // If the origin may be mutated in-place the transferred snapshot and the
+  // origin storage can diverge and we need to preserve the copies.
+  if (mayBeMutatedByUsers(origin)) {
+    LLVM_DEBUG(llvm::dbgs()
+               << "  - origin has tied (mutating) users; cannot elide\n");
+    return {};
+  }
+
+  LLVM_DEBUG(llvm::dbgs() << "  + transfer round trip can be elided\n");
+  return origin;
+}
+
+// Elides a stream.async.transfer op by replacing all uses with the origin
+// value the round trip started from.
+static void elideTransferOp(IREE::Stream::AsyncTransferOp transferOp,
+                            Value origin) {
+  transferOp.replaceAllUsesWith(origin);
+  transferOp.erase();
+}
+
 //===----------------------------------------------------------------------===//
 // IREE::Stream::AsyncSliceOp elision
 //===----------------------------------------------------------------------===//
@@ -636,6 +732,7 @@ static void elideSliceOp(IREE::Stream::AsyncSliceOp sliceOp) {
 static bool tryElideAsyncCopiesInRegion(Region &region,
                                         ElisionAnalysis &analysis) {
   bool didChange = false;
+  DominanceInfo domInfo(region.getParentOp());
   for (auto &block : region) {
     block.walk([&](Operation *op) {
       return TypeSwitch<Operation *, WalkResult>(op)
@@ -646,6 +743,14 @@ static bool tryElideAsyncCopiesInRegion(Region &region,
             }
             return WalkResult::advance();
           })
+          .Case<IREE::Stream::AsyncTransferOp>([&](auto transferOp) {
+            if (Value origin =
+                    findTransferRoundTripOrigin(transferOp, analysis, domInfo)) {
+              elideTransferOp(transferOp, origin);
+              didChange = true;
+            }
+            return WalkResult::advance();
+          })
           .Case<IREE::Stream::AsyncSliceOp>([&](auto sliceOp) {
             if (isSafeToElideSliceOp(sliceOp, analysis)) {
               elideSliceOp(sliceOp);
@@ -660,7 +765,8 @@ static bool tryElideAsyncCopiesInRegion(Region &region,
 }
 
 // Elides async copies that perform no meaningful work - such as clones of the
-// last use of a value. This is designed to be run after
+// last use of a value or transfers that return a resource to the
+// affinity/type it originated from. This is designed to be run after
 // --iree-stream-materialize-copy-on-write to clean up the copies it introduces
 // but will also pick up any copies that came from the frontend.
 //
@@ -0,0 +1,104 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/compiler/Dialect/Stream/IR/StreamDialect.h"
+#include "iree/compiler/Dialect/Stream/Transforms/Passes.h"
+#include "iree/compiler/Dialect/Util/IR/UtilDialect.h"
+#include "iree/compiler/Dialect/Util/IR/UtilOps.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/Pass/Pass.h"
+
+namespace mlir::iree_compiler::IREE::Stream {
+
+#define GEN_PASS_DEF_EMITBATCHEDENTRYPOINTSPASS
+#include "iree/compiler/Dialect/Stream/Transforms/Passes.h.inc"
+
+namespace {
+
+//===----------------------------------------------------------------------===//
+// Batch entry point emission
+//===----------------------------------------------------------------------===//
+
+// Emits a public `@foo_batchN` function wrapping |entryFuncOp| that takes N
+// independent sets of the original arguments and issues N calls to the
+// original function. Each call carries its own resource/timepoint chains with
+// no cross-call data dependencies so subsequent scheduling passes (and the
+// runtime timeline) are free to overlap the requests; after inlining the
+// partitioning passes can additionally merge them into concurrent stream
+// partitions.
+static void emitBatchedEntryPoint(IREE::Util::FuncOp entryFuncOp,
+                                  int64_t batchSize) {
+  OpBuilder moduleBuilder(entryFuncOp.getContext());
+  moduleBuilder.setInsertionPointAfter(entryFuncOp);
+  Location loc = entryFuncOp.getLoc();
+
+  // Repeat the original signature batchSize times; request i owns argument
+  // and result ranges [i * original count, (i + 1) * original count).
+  auto funcType = entryFuncOp.getFunctionType();
+  SmallVector<Type> argTypes;
+  SmallVector<Type> resultTypes;
+  for (int64_t i = 0; i < batchSize; ++i) {
+    llvm::append_range(argTypes, funcType.getInputs());
+    llvm::append_range(resultTypes, funcType.getResults());
+  }
+
+  auto batchFuncName =
+      (entryFuncOp.getName() + "_batch" + std::to_string(batchSize)).str();
+  auto batchFuncOp = moduleBuilder.create<IREE::Util::FuncOp>(
+      loc, batchFuncName, moduleBuilder.getFunctionType(argTypes, resultTypes));
+  batchFuncOp.setPublic();
+  if (auto stubAttr = entryFuncOp->getAttr("iree.abi.stub")) {
+    batchFuncOp->setAttr("iree.abi.stub", stubAttr);
+  }
+  // NOTE: reflection metadata describes the batch-1 signature and would be
+  // misleading on the widened function so it is intentionally not copied.
+
+  Block *block = batchFuncOp.addEntryBlock();
+  auto blockBuilder = OpBuilder::atBlockBegin(block);
+  unsigned argCount = funcType.getNumInputs();
+  SmallVector<Value> results;
+  for (int64_t i = 0; i < batchSize; ++i) {
+    auto args = block->getArguments().slice(i * argCount, argCount);
+    auto callOp = blockBuilder.create<IREE::Util::CallOp>(
+        loc, entryFuncOp, SmallVector<Value>(args.begin(), args.end()));
+    llvm::append_range(results, callOp.getResults());
+  }
+  blockBuilder.create<IREE::Util::ReturnOp>(loc, results);
+}
+
+//===----------------------------------------------------------------------===//
+// --iree-stream-emit-batched-entry-points
+//===----------------------------------------------------------------------===//
+
+struct EmitBatchedEntryPointsPass
+    : public IREE::Stream::impl::EmitBatchedEntryPointsPassBase<
+          EmitBatchedEntryPointsPass> {
+  using IREE::Stream::impl::EmitBatchedEntryPointsPassBase<
+      EmitBatchedEntryPointsPass>::EmitBatchedEntryPointsPassBase;
+  void runOnOperation() override {
+    // Nothing to do at batch-1: the original entry points already exist.
+    if (batchSize < 2)
+      return;
+    auto moduleOp = getOperation();
+
+    // Gather entry points first as we insert new functions while iterating.
+    SmallVector<IREE::Util::FuncOp> entryFuncOps;
+    for (auto funcOp : moduleOp.getOps<IREE::Util::FuncOp>()) {
+      if (funcOp.isPublic() && !funcOp.isExternal()) {
+        entryFuncOps.push_back(funcOp);
+      }
+    }
+
+    for (auto entryFuncOp : entryFuncOps) {
+      emitBatchedEntryPoint(entryFuncOp, batchSize);
+    }
+  }
+};
+
+} // namespace
+
+} // namespace mlir::iree_compiler::IREE::Stream
@@ -0,0 +1,132 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/compiler/Dialect/Stream/IR/StreamDialect.h"
+#include "iree/compiler/Dialect/Stream/IR/StreamOps.h"
+#include "iree/compiler/Dialect/Stream/Transforms/Passes.h"
+#include "iree/compiler/Dialect/Util/IR/UtilTypes.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/Debug.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/Pass/Pass.h"
+
+#define DEBUG_TYPE "iree-stream-hoist-invariant-collectives"
+
+namespace mlir::iree_compiler::IREE::Stream {
+
+#define GEN_PASS_DEF_HOISTINVARIANTCOLLECTIVESPASS
+#include "iree/compiler/Dialect/Stream/Transforms/Passes.h.inc"
+
+namespace {
+
+//===----------------------------------------------------------------------===//
+// Invariant collective hoisting
+//===----------------------------------------------------------------------===//
+
+// Returns true if |forOp| has statically-known bounds guaranteeing at least
+// one iteration. Collectives must be issued by every rank of a channel or the
+// remaining ranks hang; hoisting out of a loop that may run zero times would
+// introduce an unmatched issue, so we only hoist when the loop provably runs.
+static bool loopAlwaysExecutes(scf::ForOp forOp) {
+  APInt lowerBound, upperBound, step;
+  if (!matchPattern(forOp.getLowerBound(), m_ConstantInt(&lowerBound)) ||
+      !matchPattern(forOp.getUpperBound(), m_ConstantInt(&upperBound)) ||
+      !matchPattern(forOp.getStep(), m_ConstantInt(&step))) {
+    return false;
+  }
+  return step.isStrictlyPositive() && upperBound.sgt(lowerBound);
+}
+
+// Returns true if |collectiveOp| re-broadcasts the same bytes each iteration
+// of |forOp| and can be issued once in the loop preheader instead.
+static bool isHoistableBroadcast(IREE::Stream::AsyncCollectiveOp collectiveOp,
+                                 scf::ForOp forOp) {
+  // Only replicating collectives are idempotent with respect to repetition;
+  // reductions and gathers of invariant data are rare enough that we don't
+  // bother proving them safe here.
+  if (collectiveOp.getOp().getKind() !=
+      IREE::Stream::CollectiveKind::Broadcast) {
+    return false;
+  }
+
+  // Hoisting is only valid directly out of the loop body; collectives nested
+  // in further control flow may be conditionally issued.
+  if (collectiveOp->getParentOp() != forOp)
+    return false;
+
+  // Every operand (source, target, sizes, channel, rank) must be defined
+  // above the loop: the broadcast then moves the same bytes every iteration.
+  for (Value operand : collectiveOp->getOperands()) {
+    if (!forOp.isDefinedOutsideOfLoop(operand))
+      return false;
+  }
+
+  // The collective writes into its tied target; if anything else in the loop
+  // touches the target storage the per-iteration re-broadcast may be
+  // observable and we conservatively leave it in place.
+  for (Operation *user : collectiveOp.getTarget().getUsers()) {
+    if (user != collectiveOp && forOp->isAncestor(user))
+      return false;
+  }
+
+  // Consumers inside the loop must only read the result; a tied (in-place)
+  // use would clobber it and rely on the next iteration broadcasting again.
+  for (OpOperand &use : collectiveOp.getResult().getUses()) {
+    if (forOp->isAncestor(use.getOwner()) &&
+        IREE::Util::detail::isOperandTied(use.getOwner(),
+                                          use.getOperandNumber())) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+//===----------------------------------------------------------------------===//
+// --iree-stream-hoist-invariant-collectives
+//===----------------------------------------------------------------------===//
+
+struct HoistInvariantCollectivesPass
+    : public IREE::Stream::impl::HoistInvariantCollectivesPassBase<
+          HoistInvariantCollectivesPass> {
+  void runOnOperation() override {
+    auto parentOp = getOperation();
+    if (!parentOp.getCallableRegion() ||
+        parentOp.getCallableRegion()->empty()) {
+      return;
+    }
+
+    // Gather loops innermost-first so that a collective hoisted out of an
+    // inner loop is considered again for each enclosing loop.
+    SmallVector<scf::ForOp> forOps;
+    parentOp.getCallableRegion()->walk(
+        [&](scf::ForOp forOp) { forOps.push_back(forOp); });
+
+    for (auto forOp : forOps) {
+      if (!loopAlwaysExecutes(forOp))
+        continue;
+      SmallVector<IREE::Stream::AsyncCollectiveOp> candidateOps;
+      for (auto collectiveOp :
+           forOp.getBody()->getOps<IREE::Stream::AsyncCollectiveOp>()) {
+        if (isHoistableBroadcast(collectiveOp, forOp))
+          candidateOps.push_back(collectiveOp);
+      }
+      for (auto collectiveOp : candidateOps) {
+        LLVM_DEBUG(llvm::dbgs()
+                   << "hoisting loop-invariant collective out of loop: "
+                   << collectiveOp << "\n");
+        // All operands dominate the loop so the op can move to the preheader
+        // as-is; in-loop uses of the result remain dominated.
+        collectiveOp->moveBefore(forOp);
+      }
+    }
+  }
+};
+
+} // namespace
+
+} // namespace mlir::iree_compiler::IREE::Stream
@@ -14,6 +14,8 @@
 #include "iree/compiler/Dialect/Util/IR/UtilOps.h"
 #include "iree/compiler/Dialect/Util/IR/UtilTypes.h"
 #include "iree/compiler/Utils/IndexSet.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/Sequence.h"
 #include "llvm/Support/Debug.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/IR/AsmState.h"
@@ -34,32 +36,32 @@ namespace {
 
 using Slice = IREE::Stream::ResourcePackOp::Slice;
 
-// Packs a set of statically-sized slices by greedy strip packing.
+// Offsets computed for a set of statically-sized slices within a packed slab.
+struct StaticLayout {
+  // Slab-relative offset of each slice, 1:1 with the input slice list.
+  SmallVector<int64_t> offsets;
+  // Total slab size aligned to the range alignment requirements.
+  int64_t slabSize = 0;
+};
+
+// Places statically-sized |slices| one at a time in the given |order| by
+// best-fit into gaps between lifetime-overlapping reservations.
 //
-// This is the same algorithm used in tflite here:
+// This is the same placement used in tflite here:
 // https://github.com/tensorflow/tensorflow/blob/master/tensorflow/lite/simple_memory_arena.cc
-// It's not fantastic and can end up with a significant amount of wastage.
 // They do the packing at runtime and as such care more about performance than
-// we do while doing the packing here offline. For this initial version I
-// wanted to ensure we matched apples/apples their implementation.
-//
-// We should use a set of heuristics and pick the smallest one. There are also
+// we do while doing the packing here offline. Because placement quality is
+// strongly dependent on the order slices are visited we run this with several
+// orderings and keep whichever produces the smallest slab. There are also
 // some really great papers that have approximations (as all of these are -
 // 2D strip packing is NP-hard) such as
 // https://www.sciencedirect.com/science/article/pii/S0925772113001016 that
 // someone with a brain able to parse mathy papers can try implementing.
-//
-// Slice packed offset SSA values will be updated and start at the given
-// |baseOffset|. Returns |baseOffset| + the total size of the allocation
-// aligned to the requirements of |resourceConfig|.
-static Value
-packStaticSlicesGreedily(IREE::Stream::ResourcePackOp packOp, Value baseOffset,
-                         MutableArrayRef<Slice> slices,
-                         IREE::Stream::ResourceConfigAttr resourceConfig,
-                         IndexSet &indexSet, OpBuilder &builder) {
-  int64_t offsetAlignment = resourceConfig.getMinBufferOffsetAlignment();
-  int64_t rangeAlignment = resourceConfig.getMinBufferRangeAlignment();
-
+static StaticLayout placeStaticSlices(ArrayRef<Slice> slices,
+                                      ArrayRef<unsigned> order,
+                                      ArrayRef<int64_t> alignedSizes,
+                                      int64_t offsetAlignment,
+                                      int64_t rangeAlignment) {
   struct Reservation {
     const Slice *slice = nullptr;
     int64_t staticOffset = 0;
@@ -67,14 +69,16 @@ packStaticSlicesGreedily(IREE::Stream::ResourcePackOp packOp, Value baseOffset,
   };
   static constexpr int64_t UNASSIGNED = INT64_MAX;
 
+  StaticLayout layout;
+  layout.offsets.resize(slices.size());
+
   std::list<Reservation> reservations;
   int64_t highwaterMark = 0;
-  for (auto &slice : slices) {
+  for (unsigned sliceIndex : order) {
+    auto &slice = slices[sliceIndex];
+    int64_t alignedSize = alignedSizes[sliceIndex];
     int64_t bestOffset = UNASSIGNED;
     int64_t bestOffsetFit = UNASSIGNED;
-    int64_t staticSize =
-        cast<arith::ConstantIndexOp>(slice.dynamicSize.getDefiningOp()).value();
-    int64_t alignedSize = IREE::Util::align(staticSize, rangeAlignment);
 
     // Iterate through reservations (sorted by ascending offset) and identify
     // gaps in which the slice will fit. To reduce wastage we want to find the
@@ -113,17 +117,106 @@ packStaticSlicesGreedily(IREE::Stream::ResourcePackOp packOp, Value baseOffset,
       ++insertionIt;
     }
     reservations.insert(insertionIt, reservation);
-    slice.packedOffset.replaceAllUsesWith(builder.createOrFold<arith::AddIOp>(
-        packOp.getLoc(), baseOffset, indexSet.get(bestOffset)));
+    layout.offsets[sliceIndex] = bestOffset;
 
     // Update highwater mark indicating how much memory needs to be allocated
     // for the entire slab.
     highwaterMark = std::max(highwaterMark, bestOffset + alignedSize);
   }
 
-  highwaterMark = IREE::Util::align(highwaterMark, rangeAlignment);
+  layout.slabSize = IREE::Util::align(highwaterMark, rangeAlignment);
+  return layout;
+}
+
+// Returns a lower bound on the slab size required for |slices|: the largest
+// sum of aligned sizes of slices simultaneously live at any point in the
+// lifetime range. No packing can do better than this (though alignment padding
+// between slices means the bound is not always achievable).
+static int64_t computeStaticLayoutLowerBound(ArrayRef<Slice> slices,
+                                             ArrayRef<int64_t> alignedSizes,
+                                             int64_t rangeAlignment) {
+  // The maximum live set in an interval graph always occurs at an interval
+  // start point so only those need to be sampled. O(n^2) but n is the slice
+  // count of a single pack op and this runs offline.
+  int64_t lowerBound = 0;
+  for (auto [i, slice] : llvm::enumerate(slices)) {
+    int64_t liveSize = 0;
+    for (auto [j, other] : llvm::enumerate(slices)) {
+      if (other.lifetimeStart <= slice.lifetimeStart &&
+          other.lifetimeEnd >= slice.lifetimeStart) {
+        liveSize += alignedSizes[j];
+      }
+    }
+    lowerBound = std::max(lowerBound, liveSize);
+  }
+  return IREE::Util::align(lowerBound, rangeAlignment);
+}
+
+// Packs a set of statically-sized slices and emits the chosen offsets.
+//
+// Several placement orderings are tried and the one producing the smallest
+// slab is kept: the original IR order (ascending lifetime; matches the greedy
+// tflite behavior) and best-fit-decreasing on aligned size, which tends to
+// fill the gaps big slices leave behind with the smaller ones placed later.
+//
+// Slice packed offset SSA values will be updated and start at the given
+// |baseOffset|. Returns |baseOffset| + the total size of the allocation
+// aligned to the requirements of |resourceConfig|.
+static Value packStaticSlices(IREE::Stream::ResourcePackOp packOp,
+                              Value baseOffset, MutableArrayRef<Slice> slices,
+                              IREE::Stream::ResourceConfigAttr resourceConfig,
+                              IndexSet &indexSet, OpBuilder &builder,
+                              bool emitRemarks, int64_t &totalSlabSize,
+                              int64_t &totalMinSize) {
+  int64_t offsetAlignment = resourceConfig.getMinBufferOffsetAlignment();
+  int64_t rangeAlignment = resourceConfig.getMinBufferRangeAlignment();
+
+  // Sizes are all static and aligned to the range alignment class once here
+  // so that ordering and placement agree on the space each slice occupies.
+  SmallVector<int64_t> alignedSizes;
+  alignedSizes.reserve(slices.size());
+  for (auto &slice : slices) {
+    int64_t staticSize =
+        cast<arith::ConstantIndexOp>(slice.dynamicSize.getDefiningOp()).value();
+    alignedSizes.push_back(IREE::Util::align(staticSize, rangeAlignment));
+  }
+
+  // Original IR order (ascending lifetime interval).
+  SmallVector<unsigned> lifetimeOrder =
+      llvm::to_vector(llvm::seq<unsigned>(0, slices.size()));
+  auto lifetimeLayout = placeStaticSlices(slices, lifetimeOrder, alignedSizes,
+                                          offsetAlignment, rangeAlignment);
+
+  // Best-fit-decreasing: place the largest slices first so that the smaller
+  // ones fill the lifetime-compatible gaps between them. Ties break by
+  // lifetime and then IR order to keep the layout deterministic.
+  SmallVector<unsigned> decreasingSizeOrder = lifetimeOrder;
+  llvm::stable_sort(decreasingSizeOrder, [&](unsigned lhs, unsigned rhs) {
+    return alignedSizes[lhs] > alignedSizes[rhs];
+  });
+  auto bestFitLayout =
+      placeStaticSlices(slices, decreasingSizeOrder, alignedSizes,
+                        offsetAlignment, rangeAlignment);
+
+  auto &layout = bestFitLayout.slabSize < lifetimeLayout.slabSize
+                     ? bestFitLayout
+                     : lifetimeLayout;
+  int64_t lowerBound =
+      computeStaticLayoutLowerBound(slices, alignedSizes, rangeAlignment);
+  totalSlabSize += layout.slabSize;
+  totalMinSize += lowerBound;
+  if (emitRemarks) {
+    packOp.emitRemark() << "packed " << slices.size() << " slices into "
+                        << layout.slabSize << " B (lower bound " << lowerBound
+                        << " B)";
+  }
+
+  for (auto [slice, offset] : llvm::zip_equal(slices, layout.offsets)) {
+    slice.packedOffset.replaceAllUsesWith(builder.createOrFold<arith::AddIOp>(
+        packOp.getLoc(), baseOffset, indexSet.get(offset)));
+  }
   return builder.createOrFold<arith::AddIOp>(packOp.getLoc(), baseOffset,
-                                             indexSet.get(highwaterMark));
+                                             indexSet.get(layout.slabSize));
 }
 
 // Packs a set of dynamically-sized slices based on the structural information
@@ -220,6 +313,8 @@ packDynamicSlicesConservatively(IREE::Stream::ResourcePackOp packOp,
 
 struct LayoutSlicesPass
     : public IREE::Stream::impl::LayoutSlicesPassBase<LayoutSlicesPass> {
+  using IREE::Stream::impl::LayoutSlicesPassBase<
+      LayoutSlicesPass>::LayoutSlicesPassBase;
   void runOnOperation() override {
     auto parentOp = getOperation();
     if (!parentOp.getCallableRegion() ||
@@ -227,9 +322,11 @@ struct LayoutSlicesPass
       return;
     }
 
-    // NOTE: we could try several algorithms and compute which packs best. For
-    // now we just pack greedily as it's fast and what most existing ML
-    // frameworks do.
+    // Aggregate static packing results across all pack ops in the function so
+    // that statistics reporting can derive slab utilization afterward.
+    int64_t totalSlabSize = 0;
+    int64_t totalMinSize = 0;
+
     parentOp.walk([&](IREE::Stream::ResourcePackOp packOp) {
       // Derive resource constraints based on pack affinity.
       auto resourceConfig = IREE::Stream::ResourceConfigAttr::lookup(packOp);
@@ -257,8 +354,9 @@ struct LayoutSlicesPass
       // compile time.
       auto offset = packOp.getOffset() ? packOp.getOffset() : indexSet.get(0);
       if (!staticSlices.empty()) {
-        offset = packStaticSlicesGreedily(packOp, offset, staticSlices,
-                                          resourceConfig, indexSet, builder);
+        offset = packStaticSlices(packOp, offset, staticSlices, resourceConfig,
+                                  indexSet, builder, emitRemarks, totalSlabSize,
+                                  totalMinSize);
 
         // TODO(benvanik): make this an option; it can be useful for debugging
         // this code.
@@ -280,6 +378,17 @@ struct LayoutSlicesPass
 
       packOp.erase();
     });
+
+    // Record the aggregate static packing results for statistics reporting
+    // (see DumpStatistics.cpp); dynamic slices are excluded as their sizes are
+    // not known here.
+    if (totalSlabSize > 0) {
+      Builder attrBuilder(parentOp.getContext());
+      parentOp->setAttr("stream.packing.slab_size",
+                        attrBuilder.getI64IntegerAttr(totalSlabSize));
+      parentOp->setAttr("stream.packing.min_size",
+                        attrBuilder.getI64IntegerAttr(totalMinSize));
+    }
   }
 };
 
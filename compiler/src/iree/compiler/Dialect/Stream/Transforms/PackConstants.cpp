@@ -456,7 +456,7 @@ static TimepointResource buildTryMapConstantResource(
 
 static Value generateSerializedUpload(
     Value awaitTimepoint, IREE::Stream::AffinityAttr affinityAttr,
-    IREE::Stream::ResourceConfigAttr resourceConfig,
+    IREE::Stream::ResourceConfigAttr resourceConfig, int64_t tryMapMinSize,
     ArrayRef<ConstantSlice> slices, IndexSet &indexSet, OpBuilder &builder) {
   // Perform the packing of dense values to compute the storage resources we
   // will need and where each value will be placed.
@@ -475,7 +475,10 @@ static Value generateSerializedUpload(
   // Emit rodata storage for the constant values.
   // As our upload paths may vary this ensures that we are only emitting
   // them once regardless of how many strategies we emit IR for.
-  Value currentTimepoint = awaitTimepoint;
+  // Storage resources have no dependencies on each other and their uploads are
+  // issued against the incoming timepoint so the runtime can overlap the
+  // mappings/file reads; we join on completion below.
+  SmallVector<Value> uploadTimepoints;
   for (auto &storageResource : storageResources) {
     // Serialized resources are stored as packed host data.
     Value storageBuffer = builder.create<IREE::Util::BufferConstantOp>(
@@ -485,16 +488,20 @@ static Value generateSerializedUpload(
 
     // If this is producing constants (vs variables) we can try to go on a
     // fast-path where we directly map the constant memory. If producing
-    // variables then we always need to stage and clone.
+    // variables then we always need to stage and clone. Small constant
+    // resources below the policy threshold are staged as well: mapping costs
+    // page-granular device memory and runtime bookkeeping that only pays for
+    // itself on larger buffers.
     TimepointResource uploadedResource;
     auto resourceSize = indexSet.get(storageResource.totalSize);
-    if (resourceType.getLifetime() == IREE::Stream::Lifetime::Constant) {
+    if (resourceType.getLifetime() == IREE::Stream::Lifetime::Constant &&
+        storageResource.totalSize >= (uint64_t)tryMapMinSize) {
       uploadedResource = buildTryMapConstantResource(
-          storageResource.loc, currentTimepoint, affinityAttr, resourceType,
+          storageResource.loc, awaitTimepoint, affinityAttr, resourceType,
           resourceSize, storageBuffer, resourceSize, indexSet, builder);
     } else {
       uploadedResource = buildFileRead(
-          storageResource.loc, currentTimepoint, affinityAttr, resourceType,
+          storageResource.loc, awaitTimepoint, affinityAttr, resourceType,
           resourceSize, storageBuffer, resourceSize, indexSet, builder);
     }
 
@@ -506,11 +513,11 @@ static Value generateSerializedUpload(
       span.slice.result.replaceAllUsesWith(subviewOp.getResult());
     }
 
-    currentTimepoint = uploadedResource.timepoint;
+    uploadTimepoints.push_back(uploadedResource.timepoint);
   }
 
   // Join on storage timepoints for our transitive dependencies to await.
-  return currentTimepoint;
+  return IREE::Stream::TimepointJoinOp::join(uploadTimepoints, builder);
 }
 
 static Value generateParameterUpload(
@@ -594,7 +601,8 @@ static Value generateParameterUpload(
 static Value generateUploads(Value awaitTimepoint,
                              IREE::Stream::ResourceConstantsOp constantsOp,
                              IREE::Stream::ResourceConfigAttr resourceConfig,
-                             IndexSet &indexSet, OpBuilder &builder) {
+                             int64_t tryMapMinSize, IndexSet &indexSet,
+                             OpBuilder &builder) {
   // Split the slices based on whether they are sourced from serialized data or
   // externally-defined parameters.
   // TODO(benvanik): remove stream.resource.constants and this coupling;
@@ -622,7 +630,7 @@ static Value generateUploads(Value awaitTimepoint,
   if (!serializedSlices.empty()) {
     uploadTimepoints.push_back(generateSerializedUpload(
         awaitTimepoint, constantsOp.getAffinityAttr(), resourceConfig,
-        serializedSlices, indexSet, builder));
+        tryMapMinSize, serializedSlices, indexSet, builder));
   }
   if (!parameterSlices.empty()) {
     uploadTimepoints.push_back(generateParameterUpload(
@@ -670,8 +678,9 @@ struct PackConstantsPass
       // Perform upload/processing for immutable and mutable constants.
       Value awaitTimepoint = builder.create<IREE::Stream::TimepointImmediateOp>(
           constantsOp.getLoc());
-      auto uploadTimepoint = generateUploads(awaitTimepoint, constantsOp,
-                                             resourceConfig, indexSet, builder);
+      auto uploadTimepoint =
+          generateUploads(awaitTimepoint, constantsOp, resourceConfig,
+                          tryMapMinSize, indexSet, builder);
       constantsOp.getResultTimepoint().replaceAllUsesWith(uploadTimepoint);
 
       constantsOp.erase();
@@ -95,6 +95,16 @@ void buildStreamTensorPassPipeline(OpPassManager &passManager,
   // TODO(benvanik): compute affinities for executables.
   // TODO(benvanik): annotate all dispatches with preferred executable affinity.
   // TODO(benvanik): DFA to specify all value affinities and pin dispatches.
+
+  // Balance unpinned streamable work across execution queues when requested.
+  // Explicit affinities always win; this only fills in the gaps.
+  if (transformOptions.partitionQueueCount > 1) {
+    AssignQueueAffinitiesPassOptions assignQueueOptions;
+    assignQueueOptions.queueCount = transformOptions.partitionQueueCount;
+    FunctionLikeNest(passManager).addPass([&]() {
+      return IREE::Stream::createAssignQueueAffinitiesPass(assignQueueOptions);
+    });
+  }
 }
 
 //===----------------------------------------------------------------------===//
@@ -107,6 +117,17 @@ void buildStreamAsyncPassPipeline(OpPassManager &passManager,
   // Tensor lowering and resource management
   //----------------------------------------------------------------------------
 
+  // Emit batch-N entry points wrapping the batch-1 entry points when a serving
+  // layer wants to submit multiple requests with a single invocation. This
+  // runs before scheduling so that the per-request calls can be inlined and
+  // partitioned into concurrent streams like any other work.
+  if (transformOptions.entryPointBatchSize > 1) {
+    EmitBatchedEntryPointsPassOptions batchedEntryPointOptions;
+    batchedEntryPointOptions.batchSize = transformOptions.entryPointBatchSize;
+    passManager.addPass(IREE::Stream::createEmitBatchedEntryPointsPass(
+        batchedEntryPointOptions));
+  }
+
   // Lower stream.tensor.* ops to stream.async.* ops based on
   // affinity/configuration assigned during placement.
   FunctionLikeNest(passManager)
@@ -134,6 +155,12 @@ void buildStreamAsyncPassPipeline(OpPassManager &passManager,
       .addPass(mlir::createCanonicalizerPass)
       .addPass(IREE::Stream::createEmplaceAllocationsPass);
 
+  // Hoist loop-invariant broadcasts out of loops while collectives are still
+  // standalone ops; once execution regions form they are fused with
+  // surrounding work and no longer movable.
+  FunctionLikeNest(passManager)
+      .addPass(IREE::Stream::createHoistInvariantCollectivesPass);
+
   // Refine lifetime of all resources across the module.
   // We do this after scheduling execution so that we know how the resources
   // move across devices. We do it before scheduling waves as lifetime doesn't
@@ -159,7 +186,9 @@ void buildStreamAsyncPassPipeline(OpPassManager &passManager,
       // Combine async work into execution regions.
       .addPass(IREE::Stream::createScheduleExecutionPass)
       // Group concurrently executable work into waves.
-      .addPass(IREE::Stream::createScheduleConcurrencyPass);
+      .addPass(IREE::Stream::createScheduleConcurrencyPass)
+      // Overlap transfer and compute stages across loop iterations.
+      .addPass(IREE::Stream::createPipelineLoopsPass);
 
   // Materialize timepoints across the entire module. This simplifies scheduling
   // of the timeline as we can shake the IR and see what timepoints we still
@@ -199,7 +228,11 @@ void buildStreamCmdPassPipeline(OpPassManager &passManager,
       // Layout packed slices to emit the arithmetic required for all resource
       // offsets. This enables us to propagate the subviews across the program
       // below.
-      .addPass(IREE::Stream::createLayoutSlicesPass);
+      .addPass(IREE::Stream::createLayoutSlicesPass)
+
+      // Issue parameter file I/O ahead of the work that consumes it so that
+      // reads overlap with compute instead of stalling at first use.
+      .addPass(IREE::Stream::createPrefetchParametersPass);
 
   // Propagate subviews throughout the program to unify resource storage access.
   // After propagation many resource SSA values can be deduped or folded by the
@@ -331,6 +364,17 @@ void buildStreamTransformPassPipeline(
 
   buildStreamOptimizationPassPipeline(passManager, transformOptions);
 
+  // Export the final timepoint dependency graph once timepoint propagation
+  // and elision have settled so the scheduling intent can be audited against
+  // observed runtime wait behavior.
+  if (!transformOptions.dumpTimepointGraphFile.empty()) {
+    DumpTimepointGraphPassOptions dumpTimepointGraphOptions;
+    dumpTimepointGraphOptions.outputFile =
+        transformOptions.dumpTimepointGraphFile;
+    passManager.addPass(IREE::Stream::createDumpTimepointGraphPass(
+        dumpTimepointGraphOptions));
+  }
+
   //----------------------------------------------------------------------------
   // Post-pipeline cleanup
   //----------------------------------------------------------------------------
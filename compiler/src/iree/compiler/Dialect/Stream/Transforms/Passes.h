@@ -18,6 +18,10 @@ namespace mlir::func {
 class FuncDialect;
 } // namespace mlir::func
 
+namespace mlir::iree_compiler::IREE::HAL {
+class HALDialect;
+} // namespace mlir::iree_compiler::IREE::HAL
+
 namespace mlir::iree_compiler::IREE::Stream {
 
 //===----------------------------------------------------------------------===//
@@ -50,6 +54,22 @@ struct TransformOptions : public PassPipelineOptions<TransformOptions> {
       llvm::cl::init(true),
   };
 
+  Option<int64_t> partitionQueueCount{
+      *this,
+      "partition-queue-count",
+      llvm::cl::desc("Automatically balances unpinned streamable work across "
+                     "this many execution queues (<=1 disables assignment)."),
+      llvm::cl::init(0),
+  };
+
+  Option<int64_t> entryPointBatchSize{
+      *this,
+      "entry-point-batch-size",
+      llvm::cl::desc("Emits batch-N entry points evaluating N independent "
+                     "requests per invocation (<=1 disables emission)."),
+      llvm::cl::init(0),
+  };
+
   Option<DumpOutputFormat> dumpStatisticsFormat{
       *this,
       "dump-statistics-format",
@@ -70,6 +90,16 @@ struct TransformOptions : public PassPipelineOptions<TransformOptions> {
           "File path to write to; or `` for stderr or `-` for stdout."),
       llvm::cl::init(""),
   };
+
+  Option<std::string> dumpTimepointGraphFile{
+      *this,
+      "dump-timepoint-graph-file",
+      llvm::cl::desc(
+          "Dumps the final post-optimization timepoint dependency graph in "
+          "Graphviz DOT format to the given file path (`-` for stdout; empty "
+          "disables the dump)."),
+      llvm::cl::init(""),
+  };
 };
 
 // Adds a set of passes to the given pass manager that run the required flow
@@ -0,0 +1,256 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/compiler/Dialect/Stream/IR/StreamDialect.h"
+#include "iree/compiler/Dialect/Stream/IR/StreamOps.h"
+#include "iree/compiler/Dialect/Stream/Transforms/Passes.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/Debug.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/IRMapping.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+#include "mlir/Pass/Pass.h"
+
+#define DEBUG_TYPE "iree-stream-pipeline-loops"
+
+namespace mlir::iree_compiler::IREE::Stream {
+
+#define GEN_PASS_DEF_PIPELINELOOPSPASS
+#include "iree/compiler/Dialect/Stream/Transforms/Passes.h.inc"
+
+namespace {
+
+//===----------------------------------------------------------------------===//
+// Loop pipelining
+//===----------------------------------------------------------------------===//
+
+// A loop body matching the two-stage transfer/compute shape we can rotate.
+struct PipelineCandidate {
+  // Transfer stage: independent of loop-carried state; only reads values
+  // defined outside the loop or derived from the induction variable.
+  IREE::Stream::AsyncExecuteOp transferOp;
+  // Compute stage: consumes the transfer results (and any loop-carried state).
+  IREE::Stream::AsyncExecuteOp computeOp;
+  // Pure index/attribute ops in the body that (transitively) feed the transfer
+  // stage, in block order. Cloned per-stage with the stage's induction value.
+  SmallVector<Operation *> transferSliceOps;
+  // Static trip info; we only rotate loops with known non-zero trip counts so
+  // the prologue transfer is never speculative.
+  int64_t lowerBound = 0;
+  int64_t step = 0;
+  int64_t lastInductionValue = 0;
+};
+
+// Matches |forOp| against the transfer/compute shape. Returns failure (without
+// diagnostics - this is an optimization) when the loop cannot be rotated.
+static FailureOr<PipelineCandidate> matchPipelineCandidate(scf::ForOp forOp) {
+  PipelineCandidate candidate;
+
+  // Only loops with static bounds and at least two iterations are worth
+  // rotating; the prologue would otherwise speculatively execute the transfer
+  // for an iteration that may never run.
+  APInt lowerBoundValue, upperBoundValue, stepValue;
+  if (!matchPattern(forOp.getLowerBound(), m_ConstantInt(&lowerBoundValue)) ||
+      !matchPattern(forOp.getUpperBound(), m_ConstantInt(&upperBoundValue)) ||
+      !matchPattern(forOp.getStep(), m_ConstantInt(&stepValue))) {
+    return failure();
+  }
+  int64_t lowerBound = lowerBoundValue.getSExtValue();
+  int64_t upperBound = upperBoundValue.getSExtValue();
+  int64_t step = stepValue.getSExtValue();
+  if (step <= 0 || upperBound <= lowerBound)
+    return failure();
+  int64_t tripCount = (upperBound - lowerBound + step - 1) / step;
+  if (tripCount < 2)
+    return failure();
+  candidate.lowerBound = lowerBound;
+  candidate.step = step;
+  candidate.lastInductionValue = lowerBound + (tripCount - 1) * step;
+
+  // Exactly two execute ops in block order: transfer then compute. All other
+  // ops must be pure index math (cloneable per stage) or timepoint awaits on
+  // the compute side.
+  Block *body = forOp.getBody();
+  SmallVector<IREE::Stream::AsyncExecuteOp> executeOps;
+  for (auto &op : body->without_terminator()) {
+    if (auto executeOp = dyn_cast<IREE::Stream::AsyncExecuteOp>(op)) {
+      executeOps.push_back(executeOp);
+    } else if (!isPure(&op) && !isa<IREE::Stream::TimepointAwaitOp>(op)) {
+      return failure();
+    }
+  }
+  if (executeOps.size() != 2)
+    return failure();
+  candidate.transferOp = executeOps[0];
+  candidate.computeOp = executeOps[1];
+
+  // Walk the transfer operands back through the body: everything must resolve
+  // to the induction variable, values defined outside of the loop, or pure ops
+  // within the body (which become the per-stage slice). Loop-carried values
+  // or compute results would create a cross-iteration dependency that
+  // prohibits overlapping.
+  SetVector<Operation *> sliceSet;
+  SmallVector<Value> worklist(candidate.transferOp->getOperands());
+  while (!worklist.empty()) {
+    Value value = worklist.pop_back_val();
+    if (auto blockArg = dyn_cast<BlockArgument>(value)) {
+      if (blockArg.getOwner() != body)
+        continue; // defined above the loop
+      if (blockArg == forOp.getInductionVar())
+        continue; // remapped per stage
+      return failure(); // loop-carried state
+    }
+    auto *definingOp = value.getDefiningOp();
+    if (definingOp->getBlock() != body)
+      continue; // defined above the loop
+    if (!isPure(definingOp))
+      return failure(); // compute result or await
+    if (sliceSet.insert(definingOp)) {
+      llvm::append_range(worklist, definingOp->getOperands());
+    }
+  }
+  candidate.transferSliceOps = sliceSet.takeVector();
+  llvm::sort(candidate.transferSliceOps,
+             [](Operation *lhs, Operation *rhs) {
+               return lhs->isBeforeInBlock(rhs);
+             });
+
+  // All transfer results (resources + timepoint) must feed only the compute
+  // stage: anything else (yields, awaits) would observe the rotated values.
+  for (auto result : candidate.transferOp->getResults()) {
+    for (auto *user : result.getUsers()) {
+      if (user != candidate.computeOp)
+        return failure();
+    }
+  }
+
+  return candidate;
+}
+
+// Rotates the transfer stage of |candidate| one iteration ahead of compute:
+//   for i: T(i); C(i, T(i))
+// becomes
+//   T(lb); for i carrying t = T(i): C(i, t); T(min(i+step, last))
+// Each in-flight transfer writes freshly-defined transient results so the two
+// buffers double-buffer naturally through SSA; the timepoint chains let the
+// runtime overlap iteration i's compute with iteration i+1's transfer. The
+// final iteration re-issues the last transfer with unused results; later
+// timepoint elision may drop it.
+static void pipelineForOp(scf::ForOp forOp, PipelineCandidate &candidate) {
+  auto loc = forOp.getLoc();
+  OpBuilder builder(forOp);
+
+  // Prologue: issue the first iteration's transfer ahead of the loop.
+  IRMapping prologueMap;
+  prologueMap.map(
+      forOp.getInductionVar(),
+      builder.create<arith::ConstantIndexOp>(loc, candidate.lowerBound));
+  for (auto *sliceOp : candidate.transferSliceOps) {
+    builder.clone(*sliceOp, prologueMap);
+  }
+  auto *prologueTransferOp = builder.clone(*candidate.transferOp, prologueMap);
+
+  // New loop carrying the original iter args plus the in-flight transfer
+  // results and timepoint.
+  SmallVector<Value> newInits(forOp.getInitArgs());
+  llvm::append_range(newInits, prologueTransferOp->getResults());
+  auto newForOp =
+      builder.create<scf::ForOp>(loc, forOp.getLowerBound(),
+                                 forOp.getUpperBound(), forOp.getStep(),
+                                 newInits);
+  size_t carriedCount = candidate.transferOp->getNumResults();
+
+  OpBuilder bodyBuilder = OpBuilder::atBlockBegin(newForOp.getBody());
+  IRMapping bodyMap;
+  bodyMap.map(forOp.getInductionVar(), newForOp.getInductionVar());
+  for (auto [oldArg, newArg] :
+       llvm::zip(forOp.getRegionIterArgs(),
+                 newForOp.getRegionIterArgs().take_front(
+                     forOp.getRegionIterArgs().size()))) {
+    bodyMap.map(oldArg, newArg);
+  }
+  for (auto [transferResult, carriedArg] :
+       llvm::zip(candidate.transferOp->getResults(),
+                 newForOp.getRegionIterArgs().take_back(carriedCount))) {
+    bodyMap.map(transferResult, carriedArg);
+  }
+
+  // Clone the compute side at the current induction value with the transfer
+  // results redirected to the carried values. Pure ops that only fed the
+  // transfer become dead and are cleaned up later.
+  for (auto &op : forOp.getBody()->without_terminator()) {
+    if (&op == candidate.transferOp.getOperation())
+      continue;
+    bodyBuilder.clone(op, bodyMap);
+  }
+
+  // Issue the next iteration's transfer. The final iteration clamps to its own
+  // induction value as there is no next iteration to fetch for.
+  Value nextInductionValue = bodyBuilder.create<arith::MinSIOp>(
+      loc,
+      bodyBuilder.create<arith::AddIOp>(loc, newForOp.getInductionVar(),
+                                        newForOp.getStep()),
+      bodyBuilder.create<arith::ConstantIndexOp>(
+          loc, candidate.lastInductionValue));
+  IRMapping nextMap;
+  nextMap.map(forOp.getInductionVar(), nextInductionValue);
+  for (auto *sliceOp : candidate.transferSliceOps) {
+    bodyBuilder.clone(*sliceOp, nextMap);
+  }
+  auto *nextTransferOp = bodyBuilder.clone(*candidate.transferOp, nextMap);
+
+  auto oldYieldOp = cast<scf::YieldOp>(forOp.getBody()->getTerminator());
+  SmallVector<Value> yieldOperands;
+  for (auto operand : oldYieldOp.getOperands()) {
+    yieldOperands.push_back(bodyMap.lookupOrDefault(operand));
+  }
+  llvm::append_range(yieldOperands, nextTransferOp->getResults());
+  bodyBuilder.create<scf::YieldOp>(loc, yieldOperands);
+
+  // The extra carried results (the final in-flight transfer) are unused.
+  for (auto [oldResult, newResult] :
+       llvm::zip(forOp.getResults(),
+                 newForOp.getResults().take_front(forOp.getNumResults()))) {
+    oldResult.replaceAllUsesWith(newResult);
+  }
+  forOp.erase();
+}
+
+//===----------------------------------------------------------------------===//
+// --iree-stream-pipeline-loops
+//===----------------------------------------------------------------------===//
+
+struct PipelineLoopsPass
+    : public IREE::Stream::impl::PipelineLoopsPassBase<PipelineLoopsPass> {
+  void runOnOperation() override {
+    auto parentOp = getOperation();
+    if (!parentOp.getCallableRegion() ||
+        parentOp.getCallableRegion()->empty()) {
+      return;
+    }
+
+    // Gather candidates before mutating as rotation replaces the loops.
+    SmallVector<std::pair<scf::ForOp, PipelineCandidate>> candidates;
+    parentOp.walk([&](scf::ForOp forOp) {
+      auto candidate = matchPipelineCandidate(forOp);
+      if (succeeded(candidate)) {
+        candidates.push_back({forOp, std::move(*candidate)});
+      }
+    });
+    for (auto &[forOp, candidate] : candidates) {
+      pipelineForOp(forOp, candidate);
+    }
+  }
+};
+
+} // namespace
+
+} // namespace mlir::iree_compiler::IREE::Stream
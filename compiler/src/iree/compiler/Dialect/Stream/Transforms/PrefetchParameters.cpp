@@ -0,0 +1,145 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/compiler/Dialect/Stream/IR/StreamDialect.h"
+#include "iree/compiler/Dialect/Stream/IR/StreamOps.h"
+#include "iree/compiler/Dialect/Stream/Transforms/Passes.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/Debug.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+#include "mlir/Pass/Pass.h"
+
+#define DEBUG_TYPE "iree-stream-prefetch-parameters"
+
+namespace mlir::iree_compiler::IREE::Stream {
+
+#define GEN_PASS_DEF_PREFETCHPARAMETERSPASS
+#include "iree/compiler/Dialect/Stream/Transforms/Passes.h.inc"
+
+namespace {
+
+// Returns true for parameter I/O reads worth issuing as early as possible.
+static bool isPrefetchableOp(Operation *op) {
+  return isa<IREE::Stream::ParameterLoadOp, IREE::Stream::ParameterReadOp,
+             IREE::Stream::ParameterGatherOp>(op);
+}
+
+// Returns true if a prefetchable op must not be hoisted above |op|.
+// Stream dialect ops order themselves on the timeline via SSA resources and
+// timepoints so crossing them is safe - with the exception of parameter
+// writes which may alias the keys being read through the external provider.
+// Anything outside the dialect is only crossed when known pure (calls, global
+// stores, and the like may observe or alter parameter storage).
+static bool isPrefetchBarrier(Operation *op) {
+  if (isa<IREE::Stream::ParameterWriteOp, IREE::Stream::ParameterScatterOp>(
+          op)) {
+    return true;
+  }
+  if (op->getDialect()->getNamespace() ==
+      IREE::Stream::StreamDialect::getDialectNamespace()) {
+    return false;
+  }
+  return !isPure(op);
+}
+
+// Estimates the staging bytes held live by issuing |op| early: the sum of its
+// statically-known resource sizes. Dynamically-sized reads are rare for
+// parameters (weights are static) and estimated conservatively large so they
+// consume budget quickly rather than silently exceeding it.
+static int64_t estimateStagingBytes(Operation *op) {
+  static constexpr int64_t kDynamicSizeEstimate = 16 * 1024 * 1024;
+  int64_t totalBytes = 0;
+  auto sizeAwareOp = dyn_cast<IREE::Util::SizeAwareOpInterface>(op);
+  if (!sizeAwareOp)
+    return kDynamicSizeEstimate;
+  auto accumulate = [&](Value size) {
+    if (!size)
+      return;
+    APInt staticSize;
+    if (matchPattern(size, m_ConstantInt(&staticSize))) {
+      totalBytes += staticSize.getSExtValue();
+    } else {
+      totalBytes += kDynamicSizeEstimate;
+    }
+  };
+  for (unsigned i = 0; i < op->getNumOperands(); ++i) {
+    if (isa<IREE::Stream::ResourceType>(op->getOperand(i).getType())) {
+      accumulate(sizeAwareOp.getOperandSize(i));
+    }
+  }
+  for (unsigned i = 0; i < op->getNumResults(); ++i) {
+    if (isa<IREE::Stream::ResourceType>(op->getResult(i).getType())) {
+      accumulate(sizeAwareOp.getResultSize(i));
+    }
+  }
+  return totalBytes;
+}
+
+// Hoists each prefetchable op in |block| to the earliest position its
+// operands and barriers allow, bounded by |stagingBudget| total bytes of
+// early reads per block. Ops are visited in block order so relative issue
+// order of the reads themselves is preserved.
+static void prefetchBlockParameters(Block &block, int64_t stagingBudget) {
+  SmallVector<Operation *> prefetchableOps;
+  for (auto &op : block) {
+    if (isPrefetchableOp(&op))
+      prefetchableOps.push_back(&op);
+  }
+  int64_t remainingBudget = stagingBudget;
+  for (auto *op : prefetchableOps) {
+    int64_t stagingBytes = estimateStagingBytes(op);
+    if (stagingBytes > remainingBudget)
+      continue; // over budget; leave at first use
+    // Walk backward to the latest op (in current IR order) that either
+    // defines one of our operands or acts as a barrier.
+    Operation *insertAfterOp = nullptr;
+    for (auto *prevOp = op->getPrevNode(); prevOp;
+         prevOp = prevOp->getPrevNode()) {
+      if (isPrefetchBarrier(prevOp) ||
+          llvm::any_of(op->getOperands(), [&](Value operand) {
+            return operand.getDefiningOp() == prevOp;
+          })) {
+        insertAfterOp = prevOp;
+        break;
+      }
+    }
+    if (insertAfterOp) {
+      if (op->getPrevNode() != insertAfterOp) {
+        op->moveAfter(insertAfterOp);
+        remainingBudget -= stagingBytes;
+      }
+    } else if (op != &block.front()) {
+      op->moveBefore(&block.front());
+      remainingBudget -= stagingBytes;
+    }
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// --iree-stream-prefetch-parameters
+//===----------------------------------------------------------------------===//
+
+struct PrefetchParametersPass
+    : public IREE::Stream::impl::PrefetchParametersPassBase<
+          PrefetchParametersPass> {
+  using IREE::Stream::impl::PrefetchParametersPassBase<
+      PrefetchParametersPass>::PrefetchParametersPassBase;
+  void runOnOperation() override {
+    auto parentOp = getOperation();
+    if (!parentOp.getCallableRegion() ||
+        parentOp.getCallableRegion()->empty()) {
+      return;
+    }
+    parentOp.walk([&](Block *block) {
+      prefetchBlockParameters(*block, maxStagingBytes);
+    });
+  }
+};
+
+} // namespace
+
+} // namespace mlir::iree_compiler::IREE::Stream
@@ -0,0 +1,40 @@
+// RUN: iree-opt --split-input-file --pass-pipeline="builtin.module(iree-stream-annotate-small-transients{max-size=65536})" %s | FileCheck %s
+
+// Tests that a small transient produced by one dispatch and consumed by
+// exactly one other dispatch flags the producer.
+
+// CHECK-LABEL: @smallHandoff
+util.func public @smallHandoff(%arg0: !stream.resource<external>) -> !stream.resource<external> {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c80 = arith.constant 80 : index
+  // CHECK: stream.async.dispatch @ex::@dispatch_0
+  // CHECK-SAME: stream.promotable = [0]
+  %0 = stream.async.dispatch @ex::@dispatch_0[%c1, %c1, %c1](%arg0[%c0 to %c80 for %c80]) : (!stream.resource<external>{%c80}) -> !stream.resource<transient>{%c80}
+  // CHECK: stream.async.dispatch @ex::@dispatch_1
+  // CHECK-NOT: stream.promotable
+  %1 = stream.async.dispatch @ex::@dispatch_1[%c1, %c1, %c1](%0[%c0 to %c80 for %c80]) : (!stream.resource<transient>{%c80}) -> !stream.resource<external>{%c80}
+  util.return %1 : !stream.resource<external>
+}
+
+// -----
+
+// Tests that transients above the threshold or with multiple consuming
+// dispatches are not flagged.
+
+// CHECK-LABEL: @unpromotableTransients
+util.func public @unpromotableTransients(%arg0: !stream.resource<external>) -> (!stream.resource<external>, !stream.resource<external>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c80 = arith.constant 80 : index
+  %c1048576 = arith.constant 1048576 : index
+  // CHECK: stream.async.dispatch @ex::@dispatch_0
+  // CHECK-NOT: stream.promotable
+  %0 = stream.async.dispatch @ex::@dispatch_0[%c1, %c1, %c1](%arg0[%c0 to %c80 for %c80]) : (!stream.resource<external>{%c80}) -> !stream.resource<transient>{%c1048576}
+  // CHECK: stream.async.dispatch @ex::@dispatch_1
+  // CHECK-NOT: stream.promotable
+  %1 = stream.async.dispatch @ex::@dispatch_1[%c1, %c1, %c1](%arg0[%c0 to %c80 for %c80]) : (!stream.resource<external>{%c80}) -> !stream.resource<transient>{%c80}
+  %2 = stream.async.dispatch @ex::@dispatch_2[%c1, %c1, %c1](%0[%c0 to %c1048576 for %c1048576], %1[%c0 to %c80 for %c80]) : (!stream.resource<transient>{%c1048576}, !stream.resource<transient>{%c80}) -> !stream.resource<external>{%c80}
+  %3 = stream.async.dispatch @ex::@dispatch_3[%c1, %c1, %c1](%1[%c0 to %c80 for %c80]) : (!stream.resource<transient>{%c80}) -> !stream.resource<external>{%c80}
+  util.return %2, %3 : !stream.resource<external>, !stream.resource<external>
+}
@@ -0,0 +1,39 @@
+// RUN: iree-opt --split-input-file --pass-pipeline="builtin.module( util.func(iree-stream-assign-queue-affinities{queue-count=2}))" %s | FileCheck %s
+
+// Tests that unpinned dispatches are split into contiguous balanced stages
+// with one queue per stage.
+
+// CHECK-LABEL: @balanceAcrossQueues
+util.func public @balanceAcrossQueues(%input: !stream.resource<*>, %size: index) -> !stream.resource<*> {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c128 = arith.constant 128 : index
+  // CHECK: stream.async.dispatch on(#hal.affinity.queue<[0]>) @ex::@dispatch0
+  %0 = stream.async.dispatch @ex::@dispatch0[%c1, %c1, %c1](%input[%c0 to %c128 for %c128]) : (!stream.resource<*>{%c128}) -> !stream.resource<*>{%c128}
+  // CHECK: stream.async.dispatch on(#hal.affinity.queue<[0]>) @ex::@dispatch1
+  %1 = stream.async.dispatch @ex::@dispatch1[%c1, %c1, %c1](%0[%c0 to %c128 for %c128]) : (!stream.resource<*>{%c128}) -> !stream.resource<*>{%c128}
+  // CHECK: stream.async.dispatch on(#hal.affinity.queue<[1]>) @ex::@dispatch2
+  %2 = stream.async.dispatch @ex::@dispatch2[%c1, %c1, %c1](%1[%c0 to %c128 for %c128]) : (!stream.resource<*>{%c128}) -> !stream.resource<*>{%c128}
+  // CHECK: stream.async.dispatch on(#hal.affinity.queue<[1]>) @ex::@dispatch3
+  %3 = stream.async.dispatch @ex::@dispatch3[%c1, %c1, %c1](%2[%c0 to %c128 for %c128]) : (!stream.resource<*>{%c128}) -> !stream.resource<*>{%c128}
+  util.return %3 : !stream.resource<*>
+}
+
+// -----
+
+// Tests that explicitly pinned ops keep their affinity and do not participate
+// in balancing.
+
+// CHECK-LABEL: @respectExplicitAffinity
+util.func public @respectExplicitAffinity(%input: !stream.resource<*>) -> !stream.resource<*> {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c128 = arith.constant 128 : index
+  // CHECK: stream.async.dispatch on(#hal.affinity.queue<[7]>) @ex::@dispatch0
+  %0 = stream.async.dispatch on(#hal.affinity.queue<[7]>) @ex::@dispatch0[%c1, %c1, %c1](%input[%c0 to %c128 for %c128]) : (!stream.resource<*>{%c128}) -> !stream.resource<*>{%c128}
+  // CHECK: stream.async.dispatch on(#hal.affinity.queue<[0]>) @ex::@dispatch1
+  %1 = stream.async.dispatch @ex::@dispatch1[%c1, %c1, %c1](%0[%c0 to %c128 for %c128]) : (!stream.resource<*>{%c128}) -> !stream.resource<*>{%c128}
+  // CHECK: stream.async.dispatch on(#hal.affinity.queue<[1]>) @ex::@dispatch2
+  %2 = stream.async.dispatch @ex::@dispatch2[%c1, %c1, %c1](%1[%c0 to %c128 for %c128]) : (!stream.resource<*>{%c128}) -> !stream.resource<*>{%c128}
+  util.return %2 : !stream.resource<*>
+}
@@ -0,0 +1,34 @@
+// RUN: iree-opt --pass-pipeline="builtin.module(iree-stream-dump-timepoint-graph)" %s 2>&1 | FileCheck %s
+
+// Tests that independent execution regions feeding a join produce a fork-join
+// graph with no edge between the concurrent branches.
+
+// CHECK: digraph "fork_join" {
+// CHECK-DAG: n0 [label="stream.cmd.execute{{.*}}"];
+// CHECK-DAG: n1 [label="stream.cmd.execute{{.*}}"];
+// CHECK-DAG: n2 [label="stream.timepoint.join{{.*}}"];
+// CHECK-DAG: n0 -> n2;
+// CHECK-DAG: n1 -> n2;
+// CHECK: }
+util.func public @fork_join() -> !stream.timepoint {
+  %exec0 = stream.cmd.execute with() {} => !stream.timepoint
+  %exec1 = stream.cmd.execute with() {} => !stream.timepoint
+  %join = stream.timepoint.join max(%exec0, %exec1) => !stream.timepoint
+  util.return %join : !stream.timepoint
+}
+
+// Tests that timepoints entering the function get a synthesized source node
+// and that host awaits are highlighted as observable synchronization points.
+
+// CHECK: digraph "chain" {
+// CHECK-DAG: n0 [label="stream.cmd.execute{{.*}}"];
+// CHECK-DAG: n1 [label="stream.timepoint.await{{.*}}", style=filled, fillcolor=lightyellow];
+// CHECK-DAG: [label="external timepoint", shape=ellipse];
+// CHECK-DAG: n2 -> n0;
+// CHECK-DAG: n0 -> n1;
+// CHECK: }
+util.func public @chain(%arg0: !stream.timepoint, %arg1: !stream.resource<external>, %arg2: index) -> !stream.resource<external> {
+  %exec = stream.cmd.execute await(%arg0) => with() {} => !stream.timepoint
+  %ready = stream.timepoint.await %exec => %arg1 : !stream.resource<external>{%arg2}
+  util.return %ready : !stream.resource<external>
+}
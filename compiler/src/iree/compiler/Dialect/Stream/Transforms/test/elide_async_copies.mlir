@@ -123,6 +123,67 @@ util.func private @blockArgMove(%cond: i1, %size: index) -> (!stream.resource<*>
 
 // -----
 
+// Tests that a transfer returning a resource to the affinity/type it came from
+// is elided even when the staged value flows through block arguments (which
+// the transfer folders cannot see through). The device->host transfer is
+// preserved for the host-side load.
+
+// CHECK-LABEL: @transferRoundTrip
+// CHECK-SAME: (%[[INPUT:.+]]: !stream.resource<*>, %[[SIZE:.+]]: index)
+util.func public @transferRoundTrip(%input: !stream.resource<*>, %size: index) -> (!stream.resource<*>, f32) {
+  %c0 = arith.constant 0 : index
+  // CHECK: %[[STAGING:.+]] = stream.async.transfer %[[INPUT]]
+  %staging = stream.async.transfer %input : !stream.resource<*>{%size} -> !stream.resource<staging>{%size}
+  // CHECK: cf.br ^bb1(%[[STAGING]]
+  cf.br ^bb1(%staging : !stream.resource<staging>)
+// CHECK: ^bb1(%[[BB1_STAGING:.+]]: !stream.resource<staging>)
+^bb1(%bb1_staging: !stream.resource<staging>):
+  // CHECK: %[[HOST_VALUE:.+]] = stream.async.load %[[BB1_STAGING]]
+  %host_value = stream.async.load %bb1_staging[%c0] : !stream.resource<staging>{%size} -> f32
+  // CHECK-NOT: stream.async.transfer
+  %roundtrip = stream.async.transfer %bb1_staging : !stream.resource<staging>{%size} -> !stream.resource<*>{%size}
+  // CHECK: util.return %[[INPUT]], %[[HOST_VALUE]]
+  util.return %roundtrip, %host_value : !stream.resource<*>, f32
+}
+
+// -----
+
+// Tests that a transfer that does not return to the affinity it originated
+// from is preserved: the resource genuinely needs to move.
+
+// CHECK-LABEL: @transferRoundTripAffinityMismatch
+util.func public @transferRoundTripAffinityMismatch(%input: !stream.resource<*>, %size: index) -> !stream.resource<*> {
+  // CHECK: stream.async.transfer
+  %staging = stream.async.transfer %input : !stream.resource<*>{%size} from(#hal.affinity.queue<[0]>) -> !stream.resource<staging>{%size}
+  cf.br ^bb1(%staging : !stream.resource<staging>)
+^bb1(%bb1_staging: !stream.resource<staging>):
+  // CHECK: stream.async.transfer
+  %result = stream.async.transfer %bb1_staging : !stream.resource<staging>{%size} -> to(#hal.affinity.queue<[1]>) !stream.resource<*>{%size}
+  util.return %result : !stream.resource<*>
+}
+
+// -----
+
+// Tests that a round trip whose origin may be mutated in-place keeps its
+// copies: the staged snapshot and the origin storage can diverge.
+
+// CHECK-LABEL: @transferRoundTripMutatedOrigin
+util.func public @transferRoundTripMutatedOrigin(%input: !stream.resource<*>, %size: index) -> (!stream.resource<*>, !stream.resource<*>) {
+  %c0 = arith.constant 0 : index
+  %c128 = arith.constant 128 : index
+  %c123_i32 = arith.constant 123 : i32
+  // CHECK: stream.async.transfer
+  %staging = stream.async.transfer %input : !stream.resource<*>{%size} -> !stream.resource<staging>{%size}
+  %fill = stream.async.fill %c123_i32, %input[%c0 to %c128 for %c128] : i32 -> %input as !stream.resource<*>{%size}
+  cf.br ^bb1(%staging : !stream.resource<staging>)
+^bb1(%bb1_staging: !stream.resource<staging>):
+  // CHECK: stream.async.transfer
+  %roundtrip = stream.async.transfer %bb1_staging : !stream.resource<staging>{%size} -> !stream.resource<*>{%size}
+  util.return %roundtrip, %fill : !stream.resource<*>, !stream.resource<*>
+}
+
+// -----
+
 // Tests that slices aren't elided when there are ops our folding doesn't (yet)
 // support.
 
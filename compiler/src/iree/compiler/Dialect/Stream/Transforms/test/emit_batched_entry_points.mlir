@@ -0,0 +1,29 @@
+// RUN: iree-opt --split-input-file --iree-stream-emit-batched-entry-points=batch-size=2 %s | FileCheck %s
+
+// Tests that a batch-2 entry point is emitted wrapping a public function and
+// that each request gets its own call with an independent argument/result
+// range.
+
+// CHECK-LABEL: util.func public @simpleEntry
+util.func public @simpleEntry(%arg0: !stream.resource<external>, %arg1: index) -> !stream.resource<external> {
+  util.return %arg0 : !stream.resource<external>
+}
+// CHECK: util.func public @simpleEntry_batch2
+// CHECK-SAME: (%[[ARG0:.+]]: !stream.resource<external>, %[[ARG1:.+]]: index, %[[ARG2:.+]]: !stream.resource<external>, %[[ARG3:.+]]: index)
+// CHECK-SAME: -> (!stream.resource<external>, !stream.resource<external>)
+// CHECK-NEXT: %[[RET0:.+]] = util.call @simpleEntry(%[[ARG0]], %[[ARG1]])
+// CHECK-NEXT: %[[RET1:.+]] = util.call @simpleEntry(%[[ARG2]], %[[ARG3]])
+// CHECK-NEXT: util.return %[[RET0]], %[[RET1]]
+
+// -----
+
+// Tests that private functions and declarations are left alone.
+
+// CHECK-LABEL: util.func private @privateFunc
+util.func private @privateFunc(%arg0: index) -> index {
+  util.return %arg0 : index
+}
+// CHECK-NOT: @privateFunc_batch2
+// CHECK: util.func private @externFunc
+util.func private @externFunc(%arg0: index) -> index
+// CHECK-NOT: @externFunc_batch2
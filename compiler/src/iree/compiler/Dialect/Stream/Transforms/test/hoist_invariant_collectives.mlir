@@ -0,0 +1,70 @@
+// RUN: iree-opt --split-input-file --pass-pipeline="builtin.module( util.func(iree-stream-hoist-invariant-collectives))" %s | FileCheck %s
+
+// Tests that a broadcast of loop-invariant data is issued once in the loop
+// preheader instead of every iteration.
+
+// CHECK-LABEL: @hoistInvariantBroadcast
+util.func public @hoistInvariantBroadcast(%channel: !stream.channel, %rank: i32, %send: !stream.resource<*>, %recv: !stream.resource<*>, %dest: !stream.resource<*>, %size: index, %count: index) -> !stream.resource<*> {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c4 = arith.constant 4 : index
+  // CHECK: %[[BCAST:.+]] = stream.async.collective<broadcast : f32>
+  // CHECK: scf.for
+  // CHECK-NOT: stream.async.collective
+  // CHECK: stream.async.copy %[[BCAST]]
+  %result = scf.for %i = %c0 to %c4 step %c1 iter_args(%state = %dest) -> (!stream.resource<*>) {
+    %bcast = stream.async.collective<broadcast : f32>[%count]
+        channel(%channel) source(%rank)
+        %send[%c0 to %size for %size],
+        %recv[%c0 to %size for %size] :
+        !stream.resource<*>{%size} -> %recv as !stream.resource<*>{%size}
+    %copy = stream.async.copy %bcast[%c0 to %size], %state[%c0 to %size], %size : !stream.resource<*>{%size} -> %state as !stream.resource<*>{%size}
+    scf.yield %copy : !stream.resource<*>
+  }
+  util.return %result : !stream.resource<*>
+}
+
+// -----
+
+// Tests that a broadcast reading loop-carried state is left in place.
+
+// CHECK-LABEL: @loopCarriedSourceNotHoisted
+util.func public @loopCarriedSourceNotHoisted(%channel: !stream.channel, %rank: i32, %send: !stream.resource<*>, %recv: !stream.resource<*>, %size: index, %count: index) -> !stream.resource<*> {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c4 = arith.constant 4 : index
+  // CHECK: scf.for
+  // CHECK: stream.async.collective<broadcast : f32>
+  %result = scf.for %i = %c0 to %c4 step %c1 iter_args(%state = %send) -> (!stream.resource<*>) {
+    %bcast = stream.async.collective<broadcast : f32>[%count]
+        channel(%channel) source(%rank)
+        %state[%c0 to %size for %size],
+        %recv[%c0 to %size for %size] :
+        !stream.resource<*>{%size} -> %recv as !stream.resource<*>{%size}
+    scf.yield %bcast : !stream.resource<*>
+  }
+  util.return %result : !stream.resource<*>
+}
+
+// -----
+
+// Tests that loops without a statically-known non-zero trip count are not
+// touched: a hoisted collective must be issued unconditionally by all ranks.
+
+// CHECK-LABEL: @dynamicTripCountNotHoisted
+util.func public @dynamicTripCountNotHoisted(%channel: !stream.channel, %rank: i32, %send: !stream.resource<*>, %recv: !stream.resource<*>, %dest: !stream.resource<*>, %size: index, %count: index, %steps: index) -> !stream.resource<*> {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  // CHECK: scf.for
+  // CHECK: stream.async.collective<broadcast : f32>
+  %result = scf.for %i = %c0 to %steps step %c1 iter_args(%state = %dest) -> (!stream.resource<*>) {
+    %bcast = stream.async.collective<broadcast : f32>[%count]
+        channel(%channel) source(%rank)
+        %send[%c0 to %size for %size],
+        %recv[%c0 to %size for %size] :
+        !stream.resource<*>{%size} -> %recv as !stream.resource<*>{%size}
+    %copy = stream.async.copy %bcast[%c0 to %size], %state[%c0 to %size], %size : !stream.resource<*>{%size} -> %state as !stream.resource<*>{%size}
+    scf.yield %copy : !stream.resource<*>
+  }
+  util.return %result : !stream.resource<*>
+}
@@ -1,4 +1,5 @@
 // RUN: iree-opt --split-input-file --pass-pipeline='builtin.module( util.func(iree-stream-layout-slices, cse))' %s | FileCheck %s
+// RUN: iree-opt --split-input-file --pass-pipeline='builtin.module( util.func(iree-stream-layout-slices{emit-remarks=true}, cse))' --verify-diagnostics %s
 
 #layoutStaticConfig = #stream.resource_config<{
   max_allocation_size = 1073741824,
@@ -9,10 +10,13 @@
 }>
 
 // CHECK-LABEL: @layoutStatic
+// CHECK-SAME: stream.packing.min_size = 432
+// CHECK-SAME: stream.packing.slab_size = 432
 util.func public @layoutStatic() -> (index, index, index, index, index, index, index)
     attributes {stream.resources = #layoutStaticConfig} {
   %c100 = arith.constant 100 : index
   %c200 = arith.constant 200 : index
+  // expected-remark@+1 {{packed 6 slices into 432 B (lower bound 432 B)}}
   %t:7 = stream.resource.pack slices({
     [0, 1] = %c100,  // +0
     [1, 2] = %c100,  // +112 (100 align 16)
@@ -74,6 +78,7 @@ util.func public @layoutMixedStaticDynamic(%size_a: index, %size_b: index) -> (i
     attributes {stream.resources = #layoutMixedStaticDynamicConfig} {
   %c100 = arith.constant 100 : index
   %c200 = arith.constant 200 : index
+  // expected-remark@+1 {{packed 2 slices into 208 B (lower bound 208 B)}}
   %t:5 = stream.resource.pack slices({
     [0, 1] = %c100,
     [1, 2] = %size_a,
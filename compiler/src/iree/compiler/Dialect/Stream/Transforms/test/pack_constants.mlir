@@ -1,4 +1,5 @@
 // RUN: iree-opt --split-input-file --pass-pipeline='builtin.module( util.func(iree-stream-pack-constants))' %s | FileCheck %s
+// RUN: iree-opt --split-input-file --pass-pipeline='builtin.module( util.func(iree-stream-pack-constants{try-map-min-size=128}))' %s | FileCheck %s --check-prefix=MINSIZE
 
 // This is a high level test of the structure emitted by the pass.
 // Subsequent tests focus on individual components.
@@ -122,18 +123,40 @@ util.func public @splitResourceConstants() -> (!stream.resource<constant>, !stre
   // CHECK: stream.file.read await(%[[IMMEDIATE]]) => %[[FILE0]]
   // CHECK: %[[RES0:.+]] = stream.resource.subview %[[IF0]]#1[%c0] : !stream.resource<constant>{%c16} -> !stream.resource<constant>{%c4}
 
+  // Both buckets issue against the same incoming timepoint so the runtime can
+  // overlap their uploads; completion is joined below.
   // CHECK: %[[RODATA1:.+]] = util.buffer.constant {alignment = 16 : index} : !util.buffer = #composite_of_16b1
   // CHECK: %[[DID_MAP1:.+]], %[[TRY_MAP1:.+]] = stream.resource.try_map %[[RODATA1]]
   // CHECK: %[[IF1:.+]]:2 = scf.if %[[DID_MAP1]]
   // CHECK: %[[FILE1:.+]] = stream.file.constant %[[RODATA1]]
-  // CHECK: stream.file.read await(%[[IF0]]#0) => %[[FILE1]]
+  // CHECK: stream.file.read await(%[[IMMEDIATE]]) => %[[FILE1]]
   // CHECK: %[[RES1:.+]] = stream.resource.subview %[[IF1]]#1[%c0] : !stream.resource<constant>{%c16} -> !stream.resource<constant>{%c8}
 
+  // CHECK: %[[JOIN:.+]] = stream.timepoint.join max(%[[IF0]]#0, %[[IF1]]#0)
+
   %0:3 = stream.resource.constants :
     !stream.resource<constant>{%c4} = dense<100> : tensor<1xi32>,
     !stream.resource<constant>{%c8} = dense<[101, 102]> : tensor<2xi32>
     => !stream.timepoint
 
-  // CHECK: util.return %[[RES0]], %[[RES1]], %[[IF1]]#0
+  // CHECK: util.return %[[RES0]], %[[RES1]], %[[JOIN]]
   util.return %0#0, %0#1, %0#2 : !stream.resource<constant>, !stream.resource<constant>, !stream.timepoint
 }
+
+// -----
+
+// Tests that storage buckets below try-map-min-size skip the mapping attempt
+// and are always staged via file I/O; mapping tiny buffers wastes
+// page-granular device memory. Larger buckets (see above) still try to map.
+
+// MINSIZE-LABEL: @smallConstantsStaged
+util.func public @smallConstantsStaged() -> (!stream.resource<constant>, !stream.timepoint) {
+  %c8 = arith.constant 8 : index
+  // MINSIZE-NOT: stream.resource.try_map
+  // MINSIZE: %[[ALLOC:.+]] = stream.resource.alloc uninitialized : !stream.resource<constant>{%c64}
+  // MINSIZE: stream.file.read
+  %0:2 = stream.resource.constants :
+    !stream.resource<constant>{%c8} = dense<[5, 6]> : tensor<2xi32>
+    => !stream.timepoint
+  util.return %0#0, %0#1 : !stream.resource<constant>, !stream.timepoint
+}
@@ -0,0 +1,67 @@
+// RUN: iree-opt --split-input-file --pass-pipeline="builtin.module( util.func(iree-stream-pipeline-loops))" %s | FileCheck %s
+
+// Tests that a transfer/compute loop is rotated so that iteration i's compute
+// can overlap iteration i+1's transfer: the first transfer is peeled ahead of
+// the loop and the in-flight transfer results/timepoint are carried as
+// iter args.
+
+// CHECK-LABEL: @pipelineTransferCompute
+util.func public @pipelineTransferCompute(%src: !stream.resource<staging>, %init: !stream.resource<external>, %size: index) -> !stream.resource<external> {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c4 = arith.constant 4 : index
+  // CHECK: %[[PROLOGUE:.+]], %[[PROLOGUE_TP:.+]] = stream.async.execute with
+  // CHECK-NEXT: stream.async.transfer
+  // CHECK: %[[FOR:.+]]:3 = scf.for %[[IV:.+]] = %c0 to %c4 step %c1
+  // CHECK-SAME: iter_args(%[[STATE:.+]] = %{{.+}}, %[[STAGED:.+]] = %[[PROLOGUE]], %[[TP:.+]] = %[[PROLOGUE_TP]])
+  %result = scf.for %i = %c0 to %c4 step %c1 iter_args(%state = %init) -> (!stream.resource<external>) {
+    %staged, %transfer_tp = stream.async.execute with(%src as %cap: !stream.resource<staging>{%size}) -> !stream.resource<transient>{%size} {
+      %0 = stream.async.transfer %cap : !stream.resource<staging>{%size} -> !stream.resource<transient>{%size}
+      stream.yield %0 : !stream.resource<transient>{%size}
+    } => !stream.timepoint
+    // CHECK: %[[COMPUTED:.+]], %[[COMPUTE_TP:.+]] = stream.async.execute await(%[[TP]]) =>
+    // CHECK-SAME: with(%[[STAGED]] as %{{.+}}: !stream.resource<transient>{%[[SIZE:.+]]}, %[[STATE]] as
+    %computed, %compute_tp = stream.async.execute await(%transfer_tp) => with(%staged as %t: !stream.resource<transient>{%size}, %state as %s: !stream.resource<external>{%size}) -> !stream.resource<external>{%size} {
+      %0 = stream.async.dispatch @ex::@dispatch[%c1, %c1, %c1](%t[%c0 to %size for %size], %s[%c0 to %size for %size]) : (!stream.resource<transient>{%size}, !stream.resource<external>{%size}) -> !stream.resource<external>{%size}
+      stream.yield %0 : !stream.resource<external>{%size}
+    } => !stream.timepoint
+    // CHECK: %[[READY:.+]] = stream.timepoint.await %[[COMPUTE_TP]] => %[[COMPUTED]]
+    %ready = stream.timepoint.await %compute_tp => %computed : !stream.resource<external>{%size}
+    // The next iteration's transfer is issued before the yield (clamped on the
+    // final iteration):
+    // CHECK: arith.minsi
+    // CHECK: %[[NEXT:.+]], %[[NEXT_TP:.+]] = stream.async.execute with
+    // CHECK-NEXT: stream.async.transfer
+    // CHECK: scf.yield %[[READY]], %[[NEXT]], %[[NEXT_TP]]
+    scf.yield %ready : !stream.resource<external>
+  }
+  // CHECK: util.return %[[FOR]]#0
+  util.return %result : !stream.resource<external>
+}
+
+// -----
+
+// Tests that loops whose transfer stage reads loop-carried state are left
+// untouched as the stages cannot overlap across iterations.
+
+// CHECK-LABEL: @skipLoopCarriedTransfer
+util.func public @skipLoopCarriedTransfer(%init: !stream.resource<external>, %size: index) -> !stream.resource<external> {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c4 = arith.constant 4 : index
+  // CHECK: scf.for
+  // CHECK-NOT: arith.minsi
+  %result = scf.for %i = %c0 to %c4 step %c1 iter_args(%state = %init) -> (!stream.resource<external>) {
+    %staged, %transfer_tp = stream.async.execute with(%state as %cap: !stream.resource<external>{%size}) -> !stream.resource<transient>{%size} {
+      %0 = stream.async.transfer %cap : !stream.resource<external>{%size} -> !stream.resource<transient>{%size}
+      stream.yield %0 : !stream.resource<transient>{%size}
+    } => !stream.timepoint
+    %computed, %compute_tp = stream.async.execute await(%transfer_tp) => with(%staged as %t: !stream.resource<transient>{%size}) -> !stream.resource<external>{%size} {
+      %0 = stream.async.dispatch @ex::@dispatch[%c1, %c1, %c1](%t[%c0 to %size for %size]) : (!stream.resource<transient>{%size}) -> !stream.resource<external>{%size}
+      stream.yield %0 : !stream.resource<external>{%size}
+    } => !stream.timepoint
+    %ready = stream.timepoint.await %compute_tp => %computed : !stream.resource<external>{%size}
+    scf.yield %ready : !stream.resource<external>
+  }
+  util.return %result : !stream.resource<external>
+}
@@ -0,0 +1,48 @@
+// RUN: iree-opt --split-input-file --pass-pipeline="builtin.module( util.func(iree-stream-prefetch-parameters))" %s | FileCheck %s
+// RUN: iree-opt --split-input-file --pass-pipeline="builtin.module( util.func(iree-stream-prefetch-parameters{max-staging-bytes=64}))" %s | FileCheck %s --check-prefix=BUDGET
+
+// Tests that parameter gathers are issued ahead of unrelated compute so that
+// file I/O overlaps with execution. With a staging budget smaller than the
+// gathered bytes the op is left at its original position.
+
+// CHECK-LABEL: @hoistGatherAboveCompute
+// BUDGET-LABEL: @hoistGatherAboveCompute
+util.func public @hoistGatherAboveCompute(%wait: !stream.timepoint, %target: !stream.resource<transient>, %input: !stream.resource<*>) -> (!stream.resource<*>, !stream.timepoint) {
+  %c50_i64 = arith.constant 50 : i64
+  %c100 = arith.constant 100 : index
+  %c128 = arith.constant 128 : index
+  %c200 = arith.constant 200 : index
+  %c300 = arith.constant 300 : index
+  // CHECK: stream.parameter.gather
+  // CHECK: stream.async.transfer
+  // BUDGET: stream.async.transfer
+  // BUDGET: stream.parameter.gather
+  %0 = stream.async.transfer %input : !stream.resource<*>{%c128} -> !stream.resource<*>{%c128}
+  %timepoint = stream.parameter.gather await(%wait) => {
+    "scope"::"key"[%c50_i64] -> %target[%c100 for %c200] : !stream.resource<transient>{%c300}
+  } => !stream.timepoint
+  util.return %0, %timepoint : !stream.resource<*>, !stream.timepoint
+}
+
+// -----
+
+// Tests that parameter writes act as barriers: the gather may hoist above
+// unrelated compute but never above a write that may alias its keys.
+
+// CHECK-LABEL: @keepGatherAfterWrite
+util.func public @keepGatherAfterWrite(%wait: !stream.timepoint, %source: !stream.resource<transient>, %target: !stream.resource<transient>, %input: !stream.resource<*>) -> (!stream.resource<*>, !stream.timepoint, !stream.timepoint) {
+  %c50_i64 = arith.constant 50 : i64
+  %c100 = arith.constant 100 : index
+  %c128 = arith.constant 128 : index
+  %c200 = arith.constant 200 : index
+  %c300 = arith.constant 300 : index
+  // CHECK: stream.parameter.write
+  // CHECK-NEXT: stream.parameter.gather
+  // CHECK: stream.async.transfer
+  %write_timepoint = stream.parameter.write await(%wait) => %source[%c100 for %c200] : !stream.resource<transient>{%c300} -> "scope"::"key"[%c50_i64] => !stream.timepoint
+  %0 = stream.async.transfer %input : !stream.resource<*>{%c128} -> !stream.resource<*>{%c128}
+  %gather_timepoint = stream.parameter.gather await(%wait) => {
+    "scope"::"key"[%c50_i64] -> %target[%c100 for %c200] : !stream.resource<transient>{%c300}
+  } => !stream.timepoint
+  util.return %0, %write_timepoint, %gather_timepoint : !stream.resource<*>, !stream.timepoint, !stream.timepoint
+}
@@ -146,6 +146,37 @@ struct RegisterUsage {
     }
   }
 
+  // Attempts to reserve the specific |reg|, returning false if any required
+  // slot is unavailable. Used to honor cross-block coalescing hints where we
+  // want a block argument to land in the same register its incoming values
+  // already occupy.
+  bool tryAllocateRegister(Register reg) {
+    int ordinalStart = reg.ordinal();
+    if (reg.isRef()) {
+      if (ordinalStart >= Register::kRefRegisterCount ||
+          refRegisters.test(ordinalStart)) {
+        return false;
+      }
+    } else {
+      unsigned int requiredAlignment = reg.byteWidth() / 4;
+      if ((ordinalStart % requiredAlignment) != 0) {
+        return false;
+      }
+      unsigned int ordinalEnd = ordinalStart + (reg.byteWidth() / 4) - 1;
+      if (ordinalEnd >= Register::kInt32RegisterCount) {
+        return false;
+      }
+      for (unsigned int ordinal = ordinalStart; ordinal <= ordinalEnd;
+           ++ordinal) {
+        if (intRegisters.test(ordinal)) {
+          return false;
+        }
+      }
+    }
+    markRegisterUsed(reg);
+    return true;
+  }
+
   void markRegisterUsed(Register reg) {
     int ordinalStart = reg.ordinal();
     if (reg.isRef()) {
@@ -203,12 +234,53 @@ sortBlocksInDominanceOrder(IREE::VM::FuncOp funcOp) {
   return orderedBlocks;
 }
 
+// Returns the registers that values forwarded to |blockArg| from
+// already-allocated predecessor branches occupy, ordered by how many incoming
+// edges use each register. Assigning the block argument one of these registers
+// turns the remap on those edges into a no-op, which matters most for ref
+// registers where every materialized move pays an atomic refcount at runtime.
+static SmallVector<Register, 2>
+getBlockArgumentCoalescingHints(BlockArgument blockArg,
+                                llvm::DenseMap<Value, Register> &map) {
+  llvm::SmallMapVector<Register, int, 2> hintCounts;
+  Block *block = blockArg.getOwner();
+  for (Block *predBlock : block->getPredecessors()) {
+    auto branchOp = dyn_cast<BranchOpInterface>(predBlock->getTerminator());
+    if (!branchOp)
+      continue;
+    for (unsigned i = 0; i < branchOp->getNumSuccessors(); ++i) {
+      if (branchOp->getSuccessor(i) != block)
+        continue;
+      auto forwardedOperands =
+          branchOp.getSuccessorOperands(i).getForwardedOperands();
+      if (blockArg.getArgNumber() >= forwardedOperands.size())
+        continue;
+      // Predecessors later in dominance order (back edges) have not been
+      // allocated yet and provide no hint.
+      auto it = map.find(forwardedOperands[blockArg.getArgNumber()]);
+      if (it == map.end())
+        continue;
+      ++hintCounts[it->getSecond().asBaseRegister()];
+    }
+  }
+  auto hints = hintCounts.takeVector();
+  llvm::stable_sort(hints, [](const std::pair<Register, int> &lhs,
+                              const std::pair<Register, int> &rhs) {
+    return lhs.second > rhs.second;
+  });
+  return llvm::map_to_vector<2>(
+      hints, [](const std::pair<Register, int> &hint) { return hint.first; });
+}
+
 // NOTE: this is not a good algorithm, nor is it a good allocator. If you're
 // looking at this and have ideas of how to do this for real please feel
 // free to rip it all apart :)
 //
-// Because I'm lazy we really only look at individual blocks at a time. It'd
-// be much better to use dominance info to track values across blocks and
+// Because I'm lazy we really only look at individual blocks at a time. Block
+// arguments are the one place we peek across block boundaries: they prefer the
+// registers their incoming branch operands already occupy so the common
+// diamond/join control flow coalesces into zero-move branches. It'd still be
+// much better to use dominance info to track values across blocks and
 // ensure we are avoiding as many moves as possible. The special case we need to
 // handle is when values are not defined within the current block (as values in
 // dominators are allowed to cross block boundaries outside of arguments).
@@ -238,9 +310,20 @@ LogicalResult RegisterAllocation::recalculate(IREE::VM::FuncOp funcOp) {
       registerUsage.markRegisterUsed(mapToRegister(liveInValue));
     }
 
-    // Allocate arguments first from left-to-right.
+    // Allocate arguments first from left-to-right, preferring registers that
+    // coalesce with incoming branch operands so the branch remaps become
+    // no-ops.
     for (auto blockArg : block->getArguments()) {
-      auto reg = registerUsage.allocateRegister(blockArg.getType());
+      std::optional<Register> reg;
+      for (auto hint : getBlockArgumentCoalescingHints(blockArg, map_)) {
+        if (registerUsage.tryAllocateRegister(hint)) {
+          reg = hint;
+          break;
+        }
+      }
+      if (!reg.has_value()) {
+        reg = registerUsage.allocateRegister(blockArg.getType());
+      }
       if (!reg.has_value()) {
         return funcOp.emitError() << "register allocation failed for block arg "
                                   << blockArg.getArgNumber();
@@ -29,6 +29,11 @@ void TargetOptions::bindOptions(OptionsBinder &binder) {
                    truncateUnsupportedFloats,
                    llvm::cl::desc("Truncate f64 to f32 when unsupported."),
                    llvm::cl::cat(vmTargetOptionsCategory));
+  binder.opt<bool>(
+      "iree-vm-target-fused-ops", fusedOps,
+      llvm::cl::desc("Emit fused superinstruction opcodes; requires a runtime "
+                     "with the fused-ops feature."),
+      llvm::cl::cat(vmTargetOptionsCategory));
   binder.opt<bool>(
       "iree-vm-target-optimize-for-stack-size", optimizeForStackSize,
       llvm::cl::desc(
@@ -29,6 +29,10 @@ struct TargetOptions {
   // Prefer optimizations that reduce VM stack usage over performance.
   bool optimizeForStackSize = false;
 
+  // Whether to emit fused superinstruction opcodes.
+  // Modules using fused ops require a runtime with the fused-ops feature.
+  bool fusedOps = false;
+
   void bindOptions(OptionsBinder &binder);
   using FromFlags = OptionsFromFlags<TargetOptions>;
 };
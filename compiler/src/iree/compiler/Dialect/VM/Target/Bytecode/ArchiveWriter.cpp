@@ -65,6 +65,7 @@ FlatArchiveWriter::~FlatArchiveWriter() { os.flush(); }
 ArchiveWriter::File FlatArchiveWriter::declareFile(
     std::string fileName, uint64_t fileAlignment, uint64_t fileLength,
     std::function<LogicalResult(llvm::raw_ostream &os)> write) {
+  maxFileAlignment = std::max(maxFileAlignment, fileAlignment);
   File file;
   file.fileName = std::move(fileName);
   file.relativeOffset = IREE::Util::align(tailFileOffset, fileAlignment);
@@ -76,11 +77,38 @@ ArchiveWriter::File FlatArchiveWriter::declareFile(
 }
 
 LogicalResult FlatArchiveWriter::flush(FlatbufferBuilder &fbb) {
-  // Write the FlatBuffer contents out.
-  if (failed(fbb.copyToStream(os))) {
-    return mlir::emitError(loc)
-           << "failed to copy FlatBuffer emitter contents to the output stream "
-              "- possibly out of memory or storage";
+  if (maxFileAlignment <= kArchiveSegmentAlignment) {
+    // Write the FlatBuffer contents out directly.
+    if (failed(fbb.copyToStream(os))) {
+      return mlir::emitError(loc)
+             << "failed to copy FlatBuffer emitter contents to the output "
+                "stream - possibly out of memory or storage";
+    }
+  } else {
+    // One or more files require greater alignment than the default archive
+    // segment alignment (such as page alignment for mapped rodata). The
+    // runtime locates the external segment base by aligning the end of the
+    // size-prefixed FlatBuffer so we grow the size prefix to cover trailing
+    // zero padding that places the base on the requested boundary.
+    std::string moduleData;
+    {
+      llvm::raw_string_ostream moduleStream(moduleData);
+      if (failed(fbb.copyToStream(moduleStream))) {
+        return mlir::emitError(loc)
+               << "failed to serialize FlatBuffer emitter contents to memory "
+                  "- possibly out of memory";
+      }
+      moduleStream.flush();
+    }
+    auto paddedModuleLength = static_cast<flatbuffers_uoffset_t>(
+        IREE::Util::align(moduleData.size(), maxFileAlignment) -
+        sizeof(flatbuffers_uoffset_t));
+    os.write(reinterpret_cast<char *>(&paddedModuleLength),
+             sizeof(flatbuffers_uoffset_t));
+    os.write(moduleData.data() + sizeof(flatbuffers_uoffset_t),
+             moduleData.size() - sizeof(flatbuffers_uoffset_t));
+    os.write_zeros(sizeof(flatbuffers_uoffset_t) + paddedModuleLength -
+                   moduleData.size());
   }
 
   // Pad out to the start of the external rodata segment.
@@ -576,6 +604,7 @@ ZIPArchiveWriter::~ZIPArchiveWriter() { os.flush(); }
 ArchiveWriter::File ZIPArchiveWriter::declareFile(
     std::string fileName, uint64_t fileAlignment, uint64_t fileLength,
     std::function<LogicalResult(llvm::raw_ostream &os)> write) {
+  maxFileAlignment = std::max(maxFileAlignment, fileAlignment);
   // Align the file offset; the header will be prepended.
   uint64_t headerOffset = tailFileOffset;
   uint64_t headerLength = computeMinHeaderLength(fileName);
@@ -620,10 +649,15 @@ LogicalResult ZIPArchiveWriter::flush(FlatbufferBuilder &fbb) {
   }
 
   // Pad out the module data so we can easily compute the relative offsets.
+  // When a declared file requires over-alignment (such as page-aligned rodata)
+  // the padding also places the external segment base on that boundary.
+  uint64_t moduleAlignment =
+      std::max<uint64_t>(kArchiveSegmentAlignment, maxFileAlignment);
   auto paddedModuleLength = static_cast<flatbuffers_uoffset_t>(
-      IREE::Util::align(sizeof(flatbuffers_uoffset_t) + moduleData.size(),
-                        kArchiveSegmentAlignment) -
-      sizeof(flatbuffers_uoffset_t));
+      IREE::Util::align(startOffset + modulePadding +
+                            sizeof(flatbuffers_uoffset_t) + moduleData.size(),
+                        moduleAlignment) -
+      startOffset - modulePadding - sizeof(flatbuffers_uoffset_t));
 
   // Stream out the FlatBuffer contents.
   auto zipFile = appendZIPFile(
@@ -647,7 +681,7 @@ LogicalResult ZIPArchiveWriter::flush(FlatbufferBuilder &fbb) {
   // in the embedded files assume this.
   uint64_t baseOffset = os.tell();
   uint64_t basePadding =
-      IREE::Util::align(baseOffset, kArchiveSegmentAlignment) - baseOffset;
+      IREE::Util::align(baseOffset, moduleAlignment) - baseOffset;
   os.write_zeros(basePadding);
   baseOffset = os.tell();
 
@@ -45,6 +45,10 @@ public:
   // Declares an embedded file in the archive and reserves a location for it.
   // The relative offset returned will be stable despite the variable-length
   // FlatBuffer header as it is relative to the header and not the archive 0.
+  // |fileAlignment| applies to the absolute offset of the file contents within
+  // the archive: writers pad the FlatBuffer header so that over-aligned files
+  // (e.g. page-aligned rodata for zero-copy mapping) land on their boundary
+  // when the archive itself is loaded at an aligned base address.
   virtual File
   declareFile(std::string fileName, uint64_t fileAlignment, uint64_t fileLength,
               std::function<LogicalResult(llvm::raw_ostream &os)> write) = 0;
@@ -100,6 +104,9 @@ private:
   Location loc;
   llvm::raw_ostream &os;
   uint64_t tailFileOffset = 0; // unpadded
+  // Largest alignment required by any declared file; the FlatBuffer header is
+  // padded out so the external segment base lands on this boundary.
+  uint64_t maxFileAlignment = 0;
   SmallVector<File> files;
 };
 
@@ -135,6 +142,9 @@ private:
   Location loc;
   llvm::raw_ostream &os;
   uint64_t tailFileOffset = 0; // unpadded
+  // Largest alignment required by any declared file; the FlatBuffer header is
+  // padded out so the external segment base lands on this boundary.
+  uint64_t maxFileAlignment = 0;
   SmallVector<File> files;
 };
 
@@ -24,10 +24,13 @@
 #include "iree/compiler/Utils/FlatbufferUtils.h"
 #include "iree/compiler/Utils/TracingUtils.h"
 #include "iree/schemas/bytecode_module_def_builder.h"
+#include "llvm/ADT/Sequence.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/Support/CRC.h"
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "mlir/IR/Attributes.h"
 #include "mlir/IR/BuiltinOps.h"
 #include "mlir/IR/Diagnostics.h"
@@ -124,6 +127,152 @@ serializeEmbeddedData(Location loc, Attribute valueAttr, uint64_t alignment,
   return flatbuffers_uint8_vec_end(fbb);
 }
 
+// Compresses |data| into the LZ77 packet stream decoded by the runtime
+// loader (the format is documented on LZ77DataDef in
+// iree/schemas/bytecode_module_def.fbs) using a greedy single-pass match
+// search over a 64KB window.
+static void compressLZ77(ArrayRef<uint8_t> data,
+                         SmallVectorImpl<uint8_t> &output) {
+  static constexpr size_t kMinMatchLength = 4;
+  static constexpr size_t kMaxMatchOffset = 65535;
+  static constexpr unsigned kHashBits = 15;
+
+  // Appends the extension bytes for a 4-bit length nibble of 15: each byte
+  // adds 0-255 and any value < 255 terminates the run.
+  auto emitLengthExtension = [&](size_t length) {
+    length -= 15;
+    while (length >= 255) {
+      output.push_back(255);
+      length -= 255;
+    }
+    output.push_back(static_cast<uint8_t>(length));
+  };
+  auto emitPacket = [&](size_t literalStart, size_t literalLength,
+                        size_t matchOffset, size_t matchLength) {
+    size_t literalNibble = std::min(literalLength, size_t(15));
+    size_t matchNibble =
+        matchLength ? std::min(matchLength - kMinMatchLength, size_t(15)) : 0;
+    output.push_back(static_cast<uint8_t>((literalNibble << 4) | matchNibble));
+    if (literalNibble == 15) emitLengthExtension(literalLength);
+    output.append(data.begin() + literalStart,
+                  data.begin() + literalStart + literalLength);
+    if (!matchLength) return;  // final literals-only packet
+    output.push_back(static_cast<uint8_t>(matchOffset & 0xFF));
+    output.push_back(static_cast<uint8_t>(matchOffset >> 8));
+    if (matchNibble == 15) emitLengthExtension(matchLength - kMinMatchLength);
+  };
+
+  // Hash table of the most recent position of each 4-byte sequence prefix.
+  SmallVector<uint32_t> hashTable(1u << kHashBits, UINT32_MAX);
+  auto hashAt = [&](size_t pos) {
+    uint32_t word = static_cast<uint32_t>(data[pos]) |
+                    (static_cast<uint32_t>(data[pos + 1]) << 8) |
+                    (static_cast<uint32_t>(data[pos + 2]) << 16) |
+                    (static_cast<uint32_t>(data[pos + 3]) << 24);
+    return (word * 2654435761u) >> (32 - kHashBits);
+  };
+
+  size_t literalStart = 0;
+  size_t i = 0;
+  while (i + kMinMatchLength <= data.size()) {
+    uint32_t hash = hashAt(i);
+    size_t candidate = hashTable[hash];
+    hashTable[hash] = static_cast<uint32_t>(i);
+    if (candidate != UINT32_MAX && i - candidate <= kMaxMatchOffset &&
+        std::equal(data.begin() + i, data.begin() + i + kMinMatchLength,
+                   data.begin() + candidate)) {
+      size_t matchLength = kMinMatchLength;
+      while (i + matchLength < data.size() &&
+             data[candidate + matchLength] == data[i + matchLength]) {
+        ++matchLength;
+      }
+      emitPacket(literalStart, i - literalStart, i - candidate, matchLength);
+      i += matchLength;
+      literalStart = i;
+    } else {
+      ++i;
+    }
+  }
+  if (literalStart < data.size()) {
+    emitPacket(literalStart, data.size() - literalStart, 0, 0);
+  }
+}
+
+// Attempts to serialize |valueAttr| compressed with the LZ77 codec decoded by
+// the runtime loader, returning the embedded data vector holding the
+// compressed stream and setting |outCompressionRef| when compression is
+// profitable. Returns 0 without diagnostics when the segment should remain
+// uncompressed; declining to compress is never an error.
+static flatbuffers_uint8_vec_ref_t
+serializeCompressedData(Location loc, Attribute valueAttr, uint64_t alignment,
+                        uint64_t totalSize, FlatbufferBuilder &fbb,
+                        iree_vm_LZ77DataDef_ref_t &outCompressionRef) {
+  // Decompressed segments are served from 64-byte-aligned heap storage in the
+  // loader; segments requiring stronger alignment must stay in-place and
+  // uncompressed. Tiny segments aren't worth the packet overhead and the
+  // match window limits the encoder to 32-bit positions.
+  static constexpr uint64_t kStorageAlignment = 64;
+  static constexpr uint64_t kMinCompressedSize = 256;
+  if (totalSize < kMinCompressedSize || totalSize > UINT32_MAX ||
+      alignment > kStorageAlignment) {
+    return 0;
+  }
+
+  auto value = llvm::dyn_cast<IREE::Util::SerializableAttrInterface>(valueAttr);
+  if (!value) return 0;
+  SmallVector<char> buffer(static_cast<size_t>(totalSize));
+  if (failed(value.serializeToBuffer(loc, llvm::endianness::little,
+                                     MutableArrayRef<char>(buffer)))) {
+    return 0;
+  }
+
+  SmallVector<uint8_t> compressed;
+  compressLZ77(ArrayRef<uint8_t>(reinterpret_cast<uint8_t *>(buffer.data()),
+                                 buffer.size()),
+               compressed);
+
+  // Require a meaningful saving: marginal wins aren't worth the load-time
+  // decompression cost and the loss of zero-copy access.
+  if (compressed.size() >= totalSize - totalSize / 8) return 0;
+
+  outCompressionRef = iree_vm_LZ77DataDef_create(fbb, totalSize);
+  return flatbuffers_uint8_vec_create(fbb, compressed.data(),
+                                      compressed.size());
+}
+
+// Loads a call-frequency profile used for layout planning.
+// Each non-empty line is `<function-name> <count>` separated by whitespace;
+// `#` begins a comment line. Names may be bare internal function symbols or
+// module-qualified (`module.function`) as produced by Tracy zone statistics.
+// Counts for duplicate names accumulate so concatenated profiles just work.
+static LogicalResult loadFunctionProfile(IREE::VM::ModuleOp moduleOp,
+                                         StringRef profilePath,
+                                         llvm::StringMap<uint64_t> &profile) {
+  auto fileOr = llvm::MemoryBuffer::getFile(profilePath, /*IsText=*/true);
+  if (!fileOr) {
+    return moduleOp.emitError()
+           << "failed to open call-frequency profile '" << profilePath
+           << "': " << fileOr.getError().message();
+  }
+  SmallVector<StringRef> lines;
+  (*fileOr)->getBuffer().split(lines, '\n');
+  for (auto line : lines) {
+    line = line.trim();
+    if (line.empty() || line.starts_with("#"))
+      continue;
+    size_t splitPos = line.find_last_of(" \t");
+    uint64_t count = 0;
+    if (splitPos == StringRef::npos ||
+        line.drop_front(splitPos + 1).getAsInteger(10, count)) {
+      return moduleOp.emitError()
+             << "malformed line in call-frequency profile '" << profilePath
+             << "': expected `<function-name> <count>`, got '" << line << "'";
+    }
+    profile[line.take_front(splitPos).rtrim()] += count;
+  }
+  return success();
+}
+
 // Canonicalizes the module to its final form prior to emission.
 // This verifies that we only have ops we can serialize and performs any of the
 // required transformations (such as debug op stripping).
@@ -275,6 +424,9 @@ static iree_vm_FeatureBits_enum_t findRequiredFeatures(Operation *rootOp) {
     if (op->hasTrait<OpTrait::IREE::VM::ExtF64>()) {
       result |= iree_vm_FeatureBits_EXT_F64;
     }
+    if (op->hasTrait<OpTrait::IREE::VM::FusedOp>()) {
+      result |= iree_vm_FeatureBits_FUSED_OPS;
+    }
   });
   return result;
 }
@@ -339,13 +491,30 @@ buildFlatBufferModule(IREE::VM::TargetOptions vmOptions,
     typeOrdinalMap[typeDef.value().type] = typeDef.index();
   }
 
+  // Optional call-frequency profile used to plan the physical layout of
+  // function bytecode and rodata below; empty when no profile was provided.
+  llvm::StringMap<uint64_t> functionProfile;
+  if (!bytecodeOptions.profilePath.empty()) {
+    if (failed(loadFunctionProfile(moduleOp, bytecodeOptions.profilePath,
+                                   functionProfile))) {
+      return failure();
+    }
+  }
+  auto lookupProfileCount = [&](StringRef funcName) -> uint64_t {
+    auto it = functionProfile.find(funcName);
+    if (it == functionProfile.end()) {
+      it = functionProfile.find(
+          (moduleOp.getSymName() + "." + funcName).str());
+    }
+    return it == functionProfile.end() ? 0ull : it->second;
+  };
+
   // Serialize function bytecode one at a time and then merge at the end.
   SmallVector<std::vector<uint8_t>, 8> bytecodeDataParts;
   SmallVector<iree_vm_FunctionDescriptor_t, 8> functionDescriptors;
   bytecodeDataParts.resize(internalFuncOps.size());
   functionDescriptors.resize(internalFuncOps.size());
   iree_vm_FeatureBits_enum_t moduleRequirements = 0;
-  size_t totalBytecodeLength = 0;
   for (auto [i, funcOp] : llvm::enumerate(internalFuncOps)) {
     auto encodedFunction = BytecodeEncoder::encodeFunction(
         funcOp, typeOrdinalMap, symbolTable, debugDatabase);
@@ -355,13 +524,36 @@ buildFlatBufferModule(IREE::VM::TargetOptions vmOptions,
     auto funcRequirements = findRequiredFeatures(funcOp);
     moduleRequirements |= funcRequirements;
     iree_vm_FunctionDescriptor_assign(
-        &functionDescriptors[i], totalBytecodeLength,
+        &functionDescriptors[i], /*bytecode_offset=*/0,
         encodedFunction->bytecodeLength, funcRequirements,
         /*reserved=*/0u, encodedFunction->blockCount,
         encodedFunction->i32RegisterCount, encodedFunction->refRegisterCount);
-    totalBytecodeLength += encodedFunction->bytecodeData.size();
     bytecodeDataParts[i] = std::move(encodedFunction->bytecodeData);
   }
+
+  // Decide the physical order of the function bodies within the merged
+  // bytecode data. Descriptors are indexed by ordinal and carry explicit
+  // offsets so the physical order is free to differ: with a profile we emit
+  // the hottest functions first so that frequently executed code shares
+  // adjacent pages near the front of the data segment instead of being
+  // scattered in declaration order. Without a profile this is a no-op
+  // identity ordering.
+  SmallVector<int> functionEmissionOrder = llvm::to_vector(
+      llvm::seq<int>(0, static_cast<int>(internalFuncOps.size())));
+  if (!functionProfile.empty()) {
+    SmallVector<uint64_t> functionHotness = llvm::map_to_vector(
+        internalFuncOps,
+        [&](auto funcOp) { return lookupProfileCount(funcOp.getName()); });
+    llvm::stable_sort(functionEmissionOrder, [&](int lhs, int rhs) {
+      return functionHotness[lhs] > functionHotness[rhs];
+    });
+  }
+  size_t totalBytecodeLength = 0;
+  for (int ordinal : functionEmissionOrder) {
+    functionDescriptors[ordinal].bytecode_offset = totalBytecodeLength;
+    totalBytecodeLength += bytecodeDataParts[ordinal].size();
+  }
+
   flatbuffers_uint8_vec_start(fbb);
   uint8_t *bytecodeDataPtr =
       flatbuffers_uint8_vec_extend(fbb, totalBytecodeLength);
@@ -369,12 +561,10 @@ buildFlatBufferModule(IREE::VM::TargetOptions vmOptions,
   // alignment (where otherwise uninitialized memory might sneak in and be bad
   // for both security and determinism).
   memset(bytecodeDataPtr, 0, totalBytecodeLength);
-  size_t currentBytecodeOffset = 0;
-  for (const auto &[ordinal, _] : llvm::enumerate(internalFuncOps)) {
+  for (int ordinal : functionEmissionOrder) {
     auto data = std::move(bytecodeDataParts[ordinal]);
-    std::memcpy(bytecodeDataPtr + currentBytecodeOffset, data.data(),
-                data.size());
-    currentBytecodeOffset += data.size();
+    std::memcpy(bytecodeDataPtr + functionDescriptors[ordinal].bytecode_offset,
+                data.data(), data.size());
   }
   auto bytecodeDataRef = flatbuffers_uint8_vec_end(fbb);
 
@@ -389,12 +579,39 @@ buildFlatBufferModule(IREE::VM::TargetOptions vmOptions,
   // Serialize embedded read-only data and build the rodata references.
   //
   // NOTE: FlatBuffers are built bottom-up; after each rodata we serialize we
-  // move *backward* in the file and prepend the next, meaning that if we
-  // were to serialize all rodata we'd have it in the opposite order as we do
-  // in the IR. Though this it isn't required for correctness, enabling file
-  // layout planning by preserving the order in the IR is useful.
-  SmallVector<iree_vm_RodataSegmentDef_ref_t, 8> rodataSegmentRefs;
-  for (auto &rodataRef : llvm::reverse(rodataRefs)) {
+  // move *backward* in the file and prepend the next, meaning that the last
+  // rodata serialized here lands closest to the front of the file. Segment
+  // refs are stored by rodata ordinal regardless of the physical order so we
+  // are free to plan the file layout: by default we preserve the order in the
+  // IR and with a profile we pull rodata referenced by hot functions toward
+  // the front so it shares pages with the code that touches it.
+  SmallVector<int> rodataEmissionOrder = llvm::to_vector(
+      llvm::seq<int>(0, static_cast<int>(rodataRefs.size())));
+  if (!functionProfile.empty()) {
+    // Rank each rodata by the hottest function referencing it (lower rank is
+    // hotter); unreferenced rodata sinks to the end in IR order.
+    llvm::StringMap<int> rodataIndexMap;
+    for (auto [i, rodataRef] : llvm::enumerate(rodataRefs)) {
+      rodataIndexMap[rodataRef.rodataOp.getName()] = i;
+    }
+    SmallVector<size_t> rodataRank(rodataRefs.size(), SIZE_MAX);
+    for (auto [rank, ordinal] : llvm::enumerate(functionEmissionOrder)) {
+      internalFuncOps[ordinal].walk([&, rank = rank](
+                                        IREE::VM::ConstRefRodataOp accessOp) {
+        auto it = rodataIndexMap.find(accessOp.getRodata());
+        if (it != rodataIndexMap.end()) {
+          rodataRank[it->second] = std::min(rodataRank[it->second], rank);
+        }
+      });
+    }
+    llvm::stable_sort(rodataEmissionOrder, [&](int lhs, int rhs) {
+      return rodataRank[lhs] < rodataRank[rhs];
+    });
+  }
+  SmallVector<iree_vm_RodataSegmentDef_ref_t, 8> rodataSegmentRefs(
+      rodataRefs.size());
+  for (int ordinal : llvm::reverse(rodataEmissionOrder)) {
+    auto &rodataRef = rodataRefs[ordinal];
     if (rodataRef.archiveFile.has_value()) {
       // Data is already in the file at a calculated offset.
       iree_vm_RodataSegmentDef_start(fbb);
@@ -403,20 +620,34 @@ buildFlatBufferModule(IREE::VM::TargetOptions vmOptions,
                    rodataRef.archiveFile->prefixLength);
       iree_vm_RodataSegmentDef_external_data_length_add(
           fbb, rodataRef.archiveFile->fileLength);
-      rodataSegmentRefs.push_back(iree_vm_RodataSegmentDef_end(fbb));
+      rodataSegmentRefs[ordinal] = iree_vm_RodataSegmentDef_end(fbb);
     } else {
       // Serialize the embedded data first so that we can reference it.
-      flatbuffers_uint8_vec_ref_t embeddedRef = serializeEmbeddedData(
-          rodataRef.rodataOp.getLoc(), rodataRef.rodataOp.getValue(),
-          rodataRef.alignment, rodataRef.totalSize, fbb);
-      if (!embeddedRef)
-        return failure();
+      // When compression is requested try the compressed form first and fall
+      // back to uncompressed data when it doesn't pay for itself.
+      iree_vm_LZ77DataDef_ref_t compressionRef = 0;
+      flatbuffers_uint8_vec_ref_t embeddedRef = 0;
+      if (bytecodeOptions.compressRodata) {
+        embeddedRef = serializeCompressedData(
+            rodataRef.rodataOp.getLoc(), rodataRef.rodataOp.getValue(),
+            rodataRef.alignment, rodataRef.totalSize, fbb, compressionRef);
+      }
+      if (!embeddedRef) {
+        embeddedRef = serializeEmbeddedData(
+            rodataRef.rodataOp.getLoc(), rodataRef.rodataOp.getValue(),
+            rodataRef.alignment, rodataRef.totalSize, fbb);
+        if (!embeddedRef)
+          return failure();
+      }
       iree_vm_RodataSegmentDef_start(fbb);
+      if (compressionRef) {
+        iree_vm_RodataSegmentDef_compression_type_add(
+            fbb, iree_vm_CompressionTypeDef_as_LZ77DataDef(compressionRef));
+      }
       iree_vm_RodataSegmentDef_embedded_data_add(fbb, embeddedRef);
-      rodataSegmentRefs.push_back(iree_vm_RodataSegmentDef_end(fbb));
+      rodataSegmentRefs[ordinal] = iree_vm_RodataSegmentDef_end(fbb);
     }
   }
-  std::reverse(rodataSegmentRefs.begin(), rodataSegmentRefs.end());
 
   // NOTE: rwdata is currently unused.
   SmallVector<iree_vm_RwdataSegmentDef_ref_t, 8> rwdataSegmentRefs;
@@ -525,6 +756,8 @@ buildFlatBufferModule(IREE::VM::TargetOptions vmOptions,
     allowedFeatures |= iree_vm_FeatureBits_EXT_F32;
   if (vmOptions.f64Extension)
     allowedFeatures |= iree_vm_FeatureBits_EXT_F64;
+  if (vmOptions.fusedOps)
+    allowedFeatures |= iree_vm_FeatureBits_FUSED_OPS;
   if ((moduleRequirements & allowedFeatures) != moduleRequirements) {
     return moduleOp.emitError()
            << "module uses features not allowed by flags (requires "
@@ -657,8 +890,13 @@ translateModuleToBytecode(IREE::VM::ModuleOp moduleOp,
           (rodataOp.getName() +
            mimeTypeToFileExtension(rodataOp.getMimeType().value_or("")))
               .str();
+      // Over-align the file in the archive if requested; page alignment
+      // (4096+) guarantees mapped modules can reference the data zero-copy.
+      uint64_t fileAlignment =
+          std::max(rodataRef.alignment,
+                   static_cast<uint64_t>(bytecodeOptions.rodataAlignment));
       rodataRef.archiveFile = archiveWriter->declareFile(
-          fileName, rodataRef.alignment, rodataRef.totalSize,
+          fileName, fileAlignment, rodataRef.totalSize,
           [=](llvm::raw_ostream &os) {
             return rodataValue.serializeToStream(rodataLoc,
                                                  llvm::endianness::little, os);
@@ -738,6 +976,28 @@ void BytecodeTargetOptions::bindOptions(OptionsBinder &binder) {
       llvm::cl::desc(
           "Enables output files to be viewed as zip files for debugging "
           "(only applies to binary targets)"));
+  binder.opt<std::string>(
+      "iree-vm-bytecode-module-profile-path", profilePath,
+      llvm::cl::cat(vmBytecodeOptionsCategory),
+      llvm::cl::desc(
+          "Path to a call-frequency profile (lines of `function count`) used "
+          "to cluster hot function bytecode and rodata at the front of the "
+          "emitted module"));
+  binder.opt<int64_t>(
+      "iree-vm-bytecode-module-rodata-alignment", rodataAlignment,
+      llvm::cl::cat(vmBytecodeOptionsCategory),
+      llvm::cl::desc(
+          "Power-of-two byte alignment applied to external rodata segments "
+          "in the emitted archive; values such as 4096 page-align large "
+          "constants for zero-copy mapping from disk (0 = default archive "
+          "segment alignment)"));
+  binder.opt<bool>(
+      "iree-vm-bytecode-module-compress-rodata", compressRodata,
+      llvm::cl::cat(vmBytecodeOptionsCategory),
+      llvm::cl::desc(
+          "Compresses embedded rodata segments when it meaningfully reduces "
+          "their serialized size; compressed segments are decompressed into "
+          "heap memory at module load time"));
 }
 
 } // namespace mlir::iree_compiler::IREE::VM
@@ -54,6 +54,29 @@ struct BytecodeTargetOptions {
   // should be disabled in release builds.
   bool emitPolyglotZip = true;
 
+  // Path to an optional call-frequency profile used for layout planning.
+  // Each line is a function symbol name (optionally module-qualified as
+  // `module.function`, matching Tracy zone names) followed by whitespace and a
+  // call count. Function bytecode and embedded rodata are emitted hottest
+  // first so that frequently executed code clusters into adjacent pages near
+  // the front of the module instead of being scattered in declaration order.
+  std::string profilePath;
+
+  // Power-of-two byte alignment applied to external rodata segments in the
+  // emitted archive in addition to any per-rodata alignment requirement.
+  // Values greater than the default 64-byte archive segment alignment (such
+  // as 4096) page-align large constants so that modules mapped from disk can
+  // reference them zero-copy and share the clean pages across processes via
+  // the OS page cache. 0 uses the default archive segment alignment.
+  int64_t rodataAlignment = 0;
+
+  // Compresses embedded rodata segments with the VM loader's LZ77 codec when
+  // doing so meaningfully reduces their serialized size. Compressed segments
+  // are decompressed into heap memory at module load time, trading first-load
+  // cost and runtime memory for a smaller artifact; leave disabled when
+  // modules are mapped from disk and served zero-copy.
+  bool compressRodata = false;
+
   void bindOptions(OptionsBinder &binder);
   using FromFlags = OptionsFromFlags<BytecodeTargetOptions>;
 };
@@ -0,0 +1,119 @@
+// Copyright 2026 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/compiler/Dialect/VM/IR/VMDialect.h"
+#include "iree/compiler/Dialect/VM/IR/VMOps.h"
+#include "iree/compiler/Dialect/VM/Transforms/Passes.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+
+namespace mlir::iree_compiler::IREE::VM {
+
+namespace {
+
+// %0 = vm.cmp.lt.i32.s %a, %b : i32
+// %1 = vm.select.i32 %0, %x, %y : i32
+// ->
+// %1 = vm.select.lt.i32.s %a, %b, %x, %y : i32
+//
+// When |swapValues| is true the true/false values are exchanged so that
+// negated predicates (such as NE) can map onto their complement opcode.
+template <class SelectOp, class CmpOp, class FusedOp, bool swapValues = false>
+struct FuseCmpSelectOp : public OpRewritePattern<SelectOp> {
+  using OpRewritePattern<SelectOp>::OpRewritePattern;
+  LogicalResult matchAndRewrite(SelectOp selectOp,
+                                PatternRewriter &rewriter) const override {
+    auto cmpOp =
+        dyn_cast_or_null<CmpOp>(selectOp.getCondition().getDefiningOp());
+    if (!cmpOp || !cmpOp->hasOneUse() ||
+        cmpOp->isUsedOutsideOfBlock(cmpOp->getBlock())) {
+      return failure();
+    }
+    // The fused op compares values of the selected type; mixed-width
+    // cmp/select pairs have no superinstruction.
+    if (cmpOp.getLhs().getType() != selectOp.getResult().getType()) {
+      return failure();
+    }
+    Value trueValue = selectOp.getTrueValue();
+    Value falseValue = selectOp.getFalseValue();
+    if (swapValues) std::swap(trueValue, falseValue);
+    rewriter.replaceOpWithNewOp<FusedOp>(
+        selectOp, selectOp.getResult().getType(), cmpOp.getLhs(),
+        cmpOp.getRhs(), trueValue, falseValue);
+    return success();
+  }
+};
+
+// %0 = vm.cmp.nz.i32 %a : i32
+// %1 = vm.select.i32 %0, %x, %y : i32
+// ->
+// %1 = vm.select.i32 %a, %x, %y : i32
+//
+// The select condition is already tested for non-zero so the cmp.nz is
+// redundant.
+template <class SelectOp, class CmpNZOp>
+struct ElideCmpNZSelectOp : public OpRewritePattern<SelectOp> {
+  using OpRewritePattern<SelectOp>::OpRewritePattern;
+  LogicalResult matchAndRewrite(SelectOp selectOp,
+                                PatternRewriter &rewriter) const override {
+    auto cmpOp =
+        dyn_cast_or_null<CmpNZOp>(selectOp.getCondition().getDefiningOp());
+    if (!cmpOp) return failure();
+    if (cmpOp.getOperand().getType() != selectOp.getCondition().getType()) {
+      return failure();
+    }
+    rewriter.modifyOpInPlace(selectOp, [&]() {
+      selectOp.getConditionMutable().assign(cmpOp.getOperand());
+    });
+    return success();
+  }
+};
+
+} // namespace
+
+class FuseOpsPass
+    : public PassWrapper<FuseOpsPass, OperationPass<IREE::VM::ModuleOp>> {
+public:
+  void getDependentDialects(DialectRegistry &registry) const override {
+    registry.insert<IREE::VM::VMDialect>();
+  }
+
+  StringRef getArgument() const override { return "iree-vm-fuse-ops"; }
+
+  StringRef getDescription() const override {
+    return "Fuses common VM op pairs into superinstructions.";
+  }
+
+  void runOnOperation() override {
+    auto *context = &getContext();
+    RewritePatternSet patterns(context);
+    patterns.insert<
+        FuseCmpSelectOp<SelectI32Op, CmpEQI32Op, SelectEQI32Op>,
+        FuseCmpSelectOp<SelectI64Op, CmpEQI64Op, SelectEQI64Op>,
+        FuseCmpSelectOp<SelectI32Op, CmpNEI32Op, SelectEQI32Op, true>,
+        FuseCmpSelectOp<SelectI64Op, CmpNEI64Op, SelectEQI64Op, true>,
+        FuseCmpSelectOp<SelectI32Op, CmpLTI32SOp, SelectLTI32SOp>,
+        FuseCmpSelectOp<SelectI64Op, CmpLTI64SOp, SelectLTI64SOp>,
+        FuseCmpSelectOp<SelectI32Op, CmpLTI32UOp, SelectLTI32UOp>,
+        FuseCmpSelectOp<SelectI64Op, CmpLTI64UOp, SelectLTI64UOp>,
+        ElideCmpNZSelectOp<SelectI32Op, CmpNZI32Op>,
+        ElideCmpNZSelectOp<SelectI64Op, CmpNZI32Op>>(context);
+    if (failed(applyPatternsAndFoldGreedily(getOperation(),
+                                            std::move(patterns)))) {
+      return signalPassFailure();
+    }
+  }
+};
+
+std::unique_ptr<OperationPass<IREE::VM::ModuleOp>> createFuseOpsPass() {
+  return std::make_unique<FuseOpsPass>();
+}
+
+static PassRegistration<FuseOpsPass> pass;
+
+} // namespace mlir::iree_compiler::IREE::VM
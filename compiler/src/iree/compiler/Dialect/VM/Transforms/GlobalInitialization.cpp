@@ -8,6 +8,8 @@
 #include "iree/compiler/Dialect/VM/IR/VMOps.h"
 #include "iree/compiler/Dialect/VM/Transforms/Passes.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/EquivalenceClasses.h"
+#include "llvm/Support/CommandLine.h"
 #include "mlir/Dialect/Affine/Utils.h"
 #include "mlir/IR/Attributes.h"
 #include "mlir/IR/IRMapping.h"
@@ -21,6 +23,14 @@
 
 namespace mlir::iree_compiler::IREE::VM {
 
+static llvm::cl::opt<bool> clParallelInitializers(
+    "iree-vm-parallel-initializers",
+    llvm::cl::desc("Partitions module initializers into independent groups "
+                   "outlined as __init_N functions that __init calls in "
+                   "sequence; groups have no global data dependencies on each "
+                   "other and may be overlapped by runtimes that support it."),
+    llvm::cl::init(false));
+
 namespace {
 
 // Finds a function with |name| and returns it ready for appending.
@@ -81,6 +91,61 @@ static void exportFuncIfNeeded(IREE::VM::ModuleOp moduleOp,
   moduleBuilder.create<IREE::VM::ExportOp>(funcOp.getLoc(), funcOp);
 }
 
+// Transitive global access footprint of a single vm.initializer.
+struct InitializerFootprint {
+  // Global symbol names loaded/stored anywhere under the initializer,
+  // including through calls to module-internal functions.
+  DenseSet<Attribute> loadedGlobals;
+  DenseSet<Attribute> storedGlobals;
+  // True when the analysis could not resolve a callee and has to assume any
+  // global may be accessed; conflicts with all other initializers.
+  bool hasUnknownAccess = false;
+};
+
+// Accumulates the globals accessed under |rootOp| into |footprint|.
+// Calls to module-internal functions are followed; imports cannot touch
+// module globals and are ignored.
+static void collectGlobalAccesses(Operation *rootOp, SymbolTable &symbolTable,
+                                  DenseSet<Operation *> &visitedFuncs,
+                                  InitializerFootprint &footprint) {
+  rootOp->walk([&](Operation *op) {
+    if (auto loadOp = dyn_cast<IREE::Util::GlobalLoadOpInterface>(op)) {
+      footprint.loadedGlobals.insert(loadOp.getGlobalAttr().getAttr());
+    } else if (auto storeOp =
+                   dyn_cast<IREE::Util::GlobalStoreOpInterface>(op)) {
+      footprint.storedGlobals.insert(storeOp.getGlobalAttr().getAttr());
+    } else if (isa<IREE::VM::CallOp, IREE::VM::CallVariadicOp>(op)) {
+      auto calleeAttr = op->getAttrOfType<FlatSymbolRefAttr>("callee");
+      Operation *calleeOp =
+          calleeAttr ? symbolTable.lookup(calleeAttr.getValue()) : nullptr;
+      if (auto funcOp = dyn_cast_or_null<IREE::VM::FuncOp>(calleeOp)) {
+        if (visitedFuncs.insert(funcOp).second) {
+          collectGlobalAccesses(funcOp, symbolTable, visitedFuncs, footprint);
+        }
+      } else if (!isa_and_nonnull<IREE::VM::ImportOp>(calleeOp)) {
+        footprint.hasUnknownAccess = true;
+      }
+    }
+  });
+}
+
+// Returns true if the two initializers must execute in module order because
+// they may access the same global with at least one of them writing it.
+static bool footprintsConflict(const InitializerFootprint &a,
+                               const InitializerFootprint &b) {
+  if (a.hasUnknownAccess || b.hasUnknownAccess)
+    return true;
+  for (auto global : a.storedGlobals) {
+    if (b.loadedGlobals.contains(global) || b.storedGlobals.contains(global))
+      return true;
+  }
+  for (auto global : b.storedGlobals) {
+    if (a.loadedGlobals.contains(global))
+      return true;
+  }
+  return false;
+}
+
 // Updates the mutability of globals based on whether they are stored anywhere
 // in the program. The mutability here is not for program analysis but because
 // the runtime needs to allocate rwdata for the global instead of embedding it
@@ -160,6 +225,7 @@ public:
     // initialization function.
     InlinerInterface inlinerInterface(&getContext());
     SmallVector<Operation *> deadOps;
+    SmallVector<IREE::VM::InitializerOp> pendingInitializerOps;
     for (auto &op : moduleOp.getBlock().getOperations()) {
       if (auto globalOp = dyn_cast<IREE::VM::GlobalRefOp>(op)) {
       } else if (auto globalOp = dyn_cast<IREE::Util::GlobalOpInterface>(op)) {
@@ -177,6 +243,14 @@ public:
           }
         }
       } else if (auto initializerOp = dyn_cast<IREE::VM::InitializerOp>(op)) {
+        if (clParallelInitializers) {
+          // Deferred below so that initializers with disjoint global
+          // footprints can be partitioned into independent functions. The
+          // initial-value stores emitted above always run first; lowering
+          // guarantees they precede any initializer that uses them.
+          pendingInitializerOps.push_back(initializerOp);
+          continue;
+        }
         if (failed(appendInitializer(initializerOp, inlinerInterface,
                                      initBuilder))) {
           initializerOp.emitOpError() << "unable to be initialized";
@@ -186,6 +260,13 @@ public:
         initBuilder.setInsertionPointToEnd(&initFuncOp.back());
       }
     }
+    if (!pendingInitializerOps.empty()) {
+      if (failed(appendPartitionedInitializers(
+              moduleOp, symbolTable, pendingInitializerOps, inlinerInterface,
+              initFuncOp, initBuilder, deadOps))) {
+        return signalPassFailure();
+      }
+    }
     for (auto *deadOp : deadOps) {
       deadOp->erase();
     }
@@ -204,6 +285,95 @@ public:
   }
 
 private:
+  // Partitions |initializerOps| into groups with pairwise-disjoint global
+  // footprints and outlines each group as a private __init_N function that
+  // __init calls in sequence. Initializers within a group retain module order.
+  // The calls carry no data dependencies on each other so a runtime scheduler
+  // may overlap them; today's serial execution remains correct.
+  LogicalResult appendPartitionedInitializers(
+      IREE::VM::ModuleOp moduleOp, SymbolTable &symbolTable,
+      ArrayRef<IREE::VM::InitializerOp> initializerOps,
+      InlinerInterface &inlinerInterface, IREE::VM::FuncOp initFuncOp,
+      OpBuilder &initBuilder, SmallVectorImpl<Operation *> &deadOps) {
+    SmallVector<InitializerFootprint> footprints;
+    footprints.reserve(initializerOps.size());
+    for (auto initializerOp : initializerOps) {
+      InitializerFootprint footprint;
+      DenseSet<Operation *> visitedFuncs;
+      collectGlobalAccesses(initializerOp, symbolTable, visitedFuncs,
+                            footprint);
+      footprints.push_back(std::move(footprint));
+    }
+
+    // Union initializers that conflict; initializers in different classes
+    // never access the same global with a write involved.
+    llvm::EquivalenceClasses<unsigned> equivalenceClasses;
+    for (unsigned i = 0; i < footprints.size(); ++i) {
+      equivalenceClasses.insert(i);
+    }
+    for (unsigned i = 0; i < footprints.size(); ++i) {
+      for (unsigned j = i + 1; j < footprints.size(); ++j) {
+        if (footprintsConflict(footprints[i], footprints[j])) {
+          equivalenceClasses.unionSets(i, j);
+        }
+      }
+    }
+
+    // Gather groups ordered by their first initializer so output remains
+    // stable with respect to module order.
+    SmallVector<SmallVector<IREE::VM::InitializerOp>> orderedGroups;
+    DenseMap<unsigned, unsigned> leaderToGroup;
+    for (unsigned i = 0; i < footprints.size(); ++i) {
+      unsigned leader = equivalenceClasses.getLeaderValue(i);
+      auto it = leaderToGroup.find(leader);
+      if (it == leaderToGroup.end()) {
+        it = leaderToGroup.insert({leader, orderedGroups.size()}).first;
+        orderedGroups.push_back({});
+      }
+      orderedGroups[it->second].push_back(initializerOps[i]);
+    }
+
+    // With a single group there is nothing to overlap; inline directly into
+    // __init as the default path does.
+    if (orderedGroups.size() == 1) {
+      for (auto initializerOp : orderedGroups.front()) {
+        if (failed(appendInitializer(initializerOp, inlinerInterface,
+                                     initBuilder))) {
+          return initializerOp.emitOpError() << "unable to be initialized";
+        }
+        deadOps.push_back(initializerOp);
+        initBuilder.setInsertionPointToEnd(&initFuncOp.back());
+      }
+      return success();
+    }
+
+    OpBuilder funcModuleBuilder(initFuncOp);
+    for (auto [ordinal, group] : llvm::enumerate(orderedGroups)) {
+      std::string name = ("__init_" + Twine(ordinal)).str();
+      while (SymbolTable::lookupSymbolIn(moduleOp, name)) {
+        name += "_";
+      }
+      auto groupFuncOp = funcModuleBuilder.create<IREE::VM::FuncOp>(
+          initFuncOp.getLoc(), name,
+          funcModuleBuilder.getFunctionType({}, {}));
+      groupFuncOp.setPrivate();
+      auto groupBuilder = OpBuilder::atBlockEnd(groupFuncOp.addEntryBlock());
+      for (auto initializerOp : group) {
+        if (failed(appendInitializer(initializerOp, inlinerInterface,
+                                     groupBuilder))) {
+          return initializerOp.emitOpError() << "unable to be initialized";
+        }
+        deadOps.push_back(initializerOp);
+        groupBuilder.setInsertionPointToEnd(&groupFuncOp.back());
+      }
+      groupBuilder.create<IREE::VM::ReturnOp>(groupFuncOp.getLoc());
+      initBuilder.create<IREE::VM::CallOp>(groupFuncOp.getLoc(),
+                                           groupFuncOp.getSymNameAttr(),
+                                           TypeRange{}, ValueRange{});
+    }
+    return success();
+  }
+
   LogicalResult
   appendPrimitiveInitialization(IREE::Util::GlobalOpInterface globalOp,
                                 OpBuilder &builder) {
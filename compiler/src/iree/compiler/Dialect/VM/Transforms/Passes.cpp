@@ -119,6 +119,14 @@ void buildVMTransformPassPipeline(OpPassManager &passManager,
   passManager.addPass(mlir::createCSEPass());
   passManager.addPass(mlir::createCanonicalizerPass());
 
+  // Fuse common op pairs into superinstructions when targeting runtimes that
+  // support them. This runs after the final canonicalizations as the patterns
+  // want to see the canonical cmp/select forms and the fused ops have no
+  // folders of their own.
+  if (targetOptions.fusedOps) {
+    passManager.addNestedPass<IREE::VM::ModuleOp>(createFuseOpsPass());
+  }
+
   // Now that we've inlined/canonicalized/etc the initializers we can remove
   // them if they are empty to save a few bytes in the binary and avoid a
   // runtime initialization call.
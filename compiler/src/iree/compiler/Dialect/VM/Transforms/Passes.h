@@ -86,6 +86,10 @@ createOrdinalAllocationPass();
 std::unique_ptr<OperationPass<IREE::VM::ModuleOp>>
 createDropEmptyModuleInitializersPass();
 
+// Fuses common op pairs (such as cmp+select) into superinstructions.
+// Modules containing fused ops require a runtime with the fused-ops feature.
+std::unique_ptr<OperationPass<IREE::VM::ModuleOp>> createFuseOpsPass();
+
 // Sinks defining ops with few uses to their use-sites to reduce the total
 // number of live registers at the cost of additional storage requirements.
 std::unique_ptr<OperationPass<IREE::VM::ModuleOp>> createSinkDefiningOpsPass();
@@ -101,6 +105,7 @@ inline void registerVMPasses() {
   createHoistInlinedRodataPass();
   createDeduplicateRodataPass();
   createDropEmptyModuleInitializersPass();
+  createFuseOpsPass();
   createGlobalInitializationPass();
   createOrdinalAllocationPass();
   createResolveRodataLoadsPass();
@@ -0,0 +1,79 @@
+// RUN: iree-opt --split-input-file --iree-vm-fuse-ops %s | FileCheck %s
+
+vm.module @module {
+  // CHECK-LABEL: @fuse_cmp_eq_select_i32
+  vm.func @fuse_cmp_eq_select_i32(%arg0 : i32, %arg1 : i32, %arg2 : i32, %arg3 : i32) -> i32 {
+    // CHECK-NOT: vm.cmp.eq.i32
+    // CHECK: %[[RET:.+]] = vm.select.eq.i32 %arg0, %arg1, %arg2, %arg3 : i32
+    %cmp = vm.cmp.eq.i32 %arg0, %arg1 : i32
+    %0 = vm.select.i32 %cmp, %arg2, %arg3 : i32
+    // CHECK: vm.return %[[RET]]
+    vm.return %0 : i32
+  }
+}
+
+// -----
+
+vm.module @module {
+  // NE has no fused opcode; it maps onto EQ with the values swapped.
+  // CHECK-LABEL: @fuse_cmp_ne_select_i32
+  vm.func @fuse_cmp_ne_select_i32(%arg0 : i32, %arg1 : i32, %arg2 : i32, %arg3 : i32) -> i32 {
+    // CHECK: %[[RET:.+]] = vm.select.eq.i32 %arg0, %arg1, %arg3, %arg2 : i32
+    %cmp = vm.cmp.ne.i32 %arg0, %arg1 : i32
+    %0 = vm.select.i32 %cmp, %arg2, %arg3 : i32
+    vm.return %0 : i32
+  }
+}
+
+// -----
+
+vm.module @module {
+  // CHECK-LABEL: @fuse_cmp_lt_select_i64
+  vm.func @fuse_cmp_lt_select_i64(%arg0 : i64, %arg1 : i64, %arg2 : i64, %arg3 : i64) -> i64 {
+    // CHECK: %[[RET:.+]] = vm.select.lt.i64.s %arg0, %arg1, %arg2, %arg3 : i64
+    %cmp = vm.cmp.lt.i64.s %arg0, %arg1 : i64
+    %0 = vm.select.i64 %cmp, %arg2, %arg3 : i64
+    vm.return %0 : i64
+  }
+}
+
+// -----
+
+vm.module @module {
+  // The cmp result is also used directly and must be preserved.
+  // CHECK-LABEL: @no_fuse_multi_use
+  vm.func @no_fuse_multi_use(%arg0 : i32, %arg1 : i32, %arg2 : i32, %arg3 : i32) -> (i32, i32) {
+    // CHECK: vm.cmp.eq.i32
+    // CHECK: vm.select.i32
+    %cmp = vm.cmp.eq.i32 %arg0, %arg1 : i32
+    %0 = vm.select.i32 %cmp, %arg2, %arg3 : i32
+    vm.return %0, %cmp : i32, i32
+  }
+}
+
+// -----
+
+vm.module @module {
+  // A mixed-width cmp/select pair has no superinstruction.
+  // CHECK-LABEL: @no_fuse_mixed_width
+  vm.func @no_fuse_mixed_width(%arg0 : i32, %arg1 : i32, %arg2 : i64, %arg3 : i64) -> i64 {
+    // CHECK: vm.cmp.eq.i32
+    // CHECK: vm.select.i64
+    %cmp = vm.cmp.eq.i32 %arg0, %arg1 : i32
+    %0 = vm.select.i64 %cmp, %arg2, %arg3 : i64
+    vm.return %0 : i64
+  }
+}
+
+// -----
+
+vm.module @module {
+  // CHECK-LABEL: @elide_cmp_nz_select_i32
+  vm.func @elide_cmp_nz_select_i32(%arg0 : i32, %arg1 : i32, %arg2 : i32) -> i32 {
+    // CHECK-NOT: vm.cmp.nz.i32
+    // CHECK: %[[RET:.+]] = vm.select.i32 %arg0, %arg1, %arg2 : i32
+    %nz = vm.cmp.nz.i32 %arg0 : i32
+    %0 = vm.select.i32 %nz, %arg1, %arg2 : i32
+    vm.return %0 : i32
+  }
+}
@@ -0,0 +1,138 @@
+// RUN: iree-opt --split-input-file --iree-vm-parallel-initializers --pass-pipeline="builtin.module(vm.module(iree-vm-global-initialization))" %s | FileCheck %s
+
+// Tests that initializers with disjoint global footprints are outlined into
+// independent __init_N functions while dependent initializers stay grouped in
+// module order.
+
+// CHECK-LABEL: @partitioned
+vm.module @partitioned {
+  // CHECK: vm.global.i32 private mutable @g0 : i32
+  vm.global.i32 private @g0 : i32
+  vm.initializer {
+    %c123 = vm.const.i32 123
+    vm.global.store.i32 %c123, @g0 : i32
+    vm.return
+  }
+
+  // CHECK: vm.global.ref private mutable @g1 : !vm.ref<?>
+  vm.global.ref private mutable @g1 : !vm.ref<?>
+  vm.initializer {
+    %null = vm.const.ref.zero : !vm.ref<?>
+    vm.global.store.ref %null, @g1 : !vm.ref<?>
+    vm.return
+  }
+
+  // CHECK: vm.global.ref private mutable @g2 : !vm.ref<?>
+  vm.global.ref private mutable @g2 : !vm.ref<?>
+  vm.initializer {
+    %g1 = vm.global.load.ref @g1 : !vm.ref<?>
+    vm.global.store.ref %g1, @g2 : !vm.ref<?>
+    vm.return
+  }
+
+  //      CHECK: vm.func private @__init_0() {
+  // CHECK-NEXT:   %c123 = vm.const.i32 123
+  // CHECK-NEXT:   vm.global.store.i32 %c123, @g0 : i32
+  // CHECK-NEXT:   vm.return
+  // CHECK-NEXT: }
+  //      CHECK: vm.func private @__init_1() {
+  // CHECK-NEXT:   %null = vm.const.ref.zero : !vm.ref<?>
+  // CHECK-NEXT:   vm.global.store.ref %null, @g1 : !vm.ref<?>
+  // CHECK-NEXT:   %g1 = vm.global.load.ref @g1 : !vm.ref<?>
+  // CHECK-NEXT:   vm.global.store.ref %g1, @g2 : !vm.ref<?>
+  // CHECK-NEXT:   vm.return
+  // CHECK-NEXT: }
+  //      CHECK: vm.export @__init
+  // CHECK-NEXT: vm.func private @__init() {
+  // CHECK-NEXT:   vm.call @__init_0() : () -> ()
+  // CHECK-NEXT:   vm.call @__init_1() : () -> ()
+  // CHECK-NEXT:   vm.return
+  // CHECK-NEXT: }
+}
+
+// -----
+
+// Tests that import calls are treated as safe to overlap while calls into
+// module-internal functions contribute their transitive global accesses.
+
+// CHECK-LABEL: @calls
+vm.module @calls {
+  vm.import private @some.import(%arg : i32)
+
+  // CHECK: vm.global.i32 private mutable @g0 : i32
+  vm.global.i32 private @g0 : i32
+  vm.func private @storeG0() {
+    %c7 = vm.const.i32 7
+    vm.global.store.i32 %c7, @g0 : i32
+    vm.return
+  }
+  vm.initializer {
+    vm.call @storeG0() : () -> ()
+    vm.return
+  }
+
+  // Conflicts with the initializer above through @storeG0.
+  vm.initializer {
+    %g0 = vm.global.load.i32 @g0 : i32
+    vm.call @some.import(%g0) : (i32) -> ()
+    vm.return
+  }
+
+  // Independent: only calls an import.
+  // CHECK: vm.global.i32 private mutable @g1 : i32
+  vm.global.i32 private @g1 : i32
+  vm.initializer {
+    %c1 = vm.const.i32 1
+    vm.call @some.import(%c1) : (i32) -> ()
+    vm.global.store.i32 %c1, @g1 : i32
+    vm.return
+  }
+
+  //      CHECK: vm.func private @__init_0() {
+  // CHECK-NEXT:   vm.call @storeG0()
+  // CHECK-NEXT:   %g0 = vm.global.load.i32 @g0 : i32
+  // CHECK-NEXT:   vm.call @some.import(%g0)
+  // CHECK-NEXT:   vm.return
+  // CHECK-NEXT: }
+  //      CHECK: vm.func private @__init_1() {
+  // CHECK-NEXT:   %c1 = vm.const.i32 1
+  // CHECK-NEXT:   vm.call @some.import(%c1)
+  // CHECK-NEXT:   vm.global.store.i32 %c1, @g1 : i32
+  // CHECK-NEXT:   vm.return
+  // CHECK-NEXT: }
+  //      CHECK: vm.func private @__init() {
+  // CHECK-NEXT:   vm.call @__init_0() : () -> ()
+  // CHECK-NEXT:   vm.call @__init_1() : () -> ()
+  // CHECK-NEXT:   vm.return
+  // CHECK-NEXT: }
+}
+
+// -----
+
+// Tests that fully dependent initializers collapse to the serial form with no
+// outlined functions.
+
+// CHECK-LABEL: @serial
+vm.module @serial {
+  // CHECK: vm.global.i32 private mutable @g0 : i32
+  vm.global.i32 private @g0 : i32
+  vm.initializer {
+    %c123 = vm.const.i32 123
+    vm.global.store.i32 %c123, @g0 : i32
+    vm.return
+  }
+  vm.initializer {
+    %g0 = vm.global.load.i32 @g0 : i32
+    vm.global.store.i32 %g0, @g0 : i32
+    vm.return
+  }
+
+  // CHECK-NOT: vm.func private @__init_0
+  //      CHECK: vm.func private @__init() {
+  // CHECK-NEXT:   %c123 = vm.const.i32 123
+  // CHECK-NEXT:   vm.global.store.i32 %c123, @g0 : i32
+  // CHECK-NEXT:   %g0 = vm.global.load.i32 @g0 : i32
+  // CHECK-NEXT:   vm.global.store.i32 %g0, @g0 : i32
+  // CHECK-NEXT:   vm.return
+  // CHECK-NEXT: }
+}
@@ -436,6 +436,26 @@ vm.import private @mmt4d(
   %flags : i32
 )
 
+// Invokes a call site previously resolved with @mmt4d.resolve. Only the
+// per-tile buffer bindings and element offsets vary; everything else comes
+// from the descriptor so the runtime does a single direct ukernel call.
+vm.import private @mmt4d.call(
+  %descriptor : !vm.buffer,
+  %lhs_buffer : !vm.buffer,
+  %lhs_offset : i64,
+  %rhs_buffer : !vm.buffer,
+  %rhs_offset : i64,
+  %out_buffer : !vm.buffer,
+  %out_offset : i64
+)
+
+// Resolves a packed mmt4d call-site configuration (emitted as rodata) into an
+// opaque descriptor buffer. Intended to run once per call site at
+// initialization; the descriptor is then passed to @mmt4d.call per tile.
+vm.import private @mmt4d.resolve(
+  %config : !vm.buffer
+) -> !vm.buffer
+
 //==============================================================================
 // pack ops
 //==============================================================================
@@ -0,0 +1,203 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===--- BucketizeDynamicShapes.cpp ---------------------------------------===//
+// Clones exported entry points into shape-specialized variants for a set of
+// bucket sizes and turns the original export into a thin dispatcher that
+// selects a variant at runtime. Each variant pins the bucketed dimension to a
+// constant so the whole program under it compiles as static-shape code, while
+// the exported function name and signature stay unchanged.
+//===----------------------------------------------------------------------===//
+
+#include "iree/compiler/Dialect/Util/IR/UtilDialect.h"
+#include "iree/compiler/Dialect/Util/IR/UtilOps.h"
+#include "iree/compiler/GlobalOptimization/PassDetail.h"
+#include "iree/compiler/GlobalOptimization/Passes.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/Debug.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/SymbolTable.h"
+#include "mlir/Pass/Pass.h"
+
+#define DEBUG_TYPE "iree-global-opt-bucketize-dynamic-shapes"
+
+namespace mlir::iree_compiler::GlobalOptimization {
+namespace {
+
+// Location of the dimension the dispatcher keys on: argument |argIndex| of the
+// entry point, tensor dimension |dimIndex|.
+struct BucketedDim {
+  unsigned argIndex = 0;
+  unsigned dimIndex = 0;
+};
+
+// Returns the dimension to bucket on: the first dynamic dimension of the
+// first dynamically-shaped tensor argument. Entry points typically carry the
+// data-dependent dimension (batch/sequence length) on their leading operand,
+// and a single keyed dimension keeps the dispatcher to one comparison chain.
+static std::optional<BucketedDim> selectBucketedDim(IREE::Util::FuncOp funcOp) {
+  for (auto [argIndex, argType] :
+       llvm::enumerate(funcOp.getArgumentTypes())) {
+    auto tensorType = dyn_cast<RankedTensorType>(argType);
+    if (!tensorType)
+      continue;
+    for (auto [dimIndex, dimSize] : llvm::enumerate(tensorType.getShape())) {
+      if (ShapedType::isDynamic(dimSize)) {
+        return BucketedDim{static_cast<unsigned>(argIndex),
+                           static_cast<unsigned>(dimIndex)};
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+// Clones |funcOp| as a private function named |name| with the bucketed
+// dimension pinned to |bucketSize| (or left dynamic when nullopt for the
+// generic fallback). Pinning is done by casting the argument to its static
+// type at the top of the entry block; canonicalization folds the casts into
+// consumers so the variant body propagates static shapes.
+static IREE::Util::FuncOp
+cloneVariant(IREE::Util::FuncOp funcOp, BucketedDim bucketedDim,
+             std::optional<int64_t> bucketSize, StringRef name) {
+  OpBuilder moduleBuilder(funcOp);
+  auto variantOp = cast<IREE::Util::FuncOp>(moduleBuilder.clone(*funcOp));
+  SymbolTable::setSymbolName(variantOp, name);
+  variantOp.setPrivate();
+  variantOp->removeAttr("iree.reflection");
+  if (!bucketSize)
+    return variantOp;
+
+  BlockArgument arg = variantOp.getArgument(bucketedDim.argIndex);
+  auto dynamicType = cast<RankedTensorType>(arg.getType());
+  SmallVector<int64_t> staticShape(dynamicType.getShape());
+  staticShape[bucketedDim.dimIndex] = *bucketSize;
+  auto staticType = RankedTensorType::get(staticShape,
+                                          dynamicType.getElementType(),
+                                          dynamicType.getEncoding());
+
+  auto blockBuilder =
+      OpBuilder::atBlockBegin(&variantOp.getFunctionBody().front());
+  Location loc = variantOp.getLoc();
+  Value staticValue =
+      blockBuilder.create<tensor::CastOp>(loc, staticType, arg);
+  Value dynamicValue =
+      blockBuilder.create<tensor::CastOp>(loc, dynamicType, staticValue);
+  arg.replaceAllUsesExcept(dynamicValue, staticValue.getDefiningOp());
+  return variantOp;
+}
+
+// Replaces the body of the exported |funcOp| with a dispatcher that compares
+// the bucketed dimension against each bucket size and calls the matching
+// variant, falling back to the generic clone for out-of-bucket shapes.
+static void buildDispatcher(IREE::Util::FuncOp funcOp, BucketedDim bucketedDim,
+                            ArrayRef<IREE::Util::FuncOp> bucketVariants,
+                            ArrayRef<int64_t> bucketSizes,
+                            IREE::Util::FuncOp genericVariant) {
+  Location loc = funcOp.getLoc();
+  funcOp.getFunctionBody().getBlocks().clear();
+  Block *entryBlock = funcOp.addEntryBlock();
+  auto builder = OpBuilder::atBlockBegin(entryBlock);
+  SmallVector<Value> args(entryBlock->getArguments());
+
+  Value dimIndexValue =
+      builder.create<arith::ConstantIndexOp>(loc, bucketedDim.dimIndex);
+  Value dim = builder.create<tensor::DimOp>(loc, args[bucketedDim.argIndex],
+                                            dimIndexValue);
+
+  scf::IfOp outerIfOp;
+  for (auto [variantOp, bucketSize] :
+       llvm::zip_equal(bucketVariants, bucketSizes)) {
+    Value bucket = builder.create<arith::ConstantIndexOp>(loc, bucketSize);
+    Value cond = builder.create<arith::CmpIOp>(loc, arith::CmpIPredicate::eq,
+                                               dim, bucket);
+    auto ifOp = builder.create<scf::IfOp>(loc, funcOp.getResultTypes(), cond,
+                                          /*addThenBlock=*/true,
+                                          /*addElseBlock=*/true);
+    if (outerIfOp) {
+      builder.create<scf::YieldOp>(loc, ifOp.getResults());
+    } else {
+      outerIfOp = ifOp;
+    }
+    auto thenBuilder = OpBuilder::atBlockBegin(ifOp.thenBlock());
+    auto callOp = thenBuilder.create<IREE::Util::CallOp>(loc, variantOp, args);
+    thenBuilder.create<scf::YieldOp>(loc, callOp.getResults());
+    builder = OpBuilder::atBlockBegin(ifOp.elseBlock());
+  }
+
+  auto fallbackCallOp =
+      builder.create<IREE::Util::CallOp>(loc, genericVariant, args);
+  builder.create<scf::YieldOp>(loc, fallbackCallOp.getResults());
+
+  auto returnBuilder = OpBuilder::atBlockEnd(entryBlock);
+  returnBuilder.create<IREE::Util::ReturnOp>(loc, outerIfOp.getResults());
+}
+
+static void bucketizeEntryPoint(IREE::Util::FuncOp funcOp,
+                                ArrayRef<int64_t> bucketSizes) {
+  std::optional<BucketedDim> bucketedDim = selectBucketedDim(funcOp);
+  if (!bucketedDim)
+    return;
+  LLVM_DEBUG(llvm::dbgs() << "bucketizing @" << funcOp.getName() << " on arg "
+                          << bucketedDim->argIndex << " dim "
+                          << bucketedDim->dimIndex << "\n");
+
+  // The generic fallback keeps the original dynamic body; the exported
+  // function is emptied and rebuilt as the dispatcher below.
+  auto genericVariant =
+      cloneVariant(funcOp, *bucketedDim, /*bucketSize=*/std::nullopt,
+                   (funcOp.getName() + "$generic").str());
+  SmallVector<IREE::Util::FuncOp> bucketVariants;
+  for (int64_t bucketSize : bucketSizes) {
+    bucketVariants.push_back(cloneVariant(
+        funcOp, *bucketedDim, bucketSize,
+        (funcOp.getName() + "$b" + std::to_string(bucketSize)).str()));
+  }
+  buildDispatcher(funcOp, *bucketedDim, bucketVariants, bucketSizes,
+                  genericVariant);
+}
+
+struct BucketizeDynamicShapesPass
+    : public BucketizeDynamicShapesBase<BucketizeDynamicShapesPass> {
+  BucketizeDynamicShapesPass() = default;
+  BucketizeDynamicShapesPass(const BucketizeDynamicShapesPass &pass) {
+    bucketSizes = pass.bucketSizes;
+  }
+  BucketizeDynamicShapesPass(ArrayRef<int64_t> bucketSizes) {
+    this->bucketSizes = bucketSizes;
+  }
+
+  void getDependentDialects(DialectRegistry &registry) const override {
+    registry.insert<arith::ArithDialect, scf::SCFDialect,
+                    tensor::TensorDialect, IREE::Util::UtilDialect>();
+  }
+
+  void runOnOperation() override {
+    if (bucketSizes.empty())
+      return;
+    mlir::ModuleOp moduleOp = getOperation();
+    SmallVector<IREE::Util::FuncOp> entryPoints;
+    for (auto funcOp : moduleOp.getOps<IREE::Util::FuncOp>()) {
+      if (funcOp.isPublic() && !funcOp.isExternal())
+        entryPoints.push_back(funcOp);
+    }
+    SmallVector<int64_t> sizes(bucketSizes.begin(), bucketSizes.end());
+    for (auto funcOp : entryPoints) {
+      bucketizeEntryPoint(funcOp, sizes);
+    }
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<mlir::ModuleOp>>
+createBucketizeDynamicShapesPass(ArrayRef<int64_t> bucketSizes) {
+  return std::make_unique<BucketizeDynamicShapesPass>(bucketSizes);
+}
+
+} // namespace mlir::iree_compiler::GlobalOptimization
@@ -4,10 +4,13 @@
 // See https://llvm.org/LICENSE.txt for license information.
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 
+#include <cmath>
+
 #include "iree/compiler/Dialect/Util/IR/UtilOps.h"
 #include "iree/compiler/GlobalOptimization/PassDetail.h"
 #include "iree/compiler/GlobalOptimization/Passes.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/Format.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/Dialect/Linalg/IR/Linalg.h"
 #include "mlir/Dialect/Linalg/IR/LinalgInterfaces.h"
@@ -21,13 +24,90 @@ namespace mlir::iree_compiler::GlobalOptimization {
 
 namespace {
 
+// Ops carrying this unit attribute keep their f32 inputs regardless of the
+// pass configuration. Frontends use it to pin the numerics of individual ops
+// (attention logits, loss terms) while demoting the rest of a class.
+static const char kKeepF32AttrName[] = "iree.numerics.keep_f32";
+
+// Returns the policy class name for |op| used with the {op-classes} option.
+// Transpose variants demote with their parent class.
+static StringRef getContractionOpClassName(Operation *op) {
+  if (isa<linalg::MatmulOp, linalg::MatmulTransposeAOp,
+          linalg::MatmulTransposeBOp>(op)) {
+    return "matmul";
+  }
+  if (isa<linalg::BatchMatmulOp, linalg::BatchMatmulTransposeAOp,
+          linalg::BatchMatmulTransposeBOp>(op)) {
+    return "batch-matmul";
+  }
+  if (isa<linalg::MatvecOp, linalg::VecmatOp>(op)) {
+    return "matvec";
+  }
+  if (isa<linalg::BatchMatvecOp, linalg::BatchVecmatOp>(op)) {
+    return "batch-matvec";
+  }
+  return "";
+}
+
+// Emits a remark on |linalgOp| estimating the worst-case relative error of
+// demoting its inputs to bf16. Rounding each f32 input contributes at most
+// 2^-9 relative error per operand (bf16 has an 8-bit mantissa); accumulation
+// stays f32 and adds ~K*2^-24 for a reduction of size K.
+static void emitErrorEstimateRemark(linalg::LinalgOp linalgOp) {
+  int64_t reductionSize = 1;
+  bool isStatic = true;
+  SmallVector<int64_t> bounds = linalgOp.getStaticLoopRanges();
+  for (auto [index, iteratorType] :
+       llvm::enumerate(linalgOp.getIteratorTypesArray())) {
+    if (!linalg::isReductionIterator(iteratorType))
+      continue;
+    if (ShapedType::isDynamic(bounds[index])) {
+      isStatic = false;
+      break;
+    }
+    reductionSize *= bounds[index];
+  }
+  InFlightDiagnostic remark = linalgOp.emitRemark();
+  remark << "demoting f32 contraction inputs to bf16: ";
+  if (isStatic) {
+    double estimate =
+        2 * ldexp(1.0, -9) + reductionSize * ldexp(1.0, -24);
+    std::string estimateStr;
+    llvm::raw_string_ostream os(estimateStr);
+    os << llvm::format("%.3e", estimate);
+    remark << "estimated max relative error " << estimateStr
+           << " (input rounding 2*2^-9 + f32 accumulation K*2^-24, K="
+           << reductionSize << ")";
+  } else {
+    remark << "estimated max relative error 2*2^-9 + f32 accumulation "
+              "K*2^-24 with dynamic reduction size K";
+  }
+}
+
 // For narrowable inputs, selects
 struct DemoteContractionInputsToBF16Pattern
     : public OpInterfaceRewritePattern<linalg::ContractionOpInterface> {
-  using OpInterfaceRewritePattern::OpInterfaceRewritePattern;
+  DemoteContractionInputsToBF16Pattern(MLIRContext *context,
+                                       ArrayRef<std::string> opClasses,
+                                       bool emitErrorEstimates)
+      : OpInterfaceRewritePattern(context),
+        opClasses(opClasses.begin(), opClasses.end()),
+        emitErrorEstimates(emitErrorEstimates) {}
   LogicalResult matchAndRewrite(linalg::ContractionOpInterface op,
                                 PatternRewriter &rewriter) const override {
     linalg::LinalgOp linalgOp = cast<linalg::LinalgOp>(op.getOperation());
+    // Per-op opt-out wins over any class-level policy.
+    if (linalgOp->hasAttr(kKeepF32AttrName)) {
+      return failure();
+    }
+    StringRef opClass = getContractionOpClassName(op.getOperation());
+    if (opClass.empty()) {
+      // Not one of the named contraction forms handled below.
+      return failure();
+    }
+    if (!opClasses.empty() && !llvm::is_contained(opClasses, opClass)) {
+      return failure();
+    }
     for (auto operand : linalgOp->getOperands()) {
       auto operandType = dyn_cast<RankedTensorType>(operand.getType());
       if (!operandType ||
@@ -64,6 +144,11 @@ struct DemoteContractionInputsToBF16Pattern
               ->getResults()[0]);
     }
 
+    // The op is replaced below so the estimate has to go out first.
+    if (emitErrorEstimates) {
+      emitErrorEstimateRemark(linalgOp);
+    }
+
     auto replaceOpInputs = [&](auto *typePtr) {
       auto namedOp = cast<std::remove_pointer_t<decltype(typePtr)>>(op);
       rewriter.replaceOpWithNewOp<std::remove_pointer_t<decltype(typePtr)>>(
@@ -97,15 +182,27 @@ struct DemoteContractionInputsToBF16Pattern
 
     return success();
   }
+
+  SmallVector<std::string> opClasses;
+  bool emitErrorEstimates;
 };
 
 class DemoteContractionInputsToBF16Pass
     : public DemoteContractionInputsToBF16Base<
           DemoteContractionInputsToBF16Pass> {
+public:
+  DemoteContractionInputsToBF16Pass() = default;
+  DemoteContractionInputsToBF16Pass(ArrayRef<std::string> opClasses,
+                                    bool emitErrorEstimates) {
+    this->opClasses = opClasses;
+    this->emitErrorEstimates = emitErrorEstimates;
+  }
+
   void runOnOperation() override {
     MLIRContext *context = &getContext();
     RewritePatternSet patterns(context);
-    patterns.insert<DemoteContractionInputsToBF16Pattern>(context);
+    patterns.insert<DemoteContractionInputsToBF16Pattern>(
+        context, llvm::to_vector(opClasses), emitErrorEstimates);
     if (failed(applyPatternsAndFoldGreedily(getOperation(),
                                             std::move(patterns)))) {
       return signalPassFailure();
@@ -119,4 +216,11 @@ std::unique_ptr<Pass> createDemoteContractionInputsToBF16Pass() {
   return std::make_unique<DemoteContractionInputsToBF16Pass>();
 }
 
+std::unique_ptr<Pass>
+createDemoteContractionInputsToBF16Pass(ArrayRef<std::string> opClasses,
+                                        bool emitErrorEstimates) {
+  return std::make_unique<DemoteContractionInputsToBF16Pass>(
+      opClasses, emitErrorEstimates);
+}
+
 } // namespace mlir::iree_compiler::GlobalOptimization
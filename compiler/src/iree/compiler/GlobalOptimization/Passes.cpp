@@ -51,12 +51,44 @@ static llvm::cl::opt<bool> clEnableFuseHorizontalContractions(
         "Enables horizontal fusion of contractions with one common operand"),
     llvm::cl::init(false));
 
+static llvm::cl::opt<bool> clEnableEncodedGlobals(
+    "iree-global-opt-enable-encoded-globals",
+    llvm::cl::desc(
+        "Keeps persistent mutable state (e.g. KV caches) in the data-tiled "
+        "encoded layout across invocations instead of repacking on every "
+        "step. Only takes effect with late materialization since the encoded "
+        "global types must survive until the backends resolve them."),
+    llvm::cl::init(false));
+
+static llvm::cl::list<int64_t> clDynamicShapeBuckets(
+    "iree-global-opt-dynamic-shape-buckets",
+    llvm::cl::desc(
+        "Bucket sizes for specializing dynamically shaped entry points. Each "
+        "exported function is cloned per bucket with the bucketed dimension "
+        "pinned to a constant and dispatched at runtime (experimental)."),
+    llvm::cl::CommaSeparated);
+
 static llvm::cl::opt<bool> clEnableDemoteContractionInputsToBF16(
     "iree-global-opt-enable-demote-contraction-inputs-to-bf16",
     llvm::cl::desc(
         "Demote inputs (LHS, RHS) of linalg matmul-like ops from f32 to bf16."),
     llvm::cl::init(false));
 
+static llvm::cl::list<std::string> clDemoteContractionInputsToBF16OpClasses(
+    "iree-global-opt-demote-contraction-inputs-to-bf16-op-classes",
+    llvm::cl::desc(
+        "Restricts contraction input demotion to the given op classes "
+        "(matmul, batch-matmul, matvec, batch-matvec); empty demotes all. "
+        "Individual ops can opt out with the `iree.numerics.keep_f32` "
+        "attribute."),
+    llvm::cl::CommaSeparated);
+
+static llvm::cl::opt<bool> clDemoteContractionInputsToBF16EmitErrorEstimates(
+    "iree-global-opt-demote-contraction-inputs-to-bf16-emit-error-estimates",
+    llvm::cl::desc("Emits a remark per demoted contraction with a worst-case "
+                   "relative error estimate."),
+    llvm::cl::init(false));
+
 void buildGlobalOptExprHoistingPassPipeline(
     OpPassManager &passManager, const TransformOptions &transformOptions) {
   IREE::Util::ExprHoistingOptions options;
@@ -83,6 +115,13 @@ void buildGlobalOptimizationPassPipeline(
         importParametersOptions));
   }
 
+  // Specialize entry points for the requested shape buckets before any shape
+  // reasoning so every variant optimizes as static-shape code.
+  if (!clDynamicShapeBuckets.empty()) {
+    mainPassManager.addPass(createBucketizeDynamicShapesPass(
+        llvm::to_vector(clDynamicShapeBuckets)));
+  }
+
   // ML frontends have very uneven support for user-controlled types _and_ users
   // tend to use types not well suited for the work they are doing. These
   // demotions/promotions allow users to change the types after lowering out of
@@ -142,8 +181,13 @@ void buildGlobalOptimizationPassPipeline(
       .addPass(IREE::Flow::createFoldUnitExtentDimsPass)
       .addPredicatedPass(clEnableFuseSiluHorizontalMatmul,
                          createFuseSiluHorizontalMatmulPass)
-      .addPredicatedPass(clEnableDemoteContractionInputsToBF16,
-                         createDemoteContractionInputsToBF16Pass)
+      .addPredicatedPass(
+          clEnableDemoteContractionInputsToBF16,
+          [&]() {
+            return createDemoteContractionInputsToBF16Pass(
+                llvm::to_vector(clDemoteContractionInputsToBF16OpClasses),
+                clDemoteContractionInputsToBF16EmitErrorEstimates);
+          })
       .addPass([&]() {
         return createFuseDequantizationMatmulPass(
             clEnableQuantizedMatmulReassociation);
@@ -180,6 +224,9 @@ void buildGlobalOptimizationPassPipeline(
     // because it is an experimental path.
     const int64_t kPadFactor = clEnableEarlyMaterialization ? 0 : 16;
     mainPassManager.addPass(createSetEncodingPass(kPadFactor));
+    if (clEnableEncodedGlobals && !clEnableEarlyMaterialization) {
+      mainPassManager.addPass(createPropagateEncodingsToGlobalsPass());
+    }
     if (clEnableEarlyMaterialization) {
       mainPassManager.addPass(createMaterializeHomogeneousEncodingsPass());
     }
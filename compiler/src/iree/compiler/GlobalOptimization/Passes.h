@@ -40,6 +40,11 @@ void buildGlobalOptimizationPassPipeline(
 // Input canonicalization and legalization
 //===----------------------------------------------------------------------===//
 
+/// Clones exported entry points into shape-specialized variants for each of
+/// |bucketSizes| and rebuilds the export as a runtime dispatcher over them.
+std::unique_ptr<OperationPass<mlir::ModuleOp>>
+createBucketizeDynamicShapesPass(ArrayRef<int64_t> bucketSizes = {});
+
 /// Cleans up any numeric narrowing ops inserted by
 /// iree-global-opt-infer-numeric-narrowing.
 std::unique_ptr<Pass> createCleanupNumericNarrowingPass();
@@ -52,7 +57,15 @@ std::unique_ptr<Pass>
 createDecomposeConcatPass(bool enableConcatTransposition = false);
 
 /// Demotes inputs (LHS, RHS) of linalg matmul-like ops from f32 to bf16.
+/// |opClasses| restricts demotion to the named contraction classes (matmul,
+/// batch-matmul, matvec, batch-matvec); empty demotes all of them. Ops
+/// carrying the `iree.numerics.keep_f32` unit attribute are never demoted.
+/// When |emitErrorEstimates| is set a remark with a worst-case relative error
+/// estimate is emitted per demoted op.
 std::unique_ptr<Pass> createDemoteContractionInputsToBF16Pass();
+std::unique_ptr<Pass>
+createDemoteContractionInputsToBF16Pass(ArrayRef<std::string> opClasses,
+                                        bool emitErrorEstimates);
 
 /// Detaches elementwise ops from named Linalg ops.
 std::unique_ptr<Pass> createDetachElementwiseFromNamedOpsPass();
@@ -96,6 +109,11 @@ createMaterializeHomogeneousEncodingsPass();
 /// iree-global-opt-infer-numeric-narrowing.
 std::unique_ptr<Pass> createOptimizeNumericsPass();
 
+/// Keeps mutable tensor globals in the encoded layout when every access
+/// round-trips through set_encoding/unset_encoding with the same encoding.
+std::unique_ptr<OperationPass<mlir::ModuleOp>>
+createPropagateEncodingsToGlobalsPass();
+
 /// Propagates linalg.transpose ops to a restricted set of operations.
 std::unique_ptr<InterfacePass<mlir::FunctionOpInterface>>
 createPropagateLinalgTransposePass(bool enableAggressivePropagation = false);
@@ -0,0 +1,169 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===--- PropagateEncodingsToGlobals.cpp ----------------------------------===//
+// Rewrites mutable tensor globals to hold their values in the encoded layout
+// when every access round-trips through set_encoding/unset_encoding with the
+// same encoding. Persistent state (e.g. KV caches) then stays data-tiled
+// across invocations instead of being repacked on every step.
+//===----------------------------------------------------------------------===//
+
+#include "iree/compiler/Dialect/Encoding/IR/EncodingDialect.h"
+#include "iree/compiler/Dialect/Encoding/IR/EncodingOps.h"
+#include "iree/compiler/Dialect/Util/IR/UtilDialect.h"
+#include "iree/compiler/Dialect/Util/IR/UtilOps.h"
+#include "iree/compiler/GlobalOptimization/PassDetail.h"
+#include "iree/compiler/GlobalOptimization/Passes.h"
+#include "llvm/Support/Debug.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/Pass/Pass.h"
+
+#define DEBUG_TYPE "iree-global-opt-propagate-encodings-to-globals"
+
+namespace mlir::iree_compiler::GlobalOptimization {
+namespace {
+
+struct GlobalAccesses {
+  IREE::Util::GlobalOpInterface globalOp;
+  bool isIndirect = false;
+  SmallVector<IREE::Util::GlobalLoadOpInterface> loadOps;
+  SmallVector<IREE::Util::GlobalStoreOpInterface> storeOps;
+};
+
+// Returns the encoded tensor type the global can be rewritten to, or nullptr
+// if any access requires the row-major layout. The global is eligible when
+// every loaded value is only consumed by set_encoding ops and every stored
+// value is produced by unset_encoding ops that all agree on a single encoded
+// type; the set/unset ops then cancel against the rewritten global.
+static RankedTensorType getUniformEncodedType(GlobalAccesses &accesses) {
+  RankedTensorType encodedType;
+  auto matchesEncodedType = [&](RankedTensorType type) {
+    if (!type.getEncoding()) {
+      return false;
+    }
+    if (!encodedType) {
+      encodedType = type;
+    }
+    return type == encodedType;
+  };
+  for (auto loadOp : accesses.loadOps) {
+    for (Operation *userOp : loadOp.getLoadedGlobalValue().getUsers()) {
+      auto setEncodingOp = dyn_cast<IREE::Encoding::SetEncodingOp>(userOp);
+      if (!setEncodingOp ||
+          !matchesEncodedType(setEncodingOp.getResultType())) {
+        return nullptr;
+      }
+    }
+  }
+  for (auto storeOp : accesses.storeOps) {
+    auto unsetEncodingOp = storeOp.getStoredGlobalValue()
+                               .getDefiningOp<IREE::Encoding::UnsetEncodingOp>();
+    if (!unsetEncodingOp ||
+        !matchesEncodedType(unsetEncodingOp.getSourceType())) {
+      return nullptr;
+    }
+  }
+  return encodedType;
+}
+
+// Rewrites |globalOp| and all of its accesses to use |encodedType| and erases
+// the set_encoding/unset_encoding ops that bridged the layouts.
+static void propagateEncodingToGlobal(GlobalAccesses &accesses,
+                                      RankedTensorType encodedType) {
+  auto globalOp = accesses.globalOp;
+  LLVM_DEBUG(llvm::dbgs() << "propagating encoding to @"
+                          << globalOp.getGlobalName() << " : " << encodedType
+                          << "\n");
+  globalOp.setGlobalType(encodedType);
+  if (auto initialValue = globalOp.getGlobalInitialValue()) {
+    globalOp.setGlobalInitialValue(IREE::Util::UninitializedAttr::get(
+        globalOp.getContext(), encodedType));
+  }
+  for (auto loadOp : accesses.loadOps) {
+    Value loadedValue = loadOp.getLoadedGlobalValue();
+    loadedValue.setType(encodedType);
+    for (Operation *userOp : llvm::make_early_inc_range(loadedValue.getUsers())) {
+      auto setEncodingOp = cast<IREE::Encoding::SetEncodingOp>(userOp);
+      setEncodingOp.getResult().replaceAllUsesWith(loadedValue);
+      setEncodingOp.erase();
+    }
+  }
+  for (auto storeOp : accesses.storeOps) {
+    auto unsetEncodingOp = storeOp.getStoredGlobalValue()
+                               .getDefiningOp<IREE::Encoding::UnsetEncodingOp>();
+    storeOp.setStoredGlobalValue(unsetEncodingOp.getSource());
+    if (unsetEncodingOp->use_empty()) {
+      unsetEncodingOp.erase();
+    }
+  }
+}
+
+struct PropagateEncodingsToGlobalsPass
+    : public PropagateEncodingsToGlobalsBase<PropagateEncodingsToGlobalsPass> {
+  void getDependentDialects(DialectRegistry &registry) const override {
+    registry.insert<IREE::Encoding::IREEEncodingDialect,
+                    IREE::Util::UtilDialect>();
+  }
+
+  void runOnOperation() override {
+    mlir::ModuleOp moduleOp = getOperation();
+
+    DenseMap<StringRef, GlobalAccesses> globalMap;
+    for (auto globalOp : moduleOp.getOps<IREE::Util::GlobalOpInterface>()) {
+      globalMap[globalOp.getGlobalName()].globalOp = globalOp;
+    }
+    for (auto callableOp : moduleOp.getOps<CallableOpInterface>()) {
+      callableOp.walk([&](Operation *op) {
+        if (auto addressOp =
+                dyn_cast<IREE::Util::GlobalAddressOpInterface>(op)) {
+          globalMap[addressOp.getGlobalName()].isIndirect = true;
+        } else if (auto loadOp =
+                       dyn_cast<IREE::Util::GlobalLoadOpInterface>(op)) {
+          globalMap[loadOp.getGlobalName()].loadOps.push_back(loadOp);
+        } else if (auto storeOp =
+                       dyn_cast<IREE::Util::GlobalStoreOpInterface>(op)) {
+          globalMap[storeOp.getGlobalName()].storeOps.push_back(storeOp);
+        }
+      });
+    }
+
+    for (auto &[globalName, accesses] : globalMap) {
+      auto globalOp = accesses.globalOp;
+      // Only private mutable globals can change layout: the encoded type is
+      // an internal implementation detail and must not leak into the ABI.
+      if (!globalOp || !globalOp.isGlobalPrivate() ||
+          !globalOp.isGlobalMutable() || accesses.isIndirect) {
+        continue;
+      }
+      auto tensorType = dyn_cast<RankedTensorType>(globalOp.getGlobalType());
+      if (!tensorType || !tensorType.hasStaticShape() ||
+          tensorType.getEncoding()) {
+        continue;
+      }
+      // Initial values in the row-major layout cannot be reused; only globals
+      // whose contents are written before being read can change layout.
+      if (auto initialValue = globalOp.getGlobalInitialValue()) {
+        if (!isa<IREE::Util::UninitializedAttr>(initialValue)) {
+          continue;
+        }
+      }
+      RankedTensorType encodedType = getUniformEncodedType(accesses);
+      if (!encodedType) {
+        continue;
+      }
+      propagateEncodingToGlobal(accesses, encodedType);
+    }
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<mlir::ModuleOp>>
+createPropagateEncodingsToGlobalsPass() {
+  return std::make_unique<PropagateEncodingsToGlobalsPass>();
+}
+
+} // namespace mlir::iree_compiler::GlobalOptimization
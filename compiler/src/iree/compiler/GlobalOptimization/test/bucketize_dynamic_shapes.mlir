@@ -0,0 +1,49 @@
+// RUN: iree-opt --split-input-file --iree-global-opt-bucketize-dynamic-shapes=bucket-sizes=128,512 %s | FileCheck %s
+
+util.func public @predict(%arg0: tensor<?x64xf32>) -> tensor<?x64xf32> {
+  %0 = arith.negf %arg0 : tensor<?x64xf32>
+  util.return %0 : tensor<?x64xf32>
+}
+// CHECK-LABEL: util.func private @predict$generic(%{{.+}}: tensor<?x64xf32>)
+//       CHECK:   arith.negf
+//
+//       CHECK: util.func private @predict$b128(%[[ARG128:.+]]: tensor<?x64xf32>)
+//       CHECK:   %[[STATIC128:.+]] = tensor.cast %[[ARG128]] : tensor<?x64xf32> to tensor<128x64xf32>
+//       CHECK:   tensor.cast %[[STATIC128]] : tensor<128x64xf32> to tensor<?x64xf32>
+//
+//       CHECK: util.func private @predict$b512(%[[ARG512:.+]]: tensor<?x64xf32>)
+//       CHECK:   tensor.cast %[[ARG512]] : tensor<?x64xf32> to tensor<512x64xf32>
+//
+//       CHECK: util.func public @predict(%[[ARG:.+]]: tensor<?x64xf32>)
+//   CHECK-DAG:   %[[C0:.+]] = arith.constant 0 : index
+//   CHECK-DAG:   %[[DIM:.+]] = tensor.dim %[[ARG]], %[[C0]]
+//   CHECK-DAG:   %[[C128:.+]] = arith.constant 128 : index
+//       CHECK:   %[[EQ128:.+]] = arith.cmpi eq, %[[DIM]], %[[C128]]
+//       CHECK:   %[[RESULT:.+]] = scf.if %[[EQ128]]
+//       CHECK:     %[[CALL128:.+]] = util.call @predict$b128(%[[ARG]])
+//       CHECK:     scf.yield %[[CALL128]]
+//       CHECK:   } else {
+//       CHECK:     %[[C512:.+]] = arith.constant 512 : index
+//       CHECK:     %[[EQ512:.+]] = arith.cmpi eq, %[[DIM]], %[[C512]]
+//       CHECK:     %[[INNER:.+]] = scf.if %[[EQ512]]
+//       CHECK:       %[[CALL512:.+]] = util.call @predict$b512(%[[ARG]])
+//       CHECK:       scf.yield %[[CALL512]]
+//       CHECK:     } else {
+//       CHECK:       %[[CALLGEN:.+]] = util.call @predict$generic(%[[ARG]])
+//       CHECK:       scf.yield %[[CALLGEN]]
+//       CHECK:     }
+//       CHECK:     scf.yield %[[INNER]]
+//       CHECK:   }
+//       CHECK:   util.return %[[RESULT]]
+
+// -----
+
+// Entry points without a dynamic tensor dimension are left untouched.
+
+util.func public @static(%arg0: tensor<4x64xf32>) -> tensor<4x64xf32> {
+  %0 = arith.negf %arg0 : tensor<4x64xf32>
+  util.return %0 : tensor<4x64xf32>
+}
+// CHECK-LABEL: util.func public @static
+//   CHECK-NOT:   util.call
+//   CHECK-NOT:   scf.if
@@ -0,0 +1,65 @@
+// RUN: iree-opt --split-input-file --iree-global-opt-demote-contraction-inputs-to-bf16="op-classes=matmul" %s | FileCheck %s
+// RUN: iree-opt --split-input-file --iree-global-opt-demote-contraction-inputs-to-bf16="op-classes=matmul emit-error-estimates=true" --verify-diagnostics %s > /dev/null
+
+// Tests that ops in a selected class are demoted and emit an error estimate
+// in the verification mode (K=250 -> 2*2^-9 + 250*2^-24).
+
+util.func public @selected_matmul(%arg0 : tensor<100x250xf32>, %arg1 : tensor<250x500xf32>,
+    %arg2 : tensor<100x500xf32>) -> tensor<100x500xf32> {
+  // expected-remark @+1 {{estimated max relative error 3.921e-03 (input rounding 2*2^-9 + f32 accumulation K*2^-24, K=250)}}
+  %0 = linalg.matmul ins(%arg0, %arg1 : tensor<100x250xf32>, tensor<250x500xf32>)
+      outs(%arg2 : tensor<100x500xf32>) -> tensor<100x500xf32>
+  util.return %0 : tensor<100x500xf32>
+}
+
+// CHECK: @selected_matmul
+// CHECK-COUNT-2: arith.truncf {{.*}} : f32 to bf16
+// CHECK: linalg.matmul
+// CHECK-SAME: tensor<100x250xbf16>, tensor<250x500xbf16>
+
+// -----
+
+// Tests that a dynamic reduction size still reports the error form.
+
+util.func public @selected_dynamic_matmul(%arg0 : tensor<?x?xf32>, %arg1 : tensor<?x?xf32>,
+    %arg2 : tensor<?x?xf32>) -> tensor<?x?xf32> {
+  // expected-remark @+1 {{estimated max relative error 2*2^-9 + f32 accumulation K*2^-24 with dynamic reduction size K}}
+  %0 = linalg.matmul ins(%arg0, %arg1 : tensor<?x?xf32>, tensor<?x?xf32>)
+      outs(%arg2 : tensor<?x?xf32>) -> tensor<?x?xf32>
+  util.return %0 : tensor<?x?xf32>
+}
+
+// CHECK: @selected_dynamic_matmul
+// CHECK-COUNT-2: arith.truncf {{.*}} : f32 to bf16
+
+// -----
+
+// Tests that classes outside the policy keep their f32 inputs.
+
+util.func public @unselected_matvec(%arg0 : tensor<100x250xf32>, %arg1 : tensor<250xf32>,
+    %arg2 : tensor<100xf32>) -> tensor<100xf32> {
+  %0 = linalg.matvec ins(%arg0, %arg1 : tensor<100x250xf32>, tensor<250xf32>)
+      outs(%arg2 : tensor<100xf32>) -> tensor<100xf32>
+  util.return %0 : tensor<100xf32>
+}
+
+// CHECK: @unselected_matvec
+// CHECK-NOT: arith.truncf
+// CHECK: linalg.matvec
+// CHECK-SAME: tensor<100x250xf32>, tensor<250xf32>
+
+// -----
+
+// Tests that the per-op opt-out attribute wins over the class policy.
+
+util.func public @pinned_matmul(%arg0 : tensor<100x250xf32>, %arg1 : tensor<250x500xf32>,
+    %arg2 : tensor<100x500xf32>) -> tensor<100x500xf32> {
+  %0 = linalg.matmul {iree.numerics.keep_f32} ins(%arg0, %arg1 : tensor<100x250xf32>, tensor<250x500xf32>)
+      outs(%arg2 : tensor<100x500xf32>) -> tensor<100x500xf32>
+  util.return %0 : tensor<100x500xf32>
+}
+
+// CHECK: @pinned_matmul
+// CHECK-NOT: arith.truncf
+// CHECK: linalg.matmul
+// CHECK-SAME: tensor<100x250xf32>, tensor<250x500xf32>
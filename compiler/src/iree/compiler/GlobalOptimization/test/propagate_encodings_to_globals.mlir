@@ -0,0 +1,67 @@
+// RUN: iree-opt --split-input-file --iree-global-opt-propagate-encodings-to-globals %s | FileCheck %s
+
+#encoding = #iree_encoding.encoding<role = LHS, element_types = [f32, f32, f32], round_dims_to = array<i64: 16, 16, 16>>
+util.global private mutable @kv_cache = #util.uninitialized : tensor<128x256xf32>
+util.func public @encoded_round_trip(%arg0: tensor<128x256xf32, #encoding>) -> tensor<128x256xf32, #encoding> {
+  %0 = util.global.load @kv_cache : tensor<128x256xf32>
+  %1 = iree_encoding.set_encoding %0 : tensor<128x256xf32> -> tensor<128x256xf32, #encoding>
+  %2 = iree_encoding.unset_encoding %arg0 : tensor<128x256xf32, #encoding> -> tensor<128x256xf32>
+  util.global.store %2, @kv_cache : tensor<128x256xf32>
+  util.return %1 : tensor<128x256xf32, #encoding>
+}
+// CHECK-DAG: #[[$ENCODING:.+]] = #iree_encoding.encoding<role = LHS
+//     CHECK: util.global private mutable @kv_cache = #util.uninitialized : tensor<128x256xf32, #[[$ENCODING]]>
+//     CHECK: util.func public @encoded_round_trip(%[[ARG0:.+]]: tensor<128x256xf32, #[[$ENCODING]]>)
+//     CHECK:   %[[LOAD:.+]] = util.global.load @kv_cache : tensor<128x256xf32, #[[$ENCODING]]>
+// CHECK-NOT:   iree_encoding.set_encoding
+// CHECK-NOT:   iree_encoding.unset_encoding
+//     CHECK:   util.global.store %[[ARG0]], @kv_cache : tensor<128x256xf32, #[[$ENCODING]]>
+//     CHECK:   util.return %[[LOAD]]
+
+// -----
+
+// Loads consumed outside of set_encoding keep the global in row-major layout.
+
+#encoding = #iree_encoding.encoding<role = LHS, element_types = [f32, f32, f32], round_dims_to = array<i64: 16, 16, 16>>
+util.global private mutable @mixed_use : tensor<128x256xf32>
+util.func public @row_major_consumer(%arg0: tensor<128x256xf32, #encoding>) -> (tensor<128x256xf32, #encoding>, tensor<128x256xf32>) {
+  %0 = util.global.load @mixed_use : tensor<128x256xf32>
+  %1 = iree_encoding.set_encoding %0 : tensor<128x256xf32> -> tensor<128x256xf32, #encoding>
+  %2 = iree_encoding.unset_encoding %arg0 : tensor<128x256xf32, #encoding> -> tensor<128x256xf32>
+  util.global.store %2, @mixed_use : tensor<128x256xf32>
+  util.return %1, %0 : tensor<128x256xf32, #encoding>, tensor<128x256xf32>
+}
+// CHECK: util.global private mutable @mixed_use : tensor<128x256xf32>
+// CHECK: iree_encoding.set_encoding
+// CHECK: iree_encoding.unset_encoding
+
+// -----
+
+// Stores that disagree on the encoding keep the global in row-major layout.
+
+#encoding_lhs = #iree_encoding.encoding<role = LHS, element_types = [f32, f32, f32], round_dims_to = array<i64: 16, 16, 16>>
+#encoding_rhs = #iree_encoding.encoding<role = RHS, element_types = [f32, f32, f32], round_dims_to = array<i64: 16, 16, 16>>
+util.global private mutable @conflicting : tensor<128x256xf32>
+util.func public @conflicting_encodings(%arg0: tensor<128x256xf32, #encoding_lhs>, %arg1: tensor<128x256xf32, #encoding_rhs>) {
+  %0 = iree_encoding.unset_encoding %arg0 : tensor<128x256xf32, #encoding_lhs> -> tensor<128x256xf32>
+  util.global.store %0, @conflicting : tensor<128x256xf32>
+  %1 = iree_encoding.unset_encoding %arg1 : tensor<128x256xf32, #encoding_rhs> -> tensor<128x256xf32>
+  util.global.store %1, @conflicting : tensor<128x256xf32>
+  util.return
+}
+// CHECK: util.global private mutable @conflicting : tensor<128x256xf32>
+
+// -----
+
+// Globals with materialized initial values cannot change layout.
+
+#encoding = #iree_encoding.encoding<role = LHS, element_types = [f32, f32, f32], round_dims_to = array<i64: 16, 16, 16>>
+util.global private mutable @initialized = dense<0.0> : tensor<128x256xf32>
+util.func public @initialized_global(%arg0: tensor<128x256xf32, #encoding>) -> tensor<128x256xf32, #encoding> {
+  %0 = util.global.load @initialized : tensor<128x256xf32>
+  %1 = iree_encoding.set_encoding %0 : tensor<128x256xf32> -> tensor<128x256xf32, #encoding>
+  %2 = iree_encoding.unset_encoding %arg0 : tensor<128x256xf32, #encoding> -> tensor<128x256xf32>
+  util.global.store %2, @initialized : tensor<128x256xf32>
+  util.return %1 : tensor<128x256xf32, #encoding>
+}
+// CHECK: util.global private mutable @initialized = dense<0.000000e+00> : tensor<128x256xf32>
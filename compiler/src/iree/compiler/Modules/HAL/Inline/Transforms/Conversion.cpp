@@ -8,6 +8,7 @@
 #include "iree/compiler/Dialect/HAL/Conversion/TypeConverter.h"
 #include "iree/compiler/Dialect/HAL/Conversion/UtilToHAL/Patterns.h"
 #include "iree/compiler/Dialect/HAL/IR/HALDialect.h"
+#include "iree/compiler/Dialect/Stream/IR/StreamDialect.h"
 #include "iree/compiler/Dialect/Util/Conversion/ConversionPatterns.h"
 #include "iree/compiler/Dialect/Util/IR/UtilDialect.h"
 #include "iree/compiler/Modules/HAL/Inline/Conversion/HALToHALInline/Patterns.h"
@@ -89,6 +90,22 @@ public:
           << "conversion to the hal_inline dialect failed";
       return signalPassFailure();
     }
+
+    // Partial conversion leaves ops with no registered pattern untouched;
+    // stream ops that survive (collectives, etc) have no inline HAL
+    // equivalent and would otherwise only fail much later during VM
+    // conversion. Name each one here so it's clear exactly which op is
+    // forcing a program onto the full HAL implementation.
+    bool hasRemainingStreamOps = false;
+    getOperation()->walk([&](Operation *op) {
+      if (isa_and_nonnull<IREE::Stream::StreamDialect>(op->getDialect())) {
+        op->emitOpError() << "has no inline HAL equivalent; the program "
+                             "requires the full HAL implementation";
+        hasRemainingStreamOps = true;
+      }
+    });
+    if (hasRemainingStreamOps)
+      return signalPassFailure();
   }
 };
 
@@ -0,0 +1,24 @@
+// RUN: iree-opt --split-input-file --iree-hal-inline-conversion %s --verify-diagnostics | FileCheck %s
+
+// Tests that supported stream ops are fully converted into the hal_inline
+// dialect (here timepoints become placeholder ints that later get DCE'd).
+
+// CHECK-LABEL: @supportedOps
+util.func public @supportedOps() -> !stream.timepoint {
+  // CHECK: %[[TIMEPOINT:.+]] = arith.constant 0 : i64
+  %0 = stream.timepoint.immediate => !stream.timepoint
+  // CHECK: util.return %[[TIMEPOINT]]
+  util.return %0 : !stream.timepoint
+}
+
+// -----
+
+// Tests that stream ops with no inline HAL lowering (collectives and friends)
+// are called out by name instead of silently surviving to fail during VM
+// conversion.
+
+util.func public @unsupportedCollectives(%rank: index, %count: index) {
+  // expected-error @+1 {{has no inline HAL equivalent}}
+  %channel = stream.channel.create rank(%rank) count(%count) : !stream.channel
+  util.return
+}
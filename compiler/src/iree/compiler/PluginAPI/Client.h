@@ -10,6 +10,7 @@
 #include <functional>
 #include <optional>
 #include <string_view>
+#include <vector>
 
 #include "iree/compiler/Pipelines/Options.h"
 #include "iree/compiler/Utils/OptionUtils.h"
@@ -81,6 +82,26 @@ public:
 
   // Adds passes to the |buildPreprocessingPassPipeline| pipeline at the end.
   virtual void extendPreprocessingPassPipeline(OpPassManager &passManager) {}
+
+  // A custom kernel substitution contributed by a plugin: a PDL pattern file
+  // rewriting matched ops into calls to hand-written kernels (external
+  // util.func calls or hal.executable.source dispatches). Substitutions are
+  // applied during preprocessing in decreasing |priority| order and only when
+  // compiling for |targetBackend| (empty matches all targets). Shape and type
+  // requirements are expressed as pattern constraints; ops that fail them are
+  // left to the default lowering.
+  struct KernelSubstitution {
+    // Path to a file containing the PDL pattern module.
+    std::string patternsFile;
+    // HAL target backend name the kernels are written for, or empty.
+    std::string targetBackend;
+    // Substitutions with higher priority are applied first.
+    int priority = 0;
+  };
+
+  // Adds kernel substitutions to apply during preprocessing.
+  virtual void
+  populateKernelSubstitutions(std::vector<KernelSubstitution> &substitutions) {}
 };
 
 // Policy for how to activate the plugin.
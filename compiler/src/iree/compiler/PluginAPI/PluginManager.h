@@ -133,6 +133,13 @@ public:
     }
   }
 
+  void populateKernelSubstitutions(
+      std::vector<KernelSubstitution> &substitutions) override {
+    for (auto *s : initializedSessions) {
+      s->populateKernelSubstitutions(substitutions);
+    }
+  }
+
   // Populates the given list of HAL target devices for all initialized
   // plugins.
   void populateHALTargetDevices(IREE::HAL::TargetDeviceList &list);
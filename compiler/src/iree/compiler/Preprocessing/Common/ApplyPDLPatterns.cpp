@@ -9,6 +9,7 @@
 #include "iree/compiler/Codegen/Dialect/Codegen/IR/IREECodegenDialect.h"
 #include "iree/compiler/Codegen/Dialect/Codegen/IR/IREECodegenOps.h"
 #include "iree/compiler/Dialect/Flow/IR/FlowOps.h"
+#include "iree/compiler/Dialect/HAL/IR/HALTypes.h"
 #include "iree/compiler/Dialect/Stream/IR/StreamOps.h"
 #include "iree/compiler/Dialect/Util/IR/UtilDialect.h"
 #include "llvm/Support/Debug.h"
@@ -556,8 +557,26 @@ public:
       return;
     }
 
-    // Apply the patterns.
     auto operation = getOperation();
+
+    // Pattern files registered for a specific backend (hand-written kernel
+    // substitutions) only apply when one of the assigned devices can execute
+    // them; otherwise the ops keep their default lowering.
+    if (!targetBackend.empty()) {
+      auto executableTargets =
+          IREE::HAL::DeviceTargetAttr::lookupExecutableTargets(operation);
+      bool hasMatchingTarget =
+          llvm::any_of(executableTargets,
+                       [&](IREE::HAL::ExecutableTargetAttr executableTarget) {
+                         return executableTarget.getBackend().getValue() ==
+                                targetBackend;
+                       });
+      if (!hasMatchingTarget) {
+        return;
+      }
+    }
+
+    // Apply the patterns.
     if (failed(applyPatternsAndFoldGreedily(operation, patterns))) {
       operation->emitOpError("failed to apply patterns specified in ")
           << patternsFile;
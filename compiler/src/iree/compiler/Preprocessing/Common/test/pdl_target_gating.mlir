@@ -0,0 +1,40 @@
+// RUN: iree-opt --split-input-file --pass-pipeline="builtin.module(iree-preprocessing-apply-pdl-patterns{patterns-file=%p/pdl_patterns.mlir target-backend=llvm-cpu})" %s | FileCheck %s
+
+// Patterns registered for a backend apply when a matching executable target
+// is assigned to the module.
+
+#executable_target = #hal.executable.target<"llvm-cpu", "embedded-elf-x86_64">
+// CHECK-LABEL: @matching_target
+module @matching_target attributes {
+  hal.device.targets = [#hal.device.target<"llvm-cpu", [#executable_target]>]
+} {
+  func.func @two_div_one_mul(%arg0: f32, %arg1: f32, %arg2: f32, %arg3: f32) -> f32 {
+    // CHECK: arith.mulf
+    // CHECK: arith.mulf
+    // CHECK: arith.divf
+    %0 = arith.divf %arg0, %arg1 : f32
+    %1 = arith.divf %arg2, %arg3 : f32
+    %2 = arith.mulf %0, %1 : f32
+    return %2 : f32
+  }
+}
+
+// -----
+
+// ...and are skipped when no assigned device can execute the kernels.
+
+#executable_target = #hal.executable.target<"vmvx", "vmvx-bytecode-fb">
+// CHECK-LABEL: @other_target
+module @other_target attributes {
+  hal.device.targets = [#hal.device.target<"vmvx", [#executable_target]>]
+} {
+  func.func @two_div_one_mul(%arg0: f32, %arg1: f32, %arg2: f32, %arg3: f32) -> f32 {
+    // CHECK: arith.divf
+    // CHECK: arith.divf
+    // CHECK: arith.mulf
+    %0 = arith.divf %arg0, %arg1 : f32
+    %1 = arith.divf %arg2, %arg3 : f32
+    %2 = arith.mulf %0, %1 : f32
+    return %2 : f32
+  }
+}
@@ -74,6 +74,26 @@ void buildPreprocessingPassPipeline(
 
   if (pipelineExtensions) {
     pipelineExtensions->extendPreprocessingPassPipeline(passManager);
+
+    // Apply plugin-contributed kernel substitutions in decreasing priority
+    // order. Each substitution runs as its own pattern application pass gated
+    // on its declared target backend; ops whose pattern constraints don't
+    // match fall through to the default lowering.
+    std::vector<PipelineExtensions::KernelSubstitution> substitutions;
+    pipelineExtensions->populateKernelSubstitutions(substitutions);
+    llvm::stable_sort(substitutions, [](const auto &lhs, const auto &rhs) {
+      return lhs.priority > rhs.priority;
+    });
+    for (auto &substitution : substitutions) {
+      Preprocessing::ApplyPDLPatternsPassOptions options;
+      options.patternsFile = substitution.patternsFile;
+      options.targetBackend = substitution.targetBackend;
+      passManager.addPass(Preprocessing::createApplyPDLPatternsPass(options));
+    }
+    if (!substitutions.empty()) {
+      passManager.addPass(createCanonicalizerPass());
+      passManager.addPass(createCSEPass());
+    }
   }
 
   if (!preprocessingOptions.preprocessingTransformSpecFilename.empty()) {
@@ -0,0 +1,201 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/compiler/Utils/PassTelemetry.h"
+
+#include "llvm/ADT/MapVector.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/raw_ostream.h"
+#include "mlir/IR/Operation.h"
+#include "mlir/IR/SymbolTable.h"
+#include "mlir/Pass/Pass.h"
+
+static llvm::cl::opt<std::string> clTelemetryPath(
+    "iree-compile-telemetry-path",
+    llvm::cl::desc("Writes per-pass wall time, IR size, and heap usage "
+                   "telemetry as a JSON artifact to the given path "
+                   "(empty = disabled)."),
+    llvm::cl::init(""));
+
+static llvm::cl::opt<int64_t> clCompileBudgetMs(
+    "iree-compile-budget-ms",
+    llvm::cl::desc("Flags executables whose cumulative pass time exceeds the "
+                   "given budget in milliseconds (0 = disabled). Requires "
+                   "--iree-compile-telemetry-path."),
+    llvm::cl::init(0));
+
+namespace mlir::iree_compiler {
+
+//===----------------------------------------------------------------------===//
+// PassTelemetryCollector
+//===----------------------------------------------------------------------===//
+
+PassTelemetryCollector::PassTelemetryCollector(std::string outputPath,
+                                              int64_t budgetMs)
+    : outputPath(std::move(outputPath)), budgetMs(budgetMs) {}
+
+PassTelemetryCollector::~PassTelemetryCollector() { flush(); }
+
+std::shared_ptr<PassTelemetryCollector> PassTelemetryCollector::getFromFlags() {
+  if (clTelemetryPath.empty())
+    return nullptr;
+  static std::shared_ptr<PassTelemetryCollector> collector =
+      std::make_shared<PassTelemetryCollector>(clTelemetryPath,
+                                               clCompileBudgetMs);
+  return collector;
+}
+
+void PassTelemetryCollector::record(llvm::StringRef passName,
+                                    llvm::StringRef scope, double timeMs,
+                                    int64_t opsBefore, int64_t opsAfter,
+                                    int64_t mallocDeltaBytes) {
+  std::lock_guard<std::mutex> lock(mutex);
+  records.push_back({passName.str(), scope.str(), timeMs, opsBefore, opsAfter,
+                     mallocDeltaBytes});
+}
+
+void PassTelemetryCollector::flush() {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (outputPath.empty() || records.empty())
+    return;
+
+  // Aggregate total time and retained heap per pass name and per scope.
+  // MapVector keeps the first-seen order so the artifact reads in rough
+  // pipeline order.
+  llvm::MapVector<llvm::StringRef, double> passTotals;
+  llvm::MapVector<llvm::StringRef, double> scopeTotals;
+  llvm::MapVector<llvm::StringRef, int64_t> passMallocTotals;
+  for (auto &record : records) {
+    passTotals[record.passName] += record.timeMs;
+    scopeTotals[record.scope] += record.timeMs;
+    passMallocTotals[record.passName] += record.mallocDeltaBytes;
+  }
+
+  llvm::json::Array passArray;
+  for (auto &record : records) {
+    passArray.push_back(llvm::json::Object{
+        {"pass", record.passName},
+        {"scope", record.scope},
+        {"time_ms", record.timeMs},
+        {"ops_before", record.opsBefore},
+        {"ops_after", record.opsAfter},
+        {"malloc_delta_bytes", record.mallocDeltaBytes},
+    });
+  }
+  llvm::json::Object passTotalsObject;
+  for (auto &[passName, timeMs] : passTotals)
+    passTotalsObject[passName] = timeMs;
+  llvm::json::Object scopeTotalsObject;
+  for (auto &[scope, timeMs] : scopeTotals)
+    scopeTotalsObject[scope] = timeMs;
+  llvm::json::Object passMallocTotalsObject;
+  for (auto &[passName, deltaBytes] : passMallocTotals)
+    passMallocTotalsObject[passName] = deltaBytes;
+
+  std::error_code ec;
+  llvm::raw_fd_ostream os(outputPath, ec, llvm::sys::fs::OF_Text);
+  if (ec) {
+    llvm::errs() << "warning: failed to write compile telemetry to '"
+                 << outputPath << "': " << ec.message() << "\n";
+    return;
+  }
+  os << llvm::formatv("{0:2}",
+                      llvm::json::Value(llvm::json::Object{
+                          {"passes", std::move(passArray)},
+                          {"pass_totals_ms", std::move(passTotalsObject)},
+                          {"scope_totals_ms", std::move(scopeTotalsObject)},
+                          {"pass_malloc_delta_bytes",
+                           std::move(passMallocTotalsObject)},
+                      }))
+     << "\n";
+
+  // Flag executables blowing the compile budget; the scope breadcrumb names
+  // the hal.executable symbol the time was spent under.
+  if (budgetMs > 0) {
+    for (auto &[scope, timeMs] : scopeTotals) {
+      if (!scope.contains("hal.executable"))
+        continue;
+      if (timeMs > static_cast<double>(budgetMs)) {
+        llvm::errs() << "warning: compile budget exceeded: " << scope
+                     << " took " << llvm::format("%.1f", timeMs)
+                     << "ms (budget " << budgetMs << "ms)\n";
+      }
+    }
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// PassTelemetry (PassInstrumentation)
+//===----------------------------------------------------------------------===//
+
+namespace {
+struct ActivePassFrame {
+  std::chrono::steady_clock::time_point start;
+  int64_t opsBefore;
+  int64_t mallocBefore;
+};
+// Pass callbacks nest per-thread (pipelines run passes on different ops
+// concurrently) so each thread keeps its own frame stack.
+thread_local llvm::SmallVector<ActivePassFrame, 8> telemetryFrameStack;
+} // namespace
+
+static int64_t countOps(Operation *op) {
+  int64_t count = 0;
+  op->walk([&](Operation *) { ++count; });
+  return count;
+}
+
+static std::string getScopeBreadcrumb(Operation *op) {
+  std::string storage;
+  llvm::raw_string_ostream os(storage);
+  SmallVector<Operation *> chain;
+  for (Operation *ancestor = op; ancestor;
+       ancestor = ancestor->getParentOp()) {
+    chain.push_back(ancestor);
+  }
+  for (Operation *ancestor : llvm::reverse(chain)) {
+    if (ancestor != chain.back())
+      os << " > ";
+    os << ancestor->getName();
+    if (auto symbolOp = dyn_cast<SymbolOpInterface>(ancestor))
+      os << " @" << symbolOp.getName();
+  }
+  return storage;
+}
+
+// Returns the current process malloc usage or 0 on platforms where LLVM
+// cannot report it. Deltas computed from this are attributed to whichever
+// pass is active on this thread; concurrent passes on other threads add
+// noise but the aggregate across a compile still ranks retainers usefully.
+static int64_t getMallocBytes() {
+  return static_cast<int64_t>(llvm::sys::Process::GetMallocUsage());
+}
+
+void PassTelemetry::runBeforePass(Pass *pass, Operation *op) {
+  telemetryFrameStack.push_back(
+      {std::chrono::steady_clock::now(), countOps(op), getMallocBytes()});
+}
+
+void PassTelemetry::runAfterPass(Pass *pass, Operation *op) {
+  auto frame = telemetryFrameStack.pop_back_val();
+  double timeMs = std::chrono::duration<double, std::milli>(
+                      std::chrono::steady_clock::now() - frame.start)
+                      .count();
+  collector->record(pass->getName(), getScopeBreadcrumb(op), timeMs,
+                    frame.opsBefore, countOps(op),
+                    getMallocBytes() - frame.mallocBefore);
+}
+
+void PassTelemetry::runAfterPassFailed(Pass *pass, Operation *op) {
+  telemetryFrameStack.pop_back();
+}
+
+} // namespace mlir::iree_compiler
@@ -0,0 +1,83 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_COMPILER_UTILS_PASSTELEMETRY_H_
+#define IREE_COMPILER_UTILS_PASSTELEMETRY_H_
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+#include "llvm/ADT/SmallVector.h"
+#include "mlir/Pass/PassInstrumentation.h"
+
+namespace mlir::iree_compiler {
+
+// Accumulates per-pass wall time, IR size, and heap usage telemetry across
+// all pass managers in the process and writes it as a JSON artifact when
+// destroyed.
+// Records are attributed to the symbol breadcrumb of the op each pass ran on
+// so per-executable translation cost can be read off directly; scopes rooted
+// in a hal.executable that exceed the configured budget are flagged on
+// stderr at flush time.
+//
+// Usage:
+//   if (auto collector = PassTelemetryCollector::getFromFlags())
+//     passManager.addInstrumentation(
+//         std::make_unique<PassTelemetry>(collector));
+class PassTelemetryCollector {
+public:
+  PassTelemetryCollector(std::string outputPath, int64_t budgetMs);
+  ~PassTelemetryCollector();
+
+  // Returns the process-wide collector when --iree-compile-telemetry-path is
+  // set and nullptr otherwise. The JSON artifact is written when the last
+  // reference is released at process exit.
+  static std::shared_ptr<PassTelemetryCollector> getFromFlags();
+
+  // |mallocDeltaBytes| is the change in process malloc usage across the pass:
+  // positive values are memory retained after the pass completed (new IR,
+  // uniqued attribute/type storage) as opposed to transient scratch.
+  void record(llvm::StringRef passName, llvm::StringRef scope, double timeMs,
+              int64_t opsBefore, int64_t opsAfter, int64_t mallocDeltaBytes);
+
+private:
+  void flush();
+
+  struct Record {
+    std::string passName;
+    std::string scope;
+    double timeMs;
+    int64_t opsBefore;
+    int64_t opsAfter;
+    int64_t mallocDeltaBytes;
+  };
+
+  std::string outputPath;
+  int64_t budgetMs;
+  std::mutex mutex;
+  llvm::SmallVector<Record> records;
+};
+
+// Instruments passes with wall-clock timing and op-count accounting feeding
+// the shared collector. Safe to attach to multiple pass managers; callbacks
+// may run concurrently on different threads.
+struct PassTelemetry : public PassInstrumentation {
+  explicit PassTelemetry(std::shared_ptr<PassTelemetryCollector> collector)
+      : collector(std::move(collector)) {}
+  ~PassTelemetry() override = default;
+
+  void runBeforePass(Pass *pass, Operation *op) override;
+  void runAfterPass(Pass *pass, Operation *op) override;
+  void runAfterPassFailed(Pass *pass, Operation *op) override;
+
+private:
+  std::shared_ptr<PassTelemetryCollector> collector;
+};
+
+} // namespace mlir::iree_compiler
+
+#endif // IREE_COMPILER_UTILS_PASSTELEMETRY_H_
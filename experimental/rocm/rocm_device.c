@@ -400,6 +400,20 @@ static iree_status_t iree_hal_rocm_device_queue_execute(
   return iree_ok_status();
 }
 
+static iree_status_t iree_hal_rocm_device_queue_callback(
+    iree_hal_device_t* base_device, iree_hal_queue_affinity_t queue_affinity,
+    const iree_hal_semaphore_list_t wait_semaphore_list,
+    const iree_hal_semaphore_list_t signal_semaphore_list,
+    iree_hal_queue_callback_fn_t callback, void* user_data) {
+  iree_hal_rocm_device_t* device = iree_hal_rocm_device_cast(base_device);
+  // Matching queue_execute above this conservatively synchronizes the stream
+  // before running the callback; semaphores are not yet implemented.
+  ROCM_RETURN_IF_ERROR(device->context_wrapper.syms, hipStreamSynchronize(0),
+                       "hipStreamSynchronize");
+  callback(user_data);
+  return iree_ok_status();
+}
+
 static iree_status_t iree_hal_rocm_device_queue_flush(
     iree_hal_device_t* base_device, iree_hal_queue_affinity_t queue_affinity) {
   // Currently unused; we flush as submissions are made.
@@ -457,6 +471,7 @@ static const iree_hal_device_vtable_t iree_hal_rocm_device_vtable = {
     .queue_read = iree_hal_rocm_device_queue_read,
     .queue_write = iree_hal_rocm_device_queue_write,
     .queue_execute = iree_hal_rocm_device_queue_execute,
+    .queue_callback = iree_hal_rocm_device_queue_callback,
     .queue_flush = iree_hal_rocm_device_queue_flush,
     .wait_semaphores = iree_hal_rocm_device_wait_semaphores,
     .profiling_begin = iree_hal_rocm_device_profiling_begin,
@@ -20,6 +20,7 @@ void iree_hal_webgpu_bind_group_cache_initialize(
   IREE_TRACE_ZONE_BEGIN(z0);
 
   out_cache->device = device;
+  out_cache->use_counter = 0;
   out_cache->entry_count = IREE_HAL_WEBGPU_BIND_GROUP_CACHE_CAPACITY;
 
   IREE_TRACE_ZONE_END(z0);
@@ -47,10 +48,36 @@ void iree_hal_webgpu_bind_group_cache_trim(
     if (entry->handle) iree_wgpuBindGroupDrop(entry->handle);
   }
   memset(cache->entries, 0, sizeof(cache->entries));
+  cache->use_counter = 0;
 
   IREE_TRACE_ZONE_END(z0);
 }
 
+// Hashes a bind group cache key (layout + mask + bindings) with 32-bit FNV-1a.
+// Used as a cheap first-level filter so that lookups only memcmp bindings of
+// entries that are plausible matches.
+static uint32_t iree_hal_webgpu_bind_group_cache_hash_key(
+    WGPUBindGroupLayout group_layout,
+    const iree_hal_webgpu_bind_group_binding_t* bindings,
+    iree_hal_webgpu_binding_mask_t binding_mask) {
+  uint32_t hash = 2166136261u;
+  const uint8_t* layout_bytes = (const uint8_t*)&group_layout;
+  for (iree_host_size_t i = 0; i < sizeof(group_layout); ++i) {
+    hash = (hash ^ layout_bytes[i]) * 16777619u;
+  }
+  const uint8_t* mask_bytes = (const uint8_t*)&binding_mask;
+  for (iree_host_size_t i = 0; i < sizeof(binding_mask); ++i) {
+    hash = (hash ^ mask_bytes[i]) * 16777619u;
+  }
+  const uint8_t* binding_bytes = (const uint8_t*)bindings;
+  iree_host_size_t binding_length =
+      sizeof(*bindings) * IREE_HAL_WEBGPU_MAX_DESCRIPTOR_SET_BINDING_COUNT;
+  for (iree_host_size_t i = 0; i < binding_length; ++i) {
+    hash = (hash ^ binding_bytes[i]) * 16777619u;
+  }
+  return hash;
+}
+
 WGPUBindGroup iree_hal_webgpu_bind_group_cache_acquire(
     iree_hal_webgpu_bind_group_cache_t* cache, WGPUBindGroupLayout group_layout,
     const iree_hal_webgpu_bind_group_binding_t* bindings,
@@ -59,25 +86,28 @@ WGPUBindGroup iree_hal_webgpu_bind_group_cache_acquire(
   IREE_ASSERT_ARGUMENT(bindings);
   IREE_TRACE_ZONE_BEGIN(z0);
 
-  // This is not a good algorithm :)
-  // We should probably have a split index and a mechanism to partition it such
-  // that lookups don't need to perform a full scan. This is cheaper than the
-  // cost of creating a new bind group per dispatch (no need to call out to
-  // WebGPU, allocate new objects, track those new objects lifetimes, etc) but
-  // not cheap. Ideally we'd be relying on this for 4-5 bind groups per command
-  // buffer at which point it doesn't matter but the compiler still needs to
-  // improve a bit there.
-
-  // Scan the cache for entries with a matching group layout and binding mask.
-  // These should be the same today but in the future we may want to allow for
-  // subsetting as defined by bind group compatibility.
-  iree_host_size_t insertion_slot = cache->entry_count - 1;
+  // Scan the cache for entries with a matching key hash; only plausible
+  // matches pay for the full binding comparison. The scan also tracks the
+  // least recently used populated entry as the eviction candidate so a miss
+  // doesn't need a second pass. Decode command buffers cycle through many
+  // more unique binding sets than the old first-unused eviction handled;
+  // LRU keeps the per-step working set resident across submissions.
+  uint32_t key_hash = iree_hal_webgpu_bind_group_cache_hash_key(
+      group_layout, bindings, binding_mask);
+  iree_hal_webgpu_bind_group_cache_entry_t* insertion_entry = NULL;
   for (iree_host_size_t i = 0; i < cache->entry_count; ++i) {
     iree_hal_webgpu_bind_group_cache_entry_t* entry = &cache->entries[i];
     if (!entry->handle) {
-      insertion_slot = iree_min(insertion_slot, i);
+      // Unused slots always win as insertion candidates.
+      if (!insertion_entry || insertion_entry->handle) insertion_entry = entry;
       continue;
     }
+    if (!insertion_entry ||
+        (insertion_entry->handle &&
+         entry->last_use < insertion_entry->last_use)) {
+      insertion_entry = entry;
+    }
+    if (entry->key_hash != key_hash) continue;
     if (entry->group_layout != group_layout) continue;
     if (entry->binding_mask != binding_mask) continue;
 
@@ -87,15 +117,15 @@ WGPUBindGroup iree_hal_webgpu_bind_group_cache_acquire(
     // faster than what we'd have to do for that comparison.
     if (memcmp(bindings, entry->bindings, sizeof(entry->bindings)) == 0) {
       // Same exact bindings - cache hit!
-      // TODO(benvanik): a real LRU that rearranges this to the front/back.
+      entry->last_use = ++cache->use_counter;
       IREE_TRACE_ZONE_END(z0);
       return entry->handle;
     }
   }
 
-  // Evict an existing entry to store this new one or use the last unused slot.
-  iree_hal_webgpu_bind_group_cache_entry_t* entry =
-      &cache->entries[insertion_slot];
+  // Evict the least recently used entry to store this new one or use an
+  // unused slot found during the scan.
+  iree_hal_webgpu_bind_group_cache_entry_t* entry = insertion_entry;
   if (entry->handle) {
     IREE_TRACE_ZONE_APPEND_TEXT(z0, "evict");
     iree_wgpuBindGroupDrop(entry->handle);
@@ -103,6 +133,8 @@ WGPUBindGroup iree_hal_webgpu_bind_group_cache_acquire(
     IREE_TRACE_ZONE_APPEND_TEXT(z0, "miss");
   }
   entry->group_layout = group_layout;
+  entry->key_hash = key_hash;
+  entry->last_use = ++cache->use_counter;
   entry->binding_mask = binding_mask;
   memcpy(entry->bindings, bindings, sizeof(entry->bindings));
 
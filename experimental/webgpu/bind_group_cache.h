@@ -39,6 +39,12 @@ typedef struct iree_hal_webgpu_bind_group_cache_entry_t {
   WGPUBindGroupLayout group_layout;
   // Cached WebGPU bind group containing the bindings.
   WGPUBindGroup handle;
+  // Hash of the group layout, binding mask, and bindings used to reject
+  // non-matching entries without comparing the full binding list.
+  uint32_t key_hash;
+  // Ticket from the owning cache's use counter when the entry was last hit.
+  // The entry with the oldest ticket is evicted when the cache is full.
+  uint32_t last_use;
   // Each bit indicates a populated binding at the respective ordinal.
   iree_hal_webgpu_binding_mask_t binding_mask;
   // Each source binding to use for cache equality comparison.
@@ -51,6 +57,8 @@ typedef struct iree_hal_webgpu_bind_group_cache_entry_t {
 // unique set of bindings.
 typedef struct iree_hal_webgpu_bind_group_cache_t {
   WGPUDevice device;
+  // Monotonically increasing ticket used to order entries for LRU eviction.
+  uint32_t use_counter;
   iree_host_size_t entry_count;
   iree_hal_webgpu_bind_group_cache_entry_t
       entries[IREE_HAL_WEBGPU_BIND_GROUP_CACHE_CAPACITY];
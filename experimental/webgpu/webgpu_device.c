@@ -417,6 +417,19 @@ static iree_status_t iree_hal_webgpu_device_queue_execute(
   return iree_ok_status();
 }
 
+static iree_status_t iree_hal_webgpu_device_queue_callback(
+    iree_hal_device_t* base_device, iree_hal_queue_affinity_t queue_affinity,
+    const iree_hal_semaphore_list_t wait_semaphore_list,
+    const iree_hal_semaphore_list_t signal_semaphore_list,
+    iree_hal_queue_callback_fn_t callback, void* user_data) {
+  // As with queue_execute above this assumes waits are already (or about to
+  // be) satisfied; the callback runs inline on the submitting thread.
+  IREE_RETURN_IF_ERROR(iree_hal_semaphore_list_wait(wait_semaphore_list,
+                                                    iree_infinite_timeout()));
+  callback(user_data);
+  return iree_hal_semaphore_list_signal(signal_semaphore_list);
+}
+
 static iree_status_t iree_hal_webgpu_device_queue_flush(
     iree_hal_device_t* base_device, iree_hal_queue_affinity_t queue_affinity) {
   // Currently unused; we flush as submissions are made.
@@ -472,6 +485,7 @@ const iree_hal_device_vtable_t iree_hal_webgpu_device_vtable = {
     .queue_read = iree_hal_webgpu_device_queue_read,
     .queue_write = iree_hal_webgpu_device_queue_write,
     .queue_execute = iree_hal_webgpu_device_queue_execute,
+    .queue_callback = iree_hal_webgpu_device_queue_callback,
     .queue_flush = iree_hal_webgpu_device_queue_flush,
     .wait_semaphores = iree_hal_webgpu_device_wait_semaphores,
     .profiling_begin = iree_hal_webgpu_device_profiling_begin,
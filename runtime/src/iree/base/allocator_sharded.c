@@ -0,0 +1,479 @@
+// Copyright 2026 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/base/allocator_sharded.h"
+
+#include "iree/base/internal/atomics.h"
+#include "iree/base/internal/cpu.h"
+#include "iree/base/internal/math.h"
+#include "iree/base/internal/synchronization.h"
+
+//===----------------------------------------------------------------------===//
+// Size classes
+//===----------------------------------------------------------------------===//
+
+// Smallest size class in bytes; allocations below this round up to it.
+// Must be at least sizeof(void*) as freed blocks thread their freelist link
+// through the first word of user storage and at least iree_max_align_t to
+// preserve alignment guarantees for subsequent classes.
+#define IREE_ALLOCATOR_SHARDED_MIN_CACHED_SIZE 16
+
+// Largest supported max_cached_size; bounds the per-shard class table.
+#define IREE_ALLOCATOR_SHARDED_MAX_CACHED_SIZE 4096
+
+// Maximum number of power-of-two size classes ([16, 4096] inclusive).
+#define IREE_ALLOCATOR_SHARDED_MAX_CLASS_COUNT 9
+
+#define IREE_ALLOCATOR_SHARDED_DEFAULT_SHARD_COUNT 8
+#define IREE_ALLOCATOR_SHARDED_DEFAULT_MAX_CACHED_SIZE 512
+#define IREE_ALLOCATOR_SHARDED_DEFAULT_MAGAZINE_DEPTH 16
+
+// Returns the size class index for |byte_length| (must be <= max cached size).
+static iree_host_size_t iree_allocator_sharded_size_class(
+    iree_host_size_t byte_length) {
+  uint64_t padded = iree_math_round_up_to_pow2_u64(
+      iree_max(byte_length, IREE_ALLOCATOR_SHARDED_MIN_CACHED_SIZE));
+  return iree_math_count_trailing_zeros_u64(padded) -
+         iree_math_count_trailing_zeros_u64(
+             IREE_ALLOCATOR_SHARDED_MIN_CACHED_SIZE);
+}
+
+// Returns the byte size of blocks in size class |size_class|.
+static iree_host_size_t iree_allocator_sharded_class_size(
+    iree_host_size_t size_class) {
+  return (iree_host_size_t)IREE_ALLOCATOR_SHARDED_MIN_CACHED_SIZE << size_class;
+}
+
+//===----------------------------------------------------------------------===//
+// Block header
+//===----------------------------------------------------------------------===//
+
+// Header prefixed to every allocation made through the sharded allocator.
+// Padded to iree_max_align_t so user storage retains natural SIMD alignment.
+typedef struct iree_allocator_sharded_block_t {
+  // User-visible allocation length in bytes.
+  iree_host_size_t byte_length;
+  // Size class index + 1, or 0 if the block bypassed the magazines.
+  uint32_t size_class;
+  uint32_t reserved;
+} iree_allocator_sharded_block_t;
+
+#define IREE_ALLOCATOR_SHARDED_HEADER_SIZE                   \
+  iree_host_align(sizeof(iree_allocator_sharded_block_t),    \
+                  iree_max_align_t)
+
+static void* iree_allocator_sharded_block_user_ptr(
+    iree_allocator_sharded_block_t* block) {
+  return (uint8_t*)block + IREE_ALLOCATOR_SHARDED_HEADER_SIZE;
+}
+
+static iree_allocator_sharded_block_t* iree_allocator_sharded_block_from_ptr(
+    void* ptr) {
+  return (iree_allocator_sharded_block_t*)((uint8_t*)ptr -
+                                           IREE_ALLOCATOR_SHARDED_HEADER_SIZE);
+}
+
+//===----------------------------------------------------------------------===//
+// Shards
+//===----------------------------------------------------------------------===//
+
+#if IREE_STATISTICS_ENABLE
+// Per-shard statistics counters.
+// Updated with relaxed atomics so the hot paths never synchronize on them;
+// queries sum across shards and may observe slightly stale values.
+typedef struct iree_allocator_sharded_shard_statistics_t {
+  iree_atomic_int64_t allocation_count;
+  iree_atomic_int64_t free_count;
+  iree_atomic_int64_t magazine_hit_count;
+  iree_atomic_int64_t live_bytes;
+  iree_atomic_int64_t peak_bytes;
+  iree_atomic_int64_t cached_bytes;
+} iree_allocator_sharded_shard_statistics_t;
+#endif  // IREE_STATISTICS_ENABLE
+
+// A single shard holding magazines of freed blocks and statistics counters.
+// Shards are selected by logical processor ID; the mutex only contends when
+// threads migrate cores mid-operation or shard_count is less than the number
+// of active processors.
+typedef struct iree_allocator_sharded_shard_t {
+  // Guards |magazine_heads|/|magazine_counts|.
+  iree_slim_mutex_t mutex;
+  // Singly-linked freelists of cached blocks, one per size class, threaded
+  // through the first word of each cached block's user storage.
+  iree_allocator_sharded_block_t*
+      magazine_heads[IREE_ALLOCATOR_SHARDED_MAX_CLASS_COUNT];
+  // Number of blocks in each magazine.
+  uint16_t magazine_counts[IREE_ALLOCATOR_SHARDED_MAX_CLASS_COUNT];
+  IREE_STATISTICS(iree_allocator_sharded_shard_statistics_t statistics;)
+} iree_allocator_sharded_shard_t;
+
+struct iree_allocator_sharded_t {
+  // Base allocator all backing allocations are routed to.
+  iree_allocator_t base_allocator;
+  // Total shard count; power of two.
+  iree_host_size_t shard_count;
+  // Number of size classes in use ([min, max_cached_size]).
+  iree_host_size_t class_count;
+  // Maximum block size eligible for caching in bytes; power of two.
+  iree_host_size_t max_cached_size;
+  // Maximum cached blocks per size class per shard.
+  iree_host_size_t magazine_depth;
+  // Trailing shard storage.
+  iree_allocator_sharded_shard_t shards[0];
+};
+
+// Returns the shard servicing operations issued by the calling thread.
+static iree_allocator_sharded_shard_t* iree_allocator_sharded_current_shard(
+    iree_allocator_sharded_t* allocator) {
+  return &allocator->shards[iree_cpu_query_processor_id() &
+                            (allocator->shard_count - 1)];
+}
+
+#if IREE_STATISTICS_ENABLE
+static void iree_allocator_sharded_statistics_track_alloc(
+    iree_allocator_sharded_shard_t* shard, iree_host_size_t byte_length) {
+  iree_atomic_fetch_add_int64(&shard->statistics.allocation_count, 1,
+                              iree_memory_order_relaxed);
+  int64_t live_bytes =
+      iree_atomic_fetch_add_int64(&shard->statistics.live_bytes,
+                                  (int64_t)byte_length,
+                                  iree_memory_order_relaxed) +
+      (int64_t)byte_length;
+  int64_t peak_bytes = iree_atomic_load_int64(&shard->statistics.peak_bytes,
+                                              iree_memory_order_relaxed);
+  while (live_bytes > peak_bytes &&
+         !iree_atomic_compare_exchange_weak_int64(
+             &shard->statistics.peak_bytes, &peak_bytes, live_bytes,
+             iree_memory_order_relaxed, iree_memory_order_relaxed)) {
+    // Another thread raced the peak update; |peak_bytes| was reloaded.
+  }
+}
+
+static void iree_allocator_sharded_statistics_track_free(
+    iree_allocator_sharded_shard_t* shard, iree_host_size_t byte_length) {
+  iree_atomic_fetch_add_int64(&shard->statistics.free_count, 1,
+                              iree_memory_order_relaxed);
+  iree_atomic_fetch_add_int64(&shard->statistics.live_bytes,
+                              -(int64_t)byte_length,
+                              iree_memory_order_relaxed);
+}
+#else
+#define iree_allocator_sharded_statistics_track_alloc(shard, byte_length)
+#define iree_allocator_sharded_statistics_track_free(shard, byte_length)
+#endif  // IREE_STATISTICS_ENABLE
+
+//===----------------------------------------------------------------------===//
+// Allocation paths
+//===----------------------------------------------------------------------===//
+
+static iree_status_t iree_allocator_sharded_malloc(
+    iree_allocator_sharded_t* allocator, iree_allocator_command_t command,
+    iree_host_size_t byte_length, void** inout_ptr) {
+  iree_allocator_sharded_shard_t* shard =
+      iree_allocator_sharded_current_shard(allocator);
+
+  // Try to satisfy small allocations from the shard-local magazine.
+  if (byte_length <= allocator->max_cached_size) {
+    iree_host_size_t size_class =
+        iree_allocator_sharded_size_class(byte_length);
+    iree_slim_mutex_lock(&shard->mutex);
+    iree_allocator_sharded_block_t* block = shard->magazine_heads[size_class];
+    if (block) {
+      void* user_ptr = iree_allocator_sharded_block_user_ptr(block);
+      shard->magazine_heads[size_class] =
+          *(iree_allocator_sharded_block_t**)user_ptr;
+      --shard->magazine_counts[size_class];
+      iree_slim_mutex_unlock(&shard->mutex);
+      block->byte_length = byte_length;
+      if (command == IREE_ALLOCATOR_COMMAND_CALLOC) {
+        memset(user_ptr, 0, byte_length);
+      }
+      IREE_STATISTICS({
+        iree_atomic_fetch_add_int64(&shard->statistics.magazine_hit_count, 1,
+                                    iree_memory_order_relaxed);
+        iree_atomic_fetch_add_int64(
+            &shard->statistics.cached_bytes,
+            -(int64_t)iree_allocator_sharded_class_size(size_class),
+            iree_memory_order_relaxed);
+      });
+      iree_allocator_sharded_statistics_track_alloc(shard, byte_length);
+      *inout_ptr = user_ptr;
+      return iree_ok_status();
+    }
+    iree_slim_mutex_unlock(&shard->mutex);
+
+    // Miss: allocate a full class-sized block so it can be cached on free.
+    iree_allocator_sharded_block_t* new_block = NULL;
+    IREE_RETURN_IF_ERROR(allocator->base_allocator.ctl(
+        allocator->base_allocator.self, command,
+        &(iree_allocator_alloc_params_t){
+            .byte_length = IREE_ALLOCATOR_SHARDED_HEADER_SIZE +
+                           iree_allocator_sharded_class_size(size_class),
+        },
+        (void**)&new_block));
+    new_block->byte_length = byte_length;
+    new_block->size_class = (uint32_t)size_class + 1;
+    new_block->reserved = 0;
+    iree_allocator_sharded_statistics_track_alloc(shard, byte_length);
+    *inout_ptr = iree_allocator_sharded_block_user_ptr(new_block);
+    return iree_ok_status();
+  }
+
+  // Large allocation: pass through to the base allocator (still headered so
+  // frees and stats can route correctly).
+  iree_allocator_sharded_block_t* new_block = NULL;
+  IREE_RETURN_IF_ERROR(allocator->base_allocator.ctl(
+      allocator->base_allocator.self, command,
+      &(iree_allocator_alloc_params_t){
+          .byte_length = IREE_ALLOCATOR_SHARDED_HEADER_SIZE + byte_length,
+      },
+      (void**)&new_block));
+  new_block->byte_length = byte_length;
+  new_block->size_class = 0;
+  new_block->reserved = 0;
+  iree_allocator_sharded_statistics_track_alloc(shard, byte_length);
+  *inout_ptr = iree_allocator_sharded_block_user_ptr(new_block);
+  return iree_ok_status();
+}
+
+static iree_status_t iree_allocator_sharded_do_free(
+    iree_allocator_sharded_t* allocator, void** inout_ptr) {
+  void* ptr = *inout_ptr;
+  if (!ptr) return iree_ok_status();
+  iree_allocator_sharded_block_t* block =
+      iree_allocator_sharded_block_from_ptr(ptr);
+  iree_allocator_sharded_shard_t* shard =
+      iree_allocator_sharded_current_shard(allocator);
+  iree_allocator_sharded_statistics_track_free(shard, block->byte_length);
+  *inout_ptr = NULL;
+
+  // Cache eligible blocks in the magazine of the shard of the freeing thread;
+  // blocks may migrate shards over their lifetime and that's fine.
+  if (block->size_class != 0) {
+    iree_host_size_t size_class = block->size_class - 1;
+    iree_slim_mutex_lock(&shard->mutex);
+    if (shard->magazine_counts[size_class] < allocator->magazine_depth) {
+      *(iree_allocator_sharded_block_t**)ptr =
+          shard->magazine_heads[size_class];
+      shard->magazine_heads[size_class] = block;
+      ++shard->magazine_counts[size_class];
+      iree_slim_mutex_unlock(&shard->mutex);
+      IREE_STATISTICS(iree_atomic_fetch_add_int64(
+          &shard->statistics.cached_bytes,
+          (int64_t)iree_allocator_sharded_class_size(size_class),
+          iree_memory_order_relaxed));
+      return iree_ok_status();
+    }
+    iree_slim_mutex_unlock(&shard->mutex);
+  }
+
+  // Magazine full (or block too large to cache): return to base allocator.
+  iree_allocator_free(allocator->base_allocator, block);
+  return iree_ok_status();
+}
+
+static iree_status_t iree_allocator_sharded_realloc(
+    iree_allocator_sharded_t* allocator, iree_host_size_t byte_length,
+    void** inout_ptr) {
+  void* ptr = *inout_ptr;
+  iree_allocator_sharded_block_t* block =
+      iree_allocator_sharded_block_from_ptr(ptr);
+
+  // If the new length still fits within the block's backing capacity we can
+  // update in place; this covers the common shrink and small-growth cases.
+  iree_host_size_t capacity =
+      block->size_class != 0
+          ? iree_allocator_sharded_class_size(block->size_class - 1)
+          : block->byte_length;
+  if (byte_length <= capacity) {
+    iree_allocator_sharded_shard_t* shard =
+        iree_allocator_sharded_current_shard(allocator);
+    iree_allocator_sharded_statistics_track_free(shard, block->byte_length);
+    iree_allocator_sharded_statistics_track_alloc(shard, byte_length);
+    block->byte_length = byte_length;
+    return iree_ok_status();
+  }
+
+  // Growth beyond capacity: allocate fresh, copy, and free the old block so
+  // that both ends route through the magazines.
+  void* new_ptr = NULL;
+  IREE_RETURN_IF_ERROR(iree_allocator_sharded_malloc(
+      allocator, IREE_ALLOCATOR_COMMAND_MALLOC, byte_length, &new_ptr));
+  memcpy(new_ptr, ptr, block->byte_length);
+  iree_status_ignore(iree_allocator_sharded_do_free(allocator, &ptr));
+  *inout_ptr = new_ptr;
+  return iree_ok_status();
+}
+
+static iree_status_t iree_allocator_sharded_alloc(
+    iree_allocator_sharded_t* allocator, iree_allocator_command_t command,
+    const iree_allocator_alloc_params_t* params, void** inout_ptr) {
+  IREE_ASSERT_ARGUMENT(params);
+  IREE_ASSERT_ARGUMENT(inout_ptr);
+  iree_host_size_t byte_length = params->byte_length;
+  if (IREE_UNLIKELY(byte_length == 0)) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "allocations must be >0 bytes");
+  }
+  if (*inout_ptr && command == IREE_ALLOCATOR_COMMAND_REALLOC) {
+    return iree_allocator_sharded_realloc(allocator, byte_length, inout_ptr);
+  }
+  return iree_allocator_sharded_malloc(allocator, command, byte_length,
+                                       inout_ptr);
+}
+
+IREE_API_EXPORT iree_status_t
+iree_allocator_sharded_ctl(void* self, iree_allocator_command_t command,
+                           const void* params, void** inout_ptr) {
+  iree_allocator_sharded_t* allocator = (iree_allocator_sharded_t*)self;
+  switch (command) {
+    case IREE_ALLOCATOR_COMMAND_MALLOC:
+    case IREE_ALLOCATOR_COMMAND_CALLOC:
+    case IREE_ALLOCATOR_COMMAND_REALLOC:
+      return iree_allocator_sharded_alloc(
+          allocator, command, (const iree_allocator_alloc_params_t*)params,
+          inout_ptr);
+    case IREE_ALLOCATOR_COMMAND_FREE:
+      return iree_allocator_sharded_do_free(allocator, inout_ptr);
+    default:
+      return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
+                              "unsupported sharded allocator command");
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Lifetime
+//===----------------------------------------------------------------------===//
+
+IREE_API_EXPORT iree_status_t iree_allocator_sharded_allocate(
+    iree_allocator_sharded_options_t options, iree_allocator_t base_allocator,
+    iree_allocator_sharded_t** out_allocator) {
+  IREE_ASSERT_ARGUMENT(out_allocator);
+  *out_allocator = NULL;
+
+  if (!options.shard_count) {
+    options.shard_count = IREE_ALLOCATOR_SHARDED_DEFAULT_SHARD_COUNT;
+  }
+  options.shard_count = (iree_host_size_t)iree_math_round_up_to_pow2_u64(
+      (uint64_t)options.shard_count);
+  if (!options.max_cached_size) {
+    options.max_cached_size = IREE_ALLOCATOR_SHARDED_DEFAULT_MAX_CACHED_SIZE;
+  }
+  options.max_cached_size = (iree_host_size_t)iree_math_round_up_to_pow2_u64(
+      (uint64_t)iree_max(options.max_cached_size,
+                         IREE_ALLOCATOR_SHARDED_MIN_CACHED_SIZE));
+  if (options.max_cached_size > IREE_ALLOCATOR_SHARDED_MAX_CACHED_SIZE) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "max_cached_size %" PRIhsz
+                            " exceeds the supported maximum %d",
+                            options.max_cached_size,
+                            IREE_ALLOCATOR_SHARDED_MAX_CACHED_SIZE);
+  }
+  if (!options.magazine_depth) {
+    options.magazine_depth = IREE_ALLOCATOR_SHARDED_DEFAULT_MAGAZINE_DEPTH;
+  }
+  if (options.magazine_depth > UINT16_MAX) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "magazine depth exceeds maximum");
+  }
+
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_allocator_sharded_t* allocator = NULL;
+  const iree_host_size_t total_size =
+      sizeof(*allocator) +
+      options.shard_count * sizeof(allocator->shards[0]);
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0,
+      iree_allocator_malloc(base_allocator, total_size, (void**)&allocator));
+  allocator->base_allocator = base_allocator;
+  allocator->shard_count = options.shard_count;
+  allocator->class_count =
+      iree_allocator_sharded_size_class(options.max_cached_size) + 1;
+  allocator->max_cached_size = options.max_cached_size;
+  allocator->magazine_depth = options.magazine_depth;
+  for (iree_host_size_t i = 0; i < allocator->shard_count; ++i) {
+    iree_slim_mutex_initialize(&allocator->shards[i].mutex);
+  }
+
+  *out_allocator = allocator;
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
+IREE_API_EXPORT void iree_allocator_sharded_free(
+    iree_allocator_sharded_t* allocator) {
+  IREE_ASSERT_ARGUMENT(allocator);
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_allocator_sharded_trim(allocator);
+  for (iree_host_size_t i = 0; i < allocator->shard_count; ++i) {
+    iree_slim_mutex_deinitialize(&allocator->shards[i].mutex);
+  }
+  iree_allocator_free(allocator->base_allocator, allocator);
+
+  IREE_TRACE_ZONE_END(z0);
+}
+
+IREE_API_EXPORT void iree_allocator_sharded_trim(
+    iree_allocator_sharded_t* allocator) {
+  IREE_ASSERT_ARGUMENT(allocator);
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  for (iree_host_size_t i = 0; i < allocator->shard_count; ++i) {
+    iree_allocator_sharded_shard_t* shard = &allocator->shards[i];
+    for (iree_host_size_t size_class = 0; size_class < allocator->class_count;
+         ++size_class) {
+      // Unlink the whole magazine under the lock and free outside of it.
+      iree_slim_mutex_lock(&shard->mutex);
+      iree_allocator_sharded_block_t* block =
+          shard->magazine_heads[size_class];
+      shard->magazine_heads[size_class] = NULL;
+      IREE_STATISTICS(iree_atomic_fetch_add_int64(
+          &shard->statistics.cached_bytes,
+          -(int64_t)(shard->magazine_counts[size_class] *
+                     iree_allocator_sharded_class_size(size_class)),
+          iree_memory_order_relaxed));
+      shard->magazine_counts[size_class] = 0;
+      iree_slim_mutex_unlock(&shard->mutex);
+      while (block) {
+        iree_allocator_sharded_block_t* next_block =
+            *(iree_allocator_sharded_block_t**)
+                iree_allocator_sharded_block_user_ptr(block);
+        iree_allocator_free(allocator->base_allocator, block);
+        block = next_block;
+      }
+    }
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+}
+
+IREE_API_EXPORT void iree_allocator_sharded_query_statistics(
+    iree_allocator_sharded_t* allocator,
+    iree_allocator_sharded_statistics_t* out_statistics) {
+  IREE_ASSERT_ARGUMENT(allocator);
+  IREE_ASSERT_ARGUMENT(out_statistics);
+  memset(out_statistics, 0, sizeof(*out_statistics));
+  IREE_STATISTICS({
+    for (iree_host_size_t i = 0; i < allocator->shard_count; ++i) {
+      iree_allocator_sharded_shard_statistics_t* statistics =
+          &allocator->shards[i].statistics;
+      out_statistics->allocation_count += iree_atomic_load_int64(
+          &statistics->allocation_count, iree_memory_order_relaxed);
+      out_statistics->free_count += iree_atomic_load_int64(
+          &statistics->free_count, iree_memory_order_relaxed);
+      out_statistics->magazine_hit_count += iree_atomic_load_int64(
+          &statistics->magazine_hit_count, iree_memory_order_relaxed);
+      out_statistics->live_bytes += iree_atomic_load_int64(
+          &statistics->live_bytes, iree_memory_order_relaxed);
+      out_statistics->peak_bytes += iree_atomic_load_int64(
+          &statistics->peak_bytes, iree_memory_order_relaxed);
+      out_statistics->cached_bytes += iree_atomic_load_int64(
+          &statistics->cached_bytes, iree_memory_order_relaxed);
+    }
+  });
+}
@@ -0,0 +1,119 @@
+// Copyright 2026 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_BASE_ALLOCATOR_SHARDED_H_
+#define IREE_BASE_ALLOCATOR_SHARDED_H_
+
+#include "iree/base/api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+//===----------------------------------------------------------------------===//
+// iree_allocator_sharded_t
+//===----------------------------------------------------------------------===//
+
+// Configuration options for the sharded allocator.
+typedef struct iree_allocator_sharded_options_t {
+  // Number of shards used for magazines and statistics.
+  // Rounded up to a power of two. Shards are selected by the ID of the logical
+  // processor issuing the operation so that under concurrent load each core
+  // (mostly) touches its own shard. 0 = implementation-defined default.
+  iree_host_size_t shard_count;
+
+  // Maximum block size in bytes eligible for magazine caching.
+  // Rounded up to a power of two. Larger allocations pass directly through to
+  // the base allocator (statistics are still tracked). 0 = default (512).
+  iree_host_size_t max_cached_size;
+
+  // Maximum number of freed blocks retained per size class per shard.
+  // 0 = default (16).
+  iree_host_size_t magazine_depth;
+} iree_allocator_sharded_options_t;
+
+// Aggregated allocation statistics across all shards.
+// All values are zero unless IREE_STATISTICS_ENABLE is set.
+typedef struct iree_allocator_sharded_statistics_t {
+  // Lifetime number of allocations (malloc/calloc/grow-realloc).
+  int64_t allocation_count;
+  // Lifetime number of frees.
+  int64_t free_count;
+  // Lifetime number of allocations serviced from a magazine without reaching
+  // the base allocator.
+  int64_t magazine_hit_count;
+  // Total bytes currently outstanding (allocated and not yet freed).
+  int64_t live_bytes;
+  // Maximum observed value of |live_bytes|.
+  // Tracked per shard and summed; concurrent peaks on different shards may
+  // make this a slight overestimate of the true process-wide peak.
+  int64_t peak_bytes;
+  // Total bytes currently retained in magazines awaiting reuse.
+  int64_t cached_bytes;
+} iree_allocator_sharded_statistics_t;
+
+// A decorator allocator that adds per-processor magazines of small freed
+// blocks and sharded allocation statistics on top of a base allocator.
+//
+// Small allocations are padded with a header and on free are pushed onto a
+// fixed-depth per-shard per-size-class magazine instead of being returned to
+// the base allocator; subsequent allocations of the same class on the same
+// shard pop from the magazine without taking any process-wide lock. Shards
+// are keyed by logical processor ID so that concurrent dispatch threads stay
+// core-local and the per-shard locks are effectively uncontended.
+//
+// All cached blocks are returned to the base allocator when the allocator is
+// freed (or explicitly via iree_allocator_sharded_trim); the magazines only
+// ever retain shard_count * class_count * magazine_depth blocks.
+//
+// Thread-safe; may be used from any number of threads concurrently.
+typedef struct iree_allocator_sharded_t iree_allocator_sharded_t;
+
+// Allocates a sharded allocator wrapping |base_allocator|.
+// |base_allocator| is used for all backing allocations (including the
+// allocator itself) and must remain valid until the allocator is freed.
+IREE_API_EXPORT iree_status_t iree_allocator_sharded_allocate(
+    iree_allocator_sharded_options_t options, iree_allocator_t base_allocator,
+    iree_allocator_sharded_t** out_allocator);
+
+// Frees a sharded |allocator| and returns all cached blocks to the base
+// allocator. Callers must have freed all outstanding allocations made through
+// the allocator first.
+IREE_API_EXPORT void iree_allocator_sharded_free(
+    iree_allocator_sharded_t* allocator);
+
+// Returns all blocks currently cached in magazines to the base allocator.
+// Safe to call concurrently with allocator use.
+IREE_API_EXPORT void iree_allocator_sharded_trim(
+    iree_allocator_sharded_t* allocator);
+
+// Queries statistics aggregated across all shards into |out_statistics|.
+// Values are gathered with relaxed ordering and may be slightly stale with
+// respect to concurrent operations. All zeros unless IREE_STATISTICS_ENABLE.
+IREE_API_EXPORT void iree_allocator_sharded_query_statistics(
+    iree_allocator_sharded_t* allocator,
+    iree_allocator_sharded_statistics_t* out_statistics);
+
+// Sharded allocator controller used by iree_allocator_sharded.
+IREE_API_EXPORT iree_status_t
+iree_allocator_sharded_ctl(void* self, iree_allocator_command_t command,
+                           const void* params, void** inout_ptr);
+
+// Returns an iree_allocator_t that routes through |allocator|.
+// May be passed anywhere an iree_allocator_t is accepted (instance creation,
+// device creation, etc) to give that subsystem core-local caching; the
+// |allocator| must outlive all allocations made through the returned handle.
+static inline iree_allocator_t iree_allocator_sharded(
+    iree_allocator_sharded_t* allocator) {
+  iree_allocator_t v = {allocator, iree_allocator_sharded_ctl};
+  return v;
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // IREE_BASE_ALLOCATOR_SHARDED_H_
@@ -0,0 +1,116 @@
+// Copyright 2026 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/base/allocator_sharded.h"
+
+#include <cstring>
+
+#include "iree/base/api.h"
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+
+namespace {
+
+class AllocatorShardedTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    iree_allocator_sharded_options_t options = {0};
+    IREE_ASSERT_OK(iree_allocator_sharded_allocate(
+        options, iree_allocator_system(), &sharded_));
+    allocator_ = iree_allocator_sharded(sharded_);
+  }
+  void TearDown() override { iree_allocator_sharded_free(sharded_); }
+
+  iree_allocator_sharded_t* sharded_ = nullptr;
+  iree_allocator_t allocator_;
+};
+
+TEST_F(AllocatorShardedTest, MallocFree) {
+  void* ptr = nullptr;
+  IREE_ASSERT_OK(iree_allocator_malloc(allocator_, 64, &ptr));
+  ASSERT_NE(ptr, nullptr);
+  // iree_allocator_malloc guarantees zeroed contents.
+  uint8_t zeros[64] = {0};
+  EXPECT_EQ(std::memcmp(ptr, zeros, sizeof(zeros)), 0);
+  std::memset(ptr, 0xCC, 64);
+  iree_allocator_free(allocator_, ptr);
+}
+
+// A freed small block should be recycled through the magazine and subsequent
+// calloc-style allocations must still come back zeroed.
+TEST_F(AllocatorShardedTest, MagazineRecyclesAndZeroes) {
+  void* ptr = nullptr;
+  IREE_ASSERT_OK(iree_allocator_malloc(allocator_, 64, &ptr));
+  std::memset(ptr, 0xCC, 64);
+  iree_allocator_free(allocator_, ptr);
+
+  void* recycled_ptr = nullptr;
+  IREE_ASSERT_OK(iree_allocator_malloc(allocator_, 64, &recycled_ptr));
+  uint8_t zeros[64] = {0};
+  EXPECT_EQ(std::memcmp(recycled_ptr, zeros, sizeof(zeros)), 0);
+  iree_allocator_free(allocator_, recycled_ptr);
+
+#if IREE_STATISTICS_ENABLE
+  iree_allocator_sharded_statistics_t statistics;
+  iree_allocator_sharded_query_statistics(sharded_, &statistics);
+  EXPECT_EQ(statistics.allocation_count, 2);
+  EXPECT_EQ(statistics.free_count, 2);
+  // NOTE: the recycle is only guaranteed if both operations land on the same
+  // shard; with the test running on one thread that is effectively always the
+  // case but a core migration between the free and malloc could miss.
+  EXPECT_LE(statistics.magazine_hit_count, 1);
+  EXPECT_EQ(statistics.live_bytes, 0);
+  EXPECT_GE(statistics.peak_bytes, 64);
+#endif  // IREE_STATISTICS_ENABLE
+}
+
+TEST_F(AllocatorShardedTest, LargeAllocationPassthrough) {
+  void* ptr = nullptr;
+  IREE_ASSERT_OK(iree_allocator_malloc(allocator_, 1 * 1024 * 1024, &ptr));
+  ASSERT_NE(ptr, nullptr);
+  std::memset(ptr, 0xAB, 1 * 1024 * 1024);
+  iree_allocator_free(allocator_, ptr);
+
+#if IREE_STATISTICS_ENABLE
+  iree_allocator_sharded_statistics_t statistics;
+  iree_allocator_sharded_query_statistics(sharded_, &statistics);
+  EXPECT_EQ(statistics.live_bytes, 0);
+  EXPECT_EQ(statistics.cached_bytes, 0);  // too large to cache
+#endif  // IREE_STATISTICS_ENABLE
+}
+
+TEST_F(AllocatorShardedTest, ReallocPreservesContents) {
+  void* ptr = nullptr;
+  IREE_ASSERT_OK(iree_allocator_malloc(allocator_, 32, &ptr));
+  std::memset(ptr, 0x5A, 32);
+
+  // Grow within the same size class (in-place) and then far beyond it.
+  IREE_ASSERT_OK(iree_allocator_realloc(allocator_, 48, &ptr));
+  for (int i = 0; i < 32; ++i) EXPECT_EQ(((uint8_t*)ptr)[i], 0x5A);
+  IREE_ASSERT_OK(iree_allocator_realloc(allocator_, 8192, &ptr));
+  for (int i = 0; i < 32; ++i) EXPECT_EQ(((uint8_t*)ptr)[i], 0x5A);
+
+  iree_allocator_free(allocator_, ptr);
+}
+
+TEST_F(AllocatorShardedTest, TrimReleasesCachedBlocks) {
+  void* ptrs[8] = {nullptr};
+  for (auto& ptr : ptrs) {
+    IREE_ASSERT_OK(iree_allocator_malloc(allocator_, 128, &ptr));
+  }
+  for (auto& ptr : ptrs) iree_allocator_free(allocator_, ptr);
+
+  iree_allocator_sharded_trim(sharded_);
+
+#if IREE_STATISTICS_ENABLE
+  iree_allocator_sharded_statistics_t statistics;
+  iree_allocator_sharded_query_statistics(sharded_, &statistics);
+  EXPECT_EQ(statistics.cached_bytes, 0);
+  EXPECT_EQ(statistics.live_bytes, 0);
+#endif  // IREE_STATISTICS_ENABLE
+}
+
+}  // namespace
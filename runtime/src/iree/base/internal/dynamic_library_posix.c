@@ -183,6 +183,8 @@ static iree_once_flag iree_dynamic_library_temp_dir_init_once_flag_ =
 static const char* iree_dynamic_library_temp_dir_path_;
 static bool iree_dynamic_library_temp_dir_valid_;
 static bool iree_dynamic_library_temp_dir_preserve_;
+static const char* iree_dynamic_library_cache_dir_path_;
+static bool iree_dynamic_library_cache_dir_valid_;
 
 static bool iree_dynamic_library_path_is_null_or_empty(const char* path) {
   return path == NULL || path[0] == 0;
@@ -223,6 +225,88 @@ static void iree_dynamic_library_init_temp_dir(void) {
   struct stat s;
   iree_dynamic_library_temp_dir_valid_ =
       stat(path, &s) == 0 && (s.st_mode & S_IFMT) == S_IFDIR;
+
+  // Semantics of IREE_DYLIB_CACHE_DIR:
+  // * If the environment variable is not set, each load from memory extracts
+  //   a private unlinked temp file as usual.
+  // * If set to the path of a directory, libraries loaded from memory are
+  //   published there as content-addressed files. The first process to load a
+  //   given library writes the file and every other process (or later run)
+  //   dlopens the existing file directly, sharing its read-only pages through
+  //   the OS page cache instead of keeping a private copy per process.
+  //   Content addressing doubles as validation: a changed library hashes to a
+  //   different file name and stale entries are simply never referenced again.
+  const char* cache_path = getenv("IREE_DYLIB_CACHE_DIR");
+  iree_dynamic_library_cache_dir_path_ = cache_path;
+  iree_dynamic_library_cache_dir_valid_ =
+      !iree_dynamic_library_path_is_null_or_empty(cache_path) &&
+      stat(cache_path, &s) == 0 && (s.st_mode & S_IFMT) == S_IFDIR;
+}
+
+// Computes a FNV-1a hash over the library contents for content addressing.
+static uint64_t iree_dynamic_library_hash_contents(
+    iree_const_byte_span_t buffer) {
+  uint64_t hash = 14695981039346656037ull;
+  for (iree_host_size_t i = 0; i < buffer.data_length; ++i) {
+    hash = (hash ^ buffer.data[i]) * 1099511628211ull;
+  }
+  return hash;
+}
+
+// Loads a library from memory by way of a content-addressed file in the
+// IREE_DYLIB_CACHE_DIR directory, publishing the file if not present yet.
+static iree_status_t iree_dynamic_library_load_from_cache_dir(
+    iree_const_byte_span_t buffer, iree_dynamic_library_flags_t flags,
+    iree_allocator_t allocator, iree_dynamic_library_t** out_library) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  const uint64_t hash = iree_dynamic_library_hash_contents(buffer);
+  char cache_path[512];
+  if (snprintf(cache_path, sizeof(cache_path), "%s/iree_dylib_%016" PRIx64
+               ".so",
+               iree_dynamic_library_cache_dir_path_,
+               hash) >= sizeof(cache_path)) {
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(
+        IREE_STATUS_INVALID_ARGUMENT,
+        "IREE_DYLIB_CACHE_DIR name too long (>%zu chars); keep it reasonable",
+        sizeof(cache_path));
+  }
+
+  // Fast path: another process (or an earlier run) already published the
+  // library and we only pay the mapping cost.
+  if (access(cache_path, R_OK) == 0) {
+    iree_status_t status = iree_dynamic_library_load_from_file(
+        cache_path, flags, allocator, out_library);
+    if (iree_status_is_ok(status)) {
+      IREE_TRACE_ZONE_END(z0);
+      return status;
+    }
+    // A partially-written or corrupted file falls through to republishing.
+    iree_status_ignore(status);
+  }
+
+  // Extract to a unique temp file in the cache directory and atomically move
+  // it into place; concurrent publishers race benignly as all rename the same
+  // contents onto the same name.
+  char* temp_path = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_dynamic_library_write_temp_file(
+              buffer, "cache_", "so", allocator,
+              iree_dynamic_library_cache_dir_path_, &temp_path));
+  const char* load_path = cache_path;
+  if (rename(temp_path, cache_path) != 0) {
+    // Keep the temp file usable if the move failed (read-only dir race, etc).
+    load_path = temp_path;
+  }
+
+  iree_status_t status = iree_dynamic_library_load_from_file(
+      load_path, flags, allocator, out_library);
+
+  iree_allocator_free(allocator, temp_path);
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
 }
 
 // TODO(#3845): use dlopen on an fd with either dlopen(/proc/self/fd/NN),
@@ -240,6 +324,15 @@ iree_status_t iree_dynamic_library_load_from_memory(
   iree_call_once(&iree_dynamic_library_temp_dir_init_once_flag_,
                  iree_dynamic_library_init_temp_dir);
 
+  // When a cross-process cache directory is configured serve the library from
+  // a shared content-addressed file instead of a private temp file.
+  if (iree_dynamic_library_cache_dir_valid_) {
+    iree_status_t status = iree_dynamic_library_load_from_cache_dir(
+        buffer, flags, allocator, out_library);
+    IREE_TRACE_ZONE_END(z0);
+    return status;
+  }
+
   if (!iree_dynamic_library_temp_dir_valid_) {
     return iree_make_status(
         IREE_STATUS_INVALID_ARGUMENT,
@@ -38,6 +38,9 @@
 
 static iree_status_t iree_file_map_contents_readonly_platform(
     const char* path, iree_file_contents_t* contents);
+static void iree_file_contents_advise_platform(
+    iree_file_contents_t* contents, iree_host_size_t offset,
+    iree_host_size_t length, iree_file_contents_advice_t advice);
 static void iree_file_contents_free_platform(iree_file_contents_t* contents);
 
 iree_status_t iree_file_exists(const char* path) {
@@ -122,6 +125,17 @@ void iree_file_contents_free(iree_file_contents_t* contents) {
   IREE_TRACE_ZONE_END(z0);
 }
 
+void iree_file_contents_advise(iree_file_contents_t* contents,
+                               iree_host_size_t offset,
+                               iree_host_size_t length,
+                               iree_file_contents_advice_t advice) {
+  if (!contents || !contents->mapping) return;  // only mapped contents
+  if (offset >= contents->const_buffer.data_length) return;
+  length = iree_min(length, contents->const_buffer.data_length - offset);
+  if (!length) return;
+  iree_file_contents_advise_platform(contents, offset, length, advice);
+}
+
 iree_status_t iree_file_read_contents(const char* path,
                                       iree_file_read_flags_t flags,
                                       iree_allocator_t allocator,
@@ -129,7 +143,25 @@ iree_status_t iree_file_read_contents(const char* path,
   if (iree_all_bits_set(flags, IREE_FILE_READ_FLAG_PRELOAD)) {
     return iree_file_preload_contents(path, allocator, out_contents);
   } else if (iree_all_bits_set(flags, IREE_FILE_READ_FLAG_MMAP)) {
-    return iree_file_map_contents_readonly(path, allocator, out_contents);
+    IREE_RETURN_IF_ERROR(
+        iree_file_map_contents_readonly(path, allocator, out_contents));
+    if (iree_all_bits_set(flags, IREE_FILE_READ_FLAG_RANDOM_ACCESS)) {
+      // Only a sparse subset of the file is expected to be touched; disable
+      // readahead so that sparse access does not fault in unrelated pages and
+      // resident set size stays proportional to what is actually used.
+      iree_file_contents_advise(*out_contents, 0,
+                                (*out_contents)->const_buffer.data_length,
+                                IREE_FILE_CONTENTS_ADVICE_RANDOM);
+    } else {
+      // Hint that we expect to read the contents soon so the OS can begin
+      // asynchronous readahead. Unlike preloading the pages remain clean and
+      // evictable and are shared via the page cache with any other process
+      // mapping the same file.
+      iree_file_contents_advise(*out_contents, 0,
+                                (*out_contents)->const_buffer.data_length,
+                                IREE_FILE_CONTENTS_ADVICE_WILLNEED);
+    }
+    return iree_ok_status();
   } else {
     return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
                             "invalid read flag mode");
@@ -270,6 +302,16 @@ static iree_status_t iree_file_map_contents_readonly_platform(
     return iree_make_status(iree_status_code_from_errno(errno), "mmap failed");
   }
 
+#if defined(MADV_HUGEPAGE)
+  // Large mappings (parameter/weight files) benefit from huge page backing to
+  // reduce dTLB pressure during dispatch. Requires a kernel with file-backed
+  // THP enabled; older kernels ignore or reject the advice and keep normal
+  // pages. Advisory-only: failures are ignored.
+  if (length >= 2 * 1024 * 1024) {
+    madvise(ptr, (size_t)length, MADV_HUGEPAGE);
+  }
+#endif  // MADV_HUGEPAGE
+
   contents->const_buffer =
       iree_make_const_byte_span(ptr, (iree_host_size_t)length);
   return iree_ok_status();
@@ -310,6 +352,42 @@ static iree_status_t iree_file_create_mapped_platform(
   return iree_ok_status();
 }
 
+static void iree_file_contents_advise_platform(
+    iree_file_contents_t* contents, iree_host_size_t offset,
+    iree_host_size_t length, iree_file_contents_advice_t advice) {
+  int posix_advice = MADV_NORMAL;
+  switch (advice) {
+    case IREE_FILE_CONTENTS_ADVICE_NORMAL:
+      posix_advice = MADV_NORMAL;
+      break;
+    case IREE_FILE_CONTENTS_ADVICE_SEQUENTIAL:
+      posix_advice = MADV_SEQUENTIAL;
+      break;
+    case IREE_FILE_CONTENTS_ADVICE_RANDOM:
+      posix_advice = MADV_RANDOM;
+      break;
+    case IREE_FILE_CONTENTS_ADVICE_WILLNEED:
+      posix_advice = MADV_WILLNEED;
+      break;
+    case IREE_FILE_CONTENTS_ADVICE_DONTNEED:
+      // Safe on shared file mappings: clean pages are dropped and refault from
+      // the file on next access.
+      posix_advice = MADV_DONTNEED;
+      break;
+    default:
+      return;
+  }
+  // Round the range out to page boundaries as required by madvise.
+  size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+  uintptr_t base = (uintptr_t)contents->buffer.data + offset;
+  uintptr_t aligned_base = base & ~(uintptr_t)(page_size - 1);
+  size_t aligned_length =
+      (size_t)(base + length - aligned_base + page_size - 1) &
+      ~(size_t)(page_size - 1);
+  // Advisory-only: failures are ignored.
+  madvise((void*)aligned_base, aligned_length, posix_advice);
+}
+
 static void iree_file_contents_free_platform(iree_file_contents_t* contents) {
   if (contents->mapping) {
     munmap(contents->buffer.data, (size_t)contents->buffer.data_length);
@@ -430,6 +508,27 @@ static iree_status_t iree_file_create_mapped_platform(
   return iree_ok_status();
 }
 
+static void iree_file_contents_advise_platform(
+    iree_file_contents_t* contents, iree_host_size_t offset,
+    iree_host_size_t length, iree_file_contents_advice_t advice) {
+  switch (advice) {
+    case IREE_FILE_CONTENTS_ADVICE_WILLNEED: {
+      // Begin asynchronous prefetch of the range. Advisory-only: failures
+      // (including running on pre-Win8 kernels) are ignored.
+      WIN32_MEMORY_RANGE_ENTRY range = {
+          .VirtualAddress = contents->buffer.data + offset,
+          .NumberOfBytes = (SIZE_T)length,
+      };
+      PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+      break;
+    }
+    default:
+      // No Windows equivalent for the remaining advice values; the OS manages
+      // readahead and residency of mapped views on its own.
+      break;
+  }
+}
+
 static void iree_file_contents_free_platform(iree_file_contents_t* contents) {
   if (contents->mapping) {
     UnmapViewOfFile(contents->buffer.data);
@@ -452,6 +551,10 @@ static iree_status_t iree_file_create_mapped_platform(
                           "file mapping not supported on this platform");
 }
 
+static void iree_file_contents_advise_platform(
+    iree_file_contents_t* contents, iree_host_size_t offset,
+    iree_host_size_t length, iree_file_contents_advice_t advice) {}
+
 static void iree_file_contents_free_platform(iree_file_contents_t* contents) {}
 
 #endif  // IREE_PLATFORM_*
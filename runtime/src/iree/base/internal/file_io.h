@@ -46,9 +46,42 @@ iree_allocator_t iree_file_contents_deallocator(iree_file_contents_t* contents);
 // Frees memory associated with |contents|.
 void iree_file_contents_free(iree_file_contents_t* contents);
 
+// Access-pattern and residency advice for mapped file contents.
+typedef enum iree_file_contents_advice_e {
+  // No special access pattern; resets prior sequential/random advice.
+  IREE_FILE_CONTENTS_ADVICE_NORMAL = 0,
+  // Range will be accessed front-to-back; the OS may read ahead aggressively
+  // and drop pages behind the access cursor.
+  IREE_FILE_CONTENTS_ADVICE_SEQUENTIAL,
+  // Range will be accessed in arbitrary order; disables readahead so that
+  // sparse access does not fault in unrelated pages.
+  IREE_FILE_CONTENTS_ADVICE_RANDOM,
+  // Range will be needed soon; the OS may begin asynchronous prefetch.
+  IREE_FILE_CONTENTS_ADVICE_WILLNEED,
+  // Range is not needed soon; clean mapped pages may be dropped from
+  // residency and will be reloaded from the file on next access.
+  IREE_FILE_CONTENTS_ADVICE_DONTNEED,
+} iree_file_contents_advice_t;
+
+// Applies access-pattern/residency |advice| to a byte range of |contents|.
+// No-op for contents not backed by a file mapping (preloaded and allocated
+// buffers own their memory outright) and on platforms without an madvise
+// equivalent. The range is rounded out to page boundaries as required by the
+// OS. Advisory-only: failures are silently ignored.
+void iree_file_contents_advise(iree_file_contents_t* contents,
+                               iree_host_size_t offset,
+                               iree_host_size_t length,
+                               iree_file_contents_advice_t advice);
+
 typedef enum iree_file_read_flag_bits_t {
   IREE_FILE_READ_FLAG_PRELOAD = (1u << 0),
   IREE_FILE_READ_FLAG_MMAP = (1u << 1),
+  // Valid with IREE_FILE_READ_FLAG_MMAP: contents will be accessed in
+  // arbitrary order and the mapping is advised as random-access instead of
+  // being prefetched. Use when only a sparse subset of a large file is
+  // expected to be touched and resident set size matters more than first
+  // access latency.
+  IREE_FILE_READ_FLAG_RANDOM_ACCESS = (1u << 2),
   IREE_FILE_READ_FLAG_DEFAULT = IREE_FILE_READ_FLAG_PRELOAD,
 } iree_file_read_flags_t;
 
@@ -183,6 +183,35 @@ iree_status_t iree_wait_all(iree_wait_set_t* set, iree_time_t deadline_ns);
 iree_status_t iree_wait_any(iree_wait_set_t* set, iree_time_t deadline_ns,
                             iree_wait_handle_t* out_wake_handle);
 
+// Blocks the caller until at least one handle in the set is signaled or
+// |deadline_ns| elapses, reporting a batch of signaled handles.
+//
+// Up to |wake_handle_capacity| signaled handles are written to
+// |out_wake_handles| (with set_internal.index populated for fast erasure) and
+// the count stored in |out_wake_count|. Unlike iree_wait_any - which reports a
+// single handle and forces callers to re-query the remaining handles - this
+// retrieves all readiness information produced by one system wait so that
+// callers dispatching many concurrent waits (wait set pollers, loops) pay one
+// syscall per pump regardless of how many handles resolved.
+//
+// Implementations report as many signaled handles as their underlying wait
+// API surfaces in a single operation; some (win32, inproc) only report one
+// per call and callers must treat the batch as best-effort, using per-handle
+// queries for anything not reported.
+//
+// A deadline of IREE_TIME_INFINITE_PAST will act as a poll and not block the
+// caller. IREE_TIME_INFINITE_FUTURE can be used to block until signaled.
+//
+// Returns IREE_STATUS_DEADLINE_EXCEEDED if the deadline elapses without any
+// handle having been signaled.
+//
+// iree_wait_set_t is thread-compatible; only one thread may be manipulating or
+// waiting on a set at any time.
+iree_status_t iree_wait_set_poll(iree_wait_set_t* set, iree_time_t deadline_ns,
+                                 iree_host_size_t wake_handle_capacity,
+                                 iree_wait_handle_t* out_wake_handles,
+                                 iree_host_size_t* out_wake_count);
+
 // Blocks the caller until the given wait handle is signaled or |deadline_ns|
 // elapses. This is functionally equivalent to iree_wait_any/iree_wait_all used
 // on a set with a single handle in it but depending on the implementation may
@@ -9,57 +9,434 @@
 
 #if IREE_WAIT_API == IREE_WAIT_API_EPOLL
 
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
 #include "iree/base/internal/wait_handle_posix.h"
 
+//===----------------------------------------------------------------------===//
+// Platform utilities
+//===----------------------------------------------------------------------===//
+
+// epoll keeps the interest set in the kernel so each wait is O(ready events)
+// instead of O(total handles) as with poll/ppoll. That makes it a good fit for
+// long-lived sets with many mostly-idle handles such as the task system
+// poller. The tradeoff is that set mutations (insert/erase) become syscalls,
+// which is fine for our usage where waits vastly outnumber mutations.
+//
+// Documentation: https://man7.org/linux/man-pages/man7/epoll.7.html
+
+// Number of events fetched per epoll_wait syscall; larger values let wait-all
+// make more progress per syscall at only the cost of stack space.
+#define IREE_WAIT_SET_EPOLL_BATCH_SIZE 16
+
+// Makes the epoll_wait syscall with a timeout derived from |deadline_ns|,
+// retrying if interrupted.
+static iree_status_t iree_syscall_epoll_wait(int epoll_fd,
+                                             struct epoll_event* out_events,
+                                             int max_event_count,
+                                             iree_time_t deadline_ns,
+                                             int* out_signaled_count) {
+  *out_signaled_count = 0;
+  int rv = -1;
+  do {
+    // NOTE: epoll_wait only has millisecond granularity; the timeout must be
+    // recomputed each iteration of the loop as a previous wait may have taken
+    // some of the time.
+    uint32_t timeout_ms = iree_absolute_deadline_to_timeout_ms(deadline_ns);
+    rv = epoll_wait(epoll_fd, out_events, max_event_count,
+                    timeout_ms == UINT32_MAX ? -1 : (int)timeout_ms);
+  } while (rv < 0 && errno == EINTR);
+  if (rv > 0) {
+    // One or more events set.
+    *out_signaled_count = rv;
+    return iree_ok_status();
+  } else if (IREE_UNLIKELY(rv < 0)) {
+    return iree_make_status(iree_status_code_from_errno(errno),
+                            "epoll_wait failure %d", errno);
+  }
+  // rv == 0
+  // Timeout elapsed with no events set.
+  return iree_status_from_code(IREE_STATUS_DEADLINE_EXCEEDED);
+}
+
+// Maps an epoll events bitfield to a status (on failure) and an indicator of
+// whether the fd was signaled for reading.
+static iree_status_t iree_wait_set_resolve_epoll_events(uint32_t events,
+                                                        bool* out_signaled) {
+  *out_signaled = false;
+  if (IREE_UNLIKELY(events & EPOLLERR)) {
+    return iree_make_status(IREE_STATUS_INTERNAL, "EPOLLERR on fd");
+  } else if (IREE_UNLIKELY(events & EPOLLHUP)) {
+    return iree_make_status(IREE_STATUS_CANCELLED, "EPOLLHUP on fd");
+  }
+  *out_signaled = (events & (EPOLLIN | EPOLLPRI)) != 0;
+  return iree_ok_status();
+}
+
 //===----------------------------------------------------------------------===//
 // iree_wait_set_t
 //===----------------------------------------------------------------------===//
 
-// TODO(benvanik): iree_wait_set_s using an epoll fd.
-// epoll lets us route the wait set operations right to kernel and not need our
-// own duplicate data structure. epoll is great, just not available on mac/ios
-// so we still need poll for that. linux/android/bsd all have epoll, though.
 struct iree_wait_set_t {
-  // NOTE: we could in theory use the epoll handle directly (iree_wait_set_s
-  // then is just a pointer). Then allocate/free just go straight to the system.
-  int reserved;
+  iree_allocator_t allocator;
+
+  // Kernel-managed interest set each unique fd is registered with.
+  int epoll_fd;
+
+  // Total capacity of handles in the set.
+  iree_host_size_t handle_capacity;
+
+  // Total number of valid user_handles.
+  iree_host_size_t handle_count;
+
+  // User-provided handles with their original type/value preserved. We need
+  // these to return unmodified handles from iree_wait_any as well as to map
+  // ready fds reported by the kernel back to the handles wrapping them. Sets
+  // are expected to remain small so linear scans are fine.
+  iree_wait_handle_t* user_handles;
 };
 
+// Returns true if any user handle besides the one at |excluded_index| wraps
+// the given |fd|. Duplicate insertions of the same handle share one kernel
+// registration and we must only deregister once the last copy is erased.
+static bool iree_wait_set_contains_other_fd(iree_wait_set_t* set, int fd,
+                                            iree_host_size_t excluded_index) {
+  for (iree_host_size_t i = 0; i < set->handle_count; ++i) {
+    if (i == excluded_index) continue;
+    if (iree_wait_primitive_get_read_fd(&set->user_handles[i]) == fd) {
+      return true;
+    }
+  }
+  return false;
+}
+
 iree_status_t iree_wait_set_allocate(iree_host_size_t capacity,
                                      iree_allocator_t allocator,
                                      iree_wait_set_t** out_set) {
-  // TODO(benvanik): epoll_create()
+  IREE_ASSERT_ARGUMENT(out_set);
+
+  // Be reasonable; 64K objects is too high.
+  if (capacity >= UINT16_MAX) {
+    return iree_make_status(
+        IREE_STATUS_INVALID_ARGUMENT,
+        "wait set capacity of %" PRIhsz " is unreasonably large", capacity);
+  }
+
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_host_size_t user_handle_list_size =
+      capacity * iree_sizeof_struct(iree_wait_handle_t);
+  iree_host_size_t total_size =
+      iree_sizeof_struct(iree_wait_set_t) + user_handle_list_size;
+
+  iree_wait_set_t* set = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(allocator, total_size, (void**)&set));
+  set->allocator = allocator;
+  set->handle_capacity = capacity;
+  set->handle_count = 0;
+  set->user_handles =
+      (iree_wait_handle_t*)((uint8_t*)set +
+                            iree_sizeof_struct(iree_wait_set_t));
+
+  set->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  if (IREE_UNLIKELY(set->epoll_fd < 0)) {
+    int error_number = errno;
+    iree_allocator_free(allocator, set);
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(iree_status_code_from_errno(error_number),
+                            "epoll_create1 failure %d", error_number);
+  }
+
+  *out_set = set;
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
 }
 
 void iree_wait_set_free(iree_wait_set_t* set) {
-  // TODO(benvanik): close()
+  if (!set) return;
+  IREE_TRACE_ZONE_BEGIN(z0);
+  close(set->epoll_fd);
+  iree_allocator_free(set->allocator, set);
+  IREE_TRACE_ZONE_END(z0);
+}
+
+bool iree_wait_set_is_empty(const iree_wait_set_t* set) {
+  return set->handle_count == 0;
 }
 
 iree_status_t iree_wait_set_insert(iree_wait_set_t* set,
                                    iree_wait_handle_t handle) {
-  // TODO(benvanik): epoll_ctl(EPOLL_CTL_ADD)
+  if (set->handle_count + 1 > set->handle_capacity) {
+    return iree_make_status(IREE_STATUS_RESOURCE_EXHAUSTED,
+                            "wait set capacity reached");
+  }
+
+  int fd = iree_wait_primitive_get_read_fd(&handle);
+  if (fd >= 0) {
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN | EPOLLPRI;  // EPOLLERR | EPOLLHUP are implicit
+    event.data.fd = fd;
+    if (epoll_ctl(set->epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0 &&
+        errno != EEXIST) {
+      // NOTE: EEXIST indicates a duplicate of the handle is already present
+      // in the set; the existing registration covers this insertion too.
+      return iree_make_status(iree_status_code_from_errno(errno),
+                              "epoll_ctl(EPOLL_CTL_ADD) failure %d", errno);
+    }
+  }
+
+  iree_host_size_t index = set->handle_count++;
+  iree_wait_handle_t* user_handle = &set->user_handles[index];
+  iree_wait_handle_wrap_primitive(handle.type, handle.value, user_handle);
+
+  return iree_ok_status();
 }
 
 void iree_wait_set_erase(iree_wait_set_t* set, iree_wait_handle_t handle) {
-  // TODO(benvanik): epoll_ctl(EPOLL_CTL_DEL)
+  // Find the user handle in the set. This either requires a linear scan to
+  // find the matching user handle or - if valid - we can use the native index
+  // set after an iree_wait_any wake to do a quick lookup.
+  iree_host_size_t index = handle.set_internal.index;
+  if (IREE_UNLIKELY(index >= set->handle_count) ||
+      IREE_UNLIKELY(!iree_wait_primitive_compare_identical(
+          &set->user_handles[index], &handle))) {
+    // Fallback to a linear scan of (hopefully) a small list.
+    for (iree_host_size_t i = 0; i < set->handle_count; ++i) {
+      if (iree_wait_primitive_compare_identical(&set->user_handles[i],
+                                                &handle)) {
+        index = i;
+        break;
+      }
+    }
+  }
+
+  // Deregister from the kernel set unless a duplicate insertion remains.
+  int fd = iree_wait_primitive_get_read_fd(&handle);
+  if (fd >= 0 && !iree_wait_set_contains_other_fd(set, fd, index)) {
+    // NOTE: failures are ignored as the fd may have already been closed.
+    epoll_ctl(set->epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+  }
+
+  // Remove from the handle list.
+  // Since we make no guarantees about the order of the list we can just swap
+  // with the last value.
+  iree_host_size_t tail_index = set->handle_count - 1;
+  if (tail_index > index) {
+    memcpy(&set->user_handles[index], &set->user_handles[tail_index],
+           sizeof(*set->user_handles));
+  }
+  --set->handle_count;
 }
 
 void iree_wait_set_clear(iree_wait_set_t* set) {
-  // TODO(benvanik): close and reopen?
+  for (iree_host_size_t i = 0; i < set->handle_count; ++i) {
+    int fd = iree_wait_primitive_get_read_fd(&set->user_handles[i]);
+    if (fd >= 0 && !iree_wait_set_contains_other_fd(set, fd, i)) {
+      epoll_ctl(set->epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+    }
+  }
+  set->handle_count = 0;
 }
 
 iree_status_t iree_wait_all(iree_wait_set_t* set, iree_time_t deadline_ns) {
-  // TODO(benvanik): epoll_wait
+  // Make the syscall only when we have at least one valid fd.
+  // Don't use this as a sleep.
+  if (set->handle_count == 0) return iree_ok_status();
+
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Wait-all requires that we repeatedly wait until all handles have been
+  // signaled. epoll is level-triggered by default and already-signaled fds
+  // would be reported again on every wait so - much like the poll
+  // implementation neuters fds as they resolve - we temporarily deregister
+  // each fd once observed signaled and re-register them all before returning.
+  bool* signaled_flags = (bool*)iree_alloca(set->handle_count * sizeof(bool));
+  memset(signaled_flags, 0, set->handle_count * sizeof(bool));
+
+  iree_status_t status = iree_ok_status();
+  iree_host_size_t unsignaled_count = set->handle_count;
+  while (unsignaled_count > 0) {
+    struct epoll_event events[IREE_WAIT_SET_EPOLL_BATCH_SIZE];
+    int signaled_count = 0;
+    status =
+        iree_syscall_epoll_wait(set->epoll_fd, events, IREE_ARRAYSIZE(events),
+                                deadline_ns, &signaled_count);
+    if (!iree_status_is_ok(status)) break;
+    for (int i = 0; i < signaled_count; ++i) {
+      bool signaled = false;
+      status = iree_wait_set_resolve_epoll_events(events[i].events, &signaled);
+      if (!iree_status_is_ok(status)) break;
+      if (!signaled) continue;
+      // Mark all user handles wrapping the fd as signaled (duplicates share
+      // readiness) and deregister it so subsequent waits only report the
+      // remaining fds.
+      int fd = events[i].data.fd;
+      for (iree_host_size_t j = 0; j < set->handle_count; ++j) {
+        if (signaled_flags[j]) continue;
+        if (iree_wait_primitive_get_read_fd(&set->user_handles[j]) == fd) {
+          signaled_flags[j] = true;
+          --unsignaled_count;
+        }
+      }
+      epoll_ctl(set->epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+    }
+    if (!iree_status_is_ok(status)) break;
+  }
+
+  // Re-register any fds temporarily removed during the wait so that the next
+  // wait operation observes the full set again.
+  for (iree_host_size_t i = 0; i < set->handle_count; ++i) {
+    if (!signaled_flags[i]) continue;
+    int fd = iree_wait_primitive_get_read_fd(&set->user_handles[i]);
+    if (fd < 0) continue;
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN | EPOLLPRI;
+    event.data.fd = fd;
+    if (epoll_ctl(set->epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0 &&
+        errno != EEXIST && iree_status_is_ok(status)) {
+      status = iree_make_status(iree_status_code_from_errno(errno),
+                                "epoll_ctl(EPOLL_CTL_ADD) failure %d", errno);
+    }
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
 }
 
 iree_status_t iree_wait_any(iree_wait_set_t* set, iree_time_t deadline_ns,
                             iree_wait_handle_t* out_wake_handle) {
-  // TODO(benvanik): epoll_wait
+  // Make the syscall only when we have at least one valid fd.
+  // Don't use this as a sleep.
+  if (set->handle_count == 0) {
+    if (out_wake_handle) {
+      memset(out_wake_handle, 0, sizeof(*out_wake_handle));
+    }
+    return iree_ok_status();
+  }
+
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Wait-any only needs a single signaled event to resolve; we still fetch a
+  // small batch so that error events don't hide data events reported alongside
+  // them.
+  struct epoll_event events[IREE_WAIT_SET_EPOLL_BATCH_SIZE];
+  int signaled_count = 0;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_syscall_epoll_wait(set->epoll_fd, events, IREE_ARRAYSIZE(events),
+                                  deadline_ns, &signaled_count));
+
+  // Map the first signaled fd back to the user handle wrapping it; the index
+  // is stashed on the wake handle to give erase a fast path.
+  if (out_wake_handle) {
+    memset(out_wake_handle, 0, sizeof(*out_wake_handle));
+    for (int i = 0; i < signaled_count; ++i) {
+      bool signaled = false;
+      IREE_RETURN_AND_END_ZONE_IF_ERROR(
+          z0, iree_wait_set_resolve_epoll_events(events[i].events, &signaled));
+      if (!signaled) continue;
+      int fd = events[i].data.fd;
+      for (iree_host_size_t j = 0; j < set->handle_count; ++j) {
+        if (iree_wait_primitive_get_read_fd(&set->user_handles[j]) == fd) {
+          memcpy(out_wake_handle, &set->user_handles[j],
+                 sizeof(*out_wake_handle));
+          out_wake_handle->set_internal.index = j;
+          break;
+        }
+      }
+      if (out_wake_handle->type != IREE_WAIT_PRIMITIVE_TYPE_NONE) break;
+    }
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
+iree_status_t iree_wait_set_poll(iree_wait_set_t* set, iree_time_t deadline_ns,
+                                 iree_host_size_t wake_handle_capacity,
+                                 iree_wait_handle_t* out_wake_handles,
+                                 iree_host_size_t* out_wake_count) {
+  IREE_ASSERT_ARGUMENT(out_wake_handles);
+  IREE_ASSERT_ARGUMENT(out_wake_count);
+  *out_wake_count = 0;
+
+  // Make the syscall only when we have at least one valid fd.
+  // Don't use this as a sleep.
+  if (set->handle_count == 0) {
+    return iree_ok_status();
+  }
+
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // One epoll_wait fetching a batch of ready events; the persistent kernel
+  // registrations mean this is O(ready events) regardless of set size.
+  struct epoll_event events[IREE_WAIT_SET_EPOLL_BATCH_SIZE];
+  int signaled_count = 0;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_syscall_epoll_wait(set->epoll_fd, events, IREE_ARRAYSIZE(events),
+                                  deadline_ns, &signaled_count));
+
+  // Map each ready fd back to every user handle wrapping it (duplicate
+  // insertions of a handle share one kernel registration and readiness).
+  iree_host_size_t wake_count = 0;
+  for (int i = 0; i < signaled_count && wake_count < wake_handle_capacity;
+       ++i) {
+    bool signaled = false;
+    IREE_RETURN_AND_END_ZONE_IF_ERROR(
+        z0, iree_wait_set_resolve_epoll_events(events[i].events, &signaled));
+    if (!signaled) continue;
+    int fd = events[i].data.fd;
+    for (iree_host_size_t j = 0;
+         j < set->handle_count && wake_count < wake_handle_capacity; ++j) {
+      if (iree_wait_primitive_get_read_fd(&set->user_handles[j]) != fd) {
+        continue;
+      }
+      iree_wait_handle_t* wake_handle = &out_wake_handles[wake_count++];
+      memcpy(wake_handle, &set->user_handles[j], sizeof(*wake_handle));
+      wake_handle->set_internal.index = j;
+    }
+  }
+  *out_wake_count = wake_count;
+
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
 }
 
 iree_status_t iree_wait_one(iree_wait_handle_t* handle,
                             iree_time_t deadline_ns) {
-  // TODO(benvanik): just use poll?
+  // Single handles don't benefit from a kernel-managed set; a plain poll
+  // avoids the epoll fd setup/teardown entirely.
+  struct pollfd poll_fd;
+  poll_fd.fd = iree_wait_primitive_get_read_fd(handle);
+  if (poll_fd.fd == -1) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "invalid handle for wait");
+  }
+  poll_fd.events = POLLIN | POLLPRI;
+  poll_fd.revents = 0;
+
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  int rv = -1;
+  do {
+    uint32_t timeout_ms = iree_absolute_deadline_to_timeout_ms(deadline_ns);
+    rv = poll(&poll_fd, 1, timeout_ms == UINT32_MAX ? -1 : (int)timeout_ms);
+  } while (rv < 0 && errno == EINTR);
+
+  IREE_TRACE_ZONE_END(z0);
+  if (rv > 0) {
+    return iree_ok_status();
+  } else if (IREE_UNLIKELY(rv < 0)) {
+    return iree_make_status(iree_status_code_from_errno(errno),
+                            "poll failure %d", errno);
+  }
+  return iree_status_from_code(IREE_STATUS_DEADLINE_EXCEEDED);
 }
 
 #endif  // IREE_WAIT_API == IREE_WAIT_API_EPOLL
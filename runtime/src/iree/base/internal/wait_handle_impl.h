@@ -57,9 +57,12 @@
 #elif defined(IREE_PLATFORM_WINDOWS)
 #define IREE_WAIT_API IREE_WAIT_API_WIN32  // WFMO used in wait_handle_win32.c
 #else
-// TODO(benvanik): EPOLL on android/linux/bsd/etc.
 // TODO(benvanik): KQUEUE on mac/ios.
 // KQUEUE is not implemented yet. Use POLL for mac/ios
+// EPOLL is implemented for linux/android/bsd and can be selected by defining
+// IREE_WAIT_API=IREE_WAIT_API_EPOLL; it scales better with large mostly-idle
+// wait sets at the cost of syscalls on set mutation and millisecond timeout
+// granularity. PPOLL remains the default for its nanosecond deadlines.
 // Android ppoll requires API version >= 21
 #if !defined(IREE_PLATFORM_APPLE) && \
     (!defined(__ANDROID_API__) || __ANDROID_API__ >= 21)
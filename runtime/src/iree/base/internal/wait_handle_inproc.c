@@ -291,6 +291,23 @@ iree_status_t iree_wait_any(iree_wait_set_t* set, iree_time_t deadline_ns,
   return status;
 }
 
+iree_status_t iree_wait_set_poll(iree_wait_set_t* set, iree_time_t deadline_ns,
+                                 iree_host_size_t wake_handle_capacity,
+                                 iree_wait_handle_t* out_wake_handles,
+                                 iree_host_size_t* out_wake_count) {
+  // The futex-based multi-wait only identifies a single woken handle per wait;
+  // degrade to iree_wait_any and report a best-effort batch of one. Callers
+  // fall back to per-handle queries for anything not reported.
+  *out_wake_count = 0;
+  iree_wait_handle_t wake_handle = iree_wait_handle_immediate();
+  IREE_RETURN_IF_ERROR(iree_wait_any(set, deadline_ns, &wake_handle));
+  if (wake_handle_capacity > 0 && !iree_wait_handle_is_immediate(wake_handle)) {
+    out_wake_handles[0] = wake_handle;
+    *out_wake_count = 1;
+  }
+  return iree_ok_status();
+}
+
 static bool iree_futex_handle_check(iree_futex_handle_t* futex) {
   return iree_atomic_load_int64(&futex->value, iree_memory_order_acquire) != 0;
 }
@@ -54,6 +54,13 @@ iree_status_t iree_wait_any(iree_wait_set_t* set, iree_time_t deadline_ns,
   // TODO(benvanik): kqueue support
 }
 
+iree_status_t iree_wait_set_poll(iree_wait_set_t* set, iree_time_t deadline_ns,
+                                 iree_host_size_t wake_handle_capacity,
+                                 iree_wait_handle_t* out_wake_handles,
+                                 iree_host_size_t* out_wake_count) {
+  // TODO(benvanik): kqueue support
+}
+
 iree_status_t iree_wait_one(iree_wait_handle_t* handle,
                             iree_time_t deadline_ns) {
   // TODO(benvanik): kqueue support
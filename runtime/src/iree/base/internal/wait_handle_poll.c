@@ -378,6 +378,48 @@ iree_status_t iree_wait_any(iree_wait_set_t* set, iree_time_t deadline_ns,
   return iree_ok_status();
 }
 
+iree_status_t iree_wait_set_poll(iree_wait_set_t* set, iree_time_t deadline_ns,
+                                 iree_host_size_t wake_handle_capacity,
+                                 iree_wait_handle_t* out_wake_handles,
+                                 iree_host_size_t* out_wake_count) {
+  IREE_ASSERT_ARGUMENT(out_wake_handles);
+  IREE_ASSERT_ARGUMENT(out_wake_count);
+  *out_wake_count = 0;
+
+  // Make the syscall only when we have at least one valid fd.
+  // Don't use this as a sleep.
+  if (set->handle_count <= 0) {
+    return iree_ok_status();
+  }
+
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // One poll over the persistent pollfd list; the kernel reports readiness for
+  // every fd in revents so a single syscall captures the full batch.
+  int signaled_count = 0;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_syscall_poll(set->poll_fds, set->handle_count, deadline_ns,
+                            &signaled_count));
+
+  // Gather all signaled handles up to the caller-provided capacity.
+  iree_host_size_t wake_count = 0;
+  for (iree_host_size_t i = 0;
+       i < set->handle_count && wake_count < wake_handle_capacity; ++i) {
+    bool signaled = false;
+    IREE_RETURN_AND_END_ZONE_IF_ERROR(
+        z0,
+        iree_wait_set_resolve_poll_events(set->poll_fds[i].revents, &signaled));
+    if (!signaled) continue;
+    iree_wait_handle_t* wake_handle = &out_wake_handles[wake_count++];
+    memcpy(wake_handle, &set->user_handles[i], sizeof(*wake_handle));
+    wake_handle->set_internal.index = i;
+  }
+  *out_wake_count = wake_count;
+
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
 iree_status_t iree_wait_one(iree_wait_handle_t* handle,
                             iree_time_t deadline_ns) {
   struct pollfd poll_fds;
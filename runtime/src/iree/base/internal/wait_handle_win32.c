@@ -377,6 +377,23 @@ iree_status_t iree_wait_any(iree_wait_set_t* set, iree_time_t deadline_ns,
   return status;
 }
 
+iree_status_t iree_wait_set_poll(iree_wait_set_t* set, iree_time_t deadline_ns,
+                                 iree_host_size_t wake_handle_capacity,
+                                 iree_wait_handle_t* out_wake_handles,
+                                 iree_host_size_t* out_wake_count) {
+  // WaitForMultipleObjectsEx only identifies the lowest-indexed signaled
+  // handle; degrade to iree_wait_any and report a best-effort batch of one.
+  // Callers fall back to per-handle queries for anything not reported.
+  *out_wake_count = 0;
+  iree_wait_handle_t wake_handle = iree_wait_handle_immediate();
+  IREE_RETURN_IF_ERROR(iree_wait_any(set, deadline_ns, &wake_handle));
+  if (wake_handle_capacity > 0 && !iree_wait_handle_is_immediate(wake_handle)) {
+    out_wake_handles[0] = wake_handle;
+    *out_wake_count = 1;
+  }
+  return iree_ok_status();
+}
+
 iree_status_t iree_wait_one(iree_wait_handle_t* handle,
                             iree_time_t deadline_ns) {
   if (handle->type == IREE_WAIT_PRIMITIVE_TYPE_NONE) {
@@ -7,6 +7,7 @@
 #include "iree/base/loop_sync.h"
 
 #include "iree/base/internal/math.h"
+#include "iree/base/internal/synchronization.h"
 #include "iree/base/internal/wait_handle.h"
 
 //===----------------------------------------------------------------------===//
@@ -732,6 +733,130 @@ static void iree_loop_wait_list_abort_all(iree_loop_wait_list_t* wait_list) {
   IREE_TRACE_ZONE_END(z0);
 }
 
+//===----------------------------------------------------------------------===//
+// iree_loop_post_ring_t
+//===----------------------------------------------------------------------===//
+
+// A completion posted to the loop from an external thread.
+typedef struct iree_loop_post_op_t {
+  iree_loop_callback_t callback;
+  // Owned by the ring until transferred to the callback.
+  iree_status_t status;
+} iree_loop_post_op_t;
+
+// Multi-producer ringbuffer of completions posted from external threads.
+// Producers append under |mutex| and signal |wake_event| to interrupt any
+// in-progress system wait on the loop thread. The loop thread drains the ring
+// in batches into the run ring at the top of each pump so that posted
+// callbacks are sequenced with other runnable work.
+//
+// The wake event is registered with the loop wait set for the lifetime of the
+// loop so that a post can rouse the loop thread regardless of which handles it
+// is currently blocked on. Platforms without usable wait primitives cannot
+// support cross-thread posting and the loop degrades to its prior
+// single-threaded-only behavior.
+typedef iree_alignas(iree_max_align_t) struct iree_loop_post_ring_t {
+  // Guards ring state; producers may post concurrently with each other and
+  // with the loop thread draining the ring.
+  iree_slim_mutex_t mutex;
+  // Signaled when ops are pending and reset once the ring has fully drained.
+  iree_event_t wake_event;
+  // True if |wake_event| was created and registered with the wait set.
+  // When false cross-thread posting is unavailable.
+  bool wake_event_registered;
+  // Current storage capacity of |ops|.
+  uint32_t capacity;
+  // Index into |ops| where the next operation to be dequeued is located.
+  uint32_t read_head;
+  // Index into |ops| where the last operation to be enqueued is located.
+  uint32_t write_head;
+  // Ringbuffer storage.
+  iree_loop_post_op_t ops[0];
+} iree_loop_post_ring_t;
+
+static iree_host_size_t iree_loop_post_ring_storage_size(
+    iree_loop_sync_options_t options) {
+  return sizeof(iree_loop_post_ring_t) +
+         options.max_queue_depth * sizeof(iree_loop_post_op_t);
+}
+
+static inline uint32_t iree_loop_post_ring_mask(
+    const iree_loop_post_ring_t* post_ring) {
+  return post_ring->capacity - 1;
+}
+
+static void iree_loop_post_ring_initialize(
+    iree_loop_sync_options_t options, iree_loop_wait_list_t* wait_list,
+    iree_loop_post_ring_t* out_post_ring) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_slim_mutex_initialize(&out_post_ring->mutex);
+  out_post_ring->capacity = (uint32_t)options.max_queue_depth;
+  out_post_ring->read_head = 0;
+  out_post_ring->write_head = 0;
+
+  // Try to create the wake event and register it with the wait set.
+  // Platforms without wait primitives (or without wait set support) cannot
+  // accept cross-thread posts; we disable posting instead of failing loop
+  // creation so that single-threaded use keeps working as before.
+  out_post_ring->wake_event_registered = false;
+  iree_status_t status = iree_event_initialize(/*initial_state=*/false,
+                                               &out_post_ring->wake_event);
+  if (iree_status_is_ok(status)) {
+    status =
+        iree_wait_set_insert(wait_list->wait_set, out_post_ring->wake_event);
+    if (iree_status_is_ok(status)) {
+      out_post_ring->wake_event_registered = true;
+    } else {
+      iree_event_deinitialize(&out_post_ring->wake_event);
+    }
+  }
+  iree_status_ignore(status);
+
+  IREE_TRACE_ZONE_END(z0);
+}
+
+static void iree_loop_post_ring_deinitialize(iree_loop_post_ring_t* post_ring,
+                                             iree_loop_wait_list_t* wait_list) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Expected abort to be called.
+  IREE_ASSERT(post_ring->read_head == post_ring->write_head);
+
+  if (post_ring->wake_event_registered) {
+    iree_wait_set_erase(wait_list->wait_set, post_ring->wake_event);
+    iree_event_deinitialize(&post_ring->wake_event);
+    post_ring->wake_event_registered = false;
+  }
+  iree_slim_mutex_deinitialize(&post_ring->mutex);
+
+  IREE_TRACE_ZONE_END(z0);
+}
+
+// Aborts all posted ops that have not yet been transferred to the run ring.
+// Each aborted op has its callback issued with IREE_STATUS_ABORTED.
+static void iree_loop_post_ring_abort_all(iree_loop_post_ring_t* post_ring) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  for (;;) {
+    iree_slim_mutex_lock(&post_ring->mutex);
+    bool has_op = post_ring->read_head != post_ring->write_head;
+    iree_loop_post_op_t op;
+    if (has_op) {
+      op = post_ring->ops[post_ring->read_head];
+      post_ring->read_head =
+          (post_ring->read_head + 1) & iree_loop_post_ring_mask(post_ring);
+    }
+    iree_slim_mutex_unlock(&post_ring->mutex);
+    if (!has_op) break;
+    iree_status_ignore(op.status);
+    iree_status_ignore(op.callback.fn(op.callback.user_data, iree_loop_null(),
+                                      iree_make_status(IREE_STATUS_ABORTED)));
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+}
+
 //===----------------------------------------------------------------------===//
 // iree_loop_sync_scope_t
 //===----------------------------------------------------------------------===//
@@ -767,10 +892,17 @@ typedef struct iree_loop_sync_t {
 
   iree_loop_run_ring_t* run_ring;
   iree_loop_wait_list_t* wait_list;
+  iree_loop_post_ring_t* post_ring;
+
+  // Scope that cross-thread posted callbacks are attributed to.
+  // Owned by the loop and has no error handler; callback failures abort any
+  // other posted work still pending.
+  iree_loop_sync_scope_t post_scope;
 
   // Trailing data:
   // + iree_loop_run_ring_storage_size
   // + iree_loop_wait_list_storage_size
+  // + iree_loop_post_ring_storage_size
 } iree_loop_sync_t;
 
 IREE_API_EXPORT iree_status_t iree_loop_sync_allocate(
@@ -795,6 +927,10 @@ IREE_API_EXPORT iree_status_t iree_loop_sync_allocate(
                             "wait list depth exceeds maximum");
   }
 
+  // Reserve a wait set slot for the post ring wake event so that user waits
+  // can still use the full requested capacity.
+  options.max_wait_count += 1;
+
   IREE_TRACE_ZONE_BEGIN(z0);
 
   const iree_host_size_t loop_sync_size =
@@ -803,8 +939,10 @@ IREE_API_EXPORT iree_status_t iree_loop_sync_allocate(
       iree_loop_run_ring_storage_size(options), iree_max_align_t);
   const iree_host_size_t wait_list_size = iree_host_align(
       iree_loop_wait_list_storage_size(options), iree_max_align_t);
+  const iree_host_size_t post_ring_size = iree_host_align(
+      iree_loop_post_ring_storage_size(options), iree_max_align_t);
   const iree_host_size_t total_storage_size =
-      loop_sync_size + run_ring_size + wait_list_size;
+      loop_sync_size + run_ring_size + wait_list_size + post_ring_size;
 
   uint8_t* storage = NULL;
   IREE_RETURN_AND_END_ZONE_IF_ERROR(
@@ -815,6 +953,9 @@ IREE_API_EXPORT iree_status_t iree_loop_sync_allocate(
   loop_sync->run_ring = (iree_loop_run_ring_t*)(storage + loop_sync_size);
   loop_sync->wait_list =
       (iree_loop_wait_list_t*)(storage + loop_sync_size + run_ring_size);
+  loop_sync->post_ring = (iree_loop_post_ring_t*)(storage + loop_sync_size +
+                                                  run_ring_size +
+                                                  wait_list_size);
 
   iree_status_t status = iree_ok_status();
   if (iree_status_is_ok(status)) {
@@ -824,6 +965,13 @@ IREE_API_EXPORT iree_status_t iree_loop_sync_allocate(
     status = iree_loop_wait_list_initialize(options, allocator,
                                             loop_sync->wait_list);
   }
+  if (iree_status_is_ok(status)) {
+    iree_loop_post_ring_initialize(options, loop_sync->wait_list,
+                                   loop_sync->post_ring);
+    iree_loop_sync_scope_initialize(loop_sync, /*error_fn=*/NULL,
+                                    /*error_user_data=*/NULL,
+                                    &loop_sync->post_scope);
+  }
 
   if (iree_status_is_ok(status)) {
     *out_loop_sync = loop_sync;
@@ -845,13 +993,17 @@ IREE_API_EXPORT void iree_loop_sync_free(iree_loop_sync_t* loop_sync) {
   // To ensure we don't enqueue more work while aborting we NULL out the lists.
   iree_loop_run_ring_t* run_ring = loop_sync->run_ring;
   iree_loop_wait_list_t* wait_list = loop_sync->wait_list;
+  iree_loop_post_ring_t* post_ring = loop_sync->post_ring;
   loop_sync->run_ring = NULL;
   loop_sync->wait_list = NULL;
+  loop_sync->post_ring = NULL;
+  iree_loop_post_ring_abort_all(post_ring);
   iree_loop_wait_list_abort_all(wait_list);
   iree_loop_run_ring_abort_all(run_ring);
 
   // After all operations are cleared we can release the data structures.
   iree_loop_run_ring_deinitialize(run_ring);
+  iree_loop_post_ring_deinitialize(post_ring, wait_list);
   iree_loop_wait_list_deinitialize(wait_list);
   iree_allocator_free(allocator, loop_sync);
 
@@ -936,6 +1088,85 @@ workgroup_failed:
   IREE_TRACE_ZONE_END(z0);
 }
 
+// Transfers cross-thread posted completions into the run ring in one batch.
+// Stops early if the run ring fills; the remaining ops stay queued (and the
+// wake event stays signaled) so the next pump picks them up after the run
+// ring has drained - natural backpressure without dropping work.
+static void iree_loop_sync_flush_posts(iree_loop_sync_t* loop_sync) {
+  iree_loop_post_ring_t* post_ring = loop_sync->post_ring;
+  if (!post_ring || !post_ring->wake_event_registered) return;
+
+  iree_slim_mutex_lock(&post_ring->mutex);
+  while (post_ring->read_head != post_ring->write_head) {
+    if (iree_loop_run_ring_is_full(loop_sync->run_ring)) {
+      // Out of run ring space; leave the rest for the next pump.
+      iree_slim_mutex_unlock(&post_ring->mutex);
+      return;
+    }
+    uint32_t slot = post_ring->read_head;
+    post_ring->read_head =
+        (post_ring->read_head + 1) & iree_loop_post_ring_mask(post_ring);
+    iree_loop_post_op_t op = post_ring->ops[slot];
+    iree_status_ignore(iree_loop_run_ring_enqueue(
+        loop_sync->run_ring,
+        (iree_loop_run_op_t){
+            .command = IREE_LOOP_COMMAND_CALL,
+            .scope = &loop_sync->post_scope,
+            .params =
+                {
+                    .call =
+                        {
+                            .callback = op.callback,
+                            .priority = IREE_LOOP_PRIORITY_DEFAULT,
+                        },
+                },
+            .status = op.status,
+        }));
+  }
+  iree_event_reset(&post_ring->wake_event);
+  iree_slim_mutex_unlock(&post_ring->mutex);
+}
+
+IREE_API_EXPORT iree_status_t iree_loop_sync_post(iree_loop_sync_t* loop_sync,
+                                                  iree_loop_callback_t callback,
+                                                  iree_status_t signal_status) {
+  IREE_ASSERT_ARGUMENT(loop_sync);
+  iree_loop_post_ring_t* post_ring = loop_sync->post_ring;
+  if (IREE_UNLIKELY(!post_ring)) {
+    return iree_make_status(
+        IREE_STATUS_FAILED_PRECONDITION,
+        "new work cannot be posted while the loop is shutting down");
+  }
+  if (IREE_UNLIKELY(!post_ring->wake_event_registered)) {
+    return iree_make_status(
+        IREE_STATUS_UNAVAILABLE,
+        "cross-thread posting requires platform wait primitives that are "
+        "unavailable in this configuration");
+  }
+
+  iree_slim_mutex_lock(&post_ring->mutex);
+  const uint32_t mask = iree_loop_post_ring_mask(post_ring);
+  if (((post_ring->write_head - post_ring->read_head) & mask) == mask) {
+    iree_slim_mutex_unlock(&post_ring->mutex);
+    return iree_make_status(
+        IREE_STATUS_RESOURCE_EXHAUSTED,
+        "post ringbuffer capacity %u exceeded; reduce the amount of "
+        "cross-thread work or pump the loop more frequently",
+        post_ring->capacity);
+  }
+  uint32_t slot = post_ring->write_head;
+  post_ring->write_head = (post_ring->write_head + 1) & mask;
+  post_ring->ops[slot] = (iree_loop_post_op_t){
+      .callback = callback,
+      .status = signal_status,
+  };
+  // Rouse the loop thread if it is blocked in a system wait; if it is running
+  // it will pick up the post at the top of its next pump.
+  iree_event_set(&post_ring->wake_event);
+  iree_slim_mutex_unlock(&post_ring->mutex);
+  return iree_ok_status();
+}
+
 // Drains work from the loop until all work in |scope| has completed.
 // A NULL |scope| indicates all work from all scopes should be drained.
 static iree_status_t iree_loop_sync_drain_scope(iree_loop_sync_t* loop_sync,
@@ -944,6 +1175,10 @@ static iree_status_t iree_loop_sync_drain_scope(iree_loop_sync_t* loop_sync,
   IREE_TRACE_ZONE_BEGIN(z0);
 
   do {
+    // Batch-transfer any completions posted from other threads so they are
+    // sequenced with other runnable work.
+    iree_loop_sync_flush_posts(loop_sync);
+
     // If we are draining a particular scope we can bail whenever there's no
     // more work remaining.
     if (scope && !scope->pending_count) break;
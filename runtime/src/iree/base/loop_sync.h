@@ -37,7 +37,9 @@ typedef struct iree_loop_sync_options_t {
 // behavior unless multi-waits are used.
 //
 // Thread-compatible: the loop only performs work when iree_loop_drain is
-// called and must not be used from multiple threads concurrently.
+// called and must not be used from multiple threads concurrently. The one
+// exception is iree_loop_sync_post which may be used to post completions from
+// other threads; posted callbacks always execute on the draining thread.
 typedef struct iree_loop_sync_t iree_loop_sync_t;
 
 // Allocates a synchronous loop using |allocator| stored into |out_loop_sync|.
@@ -54,6 +56,22 @@ IREE_API_EXPORT void iree_loop_sync_free(iree_loop_sync_t* loop_sync);
 IREE_API_EXPORT iree_status_t
 iree_loop_sync_wait_idle(iree_loop_sync_t* loop_sync, iree_timeout_t timeout);
 
+// Posts a completion |callback| to |loop_sync| from any thread.
+// Ownership of |signal_status| transfers to the callback, which will execute
+// on the thread draining the loop as if it had been scheduled with
+// iree_loop_call. If the draining thread is blocked in a system wait it will
+// be woken to run the callback; otherwise the callback is picked up at the
+// top of the next pump. Posting does not itself pump the loop: callers must
+// ensure the loop is (or will be) drained for posted callbacks to execute.
+//
+// Posted callbacks run against a loop-owned scope with no error handler and
+// any pending posts are aborted with IREE_STATUS_ABORTED when the loop is
+// freed. Returns IREE_STATUS_RESOURCE_EXHAUSTED if the post queue is full and
+// IREE_STATUS_UNAVAILABLE on platforms without usable wait primitives.
+IREE_API_EXPORT iree_status_t iree_loop_sync_post(iree_loop_sync_t* loop_sync,
+                                                  iree_loop_callback_t callback,
+                                                  iree_status_t signal_status);
+
 // Handles scope errors returned from loop callback operations.
 // Ownership of |status| is passed to the handler and must be freed.
 // All operations of the same scope will be aborted.
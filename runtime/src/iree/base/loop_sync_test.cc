@@ -50,3 +50,137 @@ void FreeLoop(iree_allocator_t allocator, iree_loop_t loop) {
 }
 
 // TODO(benvanik): test multiple scopes and scoped abort behavior.
+
+//===----------------------------------------------------------------------===//
+// iree_loop_sync_post
+//===----------------------------------------------------------------------===//
+// Cross-thread posting is specific to the sync loop implementation and not
+// covered by the shared suite above.
+
+static iree_loop_sync_t* AllocateLoopSync() {
+  iree_loop_sync_options_t options = {0};
+  options.max_queue_depth = 128;
+  options.max_wait_count = 32;
+  iree_loop_sync_t* loop_sync = NULL;
+  IREE_CHECK_OK(
+      iree_loop_sync_allocate(options, iree_allocator_system(), &loop_sync));
+  return loop_sync;
+}
+
+// Tests that a posted callback is run when the loop is pumped.
+TEST(LoopSyncPostTest, PostThenDrain) {
+  iree_loop_sync_t* loop_sync = AllocateLoopSync();
+
+  struct UserData {
+    bool did_callback = false;
+  } user_data;
+  IREE_ASSERT_OK(iree_loop_sync_post(
+      loop_sync,
+      iree_loop_callback_t{
+          +[](void* user_data_ptr, iree_loop_t loop, iree_status_t status) {
+            IREE_EXPECT_OK(status);
+            auto* user_data = reinterpret_cast<UserData*>(user_data_ptr);
+            user_data->did_callback = true;
+            return iree_ok_status();
+          },
+          &user_data,
+      },
+      iree_ok_status()));
+  IREE_ASSERT_OK(iree_loop_sync_wait_idle(loop_sync, iree_infinite_timeout()));
+  EXPECT_TRUE(user_data.did_callback);
+
+  iree_loop_sync_free(loop_sync);
+}
+
+// Tests that a post from another thread wakes a drain blocked in a system
+// wait: the loop blocks waiting on an event that only the posted callback
+// sets, so the test can only complete if the post interrupts the wait.
+TEST(LoopSyncPostTest, PostWakesBlockedWait) {
+  iree_loop_sync_t* loop_sync = AllocateLoopSync();
+  iree_status_t scope_status = iree_ok_status();
+  iree_loop_sync_scope_t scope;
+  iree_loop_sync_scope_initialize(
+      loop_sync,
+      +[](void* user_data, iree_status_t status) {
+        iree_status_t* status_ptr = (iree_status_t*)user_data;
+        if (iree_status_is_ok(*status_ptr)) {
+          *status_ptr = status;
+        } else {
+          iree_status_ignore(status);
+        }
+      },
+      &scope_status, &scope);
+  iree_loop_t loop = iree_loop_sync_scope(&scope);
+
+  struct UserData {
+    iree_event_t event;
+    bool did_post_callback = false;
+    bool did_wait_callback = false;
+  } user_data;
+  IREE_ASSERT_OK(
+      iree_event_initialize(/*initial_state=*/false, &user_data.event));
+
+  // NOTE: a finite (but long) timeout is required for the loop to enter a
+  // blocking system wait; the test would still pass with an infinite timeout
+  // but would spin-poll instead of exercising the wake path.
+  IREE_ASSERT_OK(iree_loop_wait_one(
+      loop, iree_event_await(&user_data.event), iree_make_timeout_ms(30000),
+      +[](void* user_data_ptr, iree_loop_t loop, iree_status_t status) {
+        IREE_EXPECT_OK(status);
+        auto* user_data = reinterpret_cast<UserData*>(user_data_ptr);
+        user_data->did_wait_callback = true;
+        return iree_ok_status();
+      },
+      &user_data));
+
+  std::thread thread([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    IREE_EXPECT_OK(iree_loop_sync_post(
+        loop_sync,
+        iree_loop_callback_t{
+            +[](void* user_data_ptr, iree_loop_t loop, iree_status_t status) {
+              IREE_EXPECT_OK(status);
+              auto* user_data = reinterpret_cast<UserData*>(user_data_ptr);
+              user_data->did_post_callback = true;
+              iree_event_set(&user_data->event);
+              return iree_ok_status();
+            },
+            &user_data,
+        },
+        iree_ok_status()));
+  });
+
+  IREE_ASSERT_OK(iree_loop_sync_wait_idle(loop_sync, iree_infinite_timeout()));
+  thread.join();
+  IREE_ASSERT_OK(scope_status);
+  EXPECT_TRUE(user_data.did_post_callback);
+  EXPECT_TRUE(user_data.did_wait_callback);
+
+  iree_event_deinitialize(&user_data.event);
+  iree_loop_sync_scope_deinitialize(&scope);
+  iree_loop_sync_free(loop_sync);
+}
+
+// Tests that pending posts are aborted when the loop is freed.
+TEST(LoopSyncPostTest, PostAbortedOnFree) {
+  iree_loop_sync_t* loop_sync = AllocateLoopSync();
+
+  struct UserData {
+    bool did_callback = false;
+  } user_data;
+  IREE_ASSERT_OK(iree_loop_sync_post(
+      loop_sync,
+      iree_loop_callback_t{
+          +[](void* user_data_ptr, iree_loop_t loop, iree_status_t status) {
+            IREE_EXPECT_STATUS_IS(IREE_STATUS_ABORTED, status);
+            auto* user_data = reinterpret_cast<UserData*>(user_data_ptr);
+            user_data->did_callback = true;
+            return iree_ok_status();
+          },
+          &user_data,
+      },
+      iree_ok_status()));
+
+  iree_loop_sync_free(loop_sync);
+  EXPECT_TRUE(user_data.did_callback);
+}
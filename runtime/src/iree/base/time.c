@@ -14,9 +14,152 @@
 #include "iree/base/target_platform.h"
 #include "iree/base/tracing.h"
 
+//===----------------------------------------------------------------------===//
+// Cycle counter fast path
+//===----------------------------------------------------------------------===//
+
+// Timestamps are taken extremely frequently (tracing, deadlines, semaphore
+// timeouts) and even the vDSO clock_gettime adds up at millions of calls/sec.
+// Where the architecture provides a constant-rate cycle counter readable from
+// user mode we sample it instead and convert to nanoseconds with a scale
+// periodically recalibrated against the system clock. The calibration state is
+// thread-local so no synchronization is required; each thread pays one system
+// clock query per calibration interval and the rest of its queries are a
+// counter read and a multiply.
+//
+// Define IREE_TIME_CYCLE_COUNTER=0 to always use the system clock.
+#if !defined(IREE_TIME_CYCLE_COUNTER)
+#if !defined(IREE_TIME_NOW_FN) &&                                      \
+    (defined(IREE_PLATFORM_ANDROID) || defined(IREE_PLATFORM_LINUX)) && \
+    (defined(IREE_ARCH_ARM_64) || defined(IREE_ARCH_X86_64)) &&         \
+    (defined(IREE_COMPILER_CLANG) || defined(IREE_COMPILER_GCC))
+#define IREE_TIME_CYCLE_COUNTER 1
+#else
+#define IREE_TIME_CYCLE_COUNTER 0
+#endif  // supported platform/arch/compiler
+#endif  // !IREE_TIME_CYCLE_COUNTER
+
+#if IREE_TIME_CYCLE_COUNTER
+
+#if defined(IREE_ARCH_X86_64)
+
+#include <cpuid.h>
+#include <x86intrin.h>
+
+// Returns true if the TSC runs at a constant rate regardless of frequency
+// scaling and power states (CPUID.80000007H:EDX[8], "invariant TSC").
+// Without it the counter is useless for timing and we fall back to the
+// system clock.
+static bool iree_time_cycle_counter_usable(void) {
+  uint32_t eax = 0, ebx = 0, ecx = 0, edx = 0;
+  if (!__get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx)) return false;
+  return (edx & (1u << 8)) != 0;
+}
+
+static inline uint64_t iree_time_query_cycle_counter(void) {
+  return __rdtsc();
+}
+
+#elif defined(IREE_ARCH_ARM_64)
+
+// The generic timer counter (cntvct_el0) is architecturally required to run
+// at a fixed frequency; no feature detection is needed.
+static bool iree_time_cycle_counter_usable(void) { return true; }
+
+static inline uint64_t iree_time_query_cycle_counter(void) {
+  uint64_t value = 0;
+  __asm__ volatile("mrs %0, cntvct_el0" : "=r"(value));
+  return value;
+}
+
+#endif  // IREE_ARCH_*
+
+// System clock query matching the non-fast-path iree_time_now behavior.
+static iree_time_t iree_time_now_system(void) {
+  struct timespec clock_time;
+  clock_gettime(CLOCK_REALTIME, &clock_time);
+  return clock_time.tv_sec * 1000000000ull + clock_time.tv_nsec;
+}
+
+// Minimum system-clock baseline required before trusting a computed scale;
+// shorter baselines amplify sampling jitter into the scale.
+#define IREE_TIME_CALIBRATION_MIN_BASELINE_NS 1000000ll /* 1ms */
+// How long converted timestamps are served before resampling the system
+// clock; bounds both drift and the latency of observing clock adjustments.
+#define IREE_TIME_CALIBRATION_INTERVAL_NS 10000000ll /* 10ms */
+// Maximum baseline age before it is restarted; keeps a single historical
+// clock step (NTP/settimeofday) from skewing the scale forever.
+#define IREE_TIME_CALIBRATION_MAX_BASELINE_NS 10000000000ll /* 10s */
+
+typedef struct iree_time_calibration_t {
+  // Oldest retained (counter, clock) sample pair; scale baseline.
+  uint64_t first_ticks;
+  iree_time_t first_time_ns;
+  // Most recent sample pair; fast-path conversion origin.
+  uint64_t base_ticks;
+  iree_time_t base_time_ns;
+  // Nanoseconds per counter tick in 32.32 fixed-point; 0 until calibrated.
+  uint64_t ns_per_tick_q32;
+  // Counter delta corresponding to IREE_TIME_CALIBRATION_INTERVAL_NS.
+  uint64_t recalibration_delta_ticks;
+  // 0 = not yet queried, 1 = counter usable, -1 = use system clock.
+  int usable;
+} iree_time_calibration_t;
+static __thread iree_time_calibration_t iree_time_calibration_tls;
+
+// Slow path: samples the system clock, refreshing the conversion scale from
+// the accumulated baseline when it is long enough to be trustworthy.
+static iree_time_t iree_time_recalibrate(iree_time_calibration_t* cal,
+                                         uint64_t ticks) {
+  iree_time_t now_ns = iree_time_now_system();
+  uint64_t delta_ticks = ticks - cal->first_ticks;
+  iree_time_t delta_ns = now_ns - cal->first_time_ns;
+  if (cal->first_ticks == 0 || delta_ns <= 0 || delta_ticks == 0 ||
+      delta_ns > IREE_TIME_CALIBRATION_MAX_BASELINE_NS) {
+    // First sample in this thread, a backwards clock step, or a stale
+    // baseline: restart the baseline and serve system clock queries until it
+    // is long enough to derive a scale from.
+    cal->first_ticks = ticks;
+    cal->first_time_ns = now_ns;
+    cal->ns_per_tick_q32 = 0;
+  } else if (delta_ns >= IREE_TIME_CALIBRATION_MIN_BASELINE_NS) {
+    cal->ns_per_tick_q32 =
+        (uint64_t)(((unsigned __int128)delta_ns << 32) / delta_ticks);
+    cal->recalibration_delta_ticks =
+        (uint64_t)(((unsigned __int128)IREE_TIME_CALIBRATION_INTERVAL_NS
+                    << 32) /
+                   cal->ns_per_tick_q32);
+  }
+  cal->base_ticks = ticks;
+  cal->base_time_ns = now_ns;
+  return now_ns;
+}
+
+static iree_time_t iree_time_now_fast(void) {
+  iree_time_calibration_t* cal = &iree_time_calibration_tls;
+  if (IREE_UNLIKELY(cal->usable == 0)) {
+    cal->usable = iree_time_cycle_counter_usable() ? 1 : -1;
+  }
+  if (IREE_UNLIKELY(cal->usable < 0)) return iree_time_now_system();
+  uint64_t ticks = iree_time_query_cycle_counter();
+  uint64_t delta_ticks = ticks - cal->base_ticks;
+  if (IREE_LIKELY(cal->ns_per_tick_q32 != 0 &&
+                  delta_ticks < cal->recalibration_delta_ticks)) {
+    return cal->base_time_ns +
+           (iree_time_t)(((unsigned __int128)delta_ticks *
+                          cal->ns_per_tick_q32) >>
+                         32);
+  }
+  return iree_time_recalibrate(cal, ticks);
+}
+
+#endif  // IREE_TIME_CYCLE_COUNTER
+
 IREE_API_EXPORT iree_time_t iree_time_now(void) {
 #if defined(IREE_TIME_NOW_FN)
   IREE_TIME_NOW_FN
+#elif IREE_TIME_CYCLE_COUNTER
+  return iree_time_now_fast();
 #elif defined(IREE_PLATFORM_WINDOWS)
   // GetSystemTimePreciseAsFileTime requires Windows 8, add a fallback
   // (such as using std::chrono) if older support is needed.
@@ -160,6 +160,50 @@
 typedef uint32_t iree_zone_id_t;
 #endif  // IREE_TRACING_PROVIDER_H
 
+//===----------------------------------------------------------------------===//
+// Zone sampling
+//===----------------------------------------------------------------------===//
+// Sampled variants of the zone macros for hot call sites where even the
+// fixed per-zone capture cost is measurable. Each site keeps a static counter
+// and once it has proven hot only 1/N executions emit a zone; N is configured
+// at runtime per subsystem category with iree_tracing_sampling_set_rate and
+// defaults to 1 (emit everything). Rarely executed sites always emit.
+//
+// Zones elided by sampling produce a zone_id of 0 and must be ended with
+// IREE_TRACE_ZONE_END_SAMPLED; other zone macros (append text/values/etc)
+// treat the zone as the enclosing parent in that case.
+
+#if (IREE_TRACING_FEATURES & IREE_TRACING_FEATURE_INSTRUMENTATION)
+
+#include "iree/base/tracing/sampling.h"
+
+// Begins a sampled zone with the parent function name.
+#define IREE_TRACE_ZONE_BEGIN_SAMPLED(zone_id, category) \
+  IREE_TRACE_ZONE_BEGIN_NAMED_SAMPLED(zone_id, NULL, category)
+
+// Begins a sampled zone with the given compile-time |name_literal|.
+#define IREE_TRACE_ZONE_BEGIN_NAMED_SAMPLED(zone_id, name_literal, category) \
+  static iree_tracing_sample_site_t zone_id##_sample_site;                   \
+  iree_zone_id_t zone_id = 0;                                                \
+  if (iree_tracing_sample_site_should_emit(&zone_id##_sample_site,           \
+                                           (category))) {                    \
+    IREE_TRACE_ZONE_BEGIN_NAMED(zone_id##_sampled_impl, name_literal);       \
+    zone_id = zone_id##_sampled_impl;                                        \
+  }
+
+// Ends a sampled zone. Must be passed the |zone_id| from the sampled _BEGIN.
+// Usable as an expression so it composes with the IF_ERROR helpers.
+#define IREE_TRACE_ZONE_END_SAMPLED(zone_id) \
+  (void)((zone_id) ? (IREE_TRACE_ZONE_END(zone_id), 0) : 0)
+
+// Ends the current sampled zone before returning on a failure.
+// Sugar for IREE_TRACE_ZONE_END_SAMPLED + IREE_RETURN_IF_ERROR.
+#define IREE_RETURN_AND_END_ZONE_IF_ERROR_SAMPLED(zone_id, ...) \
+  IREE_RETURN_AND_EVAL_IF_ERROR(IREE_TRACE_ZONE_END_SAMPLED(zone_id), \
+                                __VA_ARGS__)
+
+#endif  // IREE_TRACING_FEATURE_INSTRUMENTATION
+
 //===----------------------------------------------------------------------===//
 // Instrumentation macros (C)
 //===----------------------------------------------------------------------===//
@@ -250,9 +294,23 @@ enum {
     function_name_length, name, name_length)                   \
   IREE_TRACE_ZONE_BEGIN(zone_id)
 
+// Begins a sampled zone with the parent function name.
+#define IREE_TRACE_ZONE_BEGIN_SAMPLED(zone_id, category) \
+  IREE_TRACE_ZONE_BEGIN(zone_id)
+// Begins a sampled zone with the given compile-time |name_literal|.
+#define IREE_TRACE_ZONE_BEGIN_NAMED_SAMPLED(zone_id, name_literal, category) \
+  IREE_TRACE_ZONE_BEGIN(zone_id)
+
 // Ends the current zone. Must be passed the |zone_id| from the _BEGIN.
 #define IREE_TRACE_ZONE_END(zone_id) (void)(zone_id)
 
+// Ends a sampled zone. Must be passed the |zone_id| from the sampled _BEGIN.
+#define IREE_TRACE_ZONE_END_SAMPLED(zone_id) (void)(zone_id)
+
+// Ends the current sampled zone before returning on a failure.
+#define IREE_RETURN_AND_END_ZONE_IF_ERROR_SAMPLED(zone_id, ...) \
+  IREE_RETURN_IF_ERROR(__VA_ARGS__)
+
 // Ends the current zone before returning on a failure.
 // Sugar for IREE_TRACE_ZONE_END + IREE_RETURN_IF_ERROR.
 #define IREE_RETURN_AND_END_ZONE_IF_ERROR(zone_id, ...) \
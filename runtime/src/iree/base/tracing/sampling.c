@@ -0,0 +1,31 @@
+// Copyright 2023 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/base/tracing/sampling.h"
+
+// All categories default to emitting every execution so that instrumented
+// builds behave exactly as before until a rate is explicitly configured.
+uint32_t iree_tracing_sampling_rates[IREE_TRACING_CATEGORY_COUNT] = {
+    1, /* IREE_TRACING_CATEGORY_TASK */
+    1, /* IREE_TRACING_CATEGORY_HAL */
+    1, /* IREE_TRACING_CATEGORY_VM */
+};
+
+// Rounds |value| up to the next power of two (2^0 to 2^31).
+static uint32_t iree_tracing_round_up_to_pow2_u32(uint32_t value) {
+  if (value <= 1) return 1;
+  uint32_t result = 1;
+  while (result < value && result < 0x80000000u) result <<= 1;
+  return result;
+}
+
+void iree_tracing_sampling_set_rate(iree_tracing_category_t category,
+                                    uint32_t rate) {
+  if (category < 0 || category >= IREE_TRACING_CATEGORY_COUNT) return;
+  // Power-of-two rates let the per-site check mask instead of divide.
+  iree_tracing_sampling_rates[category] =
+      iree_tracing_round_up_to_pow2_u32(rate);
+}
@@ -0,0 +1,82 @@
+// Copyright 2023 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Per-zone-site trace sampling used by the IREE_TRACE_ZONE_*_SAMPLED macros.
+// Zones instrumented with the sampled macros keep a static per-call-site
+// counter and only emit 1/N executions once the site has proven hot; rarely
+// executed sites always emit so one-off events retain full fidelity. The
+// sampling rate is configured at runtime per subsystem category which allows
+// tracing to stay enabled in production at a bounded overhead.
+//
+// NOTE: this header is included by iree/base/tracing.h when a tracing
+// provider is configured and must remain C-compatible.
+
+#ifndef IREE_BASE_TRACING_SAMPLING_H_
+#define IREE_BASE_TRACING_SAMPLING_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "iree/base/attributes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+// Coarse subsystem categories that can have their sampling rate configured
+// independently at runtime.
+typedef enum iree_tracing_category_e {
+  IREE_TRACING_CATEGORY_TASK = 0,
+  IREE_TRACING_CATEGORY_HAL,
+  IREE_TRACING_CATEGORY_VM,
+  IREE_TRACING_CATEGORY_COUNT,
+} iree_tracing_category_t;
+
+// Number of executions a site always emits before sampling kicks in.
+// Sites that execute fewer times than this are captured in full; only sites
+// that prove hot are thinned to the configured rate.
+#define IREE_TRACING_SAMPLING_WARMUP_COUNT 16
+
+// Per-call-site sampling state; declared static at the zone site by the
+// IREE_TRACE_ZONE_*_SAMPLED macros.
+//
+// The counter is intentionally not atomic: concurrent increments may drop or
+// duplicate ticks which only perturbs which executions are sampled, never
+// correctness, and keeping the hot path to a plain load/increment is the
+// entire point.
+typedef struct iree_tracing_sample_site_t {
+  uint32_t counter;
+} iree_tracing_sample_site_t;
+
+// 1/N sampling rates per category, rounded up to powers of two.
+// A rate of <=1 emits every execution. Read directly by the inlined
+// should-emit check; written only by iree_tracing_sampling_set_rate.
+extern uint32_t iree_tracing_sampling_rates[IREE_TRACING_CATEGORY_COUNT];
+
+// Sets the sampling rate of |category| so that roughly 1/|rate| executions of
+// each hot zone site emit a trace event. |rate| is rounded up to a power of
+// two; 0 or 1 restores the default of emitting every execution.
+//
+// Thread-safe in the sense that concurrent zone emission observes either the
+// old or new rate; in-flight sampling decisions are not revisited.
+void iree_tracing_sampling_set_rate(iree_tracing_category_t category,
+                                    uint32_t rate);
+
+// Returns true if the current execution of the zone at |site| should emit.
+static inline bool iree_tracing_sample_site_should_emit(
+    iree_tracing_sample_site_t* site, iree_tracing_category_t category) {
+  uint32_t rate = iree_tracing_sampling_rates[category];
+  uint32_t ordinal = site->counter++;
+  if (IREE_LIKELY(rate <= 1)) return true;
+  if (ordinal < IREE_TRACING_SAMPLING_WARMUP_COUNT) return true;
+  return (ordinal & (rate - 1)) == 0;
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // IREE_BASE_TRACING_SAMPLING_H_
@@ -134,6 +134,69 @@ void iree_uk_mmt4d_tile_s8s8s32_16x16x2_x86_64_avx512_vnni(
   }
 }
 
+// K0=4 variant using VPDPBUSD, which performs twice as many multiply-adds per
+// instruction as the VPDPWSSD used in the K0=2 kernels above. VPDPBUSD
+// multiplies unsigned*signed bytes, so to handle our signed*signed case the
+// LHS bytes are biased into unsigned range by XOR'ing with 0x80 (adding 128).
+// That over-counts each product group by 128*sum4(rhs), a term independent of
+// the LHS row, so it is accumulated once per k iteration (as VPDPBUSD of an
+// all-128 LHS with the RHS) and subtracted from every accumulator at the end.
+IREE_UK_ATTRIBUTE_ALWAYS_INLINE static inline void
+iree_uk_mmt4d_tile_s8s8s32_1x16x4_to_16x16x4_x86_64_avx512_vnni(
+    void* IREE_UK_RESTRICT out_tile, const void* IREE_UK_RESTRICT lhs_panel,
+    const void* IREE_UK_RESTRICT rhs_panel,
+    const iree_uk_mmt4d_params_t* params, int M0) {
+  IREE_UK_ASSERT(M0 >= 1 && M0 <= 16 && iree_uk_is_po2_u32(M0));
+  iree_uk_int32_t* IREE_UK_RESTRICT out_ptr = out_tile;
+  const iree_uk_int8_t* IREE_UK_RESTRICT lhs_ptr = lhs_panel;
+  const iree_uk_int8_t* IREE_UK_RESTRICT rhs_ptr = rhs_panel;
+  const __m512i bias = _mm512_set1_epi8((char)0x80);
+  __m512i acc[16];
+  if (params->flags & IREE_UK_FLAG_MMT4D_ACCUMULATE) {
+    IREE_UK_UNROLL for (int i = 0; i < M0; ++i) {
+      acc[i] = _mm512_loadu_si512((__m512i*)(out_ptr + i * 16));
+    }
+  } else {
+    IREE_UK_UNROLL for (int i = 0; i < M0; ++i) {
+      acc[i] = _mm512_setzero_si512();
+    }
+  }
+  __m512i correction = _mm512_setzero_si512();
+
+  for (int k = 0; k < params->K; ++k) {
+    __m512i rhs = _mm512_loadu_si512((const __m512i*)rhs_ptr);
+    rhs_ptr += 64;
+    correction = _mm512_dpbusd_epi32(correction, bias, rhs);
+    IREE_UK_UNROLL for (int i = 0; i < M0; ++i) {
+      __m512i lhs_biased = _mm512_xor_si512(
+          _mm512_set1_epi32(*(const iree_uk_int32_t*)(lhs_ptr)), bias);
+      acc[i] = _mm512_dpbusd_epi32(acc[i], lhs_biased, rhs);
+      lhs_ptr += 4;
+    }
+  }
+
+  IREE_UK_UNROLL for (int i = 0; i < M0; ++i) {
+    _mm512_storeu_si512((__m512i*)(out_ptr + i * 16),
+                        _mm512_sub_epi32(acc[i], correction));
+  }
+}
+
+IREE_UK_MMT4D_TILE_FUNC_IMPL_FOR_M0(
+    iree_uk_mmt4d_tile_s8s8s32_1x16x4_to_16x16x4_x86_64_avx512_vnni,
+    iree_uk_mmt4d_tile_s8s8s32_1x16x4_x86_64_avx512_vnni, 1)
+IREE_UK_MMT4D_TILE_FUNC_IMPL_FOR_M0(
+    iree_uk_mmt4d_tile_s8s8s32_1x16x4_to_16x16x4_x86_64_avx512_vnni,
+    iree_uk_mmt4d_tile_s8s8s32_2x16x4_x86_64_avx512_vnni, 2)
+IREE_UK_MMT4D_TILE_FUNC_IMPL_FOR_M0(
+    iree_uk_mmt4d_tile_s8s8s32_1x16x4_to_16x16x4_x86_64_avx512_vnni,
+    iree_uk_mmt4d_tile_s8s8s32_4x16x4_x86_64_avx512_vnni, 4)
+IREE_UK_MMT4D_TILE_FUNC_IMPL_FOR_M0(
+    iree_uk_mmt4d_tile_s8s8s32_1x16x4_to_16x16x4_x86_64_avx512_vnni,
+    iree_uk_mmt4d_tile_s8s8s32_8x16x4_x86_64_avx512_vnni, 8)
+IREE_UK_MMT4D_TILE_FUNC_IMPL_FOR_M0(
+    iree_uk_mmt4d_tile_s8s8s32_1x16x4_to_16x16x4_x86_64_avx512_vnni,
+    iree_uk_mmt4d_tile_s8s8s32_16x16x4_x86_64_avx512_vnni, 16)
+
 IREE_UK_ATTRIBUTE_ALWAYS_INLINE static inline void
 iree_uk_mmt4d_tile_s16s16s32_1x16x2_to_16x16x2_x86_64_avx512_vnni(
     void* IREE_UK_RESTRICT out_tile, const void* IREE_UK_RESTRICT lhs_panel,
@@ -62,6 +62,11 @@ IREE_UK_MMT4D_TILE(x86_64, s8, s8, s32, 2, 16, 2, _avx512_vnni)
 IREE_UK_MMT4D_TILE(x86_64, s8, s8, s32, 4, 16, 2, _avx512_vnni)
 IREE_UK_MMT4D_TILE(x86_64, s8, s8, s32, 8, 16, 2, _avx512_vnni)
 IREE_UK_MMT4D_TILE(x86_64, s8, s8, s32, 16, 16, 2, _avx512_vnni)
+IREE_UK_MMT4D_TILE(x86_64, s8, s8, s32, 1, 16, 4, _avx512_vnni)
+IREE_UK_MMT4D_TILE(x86_64, s8, s8, s32, 2, 16, 4, _avx512_vnni)
+IREE_UK_MMT4D_TILE(x86_64, s8, s8, s32, 4, 16, 4, _avx512_vnni)
+IREE_UK_MMT4D_TILE(x86_64, s8, s8, s32, 8, 16, 4, _avx512_vnni)
+IREE_UK_MMT4D_TILE(x86_64, s8, s8, s32, 16, 16, 4, _avx512_vnni)
 IREE_UK_MMT4D_TILE(x86_64, s16, s16, s32, 1, 16, 2, _avx512_base)
 IREE_UK_MMT4D_TILE(x86_64, s16, s16, s32, 2, 16, 2, _avx512_base)
 IREE_UK_MMT4D_TILE(x86_64, s16, s16, s32, 4, 16, 2, _avx512_base)
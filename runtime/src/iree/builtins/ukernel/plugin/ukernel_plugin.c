@@ -0,0 +1,183 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Executable plugin servicing the `iree_uk_*` imports emitted when compiling
+// with --iree-codegen-ukernel-plugin-abi. Instead of linking ukernel bitcode
+// into each executable, the compiled artifact imports the ukernel entry points
+// and this plugin resolves them against the runtime's ukernel library, which
+// carries all CPU-feature variants and selects tile functions at dispatch time
+// from the processor data passed with each call. This keeps one deployable
+// artifact running at native speed across microarchitectures.
+//
+// The wrappers below unpack the HAL import calling convention (a packed struct
+// of all arguments followed by the requested extra fields, using native
+// packing/alignment rules) and forward to the public ukernel entry points.
+
+#include "iree/builtins/ukernel/api.h"
+#include "iree/hal/local/executable_plugin.h"
+
+// Matches the lowering of `iree_codegen.ukernel.generic "iree_uk_mmt4d"` with
+// strided_outer_dims(1) and hal.import.fields = ["processor_data"].
+static int iree_uk_plugin_mmt4d(void* params_ptr, void* context,
+                                void* reserved) {
+  typedef struct {
+    const void* lhs_buffer;
+    size_t lhs_offset;
+    size_t lhs_stride0;
+    const void* rhs_buffer;
+    size_t rhs_offset;
+    size_t rhs_stride0;
+    void* out_buffer;
+    size_t out_offset;
+    size_t out_stride0;
+    size_t M;
+    size_t N;
+    size_t K;
+    int32_t M0;
+    int32_t N0;
+    int32_t K0;
+    uint32_t flags;
+    const uint64_t* processor_data;
+  } params_t;
+  const params_t* params = (const params_t*)params_ptr;
+  iree_uk_mmt4d(params->lhs_buffer, params->lhs_offset, params->lhs_stride0,
+                params->rhs_buffer, params->rhs_offset, params->rhs_stride0,
+                params->out_buffer, params->out_offset, params->out_stride0,
+                params->M, params->N, params->K, params->M0, params->N0,
+                params->K0, params->flags, params->processor_data);
+  return 0;
+}
+
+// Matches the lowering of `iree_codegen.ukernel.generic "iree_uk_pack"`.
+static int iree_uk_plugin_pack(void* params_ptr, void* context,
+                               void* reserved) {
+  typedef struct {
+    const void* in_buffer;
+    size_t in_offset;
+    size_t in_stride0;
+    void* out_buffer;
+    size_t out_offset;
+    size_t out_stride0;
+    size_t in_size0;
+    size_t in_size1;
+    size_t out_size0;
+    size_t out_size1;
+    size_t out_size2;
+    size_t out_size3;
+    uint64_t padding_value;
+    uint32_t flags;
+    const uint64_t* processor_data;
+  } params_t;
+  const params_t* params = (const params_t*)params_ptr;
+  iree_uk_pack(params->in_buffer, params->in_offset, params->in_stride0,
+               params->out_buffer, params->out_offset, params->out_stride0,
+               params->in_size0, params->in_size1, params->out_size0,
+               params->out_size1, params->out_size2, params->out_size3,
+               params->padding_value, params->flags, params->processor_data);
+  return 0;
+}
+
+// Matches the lowering of `iree_codegen.ukernel.generic "iree_uk_unpack"`.
+static int iree_uk_plugin_unpack(void* params_ptr, void* context,
+                                 void* reserved) {
+  typedef struct {
+    const void* in_buffer;
+    size_t in_offset;
+    size_t in_stride0;
+    void* out_buffer;
+    size_t out_offset;
+    size_t out_stride0;
+    size_t in_size0;
+    size_t in_size1;
+    size_t in_size2;
+    size_t in_size3;
+    size_t out_size0;
+    size_t out_size1;
+    uint32_t flags;
+    const uint64_t* processor_data;
+  } params_t;
+  const params_t* params = (const params_t*)params_ptr;
+  iree_uk_unpack(params->in_buffer, params->in_offset, params->in_stride0,
+                 params->out_buffer, params->out_offset, params->out_stride0,
+                 params->in_size0, params->in_size1, params->in_size2,
+                 params->in_size3, params->out_size0, params->out_size1,
+                 params->flags, params->processor_data);
+  return 0;
+}
+
+// Stateless plugin: the ukernel library keeps no state and the CPU feature
+// data used for variant selection arrives with each call.
+static iree_hal_executable_plugin_status_t iree_uk_plugin_load(
+    const iree_hal_executable_plugin_environment_v0_t* environment,
+    size_t param_count, const iree_hal_executable_plugin_string_pair_t* params,
+    void** out_self) {
+  *out_self = NULL;
+  return iree_hal_executable_plugin_ok_status();
+}
+
+static void iree_uk_plugin_unload(void* self) {}
+
+static iree_hal_executable_plugin_status_t iree_uk_plugin_resolve(
+    void* self, const iree_hal_executable_plugin_resolve_params_v0_t* params,
+    iree_hal_executable_plugin_resolution_t* out_resolution) {
+  *out_resolution = 0;
+  bool any_required_not_found = false;
+  for (size_t i = 0; i < params->count; ++i) {
+    if (params->out_fn_ptrs[i]) continue;
+    const char* symbol_name = params->symbol_names[i];
+    bool is_optional =
+        iree_hal_executable_plugin_import_is_optional(symbol_name);
+    if (is_optional) ++symbol_name;
+    if (iree_hal_executable_plugin_strcmp(symbol_name, "iree_uk_mmt4d") == 0) {
+      params->out_fn_ptrs[i] = iree_uk_plugin_mmt4d;
+      params->out_fn_contexts[i] = NULL;
+    } else if (iree_hal_executable_plugin_strcmp(symbol_name,
+                                                 "iree_uk_pack") == 0) {
+      params->out_fn_ptrs[i] = iree_uk_plugin_pack;
+      params->out_fn_contexts[i] = NULL;
+    } else if (iree_hal_executable_plugin_strcmp(symbol_name,
+                                                 "iree_uk_unpack") == 0) {
+      params->out_fn_ptrs[i] = iree_uk_plugin_unpack;
+      params->out_fn_contexts[i] = NULL;
+    } else {
+      if (is_optional) {
+        *out_resolution |=
+            IREE_HAL_EXECUTABLE_PLUGIN_RESOLUTION_MISSING_OPTIONAL;
+      } else {
+        any_required_not_found = true;
+      }
+    }
+  }
+  return any_required_not_found
+             ? iree_hal_executable_plugin_status_from_code(
+                   IREE_HAL_EXECUTABLE_PLUGIN_STATUS_NOT_FOUND)
+             : iree_hal_executable_plugin_ok_status();
+}
+
+// Exported on the shared library and used by the runtime to query the plugin
+// interface. When statically linking the plugin this can be called directly.
+IREE_HAL_EXECUTABLE_PLUGIN_EXPORT const iree_hal_executable_plugin_header_t**
+iree_hal_executable_plugin_query(
+    iree_hal_executable_plugin_version_t max_version, void* reserved) {
+  static const iree_hal_executable_plugin_header_t header = {
+      .version = IREE_HAL_EXECUTABLE_PLUGIN_VERSION_LATEST,
+      .name = "iree_ukernel",
+      .description =
+          "CPU-feature multiversioned builtin ukernels "
+          "(builtins/ukernel/plugin/ukernel_plugin.c)",
+      .features = 0,
+      .sanitizer = IREE_HAL_EXECUTABLE_PLUGIN_SANITIZER_NONE,
+  };
+  static const iree_hal_executable_plugin_v0_t plugin = {
+      .header = &header,
+      .load = iree_uk_plugin_load,
+      .unload = iree_uk_plugin_unload,
+      .resolve = iree_uk_plugin_resolve,
+  };
+  return max_version <= IREE_HAL_EXECUTABLE_PLUGIN_VERSION_LATEST
+             ? (const iree_hal_executable_plugin_header_t**)&plugin
+             : NULL;
+}
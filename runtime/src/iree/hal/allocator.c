@@ -67,6 +67,20 @@ IREE_API_EXPORT iree_status_t iree_hal_allocator_statistics_format(
       statistics->device_bytes_freed,
       (statistics->device_bytes_allocated - statistics->device_bytes_freed)));
 
+  if (statistics->pool_bytes_peak > 0) {
+    IREE_RETURN_IF_ERROR(iree_string_builder_append_format(
+        builder,
+        "      POOLED: %12" PRIdsz "B peak / %12" PRIdsz "B resident\n",
+        statistics->pool_bytes_peak, statistics->pool_bytes_resident));
+  }
+
+  if (statistics->pool_hit_count > 0 || statistics->pool_miss_count > 0) {
+    IREE_RETURN_IF_ERROR(iree_string_builder_append_format(
+        builder,
+        "  POOL REUSE: %12" PRId64 " hits / %12" PRId64 " misses\n",
+        statistics->pool_hit_count, statistics->pool_miss_count));
+  }
+
 #else
   // No-op when disabled.
 #endif  // IREE_STATISTICS_ENABLE
@@ -155,6 +169,81 @@ IREE_API_EXPORT iree_status_t iree_hal_allocator_query_memory_heaps(
                                                          heaps, out_count);
 }
 
+// Maximum number of heaps ranked during placement selection; allocators with
+// more heaps than this fall back to their preferred enumeration order.
+#define IREE_HAL_ALLOCATOR_MAX_RANKED_HEAP_COUNT 16
+
+IREE_API_EXPORT iree_status_t iree_hal_allocator_select_memory_type(
+    iree_hal_allocator_t* IREE_RESTRICT allocator,
+    const iree_hal_buffer_params_t* IREE_RESTRICT params,
+    iree_hal_memory_type_t* IREE_RESTRICT out_memory_type) {
+  IREE_ASSERT_ARGUMENT(allocator);
+  IREE_ASSERT_ARGUMENT(params);
+  IREE_ASSERT_ARGUMENT(out_memory_type);
+  *out_memory_type = params->type & ~IREE_HAL_MEMORY_TYPE_OPTIMAL;
+
+  iree_hal_allocator_memory_heap_t
+      heaps[IREE_HAL_ALLOCATOR_MAX_RANKED_HEAP_COUNT];
+  iree_host_size_t heap_count = 0;
+  iree_status_t status = iree_hal_allocator_query_memory_heaps(
+      allocator, IREE_ARRAYSIZE(heaps), heaps, &heap_count);
+  if (iree_status_code(status) == IREE_STATUS_OUT_OF_RANGE) {
+    // Too many heaps to rank; keep the caller-provided type untouched so the
+    // allocator falls back to its own preference ordering.
+    iree_status_ignore(status);
+    return iree_ok_status();
+  }
+  IREE_RETURN_IF_ERROR(status);
+
+  // Bits beyond OPTIMAL restrict the set of heaps that may be chosen.
+  const iree_hal_memory_type_t required_type =
+      params->type & ~IREE_HAL_MEMORY_TYPE_OPTIMAL;
+  // Only the coarse usage categories participate in heap matching; heaps
+  // advertise those while finer-grained bits (sharing modes, indirect params,
+  // etc) are validated by the allocator during allocation.
+  const iree_hal_buffer_usage_t required_usage =
+      params->usage &
+      (IREE_HAL_BUFFER_USAGE_TRANSFER | IREE_HAL_BUFFER_USAGE_DISPATCH |
+       IREE_HAL_BUFFER_USAGE_MAPPING);
+  const bool wants_device_access = iree_any_bit_set(
+      params->usage,
+      IREE_HAL_BUFFER_USAGE_TRANSFER | IREE_HAL_BUFFER_USAGE_DISPATCH);
+  const bool wants_host_access =
+      iree_any_bit_set(params->access, IREE_HAL_MEMORY_ACCESS_READ |
+                                           IREE_HAL_MEMORY_ACCESS_WRITE) &&
+      iree_any_bit_set(params->usage, IREE_HAL_BUFFER_USAGE_MAPPING);
+
+  const iree_hal_allocator_memory_heap_t* best_heap = NULL;
+  iree_device_size_t best_score = 0;
+  for (iree_host_size_t i = 0; i < heap_count; ++i) {
+    const iree_hal_allocator_memory_heap_t* heap = &heaps[i];
+    if (!iree_all_bits_set(heap->type, required_type)) continue;
+    if (!iree_all_bits_set(heap->allowed_usage, required_usage)) continue;
+    iree_device_size_t score = 0;
+    if (wants_device_access) {
+      score += heap->device_bandwidth_bytes_per_second;
+    }
+    if (wants_host_access &&
+        iree_all_bits_set(heap->type, IREE_HAL_MEMORY_TYPE_HOST_VISIBLE)) {
+      score += heap->host_bandwidth_bytes_per_second;
+    }
+    // Strictly-greater comparison preserves enumeration order preference on
+    // ties (including when no heap advertises bandwidth at all).
+    if (!best_heap || score > best_score) {
+      best_heap = heap;
+      best_score = score;
+    }
+  }
+  if (!best_heap) {
+    return iree_make_status(
+        IREE_STATUS_NOT_FOUND,
+        "no memory heap satisfies the requested type/usage combination");
+  }
+
+  *out_memory_type = best_heap->type & ~IREE_HAL_MEMORY_TYPE_OPTIMAL;
+  return iree_ok_status();
+}
+
 IREE_API_EXPORT iree_hal_buffer_compatibility_t
 iree_hal_allocator_query_buffer_compatibility(
     iree_hal_allocator_t* IREE_RESTRICT allocator,
@@ -77,6 +77,20 @@ typedef struct iree_hal_allocator_memory_heap_t {
   // Minimum alignment, in bytes, of allocations of this type.
   // Allocation requests will have their alignment rounded up to at least this.
   iree_device_size_t min_alignment;
+
+  // Approximate effective bandwidth, in bytes per second, when buffers in this
+  // heap are accessed by the device (dispatches and queued transfers).
+  // May come from device queries, a one-time startup measurement, or a stored
+  // profile. 0 indicates no estimate is available and the enumeration order
+  // preference will be used instead during placement selection.
+  iree_device_size_t device_bandwidth_bytes_per_second;
+
+  // Approximate effective bandwidth, in bytes per second, when buffers in this
+  // heap are mapped and accessed by the host. On unified memory and resizable
+  // BAR systems this may approach the device bandwidth while on discrete
+  // devices with write-combined staging memory host reads can be orders of
+  // magnitude slower. 0 indicates no estimate is available.
+  iree_device_size_t host_bandwidth_bytes_per_second;
 } iree_hal_allocator_memory_heap_t;
 
 // Parameters defining how a buffer should be allocated.
@@ -365,6 +379,14 @@ typedef struct iree_hal_allocator_statistics_t {
   iree_device_size_t device_bytes_peak;
   iree_device_size_t device_bytes_allocated;
   iree_device_size_t device_bytes_freed;
+  // Bytes currently resident in allocator-owned pools awaiting reuse.
+  // Zero for allocators that do not pool.
+  iree_device_size_t pool_bytes_resident;
+  iree_device_size_t pool_bytes_peak;
+  // Allocation requests serviced from (hit) or missing (miss) pooled memory.
+  // Zero for allocators that do not pool.
+  int64_t pool_hit_count;
+  int64_t pool_miss_count;
   // TODO(benvanik): mapping information (discarded, mapping ranges,
   //                 flushed/invalidated, etc).
 #else
@@ -432,6 +454,27 @@ IREE_API_EXPORT iree_status_t iree_hal_allocator_query_memory_heaps(
     iree_hal_allocator_memory_heap_t* IREE_RESTRICT heaps,
     iree_host_size_t* IREE_RESTRICT out_count);
 
+// Selects a concrete memory type for an allocation with the given |params|.
+// Intended for resolving IREE_HAL_MEMORY_TYPE_OPTIMAL requests: heaps
+// compatible with the required type and usage bits in |params| are ranked by
+// the bandwidth they advertise for the access patterns implied by the request
+// (device bandwidth for dispatch/transfer usage and host bandwidth when host
+// access is requested on mappable allocations). On unified memory or resizable
+// BAR systems this flips readback-heavy buffers to host-coherent placement
+// that the fixed discrete-GPU heap ordering would never choose.
+//
+// Heaps without bandwidth estimates rank equal and ties preserve the
+// allocator's preferred enumeration order so allocators that advertise no
+// bandwidth information retain their existing placement behavior.
+//
+// Returns the selected type in |out_memory_type| with
+// IREE_HAL_MEMORY_TYPE_OPTIMAL cleared. Returns IREE_STATUS_NOT_FOUND if no
+// heap satisfies the request.
+IREE_API_EXPORT iree_status_t iree_hal_allocator_select_memory_type(
+    iree_hal_allocator_t* IREE_RESTRICT allocator,
+    const iree_hal_buffer_params_t* IREE_RESTRICT params,
+    iree_hal_memory_type_t* IREE_RESTRICT out_memory_type);
+
 // Returns a bitmask indicating what operations with buffers of the given type
 // are available on the allocator. If any parameters or the allocation size must
 // be changed by the allocator to match device requirements they will be
@@ -537,6 +580,21 @@ IREE_API_EXPORT iree_status_t iree_hal_allocator_create_heap(
     iree_string_view_t identifier, iree_allocator_t data_allocator,
     iree_allocator_t host_allocator, iree_hal_allocator_t** out_allocator);
 
+// Creates a host-local heap allocator as with iree_hal_allocator_create_heap
+// but with a built-in size-class pool recycling buffer storage. Small and
+// medium buffer data allocations (up to a few hundred KB) are carved into
+// power-of-two size classes and recycled through per-class free lists instead
+// of being returned to |data_allocator|, keeping transient tensor churn off
+// the system allocator and its page faults. Larger allocations pass through
+// to |data_allocator| untouched.
+//
+// Pooled memory is retained until iree_hal_allocator_trim is called or the
+// allocator is destroyed. Current and peak pool residency are reported via
+// the pool_bytes_resident/pool_bytes_peak allocator statistics.
+IREE_API_EXPORT iree_status_t iree_hal_allocator_create_heap_pooled(
+    iree_string_view_t identifier, iree_allocator_t data_allocator,
+    iree_allocator_t host_allocator, iree_hal_allocator_t** out_allocator);
+
 //===----------------------------------------------------------------------===//
 // iree_hal_allocator_t implementation details
 //===----------------------------------------------------------------------===//
@@ -12,11 +12,62 @@
 #include "iree/hal/buffer_heap_impl.h"
 #include "iree/hal/resource.h"
 
+//===----------------------------------------------------------------------===//
+// Size-class segregated data pool
+//===----------------------------------------------------------------------===//
+// Recycles buffer data allocations through power-of-two size-class free lists
+// instead of returning them to the underlying data allocator. Transient
+// workloads that churn through thousands of small/medium buffers per second
+// reuse warm pages from the pool rather than faulting fresh ones from the
+// system allocator. Larger allocations pass through untouched.
+
+// Smallest size class; allocations below this round up to it.
+#define IREE_HAL_HEAP_ALLOCATOR_MIN_POOLED_SIZE ((iree_host_size_t)4 * 1024)
+// Largest size class; allocations above this bypass the pool.
+#define IREE_HAL_HEAP_ALLOCATOR_MAX_POOLED_SIZE ((iree_host_size_t)256 * 1024)
+// Power-of-two size classes from min to max, inclusive (4KB...256KB).
+#define IREE_HAL_HEAP_ALLOCATOR_POOL_COUNT 7
+
+// Sentinel pool index for allocations that bypass the pool.
+#define IREE_HAL_HEAP_ALLOCATOR_POOL_INDEX_UNPOOLED UINT32_MAX
+
+// Header prefixed to every allocation made through the pooled data allocator
+// recording the size class the block belongs to (or that it bypassed the
+// pool). Padded to iree_max_align_t so user data retains the natural
+// allocation alignment of the underlying allocator.
+typedef union iree_hal_heap_allocator_block_header_t {
+  uint32_t pool_index;
+  uint8_t padding[iree_max_align_t];
+} iree_hal_heap_allocator_block_header_t;
+
+// A free block in a size-class free list; the block storage itself is reused
+// for the link so free lists cost no additional memory.
+typedef struct iree_hal_heap_allocator_free_block_t {
+  struct iree_hal_heap_allocator_free_block_t* next;
+} iree_hal_heap_allocator_free_block_t;
+
 typedef struct iree_hal_heap_allocator_t {
   iree_hal_resource_t resource;
   iree_allocator_t host_allocator;
   iree_allocator_t data_allocator;
   iree_string_view_t identifier;
+
+  // Size-class pool state; only used when the allocator was created with
+  // pooling enabled (pool.enabled == true). When enabled data_allocator above
+  // is a thunk over the pool and pool.backing_allocator services misses.
+  struct {
+    bool enabled;
+    iree_allocator_t backing_allocator;
+    iree_slim_mutex_t mutex;
+    // LIFO free list per size class; most-recently-freed blocks are reused
+    // first to keep their pages warm in cache.
+    iree_hal_heap_allocator_free_block_t*
+        free_lists[IREE_HAL_HEAP_ALLOCATOR_POOL_COUNT];
+    // Total bytes currently resident in the free lists awaiting reuse.
+    iree_host_size_t resident_bytes;
+    iree_host_size_t resident_bytes_peak;
+  } pool;
+
   IREE_STATISTICS(iree_hal_heap_allocator_statistics_t statistics;)
 } iree_hal_heap_allocator_t;
 
@@ -27,9 +78,130 @@ iree_hal_heap_allocator_t* iree_hal_heap_allocator_cast(
   return (iree_hal_heap_allocator_t*)base_value;
 }
 
-IREE_API_EXPORT iree_status_t iree_hal_allocator_create_heap(
+// Returns the size class index servicing |size| or
+// IREE_HAL_HEAP_ALLOCATOR_POOL_INDEX_UNPOOLED if the allocation bypasses the
+// pool.
+static uint32_t iree_hal_heap_allocator_pool_index(iree_host_size_t size) {
+  if (size > IREE_HAL_HEAP_ALLOCATOR_MAX_POOLED_SIZE) {
+    return IREE_HAL_HEAP_ALLOCATOR_POOL_INDEX_UNPOOLED;
+  }
+  iree_host_size_t class_size = IREE_HAL_HEAP_ALLOCATOR_MIN_POOLED_SIZE;
+  uint32_t pool_index = 0;
+  while (class_size < size) {
+    class_size <<= 1;
+    ++pool_index;
+  }
+  return pool_index;
+}
+
+// Returns the block byte size of the given size class.
+static iree_host_size_t iree_hal_heap_allocator_pool_class_size(
+    uint32_t pool_index) {
+  return IREE_HAL_HEAP_ALLOCATOR_MIN_POOLED_SIZE << pool_index;
+}
+
+// Frees all blocks in the pool free lists back to the backing allocator.
+static void iree_hal_heap_allocator_pool_drain(
+    iree_hal_heap_allocator_t* allocator) {
+  iree_slim_mutex_lock(&allocator->pool.mutex);
+  for (uint32_t i = 0; i < IREE_HAL_HEAP_ALLOCATOR_POOL_COUNT; ++i) {
+    iree_hal_heap_allocator_free_block_t* block = allocator->pool.free_lists[i];
+    allocator->pool.free_lists[i] = NULL;
+    while (block) {
+      iree_hal_heap_allocator_free_block_t* next = block->next;
+      iree_allocator_free(
+          allocator->pool.backing_allocator,
+          (iree_hal_heap_allocator_block_header_t*)block - 1);
+      block = next;
+    }
+  }
+  allocator->pool.resident_bytes = 0;
+  iree_slim_mutex_unlock(&allocator->pool.mutex);
+}
+
+// iree_allocator_ctl_fn_t servicing buffer data allocations from the pool.
+// Pooled size classes are recycled through the free lists while anything
+// larger passes through to the backing allocator (with the header retained so
+// frees can be routed appropriately).
+static iree_status_t iree_hal_heap_allocator_pool_ctl(
+    void* self, iree_allocator_command_t command, const void* params,
+    void** inout_ptr) {
+  iree_hal_heap_allocator_t* allocator = (iree_hal_heap_allocator_t*)self;
+  switch (command) {
+    case IREE_ALLOCATOR_COMMAND_MALLOC:
+    case IREE_ALLOCATOR_COMMAND_CALLOC: {
+      const iree_allocator_alloc_params_t* alloc_params =
+          (const iree_allocator_alloc_params_t*)params;
+      iree_host_size_t size = alloc_params->byte_length;
+      uint32_t pool_index = iree_hal_heap_allocator_pool_index(size);
+      iree_hal_heap_allocator_block_header_t* header = NULL;
+      if (pool_index != IREE_HAL_HEAP_ALLOCATOR_POOL_INDEX_UNPOOLED) {
+        iree_slim_mutex_lock(&allocator->pool.mutex);
+        iree_hal_heap_allocator_free_block_t* block =
+            allocator->pool.free_lists[pool_index];
+        if (block) {
+          allocator->pool.free_lists[pool_index] = block->next;
+          allocator->pool.resident_bytes -=
+              iree_hal_heap_allocator_pool_class_size(pool_index);
+        }
+        iree_slim_mutex_unlock(&allocator->pool.mutex);
+        if (block) {
+          header = (iree_hal_heap_allocator_block_header_t*)block - 1;
+        }
+      }
+      if (!header) {
+        // Pool miss (or unpooled size): allocate a fresh block of the full
+        // class size so that it can be recycled uniformly later.
+        iree_host_size_t data_size =
+            pool_index != IREE_HAL_HEAP_ALLOCATOR_POOL_INDEX_UNPOOLED
+                ? iree_hal_heap_allocator_pool_class_size(pool_index)
+                : size;
+        IREE_RETURN_IF_ERROR(iree_allocator_malloc_uninitialized(
+            allocator->pool.backing_allocator, sizeof(*header) + data_size,
+            (void**)&header));
+        header->pool_index = pool_index;
+      }
+      void* ptr = header + 1;
+      if (command == IREE_ALLOCATOR_COMMAND_CALLOC) {
+        memset(ptr, 0, size);
+      }
+      *inout_ptr = ptr;
+      return iree_ok_status();
+    }
+    case IREE_ALLOCATOR_COMMAND_FREE: {
+      iree_hal_heap_allocator_block_header_t* header =
+          (iree_hal_heap_allocator_block_header_t*)*inout_ptr - 1;
+      uint32_t pool_index = header->pool_index;
+      if (pool_index == IREE_HAL_HEAP_ALLOCATOR_POOL_INDEX_UNPOOLED) {
+        iree_allocator_free(allocator->pool.backing_allocator, header);
+        return iree_ok_status();
+      }
+      iree_hal_heap_allocator_free_block_t* block =
+          (iree_hal_heap_allocator_free_block_t*)(header + 1);
+      iree_slim_mutex_lock(&allocator->pool.mutex);
+      block->next = allocator->pool.free_lists[pool_index];
+      allocator->pool.free_lists[pool_index] = block;
+      allocator->pool.resident_bytes +=
+          iree_hal_heap_allocator_pool_class_size(pool_index);
+      if (allocator->pool.resident_bytes >
+          allocator->pool.resident_bytes_peak) {
+        allocator->pool.resident_bytes_peak = allocator->pool.resident_bytes;
+      }
+      iree_slim_mutex_unlock(&allocator->pool.mutex);
+      return iree_ok_status();
+    }
+    default:
+      // REALLOC is not used by heap buffers and intentionally unsupported as
+      // the pool would need to track outstanding allocation sizes.
+      return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
+                              "unsupported pooled data allocator command");
+  }
+}
+
+static iree_status_t iree_hal_allocator_create_heap_impl(
     iree_string_view_t identifier, iree_allocator_t data_allocator,
-    iree_allocator_t host_allocator, iree_hal_allocator_t** out_allocator) {
+    iree_allocator_t host_allocator, bool enable_pooling,
+    iree_hal_allocator_t** out_allocator) {
   IREE_ASSERT_ARGUMENT(out_allocator);
   *out_allocator = NULL;
   IREE_TRACE_ZONE_BEGIN(z0);
@@ -44,6 +216,15 @@ IREE_API_EXPORT iree_status_t iree_hal_allocator_create_heap(
                                  &allocator->resource);
     allocator->host_allocator = host_allocator;
     allocator->data_allocator = data_allocator;
+    if (enable_pooling) {
+      // Interpose the pool between buffers and the data allocator; buffer
+      // data allocations route through iree_hal_heap_allocator_pool_ctl.
+      allocator->pool.enabled = true;
+      allocator->pool.backing_allocator = data_allocator;
+      iree_slim_mutex_initialize(&allocator->pool.mutex);
+      allocator->data_allocator.self = allocator;
+      allocator->data_allocator.ctl = iree_hal_heap_allocator_pool_ctl;
+    }
     iree_string_view_append_to_buffer(
         identifier, &allocator->identifier,
         (char*)allocator + iree_sizeof_struct(*allocator));
@@ -60,6 +241,24 @@ IREE_API_EXPORT iree_status_t iree_hal_allocator_create_heap(
   return status;
 }
 
+IREE_API_EXPORT iree_status_t iree_hal_allocator_create_heap(
+    iree_string_view_t identifier, iree_allocator_t data_allocator,
+    iree_allocator_t host_allocator, iree_hal_allocator_t** out_allocator) {
+  return iree_hal_allocator_create_heap_impl(identifier, data_allocator,
+                                             host_allocator,
+                                             /*enable_pooling=*/false,
+                                             out_allocator);
+}
+
+IREE_API_EXPORT iree_status_t iree_hal_allocator_create_heap_pooled(
+    iree_string_view_t identifier, iree_allocator_t data_allocator,
+    iree_allocator_t host_allocator, iree_hal_allocator_t** out_allocator) {
+  return iree_hal_allocator_create_heap_impl(identifier, data_allocator,
+                                             host_allocator,
+                                             /*enable_pooling=*/true,
+                                             out_allocator);
+}
+
 static void iree_hal_heap_allocator_destroy(
     iree_hal_allocator_t* IREE_RESTRICT base_allocator) {
   iree_hal_heap_allocator_t* allocator =
@@ -67,6 +266,11 @@ static void iree_hal_heap_allocator_destroy(
   iree_allocator_t host_allocator = allocator->host_allocator;
   IREE_TRACE_ZONE_BEGIN(z0);
 
+  if (allocator->pool.enabled) {
+    iree_hal_heap_allocator_pool_drain(allocator);
+    iree_slim_mutex_deinitialize(&allocator->pool.mutex);
+  }
+
   IREE_STATISTICS(iree_slim_mutex_deinitialize(&allocator->statistics.mutex));
 
   iree_allocator_free(host_allocator, allocator);
@@ -83,6 +287,11 @@ static iree_allocator_t iree_hal_heap_allocator_host_allocator(
 
 static iree_status_t iree_hal_heap_allocator_trim(
     iree_hal_allocator_t* IREE_RESTRICT base_allocator) {
+  iree_hal_heap_allocator_t* allocator =
+      iree_hal_heap_allocator_cast(base_allocator);
+  if (allocator->pool.enabled) {
+    iree_hal_heap_allocator_pool_drain(allocator);
+  }
   return iree_ok_status();
 }
 
@@ -96,6 +305,12 @@ static void iree_hal_heap_allocator_query_statistics(
     memcpy(out_statistics, &allocator->statistics.base,
            sizeof(*out_statistics));
     iree_slim_mutex_unlock(&allocator->statistics.mutex);
+    if (allocator->pool.enabled) {
+      iree_slim_mutex_lock(&allocator->pool.mutex);
+      out_statistics->pool_bytes_resident = allocator->pool.resident_bytes;
+      out_statistics->pool_bytes_peak = allocator->pool.resident_bytes_peak;
+      iree_slim_mutex_unlock(&allocator->pool.mutex);
+    }
   });
 }
 
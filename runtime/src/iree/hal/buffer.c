@@ -221,6 +221,122 @@ static const iree_hal_buffer_vtable_t iree_hal_subspan_buffer_vtable = {
     .flush_range = iree_hal_subspan_buffer_flush_range,
 };
 
+//===----------------------------------------------------------------------===//
+// Batched subspan buffers
+//===----------------------------------------------------------------------===//
+
+static iree_status_t iree_hal_buffer_calculate_range(
+    iree_device_size_t base_offset, iree_device_size_t max_length,
+    iree_device_size_t offset, iree_device_size_t length,
+    iree_device_size_t* out_adjusted_offset,
+    iree_device_size_t* out_adjusted_length);
+
+typedef struct iree_hal_subspan_buffer_block_t
+    iree_hal_subspan_buffer_block_t;
+
+// A subspan buffer stored inline within a block of subspans that were created
+// together. Each entry behaves as a standalone buffer but its storage is only
+// reclaimed once every entry in the block has been destroyed.
+typedef struct iree_hal_subspan_buffer_entry_t {
+  iree_hal_buffer_t base;  // must be at 0
+  iree_hal_subspan_buffer_block_t* block;
+} iree_hal_subspan_buffer_entry_t;
+
+// A single host allocation backing a batch of subspan buffers.
+// The block is freed when |live_count| reaches zero as the entries are
+// destroyed; entries individually retain/release the parent buffer as normal
+// subspans do.
+struct iree_hal_subspan_buffer_block_t {
+  iree_allocator_t host_allocator;
+  iree_atomic_ref_count_t live_count;
+  iree_hal_subspan_buffer_entry_t entries[];
+};
+
+static void iree_hal_subspan_buffer_block_destroy(
+    iree_hal_buffer_t* base_buffer) {
+  iree_hal_subspan_buffer_entry_t* entry =
+      (iree_hal_subspan_buffer_entry_t*)base_buffer;
+  iree_hal_subspan_buffer_block_t* block = entry->block;
+
+  iree_hal_buffer_release(base_buffer->allocated_buffer);
+
+  // Free the shared block once the last entry is destroyed.
+  if (iree_atomic_ref_count_dec(&block->live_count) == 1) {
+    iree_allocator_free(block->host_allocator, block);
+  }
+}
+
+static const iree_hal_buffer_vtable_t iree_hal_subspan_buffer_block_vtable = {
+    .recycle = iree_hal_buffer_recycle,
+    .destroy = iree_hal_subspan_buffer_block_destroy,
+    .map_range = iree_hal_subspan_buffer_map_range,
+    .unmap_range = iree_hal_subspan_buffer_unmap_range,
+    .invalidate_range = iree_hal_subspan_buffer_invalidate_range,
+    .flush_range = iree_hal_subspan_buffer_flush_range,
+};
+
+IREE_API_EXPORT iree_status_t iree_hal_buffer_subspan_batch(
+    iree_hal_buffer_t* buffer, iree_host_size_t count,
+    const iree_device_size_t* byte_offsets,
+    const iree_device_size_t* byte_lengths, iree_hal_buffer_t** out_buffers) {
+  IREE_ASSERT_ARGUMENT(buffer);
+  if (!count) return iree_ok_status();
+  IREE_ASSERT_ARGUMENT(byte_offsets);
+  IREE_ASSERT_ARGUMENT(byte_lengths);
+  IREE_ASSERT_ARGUMENT(out_buffers);
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, (int64_t)count);
+
+  // Validate all ranges before allocating anything so that failures don't
+  // require unwinding partially-initialized entries.
+  for (iree_host_size_t i = 0; i < count; ++i) {
+    iree_device_size_t byte_offset = 0;
+    iree_device_size_t byte_length = 0;
+    IREE_RETURN_AND_END_ZONE_IF_ERROR(
+        z0, iree_hal_buffer_calculate_range(
+                iree_hal_buffer_byte_offset(buffer),
+                iree_hal_buffer_byte_length(buffer), byte_offsets[i],
+                byte_lengths[i], &byte_offset, &byte_length));
+  }
+
+  // As with iree_hal_buffer_subspan we reference the parent allocation
+  // directly to avoid nesting subspans of subspans.
+  iree_hal_buffer_t* allocated_buffer =
+      iree_hal_buffer_allocated_buffer(buffer);
+  iree_allocator_t host_allocator = buffer->host_allocator;
+
+  iree_hal_subspan_buffer_block_t* block = NULL;
+  iree_host_size_t total_size =
+      sizeof(*block) + count * sizeof(block->entries[0]);
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(host_allocator, total_size, (void**)&block));
+  block->host_allocator = host_allocator;
+  iree_atomic_ref_count_init_value(&block->live_count, count);
+
+  for (iree_host_size_t i = 0; i < count; ++i) {
+    iree_device_size_t byte_offset = 0;
+    iree_device_size_t byte_length = 0;
+    iree_status_t status = iree_hal_buffer_calculate_range(
+        iree_hal_buffer_byte_offset(buffer),
+        iree_hal_buffer_byte_length(buffer), byte_offsets[i], byte_lengths[i],
+        &byte_offset, &byte_length);
+    IREE_ASSERT(iree_status_is_ok(status));  // validated above
+    iree_status_ignore(status);
+    iree_hal_subspan_buffer_entry_t* entry = &block->entries[i];
+    entry->block = block;
+    iree_hal_buffer_initialize(
+        host_allocator, /*device_allocator=*/NULL, allocated_buffer,
+        allocated_buffer->allocation_size, byte_offset, byte_length,
+        allocated_buffer->memory_type, allocated_buffer->allowed_access,
+        allocated_buffer->allowed_usage, &iree_hal_subspan_buffer_block_vtable,
+        &entry->base);
+    out_buffers[i] = &entry->base;
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
 //===----------------------------------------------------------------------===//
 // iree_hal_buffer_t
 //===----------------------------------------------------------------------===//
@@ -637,18 +753,31 @@ IREE_API_EXPORT iree_status_t iree_hal_buffer_map_fill(
       break;
     }
     case 2: {
-      uint16_t* data = (uint16_t*)data_ptr;
-      uint16_t value_bits = *(const uint16_t*)(pattern);
-      for (iree_device_size_t i = 0; i < byte_length / sizeof(uint16_t); ++i) {
-        data[i] = value_bits;
+      // Replicate the pattern into a machine word and store wide; compilers
+      // expand the fixed-size memcpy to unaligned word stores and vectorize
+      // the loop to the full register width of the target.
+      uint8_t* data = (uint8_t*)data_ptr;
+      const uint16_t value_bits = *(const uint16_t*)(pattern);
+      const uint64_t word_bits = (uint64_t)value_bits * 0x0001000100010001ull;
+      iree_device_size_t i = 0;
+      for (; i + sizeof(uint64_t) <= byte_length; i += sizeof(uint64_t)) {
+        memcpy(data + i, &word_bits, sizeof(word_bits));
+      }
+      for (; i < byte_length; i += sizeof(uint16_t)) {
+        memcpy(data + i, &value_bits, sizeof(value_bits));
       }
       break;
     }
     case 4: {
-      uint32_t* data = (uint32_t*)data_ptr;
-      uint32_t value_bits = *(const uint32_t*)(pattern);
-      for (iree_device_size_t i = 0; i < byte_length / sizeof(uint32_t); ++i) {
-        data[i] = value_bits;
+      uint8_t* data = (uint8_t*)data_ptr;
+      const uint32_t value_bits = *(const uint32_t*)(pattern);
+      const uint64_t word_bits = (uint64_t)value_bits * 0x0000000100000001ull;
+      iree_device_size_t i = 0;
+      for (; i + sizeof(uint64_t) <= byte_length; i += sizeof(uint64_t)) {
+        memcpy(data + i, &word_bits, sizeof(word_bits));
+      }
+      for (; i < byte_length; i += sizeof(uint32_t)) {
+        memcpy(data + i, &value_bits, sizeof(value_bits));
       }
       break;
     }
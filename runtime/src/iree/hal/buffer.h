@@ -595,6 +595,22 @@ IREE_API_EXPORT iree_status_t iree_hal_buffer_subspan(
     iree_hal_buffer_t* buffer, iree_device_size_t byte_offset,
     iree_device_size_t byte_length, iree_hal_buffer_t** out_buffer);
 
+// Returns references to |count| subspans of the |buffer| in a single call.
+// Each |byte_offsets|/|byte_lengths| pair defines one subspan with the same
+// semantics as iree_hal_buffer_subspan (including IREE_WHOLE_BUFFER lengths).
+//
+// All returned buffers share one host allocation that is recycled only once
+// every buffer in the batch has been released; this amortizes the per-subspan
+// allocation overhead when slicing a large buffer into many views (such as
+// model weight arenas) at the cost of the block remaining resident until the
+// last subspan is released.
+//
+// Each entry of |out_buffers| must be released by the caller.
+IREE_API_EXPORT iree_status_t iree_hal_buffer_subspan_batch(
+    iree_hal_buffer_t* buffer, iree_host_size_t count,
+    const iree_device_size_t* byte_offsets,
+    const iree_device_size_t* byte_lengths, iree_hal_buffer_t** out_buffers);
+
 // Retains the given |buffer| for the caller.
 IREE_API_EXPORT void iree_hal_buffer_retain(iree_hal_buffer_t* buffer);
 
@@ -28,6 +28,10 @@ typedef enum iree_hal_heap_buffer_storage_mode_e {
   // A user-provided buffer release callback is notified that the buffer is no
   // longer referencing the data.
   IREE_HAL_HEAP_BUFFER_STORAGE_MODE_EXTERNAL = 2u,
+  // Initialized in caller-provided [metadata] storage over externally-owned
+  // [data]. Nothing is freed; a user-provided buffer release callback is
+  // notified that both the storage and the data are no longer in use.
+  IREE_HAL_HEAP_BUFFER_STORAGE_MODE_EMBEDDED = 3u,
 } iree_hal_heap_buffer_storage_mode_t;
 
 typedef struct iree_hal_heap_buffer_t {
@@ -211,6 +215,52 @@ iree_status_t iree_hal_heap_buffer_wrap(
   return status;
 }
 
+iree_host_size_t iree_hal_heap_buffer_storage_size(void) {
+  return sizeof(iree_hal_heap_buffer_t);
+}
+
+iree_status_t iree_hal_heap_buffer_initialize(
+    iree_hal_allocator_t* allocator, iree_hal_memory_type_t memory_type,
+    iree_hal_memory_access_t allowed_access,
+    iree_hal_buffer_usage_t allowed_usage, iree_device_size_t allocation_size,
+    iree_byte_span_t data, iree_hal_buffer_release_callback_t release_callback,
+    iree_byte_span_t storage, iree_hal_buffer_t** out_buffer) {
+  IREE_ASSERT_ARGUMENT(allocator);
+  IREE_ASSERT_ARGUMENT(out_buffer);
+  if (storage.data_length < iree_hal_heap_buffer_storage_size()) {
+    return iree_make_status(
+        IREE_STATUS_INVALID_ARGUMENT,
+        "storage must have a capacity of at least %" PRIhsz
+        " bytes for embedding buffer metadata; got %" PRIhsz,
+        iree_hal_heap_buffer_storage_size(), storage.data_length);
+  }
+  if (!iree_any_bit_set(allowed_access, IREE_HAL_MEMORY_ACCESS_UNALIGNED) &&
+      !iree_host_size_has_alignment((uintptr_t)data.data,
+                                    IREE_HAL_HEAP_BUFFER_ALIGNMENT)) {
+    return iree_make_status(
+        IREE_STATUS_OUT_OF_RANGE,
+        "embedded heap buffer data must be aligned to %d; got %p",
+        (int)IREE_HAL_HEAP_BUFFER_ALIGNMENT, data.data);
+  }
+
+  iree_hal_heap_buffer_t* buffer = (iree_hal_heap_buffer_t*)storage.data;
+  iree_hal_buffer_initialize(iree_hal_allocator_host_allocator(allocator),
+                             allocator, &buffer->base, allocation_size, 0,
+                             data.data_length, memory_type, allowed_access,
+                             allowed_usage, &iree_hal_heap_buffer_vtable,
+                             &buffer->base);
+  buffer->data = data;
+
+  // Nothing is freed on destruction; the callback signals that both the
+  // caller-provided storage and the data can be reclaimed.
+  buffer->base.flags = IREE_HAL_HEAP_BUFFER_STORAGE_MODE_EMBEDDED;
+  buffer->release_callback = release_callback;
+  IREE_STATISTICS(buffer->statistics = NULL);
+
+  *out_buffer = &buffer->base;
+  return iree_ok_status();
+}
+
 static void iree_hal_heap_buffer_destroy(iree_hal_buffer_t* base_buffer) {
   iree_hal_heap_buffer_t* buffer = (iree_hal_heap_buffer_t*)base_buffer;
   iree_allocator_t host_allocator = base_buffer->host_allocator;
@@ -232,7 +282,7 @@ static void iree_hal_heap_buffer_destroy(iree_hal_buffer_t* base_buffer) {
       break;
     }
     case IREE_HAL_HEAP_BUFFER_STORAGE_MODE_SPLIT: {
-      iree_allocator_free(buffer->data_allocator, buffer->data.data);
+      iree_allocator_free_aligned(buffer->data_allocator, buffer->data.data);
       iree_allocator_free(host_allocator, buffer);
       break;
     }
@@ -244,6 +294,14 @@ static void iree_hal_heap_buffer_destroy(iree_hal_buffer_t* base_buffer) {
       iree_allocator_free(host_allocator, buffer);
       break;
     }
+    case IREE_HAL_HEAP_BUFFER_STORAGE_MODE_EMBEDDED: {
+      // Caller owns both the metadata storage and the data; nothing to free.
+      if (buffer->release_callback.fn) {
+        buffer->release_callback.fn(buffer->release_callback.user_data,
+                                    base_buffer);
+      }
+      break;
+    }
     default:
       IREE_ASSERT_UNREACHABLE("unhandled buffer storage mode");
       break;
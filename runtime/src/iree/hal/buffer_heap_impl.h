@@ -37,6 +37,24 @@ iree_status_t iree_hal_heap_buffer_create(
     iree_allocator_t data_allocator, iree_allocator_t host_allocator,
     iree_hal_buffer_t** out_buffer);
 
+// Returns the size in bytes of the storage required to embed a heap buffer
+// with iree_hal_heap_buffer_initialize.
+iree_host_size_t iree_hal_heap_buffer_storage_size(void);
+
+// Initializes a heap buffer wrapping externally-owned |data| in-place in
+// caller-provided |storage| of at least iree_hal_heap_buffer_storage_size()
+// bytes. No per-buffer host allocation is performed: the storage must remain
+// valid until |release_callback| is notified that neither it nor |data| are
+// referenced by the buffer anymore and nothing is freed on destruction.
+// Embedded buffers are excluded from allocator statistics. |out_buffer| must
+// be released by the caller.
+iree_status_t iree_hal_heap_buffer_initialize(
+    iree_hal_allocator_t* allocator, iree_hal_memory_type_t memory_type,
+    iree_hal_memory_access_t allowed_access,
+    iree_hal_buffer_usage_t allowed_usage, iree_device_size_t allocation_size,
+    iree_byte_span_t data, iree_hal_buffer_release_callback_t release_callback,
+    iree_byte_span_t storage, iree_hal_buffer_t** out_buffer);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -10,6 +10,17 @@
 // Transfer utilities
 //===----------------------------------------------------------------------===//
 
+// Minimum per-chunk length when splitting large device-to-device copies
+// across multiple queue submissions. Transfers below twice this size are
+// issued as a single copy; smaller chunks would be dominated by submission
+// overhead rather than memory bandwidth.
+#define IREE_HAL_TRANSFER_CHUNK_MIN_LENGTH (64 * 1024 * 1024)
+
+// Maximum number of chunks (and thus concurrent queue submissions) a single
+// transfer will be split into. Devices with fewer transfer queues will
+// coalesce the submissions onto the queues they have.
+#define IREE_HAL_TRANSFER_MAX_CHUNK_COUNT 4
+
 // Synchronously executes one or more transfer operations against a queue.
 // All buffers must be compatible with |device| and ranges must not overlap
 // (same as with memcpy).
@@ -91,6 +102,117 @@ static iree_status_t iree_hal_device_transfer_and_wait(
   return status;
 }
 
+// Copies |data_length| bytes between device buffers, splitting large copies
+// into chunks submitted against distinct queue affinities so devices with
+// multiple transfer queues (DMA engines) can overlap them. Each chunk gets its
+// own one-shot command buffer and fence semaphore; completion is a single
+// wait-all. Devices with one queue execute the chunks back-to-back with only
+// the extra submission overhead, which is noise at the sizes where chunking
+// kicks in.
+//
+// This is a blocking operation; see iree_hal_device_transfer_and_wait for the
+// preferred command buffer based approach for when callers want sequencing.
+//
+// Precondition: source and target ranges do not overlap.
+static iree_status_t iree_hal_device_copy_chunked_and_wait(
+    iree_hal_device_t* device, iree_hal_buffer_t* source_buffer,
+    iree_device_size_t source_offset, iree_hal_buffer_t* target_buffer,
+    iree_device_size_t target_offset, iree_device_size_t data_length,
+    iree_timeout_t timeout) {
+  // Fall back to a single submission when the transfer is too small to be
+  // worth splitting.
+  iree_host_size_t chunk_count = 1;
+  if (data_length >= 2 * IREE_HAL_TRANSFER_CHUNK_MIN_LENGTH) {
+    chunk_count = (iree_host_size_t)iree_min(
+        IREE_HAL_TRANSFER_MAX_CHUNK_COUNT,
+        data_length / IREE_HAL_TRANSFER_CHUNK_MIN_LENGTH);
+  }
+  if (chunk_count == 1) {
+    const iree_hal_transfer_command_t transfer_command = {
+        .type = IREE_HAL_TRANSFER_COMMAND_TYPE_COPY,
+        .copy =
+            {
+                .source_buffer = source_buffer,
+                .source_offset = source_offset,
+                .target_buffer = target_buffer,
+                .target_offset = target_offset,
+                .length = data_length,
+            },
+    };
+    return iree_hal_device_transfer_and_wait(device, /*wait_semaphore=*/NULL,
+                                             /*wait_value=*/0ull, 1,
+                                             &transfer_command, timeout);
+  }
+
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, (int64_t)chunk_count);
+
+  iree_hal_command_buffer_t* command_buffers[IREE_HAL_TRANSFER_MAX_CHUNK_COUNT];
+  iree_hal_semaphore_t* fence_semaphores[IREE_HAL_TRANSFER_MAX_CHUNK_COUNT];
+  uint64_t signal_values[IREE_HAL_TRANSFER_MAX_CHUNK_COUNT];
+  memset(command_buffers, 0, sizeof(command_buffers));
+  memset(fence_semaphores, 0, sizeof(fence_semaphores));
+
+  // Record and submit one chunk per queue affinity bit. Drivers map affinity
+  // bits onto however many queues they actually have.
+  iree_device_size_t chunk_length = data_length / chunk_count;
+  iree_status_t status = iree_ok_status();
+  for (iree_host_size_t i = 0; i < chunk_count; ++i) {
+    iree_device_size_t chunk_offset = i * chunk_length;
+    const iree_hal_transfer_command_t transfer_command = {
+        .type = IREE_HAL_TRANSFER_COMMAND_TYPE_COPY,
+        .copy =
+            {
+                .source_buffer = source_buffer,
+                .source_offset = source_offset + chunk_offset,
+                .target_buffer = target_buffer,
+                .target_offset = target_offset + chunk_offset,
+                .length = i + 1 == chunk_count ? data_length - chunk_offset
+                                               : chunk_length,
+            },
+    };
+    iree_hal_queue_affinity_t queue_affinity = (iree_hal_queue_affinity_t)1u
+                                               << i;
+    status = iree_hal_create_transfer_command_buffer(
+        device,
+        IREE_HAL_COMMAND_BUFFER_MODE_ONE_SHOT |
+            IREE_HAL_COMMAND_BUFFER_MODE_ALLOW_INLINE_EXECUTION,
+        queue_affinity, 1, &transfer_command, &command_buffers[i]);
+    if (!iree_status_is_ok(status)) break;
+    status = iree_hal_semaphore_create(device, 0ull, &fence_semaphores[i]);
+    if (!iree_status_is_ok(status)) break;
+    signal_values[i] = 1ull;
+    iree_hal_semaphore_list_t signal_semaphores = {
+        .count = 1,
+        .semaphores = &fence_semaphores[i],
+        .payload_values = &signal_values[i],
+    };
+    status = iree_hal_device_queue_execute(
+        device, queue_affinity, iree_hal_semaphore_list_empty(),
+        signal_semaphores, 1, &command_buffers[i]);
+    if (!iree_status_is_ok(status)) break;
+  }
+
+  // Join on all chunks; queues making independent progress overlap here.
+  if (iree_status_is_ok(status)) {
+    iree_hal_semaphore_list_t wait_semaphores = {
+        .count = chunk_count,
+        .semaphores = fence_semaphores,
+        .payload_values = signal_values,
+    };
+    status = iree_hal_device_wait_semaphores(device, IREE_HAL_WAIT_MODE_ALL,
+                                             wait_semaphores, timeout);
+  }
+
+  for (iree_host_size_t i = 0; i < chunk_count; ++i) {
+    iree_hal_command_buffer_release(command_buffers[i]);
+    iree_hal_semaphore_release(fence_semaphores[i]);
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
 //===----------------------------------------------------------------------===//
 // iree_hal_device_transfer_range implementations
 //===----------------------------------------------------------------------===//
@@ -277,22 +399,11 @@ static iree_status_t iree_hal_device_submit_transfer_range_and_wait(
     target_offset = 0;
   }
 
-  // Issue synchronous device copy.
+  // Issue synchronous device copy, split across queues when large enough.
   if (iree_status_is_ok(status)) {
-    const iree_hal_transfer_command_t transfer_command = {
-        .type = IREE_HAL_TRANSFER_COMMAND_TYPE_COPY,
-        .copy =
-            {
-                .source_buffer = source_buffer,
-                .source_offset = source_offset,
-                .target_buffer = target_buffer,
-                .target_offset = target_offset,
-                .length = data_length,
-            },
-    };
-    status = iree_hal_device_transfer_and_wait(device, /*wait_semaphore=*/NULL,
-                                               /*wait_value=*/0ull, 1,
-                                               &transfer_command, timeout);
+    status = iree_hal_device_copy_chunked_and_wait(
+        device, source_buffer, source_offset, target_buffer, target_offset,
+        data_length, timeout);
   }
 
   // Read back the staging buffer into memory, if needed.
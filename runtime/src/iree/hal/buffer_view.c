@@ -7,6 +7,7 @@
 #include "iree/hal/buffer_view.h"
 
 #include "iree/base/api.h"
+#include "iree/base/internal/synchronization.h"
 #include "iree/hal/allocator.h"
 #include "iree/hal/buffer_view_util.h"
 #include "iree/hal/resource.h"
@@ -14,7 +15,14 @@
 struct iree_hal_buffer_view_t {
   iree_atomic_ref_count_t ref_count;
   iree_allocator_t host_allocator;
-  iree_hal_buffer_t* buffer;
+  // Pool the view storage is returned to upon release, if any.
+  iree_hal_buffer_view_pool_t* pool;
+  union {
+    // Buffer the view references; valid while the view is live.
+    iree_hal_buffer_t* buffer;
+    // Freelist link; valid while the view storage is recycled in its pool.
+    iree_hal_buffer_view_t* next_free;
+  };
   iree_hal_element_type_t element_type;
   iree_hal_encoding_type_t encoding_type;
   iree_device_size_t byte_length;
@@ -22,6 +30,31 @@ struct iree_hal_buffer_view_t {
   iree_hal_dim_t shape[];
 };
 
+// Returns |buffer_view| storage to the pool it was created from.
+static void iree_hal_buffer_view_pool_recycle(
+    iree_hal_buffer_view_t* buffer_view);
+
+static void iree_hal_buffer_view_initialize(
+    iree_hal_buffer_t* buffer, iree_host_size_t shape_rank,
+    const iree_hal_dim_t* shape, iree_hal_element_type_t element_type,
+    iree_hal_encoding_type_t encoding_type, iree_allocator_t host_allocator,
+    iree_hal_buffer_view_pool_t* pool, iree_hal_buffer_view_t* buffer_view) {
+  iree_atomic_ref_count_init(&buffer_view->ref_count);
+  buffer_view->host_allocator = host_allocator;
+  buffer_view->pool = pool;
+  buffer_view->buffer = buffer;
+  iree_hal_buffer_retain(buffer_view->buffer);
+  buffer_view->element_type = element_type;
+  buffer_view->encoding_type = encoding_type;
+  buffer_view->byte_length =
+      iree_hal_element_dense_byte_count(buffer_view->element_type);
+  buffer_view->shape_rank = shape_rank;
+  for (iree_host_size_t i = 0; i < shape_rank; ++i) {
+    buffer_view->shape[i] = shape[i];
+    buffer_view->byte_length *= shape[i];
+  }
+}
+
 IREE_API_EXPORT iree_status_t iree_hal_buffer_view_create(
     iree_hal_buffer_t* buffer, iree_host_size_t shape_rank,
     const iree_hal_dim_t* shape, iree_hal_element_type_t element_type,
@@ -46,19 +79,9 @@ IREE_API_EXPORT iree_status_t iree_hal_buffer_view_create(
       sizeof(*buffer_view) + sizeof(iree_hal_dim_t) * shape_rank,
       (void**)&buffer_view);
   if (iree_status_is_ok(status)) {
-    iree_atomic_ref_count_init(&buffer_view->ref_count);
-    buffer_view->host_allocator = host_allocator;
-    buffer_view->buffer = buffer;
-    iree_hal_buffer_retain(buffer_view->buffer);
-    buffer_view->element_type = element_type;
-    buffer_view->encoding_type = encoding_type;
-    buffer_view->byte_length =
-        iree_hal_element_dense_byte_count(buffer_view->element_type);
-    buffer_view->shape_rank = shape_rank;
-    for (iree_host_size_t i = 0; i < shape_rank; ++i) {
-      buffer_view->shape[i] = shape[i];
-      buffer_view->byte_length *= shape[i];
-    }
+    iree_hal_buffer_view_initialize(buffer, shape_rank, shape, element_type,
+                                    encoding_type, host_allocator,
+                                    /*pool=*/NULL, buffer_view);
     *out_buffer_view = buffer_view;
   }
 
@@ -97,7 +120,11 @@ IREE_API_EXPORT void iree_hal_buffer_view_destroy(
   iree_allocator_t host_allocator = buffer_view->host_allocator;
   IREE_TRACE_ZONE_BEGIN(z0);
   iree_hal_buffer_release(buffer_view->buffer);
-  iree_allocator_free(host_allocator, buffer_view);
+  if (buffer_view->pool) {
+    iree_hal_buffer_view_pool_recycle(buffer_view);
+  } else {
+    iree_allocator_free(host_allocator, buffer_view);
+  }
   IREE_TRACE_ZONE_END(z0);
 }
 
@@ -240,3 +267,155 @@ IREE_API_EXPORT iree_status_t iree_hal_buffer_view_compute_range(
       buffer_view->encoding_type, indices_count, start_indices, lengths_count,
       lengths, out_start_offset, out_length);
 }
+
+//===----------------------------------------------------------------------===//
+// iree_hal_buffer_view_pool_t
+//===----------------------------------------------------------------------===//
+
+struct iree_hal_buffer_view_pool_t {
+  iree_atomic_ref_count_t ref_count;
+  iree_allocator_t host_allocator;
+  // Maximum shape rank the pooled storage blocks can hold. All blocks are
+  // sized uniformly so any recycled block can satisfy any pooled request.
+  iree_host_size_t max_shape_rank;
+  iree_slim_mutex_t mutex;
+  // Singly-linked list of recycled view storage blocks.
+  iree_hal_buffer_view_t* free_head IREE_GUARDED_BY(mutex);
+};
+
+IREE_API_EXPORT iree_status_t iree_hal_buffer_view_pool_create(
+    iree_host_size_t max_shape_rank, iree_allocator_t host_allocator,
+    iree_hal_buffer_view_pool_t** out_pool) {
+  IREE_ASSERT_ARGUMENT(out_pool);
+  *out_pool = NULL;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_hal_buffer_view_pool_t* pool = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(host_allocator, sizeof(*pool), (void**)&pool));
+  iree_atomic_ref_count_init(&pool->ref_count);
+  pool->host_allocator = host_allocator;
+  pool->max_shape_rank = max_shape_rank;
+  iree_slim_mutex_initialize(&pool->mutex);
+  pool->free_head = NULL;
+  *out_pool = pool;
+
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
+static void iree_hal_buffer_view_pool_destroy(
+    iree_hal_buffer_view_pool_t* pool) {
+  iree_allocator_t host_allocator = pool->host_allocator;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // No locking required: the last reference (live view or caller) is gone.
+  iree_hal_buffer_view_t* free_head = pool->free_head;
+  while (free_head) {
+    iree_hal_buffer_view_t* next_free = free_head->next_free;
+    iree_allocator_free(host_allocator, free_head);
+    free_head = next_free;
+  }
+  iree_slim_mutex_deinitialize(&pool->mutex);
+  iree_allocator_free(host_allocator, pool);
+
+  IREE_TRACE_ZONE_END(z0);
+}
+
+IREE_API_EXPORT void iree_hal_buffer_view_pool_retain(
+    iree_hal_buffer_view_pool_t* pool) {
+  if (IREE_LIKELY(pool)) {
+    iree_atomic_ref_count_inc(&pool->ref_count);
+  }
+}
+
+IREE_API_EXPORT void iree_hal_buffer_view_pool_release(
+    iree_hal_buffer_view_pool_t* pool) {
+  if (IREE_LIKELY(pool) && iree_atomic_ref_count_dec(&pool->ref_count) == 1) {
+    iree_hal_buffer_view_pool_destroy(pool);
+  }
+}
+
+IREE_API_EXPORT void iree_hal_buffer_view_pool_trim(
+    iree_hal_buffer_view_pool_t* pool) {
+  IREE_ASSERT_ARGUMENT(pool);
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_slim_mutex_lock(&pool->mutex);
+  iree_hal_buffer_view_t* free_head = pool->free_head;
+  pool->free_head = NULL;
+  iree_slim_mutex_unlock(&pool->mutex);
+  while (free_head) {
+    iree_hal_buffer_view_t* next_free = free_head->next_free;
+    iree_allocator_free(pool->host_allocator, free_head);
+    free_head = next_free;
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+}
+
+IREE_API_EXPORT iree_status_t iree_hal_buffer_view_create_pooled(
+    iree_hal_buffer_view_pool_t* pool, iree_hal_buffer_t* buffer,
+    iree_host_size_t shape_rank, const iree_hal_dim_t* shape,
+    iree_hal_element_type_t element_type,
+    iree_hal_encoding_type_t encoding_type,
+    iree_hal_buffer_view_t** out_buffer_view) {
+  IREE_ASSERT_ARGUMENT(pool);
+  IREE_ASSERT_ARGUMENT(buffer);
+  IREE_ASSERT_ARGUMENT(out_buffer_view);
+
+  *out_buffer_view = NULL;
+  if (IREE_UNLIKELY(shape_rank > 0 && !shape)) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "no shape dimensions specified");
+  }
+  if (IREE_UNLIKELY(shape_rank > pool->max_shape_rank)) {
+    // Rank exceeds the uniform pooled storage capacity; fall back to a one-off
+    // heap allocation that is freed on release as usual.
+    return iree_hal_buffer_view_create(buffer, shape_rank, shape, element_type,
+                                       encoding_type, pool->host_allocator,
+                                       out_buffer_view);
+  }
+
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Try to pop a recycled storage block; the common case in steady-state.
+  iree_slim_mutex_lock(&pool->mutex);
+  iree_hal_buffer_view_t* buffer_view = pool->free_head;
+  if (buffer_view) pool->free_head = buffer_view->next_free;
+  iree_slim_mutex_unlock(&pool->mutex);
+
+  iree_status_t status = iree_ok_status();
+  if (!buffer_view) {
+    // Pool empty (or still warming up); allocate a new block at the uniform
+    // capacity so it can be recycled for any future pooled view.
+    status = iree_allocator_malloc(
+        pool->host_allocator,
+        sizeof(*buffer_view) + sizeof(iree_hal_dim_t) * pool->max_shape_rank,
+        (void**)&buffer_view);
+  }
+  if (iree_status_is_ok(status)) {
+    iree_hal_buffer_view_initialize(buffer, shape_rank, shape, element_type,
+                                    encoding_type, pool->host_allocator, pool,
+                                    buffer_view);
+    // Each live view keeps the pool live so late releases have somewhere to
+    // return their storage.
+    iree_hal_buffer_view_pool_retain(pool);
+    *out_buffer_view = buffer_view;
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+static void iree_hal_buffer_view_pool_recycle(
+    iree_hal_buffer_view_t* buffer_view) {
+  iree_hal_buffer_view_pool_t* pool = buffer_view->pool;
+  iree_slim_mutex_lock(&pool->mutex);
+  buffer_view->next_free = pool->free_head;
+  pool->free_head = buffer_view;
+  iree_slim_mutex_unlock(&pool->mutex);
+  // May destroy the pool (and the storage just recycled into it) if this view
+  // outlived the last external pool reference.
+  iree_hal_buffer_view_pool_release(pool);
+}
@@ -285,6 +285,53 @@ IREE_API_EXPORT iree_status_t iree_hal_buffer_view_compute_range(
     const iree_hal_dim_t* lengths, iree_device_size_t* out_start_offset,
     iree_device_size_t* out_length);
 
+//===----------------------------------------------------------------------===//
+// iree_hal_buffer_view_pool_t
+//===----------------------------------------------------------------------===//
+
+// A pool of recycled buffer view storage used to amortize allocation costs in
+// applications that create and destroy many transient views (such as serving
+// loops issuing tens of thousands of invocations per second). Views created
+// from a pool return their storage to the pool when released instead of
+// freeing it and subsequent creations become a freelist pop plus metadata
+// assignment. All pooled storage blocks are uniformly sized so any recycled
+// block can satisfy any pooled request regardless of shape.
+//
+// Thread-safe; views may be created and released from any thread.
+typedef struct iree_hal_buffer_view_pool_t iree_hal_buffer_view_pool_t;
+
+// Creates a buffer view pool recycling storage for views of up to
+// |max_shape_rank| dimensions. Views with larger ranks are transparently
+// created unpooled from |host_allocator| as with iree_hal_buffer_view_create.
+// |out_pool| must be released by the caller; pool resources remain live until
+// all views created from the pool have also been released.
+IREE_API_EXPORT iree_status_t iree_hal_buffer_view_pool_create(
+    iree_host_size_t max_shape_rank, iree_allocator_t host_allocator,
+    iree_hal_buffer_view_pool_t** out_pool);
+
+// Retains the given |pool| for the caller.
+IREE_API_EXPORT void iree_hal_buffer_view_pool_retain(
+    iree_hal_buffer_view_pool_t* pool);
+
+// Releases the given |pool| from the caller.
+IREE_API_EXPORT void iree_hal_buffer_view_pool_release(
+    iree_hal_buffer_view_pool_t* pool);
+
+// Trims the pool by freeing all recycled view storage.
+// Live views created from the pool are unaffected.
+IREE_API_EXPORT void iree_hal_buffer_view_pool_trim(
+    iree_hal_buffer_view_pool_t* pool);
+
+// Creates a buffer view with the given |buffer| using storage from |pool|.
+// Equivalent to iree_hal_buffer_view_create with recycled storage used when
+// available. |out_buffer_view| must be released by the caller.
+IREE_API_EXPORT iree_status_t iree_hal_buffer_view_create_pooled(
+    iree_hal_buffer_view_pool_t* pool, iree_hal_buffer_t* buffer,
+    iree_host_size_t shape_rank, const iree_hal_dim_t* shape,
+    iree_hal_element_type_t element_type,
+    iree_hal_encoding_type_t encoding_type,
+    iree_hal_buffer_view_t** out_buffer_view);
+
 //===----------------------------------------------------------------------===//
 // iree_hal_buffer_view_t implementation details
 //===----------------------------------------------------------------------===//
@@ -555,9 +555,11 @@ IREE_API_EXPORT iree_status_t iree_hal_command_buffer_dispatch(
     // the executable/etc could be bogus but that's fine.
     return iree_ok_status();
   }
-  IREE_TRACE_ZONE_BEGIN(z0);
+  // Recorded per dispatch; sampled so production traces can thin the zone
+  // (and its string formatting below) on dispatch-heavy workloads.
+  IREE_TRACE_ZONE_BEGIN_SAMPLED(z0, IREE_TRACING_CATEGORY_HAL);
   IF_VALIDATING(command_buffer, {
-    IREE_RETURN_AND_END_ZONE_IF_ERROR(
+    IREE_RETURN_AND_END_ZONE_IF_ERROR_SAMPLED(
         z0, iree_hal_command_buffer_dispatch_validation(
                 command_buffer, VALIDATION_STATE(command_buffer), executable,
                 entry_point, workgroup_x, workgroup_y, workgroup_z));
@@ -571,17 +573,20 @@ IREE_API_EXPORT iree_status_t iree_hal_command_buffer_dispatch(
   // slice off a much larger allocation and then suballocate from that ourselves
   // so that we could avoid the tracy_malloc overheads per-dispatch.
   IREE_TRACE({
-    char xyz_string[32];
-    int xyz_string_length =
-        snprintf(xyz_string, IREE_ARRAYSIZE(xyz_string), "%ux%ux%u",
-                 workgroup_x, workgroup_y, workgroup_z);
-    IREE_TRACE_ZONE_APPEND_TEXT_STRING_VIEW(z0, xyz_string, xyz_string_length);
+    if (z0) {
+      char xyz_string[32];
+      int xyz_string_length =
+          snprintf(xyz_string, IREE_ARRAYSIZE(xyz_string), "%ux%ux%u",
+                   workgroup_x, workgroup_y, workgroup_z);
+      IREE_TRACE_ZONE_APPEND_TEXT_STRING_VIEW(z0, xyz_string,
+                                              xyz_string_length);
+    }
   });
 #endif  // IREE_HAL_VERBOSE_TRACING_ENABLE
   iree_status_t status = _VTABLE_DISPATCH(command_buffer, dispatch)(
       command_buffer, executable, entry_point, workgroup_x, workgroup_y,
       workgroup_z);
-  IREE_TRACE_ZONE_END(z0);
+  IREE_TRACE_ZONE_END_SAMPLED(z0);
   return status;
 }
 
@@ -0,0 +1,240 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Performance conformance tests measuring standardized microbenchmarks over
+// the CTS harness: submission latency, semaphore signal-to-wake latency,
+// host<->device transfer bandwidth, and command buffer recording cost.
+//
+// Results are emitted as one JSON line per metric prefixed with
+// `IREE_CTS_PERF` so driver runs can be diffed/gated with hard numbers:
+//   IREE_CTS_PERF {"driver":"local-task","benchmark":"submission_latency",...}
+//
+// By default the tests only report. Setting an environment variable of the
+// form `IREE_CTS_PERF_BUDGET_<BENCHMARK>` (upper-cased benchmark name, value
+// in the metric's unit) turns the corresponding benchmark into a hard
+// pass/fail gate, allowing per-driver regression thresholds to live alongside
+// whatever harness invokes the suite.
+
+#ifndef IREE_HAL_CTS_PERFORMANCE_TEST_H_
+#define IREE_HAL_CTS_PERFORMANCE_TEST_H_
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "iree/base/api.h"
+#include "iree/hal/api.h"
+#include "iree/hal/cts/cts_test_base.h"
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+
+namespace iree {
+namespace hal {
+namespace cts {
+
+namespace {
+// Iteration counts are kept small enough for software emulation and CI but
+// large enough that medians are stable on real hardware.
+constexpr int kLatencyIterations = 64;
+constexpr int kBandwidthIterations = 8;
+constexpr iree_device_size_t kBandwidthBufferSize = 8 * 1024 * 1024;
+constexpr int kRecordCommandCount = 256;
+}  // namespace
+
+class performance_test : public CtsTestBase {
+ protected:
+  using Clock = std::chrono::steady_clock;
+
+  static double ToNanos(Clock::duration duration) {
+    return std::chrono::duration<double, std::nano>(duration).count();
+  }
+
+  static double Median(std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+  }
+
+  // Emits one JSON result line and enforces the benchmark budget when the
+  // IREE_CTS_PERF_BUDGET_<BENCHMARK> environment variable is set. Budgets
+  // gate on the median so one scheduler hiccup doesn't flake the suite.
+  void ReportMetric(const char* benchmark, const char* unit,
+                    std::vector<double> samples) {
+    double median = Median(samples);
+    double minimum = *std::min_element(samples.begin(), samples.end());
+    fprintf(stdout,
+            "IREE_CTS_PERF {\"driver\":\"%s\",\"benchmark\":\"%s\","
+            "\"unit\":\"%s\",\"median\":%.1f,\"min\":%.1f,\"samples\":%zu}\n",
+            GetParam().c_str(), benchmark, unit, median, minimum,
+            samples.size());
+
+    std::string budget_key = std::string("IREE_CTS_PERF_BUDGET_") + benchmark;
+    std::transform(budget_key.begin(), budget_key.end(), budget_key.begin(),
+                   [](unsigned char c) { return std::toupper(c); });
+    const char* budget_value = std::getenv(budget_key.c_str());
+    if (budget_value) {
+      double budget = std::atof(budget_value);
+      EXPECT_LE(median, budget)
+          << benchmark << " median " << median << unit
+          << " exceeds budget from " << budget_key << "=" << budget_value;
+    }
+  }
+
+  void CreateTransferBuffer(iree_hal_buffer_t** out_buffer) {
+    iree_hal_buffer_params_t params = {0};
+    params.type = IREE_HAL_MEMORY_TYPE_DEVICE_LOCAL;
+    params.usage = IREE_HAL_BUFFER_USAGE_TRANSFER;
+    IREE_ASSERT_OK(iree_hal_allocator_allocate_buffer(
+        device_allocator_, params, kBandwidthBufferSize, out_buffer));
+  }
+};
+
+// Measures the round-trip latency of submitting an empty one-shot command
+// buffer and waiting for its signal semaphore. This covers queue submission,
+// scheduling, and semaphore wake cost along the same path the runtime uses
+// for every dispatch batch.
+TEST_P(performance_test, SubmissionLatency) {
+  iree_hal_command_buffer_t* command_buffer = NULL;
+  IREE_ASSERT_OK(iree_hal_command_buffer_create(
+      device_, IREE_HAL_COMMAND_BUFFER_MODE_ONE_SHOT,
+      IREE_HAL_COMMAND_CATEGORY_TRANSFER, IREE_HAL_QUEUE_AFFINITY_ANY,
+      /*binding_capacity=*/0, &command_buffer));
+  IREE_ASSERT_OK(iree_hal_command_buffer_begin(command_buffer));
+  IREE_ASSERT_OK(iree_hal_command_buffer_end(command_buffer));
+
+  // Warm up allocator/queue state outside of measurement.
+  IREE_ASSERT_OK(SubmitCommandBufferAndWait(command_buffer));
+
+  std::vector<double> samples;
+  samples.reserve(kLatencyIterations);
+  for (int i = 0; i < kLatencyIterations; ++i) {
+    auto start = Clock::now();
+    IREE_ASSERT_OK(SubmitCommandBufferAndWait(command_buffer));
+    samples.push_back(ToNanos(Clock::now() - start));
+  }
+  iree_hal_command_buffer_release(command_buffer);
+
+  ReportMetric("submission_latency", "ns", std::move(samples));
+}
+
+// Measures the latency from a host thread signaling a semaphore to a waiting
+// host thread waking up. A slow wake path here directly inflates every
+// cross-queue and host/device synchronization point.
+TEST_P(performance_test, SemaphoreSignalToWake) {
+  std::vector<double> samples;
+  samples.reserve(kLatencyIterations);
+  for (int i = 0; i < kLatencyIterations; ++i) {
+    iree_hal_semaphore_t* semaphore = NULL;
+    IREE_ASSERT_OK(iree_hal_semaphore_create(device_, 0ull, &semaphore));
+
+    Clock::time_point signal_time;
+    std::thread signal_thread([&]() {
+      // Give the main thread time to enter the wait before signaling so the
+      // measurement covers the blocking wake path and not a fast poll.
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      signal_time = Clock::now();
+      IREE_ASSERT_OK(iree_hal_semaphore_signal(semaphore, 1ull));
+    });
+    IREE_ASSERT_OK(
+        iree_hal_semaphore_wait(semaphore, 1ull, iree_infinite_timeout()));
+    auto wake_time = Clock::now();
+    signal_thread.join();
+    samples.push_back(ToNanos(wake_time - signal_time));
+
+    iree_hal_semaphore_release(semaphore);
+  }
+
+  ReportMetric("semaphore_signal_to_wake", "ns", std::move(samples));
+}
+
+// Measures host-to-device transfer bandwidth through the synchronous
+// transfer path.
+TEST_P(performance_test, TransferBandwidthH2D) {
+  iree_hal_buffer_t* device_buffer = NULL;
+  CreateTransferBuffer(&device_buffer);
+  std::vector<uint8_t> host_data(kBandwidthBufferSize, 0xAB);
+
+  std::vector<double> samples;
+  samples.reserve(kBandwidthIterations);
+  for (int i = 0; i < kBandwidthIterations; ++i) {
+    auto start = Clock::now();
+    IREE_ASSERT_OK(iree_hal_device_transfer_h2d(
+        device_, host_data.data(), device_buffer, 0, kBandwidthBufferSize,
+        IREE_HAL_TRANSFER_BUFFER_FLAG_DEFAULT, iree_infinite_timeout()));
+    double seconds =
+        std::chrono::duration<double>(Clock::now() - start).count();
+    samples.push_back((double)kBandwidthBufferSize / seconds / (1024 * 1024));
+  }
+  iree_hal_buffer_release(device_buffer);
+
+  ReportMetric("transfer_bandwidth_h2d", "MB/s", std::move(samples));
+}
+
+// Measures device-to-host transfer bandwidth through the synchronous
+// transfer path.
+TEST_P(performance_test, TransferBandwidthD2H) {
+  iree_hal_buffer_t* device_buffer = NULL;
+  CreateTransferBuffer(&device_buffer);
+  std::vector<uint8_t> host_data(kBandwidthBufferSize);
+
+  std::vector<double> samples;
+  samples.reserve(kBandwidthIterations);
+  for (int i = 0; i < kBandwidthIterations; ++i) {
+    auto start = Clock::now();
+    IREE_ASSERT_OK(iree_hal_device_transfer_d2h(
+        device_, device_buffer, 0, host_data.data(), kBandwidthBufferSize,
+        IREE_HAL_TRANSFER_BUFFER_FLAG_DEFAULT, iree_infinite_timeout()));
+    double seconds =
+        std::chrono::duration<double>(Clock::now() - start).count();
+    samples.push_back((double)kBandwidthBufferSize / seconds / (1024 * 1024));
+  }
+  iree_hal_buffer_release(device_buffer);
+
+  ReportMetric("transfer_bandwidth_d2h", "MB/s", std::move(samples));
+}
+
+// Measures command buffer recording cost: create/begin, a fixed number of
+// fill commands, and end. Recording shows up on the critical path whenever
+// programs build one-shot command buffers per invocation.
+TEST_P(performance_test, CommandBufferRecordCost) {
+  iree_hal_buffer_t* device_buffer = NULL;
+  CreateTransferBuffer(&device_buffer);
+  const uint32_t pattern = 0x01020304u;
+
+  std::vector<double> samples;
+  samples.reserve(kLatencyIterations);
+  for (int i = 0; i < kLatencyIterations; ++i) {
+    auto start = Clock::now();
+    iree_hal_command_buffer_t* command_buffer = NULL;
+    IREE_ASSERT_OK(iree_hal_command_buffer_create(
+        device_, IREE_HAL_COMMAND_BUFFER_MODE_ONE_SHOT,
+        IREE_HAL_COMMAND_CATEGORY_TRANSFER, IREE_HAL_QUEUE_AFFINITY_ANY,
+        /*binding_capacity=*/0, &command_buffer));
+    IREE_ASSERT_OK(iree_hal_command_buffer_begin(command_buffer));
+    for (int j = 0; j < kRecordCommandCount; ++j) {
+      IREE_ASSERT_OK(iree_hal_command_buffer_fill_buffer(
+          command_buffer, device_buffer, /*target_offset=*/0,
+          /*length=*/sizeof(pattern), &pattern, sizeof(pattern)));
+    }
+    IREE_ASSERT_OK(iree_hal_command_buffer_end(command_buffer));
+    samples.push_back(ToNanos(Clock::now() - start));
+    iree_hal_command_buffer_release(command_buffer);
+  }
+  iree_hal_buffer_release(device_buffer);
+
+  ReportMetric("command_buffer_record_cost", "ns", std::move(samples));
+}
+
+}  // namespace cts
+}  // namespace hal
+}  // namespace iree
+
+#endif  // IREE_HAL_CTS_PERFORMANCE_TEST_H_
@@ -12,29 +12,43 @@
 
 #include "iree/base/api.h"
 
+// Dispatches a method on a HAL object vtable through the vtable pointer
+// stored on the resource. This is the default dispatch mode and works with
+// any number of implementations linked into the binary.
+#define IREE_HAL_VTABLE_DISPATCH_INDIRECT(resource, type_prefix, method_name) \
+  ((const type_prefix##_vtable_t*)((const iree_hal_resource_t*)(resource))    \
+       ->vtable)                                                              \
+      ->method_name
+
+// Single-driver builds can replace the indirect dispatch with direct calls to
+// the vtables of the sole linked implementation so that LTO can perform
+// cross-compilation unit inlining and strip unused HAL calls. This is
+// particularly useful for super tiny builds (web/embedded) where there's only
+// ever one usable backend and debugging features like command buffer
+// validation aren't required. The provided header must define
+// IREE_HAL_VTABLE_DISPATCH(resource, type_prefix, method_name) for every
+// dispatched type, falling back to IREE_HAL_VTABLE_DISPATCH_INDIRECT for any
+// type with multiple linked implementations; see
+// iree/hal/drivers/local_sync/static_dispatch.h for a reference.
+//
+// Specify a custom header with
+//   -DIREE_HAL_VTABLE_DISPATCH_HEADER='"my_dispatch.h"'
+// It's easy to accidentally break static dispatch builds (by not routing
+// through this interface, using the vtable for object instance comparison,
+// etc) so deployments relying on it should build with the setting in CI.
+#if defined(IREE_HAL_VTABLE_DISPATCH_HEADER)
+#include IREE_HAL_VTABLE_DISPATCH_HEADER
+#endif  // IREE_HAL_VTABLE_DISPATCH_HEADER
+
+// Dispatches a method on a HAL object vtable.
+#if !defined(IREE_HAL_VTABLE_DISPATCH)
+#define IREE_HAL_VTABLE_DISPATCH IREE_HAL_VTABLE_DISPATCH_INDIRECT
+#endif  // !IREE_HAL_VTABLE_DISPATCH
+
 #ifdef __cplusplus
 extern "C" {
 #endif  // __cplusplus
 
-// Dispatches a method on a HAL object vtable.
-//
-// In the future we can use this to compile in a mode where all indirect
-// dispatches are replaced by direct calls to static methods. For example,
-// by changing the macro to resolve to `iree_hal_[resource]_[method_name]` we
-// can rely on LTO to perform cross-compilation unit inlining/strip unused HAL
-// calls/etc. This will be particularly useful for super tiny builds
-// (web/embedded) where there's only ever one usable backend and debugging
-// features like command buffer validation aren't required.
-//
-// Some changes (mostly whackamole) are still required to fully support this and
-// it's critical there's a CI building with the setting as it's not hard to keep
-// working but very easy to accidentally break (by not routing through this
-// interface, using the vtable for object instance comparison, etc).
-#define IREE_HAL_VTABLE_DISPATCH(resource, type_prefix, method_name)       \
-  ((const type_prefix##_vtable_t*)((const iree_hal_resource_t*)(resource)) \
-       ->vtable)                                                           \
-      ->method_name
-
 // Defines the iree_hal_<type_name>_retain/_release methods.
 #define IREE_HAL_API_RETAIN_RELEASE(type_name)                           \
   IREE_API_EXPORT void iree_hal_##type_name##_destroy(                   \
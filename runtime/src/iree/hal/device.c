@@ -334,6 +334,27 @@ IREE_API_EXPORT iree_status_t iree_hal_device_queue_barrier(
   return status;
 }
 
+IREE_API_EXPORT iree_status_t iree_hal_device_queue_callback(
+    iree_hal_device_t* device, iree_hal_queue_affinity_t queue_affinity,
+    const iree_hal_semaphore_list_t wait_semaphore_list,
+    const iree_hal_semaphore_list_t signal_semaphore_list,
+    iree_hal_queue_callback_fn_t callback, void* user_data) {
+  IREE_ASSERT_ARGUMENT(device);
+  IREE_ASSERT_ARGUMENT(
+      !wait_semaphore_list.count ||
+      (wait_semaphore_list.semaphores && wait_semaphore_list.payload_values));
+  IREE_ASSERT_ARGUMENT(!signal_semaphore_list.count ||
+                       (signal_semaphore_list.semaphores &&
+                        signal_semaphore_list.payload_values));
+  IREE_ASSERT_ARGUMENT(callback);
+  IREE_TRACE_ZONE_BEGIN(z0);
+  iree_status_t status = _VTABLE_DISPATCH(device, queue_callback)(
+      device, queue_affinity, wait_semaphore_list, signal_semaphore_list,
+      callback, user_data);
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
 IREE_API_EXPORT iree_status_t iree_hal_device_queue_flush(
     iree_hal_device_t* device, iree_hal_queue_affinity_t queue_affinity) {
   IREE_ASSERT_ARGUMENT(device);
@@ -276,6 +276,16 @@ iree_status_t iree_hal_device_trim(iree_hal_device_t* device);
 //
 // Returned values must remain the same for the lifetime of the device as
 // callers may cache them to avoid redundant calls.
+//
+// The exception is the optional `hal.device.stats` category holding
+// monitoring counters that change as the device runs and are cheap enough to
+// poll frequently (~100Hz). Implementations may support any subset:
+//   hal.device.stats :: submissions.inflight
+//     Queue submissions accepted but not yet retired.
+//   hal.device.stats :: semaphore.wait_ns
+//     Cumulative host time spent blocked waiting on semaphores.
+//   hal.device.stats :: executable_cache.hits / executable_cache.misses
+//     Cumulative executable/graph cache acquisition counters.
 IREE_API_EXPORT iree_status_t iree_hal_device_query_i64(
     iree_hal_device_t* device, iree_string_view_t category,
     iree_string_view_t key, int64_t* out_value);
@@ -414,6 +424,30 @@ IREE_API_EXPORT iree_status_t iree_hal_device_queue_barrier(
     const iree_hal_semaphore_list_t wait_semaphore_list,
     const iree_hal_semaphore_list_t signal_semaphore_list);
 
+// Function invoked on the queue timeline by iree_hal_device_queue_callback.
+// |user_data| is the value provided when the callback was enqueued.
+typedef void(IREE_API_PTR* iree_hal_queue_callback_fn_t)(void* user_data);
+
+// Enqueues a host |callback| on a device queue.
+// The callback is invoked after the entire |wait_semaphore_list| has been
+// reached and |signal_semaphore_list| will be signaled after the callback
+// returns. This allows completion-driven host logic to run in queue order
+// without requiring a dedicated thread waiting on a semaphore.
+//
+// The callback may be invoked from a driver-managed thread and must complete
+// quickly: it must not block and must not make calls back into the device
+// (new submissions, synchronous waits, etc) as doing so may deadlock the
+// timeline. Heavy work should be handed off to an application-owned executor.
+//
+// Not all implementations support queue-ordered callbacks and callers must be
+// prepared to handle IREE_STATUS_UNIMPLEMENTED by falling back to waiting on
+// the semaphores from a host thread.
+IREE_API_EXPORT iree_status_t iree_hal_device_queue_callback(
+    iree_hal_device_t* device, iree_hal_queue_affinity_t queue_affinity,
+    const iree_hal_semaphore_list_t wait_semaphore_list,
+    const iree_hal_semaphore_list_t signal_semaphore_list,
+    iree_hal_queue_callback_fn_t callback, void* user_data);
+
 // Flushes any locally-pending submissions in the queue.
 // When submitting many queue operations this can be used to eagerly flush
 // earlier submissions while later ones are still being constructed.
@@ -613,6 +647,12 @@ typedef struct iree_hal_device_vtable_t {
       iree_host_size_t command_buffer_count,
       iree_hal_command_buffer_t* const* command_buffers);
 
+  iree_status_t(IREE_API_PTR* queue_callback)(
+      iree_hal_device_t* device, iree_hal_queue_affinity_t queue_affinity,
+      const iree_hal_semaphore_list_t wait_semaphore_list,
+      const iree_hal_semaphore_list_t signal_semaphore_list,
+      iree_hal_queue_callback_fn_t callback, void* user_data);
+
   iree_status_t(IREE_API_PTR* queue_flush)(
       iree_hal_device_t* device, iree_hal_queue_affinity_t queue_affinity);
 
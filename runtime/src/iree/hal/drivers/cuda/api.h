@@ -62,6 +62,27 @@ typedef struct iree_hal_cuda_device_params_t {
   // concurrently unless prohibited by semaphores.
   iree_host_size_t queue_count;
 
+  // Number of CUDA streams the device distributes dispatch work across.
+  // Submissions rotate over the stream pool and submissions with no
+  // dependencies between them may overlap on the GPU. Ordering between
+  // dependent submissions is preserved regardless of which stream they land
+  // on: the scheduler derives CUevent edges from submission semaphore
+  // wait/signal lists and CUevent waits work across streams.
+  //
+  // 1 (the default) issues all dispatch work to a single stream. Note that
+  // stream_tracing only instruments the primary stream; use a single stream
+  // when accurate dispatch timing is required.
+  iree_host_size_t dispatch_stream_count;
+
+  // Issues transfer-only submissions (readbacks of sampled results, uploads,
+  // file streaming) on a dedicated copy stream instead of the dispatch stream
+  // pool. The copy then launches as soon as the CUevents for its wait
+  // semaphores resolve rather than queuing behind unrelated dispatch work,
+  // letting device-to-host readbacks overlap subsequent compute and use the
+  // copy engines. Ordering with dependent submissions is preserved via the
+  // cross-stream event waits derived from semaphore lists.
+  bool dedicated_transfer_stream;
+
   // Total size of each block in the device shared block pool.
   // Larger sizes will lower overhead and ensure the heap isn't hit for
   // transient allocations while also increasing memory consumption.
@@ -77,6 +98,13 @@ typedef struct iree_hal_cuda_device_params_t {
   // Specifies how command buffers are recorded and executed.
   iree_hal_cuda_command_buffer_mode_t command_buffer_mode;
 
+  // Enables caching of instantiated executable graphs in graph command buffer
+  // mode. Re-recordings with a matching topology (the common case for
+  // repeated invocations that differ only in buffer pointers and launch
+  // parameters) are re-bound in place via cuGraphExecUpdate instead of paying
+  // milliseconds for cuGraphInstantiate on every submission.
+  bool graph_caching;
+
   // Enables tracing of command buffers when IREE tracing is enabled.
   // May take advantage of additional extensions for more accurate timing or
   // hardware-specific performance counters.
@@ -99,6 +127,43 @@ typedef struct iree_hal_cuda_device_params_t {
 IREE_API_EXPORT void iree_hal_cuda_device_params_initialize(
     iree_hal_cuda_device_params_t* out_params);
 
+// Called when a pooled queue-ordered allocation of |allocation_size| bytes
+// fails because the pool is exhausted. Implementations should release device
+// memory they can recreate later (e.g. evictable cache blocks) and return OK
+// to have the allocation retried. Returning a non-OK status stops retrying
+// and the original allocation failure is returned to the caller; the status
+// is otherwise ignored. May be called from any thread performing queue-ordered
+// allocations and must not allocate device memory itself.
+typedef iree_status_t(IREE_API_PTR* iree_hal_cuda_memory_pressure_callback_fn_t)(
+    void* user_data, iree_device_size_t allocation_size);
+
+// A callback invoked under device memory pressure and its user data.
+typedef struct iree_hal_cuda_memory_pressure_callback_t {
+  iree_hal_cuda_memory_pressure_callback_fn_t fn;
+  void* user_data;
+} iree_hal_cuda_memory_pressure_callback_t;
+
+// Sets the memory pressure callback invoked when pooled queue-ordered
+// allocations on |device| exhaust their pool. Pass a zeroed callback to clear.
+// Only applies to devices using async allocations; synchronous allocation
+// fallbacks do not trigger the callback.
+IREE_API_EXPORT iree_status_t iree_hal_cuda_device_set_memory_pressure_callback(
+    iree_hal_device_t* device,
+    iree_hal_cuda_memory_pressure_callback_t callback);
+
+// Enables direct access from |device| to memory allocated on |peer_device|.
+// Once enabled copies between buffers of the two devices issued against
+// |device| queues take the direct fabric path between the GPUs (NVLink when
+// present, PCIe otherwise) instead of staging through host memory.
+//
+// Peer access is asymmetric: call once per direction for bidirectional
+// access. Succeeds if access was already enabled. Fails with
+// IREE_STATUS_UNAVAILABLE if the devices cannot access each other; use
+// iree_hal_cuda_driver_query_p2p_link to query capability before committing
+// to a placement.
+IREE_API_EXPORT iree_status_t iree_hal_cuda_device_enable_peer_access(
+    iree_hal_device_t* device, iree_hal_device_t* peer_device);
+
 //===----------------------------------------------------------------------===//
 // iree_hal_cuda_driver_t
 //===----------------------------------------------------------------------===//
@@ -124,6 +189,31 @@ IREE_API_EXPORT iree_status_t iree_hal_cuda_driver_create(
     const iree_hal_cuda_device_params_t* default_params,
     iree_allocator_t host_allocator, iree_hal_driver_t** out_driver);
 
+// Describes the peer-to-peer link from one CUDA device to another.
+typedef struct iree_hal_cuda_p2p_link_t {
+  // True if the source device can directly access memory on the peer device.
+  // All other fields are only valid when this is set.
+  bool supported;
+  // Relative performance of the link as reported by the driver. Lower ranks
+  // indicate faster paths: devices on a shared NVLink island rank above those
+  // reachable only over PCIe hops. Only meaningful for ordering links of the
+  // same device; the absolute value carries no unit.
+  int32_t performance_rank;
+  // True if the link supports native atomic operations.
+  bool native_atomics;
+} iree_hal_cuda_p2p_link_t;
+
+// Queries the peer-to-peer link from |device_id| to |peer_device_id|.
+// Device IDs are those returned by iree_hal_driver_query_available_devices.
+// Placement layers can use the link information to co-locate workloads that
+// exchange data on devices sharing a fast interconnect.
+//
+// Querying only reports capability; access must still be enabled per device
+// pair with iree_hal_cuda_device_enable_peer_access.
+IREE_API_EXPORT iree_status_t iree_hal_cuda_driver_query_p2p_link(
+    iree_hal_driver_t* driver, iree_hal_device_id_t device_id,
+    iree_hal_device_id_t peer_device_id, iree_hal_cuda_p2p_link_t* out_link);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
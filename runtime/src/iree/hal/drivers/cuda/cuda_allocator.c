@@ -9,14 +9,41 @@
 #include <stddef.h>
 
 #include "iree/base/api.h"
+#include "iree/base/internal/synchronization.h"
 #include "iree/hal/drivers/cuda/cuda_buffer.h"
 #include "iree/hal/drivers/cuda/cuda_dynamic_symbols.h"
 #include "iree/hal/drivers/cuda/cuda_status_util.h"
+#include "iree/hal/drivers/cuda/virtual_buffer.h"
 
 #if IREE_TRACING_FEATURES & IREE_TRACING_FEATURE_ALLOCATION_TRACKING
 static const char* IREE_HAL_CUDA_ALLOCATOR_ID = "CUDA unpooled";
 #endif  // IREE_TRACING_FEATURE_ALLOCATION_TRACKING
 
+// Total number of host registrations retained by the import cache.
+// Imports are rare enough that a linear scan over a small table beats any
+// fancier structure and keeps the hot path to a handful of compares.
+#define IREE_HAL_CUDA_REGISTRATION_CACHE_CAPACITY 16
+
+// A single cached cuMemHostRegister registration. Registrations are inserted
+// when host allocations are imported and retained after the importing buffer
+// is released so that subsequent imports of the same (or a contained) range
+// skip the multi-millisecond register/unregister round-trip.
+typedef struct iree_hal_cuda_registration_cache_entry_t {
+  // Base of the registered host range; NULL indicates an unused slot.
+  void* host_ptr;
+  // Total size of the registered range in bytes.
+  iree_host_size_t size;
+  // Device pointer mapping to |host_ptr|.
+  CUdeviceptr device_ptr;
+  // CU_MEMHOSTREGISTER_* flags the range was registered with.
+  uint32_t register_flags;
+  // Number of live imported buffers referencing the registration; entries are
+  // only evictable when this reaches zero.
+  int32_t use_count;
+  // Monotonic tick of the most recent use; lowest tick evicts first.
+  uint64_t last_use_tick;
+} iree_hal_cuda_registration_cache_entry_t;
+
 typedef struct iree_hal_cuda_allocator_t {
   // Abstract resource used for injecting reference counting and vtable;
   // must be at offset 0.
@@ -43,6 +70,24 @@ typedef struct iree_hal_cuda_allocator_t {
   // Whether host memory can be registered with CU_MEMHOSTREGISTER_READ_ONLY.
   bool supports_read_only_host_register;
 
+  // Whether the device shares physical memory with the host (Jetson/Tegra and
+  // other integrated parts). Host-visible heaps run at full memory bandwidth
+  // and readback-heavy buffers should prefer host-coherent placement.
+  bool is_integrated;
+
+  // Theoretical peak global memory bandwidth derived from the memory clock and
+  // bus width device attributes; 0 if the attributes were unavailable.
+  // Advertised on memory heaps so placement selection can rank them.
+  iree_device_size_t device_bandwidth_bytes_per_second;
+
+  // Guards the registration cache below.
+  iree_slim_mutex_t registration_mutex;
+  // Monotonic tick used to order registration cache entries for LRU eviction.
+  uint64_t registration_tick;
+  // Recently imported host allocation registrations kept alive for reuse.
+  iree_hal_cuda_registration_cache_entry_t
+      registration_cache[IREE_HAL_CUDA_REGISTRATION_CACHE_CAPACITY];
+
   IREE_STATISTICS(iree_hal_allocator_statistics_t statistics;)
 } iree_hal_cuda_allocator_t;
 
@@ -54,6 +99,130 @@ static iree_hal_cuda_allocator_t* iree_hal_cuda_allocator_cast(
   return (iree_hal_cuda_allocator_t*)base_value;
 }
 
+// Returns true if the cached |entry| registration can serve an import of
+// [host_ptr, host_ptr+size) with |register_flags|. A read-only registration
+// can only serve read-only imports while a writable one can serve either.
+static bool iree_hal_cuda_registration_cache_entry_covers(
+    const iree_hal_cuda_registration_cache_entry_t* entry, void* host_ptr,
+    iree_host_size_t size, uint32_t register_flags) {
+  if (!entry->host_ptr) return false;
+  if ((uint8_t*)host_ptr < (uint8_t*)entry->host_ptr ||
+      (uint8_t*)host_ptr + size > (uint8_t*)entry->host_ptr + entry->size) {
+    return false;
+  }
+  if (iree_all_bits_set(entry->register_flags, CU_MEMHOSTREGISTER_READ_ONLY) &&
+      !iree_all_bits_set(register_flags, CU_MEMHOSTREGISTER_READ_ONLY)) {
+    return false;
+  }
+  return true;
+}
+
+// Tries to serve an import of [host_ptr, host_ptr+size) from the registration
+// cache. On a hit the entry use count is incremented, the device pointer
+// mapping |host_ptr| is returned, and no cuMemHostRegister call is required.
+static bool iree_hal_cuda_allocator_registration_cache_lookup(
+    iree_hal_cuda_allocator_t* allocator, void* host_ptr,
+    iree_host_size_t size, uint32_t register_flags,
+    CUdeviceptr* out_device_ptr) {
+  bool found = false;
+  iree_slim_mutex_lock(&allocator->registration_mutex);
+  for (iree_host_size_t i = 0;
+       i < IREE_HAL_CUDA_REGISTRATION_CACHE_CAPACITY; ++i) {
+    iree_hal_cuda_registration_cache_entry_t* entry =
+        &allocator->registration_cache[i];
+    if (iree_hal_cuda_registration_cache_entry_covers(entry, host_ptr, size,
+                                                      register_flags)) {
+      ++entry->use_count;
+      entry->last_use_tick = ++allocator->registration_tick;
+      *out_device_ptr =
+          entry->device_ptr +
+          (CUdeviceptr)((uint8_t*)host_ptr - (uint8_t*)entry->host_ptr);
+      found = true;
+      break;
+    }
+  }
+  iree_slim_mutex_unlock(&allocator->registration_mutex);
+  return found;
+}
+
+// Inserts a registration that was just performed into the cache with an
+// initial use count of one (the importing buffer). If the cache is full of
+// in-use entries the registration is not cached and remains owned by the
+// importing buffer which will unregister it on release as before.
+static void iree_hal_cuda_allocator_registration_cache_insert(
+    iree_hal_cuda_allocator_t* allocator, void* host_ptr,
+    iree_host_size_t size, uint32_t register_flags, CUdeviceptr device_ptr) {
+  iree_slim_mutex_lock(&allocator->registration_mutex);
+  iree_hal_cuda_registration_cache_entry_t* slot = NULL;
+  for (iree_host_size_t i = 0;
+       i < IREE_HAL_CUDA_REGISTRATION_CACHE_CAPACITY; ++i) {
+    iree_hal_cuda_registration_cache_entry_t* entry =
+        &allocator->registration_cache[i];
+    if (!entry->host_ptr) {
+      slot = entry;
+      break;
+    } else if (entry->use_count == 0 &&
+               (!slot || entry->last_use_tick < slot->last_use_tick)) {
+      slot = entry;  // LRU unreferenced entry; may be displaced by a free one.
+    }
+  }
+  if (slot) {
+    if (slot->host_ptr) {
+      // Evicting an unreferenced registration; release it back to the driver.
+      IREE_CUDA_IGNORE_ERROR(allocator->symbols,
+                             cuMemHostUnregister(slot->host_ptr));
+    }
+    slot->host_ptr = host_ptr;
+    slot->size = size;
+    slot->device_ptr = device_ptr;
+    slot->register_flags = register_flags;
+    slot->use_count = 1;
+    slot->last_use_tick = ++allocator->registration_tick;
+  }
+  iree_slim_mutex_unlock(&allocator->registration_mutex);
+}
+
+// Releases one use of the cached registration covering |host_ptr|.
+// Returns true if the registration is owned by the cache and the caller must
+// not unregister the memory; false if the registration was never cached and
+// the caller retains ownership.
+static bool iree_hal_cuda_allocator_registration_cache_release(
+    iree_hal_cuda_allocator_t* allocator, void* host_ptr) {
+  bool found = false;
+  iree_slim_mutex_lock(&allocator->registration_mutex);
+  for (iree_host_size_t i = 0;
+       i < IREE_HAL_CUDA_REGISTRATION_CACHE_CAPACITY; ++i) {
+    iree_hal_cuda_registration_cache_entry_t* entry =
+        &allocator->registration_cache[i];
+    if (entry->host_ptr && (uint8_t*)host_ptr >= (uint8_t*)entry->host_ptr &&
+        (uint8_t*)host_ptr < (uint8_t*)entry->host_ptr + entry->size) {
+      --entry->use_count;
+      found = true;
+      break;
+    }
+  }
+  iree_slim_mutex_unlock(&allocator->registration_mutex);
+  return found;
+}
+
+// Unregisters all cached registrations; those still in use when |keep_used|
+// is false are dropped as well (only valid during allocator teardown).
+static void iree_hal_cuda_allocator_registration_cache_clear(
+    iree_hal_cuda_allocator_t* allocator, bool keep_used) {
+  iree_slim_mutex_lock(&allocator->registration_mutex);
+  for (iree_host_size_t i = 0;
+       i < IREE_HAL_CUDA_REGISTRATION_CACHE_CAPACITY; ++i) {
+    iree_hal_cuda_registration_cache_entry_t* entry =
+        &allocator->registration_cache[i];
+    if (!entry->host_ptr) continue;
+    if (keep_used && entry->use_count > 0) continue;
+    IREE_CUDA_IGNORE_ERROR(allocator->symbols,
+                           cuMemHostUnregister(entry->host_ptr));
+    memset(entry, 0, sizeof(*entry));
+  }
+  iree_slim_mutex_unlock(&allocator->registration_mutex);
+}
+
 iree_status_t iree_hal_cuda_allocator_create(
     const iree_hal_cuda_dynamic_symbols_t* cuda_symbols, CUdevice device,
     CUstream stream, iree_hal_cuda_memory_pools_t* pools,
@@ -97,6 +266,26 @@ iree_status_t iree_hal_cuda_allocator_create(
                                       ? "has READ_ONLY_HOST_REGISTER_SUPPORTED"
                                       : "no READ_ONLY_HOST_REGISTER_SUPPORTED");
 
+  // Advisory attributes used to rank memory heaps during placement selection;
+  // failures leave the values at 0 and selection falls back to the fixed heap
+  // ordering.
+  int is_integrated = 0;
+  IREE_CUDA_IGNORE_ERROR(
+      cuda_symbols, cuDeviceGetAttribute(&is_integrated,
+                                         CU_DEVICE_ATTRIBUTE_INTEGRATED,
+                                         device));
+  int memory_clock_khz = 0;
+  IREE_CUDA_IGNORE_ERROR(
+      cuda_symbols, cuDeviceGetAttribute(&memory_clock_khz,
+                                         CU_DEVICE_ATTRIBUTE_MEMORY_CLOCK_RATE,
+                                         device));
+  int memory_bus_width_bits = 0;
+  IREE_CUDA_IGNORE_ERROR(
+      cuda_symbols,
+      cuDeviceGetAttribute(&memory_bus_width_bits,
+                           CU_DEVICE_ATTRIBUTE_GLOBAL_MEMORY_BUS_WIDTH,
+                           device));
+
   iree_hal_cuda_allocator_t* allocator = NULL;
   IREE_RETURN_AND_END_ZONE_IF_ERROR(
       z0, iree_allocator_malloc(host_allocator, sizeof(*allocator),
@@ -113,6 +302,12 @@ iree_status_t iree_hal_cuda_allocator_create(
       supports_concurrent_managed_access != 0;
   allocator->supports_read_only_host_register =
       supports_read_only_host_register != 0;
+  allocator->is_integrated = is_integrated != 0;
+  // DDR transfers twice per clock; clock is reported in kHz and width in bits.
+  allocator->device_bandwidth_bytes_per_second =
+      (iree_device_size_t)memory_clock_khz * 1000 * 2 *
+      (memory_bus_width_bits / 8);
+  iree_slim_mutex_initialize(&allocator->registration_mutex);
   *out_allocator = (iree_hal_allocator_t*)allocator;
 
   IREE_TRACE_ZONE_END(z0);
@@ -126,6 +321,9 @@ static void iree_hal_cuda_allocator_destroy(
       iree_hal_cuda_allocator_cast(base_allocator);
   IREE_TRACE_ZONE_BEGIN(z0);
 
+  iree_hal_cuda_allocator_registration_cache_clear(allocator,
+                                                   /*keep_used=*/false);
+  iree_slim_mutex_deinitialize(&allocator->registration_mutex);
   iree_allocator_free(allocator->host_allocator, allocator);
 
   IREE_TRACE_ZONE_END(z0);
@@ -140,6 +338,11 @@ static iree_allocator_t iree_hal_cuda_allocator_host_allocator(
 
 static iree_status_t iree_hal_cuda_allocator_trim(
     iree_hal_allocator_t* IREE_RESTRICT base_allocator) {
+  iree_hal_cuda_allocator_t* allocator =
+      iree_hal_cuda_allocator_cast(base_allocator);
+  // Drop cached host registrations that no live buffer references.
+  iree_hal_cuda_allocator_registration_cache_clear(allocator,
+                                                   /*keep_used=*/true);
   return iree_ok_status();
 }
 
@@ -189,6 +392,15 @@ static iree_status_t iree_hal_cuda_allocator_query_memory_heaps(
 
   int i = 0;
 
+  // On integrated parts (Jetson/Tegra) host-visible heaps run at full memory
+  // bandwidth and are advertised as such so placement selection routes
+  // readback-heavy buffers to host-coherent memory; on discrete parts host
+  // access crosses the bus at an unknown rate and is left unadvertised.
+  const iree_device_size_t device_bandwidth =
+      allocator->device_bandwidth_bytes_per_second;
+  const iree_device_size_t unified_host_bandwidth =
+      allocator->is_integrated ? device_bandwidth : 0;
+
   // Device-local memory (dispatch resources):
   heaps[i++] = (iree_hal_allocator_memory_heap_t){
       .type = IREE_HAL_MEMORY_TYPE_DEVICE_LOCAL,
@@ -196,6 +408,7 @@ static iree_status_t iree_hal_cuda_allocator_query_memory_heaps(
           IREE_HAL_BUFFER_USAGE_TRANSFER | IREE_HAL_BUFFER_USAGE_DISPATCH,
       .max_allocation_size = max_allocation_size,
       .min_alignment = min_alignment,
+      .device_bandwidth_bytes_per_second = device_bandwidth,
   };
 
   if (allocator->supports_concurrent_managed_access) {
@@ -209,10 +422,15 @@ static iree_status_t iree_hal_cuda_allocator_query_memory_heaps(
                          IREE_HAL_BUFFER_USAGE_MAPPING,
         .max_allocation_size = max_allocation_size,
         .min_alignment = min_alignment,
+        .device_bandwidth_bytes_per_second = device_bandwidth,
+        .host_bandwidth_bytes_per_second = unified_host_bandwidth,
     };
   }
 
   // Write-combined page-locked host-local memory (upload):
+  // NOTE: host bandwidth is left unadvertised even on integrated parts as
+  // write-combined memory serves uncached host reads and must not win
+  // readback placement.
   heaps[i++] = (iree_hal_allocator_memory_heap_t){
       .type = IREE_HAL_MEMORY_TYPE_DEVICE_VISIBLE |
               IREE_HAL_MEMORY_TYPE_HOST_LOCAL |
@@ -222,6 +440,7 @@ static iree_status_t iree_hal_cuda_allocator_query_memory_heaps(
                        IREE_HAL_BUFFER_USAGE_MAPPING,
       .max_allocation_size = max_allocation_size,
       .min_alignment = min_alignment,
+      .device_bandwidth_bytes_per_second = unified_host_bandwidth,
   };
 
   // Cached page-locked host-local memory (download):
@@ -235,6 +454,8 @@ static iree_status_t iree_hal_cuda_allocator_query_memory_heaps(
                        IREE_HAL_BUFFER_USAGE_MAPPING,
       .max_allocation_size = max_allocation_size,
       .min_alignment = min_alignment,
+      .device_bandwidth_bytes_per_second = unified_host_bandwidth,
+      .host_bandwidth_bytes_per_second = unified_host_bandwidth,
   };
 
   IREE_ASSERT(i == count);
@@ -286,6 +507,23 @@ iree_hal_cuda_allocator_query_buffer_compatibility(
         IREE_HAL_MEMORY_TYPE_HOST_LOCAL | IREE_HAL_MEMORY_TYPE_DEVICE_VISIBLE;
   }
 
+  // Resolve IREE_HAL_MEMORY_TYPE_OPTIMAL by ranking heaps on the bandwidth
+  // they advertise for the requested access pattern. On integrated parts this
+  // routes readback-heavy buffers to host-coherent placement; on discrete
+  // parts no host bandwidth is advertised and the fixed heap preference order
+  // is preserved. Selection failures (e.g. over-constrained type bits) are
+  // ignored and left for allocation to report.
+  if (iree_all_bits_set(params->type, IREE_HAL_MEMORY_TYPE_OPTIMAL)) {
+    iree_hal_memory_type_t selected_type = IREE_HAL_MEMORY_TYPE_NONE;
+    iree_status_t status = iree_hal_allocator_select_memory_type(
+        base_allocator, params, &selected_type);
+    if (iree_status_is_ok(status)) {
+      params->type = selected_type;
+    } else {
+      iree_status_ignore(status);
+    }
+  }
+
   // We are now optimal.
   params->type &= ~IREE_HAL_MEMORY_TYPE_OPTIMAL;
 
@@ -322,6 +560,12 @@ static void iree_hal_cuda_buffer_free(
       IREE_TRACE_ZONE_APPEND_TEXT(z0, "(ignored; async)");
       break;
     }
+    case IREE_HAL_CUDA_BUFFER_TYPE_VIRTUAL: {
+      // Virtual buffers release their reservation and committed chunks via
+      // their release callback.
+      IREE_TRACE_ZONE_APPEND_TEXT(z0, "(ignored; virtual)");
+      break;
+    }
     case IREE_HAL_CUDA_BUFFER_TYPE_EXTERNAL: {
       IREE_TRACE_ZONE_APPEND_TEXT(z0, "(ignored; external)");
       break;
@@ -471,9 +715,16 @@ static void iree_hal_cuda_allocator_deallocate_buffer(
   // to silently ignore them: whatever the user tries to do next will fail in
   // the same way and if we were deallocating this buffer as part of a tear-down
   // on failure we don't want to end up dying during cleanup.
-  iree_hal_cuda_buffer_free(allocator->symbols, buffer_type,
-                            iree_hal_cuda_buffer_device_pointer(base_buffer),
-                            iree_hal_cuda_buffer_host_pointer(base_buffer));
+  if (buffer_type == IREE_HAL_CUDA_BUFFER_TYPE_HOST_REGISTERED &&
+      iree_hal_cuda_allocator_registration_cache_release(
+          allocator, iree_hal_cuda_buffer_host_pointer(base_buffer))) {
+    // Registration retained by the import cache for reuse; unregistered on
+    // eviction, trim, or allocator teardown.
+  } else {
+    iree_hal_cuda_buffer_free(allocator->symbols, buffer_type,
+                              iree_hal_cuda_buffer_device_pointer(base_buffer),
+                              iree_hal_cuda_buffer_host_pointer(base_buffer));
+  }
 
   switch (buffer_type) {
     case IREE_HAL_CUDA_BUFFER_TYPE_DEVICE:
@@ -494,6 +745,20 @@ static void iree_hal_cuda_allocator_deallocate_buffer(
   iree_hal_buffer_destroy(base_buffer);
 }
 
+iree_status_t iree_hal_cuda_allocator_create_virtual_buffer(
+    iree_hal_allocator_t* base_allocator, iree_hal_buffer_params_t params,
+    iree_device_size_t allocation_size, iree_hal_buffer_t** out_buffer) {
+  IREE_ASSERT_ARGUMENT(base_allocator);
+  IREE_ASSERT_ARGUMENT(out_buffer);
+  iree_hal_cuda_allocator_t* allocator =
+      iree_hal_cuda_allocator_cast(base_allocator);
+  // NOTE: virtual buffers are not tracked in allocator statistics as their
+  // physical residency changes over the buffer lifetime.
+  return iree_hal_cuda_virtual_buffer_create(
+      base_allocator, allocator->symbols, allocator->device, params,
+      allocation_size, allocator->host_allocator, out_buffer);
+}
+
 static iree_status_t iree_hal_cuda_allocator_import_buffer(
     iree_hal_allocator_t* IREE_RESTRICT base_allocator,
     const iree_hal_buffer_params_t* IREE_RESTRICT params,
@@ -556,6 +821,13 @@ static iree_status_t iree_hal_cuda_allocator_import_buffer(
           allocator->supports_read_only_host_register) {
         register_flags |= CU_MEMHOSTREGISTER_READ_ONLY;
       }
+      if (iree_hal_cuda_allocator_registration_cache_lookup(
+              allocator, host_ptr, (iree_host_size_t)external_buffer->size,
+              register_flags, &device_ptr)) {
+        // A previous import already registered a covering range; reuse it and
+        // skip the expensive cuMemHostRegister call.
+        break;
+      }
       status = IREE_CURESULT_TO_STATUS(
           allocator->symbols,
           cuMemHostRegister(host_ptr, external_buffer->size, register_flags),
@@ -566,6 +838,20 @@ static iree_status_t iree_hal_cuda_allocator_import_buffer(
             cuMemHostGetDevicePointer(&device_ptr, host_ptr, 0),
             "cuMemHostGetDevicePointer");
       }
+      if (iree_status_is_ok(status)) {
+        iree_hal_cuda_allocator_registration_cache_insert(
+            allocator, host_ptr, (iree_host_size_t)external_buffer->size,
+            register_flags, device_ptr);
+      } else if (iree_hal_cuda_allocator_registration_cache_lookup(
+                     allocator, host_ptr,
+                     (iree_host_size_t)external_buffer->size, register_flags,
+                     &device_ptr)) {
+        // Lost a registration race with a concurrent import of the same range
+        // (the driver rejects overlapping registrations); serve it from the
+        // entry the winner just inserted.
+        iree_status_ignore(status);
+        status = iree_ok_status();
+      }
       break;
     }
     case IREE_HAL_EXTERNAL_BUFFER_TYPE_DEVICE_ALLOCATION: {
@@ -596,8 +882,14 @@ static iree_status_t iree_hal_cuda_allocator_import_buffer(
     *out_buffer = buffer;
   } else {
     if (!buffer && (device_ptr || host_ptr)) {
-      iree_hal_cuda_buffer_free(allocator->symbols, buffer_type, device_ptr,
-                                host_ptr);
+      if (buffer_type == IREE_HAL_CUDA_BUFFER_TYPE_HOST_REGISTERED &&
+          iree_hal_cuda_allocator_registration_cache_release(allocator,
+                                                             host_ptr)) {
+        // Registration retained by the import cache.
+      } else {
+        iree_hal_cuda_buffer_free(allocator->symbols, buffer_type, device_ptr,
+                                  host_ptr);
+      }
     } else {
       iree_hal_buffer_release(buffer);
     }
@@ -26,6 +26,17 @@ iree_status_t iree_hal_cuda_allocator_create(
     CUstream stream, iree_hal_cuda_memory_pools_t* pools,
     iree_allocator_t host_allocator, iree_hal_allocator_t** out_allocator);
 
+// Creates a device-local buffer spanning |allocation_size| bytes of reserved
+// virtual address space with no physical memory committed. Physical backing is
+// committed and released on demand with
+// iree_hal_cuda_virtual_buffer_commit_range/decommit_range; see
+// virtual_buffer.h for the commit semantics.
+// |base_allocator| must be a CUDA allocator created with
+// iree_hal_cuda_allocator_create.
+iree_status_t iree_hal_cuda_allocator_create_virtual_buffer(
+    iree_hal_allocator_t* base_allocator, iree_hal_buffer_params_t params,
+    iree_device_size_t allocation_size, iree_hal_buffer_t** out_buffer);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
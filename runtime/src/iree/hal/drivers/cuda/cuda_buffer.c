@@ -159,6 +159,13 @@ void* iree_hal_cuda_buffer_host_pointer(const iree_hal_buffer_t* base_buffer) {
   return buffer->host_ptr;
 }
 
+iree_hal_buffer_release_callback_t iree_hal_cuda_buffer_release_callback(
+    const iree_hal_buffer_t* base_buffer) {
+  const iree_hal_cuda_buffer_t* buffer =
+      iree_hal_cuda_buffer_const_cast(base_buffer);
+  return buffer->release_callback;
+}
+
 void iree_hal_cuda_buffer_drop_release_callback(
     iree_hal_buffer_t* base_buffer) {
   iree_hal_cuda_buffer_t* buffer = iree_hal_cuda_buffer_cast(base_buffer);
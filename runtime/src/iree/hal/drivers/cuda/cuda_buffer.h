@@ -27,6 +27,10 @@ typedef enum iree_hal_cuda_buffer_type_e {
   // Device local buffer, allocated with cuMemAllocFromPoolAsync, freed with
   // cuMemFree/cuMemFreeAsync.
   IREE_HAL_CUDA_BUFFER_TYPE_ASYNC,
+  // Device local buffer backed by virtual address space reserved with
+  // cuMemAddressReserve; physical memory is committed and released on demand
+  // with cuMemMap/cuMemUnmap.
+  IREE_HAL_CUDA_BUFFER_TYPE_VIRTUAL,
   // Externally registered buffer whose providence is unknown.
   // Must be freed by the user.
   IREE_HAL_CUDA_BUFFER_TYPE_EXTERNAL,
@@ -56,6 +60,12 @@ CUdeviceptr iree_hal_cuda_buffer_device_pointer(
 // Returns the CUDA host pointer for the given |buffer|, if available.
 void* iree_hal_cuda_buffer_host_pointer(const iree_hal_buffer_t* buffer);
 
+// Returns the release callback registered on |buffer| when it was wrapped.
+// Buffer-type implementations that stash bookkeeping state as the callback
+// user data (such as virtual buffers) use this to get it back.
+iree_hal_buffer_release_callback_t iree_hal_cuda_buffer_release_callback(
+    const iree_hal_buffer_t* buffer);
+
 // Drops the release callback so that when the buffer is destroyed no callback
 // will be made. This is not thread safe but all callers are expected to be
 // holding an allocation and the earliest the buffer could be destroyed is after
@@ -11,6 +11,7 @@
 #include <string.h>
 
 #include "iree/base/internal/arena.h"
+#include "iree/base/internal/atomics.h"
 #include "iree/base/internal/event_pool.h"
 #include "iree/base/internal/math.h"
 #include "iree/hal/drivers/cuda/cuda_allocator.h"
@@ -19,6 +20,7 @@
 #include "iree/hal/drivers/cuda/event_pool.h"
 #include "iree/hal/drivers/cuda/event_semaphore.h"
 #include "iree/hal/drivers/cuda/graph_command_buffer.h"
+#include "iree/hal/drivers/cuda/graph_exec_cache.h"
 #include "iree/hal/drivers/cuda/memory_pools.h"
 #include "iree/hal/drivers/cuda/nccl_channel.h"
 #include "iree/hal/drivers/cuda/nccl_dynamic_symbols.h"
@@ -32,6 +34,15 @@
 #include "iree/hal/utils/file_transfer.h"
 #include "iree/hal/utils/memory_file.h"
 
+// The maximal number of CUstreams dispatch work may be distributed across.
+// Each stream costs device resources and there's rarely enough independent
+// work in flight to keep more than a handful busy.
+#define IREE_HAL_CUDA_MAX_DISPATCH_STREAM_COUNT 8
+
+// The maximal number of instantiated executable graphs retained for re-binding
+// when graph_caching is enabled.
+#define IREE_HAL_CUDA_GRAPH_EXEC_CACHE_CAPACITY 8
+
 //===----------------------------------------------------------------------===//
 // iree_hal_cuda_device_t
 //===----------------------------------------------------------------------===//
@@ -58,11 +69,20 @@ typedef struct iree_hal_cuda_device_t {
 
   CUcontext cu_context;
   CUdevice cu_device;
-  // TODO: Support multiple device streams.
-  // The CUstream used to issue device kernels and allocations.
-  CUstream dispatch_cu_stream;
+  // Pool of CUstreams used to issue device kernels and allocations.
+  // Submissions rotate across the pool so that independent workloads may
+  // overlap on the GPU; the primary stream [0] is additionally used for
+  // stream-ordered allocations and tracing.
+  CUstream dispatch_cu_streams[IREE_HAL_CUDA_MAX_DISPATCH_STREAM_COUNT];
+  iree_host_size_t dispatch_stream_count;
+  // Monotonically increasing counter used to rotate across dispatch streams.
+  iree_atomic_int32_t next_dispatch_stream;
   // The CUstream used to issue host callback functions.
   CUstream callback_cu_stream;
+  // Dedicated CUstream for transfer-only submissions so that readbacks and
+  // uploads launch as soon as their wait semaphores resolve instead of
+  // queuing behind dispatch work; NULL when disabled via params.
+  CUstream transfer_cu_stream;
 
   iree_hal_cuda_tracing_context_t* tracing_context;
 
@@ -74,6 +94,10 @@ typedef struct iree_hal_cuda_device_t {
   // Timepoint pools, shared by various semaphores.
   iree_hal_cuda_timepoint_pool_t* timepoint_pool;
 
+  // Optional cache of instantiated executable graphs re-bound across
+  // recordings when graph_caching is enabled; NULL otherwise.
+  iree_hal_cuda_graph_exec_cache_t* graph_exec_cache;
+
   // A queue to order device workloads and relase to the GPU when constraints
   // are met. It buffers submissions and allocations internally before they
   // are ready. This queue couples with HAL semaphores backed by iree_event_t
@@ -87,6 +111,10 @@ typedef struct iree_hal_cuda_device_t {
 
   // Optional provider used for creating/configuring collective channels.
   iree_hal_channel_provider_t* channel_provider;
+
+  // Total time the host has spent blocked in wait_semaphores, accumulated for
+  // monitoring queries.
+  iree_atomic_int64_t semaphore_wait_ns;
 } iree_hal_cuda_device_t;
 
 static const iree_hal_device_vtable_t iree_hal_cuda_device_vtable;
@@ -108,7 +136,10 @@ IREE_API_EXPORT void iree_hal_cuda_device_params_initialize(
   out_params->arena_block_size = 32 * 1024;
   out_params->event_pool_capacity = 32;
   out_params->queue_count = 1;
+  out_params->dispatch_stream_count = 1;
+  out_params->dedicated_transfer_stream = true;
   out_params->command_buffer_mode = IREE_HAL_CUDA_COMMAND_BUFFER_MODE_GRAPH;
+  out_params->graph_caching = true;
   out_params->stream_tracing = false;
   out_params->async_allocations = true;
 }
@@ -123,13 +154,23 @@ static iree_status_t iree_hal_cuda_device_check_params(
     return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
                             "at least one queue is required");
   }
+  if (params->dispatch_stream_count == 0 ||
+      params->dispatch_stream_count >
+          IREE_HAL_CUDA_MAX_DISPATCH_STREAM_COUNT) {
+    return iree_make_status(
+        IREE_STATUS_INVALID_ARGUMENT,
+        "dispatch stream count must be between 1 and %d (provided %" PRIhsz
+        ")",
+        IREE_HAL_CUDA_MAX_DISPATCH_STREAM_COUNT, params->dispatch_stream_count);
+  }
   return iree_ok_status();
 }
 
 static iree_status_t iree_hal_cuda_device_create_internal(
     iree_hal_driver_t* driver, iree_string_view_t identifier,
     const iree_hal_cuda_device_params_t* params, CUdevice cu_device,
-    CUstream dispatch_stream, CUstream callback_stream, CUcontext context,
+    const CUstream* dispatch_streams, CUstream callback_stream,
+    CUstream transfer_stream, CUcontext context,
     const iree_hal_cuda_dynamic_symbols_t* cuda_symbols,
     const iree_hal_cuda_nccl_dynamic_symbols_t* nccl_symbols,
     iree_allocator_t host_allocator, iree_hal_device_t** out_device) {
@@ -151,23 +192,43 @@ static iree_status_t iree_hal_cuda_device_create_internal(
   device->params = *params;
   device->cu_context = context;
   device->cu_device = cu_device;
-  device->dispatch_cu_stream = dispatch_stream;
+  memcpy(device->dispatch_cu_streams, dispatch_streams,
+         params->dispatch_stream_count * sizeof(CUstream));
+  device->dispatch_stream_count = params->dispatch_stream_count;
+  iree_atomic_store_int32(&device->next_dispatch_stream, 0,
+                          iree_memory_order_relaxed);
+  iree_atomic_store_int64(&device->semaphore_wait_ns, 0,
+                          iree_memory_order_relaxed);
   device->callback_cu_stream = callback_stream;
+  device->transfer_cu_stream = transfer_stream;
   device->host_allocator = host_allocator;
 
   iree_status_t status = iree_hal_cuda_pending_queue_actions_create(
       cuda_symbols, &device->block_pool, host_allocator,
       &device->pending_queue_actions);
 
-  // Enable tracing for the (currently only) stream - no-op if disabled.
+  if (iree_status_is_ok(status) && params->graph_caching &&
+      params->command_buffer_mode == IREE_HAL_CUDA_COMMAND_BUFFER_MODE_GRAPH) {
+    status = iree_hal_cuda_graph_exec_cache_create(
+        cuda_symbols, IREE_HAL_CUDA_GRAPH_EXEC_CACHE_CAPACITY, host_allocator,
+        &device->graph_exec_cache);
+  }
+
+  // Enable tracing for the primary dispatch stream - no-op if disabled.
+  // Work issued to other streams in the pool is not instrumented.
   if (iree_status_is_ok(status) && device->params.stream_tracing) {
     status = iree_hal_cuda_tracing_context_allocate(
-        device->cuda_symbols, device->identifier, dispatch_stream,
+        device->cuda_symbols, device->identifier, dispatch_streams[0],
         &device->block_pool, host_allocator, &device->tracing_context);
   }
 
   // Memory pool support is conditional.
-  if (iree_status_is_ok(status) && params->async_allocations) {
+  // NOTE: stream-ordered allocations are only ordered against the stream they
+  // were issued on; with multiple dispatch streams a consumer may land on a
+  // different stream than the allocation and race it. Fall back to synchronous
+  // allocation when the dispatch stream pool is in use.
+  if (iree_status_is_ok(status) && params->async_allocations &&
+      params->dispatch_stream_count == 1) {
     int supports_memory_pools = 0;
     status = IREE_CURESULT_TO_STATUS(
         cuda_symbols,
@@ -187,7 +248,7 @@ static iree_status_t iree_hal_cuda_device_create_internal(
 
   if (iree_status_is_ok(status)) {
     status = iree_hal_cuda_allocator_create(
-        cuda_symbols, cu_device, dispatch_stream,
+        cuda_symbols, cu_device, dispatch_streams[0],
         device->supports_memory_pools ? &device->memory_pools : NULL,
         host_allocator, &device->device_allocator);
   }
@@ -224,11 +285,13 @@ iree_status_t iree_hal_cuda_device_create(
     status = IREE_CURESULT_TO_STATUS(cuda_symbols, cuCtxSetCurrent(context));
   }
 
-  // Create the default dispatch stream for the device.
-  CUstream dispatch_stream = NULL;
-  if (iree_status_is_ok(status)) {
+  // Create the pool of dispatch streams for the device.
+  CUstream dispatch_streams[IREE_HAL_CUDA_MAX_DISPATCH_STREAM_COUNT] = {NULL};
+  for (iree_host_size_t i = 0;
+       iree_status_is_ok(status) && i < params->dispatch_stream_count; ++i) {
     status = IREE_CURESULT_TO_STATUS(
-        cuda_symbols, cuStreamCreate(&dispatch_stream, CU_STREAM_NON_BLOCKING));
+        cuda_symbols,
+        cuStreamCreate(&dispatch_streams[i], CU_STREAM_NON_BLOCKING));
   }
   // Create the default callback stream for the device.
   CUstream callback_stream = NULL;
@@ -236,15 +299,28 @@ iree_status_t iree_hal_cuda_device_create(
     status = IREE_CURESULT_TO_STATUS(
         cuda_symbols, cuStreamCreate(&callback_stream, CU_STREAM_NON_BLOCKING));
   }
+  // Create the dedicated transfer stream, if enabled.
+  CUstream transfer_stream = NULL;
+  if (iree_status_is_ok(status) && params->dedicated_transfer_stream) {
+    status = IREE_CURESULT_TO_STATUS(
+        cuda_symbols, cuStreamCreate(&transfer_stream, CU_STREAM_NON_BLOCKING));
+  }
 
   if (iree_status_is_ok(status)) {
     status = iree_hal_cuda_device_create_internal(
-        driver, identifier, params, device, dispatch_stream, callback_stream,
-        context, cuda_symbols, nccl_symbols, host_allocator, out_device);
+        driver, identifier, params, device, dispatch_streams, callback_stream,
+        transfer_stream, context, cuda_symbols, nccl_symbols, host_allocator,
+        out_device);
   } else {
     // Release resources we have accquired thus far.
+    if (transfer_stream) cuda_symbols->cuStreamDestroy(transfer_stream);
     if (callback_stream) cuda_symbols->cuStreamDestroy(callback_stream);
-    if (dispatch_stream) cuda_symbols->cuStreamDestroy(dispatch_stream);
+    for (iree_host_size_t i = 0; i < IREE_HAL_CUDA_MAX_DISPATCH_STREAM_COUNT;
+         ++i) {
+      if (dispatch_streams[i]) {
+        cuda_symbols->cuStreamDestroy(dispatch_streams[i]);
+      }
+    }
     if (context) cuda_symbols->cuDevicePrimaryCtxRelease(device);
   }
 
@@ -293,6 +369,70 @@ CUcontext iree_hal_cuda_device_context(iree_hal_device_t* base_device) {
   return device->cu_context;
 }
 
+IREE_API_EXPORT iree_status_t iree_hal_cuda_device_set_memory_pressure_callback(
+    iree_hal_device_t* base_device,
+    iree_hal_cuda_memory_pressure_callback_t callback) {
+  iree_hal_cuda_device_t* device = iree_hal_cuda_device_cast(base_device);
+  if (!device->supports_memory_pools) {
+    return iree_make_status(
+        IREE_STATUS_FAILED_PRECONDITION,
+        "device is not using memory pools for queue-ordered allocations");
+  }
+  iree_hal_cuda_memory_pools_set_pressure_callback(&device->memory_pools,
+                                                   callback);
+  return iree_ok_status();
+}
+
+IREE_API_EXPORT iree_status_t iree_hal_cuda_device_enable_peer_access(
+    iree_hal_device_t* base_device, iree_hal_device_t* base_peer_device) {
+  IREE_ASSERT_ARGUMENT(base_device);
+  IREE_ASSERT_ARGUMENT(base_peer_device);
+  iree_hal_cuda_device_t* device = iree_hal_cuda_device_cast(base_device);
+  if (!iree_hal_resource_is(base_peer_device, &iree_hal_cuda_device_vtable)) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "peer device is not a CUDA device");
+  }
+  iree_hal_cuda_device_t* peer_device =
+      iree_hal_cuda_device_cast(base_peer_device);
+  if (device == peer_device) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "device cannot be its own peer");
+  }
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Peer access is recorded against the current context; bind the device's
+  // own context for the call regardless of what the calling thread has
+  // current.
+  IREE_CUDA_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, device->cuda_symbols, cuCtxPushCurrent(device->cu_context),
+      "cuCtxPushCurrent");
+  CUresult result =
+      device->cuda_symbols->cuCtxEnablePeerAccess(peer_device->cu_context, 0);
+  CUcontext unused_context = NULL;
+  IREE_CUDA_IGNORE_ERROR(device->cuda_symbols,
+                         cuCtxPopCurrent(&unused_context));
+
+  iree_status_t status = iree_ok_status();
+  switch (result) {
+    case CUDA_SUCCESS:
+    case CUDA_ERROR_PEER_ACCESS_ALREADY_ENABLED:
+      break;
+    case CUDA_ERROR_PEER_ACCESS_UNSUPPORTED:
+      status = iree_make_status(
+          IREE_STATUS_UNAVAILABLE,
+          "devices do not support peer access; verify connectivity with "
+          "iree_hal_cuda_driver_query_p2p_link");
+      break;
+    default:
+      status = iree_hal_cuda_result_to_status(device->cuda_symbols, result,
+                                              __FILE__, __LINE__);
+      break;
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
 const iree_hal_cuda_dynamic_symbols_t* iree_hal_cuda_device_dynamic_symbols(
     iree_hal_device_t* base_device) {
   iree_hal_cuda_device_t* device =
@@ -310,6 +450,10 @@ static void iree_hal_cuda_device_destroy(iree_hal_device_t* base_device) {
   iree_hal_cuda_pending_queue_actions_destroy(
       (iree_hal_resource_t*)device->pending_queue_actions);
 
+  // All command buffers must have been released before the device is
+  // destroyed so the cache holds the only remaining executable graphs.
+  iree_hal_cuda_graph_exec_cache_free(device->graph_exec_cache);
+
   // There should be no more buffers live that use the allocator.
   iree_hal_allocator_release(device->device_allocator);
 
@@ -330,8 +474,15 @@ static void iree_hal_cuda_device_destroy(iree_hal_device_t* base_device) {
   }
   if (device->host_event_pool) iree_event_pool_free(device->host_event_pool);
 
-  IREE_CUDA_IGNORE_ERROR(symbols, cuStreamDestroy(device->dispatch_cu_stream));
+  for (iree_host_size_t i = 0; i < device->dispatch_stream_count; ++i) {
+    IREE_CUDA_IGNORE_ERROR(symbols,
+                           cuStreamDestroy(device->dispatch_cu_streams[i]));
+  }
   IREE_CUDA_IGNORE_ERROR(symbols, cuStreamDestroy(device->callback_cu_stream));
+  if (device->transfer_cu_stream) {
+    IREE_CUDA_IGNORE_ERROR(symbols,
+                           cuStreamDestroy(device->transfer_cu_stream));
+  }
 
   IREE_CUDA_IGNORE_ERROR(symbols, cuDevicePrimaryCtxRelease(device->cu_device));
 
@@ -419,6 +570,32 @@ static iree_status_t iree_hal_cuda_device_query_i64(
     return iree_ok_status();
   }
 
+  if (iree_string_view_equal(category, IREE_SV("hal.device.stats"))) {
+    if (iree_string_view_equal(key, IREE_SV("submissions.inflight"))) {
+      *out_value =
+          (int64_t)iree_hal_cuda_pending_queue_actions_outstanding_count(
+              device->pending_queue_actions);
+      return iree_ok_status();
+    } else if (iree_string_view_equal(key, IREE_SV("semaphore.wait_ns"))) {
+      *out_value = iree_atomic_load_int64(&device->semaphore_wait_ns,
+                                          iree_memory_order_relaxed);
+      return iree_ok_status();
+    } else if (iree_string_view_equal(key, IREE_SV("executable_cache.hits")) ||
+               iree_string_view_equal(key,
+                                      IREE_SV("executable_cache.misses"))) {
+      int64_t hit_count = 0;
+      int64_t miss_count = 0;
+      if (device->graph_exec_cache) {
+        iree_hal_cuda_graph_exec_cache_query_statistics(
+            device->graph_exec_cache, &hit_count, &miss_count);
+      }
+      *out_value = iree_string_view_equal(key, IREE_SV("executable_cache.hits"))
+                       ? hit_count
+                       : miss_count;
+      return iree_ok_status();
+    }
+  }
+
   if (iree_string_view_equal(category, IREE_SV("cuda.device"))) {
     if (iree_string_view_equal(key, IREE_SV("compute_capability_major"))) {
       return iree_hal_cuda_device_query_attribute(
@@ -523,13 +700,14 @@ static iree_status_t iree_hal_cuda_device_create_channel(
 iree_status_t iree_hal_cuda_device_create_stream_command_buffer(
     iree_hal_device_t* base_device, iree_hal_command_buffer_mode_t mode,
     iree_hal_command_category_t command_categories,
-    iree_host_size_t binding_capacity,
+    iree_host_size_t binding_capacity, CUstream cu_stream,
     iree_hal_command_buffer_t** out_command_buffer) {
   iree_hal_cuda_device_t* device = iree_hal_cuda_device_cast(base_device);
+  if (!cu_stream) cu_stream = device->dispatch_cu_streams[0];
   return iree_hal_cuda_stream_command_buffer_create(
       base_device, device->cuda_symbols, device->nccl_symbols,
       device->tracing_context, mode, command_categories, binding_capacity,
-      device->dispatch_cu_stream, &device->block_pool, device->host_allocator,
+      cu_stream, &device->block_pool, device->host_allocator,
       out_command_buffer);
 }
 
@@ -545,8 +723,8 @@ static iree_status_t iree_hal_cuda_device_create_command_buffer(
       return iree_hal_cuda_graph_command_buffer_create(
           base_device, device->cuda_symbols, device->tracing_context,
           device->cu_context, mode, command_categories, queue_affinity,
-          binding_capacity, &device->block_pool, device->host_allocator,
-          out_command_buffer);
+          binding_capacity, &device->block_pool, device->graph_exec_cache,
+          device->host_allocator, out_command_buffer);
     case IREE_HAL_CUDA_COMMAND_BUFFER_MODE_STREAM:
       return iree_hal_deferred_command_buffer_create(
           base_device, mode, command_categories, binding_capacity,
@@ -654,7 +832,7 @@ static iree_status_t iree_hal_cuda_device_queue_alloca(
   if (device->supports_memory_pools &&
       !iree_all_bits_set(params.type, IREE_HAL_MEMORY_TYPE_HOST_VISIBLE)) {
     status = iree_hal_cuda_memory_pools_alloca(
-        &device->memory_pools, device->dispatch_cu_stream, pool, params,
+        &device->memory_pools, device->dispatch_cu_streams[0], pool, params,
         allocation_size, out_buffer);
   } else {
     status = iree_hal_allocator_allocate_buffer(
@@ -693,7 +871,7 @@ static iree_status_t iree_hal_cuda_device_queue_dealloca(
   iree_status_t status = iree_ok_status();
   if (device->supports_memory_pools) {
     status = iree_hal_cuda_memory_pools_dealloca(
-        &device->memory_pools, device->dispatch_cu_stream, buffer);
+        &device->memory_pools, device->dispatch_cu_streams[0], buffer);
   }
 
   // Only signal if not returning a synchronous error - synchronous failure
@@ -752,6 +930,22 @@ static void iree_hal_cuda_device_collect_tracing_context(void* user_data) {
       (iree_hal_cuda_tracing_context_t*)user_data);
 }
 
+// Returns true if the submission consists solely of transfer command buffers
+// (fills/copies with no dispatch work), as produced for readbacks, uploads,
+// and file streaming.
+static bool iree_hal_cuda_device_is_transfer_only_submission(
+    iree_host_size_t command_buffer_count,
+    iree_hal_command_buffer_t* const* command_buffers) {
+  if (!command_buffer_count) return false;
+  for (iree_host_size_t i = 0; i < command_buffer_count; ++i) {
+    if (iree_hal_command_buffer_allowed_categories(command_buffers[i]) !=
+        IREE_HAL_COMMAND_CATEGORY_TRANSFER) {
+      return false;
+    }
+  }
+  return true;
+}
+
 static iree_status_t iree_hal_cuda_device_queue_execute(
     iree_hal_device_t* base_device, iree_hal_queue_affinity_t queue_affinity,
     const iree_hal_semaphore_list_t wait_semaphore_list,
@@ -761,8 +955,30 @@ static iree_status_t iree_hal_cuda_device_queue_execute(
   iree_hal_cuda_device_t* device = iree_hal_cuda_device_cast(base_device);
   IREE_TRACE_ZONE_BEGIN(z0);
 
+  // Rotate across the dispatch stream pool so that independent submissions
+  // may overlap on the GPU. Ordering between dependent submissions holds
+  // regardless of stream assignment: before release each action waits on the
+  // CUevents recorded for its wait semaphores and those waits are effective
+  // across streams.
+  CUstream dispatch_stream = device->dispatch_cu_streams[0];
+  if (device->transfer_cu_stream &&
+      iree_hal_cuda_device_is_transfer_only_submission(command_buffer_count,
+                                                       command_buffers)) {
+    // Transfer-only submissions go to the dedicated copy stream: the copy
+    // then launches as soon as its wait semaphores resolve instead of
+    // queuing behind dispatch work already issued to the pool, shaving the
+    // readback latency observed by host-side consumers (e.g. samplers).
+    dispatch_stream = device->transfer_cu_stream;
+  } else if (device->dispatch_stream_count > 1) {
+    uint32_t next_stream = (uint32_t)iree_atomic_fetch_add_int32(
+        &device->next_dispatch_stream, 1, iree_memory_order_relaxed);
+    dispatch_stream =
+        device->dispatch_cu_streams[next_stream %
+                                    device->dispatch_stream_count];
+  }
+
   iree_status_t status = iree_hal_cuda_pending_queue_actions_enqueue_execution(
-      base_device, device->dispatch_cu_stream, device->callback_cu_stream,
+      base_device, dispatch_stream, device->callback_cu_stream,
       device->pending_queue_actions,
       iree_hal_cuda_device_collect_tracing_context, device->tracing_context,
       wait_semaphore_list, signal_semaphore_list, command_buffer_count,
@@ -777,6 +993,31 @@ static iree_status_t iree_hal_cuda_device_queue_execute(
   return status;
 }
 
+static iree_status_t iree_hal_cuda_device_queue_callback(
+    iree_hal_device_t* base_device, iree_hal_queue_affinity_t queue_affinity,
+    const iree_hal_semaphore_list_t wait_semaphore_list,
+    const iree_hal_semaphore_list_t signal_semaphore_list,
+    iree_hal_queue_callback_fn_t callback, void* user_data) {
+  iree_hal_cuda_device_t* device = iree_hal_cuda_device_cast(base_device);
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Callbacks have no GPU payload so stream assignment does not matter for
+  // overlap; the host function launches on the shared callback stream after
+  // the CUevents recorded for the wait semaphores complete.
+  iree_status_t status = iree_hal_cuda_pending_queue_actions_enqueue_callback(
+      base_device, device->dispatch_cu_streams[0], device->callback_cu_stream,
+      device->pending_queue_actions, wait_semaphore_list, signal_semaphore_list,
+      callback, user_data);
+  if (iree_status_is_ok(status)) {
+    // Try to advance the pending workload queue.
+    status = iree_hal_cuda_pending_queue_actions_issue(
+        device->pending_queue_actions);
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
 static iree_status_t iree_hal_cuda_device_queue_flush(
     iree_hal_device_t* base_device, iree_hal_queue_affinity_t queue_affinity) {
   iree_hal_cuda_device_t* device = iree_hal_cuda_device_cast(base_device);
@@ -792,8 +1033,13 @@ static iree_status_t iree_hal_cuda_device_wait_semaphores(
     iree_hal_device_t* base_device, iree_hal_wait_mode_t wait_mode,
     const iree_hal_semaphore_list_t semaphore_list, iree_timeout_t timeout) {
   iree_hal_cuda_device_t* device = iree_hal_cuda_device_cast(base_device);
-  return iree_hal_cuda_semaphore_multi_wait(semaphore_list, wait_mode, timeout,
-                                            &device->block_pool);
+  iree_time_t start_ns = iree_time_now();
+  iree_status_t status = iree_hal_cuda_semaphore_multi_wait(
+      semaphore_list, wait_mode, timeout, &device->block_pool);
+  iree_atomic_fetch_add_int64(&device->semaphore_wait_ns,
+                              (int64_t)(iree_time_now() - start_ns),
+                              iree_memory_order_relaxed);
+  return status;
 }
 
 static iree_status_t iree_hal_cuda_device_profiling_begin(
@@ -841,6 +1087,7 @@ static const iree_hal_device_vtable_t iree_hal_cuda_device_vtable = {
     .queue_read = iree_hal_cuda_device_queue_read,
     .queue_write = iree_hal_cuda_device_queue_write,
     .queue_execute = iree_hal_cuda_device_queue_execute,
+    .queue_callback = iree_hal_cuda_device_queue_callback,
     .queue_flush = iree_hal_cuda_device_queue_flush,
     .wait_semaphores = iree_hal_cuda_device_wait_semaphores,
     .profiling_begin = iree_hal_cuda_device_profiling_begin,
@@ -431,6 +431,54 @@ static iree_status_t iree_hal_cuda_driver_dump_device_info(
   return iree_ok_status();
 }
 
+IREE_API_EXPORT iree_status_t iree_hal_cuda_driver_query_p2p_link(
+    iree_hal_driver_t* base_driver, iree_hal_device_id_t device_id,
+    iree_hal_device_id_t peer_device_id,
+    iree_hal_cuda_p2p_link_t* out_link) {
+  IREE_ASSERT_ARGUMENT(base_driver);
+  IREE_ASSERT_ARGUMENT(out_link);
+  iree_hal_cuda_driver_t* driver = iree_hal_cuda_driver_cast(base_driver);
+  memset(out_link, 0, sizeof(*out_link));
+
+  // Ensure CUDA is initialized before querying it.
+  IREE_RETURN_IF_ERROR(iree_hal_cuda_init(driver));
+
+  CUdevice device = IREE_DEVICE_ID_TO_CUDEVICE(device_id);
+  CUdevice peer_device = IREE_DEVICE_ID_TO_CUDEVICE(peer_device_id);
+  if (device == peer_device) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "device cannot be its own peer");
+  }
+
+  int can_access_peer = 0;
+  IREE_CUDA_RETURN_IF_ERROR(
+      &driver->cuda_symbols,
+      cuDeviceCanAccessPeer(&can_access_peer, device, peer_device),
+      "cuDeviceCanAccessPeer");
+  out_link->supported = can_access_peer != 0;
+  if (!out_link->supported) return iree_ok_status();
+
+  int performance_rank = 0;
+  IREE_CUDA_RETURN_IF_ERROR(
+      &driver->cuda_symbols,
+      cuDeviceGetP2PAttribute(&performance_rank,
+                              CU_DEVICE_P2P_ATTRIBUTE_PERFORMANCE_RANK, device,
+                              peer_device),
+      "cuDeviceGetP2PAttribute");
+  out_link->performance_rank = performance_rank;
+
+  int native_atomics = 0;
+  IREE_CUDA_RETURN_IF_ERROR(
+      &driver->cuda_symbols,
+      cuDeviceGetP2PAttribute(&native_atomics,
+                              CU_DEVICE_P2P_ATTRIBUTE_NATIVE_ATOMIC_SUPPORTED,
+                              device, peer_device),
+      "cuDeviceGetP2PAttribute");
+  out_link->native_atomics = native_atomics != 0;
+
+  return iree_ok_status();
+}
+
 static iree_status_t iree_hal_cuda_driver_select_default_device(
     iree_hal_driver_t* base_driver, iree_hal_cuda_dynamic_symbols_t* syms,
     int default_device_index, iree_allocator_t host_allocator,
@@ -16,10 +16,14 @@ IREE_CU_PFN_DECL(cuDevicePrimaryCtxRelease, CUdevice)
 IREE_CU_PFN_DECL(cuCtxSetCurrent, CUcontext)
 IREE_CU_PFN_DECL(cuCtxPushCurrent, CUcontext)
 IREE_CU_PFN_DECL(cuCtxPopCurrent, CUcontext*)
+IREE_CU_PFN_DECL(cuCtxEnablePeerAccess, CUcontext, unsigned int)
+IREE_CU_PFN_DECL(cuDeviceCanAccessPeer, int*, CUdevice, CUdevice)
 IREE_CU_PFN_DECL(cuDeviceGet, CUdevice*, int)
 IREE_CU_PFN_DECL(cuDeviceGetCount, int*)
 IREE_CU_PFN_DECL(cuDeviceGetName, char*, int, CUdevice)
 IREE_CU_PFN_DECL(cuDeviceGetAttribute, int*, CUdevice_attribute, CUdevice)
+IREE_CU_PFN_DECL(cuDeviceGetP2PAttribute, int*, CUdevice_P2PAttribute, CUdevice,
+                 CUdevice)
 IREE_CU_PFN_DECL(cuDeviceGetUuid, CUuuid*, CUdevice)
 IREE_CU_PFN_DECL(cuEventCreate, CUevent*, unsigned int)
 IREE_CU_PFN_DECL(cuEventDestroy, CUevent)
@@ -42,6 +46,10 @@ IREE_CU_PFN_DECL(cuGraphAddKernelNode, CUgraphNode*, CUgraph,
 IREE_CU_PFN_DECL(cuGraphCreate, CUgraph*, unsigned int)
 IREE_CU_PFN_DECL(cuGraphDestroy, CUgraph)
 IREE_CU_PFN_DECL(cuGraphExecDestroy, CUgraphExec)
+IREE_CU_PFN_DECL(cuGraphExecKernelNodeSetParams, CUgraphExec, CUgraphNode,
+                 const CUDA_KERNEL_NODE_PARAMS*)
+IREE_CU_PFN_DECL(cuGraphExecUpdate, CUgraphExec, CUgraph, CUgraphNode*,
+                 CUgraphExecUpdateResult*)
 IREE_CU_PFN_DECL(cuGraphGetNodes, CUgraph, CUgraphNode*, size_t*)
 IREE_CU_PFN_DECL(cuGraphInstantiate, CUgraphExec*, CUgraph, CUgraphNode*, char*,
                  size_t)
@@ -56,6 +64,20 @@ IREE_CU_PFN_DECL(cuMemHostAlloc, void**, size_t, unsigned int)
 IREE_CU_PFN_DECL(cuMemHostRegister, void*, size_t, unsigned int)
 IREE_CU_PFN_DECL(cuMemHostUnregister, void*)
 IREE_CU_PFN_DECL(cuMemHostGetDevicePointer, CUdeviceptr*, void*, unsigned int)
+IREE_CU_PFN_DECL(cuMemAddressReserve, CUdeviceptr*, size_t, size_t, CUdeviceptr,
+                 unsigned long long)
+IREE_CU_PFN_DECL(cuMemAddressFree, CUdeviceptr, size_t)
+IREE_CU_PFN_DECL(cuMemCreate, CUmemGenericAllocationHandle*, size_t,
+                 const CUmemAllocationProp*, unsigned long long)
+IREE_CU_PFN_DECL(cuMemRelease, CUmemGenericAllocationHandle)
+IREE_CU_PFN_DECL(cuMemMap, CUdeviceptr, size_t, size_t,
+                 CUmemGenericAllocationHandle, unsigned long long)
+IREE_CU_PFN_DECL(cuMemUnmap, CUdeviceptr, size_t)
+IREE_CU_PFN_DECL(cuMemSetAccess, CUdeviceptr, size_t, const CUmemAccessDesc*,
+                 size_t)
+IREE_CU_PFN_DECL(cuMemGetAllocationGranularity, size_t*,
+                 const CUmemAllocationProp*,
+                 CUmemAllocationGranularity_flags)
 IREE_CU_PFN_DECL(cuMemPoolCreate, CUmemoryPool*, const CUmemPoolProps*)
 IREE_CU_PFN_DECL(cuMemPoolDestroy, CUmemoryPool)
 IREE_CU_PFN_DECL(cuMemPoolSetAccess, CUmemoryPool, const CUmemAccessDesc*,
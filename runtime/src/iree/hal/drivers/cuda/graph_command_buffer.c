@@ -13,6 +13,7 @@
 #include "iree/hal/drivers/cuda/cuda_buffer.h"
 #include "iree/hal/drivers/cuda/cuda_dynamic_symbols.h"
 #include "iree/hal/drivers/cuda/cuda_status_util.h"
+#include "iree/hal/drivers/cuda/graph_exec_cache.h"
 #include "iree/hal/drivers/cuda/native_executable.h"
 #include "iree/hal/drivers/cuda/pipeline_layout.h"
 #include "iree/hal/drivers/cuda/tracing.h"
@@ -23,6 +24,22 @@
 // barriers.
 #define IREE_HAL_CUDA_MAX_CONCURRENT_GRAPH_NODE_COUNT 32
 
+// Tracks an indirect dispatch whose workgroup count is sourced from a
+// persistently-mapped host-visible parameter buffer. CUDA graphs have no
+// device-side indirect dispatch so the instantiated kernel node is instead
+// patched with the current buffer contents prior to each launch.
+typedef struct iree_hal_cuda_graph_indirect_dispatch_t {
+  struct iree_hal_cuda_graph_indirect_dispatch_t* next;
+  // Kernel node in the graph performing the dispatch.
+  CUgraphNode cu_node;
+  // Full node params captured at record time; only the grid dimensions are
+  // changed when patching. |kernelParams| references arena storage that
+  // remains live for the lifetime of the command buffer.
+  CUDA_KERNEL_NODE_PARAMS params;
+  // Host pointer to the mapped uint32_t[3] workgroup count.
+  const uint32_t* workgroup_count_ptr;
+} iree_hal_cuda_graph_indirect_dispatch_t;
+
 // Command buffer implementation that directly records into CUDA graphs.
 // The command buffer records the commands on the calling thread without
 // additional threading indirection.
@@ -48,6 +65,11 @@ typedef struct iree_hal_cuda_graph_command_buffer_t {
   CUgraph cu_graph;
   CUgraphExec cu_graph_exec;
 
+  // Optional cache the executable graph was acquired from; when set the
+  // executable graph is released back to the cache instead of destroyed.
+  iree_hal_cuda_graph_exec_cache_t* exec_cache;
+  bool cu_graph_exec_cached;
+
   // A node acting as a barrier for all commands added to the command buffer.
   CUgraphNode cu_barrier_node;
 
@@ -58,6 +80,11 @@ typedef struct iree_hal_cuda_graph_command_buffer_t {
   // Iteratively constructed batch of collective operations.
   iree_hal_collective_batch_t collective_batch;
 
+  // Singly-linked list of indirect dispatches that must be patched with the
+  // current workgroup counts prior to each launch. Storage is allocated from
+  // |arena| and lives until the command buffer is destroyed.
+  iree_hal_cuda_graph_indirect_dispatch_t* indirect_dispatch_head;
+
   int32_t push_constants[IREE_HAL_CUDA_MAX_PUSH_CONSTANT_COUNT];
 
   // The current bound descriptor sets.
@@ -161,7 +188,9 @@ iree_status_t iree_hal_cuda_graph_command_buffer_create(
     iree_hal_command_buffer_mode_t mode,
     iree_hal_command_category_t command_categories,
     iree_hal_queue_affinity_t queue_affinity, iree_host_size_t binding_capacity,
-    iree_arena_block_pool_t* block_pool, iree_allocator_t host_allocator,
+    iree_arena_block_pool_t* block_pool,
+    iree_hal_cuda_graph_exec_cache_t* exec_cache,
+    iree_allocator_t host_allocator,
     iree_hal_command_buffer_t** out_command_buffer) {
   IREE_ASSERT_ARGUMENT(block_pool);
   IREE_ASSERT_ARGUMENT(out_command_buffer);
@@ -190,8 +219,11 @@ iree_status_t iree_hal_cuda_graph_command_buffer_create(
   command_buffer->cu_context = context;
   command_buffer->cu_graph = NULL;
   command_buffer->cu_graph_exec = NULL;
+  command_buffer->exec_cache = exec_cache;
+  command_buffer->cu_graph_exec_cached = false;
   command_buffer->cu_barrier_node = NULL;
   command_buffer->graph_node_count = 0;
+  command_buffer->indirect_dispatch_head = NULL;
 
   iree_status_t status =
       iree_hal_resource_set_allocate(block_pool, &command_buffer->resource_set);
@@ -228,8 +260,13 @@ static void iree_hal_cuda_graph_command_buffer_destroy(
     command_buffer->cu_graph = NULL;
   }
   if (command_buffer->cu_graph_exec != NULL) {
-    IREE_CUDA_IGNORE_ERROR(command_buffer->symbols,
-                           cuGraphExecDestroy(command_buffer->cu_graph_exec));
+    if (command_buffer->cu_graph_exec_cached) {
+      iree_hal_cuda_graph_exec_cache_release(command_buffer->exec_cache,
+                                             command_buffer->cu_graph_exec);
+    } else {
+      IREE_CUDA_IGNORE_ERROR(command_buffer->symbols,
+                             cuGraphExecDestroy(command_buffer->cu_graph_exec));
+    }
     command_buffer->cu_graph_exec = NULL;
   }
   command_buffer->cu_barrier_node = NULL;
@@ -332,14 +369,26 @@ static iree_status_t iree_hal_cuda_graph_command_buffer_end(
   command_buffer->cu_barrier_node = NULL;
   command_buffer->graph_node_count = 0;
 
-  // Compile the graph.
-  CUgraphNode error_node = NULL;
-  iree_status_t status = IREE_CURESULT_TO_STATUS(
-      command_buffer->symbols,
-      cuGraphInstantiate(&command_buffer->cu_graph_exec,
-                         command_buffer->cu_graph, &error_node,
-                         /*logBuffer=*/NULL,
-                         /*bufferSize=*/0));
+  // Compile the graph, preferring to re-bind a cached executable graph with
+  // a matching topology over paying for instantiation. Indirect dispatches
+  // are patched via node handles from the recorded graph which only match an
+  // executable graph instantiated from that same graph, so they bypass the
+  // cache.
+  iree_status_t status = iree_ok_status();
+  if (command_buffer->exec_cache && !command_buffer->indirect_dispatch_head) {
+    status = iree_hal_cuda_graph_exec_cache_acquire(
+        command_buffer->exec_cache, command_buffer->cu_graph,
+        &command_buffer->cu_graph_exec);
+    command_buffer->cu_graph_exec_cached = iree_status_is_ok(status);
+  } else {
+    CUgraphNode error_node = NULL;
+    status = IREE_CURESULT_TO_STATUS(
+        command_buffer->symbols,
+        cuGraphInstantiate(&command_buffer->cu_graph_exec,
+                           command_buffer->cu_graph, &error_node,
+                           /*logBuffer=*/NULL,
+                           /*bufferSize=*/0));
+  }
   if (iree_status_is_ok(status)) {
     // No longer need the source graph used for construction.
     IREE_CUDA_IGNORE_ERROR(command_buffer->symbols,
@@ -708,10 +757,14 @@ static iree_status_t iree_hal_cuda_graph_command_buffer_push_descriptor_set(
   return iree_ok_status();
 }
 
-static iree_status_t iree_hal_cuda_graph_command_buffer_dispatch(
+// Records a kernel node performing the dispatch. When |out_indirect_dispatch|
+// is provided it receives the node handle and captured params so the grid
+// dimensions can be patched after graph instantiation.
+static iree_status_t iree_hal_cuda_graph_command_buffer_dispatch_internal(
     iree_hal_command_buffer_t* base_command_buffer,
     iree_hal_executable_t* executable, int32_t entry_point,
-    uint32_t workgroup_x, uint32_t workgroup_y, uint32_t workgroup_z) {
+    uint32_t workgroup_x, uint32_t workgroup_y, uint32_t workgroup_z,
+    iree_hal_cuda_graph_indirect_dispatch_t* out_indirect_dispatch) {
   iree_hal_cuda_graph_command_buffer_t* command_buffer =
       iree_hal_cuda_graph_command_buffer_cast(base_command_buffer);
   IREE_TRACE_ZONE_BEGIN(z0);
@@ -821,26 +874,103 @@ static iree_status_t iree_hal_cuda_graph_command_buffer_dispatch(
   }
 
   size_t dependency_count = command_buffer->cu_barrier_node ? 1 : 0;
+  CUgraphNode* cu_node =
+      &command_buffer->cu_graph_nodes[command_buffer->graph_node_count++];
   IREE_CUDA_RETURN_AND_END_ZONE_IF_ERROR(
       z0, command_buffer->symbols,
-      cuGraphAddKernelNode(
-          &command_buffer->cu_graph_nodes[command_buffer->graph_node_count++],
-          command_buffer->cu_graph, &command_buffer->cu_barrier_node,
-          dependency_count, &params),
+      cuGraphAddKernelNode(cu_node, command_buffer->cu_graph,
+                           &command_buffer->cu_barrier_node, dependency_count,
+                           &params),
       "cuGraphAddKernelNode");
 
+  if (out_indirect_dispatch) {
+    out_indirect_dispatch->cu_node = *cu_node;
+    out_indirect_dispatch->params = params;
+  }
+
   IREE_CUDA_GRAPH_COMMAND_BUFFER_TRACE_ZONE_END(command_buffer);
   IREE_TRACE_ZONE_END(z0);
   return iree_ok_status();
 }
 
+static iree_status_t iree_hal_cuda_graph_command_buffer_dispatch(
+    iree_hal_command_buffer_t* base_command_buffer,
+    iree_hal_executable_t* executable, int32_t entry_point,
+    uint32_t workgroup_x, uint32_t workgroup_y, uint32_t workgroup_z) {
+  return iree_hal_cuda_graph_command_buffer_dispatch_internal(
+      base_command_buffer, executable, entry_point, workgroup_x, workgroup_y,
+      workgroup_z, /*out_indirect_dispatch=*/NULL);
+}
+
 static iree_status_t iree_hal_cuda_graph_command_buffer_dispatch_indirect(
     iree_hal_command_buffer_t* base_command_buffer,
     iree_hal_executable_t* executable, int32_t entry_point,
     iree_hal_buffer_t* workgroups_buffer,
     iree_device_size_t workgroups_offset) {
-  return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
-                          "indirect dispatch not yet implemented");
+  iree_hal_cuda_graph_command_buffer_t* command_buffer =
+      iree_hal_cuda_graph_command_buffer_cast(base_command_buffer);
+
+  IREE_RETURN_IF_ERROR(iree_hal_resource_set_insert(
+      command_buffer->resource_set, 1, &workgroups_buffer));
+
+  // CUDA graphs have no device-side indirect dispatch so the workgroup count
+  // must come from a host-visible parameter buffer that we keep persistently
+  // mapped and re-read prior to each launch. This allows the same recorded
+  // graph to be resubmitted with varying dispatch dimensions for the cost of a
+  // memcpy into the parameter buffer and a node param update.
+  iree_hal_buffer_mapping_t buffer_mapping = {{0}};
+  IREE_RETURN_IF_ERROR(iree_hal_buffer_map_range(
+      workgroups_buffer, IREE_HAL_MAPPING_MODE_PERSISTENT,
+      IREE_HAL_MEMORY_ACCESS_READ, workgroups_offset, 3 * sizeof(uint32_t),
+      &buffer_mapping));
+  const uint32_t* workgroup_count_ptr =
+      (const uint32_t*)buffer_mapping.contents.data;
+
+  // Record the dispatch with the current contents of the parameter buffer;
+  // the instantiated node is patched with fresh values prior to each launch.
+  iree_hal_cuda_graph_indirect_dispatch_t* indirect_dispatch = NULL;
+  IREE_RETURN_IF_ERROR(iree_arena_allocate(&command_buffer->arena,
+                                           sizeof(*indirect_dispatch),
+                                           (void**)&indirect_dispatch));
+  IREE_RETURN_IF_ERROR(iree_hal_cuda_graph_command_buffer_dispatch_internal(
+      base_command_buffer, executable, entry_point, workgroup_count_ptr[0],
+      workgroup_count_ptr[1], workgroup_count_ptr[2], indirect_dispatch));
+
+  indirect_dispatch->workgroup_count_ptr = workgroup_count_ptr;
+  indirect_dispatch->next = command_buffer->indirect_dispatch_head;
+  command_buffer->indirect_dispatch_head = indirect_dispatch;
+  return iree_ok_status();
+}
+
+iree_status_t iree_hal_cuda_graph_command_buffer_update_indirect_dispatches(
+    iree_hal_command_buffer_t* base_command_buffer) {
+  iree_hal_cuda_graph_command_buffer_t* command_buffer =
+      iree_hal_cuda_graph_command_buffer_cast(base_command_buffer);
+  if (!command_buffer->indirect_dispatch_head) return iree_ok_status();
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  for (iree_hal_cuda_graph_indirect_dispatch_t* indirect_dispatch =
+           command_buffer->indirect_dispatch_head;
+       indirect_dispatch != NULL; indirect_dispatch = indirect_dispatch->next) {
+    const uint32_t* workgroup_count_ptr = indirect_dispatch->workgroup_count_ptr;
+    if (indirect_dispatch->params.gridDimX == workgroup_count_ptr[0] &&
+        indirect_dispatch->params.gridDimY == workgroup_count_ptr[1] &&
+        indirect_dispatch->params.gridDimZ == workgroup_count_ptr[2]) {
+      continue;  // unchanged since the last launch
+    }
+    indirect_dispatch->params.gridDimX = workgroup_count_ptr[0];
+    indirect_dispatch->params.gridDimY = workgroup_count_ptr[1];
+    indirect_dispatch->params.gridDimZ = workgroup_count_ptr[2];
+    IREE_CUDA_RETURN_AND_END_ZONE_IF_ERROR(
+        z0, command_buffer->symbols,
+        cuGraphExecKernelNodeSetParams(command_buffer->cu_graph_exec,
+                                       indirect_dispatch->cu_node,
+                                       &indirect_dispatch->params),
+        "cuGraphExecKernelNodeSetParams");
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
 }
 
 static iree_status_t iree_hal_cuda_graph_command_buffer_execute_commands(
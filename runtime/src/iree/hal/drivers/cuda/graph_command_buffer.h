@@ -17,6 +17,8 @@ extern "C" {
 #endif  // __cplusplus
 
 typedef struct iree_arena_block_pool_t iree_arena_block_pool_t;
+typedef struct iree_hal_cuda_graph_exec_cache_t
+    iree_hal_cuda_graph_exec_cache_t;
 typedef struct iree_hal_cuda_tracing_context_t iree_hal_cuda_tracing_context_t;
 
 // Creates a command buffer that records into a CUDA graph.
@@ -24,6 +26,11 @@ typedef struct iree_hal_cuda_tracing_context_t iree_hal_cuda_tracing_context_t;
 // |block_pool| will be used by the graph command buffer to retain copies of
 // input data until reset. It must remain live for the lifetime of the command
 // buffers that use it.
+//
+// |exec_cache|, if not NULL, is used to satisfy graph instantiation: recorded
+// graphs whose topology matches a cached executable graph are re-bound in
+// place via cuGraphExecUpdate instead of paying for cuGraphInstantiate. It
+// must remain live for the lifetime of the command buffers that use it.
 iree_status_t iree_hal_cuda_graph_command_buffer_create(
     iree_hal_device_t* device,
     const iree_hal_cuda_dynamic_symbols_t* cuda_symbols,
@@ -31,7 +38,9 @@ iree_status_t iree_hal_cuda_graph_command_buffer_create(
     iree_hal_command_buffer_mode_t mode,
     iree_hal_command_category_t command_categories,
     iree_hal_queue_affinity_t queue_affinity, iree_host_size_t binding_capacity,
-    iree_arena_block_pool_t* block_pool, iree_allocator_t host_allocator,
+    iree_arena_block_pool_t* block_pool,
+    iree_hal_cuda_graph_exec_cache_t* exec_cache,
+    iree_allocator_t host_allocator,
     iree_hal_command_buffer_t** out_command_buffer);
 
 // Returns true if |command_buffer| is a CUDA graph-based command buffer.
@@ -42,6 +51,20 @@ bool iree_hal_cuda_graph_command_buffer_isa(
 CUgraphExec iree_hal_cuda_graph_command_buffer_handle(
     iree_hal_command_buffer_t* command_buffer);
 
+// Updates all indirect dispatches in the instantiated graph with the current
+// contents of their workgroup count parameter buffers.
+//
+// CUDA graphs have no device-side indirect dispatch: workgroup counts are
+// fixed at graph instantiation time. Indirect dispatches are instead recorded
+// against a persistently-mapped host-visible parameter buffer and this patches
+// the corresponding kernel nodes prior to each launch, allowing the same
+// recorded graph to be resubmitted with varying dispatch dimensions.
+//
+// Must be called prior to launching the graph each time the parameter buffer
+// contents may have changed.
+iree_status_t iree_hal_cuda_graph_command_buffer_update_indirect_dispatches(
+    iree_hal_command_buffer_t* command_buffer);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
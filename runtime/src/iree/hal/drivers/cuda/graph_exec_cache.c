@@ -0,0 +1,200 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/hal/drivers/cuda/graph_exec_cache.h"
+
+#include <stddef.h>
+
+#include "iree/base/internal/atomics.h"
+#include "iree/base/internal/synchronization.h"
+#include "iree/hal/drivers/cuda/cuda_status_util.h"
+
+// A cached executable graph.
+typedef struct iree_hal_cuda_graph_exec_cache_entry_t {
+  // The instantiated executable graph or NULL if the slot is empty.
+  CUgraphExec exec;
+  // Number of outstanding acquisitions. Entries with a non-zero count may
+  // have launches in flight and are never updated or evicted.
+  iree_host_size_t use_count;
+  // Epoch of the most recent acquisition; used for LRU eviction.
+  uint64_t last_use;
+} iree_hal_cuda_graph_exec_cache_entry_t;
+
+struct iree_hal_cuda_graph_exec_cache_t {
+  iree_allocator_t host_allocator;
+  const iree_hal_cuda_dynamic_symbols_t* symbols;
+
+  // Guards cache entries. Note that instantiation and update happen while the
+  // lock is held; recording is effectively serialized anyway and this keeps
+  // entry lifetime management trivial.
+  iree_slim_mutex_t mutex;
+
+  // Monotonically increasing acquisition epoch.
+  uint64_t use_epoch IREE_GUARDED_BY(mutex);
+
+  // Cumulative acquisition counters for monitoring. Updated under the mutex
+  // but stored atomically so queries can read them without taking it.
+  iree_atomic_int64_t hit_count;
+  iree_atomic_int64_t miss_count;
+
+  iree_host_size_t capacity;
+  iree_hal_cuda_graph_exec_cache_entry_t entries[] IREE_GUARDED_BY(mutex);
+};
+
+iree_status_t iree_hal_cuda_graph_exec_cache_create(
+    const iree_hal_cuda_dynamic_symbols_t* symbols, iree_host_size_t capacity,
+    iree_allocator_t host_allocator,
+    iree_hal_cuda_graph_exec_cache_t** out_cache) {
+  IREE_ASSERT_ARGUMENT(symbols);
+  IREE_ASSERT_ARGUMENT(out_cache);
+  *out_cache = NULL;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_hal_cuda_graph_exec_cache_t* cache = NULL;
+  iree_host_size_t total_size =
+      sizeof(*cache) + capacity * sizeof(cache->entries[0]);
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(host_allocator, total_size, (void**)&cache));
+  cache->host_allocator = host_allocator;
+  cache->symbols = symbols;
+  iree_slim_mutex_initialize(&cache->mutex);
+  cache->use_epoch = 0;
+  iree_atomic_store_int64(&cache->hit_count, 0, iree_memory_order_relaxed);
+  iree_atomic_store_int64(&cache->miss_count, 0, iree_memory_order_relaxed);
+  cache->capacity = capacity;
+
+  *out_cache = cache;
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
+void iree_hal_cuda_graph_exec_cache_free(
+    iree_hal_cuda_graph_exec_cache_t* cache) {
+  if (!cache) return;
+  iree_allocator_t host_allocator = cache->host_allocator;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  for (iree_host_size_t i = 0; i < cache->capacity; ++i) {
+    if (cache->entries[i].exec) {
+      IREE_ASSERT_EQ(cache->entries[i].use_count, 0,
+                     "all executable graphs must have been released");
+      IREE_CUDA_IGNORE_ERROR(cache->symbols,
+                             cuGraphExecDestroy(cache->entries[i].exec));
+    }
+  }
+  iree_slim_mutex_deinitialize(&cache->mutex);
+  iree_allocator_free(host_allocator, cache);
+
+  IREE_TRACE_ZONE_END(z0);
+}
+
+iree_status_t iree_hal_cuda_graph_exec_cache_acquire(
+    iree_hal_cuda_graph_exec_cache_t* cache, CUgraph graph,
+    CUgraphExec* out_graph_exec) {
+  IREE_ASSERT_ARGUMENT(cache);
+  IREE_ASSERT_ARGUMENT(out_graph_exec);
+  *out_graph_exec = NULL;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_slim_mutex_lock(&cache->mutex);
+
+  // Try to re-bind a quiescent cached executable graph in place. The driver
+  // checks that the topology of |graph| matches and updates all node params
+  // (kernel args, grid dims, memcpy/memset operands) when it does.
+  for (iree_host_size_t i = 0; i < cache->capacity; ++i) {
+    iree_hal_cuda_graph_exec_cache_entry_t* entry = &cache->entries[i];
+    if (!entry->exec || entry->use_count > 0) continue;
+    CUgraphNode error_node = NULL;
+    CUgraphExecUpdateResult update_result = CU_GRAPH_EXEC_UPDATE_ERROR;
+    CUresult result = cache->symbols->cuGraphExecUpdate(
+        entry->exec, graph, &error_node, &update_result);
+    if (result == CUDA_SUCCESS) {
+      entry->use_count = 1;
+      entry->last_use = ++cache->use_epoch;
+      iree_atomic_fetch_add_int64(&cache->hit_count, 1,
+                                  iree_memory_order_relaxed);
+      *out_graph_exec = entry->exec;
+      iree_slim_mutex_unlock(&cache->mutex);
+      IREE_TRACE_ZONE_END(z0);
+      return iree_ok_status();
+    } else if (update_result != CU_GRAPH_EXEC_UPDATE_ERROR_TOPOLOGY_CHANGED) {
+      // Failures past the topology check may leave the executable graph
+      // partially updated; drop it rather than risk launching it again.
+      IREE_CUDA_IGNORE_ERROR(cache->symbols, cuGraphExecDestroy(entry->exec));
+      entry->exec = NULL;
+    }
+  }
+
+  // No compatible executable graph available: instantiate a new one.
+  iree_atomic_fetch_add_int64(&cache->miss_count, 1, iree_memory_order_relaxed);
+  CUgraphExec exec = NULL;
+  CUgraphNode error_node = NULL;
+  iree_status_t status = IREE_CURESULT_TO_STATUS(
+      cache->symbols,
+      cuGraphInstantiate(&exec, graph, &error_node,
+                         /*logBuffer=*/NULL, /*bufferSize=*/0));
+
+  if (iree_status_is_ok(status)) {
+    // Cache the new executable graph, evicting the least recently used
+    // quiescent entry when full. If every entry is in use the executable
+    // graph is handed out uncached and destroyed on release.
+    iree_hal_cuda_graph_exec_cache_entry_t* target_entry = NULL;
+    for (iree_host_size_t i = 0; i < cache->capacity; ++i) {
+      iree_hal_cuda_graph_exec_cache_entry_t* entry = &cache->entries[i];
+      if (entry->use_count > 0) continue;
+      if (!entry->exec) {
+        target_entry = entry;
+        break;
+      }
+      if (!target_entry || entry->last_use < target_entry->last_use) {
+        target_entry = entry;
+      }
+    }
+    if (target_entry) {
+      if (target_entry->exec) {
+        IREE_CUDA_IGNORE_ERROR(cache->symbols,
+                               cuGraphExecDestroy(target_entry->exec));
+      }
+      target_entry->exec = exec;
+      target_entry->use_count = 1;
+      target_entry->last_use = ++cache->use_epoch;
+    }
+    *out_graph_exec = exec;
+  }
+
+  iree_slim_mutex_unlock(&cache->mutex);
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+void iree_hal_cuda_graph_exec_cache_query_statistics(
+    iree_hal_cuda_graph_exec_cache_t* cache, int64_t* out_hit_count,
+    int64_t* out_miss_count) {
+  *out_hit_count =
+      iree_atomic_load_int64(&cache->hit_count, iree_memory_order_relaxed);
+  *out_miss_count =
+      iree_atomic_load_int64(&cache->miss_count, iree_memory_order_relaxed);
+}
+
+void iree_hal_cuda_graph_exec_cache_release(
+    iree_hal_cuda_graph_exec_cache_t* cache, CUgraphExec graph_exec) {
+  if (!graph_exec) return;
+
+  iree_slim_mutex_lock(&cache->mutex);
+  for (iree_host_size_t i = 0; i < cache->capacity; ++i) {
+    iree_hal_cuda_graph_exec_cache_entry_t* entry = &cache->entries[i];
+    if (entry->exec == graph_exec) {
+      IREE_ASSERT_GT(entry->use_count, 0, "unbalanced release");
+      --entry->use_count;
+      iree_slim_mutex_unlock(&cache->mutex);
+      return;
+    }
+  }
+  iree_slim_mutex_unlock(&cache->mutex);
+
+  // Not cached (handed out while the cache was full): destroy directly.
+  IREE_CUDA_IGNORE_ERROR(cache->symbols, cuGraphExecDestroy(graph_exec));
+}
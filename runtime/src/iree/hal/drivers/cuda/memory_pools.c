@@ -88,6 +88,12 @@ iree_status_t iree_hal_cuda_memory_pools_initialize(
   return status;
 }
 
+void iree_hal_cuda_memory_pools_set_pressure_callback(
+    iree_hal_cuda_memory_pools_t* pools,
+    iree_hal_cuda_memory_pressure_callback_t callback) {
+  pools->pressure_callback = callback;
+}
+
 void iree_hal_cuda_memory_pools_deinitialize(
     iree_hal_cuda_memory_pools_t* pools) {
   IREE_TRACE_ZONE_BEGIN(z0);
@@ -235,6 +241,26 @@ iree_status_t iree_hal_cuda_memory_pools_alloca(
                               stream),
       "cuMemAllocFromPoolAsync");
 
+  // When the pool is exhausted give the registered pressure callback a chance
+  // to shed memory (e.g. evictable cache blocks) and retry instead of failing
+  // the allocation. The callback returning non-OK indicates nothing more can
+  // be released and the original failure is surfaced.
+  while (IREE_UNLIKELY(iree_status_is_resource_exhausted(status)) &&
+         pools->pressure_callback.fn) {
+    iree_status_t shed_status = pools->pressure_callback.fn(
+        pools->pressure_callback.user_data, allocation_size);
+    if (!iree_status_is_ok(shed_status)) {
+      iree_status_ignore(shed_status);
+      break;
+    }
+    iree_status_ignore(status);
+    status = IREE_CURESULT_TO_STATUS(
+        pools->cuda_symbols,
+        cuMemAllocFromPoolAsync(&device_ptr, (size_t)allocation_size,
+                                memory_pool, stream),
+        "cuMemAllocFromPoolAsync");
+  }
+
   // Wrap the allocated CUDA buffer in a HAL buffer.
   // NOTE: we don't provide a device allocator because we didn't allocate from
   // one and instead we use a release callback to perform the free if the user
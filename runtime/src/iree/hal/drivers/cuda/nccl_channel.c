@@ -10,11 +10,36 @@
 #include <stdlib.h>
 
 #include "iree/base/api.h"
+#include "iree/base/internal/file_io.h"
 #include "iree/base/tracing.h"
 #include "iree/hal/drivers/cuda/cuda_buffer.h"
 #include "iree/hal/drivers/cuda/cuda_status_util.h"
 #include "iree/hal/drivers/cuda/nccl_status_util.h"
 
+// Maximum number of all-reduce size buckets a tuning file may define.
+#define IREE_HAL_CUDA_NCCL_TUNING_MAX_BUCKETS 8
+
+// Environment variable naming an optional collective tuning file produced by
+// an offline sweep on the target topology. See
+// iree_hal_cuda_nccl_channel_load_tuning for the file format.
+#define IREE_HAL_CUDA_NCCL_TUNING_FILE_ENV "IREE_HAL_CUDA_NCCL_TUNING_FILE"
+
+// All-reduce transfers up to and including |max_bytes| are issued as
+// |segment_count| segmented calls within the surrounding group.
+typedef struct iree_hal_cuda_nccl_tuning_bucket_t {
+  uint64_t max_bytes;
+  uint32_t segment_count;
+} iree_hal_cuda_nccl_tuning_bucket_t;
+
+// Pre-tuned collective parameters loaded at channel creation.
+// A bucket count of zero means no tuning was loaded and the built-in
+// heuristics are used instead.
+typedef struct iree_hal_cuda_nccl_tuning_t {
+  iree_host_size_t bucket_count;
+  iree_hal_cuda_nccl_tuning_bucket_t
+      buckets[IREE_HAL_CUDA_NCCL_TUNING_MAX_BUCKETS];
+} iree_hal_cuda_nccl_tuning_t;
+
 typedef struct iree_hal_cuda_nccl_channel_t {
   iree_hal_resource_t resource;
 
@@ -38,6 +63,9 @@ typedef struct iree_hal_cuda_nccl_channel_t {
   // Communicator handle.
   ncclComm_t comm;
 
+  // Pre-tuned collective parameters; inherited by split channels.
+  iree_hal_cuda_nccl_tuning_t tuning;
+
   // Hash of the unique ID used to create the communicator.
   // This is consistent with the hashes NCCL itself uses for logging but is not
   // guaranteed to be unique - only use for informational purposes.
@@ -91,6 +119,98 @@ iree_status_t iree_hal_cuda_nccl_get_unique_id(
   return status;
 }
 
+// Loads pre-tuned collective parameters for the communicator from the file
+// named by IREE_HAL_CUDA_NCCL_TUNING_FILE, if set. The file is produced by an
+// offline sweep of candidate configurations on the target topology (one rank
+// per line of iree-run-module or an external harness issuing the collectives)
+// and is plain text:
+//   # comment
+//   topology <participant_count> <nccl_version>
+//   allreduce <max_bytes> <segment_count>
+//   ...
+// The topology line is a fingerprint that must match the communicator being
+// created: a cache swept on a different cluster shape or NCCL build is
+// silently ignored so stale files can never mistune a job. Buckets apply to
+// transfers up to and including max_bytes with the last bucket covering all
+// larger transfers; unknown keys are skipped for forward compatibility.
+// Absent or malformed files leave the built-in heuristics in place.
+static void iree_hal_cuda_nccl_channel_load_tuning(
+    const iree_hal_cuda_nccl_dynamic_symbols_t* nccl_symbols, int count,
+    iree_allocator_t host_allocator,
+    iree_hal_cuda_nccl_tuning_t* out_tuning) {
+  memset(out_tuning, 0, sizeof(*out_tuning));
+  const char* path = getenv(IREE_HAL_CUDA_NCCL_TUNING_FILE_ENV);
+  if (!path || strlen(path) == 0) return;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_file_contents_t* contents = NULL;
+  iree_status_t status = iree_file_read_contents(
+      path, IREE_FILE_READ_FLAG_PRELOAD, host_allocator, &contents);
+  if (!iree_status_is_ok(status)) {
+    // Tuning files are advisory; missing/unreadable files are not an error.
+    iree_status_ignore(status);
+    IREE_TRACE_ZONE_END(z0);
+    return;
+  }
+
+  int nccl_version = 0;
+  IREE_NCCL_IGNORE_ERROR(nccl_symbols, ncclGetVersion(&nccl_version));
+
+  bool fingerprint_ok = false;
+  iree_hal_cuda_nccl_tuning_t tuning;
+  memset(&tuning, 0, sizeof(tuning));
+  iree_string_view_t remaining =
+      iree_make_string_view((const char*)contents->const_buffer.data,
+                            contents->const_buffer.data_length);
+  while (remaining.size > 0) {
+    iree_string_view_t line = iree_string_view_empty();
+    iree_string_view_split(remaining, '\n', &line, &remaining);
+    line = iree_string_view_trim(line);
+    if (line.size == 0 || iree_string_view_starts_with(line, IREE_SV("#"))) {
+      continue;
+    }
+    iree_string_view_t key = iree_string_view_empty();
+    iree_string_view_t params = iree_string_view_empty();
+    iree_string_view_split(line, ' ', &key, &params);
+    if (iree_string_view_equal(key, IREE_SV("topology"))) {
+      iree_string_view_t count_str = iree_string_view_empty();
+      iree_string_view_t version_str = iree_string_view_empty();
+      iree_string_view_split(params, ' ', &count_str, &version_str);
+      int32_t file_count = 0;
+      int32_t file_version = 0;
+      fingerprint_ok =
+          iree_string_view_atoi_int32(iree_string_view_trim(count_str),
+                                      &file_count) &&
+          iree_string_view_atoi_int32(iree_string_view_trim(version_str),
+                                      &file_version) &&
+          file_count == count && file_version == nccl_version;
+      if (!fingerprint_ok) break;
+    } else if (iree_string_view_equal(key, IREE_SV("allreduce"))) {
+      iree_string_view_t bytes_str = iree_string_view_empty();
+      iree_string_view_t segments_str = iree_string_view_empty();
+      iree_string_view_split(params, ' ', &bytes_str, &segments_str);
+      uint64_t max_bytes = 0;
+      int32_t segment_count = 0;
+      if (tuning.bucket_count < IREE_HAL_CUDA_NCCL_TUNING_MAX_BUCKETS &&
+          iree_string_view_atoi_uint64(iree_string_view_trim(bytes_str),
+                                       &max_bytes) &&
+          iree_string_view_atoi_int32(iree_string_view_trim(segments_str),
+                                      &segment_count) &&
+          segment_count > 0) {
+        tuning.buckets[tuning.bucket_count].max_bytes = max_bytes;
+        tuning.buckets[tuning.bucket_count].segment_count =
+            (uint32_t)segment_count;
+        ++tuning.bucket_count;
+      }
+    }
+  }
+  if (fingerprint_ok) *out_tuning = tuning;
+
+  iree_file_contents_free(contents);
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, (int64_t)out_tuning->bucket_count);
+  IREE_TRACE_ZONE_END(z0);
+}
+
 iree_status_t iree_hal_cuda_nccl_channel_create(
     const iree_hal_cuda_dynamic_symbols_t* cuda_symbols,
     const iree_hal_cuda_nccl_dynamic_symbols_t* nccl_symbols,
@@ -132,6 +252,8 @@ iree_status_t iree_hal_cuda_nccl_channel_create(
   channel->rank = rank;
   channel->count = count;
   channel->comm = comm;
+  iree_hal_cuda_nccl_channel_load_tuning(nccl_symbols, count, host_allocator,
+                                         &channel->tuning);
   IREE_TRACE(channel->id_hash = id_hash);
   *out_channel = (iree_hal_channel_t*)channel;
 
@@ -221,6 +343,10 @@ static iree_status_t iree_hal_cuda_nccl_channel_split(
     split_channel->rank = split_rank;
     split_channel->count = split_count;
     split_channel->comm = split_comm;
+    // NOTE: tuning is fingerprinted on the parent participant count; a split
+    // with fewer ranks keeps the same segmentation as sweeping per split
+    // shape is not worth the bookkeeping today.
+    split_channel->tuning = channel->tuning;
     *out_split_channel = (iree_hal_channel_t*)split_channel;
   }
 
@@ -324,6 +450,14 @@ static iree_status_t iree_hal_cuda_get_nccl_reduction_type(
   return iree_ok_status();
 }
 
+// Minimum per-segment size when splitting large all-reduces into multiple
+// grouped calls. Below twice this size a single call is issued; smaller
+// segments would pay NCCL per-call latency without improving overlap.
+#define IREE_HAL_CUDA_NCCL_SEGMENT_MIN_BYTES (32 * 1024 * 1024)
+
+// Maximum number of segments a single all-reduce will be split into.
+#define IREE_HAL_CUDA_NCCL_MAX_SEGMENT_COUNT 8
+
 static iree_status_t iree_hal_cuda_nccl_submit_batch_entry(
     const iree_hal_collective_batch_entry_t* entry, CUstream stream) {
   IREE_ASSERT_ARGUMENT(entry);
@@ -371,11 +505,51 @@ static iree_status_t iree_hal_cuda_nccl_submit_batch_entry(
       ncclRedOp_t redop;
       IREE_RETURN_IF_ERROR(
           iree_hal_cuda_get_nccl_reduction_type(entry->op.reduction, &redop));
-      IREE_NCCL_RETURN_IF_ERROR(
-          symbols,
-          ncclAllReduce((const void*)sendbuff, (void*)recvbuff,
-                        entry->element_count, datatype, redop, comm, stream),
-          "ncclAllReduce");
+      // Large all-reduces are issued as multiple segmented calls within the
+      // surrounding group. NCCL pipelines the segments across its internal
+      // channels and the first segments complete (and unblock consumers)
+      // while the later ones are still in flight instead of the whole
+      // reduction landing at once; this also keeps per-call chunk sizes in
+      // the range where ring transfers stay overlapped.
+      iree_device_size_t element_size_bytes =
+          iree_hal_collective_element_byte_count(entry->op.element_type);
+      iree_device_size_t total_bytes =
+          entry->element_count * element_size_bytes;
+      iree_device_size_t segment_count = 1;
+      if (channel->tuning.bucket_count > 0) {
+        // Pre-tuned segmentation swept offline for this topology; the last
+        // bucket covers all larger transfers.
+        const iree_hal_cuda_nccl_tuning_t* tuning = &channel->tuning;
+        segment_count =
+            tuning->buckets[tuning->bucket_count - 1].segment_count;
+        for (iree_host_size_t b = 0; b < tuning->bucket_count; ++b) {
+          if (total_bytes <= tuning->buckets[b].max_bytes) {
+            segment_count = tuning->buckets[b].segment_count;
+            break;
+          }
+        }
+        segment_count = iree_min(segment_count, entry->element_count);
+      } else if (total_bytes >= 2 * IREE_HAL_CUDA_NCCL_SEGMENT_MIN_BYTES) {
+        segment_count =
+            iree_min(IREE_HAL_CUDA_NCCL_MAX_SEGMENT_COUNT,
+                     total_bytes / IREE_HAL_CUDA_NCCL_SEGMENT_MIN_BYTES);
+      }
+      iree_device_size_t segment_elements =
+          entry->element_count / segment_count;
+      for (iree_device_size_t s = 0; s < segment_count; ++s) {
+        iree_device_size_t element_offset = s * segment_elements;
+        iree_device_size_t segment_element_count =
+            s + 1 == segment_count ? entry->element_count - element_offset
+                                   : segment_elements;
+        iree_device_size_t byte_offset = element_offset * element_size_bytes;
+        IREE_NCCL_RETURN_IF_ERROR(
+            symbols,
+            ncclAllReduce((const void*)(sendbuff + byte_offset),
+                          (void*)(recvbuff + byte_offset),
+                          segment_element_count, datatype, redop, comm,
+                          stream),
+            "ncclAllReduce");
+      }
       break;
     }
     case IREE_HAL_COLLECTIVE_KIND_ALL_TO_ALL: {
@@ -35,6 +35,7 @@
 
 typedef enum iree_hal_cuda_queue_action_kind_e {
   IREE_HAL_CUDA_QUEUE_ACTION_TYPE_EXECUTION,
+  IREE_HAL_CUDA_QUEUE_ACTION_TYPE_CALLBACK,
   // TODO: Add support for queue alloca and dealloca.
 } iree_hal_cuda_queue_action_kind_t;
 
@@ -76,13 +77,19 @@ typedef struct iree_hal_cuda_queue_action_t {
       iree_host_size_t count;
       iree_hal_command_buffer_t** ptr;
     } command_buffers;
+    struct {
+      iree_hal_queue_callback_fn_t fn;
+      void* user_data;
+    } callback;
   } payload;
 
   // The device from which to allocate CUDA stream-based command buffers for
   // applying deferred command buffers.
   iree_hal_device_t* device;
 
-  // The stream to launch main GPU workload.
+  // The stream to launch main GPU workload. Assigned per action by the device
+  // from its dispatch stream pool; CUevent waits recorded for the wait
+  // semaphores order this action against work on other streams.
   CUstream dispatch_cu_stream;
   // The stream to launch CUDA host function callbacks.
   CUstream callback_cu_stream;
@@ -222,9 +229,10 @@ typedef struct iree_hal_cuda_working_area_t {
   iree_atomic_int32_t worker_state;                   // atomic
   iree_atomic_intptr_t error_code;                    // atomic
   // The number of actions that have been issued to the GPU but not yet fully
-  // completed both execution and cleanup. We don't need this field to be atomic
-  // given it is modified only from the worker thread.
-  int32_t pending_action_count;
+  // completed both execution and cleanup. Only modified from the worker thread
+  // but stored atomically so monitoring queries can read it from other
+  // threads.
+  iree_atomic_int32_t pending_action_count;
   iree_allocator_t host_allocator;  // const
 } iree_hal_cuda_working_area_t;
 
@@ -239,7 +247,8 @@ static void iree_hal_cuda_working_area_initialize(
                           iree_memory_order_release);
   iree_atomic_store_int32(&working_area->error_code, IREE_STATUS_OK,
                           iree_memory_order_release);
-  working_area->pending_action_count = 0;
+  iree_atomic_store_int32(&working_area->pending_action_count, 0,
+                          iree_memory_order_relaxed);
   working_area->host_allocator = host_allocator;
 }
 
@@ -530,6 +539,88 @@ iree_status_t iree_hal_cuda_pending_queue_actions_enqueue_execution(
   return status;
 }
 
+iree_status_t iree_hal_cuda_pending_queue_actions_enqueue_callback(
+    iree_hal_device_t* device, CUstream dispatch_stream,
+    CUstream callback_stream, iree_hal_cuda_pending_queue_actions_t* actions,
+    const iree_hal_semaphore_list_t wait_semaphore_list,
+    const iree_hal_semaphore_list_t signal_semaphore_list,
+    iree_hal_queue_callback_fn_t callback, void* user_data) {
+  IREE_ASSERT_ARGUMENT(actions);
+  IREE_ASSERT_ARGUMENT(callback);
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_hal_cuda_queue_action_t* action = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(actions->host_allocator, sizeof(*action),
+                                (void**)&action));
+
+  action->owning_actions = actions;
+  action->state = IREE_HAL_cuda_QUEUE_ACTION_STATE_ALIVE;
+  action->cleanup_callback = NULL;
+  action->callback_user_data = NULL;
+  action->kind = IREE_HAL_CUDA_QUEUE_ACTION_TYPE_CALLBACK;
+  action->payload.callback.fn = callback;
+  action->payload.callback.user_data = user_data;
+  action->device = device;
+  action->dispatch_cu_stream = dispatch_stream;
+  action->callback_cu_stream = callback_stream;
+
+  // Initialize scratch fields.
+  action->event_count = 0;
+  action->is_pending = true;
+
+  // Retain all semaphores.
+  iree_hal_resource_set_t* resource_set = NULL;
+  iree_status_t status =
+      iree_hal_resource_set_allocate(actions->block_pool, &resource_set);
+  if (IREE_LIKELY(iree_status_is_ok(status))) {
+    status =
+        iree_hal_resource_set_insert(resource_set, wait_semaphore_list.count,
+                                     wait_semaphore_list.semaphores);
+  }
+  if (IREE_LIKELY(iree_status_is_ok(status))) {
+    status =
+        iree_hal_resource_set_insert(resource_set, signal_semaphore_list.count,
+                                     signal_semaphore_list.semaphores);
+  }
+  if (IREE_LIKELY(iree_status_is_ok(status))) {
+    action->resource_set = resource_set;
+  }
+
+  // Copy the semaphore and value list for later access.
+  // TODO: avoid host allocator malloc; use some pool for the allocation.
+  if (IREE_LIKELY(iree_status_is_ok(status))) {
+    status = iree_hal_cuda_copy_semaphore_list(wait_semaphore_list,
+                                               actions->host_allocator,
+                                               &action->wait_semaphore_list);
+  }
+  if (IREE_LIKELY(iree_status_is_ok(status))) {
+    status = iree_hal_cuda_copy_semaphore_list(signal_semaphore_list,
+                                               actions->host_allocator,
+                                               &action->signal_semaphore_list);
+  }
+
+  if (IREE_LIKELY(iree_status_is_ok(status))) {
+    // Retain the owning queue to make sure the action outlives it.
+    iree_hal_resource_retain(actions);
+
+    // Now everything is okay and we can enqueue the action.
+    iree_slim_mutex_lock(&actions->action_mutex);
+    iree_hal_cuda_queue_action_list_push_back(&actions->action_list, action);
+    iree_slim_mutex_unlock(&actions->action_mutex);
+  } else {
+    iree_hal_cuda_free_semaphore_list(actions->host_allocator,
+                                      &action->wait_semaphore_list);
+    iree_hal_cuda_free_semaphore_list(actions->host_allocator,
+                                      &action->signal_semaphore_list);
+    iree_hal_resource_set_free(resource_set);
+    iree_allocator_free(actions->host_allocator, action);
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
 static void iree_hal_cuda_post_error_to_worker_state(
     iree_hal_cuda_working_area_t* working_area, iree_status_code_t code) {
   iree_atomic_store_int32(&working_area->error_code, code,
@@ -552,7 +643,6 @@ static void iree_hal_cuda_execution_device_signal_host_callback(
   IREE_TRACE_ZONE_BEGIN(z0);
   iree_hal_cuda_queue_action_t* action =
       (iree_hal_cuda_queue_action_t*)user_data;
-  IREE_ASSERT_EQ(action->kind, IREE_HAL_CUDA_QUEUE_ACTION_TYPE_EXECUTION);
   IREE_ASSERT_EQ(action->state, IREE_HAL_cuda_QUEUE_ACTION_STATE_ALIVE);
   iree_hal_cuda_pending_queue_actions_t* actions = action->owning_actions;
 
@@ -586,6 +676,25 @@ static void iree_hal_cuda_execution_device_signal_host_callback(
   IREE_TRACE_ZONE_END(z0);
 }
 
+// Invokes the user-provided queue callback and then advances the timeline.
+//
+// This is the CUDA host function callback to cudaLaunchHostFunc(), invoked by
+// a CUDA driver thread. Note that code in this function MUST NOT invoke any
+// GPU API under the hood to avoid potential deadlock.
+static void iree_hal_cuda_queue_callback_host_callback(void* user_data) {
+  iree_hal_cuda_queue_action_t* action =
+      (iree_hal_cuda_queue_action_t*)user_data;
+  IREE_ASSERT_EQ(action->kind, IREE_HAL_CUDA_QUEUE_ACTION_TYPE_CALLBACK);
+
+  // Run the user callback before advancing the timeline so that host logic
+  // ordered against the queue observes a fully satisfied wait list. The user
+  // callback must follow the same rules as this function and not call back
+  // into any GPU API.
+  action->payload.callback.fn(action->payload.callback.user_data);
+
+  iree_hal_cuda_execution_device_signal_host_callback(user_data);
+}
+
 // Issues the given kernel dispatch |action| to the GPU.
 static iree_status_t iree_hal_cuda_pending_queue_actions_issue_execution(
     iree_hal_cuda_queue_action_t* action) {
@@ -617,6 +726,11 @@ static iree_status_t iree_hal_cuda_pending_queue_actions_issue_execution(
     iree_hal_command_buffer_t* command_buffer =
         action->payload.command_buffers.ptr[i];
     if (iree_hal_cuda_graph_command_buffer_isa(command_buffer)) {
+      // Patch any indirect dispatches with the current workgroup counts from
+      // their parameter buffers before launching the instantiated graph.
+      IREE_RETURN_AND_END_ZONE_IF_ERROR(
+          z0, iree_hal_cuda_graph_command_buffer_update_indirect_dispatches(
+                  command_buffer));
       CUgraphExec exec = iree_hal_cuda_graph_command_buffer_handle(
           action->payload.command_buffers.ptr[i]);
       IREE_CUDA_RETURN_AND_END_ZONE_IF_ERROR(
@@ -631,7 +745,8 @@ static iree_status_t iree_hal_cuda_pending_queue_actions_issue_execution(
       IREE_RETURN_AND_END_ZONE_IF_ERROR(
           z0, iree_hal_cuda_device_create_stream_command_buffer(
                   action->device, mode, IREE_HAL_COMMAND_CATEGORY_ANY,
-                  /*binding_capacity=*/0, &stream_command_buffer));
+                  /*binding_capacity=*/0, action->dispatch_cu_stream,
+                  &stream_command_buffer));
       IREE_RETURN_AND_END_ZONE_IF_ERROR(
           z0, iree_hal_resource_set_insert(action->resource_set, 1,
                                            &stream_command_buffer));
@@ -666,7 +781,9 @@ static iree_status_t iree_hal_cuda_pending_queue_actions_issue_execution(
 
   // Increase the pending action counter. We decrease it once it fully
   // completes and gets cleaned up.
-  ++action->owning_actions->working_area.pending_action_count;
+  iree_atomic_fetch_add_int32(
+      &action->owning_actions->working_area.pending_action_count, 1,
+      iree_memory_order_relaxed);
 
   // Now launch a host function on the callback stream to advance the semaphore
   // timeline.
@@ -681,6 +798,45 @@ static iree_status_t iree_hal_cuda_pending_queue_actions_issue_execution(
   return iree_ok_status();
 }
 
+// Issues the given host callback |action| on the callback stream.
+static iree_status_t iree_hal_cuda_pending_queue_actions_issue_callback(
+    iree_hal_cuda_queue_action_t* action) {
+  IREE_ASSERT_EQ(action->kind, IREE_HAL_CUDA_QUEUE_ACTION_TYPE_CALLBACK);
+  IREE_ASSERT_EQ(action->is_pending, false);
+  const iree_hal_cuda_dynamic_symbols_t* symbols =
+      action->owning_actions->symbols;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Wait for all the device CUevent in the callback stream so the host
+  // function only launches after all dependent GPU work completes. There is
+  // no GPU payload so nothing touches the dispatch stream.
+  for (iree_host_size_t i = 0; i < action->event_count; ++i) {
+    IREE_CUDA_RETURN_AND_END_ZONE_IF_ERROR(
+        z0, symbols,
+        cuStreamWaitEvent(action->callback_cu_stream,
+                          iree_hal_cuda_event_handle(action->events[i]),
+                          CU_EVENT_WAIT_DEFAULT),
+        "cuStreamWaitEvent");
+  }
+
+  // Increase the pending action counter. We decrease it once it fully
+  // completes and gets cleaned up.
+  iree_atomic_fetch_add_int32(
+      &action->owning_actions->working_area.pending_action_count, 1,
+      iree_memory_order_relaxed);
+
+  // Now launch a host function on the callback stream to run the user
+  // callback and advance the semaphore timeline.
+  IREE_CUDA_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, symbols,
+      cuLaunchHostFunc(action->callback_cu_stream,
+                       iree_hal_cuda_queue_callback_host_callback, action),
+      "cuLaunchHostFunc");
+
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
 static void iree_hal_cuda_queue_action_clear_events(
     iree_hal_cuda_queue_action_t* action) {
   for (iree_host_size_t i = 0; i < action->event_count; ++i) {
@@ -714,7 +870,8 @@ static iree_status_t iree_hal_cuda_pending_queue_actions_issue_cleanup(
 
   // Now we fully executed and cleaned up this action. Decrease the pending
   // action counter.
-  --actions->working_area.pending_action_count;
+  iree_atomic_fetch_sub_int32(&actions->working_area.pending_action_count, 1,
+                              iree_memory_order_relaxed);
 
   // Drop reference to the pending action queue given now we are done.
   iree_hal_resource_release(actions);
@@ -723,6 +880,24 @@ static iree_status_t iree_hal_cuda_pending_queue_actions_issue_cleanup(
   return iree_ok_status();
 }
 
+iree_host_size_t iree_hal_cuda_pending_queue_actions_outstanding_count(
+    iree_hal_cuda_pending_queue_actions_t* actions) {
+  // Actions enqueued but not yet released to the GPU.
+  iree_host_size_t pending_count = 0;
+  iree_slim_mutex_lock(&actions->action_mutex);
+  for (iree_hal_cuda_queue_action_t* action = actions->action_list.head;
+       action != NULL; action = action->next) {
+    ++pending_count;
+  }
+  iree_slim_mutex_unlock(&actions->action_mutex);
+
+  // Actions issued to the GPU but not yet completed and cleaned up.
+  int32_t issued_count = iree_atomic_load_int32(
+      &actions->working_area.pending_action_count, iree_memory_order_relaxed);
+
+  return pending_count + (iree_host_size_t)issued_count;
+}
+
 iree_status_t iree_hal_cuda_pending_queue_actions_issue(
     iree_hal_cuda_pending_queue_actions_t* actions) {
   IREE_TRACE_ZONE_BEGIN(z0);
@@ -920,7 +1095,16 @@ static iree_status_t iree_hal_cuda_worker_process_ready_list(
 
       switch (action->state) {
         case IREE_HAL_cuda_QUEUE_ACTION_STATE_ALIVE:
-          status = iree_hal_cuda_pending_queue_actions_issue_execution(action);
+          switch (action->kind) {
+            case IREE_HAL_CUDA_QUEUE_ACTION_TYPE_EXECUTION:
+              status =
+                  iree_hal_cuda_pending_queue_actions_issue_execution(action);
+              break;
+            case IREE_HAL_CUDA_QUEUE_ACTION_TYPE_CALLBACK:
+              status =
+                  iree_hal_cuda_pending_queue_actions_issue_callback(action);
+              break;
+          }
           if (iree_status_is_ok(status)) action->event_count = 0;
           break;
         case IREE_HAL_cuda_QUEUE_ACTION_STATE_ZOMBIE:
@@ -985,7 +1169,10 @@ static int iree_hal_cuda_worker_execute(
       return -1;
     }
 
-    if (IREE_UNLIKELY(should_exit && working_area->pending_action_count == 0)) {
+    if (IREE_UNLIKELY(should_exit &&
+                      iree_atomic_load_int32(
+                          &working_area->pending_action_count,
+                          iree_memory_order_relaxed) == 0)) {
       // Signal that this thread is committed to exit.
       // This state has a priority that is only lower than error exit.
       // A CUDA callback may have posted an error, make sure we don't
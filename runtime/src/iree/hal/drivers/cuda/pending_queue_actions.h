@@ -67,10 +67,28 @@ iree_status_t iree_hal_cuda_pending_queue_actions_enqueue_execution(
     iree_host_size_t command_buffer_count,
     iree_hal_command_buffer_t* const* command_buffers);
 
+// Enqueues a host |callback| invocation that waits on |wait_semaphore_list|
+// and signals |signal_semaphore_list| after the callback returns.
+//
+// The callback is invoked from a CUDA driver thread once all waits are
+// satisfied; it must not block and must not call back into any GPU API.
+iree_status_t iree_hal_cuda_pending_queue_actions_enqueue_callback(
+    iree_hal_device_t* device, CUstream dispatch_stream,
+    CUstream callback_stream, iree_hal_cuda_pending_queue_actions_t* actions,
+    const iree_hal_semaphore_list_t wait_semaphore_list,
+    const iree_hal_semaphore_list_t signal_semaphore_list,
+    iree_hal_queue_callback_fn_t callback, void* user_data);
+
 // Tries to scan the pending actions and release ready ones to the GPU.
 iree_status_t iree_hal_cuda_pending_queue_actions_issue(
     iree_hal_cuda_pending_queue_actions_t* actions);
 
+// Returns the number of actions that have been enqueued but have not yet
+// completed execution and cleanup. Intended for monitoring; the value may
+// change concurrently.
+iree_host_size_t iree_hal_cuda_pending_queue_actions_outstanding_count(
+    iree_hal_cuda_pending_queue_actions_t* actions);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
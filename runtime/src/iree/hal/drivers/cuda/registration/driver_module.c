@@ -17,6 +17,12 @@ IREE_FLAG(
     bool, cuda_use_streams, true,
     "Use CUDA streams (instead of graphs) for executing command buffers.");
 
+IREE_FLAG(
+    bool, cuda_graph_caching, true,
+    "Caches instantiated executable graphs and re-binds them in place when\n"
+    "re-recordings only change buffer pointers or launch parameters instead\n"
+    "of re-instantiating on every submission. Only used with graphs.");
+
 IREE_FLAG(bool, cuda_allow_inline_execution, false,
           "Allow command buffers to execute inline against CUDA streams when\n"
           "possible.");
@@ -25,6 +31,18 @@ IREE_FLAG(
     bool, cuda_async_allocations, true,
     "Enables CUDA asynchronous stream-ordered allocations when supported.");
 
+IREE_FLAG(
+    bool, cuda_transfer_stream, true,
+    "Issues transfer-only submissions (readbacks/uploads) on a dedicated\n"
+    "copy stream so they launch as soon as their wait semaphores resolve\n"
+    "instead of queuing behind dispatch work.");
+
+IREE_FLAG(
+    int32_t, cuda_dispatch_streams, 1,
+    "Number of CUDA streams dispatch work is distributed across. Independent\n"
+    "submissions may overlap on the GPU when more than one stream is used;\n"
+    "dependent submissions remain ordered via cross-stream event waits.");
+
 IREE_FLAG(
     bool, cuda_tracing, true,
     "Enables tracing of stream events when Tracy instrumentation is enabled.\n"
@@ -102,8 +120,11 @@ static iree_status_t iree_hal_cuda_driver_factory_try_create(
     device_params.command_buffer_mode =
         IREE_HAL_CUDA_COMMAND_BUFFER_MODE_STREAM;
   }
+  device_params.graph_caching = FLAG_cuda_graph_caching;
   device_params.stream_tracing = FLAG_cuda_tracing;
   device_params.async_allocations = FLAG_cuda_async_allocations;
+  device_params.dispatch_stream_count = FLAG_cuda_dispatch_streams;
+  device_params.dedicated_transfer_stream = FLAG_cuda_transfer_stream;
 
   driver_options.default_device_index = FLAG_cuda_default_index;
   if (FLAG_cuda_default_index_from_mpi) {
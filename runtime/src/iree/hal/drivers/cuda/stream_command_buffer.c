@@ -14,6 +14,13 @@
 #include "iree/hal/utils/collective_batch.h"
 #include "iree/hal/utils/resource_set.h"
 
+// Total number of kernel arguments a single dispatch may take: all bindings
+// across all descriptor sets plus all push constants.
+#define IREE_HAL_CUDA_MAX_KERNEL_PARAM_COUNT            \
+  (IREE_HAL_CUDA_MAX_DESCRIPTOR_SET_COUNT *             \
+       IREE_HAL_CUDA_MAX_DESCRIPTOR_SET_BINDING_COUNT + \
+   IREE_HAL_CUDA_MAX_PUSH_CONSTANT_COUNT)
+
 typedef struct iree_hal_cuda_stream_command_buffer_t {
   iree_hal_command_buffer_t base;
   iree_allocator_t host_allocator;
@@ -45,6 +52,15 @@ typedef struct iree_hal_cuda_stream_command_buffer_t {
   struct {
     CUdeviceptr bindings[IREE_HAL_CUDA_MAX_DESCRIPTOR_SET_BINDING_COUNT];
   } descriptor_sets[IREE_HAL_CUDA_MAX_DESCRIPTOR_SET_COUNT];
+
+  // Persistent staging for dispatch kernel arguments. cuLaunchKernel copies
+  // the parameter memory before returning so the same staging area can be
+  // reused by every dispatch in the recording instead of growing the arena
+  // per dispatch. kernel_params[i] permanently points at kernel_payload[i]
+  // (CUDA requires the extra level of indirection) and only the payload is
+  // rewritten when recording a dispatch.
+  void* kernel_params[IREE_HAL_CUDA_MAX_KERNEL_PARAM_COUNT];
+  CUdeviceptr kernel_payload[IREE_HAL_CUDA_MAX_KERNEL_PARAM_COUNT];
 } iree_hal_cuda_stream_command_buffer_t;
 
 static const iree_hal_command_buffer_vtable_t
@@ -96,6 +112,9 @@ iree_status_t iree_hal_cuda_stream_command_buffer_create(
   command_buffer->tracing_context = tracing_context;
   command_buffer->cu_stream = stream;
   iree_arena_initialize(block_pool, &command_buffer->arena);
+  for (iree_host_size_t i = 0; i < IREE_HAL_CUDA_MAX_KERNEL_PARAM_COUNT; ++i) {
+    command_buffer->kernel_params[i] = &command_buffer->kernel_payload[i];
+  }
 
   iree_status_t status =
       iree_hal_resource_set_allocate(block_pool, &command_buffer->resource_set);
@@ -536,7 +555,15 @@ static iree_status_t iree_hal_cuda_stream_command_buffer_dispatch(
   // We append push constants to the end of descriptors to form a linear chain
   // of kernel arguments.
   iree_host_size_t kernel_params_count = descriptor_count + push_constant_count;
-  iree_host_size_t kernel_params_length = kernel_params_count * sizeof(void*);
+  if (IREE_UNLIKELY(kernel_params_count >
+                    IREE_HAL_CUDA_MAX_KERNEL_PARAM_COUNT)) {
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(IREE_STATUS_RESOURCE_EXHAUSTED,
+                            "exceeded available kernel argument slots; "
+                            "requested %" PRIhsz " vs. maximal %d",
+                            kernel_params_count,
+                            IREE_HAL_CUDA_MAX_KERNEL_PARAM_COUNT);
+  }
 
   // Per CUDA API requirements, we need two levels of indirection for passing
   // kernel arguments in.
@@ -545,25 +572,15 @@ static iree_status_t iree_hal_cuda_stream_command_buffer_dispatch(
   //   points to the region of memory from which the actual parameter will be
   //   copied."
   //
-  // (From the cuGraphAddKernelNode API doc in
-  // https://docs.nvidia.com/cuda/cuda-driver-api/group__CUDA__GRAPH.html#group__CUDA__GRAPH_1g50d871e3bd06c1b835e52f2966ef366b)
+  // (From the cuLaunchKernel API doc in
+  // https://docs.nvidia.com/cuda/cuda-driver-api/group__CUDA__EXEC.html)
   //
-  // It means each kernel_params[i] is itself a pointer to the corresponding
-  // element at the *second* inline allocation at the end of the current
-  // segment.
-  iree_host_size_t total_size = kernel_params_length * 2;
-  uint8_t* storage_base = NULL;
-  IREE_RETURN_AND_END_ZONE_IF_ERROR(
-      z0, iree_arena_allocate(&command_buffer->arena, total_size,
-                              (void**)&storage_base));
-  void** params_ptr = (void**)storage_base;
-
-  // Set up kernel arguments to point to the payload slots.
-  CUdeviceptr* payload_ptr =
-      (CUdeviceptr*)((uint8_t*)params_ptr + kernel_params_length);
-  for (size_t i = 0; i < kernel_params_count; i++) {
-    params_ptr[i] = &payload_ptr[i];
-  }
+  // The persistent staging set up at creation already has each
+  // kernel_params[i] pointing at kernel_payload[i]; only the payload needs to
+  // be rewritten here. cuLaunchKernel copies the parameters before returning
+  // so reuse across dispatches is safe.
+  void** params_ptr = command_buffer->kernel_params;
+  CUdeviceptr* payload_ptr = command_buffer->kernel_payload;
 
   // Copy descriptors from all sets to the end of the current segment for later
   // access.
@@ -11,9 +11,10 @@
 #include <string.h>
 
 #include "iree/base/api.h"
+#include "iree/base/internal/atomic_slist.h"
 #include "iree/base/internal/atomics.h"
+#include "iree/base/internal/cpu.h"
 #include "iree/base/internal/event_pool.h"
-#include "iree/base/internal/synchronization.h"
 #include "iree/hal/api.h"
 #include "iree/hal/drivers/cuda/cuda_dynamic_symbols.h"
 #include "iree/hal/drivers/cuda/cuda_status_util.h"
@@ -71,6 +72,25 @@ static void iree_hal_cuda_timepoint_free(iree_hal_cuda_timepoint_t* timepoint) {
 // iree_hal_cuda_timepoint_pool_t
 //===----------------------------------------------------------------------===//
 
+IREE_TYPED_ATOMIC_SLIST_WRAPPER(iree_hal_cuda_timepoint,
+                                iree_hal_cuda_timepoint_t,
+                                offsetof(iree_hal_cuda_timepoint_t, pool_next));
+
+// Number of free lists the pool is split across. Timepoints are acquired and
+// released at timeline operation rates from many threads at once and a single
+// list head is a contention point; sharding by the calling processor keeps
+// each head mostly core-local. Must be a power of two.
+#define IREE_HAL_CUDA_TIMEPOINT_POOL_SHARD_COUNT 8
+
+typedef struct iree_hal_cuda_timepoint_pool_shard_t {
+  // Free list of pooled timepoint objects.
+  iree_hal_cuda_timepoint_slist_t free_list;
+  // Approximate number of timepoints in the free list; used to bound pooled
+  // storage on release. Releases may transiently overshoot the per-shard
+  // capacity by the number of concurrent releasers which is harmless.
+  iree_atomic_int32_t available_count;
+} iree_hal_cuda_timepoint_pool_shard_t;
+
 struct iree_hal_cuda_timepoint_pool_t {
   // The allocator used to create the timepoint pool.
   iree_allocator_t host_allocator;
@@ -80,25 +100,27 @@ struct iree_hal_cuda_timepoint_pool_t {
   // The pool to acquire device events. Internally synchronized.
   iree_hal_cuda_event_pool_t* device_event_pool;
 
-  // Note that the above pools are internally synchronized; so we don't and
-  // shouldn't use the following mutex to guard access to them.
-
-  // Guards timepoint related fields this pool. We don't expect a performant
-  // program to frequently allocate timepoints for synchronization purposes; the
-  // traffic to this pool should be low. So it should be fine to use mutex to
-  // guard here.
-  iree_slim_mutex_t timepoint_mutex;
-
-  // Maximum number of timepoint objects that will be maintained in the pool.
+  // Maximum number of timepoint objects that each shard will maintain.
   // More timepoints may be allocated at any time, but they will be disposed
   // directly when they are no longer needed.
-  iree_host_size_t available_capacity IREE_GUARDED_BY(timepoint_mutex);
-  // Total number of currently available timepoint objects.
-  iree_host_size_t available_count IREE_GUARDED_BY(timepoint_mutex);
-  // The list of available_count timepoint objects.
-  iree_hal_cuda_timepoint_t* available_list[] IREE_GUARDED_BY(timepoint_mutex);
+  iree_host_size_t shard_capacity;
+
+  // Per-processor-group free lists; each internally synchronized.
+  iree_hal_cuda_timepoint_pool_shard_t shards
+      [IREE_HAL_CUDA_TIMEPOINT_POOL_SHARD_COUNT];
 };
-// + Additional inline allocation for holding timepoints up to the capacity.
+
+// Returns the shard the calling thread should prefer for acquire/release.
+// Threads may migrate between queries; correctness does not depend on
+// stickiness, only contention avoidance does.
+static iree_hal_cuda_timepoint_pool_shard_t*
+iree_hal_cuda_timepoint_pool_current_shard(
+    iree_hal_cuda_timepoint_pool_t* timepoint_pool) {
+  uint32_t processor_id = iree_cpu_query_processor_id();
+  return &timepoint_pool
+              ->shards[processor_id &
+                       (IREE_HAL_CUDA_TIMEPOINT_POOL_SHARD_COUNT - 1)];
+}
 
 iree_status_t iree_hal_cuda_timepoint_pool_allocate(
     iree_event_pool_t* host_event_pool,
@@ -112,26 +134,36 @@ iree_status_t iree_hal_cuda_timepoint_pool_allocate(
   IREE_TRACE_ZONE_BEGIN(z0);
 
   iree_hal_cuda_timepoint_pool_t* timepoint_pool = NULL;
-  iree_host_size_t total_size =
-      sizeof(*timepoint_pool) +
-      available_capacity * sizeof(*timepoint_pool->available_list);
   IREE_RETURN_AND_END_ZONE_IF_ERROR(
-      z0, iree_allocator_malloc(host_allocator, total_size,
+      z0, iree_allocator_malloc(host_allocator, sizeof(*timepoint_pool),
                                 (void**)&timepoint_pool));
   timepoint_pool->host_allocator = host_allocator;
   timepoint_pool->host_event_pool = host_event_pool;
   timepoint_pool->device_event_pool = device_event_pool;
 
-  iree_slim_mutex_initialize(&timepoint_pool->timepoint_mutex);
-  timepoint_pool->available_capacity = available_capacity;
-  timepoint_pool->available_count = 0;
+  // Split the capacity across the shards, rounding up so the total pooled
+  // count is at least what the caller requested.
+  timepoint_pool->shard_capacity =
+      iree_host_size_ceil_div(available_capacity,
+                              IREE_HAL_CUDA_TIMEPOINT_POOL_SHARD_COUNT);
+  for (iree_host_size_t i = 0; i < IREE_HAL_CUDA_TIMEPOINT_POOL_SHARD_COUNT;
+       ++i) {
+    iree_hal_cuda_timepoint_slist_initialize(
+        &timepoint_pool->shards[i].free_list);
+  }
 
+  // Seed the shards round-robin with preallocated timepoints.
   iree_status_t status = iree_ok_status();
   for (iree_host_size_t i = 0; i < available_capacity; ++i) {
-    status = iree_hal_cuda_timepoint_allocate(
-        timepoint_pool, host_allocator,
-        &timepoint_pool->available_list[timepoint_pool->available_count++]);
+    iree_hal_cuda_timepoint_t* timepoint = NULL;
+    status = iree_hal_cuda_timepoint_allocate(timepoint_pool, host_allocator,
+                                              &timepoint);
     if (!iree_status_is_ok(status)) break;
+    iree_hal_cuda_timepoint_pool_shard_t* shard =
+        &timepoint_pool->shards[i % IREE_HAL_CUDA_TIMEPOINT_POOL_SHARD_COUNT];
+    iree_hal_cuda_timepoint_slist_push_unsafe(&shard->free_list, timepoint);
+    iree_atomic_fetch_add_int32(&shard->available_count, 1,
+                                iree_memory_order_relaxed);
   }
 
   if (iree_status_is_ok(status)) {
@@ -148,10 +180,15 @@ void iree_hal_cuda_timepoint_pool_free(
   iree_allocator_t host_allocator = timepoint_pool->host_allocator;
   IREE_TRACE_ZONE_BEGIN(z0);
 
-  for (iree_host_size_t i = 0; i < timepoint_pool->available_count; ++i) {
-    iree_hal_cuda_timepoint_free(timepoint_pool->available_list[i]);
+  for (iree_host_size_t i = 0; i < IREE_HAL_CUDA_TIMEPOINT_POOL_SHARD_COUNT;
+       ++i) {
+    iree_hal_cuda_timepoint_pool_shard_t* shard = &timepoint_pool->shards[i];
+    iree_hal_cuda_timepoint_t* timepoint = NULL;
+    while ((timepoint = iree_hal_cuda_timepoint_slist_pop(&shard->free_list))) {
+      iree_hal_cuda_timepoint_free(timepoint);
+    }
+    iree_hal_cuda_timepoint_slist_deinitialize(&shard->free_list);
   }
-  iree_slim_mutex_deinitialize(&timepoint_pool->timepoint_mutex);
   iree_allocator_free(host_allocator, timepoint_pool);
 
   IREE_TRACE_ZONE_END(z0);
@@ -173,19 +210,28 @@ static iree_status_t iree_hal_cuda_timepoint_pool_acquire_internal(
   // new iree_hal_cuda_timepoint_t objects.
   iree_host_size_t remaining_count = timepoint_count;
 
-  // Try first to grab from the pool.
-  iree_slim_mutex_lock(&timepoint_pool->timepoint_mutex);
-  iree_host_size_t from_pool_count =
-      iree_min(timepoint_pool->available_count, timepoint_count);
-  if (from_pool_count > 0) {
-    iree_host_size_t pool_base_index =
-        timepoint_pool->available_count - from_pool_count;
-    memcpy(out_timepoints, &timepoint_pool->available_list[pool_base_index],
-           from_pool_count * sizeof(*timepoint_pool->available_list));
-    timepoint_pool->available_count -= from_pool_count;
-    remaining_count -= from_pool_count;
+  // Try first to grab from the free lists, starting with the shard matching
+  // the calling processor and stealing from the others when it runs dry.
+  iree_hal_cuda_timepoint_pool_shard_t* home_shard =
+      iree_hal_cuda_timepoint_pool_current_shard(timepoint_pool);
+  iree_host_size_t home_shard_index =
+      (iree_host_size_t)(home_shard - timepoint_pool->shards);
+  iree_host_size_t from_pool_count = 0;
+  for (iree_host_size_t i = 0;
+       i < IREE_HAL_CUDA_TIMEPOINT_POOL_SHARD_COUNT && remaining_count > 0;
+       ++i) {
+    iree_hal_cuda_timepoint_pool_shard_t* shard =
+        &timepoint_pool->shards[(home_shard_index + i) %
+                                IREE_HAL_CUDA_TIMEPOINT_POOL_SHARD_COUNT];
+    iree_hal_cuda_timepoint_t* timepoint = NULL;
+    while (remaining_count > 0 &&
+           (timepoint = iree_hal_cuda_timepoint_slist_pop(&shard->free_list))) {
+      iree_atomic_fetch_sub_int32(&shard->available_count, 1,
+                                  iree_memory_order_relaxed);
+      out_timepoints[from_pool_count++] = timepoint;
+      --remaining_count;
+    }
   }
-  iree_slim_mutex_unlock(&timepoint_pool->timepoint_mutex);
 
   // Allocate the rest of the timepoints.
   if (remaining_count > 0) {
@@ -318,36 +364,26 @@ void iree_hal_cuda_timepoint_pool_release(
     }
   }
 
-  // We'll try to release all we can back to the pool and then deinitialize
-  // the ones that won't fit.
-  iree_host_size_t remaining_count = timepoint_count;
-
-  // Try first to release to the pool.
-  iree_slim_mutex_lock(&timepoint_pool->timepoint_mutex);
-  iree_host_size_t to_pool_count = iree_min(
-      timepoint_pool->available_capacity - timepoint_pool->available_count,
-      timepoint_count);
-  if (to_pool_count > 0) {
-    for (iree_host_size_t i = 0; i < to_pool_count; ++i) {
-      iree_hal_cuda_timepoint_clear(timepoints[i]);
-    }
-    iree_host_size_t pool_base_index = timepoint_pool->available_count;
-    memcpy(&timepoint_pool->available_list[pool_base_index], timepoints,
-           to_pool_count * sizeof(*timepoint_pool->available_list));
-    timepoint_pool->available_count += to_pool_count;
-    remaining_count -= to_pool_count;
-  }
-  iree_slim_mutex_unlock(&timepoint_pool->timepoint_mutex);
-
-  // Deallocate the rest of the timepoints. We don't bother resetting them as we
-  // are getting rid of them.
-  if (remaining_count > 0) {
-    IREE_TRACE_ZONE_BEGIN_NAMED(z1, "timepoint-pool-unpooled-release");
-    for (iree_host_size_t i = 0; i < remaining_count; ++i) {
-      iree_hal_cuda_timepoint_clear(timepoints[to_pool_count + i]);
-      iree_hal_cuda_timepoint_free(timepoints[to_pool_count + i]);
+  // Release to the calling processor's shard while it has pooled capacity and
+  // deallocate the ones that won't fit. The count check and push are not one
+  // atomic operation so concurrent releasers may briefly exceed the capacity;
+  // the overshoot is bounded by the releaser count and corrects itself as
+  // timepoints are acquired.
+  iree_hal_cuda_timepoint_pool_shard_t* shard =
+      iree_hal_cuda_timepoint_pool_current_shard(timepoint_pool);
+  for (iree_host_size_t i = 0; i < timepoint_count; ++i) {
+    iree_hal_cuda_timepoint_clear(timepoints[i]);
+    if (iree_atomic_load_int32(&shard->available_count,
+                               iree_memory_order_relaxed) <
+        (int32_t)timepoint_pool->shard_capacity) {
+      iree_atomic_fetch_add_int32(&shard->available_count, 1,
+                                  iree_memory_order_relaxed);
+      iree_hal_cuda_timepoint_slist_push(&shard->free_list, timepoints[i]);
+    } else {
+      IREE_TRACE_ZONE_BEGIN_NAMED(z1, "timepoint-pool-unpooled-release");
+      iree_hal_cuda_timepoint_free(timepoints[i]);
+      IREE_TRACE_ZONE_END(z1);
     }
-    IREE_TRACE_ZONE_END(z1);
   }
   IREE_TRACE_ZONE_END(z0);
 }
@@ -8,6 +8,7 @@
 #define IREE_HAL_DRIVERS_CUDA_TIMEPOINT_POOL_H_
 
 #include "iree/base/api.h"
+#include "iree/base/internal/atomic_slist.h"
 #include "iree/base/internal/event_pool.h"
 #include "iree/hal/drivers/cuda/event_pool.h"
 #include "iree/hal/utils/semaphore_base.h"
@@ -53,6 +54,10 @@ typedef struct iree_hal_cuda_timepoint_t {
   // The timepoint pool that owns this timepoint.
   iree_hal_cuda_timepoint_pool_t* pool;
 
+  // Intrusive pointer used to link the timepoint into the pool free list
+  // while it is not acquired. Only valid while pooled.
+  iree_atomic_slist_intrusive_ptr_t pool_next;
+
   iree_hal_cuda_timepoint_kind_t kind;
   union {
     iree_event_t host_wait;
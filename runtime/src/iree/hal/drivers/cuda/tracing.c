@@ -16,6 +16,14 @@
 // To prevent spilling pages we leave some room for the context structure.
 #define IREE_HAL_CUDA_TRACING_DEFAULT_QUERY_CAPACITY (16 * 1024 - 256)
 
+// Minimum interval between CPU/GPU timeline recalibrations.
+// Without CUPTI the GPU timestamps we report are extrapolated from a single
+// base event pair sampled at context creation and the two clocks drift apart
+// over long captures; periodically resampling keeps continuously profiled
+// workloads aligned without adding per-zone cost.
+#define IREE_HAL_CUDA_TRACING_CALIBRATION_INTERVAL \
+  (1 * 1000 * 1000 * 1000)  // 1s
+
 struct iree_hal_cuda_tracing_context_t {
   const iree_hal_cuda_dynamic_symbols_t* symbols;
 
@@ -32,6 +40,13 @@ struct iree_hal_cuda_tracing_context_t {
   // between events and we need a stable base event.
   CUevent base_event;
 
+  // Event reused to sample fresh CPU/GPU timestamp pairs for recalibration.
+  CUevent calibration_event;
+  // CPU timestamp (in tracing timebase) of the last calibration sample sent.
+  int64_t last_calibration_cpu_timestamp;
+  // Wall-clock time of the last calibration used for rate limiting.
+  iree_time_t last_calibration_time;
+
   // Indices into |event_pool| defining a ringbuffer.
   uint32_t query_head;
   uint32_t query_tail;
@@ -114,6 +129,10 @@ iree_status_t iree_hal_cuda_tracing_context_allocate(
     status = IREE_CURESULT_TO_STATUS(
         symbols, cuEventCreate(&context->base_event, CU_EVENT_DEFAULT));
   }
+  if (iree_status_is_ok(status)) {
+    status = IREE_CURESULT_TO_STATUS(
+        symbols, cuEventCreate(&context->calibration_event, CU_EVENT_DEFAULT));
+  }
   if (iree_status_is_ok(status)) {
     status = iree_hal_cuda_tracing_context_initial_calibration(
         symbols, stream, context->base_event, &cpu_timestamp, &gpu_timestamp,
@@ -121,11 +140,14 @@ iree_status_t iree_hal_cuda_tracing_context_allocate(
   }
 
   // Allocate the GPU context and pass initial calibration data.
+  // The context is calibrated: we periodically resample the CPU/GPU timestamp
+  // pair during collection and send drift corrections.
   if (iree_status_is_ok(status)) {
     context->id = iree_tracing_gpu_context_allocate(
         IREE_TRACING_GPU_CONTEXT_TYPE_VULKAN, queue_name.data, queue_name.size,
-        /*is_calibrated=*/false, cpu_timestamp, gpu_timestamp,
-        timestamp_period);
+        /*is_calibrated=*/true, cpu_timestamp, gpu_timestamp, timestamp_period);
+    context->last_calibration_cpu_timestamp = cpu_timestamp;
+    context->last_calibration_time = iree_time_now();
   }
 
   if (iree_status_is_ok(status)) {
@@ -159,6 +181,10 @@ void iree_hal_cuda_tracing_context_free(
     IREE_CUDA_IGNORE_ERROR(context->symbols,
                            cuEventDestroy(context->base_event));
   }
+  if (context->calibration_event) {
+    IREE_CUDA_IGNORE_ERROR(context->symbols,
+                           cuEventDestroy(context->calibration_event));
+  }
 
   iree_allocator_t host_allocator = context->host_allocator;
   iree_allocator_free(host_allocator, context);
@@ -166,6 +192,41 @@ void iree_hal_cuda_tracing_context_free(
   IREE_TRACE_ZONE_END(z0);
 }
 
+// Resamples the CPU/GPU timestamp correlation and sends a drift correction
+// to tracy. Must only be called when all outstanding queries have been
+// collected so that the calibration event retires promptly. If the stream has
+// other uncollected work pending the sample is skipped rather than blocking
+// the calling thread.
+static void iree_hal_cuda_tracing_context_recalibrate(
+    iree_hal_cuda_tracing_context_t* context) {
+  if (context->symbols->cuEventRecord(context->calibration_event,
+                                      context->stream) != CUDA_SUCCESS) {
+    return;
+  }
+  if (context->symbols->cuEventQuery(context->calibration_event) !=
+      CUDA_SUCCESS) {
+    // Not retired yet; the stream is busy with untraced work. Skip this round
+    // instead of synchronizing - we'll recalibrate on a future collection.
+    return;
+  }
+  int64_t cpu_timestamp = iree_tracing_time();
+
+  float relative_millis = 0.0f;
+  if (context->symbols->cuEventElapsedTime(&relative_millis,
+                                           context->base_event,
+                                           context->calibration_event) !=
+      CUDA_SUCCESS) {
+    return;
+  }
+  int64_t gpu_timestamp = (int64_t)((double)relative_millis * 1000000.0);
+
+  iree_tracing_gpu_context_calibrate(
+      context->id, cpu_timestamp - context->last_calibration_cpu_timestamp,
+      cpu_timestamp, gpu_timestamp);
+  context->last_calibration_cpu_timestamp = cpu_timestamp;
+  context->last_calibration_time = iree_time_now();
+}
+
 void iree_hal_cuda_tracing_context_collect(
     iree_hal_cuda_tracing_context_t* context) {
   if (!context) return;
@@ -215,6 +276,13 @@ void iree_hal_cuda_tracing_context_collect(
     }
   }
 
+  // With all queries collected the traced portion of the stream has retired
+  // and we can cheaply resample the CPU/GPU clock correlation.
+  if (iree_time_now() - context->last_calibration_time >=
+      IREE_HAL_CUDA_TRACING_CALIBRATION_INTERVAL) {
+    iree_hal_cuda_tracing_context_recalibrate(context);
+  }
+
   IREE_TRACE_ZONE_END(z0);
 }
 
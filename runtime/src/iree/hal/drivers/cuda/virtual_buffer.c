@@ -0,0 +1,324 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/hal/drivers/cuda/virtual_buffer.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "iree/base/api.h"
+#include "iree/base/internal/synchronization.h"
+#include "iree/hal/drivers/cuda/cuda_buffer.h"
+#include "iree/hal/drivers/cuda/cuda_status_util.h"
+
+// Bookkeeping for a reserved virtual address range and its physical chunks.
+// Stashed on the wrapping iree_hal_cuda_buffer_t as release callback user data
+// so that command buffer binding resolution sees a normal CUDA buffer.
+typedef struct iree_hal_cuda_virtual_buffer_t {
+  const iree_hal_cuda_dynamic_symbols_t* symbols;
+  CUdevice device;
+  iree_allocator_t host_allocator;
+  // Base of the reserved virtual address range.
+  CUdeviceptr base_ptr;
+  // Total reserved size; the buffer allocation size rounded up to
+  // |chunk_size|.
+  iree_device_size_t reserved_size;
+  // Physical commit granularity as reported by the driver.
+  iree_device_size_t chunk_size;
+  iree_host_size_t chunk_count;
+  // Guards |chunks| against concurrent commit/decommit requests.
+  iree_slim_mutex_t mutex;
+  // One physical allocation handle per chunk; 0 when uncommitted.
+  CUmemGenericAllocationHandle chunks[];
+} iree_hal_cuda_virtual_buffer_t;
+
+static CUmemAllocationProp iree_hal_cuda_virtual_buffer_allocation_prop(
+    CUdevice device) {
+  CUmemAllocationProp prop;
+  memset(&prop, 0, sizeof(prop));
+  prop.type = CU_MEM_ALLOCATION_TYPE_PINNED;
+  prop.location.type = CU_MEM_LOCATION_TYPE_DEVICE;
+  prop.location.id = device;
+  return prop;
+}
+
+static void iree_hal_cuda_virtual_buffer_release(void* user_data,
+                                                 iree_hal_buffer_t* buffer) {
+  iree_hal_cuda_virtual_buffer_t* virtual_buffer =
+      (iree_hal_cuda_virtual_buffer_t*)user_data;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  for (iree_host_size_t i = 0; i < virtual_buffer->chunk_count; ++i) {
+    if (!virtual_buffer->chunks[i]) continue;
+    IREE_CUDA_IGNORE_ERROR(
+        virtual_buffer->symbols,
+        cuMemUnmap(virtual_buffer->base_ptr + i * virtual_buffer->chunk_size,
+                   virtual_buffer->chunk_size));
+    IREE_CUDA_IGNORE_ERROR(virtual_buffer->symbols,
+                           cuMemRelease(virtual_buffer->chunks[i]));
+  }
+  IREE_CUDA_IGNORE_ERROR(virtual_buffer->symbols,
+                         cuMemAddressFree(virtual_buffer->base_ptr,
+                                          virtual_buffer->reserved_size));
+
+  iree_slim_mutex_deinitialize(&virtual_buffer->mutex);
+  iree_allocator_free(virtual_buffer->host_allocator, virtual_buffer);
+
+  IREE_TRACE_ZONE_END(z0);
+}
+
+iree_status_t iree_hal_cuda_virtual_buffer_create(
+    iree_hal_allocator_t* device_allocator,
+    const iree_hal_cuda_dynamic_symbols_t* symbols, CUdevice device,
+    iree_hal_buffer_params_t params, iree_device_size_t allocation_size,
+    iree_allocator_t host_allocator, iree_hal_buffer_t** out_buffer) {
+  IREE_ASSERT_ARGUMENT(symbols);
+  IREE_ASSERT_ARGUMENT(out_buffer);
+  *out_buffer = NULL;
+  if (!iree_all_bits_set(params.type, IREE_HAL_MEMORY_TYPE_DEVICE_LOCAL)) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "virtual buffers must be device-local");
+  }
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, allocation_size);
+
+  // The driver dictates the minimum granularity at which physical memory can
+  // be committed; on most devices this is the 2MB large page size.
+  CUmemAllocationProp prop =
+      iree_hal_cuda_virtual_buffer_allocation_prop(device);
+  size_t granularity = 0;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, IREE_CURESULT_TO_STATUS(
+              symbols,
+              cuMemGetAllocationGranularity(&granularity, &prop,
+                                            CU_MEM_ALLOC_GRANULARITY_MINIMUM),
+              "cuMemGetAllocationGranularity"));
+
+  iree_device_size_t chunk_size = (iree_device_size_t)granularity;
+  iree_device_size_t reserved_size =
+      iree_device_align(allocation_size, chunk_size);
+  iree_host_size_t chunk_count = (iree_host_size_t)(reserved_size / chunk_size);
+
+  iree_hal_cuda_virtual_buffer_t* virtual_buffer = NULL;
+  iree_host_size_t total_size =
+      sizeof(*virtual_buffer) +
+      chunk_count * sizeof(virtual_buffer->chunks[0]);
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(host_allocator, total_size,
+                                (void**)&virtual_buffer));
+  virtual_buffer->symbols = symbols;
+  virtual_buffer->device = device;
+  virtual_buffer->host_allocator = host_allocator;
+  virtual_buffer->reserved_size = reserved_size;
+  virtual_buffer->chunk_size = chunk_size;
+  virtual_buffer->chunk_count = chunk_count;
+  iree_slim_mutex_initialize(&virtual_buffer->mutex);
+
+  iree_status_t status = IREE_CURESULT_TO_STATUS(
+      symbols,
+      cuMemAddressReserve(&virtual_buffer->base_ptr, reserved_size,
+                          /*alignment=*/chunk_size, /*addr=*/0, /*flags=*/0),
+      "cuMemAddressReserve");
+
+  iree_hal_buffer_t* buffer = NULL;
+  if (iree_status_is_ok(status)) {
+    const iree_hal_buffer_release_callback_t release_callback = {
+        .fn = iree_hal_cuda_virtual_buffer_release,
+        .user_data = virtual_buffer,
+    };
+    status = iree_hal_cuda_buffer_wrap(
+        device_allocator, params.type, params.access, params.usage,
+        allocation_size, /*byte_offset=*/0, /*byte_length=*/allocation_size,
+        IREE_HAL_CUDA_BUFFER_TYPE_VIRTUAL, virtual_buffer->base_ptr,
+        /*host_ptr=*/NULL, release_callback, host_allocator, &buffer);
+  }
+
+  if (iree_status_is_ok(status)) {
+    // The wrapping buffer now owns the bookkeeping and will tear down the
+    // reservation when released.
+    *out_buffer = buffer;
+  } else {
+    if (virtual_buffer->base_ptr) {
+      IREE_CUDA_IGNORE_ERROR(symbols,
+                             cuMemAddressFree(virtual_buffer->base_ptr,
+                                              reserved_size));
+    }
+    iree_slim_mutex_deinitialize(&virtual_buffer->mutex);
+    iree_allocator_free(host_allocator, virtual_buffer);
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+// Resolves |base_buffer| (or the allocation a span of it references) to its
+// virtual buffer bookkeeping and folds the span offset into |offset|.
+static iree_status_t iree_hal_cuda_virtual_buffer_resolve(
+    iree_hal_buffer_t* base_buffer, iree_device_size_t* offset,
+    iree_hal_cuda_virtual_buffer_t** out_virtual_buffer) {
+  iree_hal_buffer_t* allocated_buffer =
+      iree_hal_buffer_allocated_buffer(base_buffer);
+  if (iree_hal_cuda_buffer_type(allocated_buffer) !=
+      IREE_HAL_CUDA_BUFFER_TYPE_VIRTUAL) {
+    return iree_make_status(
+        IREE_STATUS_INVALID_ARGUMENT,
+        "buffer was not created as a CUDA virtual buffer");
+  }
+  *offset += iree_hal_buffer_byte_offset(base_buffer);
+  *out_virtual_buffer =
+      (iree_hal_cuda_virtual_buffer_t*)iree_hal_cuda_buffer_release_callback(
+          allocated_buffer)
+          .user_data;
+  return iree_ok_status();
+}
+
+iree_device_size_t iree_hal_cuda_virtual_buffer_granularity(
+    iree_hal_buffer_t* buffer) {
+  iree_device_size_t offset = 0;
+  iree_hal_cuda_virtual_buffer_t* virtual_buffer = NULL;
+  iree_status_t status =
+      iree_hal_cuda_virtual_buffer_resolve(buffer, &offset, &virtual_buffer);
+  if (!iree_status_is_ok(status)) {
+    iree_status_ignore(status);
+    return 0;
+  }
+  return virtual_buffer->chunk_size;
+}
+
+iree_status_t iree_hal_cuda_virtual_buffer_commit_range(
+    iree_hal_buffer_t* buffer, iree_device_size_t offset,
+    iree_device_size_t length) {
+  IREE_ASSERT_ARGUMENT(buffer);
+  if (!length) return iree_ok_status();
+  iree_hal_cuda_virtual_buffer_t* virtual_buffer = NULL;
+  IREE_RETURN_IF_ERROR(
+      iree_hal_cuda_virtual_buffer_resolve(buffer, &offset, &virtual_buffer));
+  if (offset > virtual_buffer->reserved_size ||
+      length > virtual_buffer->reserved_size - offset) {
+    return iree_make_status(
+        IREE_STATUS_OUT_OF_RANGE,
+        "commit range [%" PRIdsz ", %" PRIdsz
+        ") out of buffer bounds (%" PRIdsz ")",
+        offset, offset + length, virtual_buffer->reserved_size);
+  }
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, length);
+
+  CUmemAllocationProp prop =
+      iree_hal_cuda_virtual_buffer_allocation_prop(virtual_buffer->device);
+  CUmemAccessDesc access_desc;
+  memset(&access_desc, 0, sizeof(access_desc));
+  access_desc.location = prop.location;
+  access_desc.flags = CU_MEM_ACCESS_FLAGS_PROT_READWRITE;
+
+  iree_host_size_t first_chunk =
+      (iree_host_size_t)(offset / virtual_buffer->chunk_size);
+  iree_host_size_t last_chunk =
+      (iree_host_size_t)((offset + length - 1) / virtual_buffer->chunk_size);
+
+  iree_status_t status = iree_ok_status();
+  iree_slim_mutex_lock(&virtual_buffer->mutex);
+  for (iree_host_size_t i = first_chunk;
+       i <= last_chunk && iree_status_is_ok(status); ++i) {
+    if (virtual_buffer->chunks[i]) continue;  // already committed
+    CUdeviceptr chunk_ptr =
+        virtual_buffer->base_ptr + i * virtual_buffer->chunk_size;
+    CUmemGenericAllocationHandle handle = 0;
+    bool mapped = false;
+    status = IREE_CURESULT_TO_STATUS(
+        virtual_buffer->symbols,
+        cuMemCreate(&handle, virtual_buffer->chunk_size, &prop, /*flags=*/0),
+        "cuMemCreate");
+    if (iree_status_is_ok(status)) {
+      status = IREE_CURESULT_TO_STATUS(
+          virtual_buffer->symbols,
+          cuMemMap(chunk_ptr, virtual_buffer->chunk_size, /*offset=*/0, handle,
+                   /*flags=*/0),
+          "cuMemMap");
+      mapped = iree_status_is_ok(status);
+    }
+    if (iree_status_is_ok(status)) {
+      status = IREE_CURESULT_TO_STATUS(
+          virtual_buffer->symbols,
+          cuMemSetAccess(chunk_ptr, virtual_buffer->chunk_size, &access_desc,
+                         /*count=*/1),
+          "cuMemSetAccess");
+    }
+    if (iree_status_is_ok(status)) {
+      virtual_buffer->chunks[i] = handle;
+    } else if (handle) {
+      // Chunks committed before the failure remain committed so the caller
+      // can retry or release the buffer to clean up.
+      if (mapped) {
+        IREE_CUDA_IGNORE_ERROR(
+            virtual_buffer->symbols,
+            cuMemUnmap(chunk_ptr, virtual_buffer->chunk_size));
+      }
+      IREE_CUDA_IGNORE_ERROR(virtual_buffer->symbols, cuMemRelease(handle));
+    }
+  }
+  iree_slim_mutex_unlock(&virtual_buffer->mutex);
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+iree_status_t iree_hal_cuda_virtual_buffer_decommit_range(
+    iree_hal_buffer_t* buffer, iree_device_size_t offset,
+    iree_device_size_t length) {
+  IREE_ASSERT_ARGUMENT(buffer);
+  if (!length) return iree_ok_status();
+  iree_hal_cuda_virtual_buffer_t* virtual_buffer = NULL;
+  IREE_RETURN_IF_ERROR(
+      iree_hal_cuda_virtual_buffer_resolve(buffer, &offset, &virtual_buffer));
+  iree_hal_buffer_t* allocated_buffer =
+      iree_hal_buffer_allocated_buffer(buffer);
+  if (offset > virtual_buffer->reserved_size ||
+      length > virtual_buffer->reserved_size - offset) {
+    return iree_make_status(
+        IREE_STATUS_OUT_OF_RANGE,
+        "decommit range [%" PRIdsz ", %" PRIdsz
+        ") out of buffer bounds (%" PRIdsz ")",
+        offset, offset + length, virtual_buffer->reserved_size);
+  }
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, length);
+
+  // Only release chunks entirely covered by the range so that data sharing a
+  // chunk with the range edges survives. A range reaching the end of the
+  // buffer also covers the trailing partial chunk.
+  iree_host_size_t first_chunk = (iree_host_size_t)(iree_device_align(
+      offset, virtual_buffer->chunk_size) / virtual_buffer->chunk_size);
+  iree_host_size_t end_chunk =
+      (iree_host_size_t)((offset + length) / virtual_buffer->chunk_size);
+  if (offset + length == iree_hal_buffer_allocation_size(allocated_buffer)) {
+    end_chunk = virtual_buffer->chunk_count;
+  }
+
+  iree_status_t status = iree_ok_status();
+  iree_slim_mutex_lock(&virtual_buffer->mutex);
+  for (iree_host_size_t i = first_chunk;
+       i < end_chunk && iree_status_is_ok(status); ++i) {
+    if (!virtual_buffer->chunks[i]) continue;  // already decommitted
+    CUdeviceptr chunk_ptr =
+        virtual_buffer->base_ptr + i * virtual_buffer->chunk_size;
+    status = IREE_CURESULT_TO_STATUS(
+        virtual_buffer->symbols,
+        cuMemUnmap(chunk_ptr, virtual_buffer->chunk_size), "cuMemUnmap");
+    if (iree_status_is_ok(status)) {
+      status = IREE_CURESULT_TO_STATUS(
+          virtual_buffer->symbols, cuMemRelease(virtual_buffer->chunks[i]),
+          "cuMemRelease");
+    }
+    if (iree_status_is_ok(status)) {
+      virtual_buffer->chunks[i] = 0;
+    }
+  }
+  iree_slim_mutex_unlock(&virtual_buffer->mutex);
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
@@ -0,0 +1,68 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_HAL_DRIVERS_CUDA_VIRTUAL_BUFFER_H_
+#define IREE_HAL_DRIVERS_CUDA_VIRTUAL_BUFFER_H_
+
+#include "iree/base/api.h"
+#include "iree/hal/api.h"
+#include "iree/hal/drivers/cuda/cuda_dynamic_symbols.h"
+#include "iree/hal/drivers/cuda/cuda_headers.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+// Creates a device-local buffer spanning |allocation_size| bytes of virtual
+// address space reserved with cuMemAddressReserve. No physical memory is
+// committed at creation time: physical backing is committed and released in
+// driver-granularity chunks with iree_hal_cuda_virtual_buffer_commit_range
+// and iree_hal_cuda_virtual_buffer_decommit_range. Accessing uncommitted
+// ranges from device code is undefined behavior.
+//
+// The buffer behaves like any other device-local CUDA buffer and can be used
+// directly in command buffer bindings; only the committed portions may be
+// touched by dispatches. Mapping is not supported and |params| must specify
+// device-local memory without mapping usage.
+//
+// Requires a device reporting
+// CU_DEVICE_ATTRIBUTE_VIRTUAL_ADDRESS_MANAGEMENT_SUPPORTED.
+iree_status_t iree_hal_cuda_virtual_buffer_create(
+    iree_hal_allocator_t* device_allocator,
+    const iree_hal_cuda_dynamic_symbols_t* symbols, CUdevice device,
+    iree_hal_buffer_params_t params, iree_device_size_t allocation_size,
+    iree_allocator_t host_allocator, iree_hal_buffer_t** out_buffer);
+
+// Returns the physical commit granularity of the virtual |buffer| in bytes.
+// Commit and decommit operations act on chunks of this size (typically 2MB).
+iree_device_size_t iree_hal_cuda_virtual_buffer_granularity(
+    iree_hal_buffer_t* buffer);
+
+// Commits physical memory backing [offset, offset+length) of |buffer|.
+// The range is expanded outward to chunk granularity and chunks that are
+// already committed are left untouched, making repeated commits of growing
+// ranges cheap. On failure previously committed chunks remain committed.
+//
+// Must not be called concurrently with device execution accessing the range.
+iree_status_t iree_hal_cuda_virtual_buffer_commit_range(
+    iree_hal_buffer_t* buffer, iree_device_size_t offset,
+    iree_device_size_t length);
+
+// Decommits physical memory backing [offset, offset+length) of |buffer| and
+// returns it to the system. Only chunks entirely contained within the range
+// are decommitted so that neighboring data is preserved; a range ending at the
+// end of the buffer also releases the final (possibly partial) chunk.
+//
+// Must not be called concurrently with device execution accessing the range.
+iree_status_t iree_hal_cuda_virtual_buffer_decommit_range(
+    iree_hal_buffer_t* buffer, iree_device_size_t offset,
+    iree_device_size_t length);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // IREE_HAL_DRIVERS_CUDA_VIRTUAL_BUFFER_H_
@@ -71,6 +71,13 @@ typedef struct iree_hal_hip_device_params_t {
   // Specifies how command buffers are recorded and executed.
   iree_hal_hip_command_buffer_mode_t command_buffer_mode;
 
+  // Enables caching of instantiated executable graphs in graph command buffer
+  // mode. Re-recordings with a matching topology (the common case for
+  // repeated invocations that differ only in buffer pointers and launch
+  // parameters) are re-bound in place via hipGraphExecUpdate instead of
+  // paying milliseconds for hipGraphInstantiate on every submission.
+  bool graph_caching;
+
   // Enables tracing of command buffers when IREE tracing is enabled.
   // May take advantage of additional extensions for more accurate timing or
   // hardware-specific performance counters.
@@ -98,6 +105,30 @@ typedef struct iree_hal_hip_device_params_t {
 IREE_API_EXPORT void iree_hal_hip_device_params_initialize(
     iree_hal_hip_device_params_t* out_params);
 
+// Called when a pooled queue-ordered allocation of |allocation_size| bytes
+// fails because the pool is exhausted. Implementations should release device
+// memory they can recreate later (e.g. evictable cache blocks) and return OK
+// to have the allocation retried. Returning a non-OK status stops retrying
+// and the original allocation failure is returned to the caller; the status
+// is otherwise ignored. May be called from any thread performing queue-ordered
+// allocations and must not allocate device memory itself.
+typedef iree_status_t(IREE_API_PTR* iree_hal_hip_memory_pressure_callback_fn_t)(
+    void* user_data, iree_device_size_t allocation_size);
+
+// A callback invoked under device memory pressure and its user data.
+typedef struct iree_hal_hip_memory_pressure_callback_t {
+  iree_hal_hip_memory_pressure_callback_fn_t fn;
+  void* user_data;
+} iree_hal_hip_memory_pressure_callback_t;
+
+// Sets the memory pressure callback invoked when pooled queue-ordered
+// allocations on |device| exhaust their pool. Pass a zeroed callback to clear.
+// Only applies to devices using async allocations; synchronous allocation
+// fallbacks do not trigger the callback.
+IREE_API_EXPORT iree_status_t iree_hal_hip_device_set_memory_pressure_callback(
+    iree_hal_device_t* device,
+    iree_hal_hip_memory_pressure_callback_t callback);
+
 //===----------------------------------------------------------------------===//
 // iree_hal_hip_driver_t
 //===----------------------------------------------------------------------===//
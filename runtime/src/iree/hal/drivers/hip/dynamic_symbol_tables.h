@@ -54,6 +54,8 @@ IREE_HAL_HIP_REQUIRED_PFN_DECL(hipGraphAddMemsetNode, hipGraphNode_t *,
 IREE_HAL_HIP_REQUIRED_PFN_DECL(hipGraphCreate, hipGraph_t *, unsigned int)
 IREE_HAL_HIP_REQUIRED_PFN_DECL(hipGraphDestroy, hipGraph_t)
 IREE_HAL_HIP_REQUIRED_PFN_DECL(hipGraphExecDestroy, hipGraphExec_t)
+IREE_HAL_HIP_REQUIRED_PFN_DECL(hipGraphExecUpdate, hipGraphExec_t, hipGraph_t,
+                               hipGraphNode_t *, hipGraphExecUpdateResult *)
 IREE_HAL_HIP_REQUIRED_PFN_DECL(hipGraphInstantiate, hipGraphExec_t *,
                                hipGraph_t, hipGraphNode_t *, char *, size_t)
 IREE_HAL_HIP_REQUIRED_PFN_DECL(hipGraphLaunch, hipGraphExec_t, hipStream_t)
@@ -12,6 +12,7 @@
 
 #include "iree/base/api.h"
 #include "iree/hal/drivers/hip/dynamic_symbols.h"
+#include "iree/hal/drivers/hip/graph_exec_cache.h"
 #include "iree/hal/drivers/hip/hip_buffer.h"
 #include "iree/hal/drivers/hip/native_executable.h"
 #include "iree/hal/drivers/hip/pipeline_layout.h"
@@ -48,6 +49,13 @@ typedef struct iree_hal_hip_graph_command_buffer_t {
   hipGraph_t hip_graph;
   hipGraphExec_t hip_exec;
 
+  // Optional cache of instantiated executable graphs shared across command
+  // buffers; when present hip_exec is acquired from (and released back to)
+  // the cache instead of being instantiated and destroyed per recording.
+  iree_hal_hip_graph_exec_cache_t* exec_cache;
+  // True if hip_exec is owned by exec_cache.
+  bool hip_exec_cached;
+
   // A node acting as a barrier for all commands added to the command buffer.
   hipGraphNode_t hip_barrier_node;
 
@@ -158,7 +166,9 @@ iree_status_t iree_hal_hip_graph_command_buffer_create(
     iree_hal_command_buffer_mode_t mode,
     iree_hal_command_category_t command_categories,
     iree_hal_queue_affinity_t queue_affinity, iree_host_size_t binding_capacity,
-    iree_arena_block_pool_t* block_pool, iree_allocator_t host_allocator,
+    iree_arena_block_pool_t* block_pool,
+    iree_hal_hip_graph_exec_cache_t* exec_cache,
+    iree_allocator_t host_allocator,
     iree_hal_command_buffer_t** out_command_buffer) {
   IREE_ASSERT_ARGUMENT(device);
   IREE_ASSERT_ARGUMENT(hip_symbols);
@@ -189,6 +199,8 @@ iree_status_t iree_hal_hip_graph_command_buffer_create(
   command_buffer->hip_context = context;
   command_buffer->hip_graph = NULL;
   command_buffer->hip_exec = NULL;
+  command_buffer->exec_cache = exec_cache;
+  command_buffer->hip_exec_cached = false;
   command_buffer->hip_barrier_node = NULL;
   command_buffer->graph_node_count = 0;
 
@@ -218,8 +230,13 @@ static void iree_hal_hip_graph_command_buffer_destroy(
     command_buffer->hip_graph = NULL;
   }
   if (command_buffer->hip_exec != NULL) {
-    IREE_HIP_IGNORE_ERROR(command_buffer->symbols,
-                          hipGraphExecDestroy(command_buffer->hip_exec));
+    if (command_buffer->hip_exec_cached) {
+      iree_hal_hip_graph_exec_cache_release(command_buffer->exec_cache,
+                                            command_buffer->hip_exec);
+    } else {
+      IREE_HIP_IGNORE_ERROR(command_buffer->symbols,
+                            hipGraphExecDestroy(command_buffer->hip_exec));
+    }
     command_buffer->hip_exec = NULL;
   }
   command_buffer->hip_barrier_node = NULL;
@@ -277,14 +294,22 @@ static iree_status_t iree_hal_hip_graph_command_buffer_end(
   command_buffer->hip_barrier_node = NULL;
   command_buffer->graph_node_count = 0;
 
-  // Compile the graph.
-  hipGraphNode_t error_node = NULL;
-  iree_status_t status = IREE_HIP_RESULT_TO_STATUS(
-      command_buffer->symbols,
-      hipGraphInstantiate(&command_buffer->hip_exec, command_buffer->hip_graph,
-                          &error_node,
-                          /*logBuffer=*/NULL,
-                          /*bufferSize=*/0));
+  // Compile the graph, reusing a cached executable graph when possible.
+  iree_status_t status = iree_ok_status();
+  if (command_buffer->exec_cache) {
+    status = iree_hal_hip_graph_exec_cache_acquire(command_buffer->exec_cache,
+                                                   command_buffer->hip_graph,
+                                                   &command_buffer->hip_exec);
+    command_buffer->hip_exec_cached = iree_status_is_ok(status);
+  } else {
+    hipGraphNode_t error_node = NULL;
+    status = IREE_HIP_RESULT_TO_STATUS(
+        command_buffer->symbols,
+        hipGraphInstantiate(&command_buffer->hip_exec,
+                            command_buffer->hip_graph, &error_node,
+                            /*logBuffer=*/NULL,
+                            /*bufferSize=*/0));
+  }
   if (iree_status_is_ok(status)) {
     // No longer need the source graph used for construction.
     IREE_HIP_IGNORE_ERROR(command_buffer->symbols,
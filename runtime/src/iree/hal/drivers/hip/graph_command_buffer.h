@@ -21,10 +21,16 @@ extern "C" {
 // changes and may have outstanding issues.
 
 typedef struct iree_arena_block_pool_t iree_arena_block_pool_t;
+typedef struct iree_hal_hip_graph_exec_cache_t iree_hal_hip_graph_exec_cache_t;
 typedef struct iree_hal_hip_tracing_context_t iree_hal_hip_tracing_context_t;
 
 // Creates a command buffer that records into a HIP graph.
 //
+// An optional |exec_cache| may be provided to reuse instantiated executable
+// graphs from prior recordings: on end() a cached executable graph with a
+// matching topology is re-bound in place via hipGraphExecUpdate instead of
+// paying for hipGraphInstantiate.
+//
 // NOTE: the |block_pool| must remain live for the lifetime of the command
 // buffers that use it.
 iree_status_t iree_hal_hip_graph_command_buffer_create(
@@ -34,7 +40,9 @@ iree_status_t iree_hal_hip_graph_command_buffer_create(
     iree_hal_command_buffer_mode_t mode,
     iree_hal_command_category_t command_categories,
     iree_hal_queue_affinity_t queue_affinity, iree_host_size_t binding_capacity,
-    iree_arena_block_pool_t* block_pool, iree_allocator_t host_allocator,
+    iree_arena_block_pool_t* block_pool,
+    iree_hal_hip_graph_exec_cache_t* exec_cache,
+    iree_allocator_t host_allocator,
     iree_hal_command_buffer_t** out_command_buffer);
 
 // Returns true if |command_buffer| is a HIP graph-based command buffer.
@@ -0,0 +1,73 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_HAL_DRIVERS_HIP_GRAPH_EXEC_CACHE_H_
+#define IREE_HAL_DRIVERS_HIP_GRAPH_EXEC_CACHE_H_
+
+#include "iree/base/api.h"
+#include "iree/hal/drivers/hip/dynamic_symbols.h"
+#include "iree/hal/drivers/hip/hip_headers.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+// A small cache of instantiated executable graphs that are re-bound to new
+// parameters instead of re-instantiated when possible.
+//
+// hipGraphInstantiate costs milliseconds for large graphs while successive
+// recordings of the same program (e.g. per-token decode steps) differ only in
+// buffer pointers and launch parameters. Acquisition first tries
+// hipGraphExecUpdate against quiescent cached executable graphs - the runtime
+// verifies the topology matches and re-binds all node params in place - and
+// only falls back to hipGraphInstantiate when no compatible executable graph
+// is available.
+//
+// Cached executable graphs are only updated while quiescent (no outstanding
+// acquisition); since releases happen after the owning command buffer has
+// completed execution an in-flight launch is never updated.
+//
+// Thread-safe; multiple threads may acquire and release executable graphs.
+typedef struct iree_hal_hip_graph_exec_cache_t iree_hal_hip_graph_exec_cache_t;
+
+// Creates a cache retaining up to |capacity| executable graphs.
+iree_status_t iree_hal_hip_graph_exec_cache_create(
+    const iree_hal_hip_dynamic_symbols_t* symbols, iree_host_size_t capacity,
+    iree_allocator_t host_allocator,
+    iree_hal_hip_graph_exec_cache_t** out_cache);
+
+// Frees |cache| and destroys all retained executable graphs.
+// All acquired executable graphs must have been released back to the cache.
+void iree_hal_hip_graph_exec_cache_free(iree_hal_hip_graph_exec_cache_t* cache);
+
+// Acquires an executable graph for the recorded |graph|.
+// Reuses a cached executable graph via hipGraphExecUpdate when the topology
+// matches and otherwise instantiates (and caches) a new one. The returned
+// executable graph remains owned by the cache and must be returned with
+// iree_hal_hip_graph_exec_cache_release once no longer in use.
+iree_status_t iree_hal_hip_graph_exec_cache_acquire(
+    iree_hal_hip_graph_exec_cache_t* cache, hipGraph_t graph,
+    hipGraphExec_t* out_graph_exec);
+
+// Queries the cumulative number of acquisitions served by re-binding a cached
+// executable graph (|out_hit_count|) versus requiring a fresh instantiation
+// (|out_miss_count|). Intended for monitoring; the values may change
+// concurrently.
+void iree_hal_hip_graph_exec_cache_query_statistics(
+    iree_hal_hip_graph_exec_cache_t* cache, int64_t* out_hit_count,
+    int64_t* out_miss_count);
+
+// Releases |graph_exec| previously acquired from the cache.
+// Must only be called once all launches of the executable graph have
+// completed on the device.
+void iree_hal_hip_graph_exec_cache_release(
+    iree_hal_hip_graph_exec_cache_t* cache, hipGraphExec_t graph_exec);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // IREE_HAL_DRIVERS_HIP_GRAPH_EXEC_CACHE_H_
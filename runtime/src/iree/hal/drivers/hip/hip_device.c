@@ -11,6 +11,7 @@
 #include <string.h>
 
 #include "iree/base/internal/arena.h"
+#include "iree/base/internal/atomics.h"
 #include "iree/base/internal/event_pool.h"
 #include "iree/base/internal/math.h"
 #include "iree/base/tracing.h"
@@ -18,6 +19,7 @@
 #include "iree/hal/drivers/hip/event_pool.h"
 #include "iree/hal/drivers/hip/event_semaphore.h"
 #include "iree/hal/drivers/hip/graph_command_buffer.h"
+#include "iree/hal/drivers/hip/graph_exec_cache.h"
 #include "iree/hal/drivers/hip/hip_allocator.h"
 #include "iree/hal/drivers/hip/hip_buffer.h"
 #include "iree/hal/drivers/hip/memory_pools.h"
@@ -36,6 +38,10 @@
 // iree_hal_hip_device_t
 //===----------------------------------------------------------------------===//
 
+// Maximum number of instantiated executable graphs retained for reuse across
+// command buffer recordings when graph caching is enabled.
+#define IREE_HAL_HIP_GRAPH_EXEC_CACHE_CAPACITY 8
+
 typedef struct iree_hal_hip_device_t {
   // Abstract resource used for injecting reference counting and vtable;
   // must be at offset 0.
@@ -79,10 +85,19 @@ typedef struct iree_hal_hip_device_t {
   // and hipEvent_t objects.
   iree_hal_hip_pending_queue_actions_t* pending_queue_actions;
 
+  // Optional cache of instantiated executable graphs shared by graph command
+  // buffers; NULL when graph caching is disabled or command buffers are not
+  // in graph mode.
+  iree_hal_hip_graph_exec_cache_t* graph_exec_cache;
+
   // Device memory pools and allocators.
   bool supports_memory_pools;
   iree_hal_hip_memory_pools_t memory_pools;
   iree_hal_allocator_t* device_allocator;
+
+  // Total time the host has spent blocked in wait_semaphores, accumulated for
+  // monitoring queries.
+  iree_atomic_int64_t semaphore_wait_ns;
 } iree_hal_hip_device_t;
 
 static const iree_hal_device_vtable_t iree_hal_hip_device_vtable;
@@ -105,6 +120,7 @@ IREE_API_EXPORT void iree_hal_hip_device_params_initialize(
   out_params->event_pool_capacity = 32;
   out_params->queue_count = 1;
   out_params->command_buffer_mode = IREE_HAL_HIP_COMMAND_BUFFER_MODE_GRAPH;
+  out_params->graph_caching = true;
   out_params->stream_tracing = false;
   out_params->async_allocations = true;
   out_params->allow_inline_execution = false;
@@ -149,11 +165,21 @@ static iree_status_t iree_hal_hip_device_create_internal(
   device->hip_dispatch_stream = dispatch_stream;
   device->hip_callback_stream = callback_stream;
   device->host_allocator = host_allocator;
+  iree_atomic_store_int64(&device->semaphore_wait_ns, 0,
+                          iree_memory_order_relaxed);
 
   iree_status_t status = iree_hal_hip_pending_queue_actions_create(
       symbols, &device->block_pool, host_allocator,
       &device->pending_queue_actions);
 
+  // Reuse instantiated executable graphs across command buffer recordings.
+  if (iree_status_is_ok(status) && params->graph_caching &&
+      params->command_buffer_mode == IREE_HAL_HIP_COMMAND_BUFFER_MODE_GRAPH) {
+    status = iree_hal_hip_graph_exec_cache_create(
+        symbols, IREE_HAL_HIP_GRAPH_EXEC_CACHE_CAPACITY, host_allocator,
+        &device->graph_exec_cache);
+  }
+
   // Enable tracing for the (currently only) stream - no-op if disabled.
   if (iree_status_is_ok(status) && device->params.stream_tracing) {
     status = iree_hal_hip_tracing_context_allocate(
@@ -294,6 +320,20 @@ const iree_hal_hip_dynamic_symbols_t* iree_hal_hip_device_dynamic_symbols(
   return device->hip_symbols;
 }
 
+IREE_API_EXPORT iree_status_t iree_hal_hip_device_set_memory_pressure_callback(
+    iree_hal_device_t* base_device,
+    iree_hal_hip_memory_pressure_callback_t callback) {
+  iree_hal_hip_device_t* device = iree_hal_hip_device_cast(base_device);
+  if (!device->supports_memory_pools) {
+    return iree_make_status(
+        IREE_STATUS_FAILED_PRECONDITION,
+        "device is not using memory pools for queue-ordered allocations");
+  }
+  iree_hal_hip_memory_pools_set_pressure_callback(&device->memory_pools,
+                                                  callback);
+  return iree_ok_status();
+}
+
 static void iree_hal_hip_device_destroy(iree_hal_device_t* base_device) {
   iree_hal_hip_device_t* device = iree_hal_hip_device_cast(base_device);
   iree_allocator_t host_allocator = iree_hal_device_host_allocator(base_device);
@@ -304,6 +344,10 @@ static void iree_hal_hip_device_destroy(iree_hal_device_t* base_device) {
   iree_hal_hip_pending_queue_actions_destroy(
       (iree_hal_resource_t*)device->pending_queue_actions);
 
+  // All command buffers must have been released before the device is
+  // destroyed so the cache holds the only remaining executable graphs.
+  iree_hal_hip_graph_exec_cache_free(device->graph_exec_cache);
+
   // There should be no more buffers live that use the allocator.
   iree_hal_allocator_release(device->device_allocator);
 
@@ -410,6 +454,32 @@ static iree_status_t iree_hal_hip_device_query_i64(
     return iree_ok_status();
   }
 
+  if (iree_string_view_equal(category, IREE_SV("hal.device.stats"))) {
+    if (iree_string_view_equal(key, IREE_SV("submissions.inflight"))) {
+      *out_value =
+          (int64_t)iree_hal_hip_pending_queue_actions_outstanding_count(
+              device->pending_queue_actions);
+      return iree_ok_status();
+    } else if (iree_string_view_equal(key, IREE_SV("semaphore.wait_ns"))) {
+      *out_value = iree_atomic_load_int64(&device->semaphore_wait_ns,
+                                          iree_memory_order_relaxed);
+      return iree_ok_status();
+    } else if (iree_string_view_equal(key, IREE_SV("executable_cache.hits")) ||
+               iree_string_view_equal(key,
+                                      IREE_SV("executable_cache.misses"))) {
+      int64_t hit_count = 0;
+      int64_t miss_count = 0;
+      if (device->graph_exec_cache) {
+        iree_hal_hip_graph_exec_cache_query_statistics(
+            device->graph_exec_cache, &hit_count, &miss_count);
+      }
+      *out_value = iree_string_view_equal(key, IREE_SV("executable_cache.hits"))
+                       ? hit_count
+                       : miss_count;
+      return iree_ok_status();
+    }
+  }
+
   return iree_make_status(
       IREE_STATUS_NOT_FOUND,
       "unknown device configuration key value '%.*s :: %.*s'",
@@ -458,8 +528,8 @@ static iree_status_t iree_hal_hip_device_create_command_buffer(
       return iree_hal_hip_graph_command_buffer_create(
           base_device, device->hip_symbols, device->tracing_context,
           device->hip_context, mode, command_categories, queue_affinity,
-          binding_capacity, &device->block_pool, device->host_allocator,
-          out_command_buffer);
+          binding_capacity, &device->block_pool, device->graph_exec_cache,
+          device->host_allocator, out_command_buffer);
     case IREE_HAL_HIP_COMMAND_BUFFER_MODE_STREAM:
       return iree_hal_deferred_command_buffer_create(
           base_device, mode, command_categories, binding_capacity,
@@ -690,6 +760,28 @@ static iree_status_t iree_hal_hip_device_queue_execute(
   return status;
 }
 
+static iree_status_t iree_hal_hip_device_queue_callback(
+    iree_hal_device_t* base_device, iree_hal_queue_affinity_t queue_affinity,
+    const iree_hal_semaphore_list_t wait_semaphore_list,
+    const iree_hal_semaphore_list_t signal_semaphore_list,
+    iree_hal_queue_callback_fn_t callback, void* user_data) {
+  iree_hal_hip_device_t* device = iree_hal_hip_device_cast(base_device);
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_status_t status = iree_hal_hip_pending_queue_actions_enqueue_callback(
+      base_device, device->hip_dispatch_stream, device->hip_callback_stream,
+      device->pending_queue_actions, wait_semaphore_list, signal_semaphore_list,
+      callback, user_data);
+  if (iree_status_is_ok(status)) {
+    // Try to advance the pending workload queue.
+    status =
+        iree_hal_hip_pending_queue_actions_issue(device->pending_queue_actions);
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
 static iree_status_t iree_hal_hip_device_queue_flush(
     iree_hal_device_t* base_device, iree_hal_queue_affinity_t queue_affinity) {
   iree_hal_hip_device_t* device = iree_hal_hip_device_cast(base_device);
@@ -705,8 +797,13 @@ static iree_status_t iree_hal_hip_device_wait_semaphores(
     iree_hal_device_t* base_device, iree_hal_wait_mode_t wait_mode,
     const iree_hal_semaphore_list_t semaphore_list, iree_timeout_t timeout) {
   iree_hal_hip_device_t* device = iree_hal_hip_device_cast(base_device);
-  return iree_hal_hip_semaphore_multi_wait(semaphore_list, wait_mode, timeout,
-                                           &device->block_pool);
+  iree_time_t start_ns = iree_time_now();
+  iree_status_t status = iree_hal_hip_semaphore_multi_wait(
+      semaphore_list, wait_mode, timeout, &device->block_pool);
+  iree_atomic_fetch_add_int64(&device->semaphore_wait_ns,
+                              (int64_t)(iree_time_now() - start_ns),
+                              iree_memory_order_relaxed);
+  return status;
 }
 
 static iree_status_t iree_hal_hip_device_profiling_begin(
@@ -753,6 +850,7 @@ static const iree_hal_device_vtable_t iree_hal_hip_device_vtable = {
     .queue_read = iree_hal_hip_device_queue_read,
     .queue_write = iree_hal_hip_device_queue_write,
     .queue_execute = iree_hal_hip_device_queue_execute,
+    .queue_callback = iree_hal_hip_device_queue_callback,
     .queue_flush = iree_hal_hip_device_queue_flush,
     .wait_semaphores = iree_hal_hip_device_wait_semaphores,
     .profiling_begin = iree_hal_hip_device_profiling_begin,
@@ -35,6 +35,11 @@ typedef struct iree_hal_hip_memory_pools_t {
   const iree_hal_hip_dynamic_symbols_t* hip_symbols;
   iree_allocator_t host_allocator;
 
+  // Optional callback invoked when a pooled allocation fails due to pool
+  // exhaustion; the allocation is retried while the callback reports memory
+  // was released.
+  iree_hal_hip_memory_pressure_callback_t pressure_callback;
+
   IREE_STATISTICS(struct {
     iree_atomic_int64_t device_bytes_allocated;
     iree_atomic_int64_t device_bytes_freed;
@@ -53,6 +58,13 @@ iree_status_t iree_hal_hip_memory_pools_initialize(
 // Deinitializes the |pools| and releases the underlying HIP resources.
 void iree_hal_hip_memory_pools_deinitialize(iree_hal_hip_memory_pools_t* pools);
 
+// Sets the memory pressure |callback| invoked when a pooled allocation fails
+// due to pool exhaustion. Pass a zeroed callback to clear. Not thread-safe
+// with in-flight allocations; register during application startup.
+void iree_hal_hip_memory_pools_set_pressure_callback(
+    iree_hal_hip_memory_pools_t* pools,
+    iree_hal_hip_memory_pressure_callback_t callback);
+
 // Merges statistics information from |pools| into |statistics|.
 void iree_hal_hip_memory_pools_merge_statistics(
     iree_hal_hip_memory_pools_t* pools,
@@ -27,6 +27,10 @@ IREE_FLAG_LIST(
 IREE_FLAG(bool, hip_use_streams, true,
           "Use HIP streams (instead of graphs) for executing command buffers.");
 
+IREE_FLAG(bool, hip_graph_caching, true,
+          "Reuses instantiated HIP graphs across command buffer recordings \n"
+          "with matching topologies instead of re-instantiating each time.");
+
 IREE_FLAG(bool, hip_allow_inline_execution, false,
           "Allow command buffers to execute inline against HIP streams when \n"
           "possible.");
@@ -67,6 +71,8 @@ static const iree_string_view_t key_hip_dylib_path =
     iree_string_view_literal("hip_dylib_path");
 static const iree_string_view_t key_hip_use_streams =
     iree_string_view_literal("hip_use_streams");
+static const iree_string_view_t key_hip_graph_caching =
+    iree_string_view_literal("hip_graph_caching");
 static const iree_string_view_t key_hip_allow_inline_execution =
     iree_string_view_literal("hip_allow_inline_execution");
 static const iree_string_view_t key_hip_async_allocations =
@@ -91,6 +97,8 @@ static iree_status_t iree_hal_hip_driver_parse_flags(
   // bool and int flags
   IREE_RETURN_IF_ERROR(iree_string_pair_builder_add_int32(
       builder, key_hip_use_streams, FLAG_hip_use_streams));
+  IREE_RETURN_IF_ERROR(iree_string_pair_builder_add_int32(
+      builder, key_hip_graph_caching, FLAG_hip_graph_caching));
   IREE_RETURN_IF_ERROR(iree_string_pair_builder_add_int32(
       builder, key_hip_allow_inline_execution,
       FLAG_hip_allow_inline_execution));
@@ -156,6 +164,14 @@ static iree_status_t iree_hal_hip_driver_populate_options(
         device_params->command_buffer_mode =
             IREE_HAL_HIP_COMMAND_BUFFER_MODE_STREAM;
       }
+    } else if (iree_string_view_equal(key, key_hip_graph_caching)) {
+      if (!iree_string_view_atoi_int32(value, &ivalue)) {
+        return iree_make_status(
+            IREE_STATUS_FAILED_PRECONDITION,
+            "Option 'hip_graph_caching' expected to be int. Got: '%.*s'",
+            (int)value.size, value.data);
+      }
+      device_params->graph_caching = ivalue ? true : false;
     } else if (iree_string_view_equal(key, key_hip_allow_inline_execution)) {
       if (!iree_string_view_atoi_int32(value, &ivalue)) {
         return iree_make_status(
@@ -0,0 +1,69 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_HAL_DRIVERS_LOCAL_SYNC_STATIC_DISPATCH_H_
+#define IREE_HAL_DRIVERS_LOCAL_SYNC_STATIC_DISPATCH_H_
+
+#include "iree/hal/drivers/local_sync/sync_device.h"
+#include "iree/hal/drivers/local_sync/sync_driver.h"
+#include "iree/hal/drivers/local_sync/sync_event.h"
+#include "iree/hal/drivers/local_sync/sync_semaphore.h"
+
+// Static dispatch overrides for builds where the local_sync driver is the only
+// driver linked into the binary. HAL methods on types the driver has exactly
+// one implementation of (driver, device, semaphore, event) are dispatched
+// directly through the local_sync vtables so that LTO can inline across the
+// HAL API boundary; this matters on MCU-class targets where the indirect call
+// alone is measurable on sub-microsecond dispatches. Types with multiple
+// implementations even in a local_sync-only build (buffers, command buffers,
+// executables, etc) stay on the indirect path.
+//
+// Enable with:
+//   -DIREE_HAL_VTABLE_DISPATCH_HEADER='"iree/hal/drivers/local_sync/static_dispatch.h"'
+//
+// WARNING: dispatching an object of any other implementation of a
+// devirtualized type through this configuration is undefined behavior; this
+// must only be enabled when no other driver is linked.
+
+#define IREE_HAL_VTABLE_DISPATCH(resource, type_prefix, method_name) \
+  IREE_HAL_STATIC_DISPATCH_##type_prefix(resource, type_prefix, method_name)
+
+// Devirtualized: exactly one implementation in a local_sync-only build.
+#define IREE_HAL_STATIC_DISPATCH_iree_hal_driver(resource, type_prefix, \
+                                                 method_name)           \
+  (&iree_hal_sync_driver_vtable)->method_name
+#define IREE_HAL_STATIC_DISPATCH_iree_hal_device(resource, type_prefix, \
+                                                 method_name)           \
+  (&iree_hal_sync_device_vtable)->method_name
+#define IREE_HAL_STATIC_DISPATCH_iree_hal_semaphore(resource, type_prefix, \
+                                                    method_name)           \
+  (&iree_hal_sync_semaphore_vtable)->method_name
+#define IREE_HAL_STATIC_DISPATCH_iree_hal_event(resource, type_prefix, \
+                                                method_name)           \
+  (&iree_hal_sync_event_vtable)->method_name
+
+// Indirect: multiple implementations may be linked (heap/subspan buffers,
+// inline/deferred command buffers, per-loader executables, etc).
+#define IREE_HAL_STATIC_DISPATCH_iree_hal_allocator \
+  IREE_HAL_VTABLE_DISPATCH_INDIRECT
+#define IREE_HAL_STATIC_DISPATCH_iree_hal_buffer \
+  IREE_HAL_VTABLE_DISPATCH_INDIRECT
+#define IREE_HAL_STATIC_DISPATCH_iree_hal_channel \
+  IREE_HAL_VTABLE_DISPATCH_INDIRECT
+#define IREE_HAL_STATIC_DISPATCH_iree_hal_channel_provider \
+  IREE_HAL_VTABLE_DISPATCH_INDIRECT
+#define IREE_HAL_STATIC_DISPATCH_iree_hal_command_buffer \
+  IREE_HAL_VTABLE_DISPATCH_INDIRECT
+#define IREE_HAL_STATIC_DISPATCH_iree_hal_executable \
+  IREE_HAL_VTABLE_DISPATCH_INDIRECT
+#define IREE_HAL_STATIC_DISPATCH_iree_hal_executable_cache \
+  IREE_HAL_VTABLE_DISPATCH_INDIRECT
+#define IREE_HAL_STATIC_DISPATCH_iree_hal_file \
+  IREE_HAL_VTABLE_DISPATCH_INDIRECT
+#define IREE_HAL_STATIC_DISPATCH_iree_hal_pipeline_layout \
+  IREE_HAL_VTABLE_DISPATCH_INDIRECT
+
+#endif  // IREE_HAL_DRIVERS_LOCAL_SYNC_STATIC_DISPATCH_H_
@@ -36,6 +36,11 @@ typedef struct iree_hal_sync_device_t {
   // buffers can contain inlined data uploads).
   iree_arena_block_pool_t large_block_pool;
 
+  // Replaying a deferred command buffer revalidates every command when set.
+  // Replayed commands were validated during recording and by default we rely
+  // on that validated-once contract to skip the redundant work per submission.
+  bool revalidate_submitted_command_buffers;
+
   // Shared semaphore state used to emulate OS-level primitives. This backend
   // is intended to run on bare-metal systems where we need to perform all
   // synchronization ourselves.
@@ -45,8 +50,6 @@ typedef struct iree_hal_sync_device_t {
   iree_hal_executable_loader_t* loaders[];
 } iree_hal_sync_device_t;
 
-static const iree_hal_device_vtable_t iree_hal_sync_device_vtable;
-
 static iree_hal_sync_device_t* iree_hal_sync_device_cast(
     iree_hal_device_t* base_value) {
   IREE_HAL_ASSERT_TYPE(base_value, &iree_hal_sync_device_vtable);
@@ -100,6 +103,8 @@ iree_status_t iree_hal_sync_device_create(
     iree_hal_allocator_retain(device_allocator);
     iree_arena_block_pool_initialize(params->arena_block_size, host_allocator,
                                      &device->large_block_pool);
+    device->revalidate_submitted_command_buffers =
+        params->revalidate_submitted_command_buffers;
 
     device->loader_count = loader_count;
     for (iree_host_size_t i = 0; i < device->loader_count; ++i) {
@@ -363,12 +368,20 @@ static iree_status_t iree_hal_sync_device_apply_deferred_command_buffers(
   for (iree_host_size_t i = 0; i < command_buffer_count; ++i) {
     iree_hal_command_buffer_t* command_buffer = command_buffers[i];
     if (iree_hal_deferred_command_buffer_isa(command_buffer)) {
+      iree_hal_command_buffer_mode_t mode =
+          iree_hal_command_buffer_mode(command_buffer) |
+          IREE_HAL_COMMAND_BUFFER_MODE_ALLOW_INLINE_EXECUTION;
+      if (!device->revalidate_submitted_command_buffers) {
+        // Replayed commands were already validated against the device when the
+        // deferred command buffer was recorded; reusable command buffers that
+        // are resubmitted every step would otherwise revalidate the exact same
+        // commands on each submission.
+        mode |= IREE_HAL_COMMAND_BUFFER_MODE_UNVALIDATED;
+      }
       iree_hal_command_buffer_t* inline_command_buffer = NULL;
       IREE_RETURN_IF_ERROR(iree_hal_inline_command_buffer_initialize(
-          (iree_hal_device_t*)device,
-          iree_hal_command_buffer_mode(command_buffer) |
-              IREE_HAL_COMMAND_BUFFER_MODE_ALLOW_INLINE_EXECUTION,
-          IREE_HAL_COMMAND_CATEGORY_ANY, IREE_HAL_QUEUE_AFFINITY_ANY,
+          (iree_hal_device_t*)device, mode, IREE_HAL_COMMAND_CATEGORY_ANY,
+          IREE_HAL_QUEUE_AFFINITY_ANY,
           /*binding_capacity=*/0, device->host_allocator, storage,
           &inline_command_buffer));
       iree_status_t status = iree_hal_deferred_command_buffer_apply(
@@ -454,6 +467,28 @@ static iree_status_t iree_hal_sync_device_queue_execute(
   return iree_ok_status();
 }
 
+static iree_status_t iree_hal_sync_device_queue_callback(
+    iree_hal_device_t* base_device, iree_hal_queue_affinity_t queue_affinity,
+    const iree_hal_semaphore_list_t wait_semaphore_list,
+    const iree_hal_semaphore_list_t signal_semaphore_list,
+    iree_hal_queue_callback_fn_t callback, void* user_data) {
+  iree_hal_sync_device_t* device = iree_hal_sync_device_cast(base_device);
+
+  // Wait for semaphores to be signaled before running the callback.
+  IREE_RETURN_IF_ERROR(iree_hal_sync_semaphore_multi_wait(
+      &device->semaphore_state, IREE_HAL_WAIT_MODE_ALL, wait_semaphore_list,
+      iree_infinite_timeout()));
+
+  // Run the callback inline; everything is synchronous here.
+  callback(user_data);
+
+  // Signal all semaphores now that the callback has completed.
+  IREE_RETURN_IF_ERROR(iree_hal_sync_semaphore_multi_signal(
+      &device->semaphore_state, signal_semaphore_list));
+
+  return iree_ok_status();
+}
+
 static iree_status_t iree_hal_sync_device_queue_flush(
     iree_hal_device_t* base_device, iree_hal_queue_affinity_t queue_affinity) {
   // Currently unused; we flush as submissions are made.
@@ -494,7 +529,7 @@ static iree_status_t iree_hal_sync_device_profiling_end(
   return iree_ok_status();
 }
 
-static const iree_hal_device_vtable_t iree_hal_sync_device_vtable = {
+const iree_hal_device_vtable_t iree_hal_sync_device_vtable = {
     .destroy = iree_hal_sync_device_destroy,
     .id = iree_hal_sync_device_id,
     .host_allocator = iree_hal_sync_device_host_allocator,
@@ -519,6 +554,7 @@ static const iree_hal_device_vtable_t iree_hal_sync_device_vtable = {
     .queue_read = iree_hal_sync_device_queue_read,
     .queue_write = iree_hal_sync_device_queue_write,
     .queue_execute = iree_hal_sync_device_queue_execute,
+    .queue_callback = iree_hal_sync_device_queue_callback,
     .queue_flush = iree_hal_sync_device_queue_flush,
     .wait_semaphores = iree_hal_sync_device_wait_semaphores,
     .profiling_begin = iree_hal_sync_device_profiling_begin,
@@ -22,6 +22,15 @@ typedef struct iree_hal_sync_device_params_t {
   // Larger sizes will lower overhead and ensure the heap isn't hit for
   // transient allocations while also increasing memory consumption.
   iree_host_size_t arena_block_size;
+
+  // Re-runs full command buffer validation each time a deferred command buffer
+  // is replayed during submission. Deferred command buffers are validated as
+  // they are recorded and replaying them cannot introduce new commands so the
+  // per-submission validation is redundant; it's off by default so that
+  // steady-state loops resubmitting the same reusable command buffers don't
+  // pay for it on every submission. Enable when debugging suspected
+  // device/buffer lifetime issues that only manifest at submission time.
+  bool revalidate_submitted_command_buffers;
 } iree_hal_sync_device_params_t;
 
 // Initializes |out_params| to default values.
@@ -37,6 +46,10 @@ iree_status_t iree_hal_sync_device_create(
     iree_hal_allocator_t* device_allocator, iree_allocator_t host_allocator,
     iree_hal_device_t** out_device);
 
+// Exported for single-driver static dispatch builds (see iree/hal/detail.h
+// and iree/hal/drivers/local_sync/static_dispatch.h).
+extern const iree_hal_device_vtable_t iree_hal_sync_device_vtable;
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
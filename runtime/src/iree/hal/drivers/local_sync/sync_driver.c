@@ -23,8 +23,6 @@ typedef struct iree_hal_sync_driver_t {
   iree_hal_executable_loader_t* loaders[];
 } iree_hal_sync_driver_t;
 
-static const iree_hal_driver_vtable_t iree_hal_sync_driver_vtable;
-
 static iree_hal_sync_driver_t* iree_hal_sync_driver_cast(
     iree_hal_driver_t* base_value) {
   IREE_HAL_ASSERT_TYPE(base_value, &iree_hal_sync_driver_vtable);
@@ -147,7 +145,7 @@ static iree_status_t iree_hal_sync_driver_create_device_by_path(
       host_allocator, out_device);
 }
 
-static const iree_hal_driver_vtable_t iree_hal_sync_driver_vtable = {
+const iree_hal_driver_vtable_t iree_hal_sync_driver_vtable = {
     .destroy = iree_hal_sync_driver_destroy,
     .query_available_devices = iree_hal_sync_driver_query_available_devices,
     .dump_device_info = iree_hal_sync_driver_dump_device_info,
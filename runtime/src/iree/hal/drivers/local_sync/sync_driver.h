@@ -26,6 +26,10 @@ iree_status_t iree_hal_sync_driver_create(
     iree_hal_allocator_t* device_allocator, iree_allocator_t host_allocator,
     iree_hal_driver_t** out_driver);
 
+// Exported for single-driver static dispatch builds (see iree/hal/detail.h
+// and iree/hal/drivers/local_sync/static_dispatch.h).
+extern const iree_hal_driver_vtable_t iree_hal_sync_driver_vtable;
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
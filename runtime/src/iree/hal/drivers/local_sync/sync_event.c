@@ -13,8 +13,6 @@ typedef struct iree_hal_sync_event_t {
   iree_allocator_t host_allocator;
 } iree_hal_sync_event_t;
 
-static const iree_hal_event_vtable_t iree_hal_sync_event_vtable;
-
 static iree_hal_sync_event_t* iree_hal_sync_event_cast(
     iree_hal_event_t* base_value) {
   IREE_HAL_ASSERT_TYPE(base_value, &iree_hal_sync_event_vtable);
@@ -50,6 +48,6 @@ static void iree_hal_sync_event_destroy(iree_hal_event_t* base_event) {
   IREE_TRACE_ZONE_END(z0);
 }
 
-static const iree_hal_event_vtable_t iree_hal_sync_event_vtable = {
+const iree_hal_event_vtable_t iree_hal_sync_event_vtable = {
     .destroy = iree_hal_sync_event_destroy,
 };
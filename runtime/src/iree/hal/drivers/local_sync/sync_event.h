@@ -17,6 +17,10 @@ extern "C" {
 iree_status_t iree_hal_sync_event_create(iree_allocator_t host_allocator,
                                          iree_hal_event_t** out_event);
 
+// Exported for single-driver static dispatch builds (see iree/hal/detail.h
+// and iree/hal/drivers/local_sync/static_dispatch.h).
+extern const iree_hal_event_vtable_t iree_hal_sync_event_vtable;
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -11,6 +11,7 @@
 #include <stddef.h>
 #include <string.h>
 
+#include "iree/base/internal/atomics.h"
 #include "iree/hal/utils/semaphore_base.h"
 
 //===----------------------------------------------------------------------===//
@@ -40,22 +41,27 @@ typedef struct iree_hal_sync_semaphore_t {
   // Shared across all semaphores.
   iree_hal_sync_semaphore_state_t* shared_state;
 
-  // Guards all mutable fields. We expect low contention on semaphores and since
-  // iree_slim_mutex_t is (effectively) just a CAS this keeps things simpler
-  // than trying to make the entire structure lock-free.
+  // Guards value monotonicity checks and |failure_status|. We expect low
+  // contention on semaphores and since iree_slim_mutex_t is (effectively) just
+  // a CAS this keeps things simpler than trying to make the entire structure
+  // lock-free. |current_value| is additionally published atomically so that
+  // wait/query fast paths can avoid the lock entirely.
   iree_slim_mutex_t mutex;
 
   // Current signaled value. May be IREE_HAL_SEMAPHORE_FAILURE_VALUE to
   // indicate that the semaphore has been signaled for failure and
   // |failure_status| contains the error.
-  uint64_t current_value;
+  //
+  // Stored with release order while the mutex is held and loaded with acquire
+  // order on wait/query fast paths so that a wait on an already-signaled value
+  // is a single atomic load with no lock acquisition. The failure sentinel is
+  // only published after |failure_status| has been set.
+  iree_atomic_int64_t current_value;
 
   // OK or the status passed to iree_hal_semaphore_fail. Owned by the semaphore.
   iree_status_t failure_status;
 } iree_hal_sync_semaphore_t;
 
-static const iree_hal_semaphore_vtable_t iree_hal_sync_semaphore_vtable;
-
 static iree_hal_sync_semaphore_t* iree_hal_sync_semaphore_cast(
     iree_hal_semaphore_t* base_value) {
   IREE_HAL_ASSERT_TYPE(base_value, &iree_hal_sync_semaphore_vtable);
@@ -80,7 +86,8 @@ iree_status_t iree_hal_sync_semaphore_create(
     semaphore->shared_state = shared_state;
 
     iree_slim_mutex_initialize(&semaphore->mutex);
-    semaphore->current_value = initial_value;
+    iree_atomic_store_int64(&semaphore->current_value, (int64_t)initial_value,
+                            iree_memory_order_release);
     semaphore->failure_status = iree_ok_status();
 
     *out_semaphore = &semaphore->base;
@@ -111,14 +118,21 @@ static iree_status_t iree_hal_sync_semaphore_query(
   iree_hal_sync_semaphore_t* semaphore =
       iree_hal_sync_semaphore_cast(base_semaphore);
 
-  iree_slim_mutex_lock(&semaphore->mutex);
+  // Fast path: valid values are published with release order and can be
+  // returned without taking the mutex.
+  uint64_t current_value = (uint64_t)iree_atomic_load_int64(
+      &semaphore->current_value, iree_memory_order_acquire);
+  if (current_value < IREE_HAL_SEMAPHORE_FAILURE_VALUE) {
+    *out_value = current_value;
+    return iree_ok_status();
+  }
 
-  *out_value = semaphore->current_value;
+  // Slow path: the mutex is required to clone the failure status.
+  iree_slim_mutex_lock(&semaphore->mutex);
 
-  iree_status_t status = iree_ok_status();
-  if (*out_value >= IREE_HAL_SEMAPHORE_FAILURE_VALUE) {
-    status = iree_status_clone(semaphore->failure_status);
-  }
+  *out_value = (uint64_t)iree_atomic_load_int64(&semaphore->current_value,
+                                                iree_memory_order_relaxed);
+  iree_status_t status = iree_status_clone(semaphore->failure_status);
 
   iree_slim_mutex_unlock(&semaphore->mutex);
 
@@ -129,8 +143,9 @@ static iree_status_t iree_hal_sync_semaphore_query(
 // invalid. The semaphore mutex must be held.
 static iree_status_t iree_hal_sync_semaphore_signal_unsafe(
     iree_hal_sync_semaphore_t* semaphore, uint64_t new_value) {
-  if (new_value <= semaphore->current_value) {
-    uint64_t current_value IREE_ATTRIBUTE_UNUSED = semaphore->current_value;
+  uint64_t current_value = (uint64_t)iree_atomic_load_int64(
+      &semaphore->current_value, iree_memory_order_relaxed);
+  if (new_value <= current_value) {
     return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
                             "semaphore values must be monotonically "
                             "increasing; current_value=%" PRIu64
@@ -139,7 +154,8 @@ static iree_status_t iree_hal_sync_semaphore_signal_unsafe(
   }
 
   // Update to the new value.
-  semaphore->current_value = new_value;
+  iree_atomic_store_int64(&semaphore->current_value, (int64_t)new_value,
+                          iree_memory_order_release);
 
   return iree_ok_status();
 }
@@ -189,9 +205,13 @@ static void iree_hal_sync_semaphore_fail(iree_hal_semaphore_t* base_semaphore,
     return;
   }
 
-  // Signal to our failure sentinel value.
-  semaphore->current_value = IREE_HAL_SEMAPHORE_FAILURE_VALUE;
+  // Signal to our failure sentinel value. The status must be set before the
+  // sentinel is published so that acquire loads observing the sentinel can
+  // safely lock and clone it.
   semaphore->failure_status = status;
+  iree_atomic_store_int64(&semaphore->current_value,
+                          (int64_t)IREE_HAL_SEMAPHORE_FAILURE_VALUE,
+                          iree_memory_order_release);
 
   iree_slim_mutex_unlock(&semaphore->mutex);
 
@@ -253,11 +273,10 @@ typedef struct iree_hal_sync_semaphore_notify_state_t {
 static bool iree_hal_sync_semaphore_is_signaled(
     iree_hal_sync_semaphore_notify_state_t* state) {
   iree_hal_sync_semaphore_t* semaphore = state->semaphore;
-  iree_slim_mutex_lock(&semaphore->mutex);
-  bool is_signaled = semaphore->current_value >= state->value ||
-                     !iree_status_is_ok(semaphore->failure_status);
-  iree_slim_mutex_unlock(&semaphore->mutex);
-  return is_signaled;
+  // The failure sentinel is the maximum value and satisfies any wait.
+  return (uint64_t)iree_atomic_load_int64(&semaphore->current_value,
+                                          iree_memory_order_acquire) >=
+         state->value;
 }
 
 static iree_status_t iree_hal_sync_semaphore_wait(
@@ -266,22 +285,20 @@ static iree_status_t iree_hal_sync_semaphore_wait(
   iree_hal_sync_semaphore_t* semaphore =
       iree_hal_sync_semaphore_cast(base_semaphore);
 
-  // Try to see if we can return immediately.
-  iree_slim_mutex_lock(&semaphore->mutex);
-  if (!iree_status_is_ok(semaphore->failure_status)) {
+  // Try to see if we can return immediately; a wait on an already-signaled
+  // value is a single atomic load.
+  uint64_t current_value = (uint64_t)iree_atomic_load_int64(
+      &semaphore->current_value, iree_memory_order_acquire);
+  if (current_value >= IREE_HAL_SEMAPHORE_FAILURE_VALUE) {
     // Fastest path: failed; return an error to tell callers to query for it.
-    iree_slim_mutex_unlock(&semaphore->mutex);
     return iree_status_from_code(IREE_STATUS_ABORTED);
-  } else if (semaphore->current_value >= value) {
+  } else if (current_value >= value) {
     // Fast path: already satisfied.
-    iree_slim_mutex_unlock(&semaphore->mutex);
     return iree_ok_status();
   } else if (iree_timeout_is_immediate(timeout)) {
     // Not satisfied but a poll, so can avoid the expensive wait handle work.
-    iree_slim_mutex_unlock(&semaphore->mutex);
     return iree_status_from_code(IREE_STATUS_DEADLINE_EXCEEDED);
   }
-  iree_slim_mutex_unlock(&semaphore->mutex);
 
   // TODO(#4680): we should be checking for DEADLINE_EXCEEDED here. This is
   // easy when it's iree_timeout_is_infinite (we can just use the notification
@@ -300,15 +317,15 @@ static iree_status_t iree_hal_sync_semaphore_wait(
       (void*)&notify_state, timeout);
 
   iree_status_t status = iree_ok_status();
-  iree_slim_mutex_lock(&semaphore->mutex);
-  if (!iree_status_is_ok(semaphore->failure_status)) {
+  current_value = (uint64_t)iree_atomic_load_int64(&semaphore->current_value,
+                                                   iree_memory_order_acquire);
+  if (current_value >= IREE_HAL_SEMAPHORE_FAILURE_VALUE) {
     // Semaphore has failed.
     status = iree_status_from_code(IREE_STATUS_ABORTED);
-  } else if (semaphore->current_value < value) {
+  } else if (current_value < value) {
     // Deadline expired before the semaphore was signaled.
     status = iree_status_from_code(IREE_STATUS_DEADLINE_EXCEEDED);
   }
-  iree_slim_mutex_unlock(&semaphore->mutex);
   return status;
 }
 
@@ -319,11 +336,11 @@ static bool iree_hal_sync_semaphore_any_signaled(
   for (iree_host_size_t i = 0; i < semaphore_list->count; ++i) {
     iree_hal_sync_semaphore_t* semaphore =
         iree_hal_sync_semaphore_cast(semaphore_list->semaphores[i]);
-    iree_slim_mutex_lock(&semaphore->mutex);
-    bool is_signaled =
-        semaphore->current_value >= semaphore_list->payload_values[i] ||
-        !iree_status_is_ok(semaphore->failure_status);
-    iree_slim_mutex_unlock(&semaphore->mutex);
+    // The failure sentinel is the maximum value and satisfies any wait.
+    bool is_signaled = (uint64_t)iree_atomic_load_int64(
+                           &semaphore->current_value,
+                           iree_memory_order_acquire) >=
+                       semaphore_list->payload_values[i];
     if (is_signaled) return true;
   }
   return false;
@@ -336,11 +353,11 @@ static bool iree_hal_sync_semaphore_all_signaled(
   for (iree_host_size_t i = 0; i < semaphore_list->count; ++i) {
     iree_hal_sync_semaphore_t* semaphore =
         iree_hal_sync_semaphore_cast(semaphore_list->semaphores[i]);
-    iree_slim_mutex_lock(&semaphore->mutex);
-    bool is_signaled =
-        semaphore->current_value >= semaphore_list->payload_values[i] ||
-        !iree_status_is_ok(semaphore->failure_status);
-    iree_slim_mutex_unlock(&semaphore->mutex);
+    // The failure sentinel is the maximum value and satisfies any wait.
+    bool is_signaled = (uint64_t)iree_atomic_load_int64(
+                           &semaphore->current_value,
+                           iree_memory_order_acquire) >=
+                       semaphore_list->payload_values[i];
     if (!is_signaled) return false;
   }
   return true;
@@ -359,11 +376,9 @@ static iree_status_t iree_hal_sync_semaphore_result_from_state(
   for (iree_host_size_t i = 0; i < semaphore_list.count; ++i) {
     iree_hal_sync_semaphore_t* semaphore =
         iree_hal_sync_semaphore_cast(semaphore_list.semaphores[i]);
-    iree_slim_mutex_lock(&semaphore->mutex);
-    const uint64_t current_value = semaphore->current_value;
-    const iree_status_code_t current_status_code =
-        iree_status_code(semaphore->failure_status);
-    if (current_status_code != IREE_STATUS_OK) {
+    const uint64_t current_value = (uint64_t)iree_atomic_load_int64(
+        &semaphore->current_value, iree_memory_order_acquire);
+    if (current_value >= IREE_HAL_SEMAPHORE_FAILURE_VALUE) {
       // Semaphore has failed.
       any_failed = true;
     } else if (current_value < semaphore_list.payload_values[i]) {
@@ -373,7 +388,6 @@ static iree_status_t iree_hal_sync_semaphore_result_from_state(
       // Signaled!
       any_signaled = true;
     }
-    iree_slim_mutex_unlock(&semaphore->mutex);
   }
   if (any_failed) {
     // Always prioritize failure state.
@@ -430,7 +444,7 @@ iree_status_t iree_hal_sync_semaphore_multi_wait(
   return status;
 }
 
-static const iree_hal_semaphore_vtable_t iree_hal_sync_semaphore_vtable = {
+const iree_hal_semaphore_vtable_t iree_hal_sync_semaphore_vtable = {
     .destroy = iree_hal_sync_semaphore_destroy,
     .query = iree_hal_sync_semaphore_query,
     .signal = iree_hal_sync_semaphore_signal,
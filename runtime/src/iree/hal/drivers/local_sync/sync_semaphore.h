@@ -67,6 +67,10 @@ iree_status_t iree_hal_sync_semaphore_multi_wait(
     iree_hal_wait_mode_t wait_mode,
     const iree_hal_semaphore_list_t semaphore_list, iree_timeout_t timeout);
 
+// Exported for single-driver static dispatch builds (see iree/hal/detail.h
+// and iree/hal/drivers/local_sync/static_dispatch.h).
+extern const iree_hal_semaphore_vtable_t iree_hal_sync_semaphore_vtable;
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -11,14 +11,19 @@
 #include <string.h>
 
 #include "iree/base/internal/arena.h"
+#include "iree/base/internal/atomics.h"
 #include "iree/base/internal/cpu.h"
 #include "iree/hal/drivers/local_task/task_command_buffer.h"
 #include "iree/hal/drivers/local_task/task_event.h"
 #include "iree/hal/drivers/local_task/task_queue.h"
 #include "iree/hal/drivers/local_task/task_semaphore.h"
 #include "iree/hal/local/executable_environment.h"
+#include "iree/hal/local/inline_command_buffer.h"
+#include "iree/hal/local/local_executable.h"
 #include "iree/hal/local/local_executable_cache.h"
 #include "iree/hal/local/local_pipeline_layout.h"
+#include "iree/task/submission.h"
+#include "iree/task/task.h"
 #include "iree/hal/utils/file_transfer.h"
 #include "iree/hal/utils/memory_file.h"
 
@@ -42,6 +47,10 @@ typedef struct iree_hal_task_device_t {
   // Optional provider used for creating/configuring collective channels.
   iree_hal_channel_provider_t* channel_provider;
 
+  // Total time the host has spent blocked in wait_semaphores, accumulated for
+  // monitoring queries.
+  iree_atomic_int64_t semaphore_wait_ns;
+
   iree_host_size_t queue_count;
   iree_hal_task_queue_t queues[];
 } iree_hal_task_device_t;
@@ -129,6 +138,9 @@ iree_status_t iree_hal_task_device_create(
       iree_hal_executable_loader_retain(device->loaders[i]);
     }
 
+    iree_atomic_store_int64(&device->semaphore_wait_ns, 0,
+                            iree_memory_order_relaxed);
+
     device->queue_count = queue_count;
     for (iree_host_size_t i = 0; i < device->queue_count; ++i) {
       // TODO(benvanik): add a number to each queue ID.
@@ -242,6 +254,22 @@ static iree_status_t iree_hal_task_device_query_i64(
     return iree_ok_status();
   }
 
+  if (iree_string_view_equal(category, IREE_SV("hal.device.stats"))) {
+    if (iree_string_view_equal(key, IREE_SV("submissions.inflight"))) {
+      int64_t inflight = 0;
+      for (iree_host_size_t i = 0; i < device->queue_count; ++i) {
+        inflight += (int64_t)iree_task_scope_pending_submission_count(
+            &device->queues[i].scope);
+      }
+      *out_value = inflight;
+      return iree_ok_status();
+    } else if (iree_string_view_equal(key, IREE_SV("semaphore.wait_ns"))) {
+      *out_value = iree_atomic_load_int64(&device->semaphore_wait_ns,
+                                          iree_memory_order_relaxed);
+      return iree_ok_status();
+    }
+  }
+
   if (iree_string_view_equal(category, IREE_SV("hal.device"))) {
     if (iree_string_view_equal(key, IREE_SV("concurrency"))) {
       *out_value = (int64_t)device->queue_count;
@@ -286,6 +314,104 @@ static iree_status_t iree_hal_task_device_create_channel(
                           "collectives not implemented");
 }
 
+// State shared by all tiles of a delegated inline dispatch.
+// Lives on the delegating thread's stack; the thread blocks until the
+// dispatch completes so the lifetime is guaranteed.
+typedef struct iree_hal_task_device_delegate_dispatch_cmd_t {
+  iree_hal_local_executable_t* executable;
+  iree_host_size_t ordinal;
+  const iree_hal_executable_dispatch_state_v0_t* dispatch_state;
+  uint32_t max_concurrency;
+} iree_hal_task_device_delegate_dispatch_cmd_t;
+
+static iree_status_t iree_hal_task_device_delegate_dispatch_tile(
+    void* user_context, const iree_task_tile_context_t* tile_context,
+    iree_task_submission_t* pending_submission) {
+  const iree_hal_task_device_delegate_dispatch_cmd_t* cmd =
+      (const iree_hal_task_device_delegate_dispatch_cmd_t*)user_context;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // The incoming dispatch state was built for single-threaded execution;
+  // patch the concurrency to reflect the executor fan-out while reusing the
+  // push constants and bindings already resolved by the command buffer.
+  iree_alignas(64) iree_hal_executable_dispatch_state_v0_t dispatch_state =
+      *cmd->dispatch_state;
+  dispatch_state.max_concurrency = cmd->max_concurrency;
+
+  const iree_alignas(64)
+      iree_hal_executable_workgroup_state_v0_t workgroup_state = {
+          .workgroup_id_x = tile_context->workgroup_xyz[0],
+          .workgroup_id_y = tile_context->workgroup_xyz[1],
+          .workgroup_id_z = tile_context->workgroup_xyz[2],
+          .reserved = 0,
+          .processor_id = tile_context->processor_id,
+          .local_memory = tile_context->local_memory.data,
+          .local_memory_size = (size_t)tile_context->local_memory.data_length,
+      };
+  iree_status_t status = iree_hal_local_executable_issue_call(
+      cmd->executable, cmd->ordinal, &dispatch_state, &workgroup_state,
+      tile_context->worker_id);
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+// Executes a wide dispatch recorded into an inline command buffer across the
+// task executor and blocks until it completes. Narrow dispatches never get
+// here: the inline command buffer only routes dispatches whose workgroup
+// count meets its threshold.
+static iree_status_t iree_hal_task_device_delegate_dispatch(
+    void* user_data, iree_hal_executable_t* executable,
+    iree_host_size_t entry_point,
+    const iree_hal_executable_dispatch_state_v0_t* dispatch_state) {
+  iree_task_executor_t* executor = (iree_task_executor_t*)user_data;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Transient scope tracking just this dispatch so that waiting for idle does
+  // not synchronize with unrelated queue work.
+  iree_task_scope_t scope;
+  iree_task_scope_initialize(iree_make_cstring_view("inline-dispatch"),
+                             IREE_TASK_SCOPE_FLAG_NONE, &scope);
+
+  iree_hal_task_device_delegate_dispatch_cmd_t cmd = {
+      .executable = iree_hal_local_executable_cast(executable),
+      .ordinal = entry_point,
+      .dispatch_state = dispatch_state,
+      .max_concurrency = 1,
+  };
+  const uint32_t workgroup_size[3] = {1, 1, 1};
+  const uint32_t workgroup_count[3] = {
+      dispatch_state->workgroup_count_x,
+      dispatch_state->workgroup_count_y,
+      dispatch_state->workgroup_count_z,
+  };
+  iree_task_dispatch_t task;
+  iree_task_dispatch_initialize(
+      &scope,
+      iree_task_make_dispatch_closure(
+          iree_hal_task_device_delegate_dispatch_tile, (void*)&cmd),
+      workgroup_size, workgroup_count, &task);
+  cmd.max_concurrency =
+      iree_task_affinity_set_count_ones(task.header.affinity_set);
+
+  iree_task_submission_t submission;
+  iree_task_submission_initialize(&submission);
+  iree_task_submission_enqueue(&submission, &task.header);
+  iree_task_executor_submit(executor, &submission);
+  iree_task_executor_flush(executor);
+
+  // Block until all tiles retire; the task and cmd above live on this stack.
+  iree_status_t status =
+      iree_task_scope_wait_idle(&scope, IREE_TIME_INFINITE_FUTURE);
+  if (iree_status_is_ok(status)) {
+    status = iree_task_scope_consume_status(&scope);
+  }
+  iree_task_scope_deinitialize(&scope);
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
 static iree_status_t iree_hal_task_device_create_command_buffer(
     iree_hal_device_t* base_device, iree_hal_command_buffer_mode_t mode,
     iree_hal_command_category_t command_categories,
@@ -294,6 +420,31 @@ static iree_status_t iree_hal_task_device_create_command_buffer(
   iree_hal_task_device_t* device = iree_hal_task_device_cast(base_device);
   iree_host_size_t queue_index = iree_hal_task_device_select_queue(
       device, command_categories, queue_affinity);
+
+  // One-shot command buffers that allow inline execution run on the calling
+  // thread as they are recorded instead of being scheduled on the executor,
+  // keeping sub-millisecond models off the task system entirely. Wide
+  // dispatches are still fanned out across the executor via the delegate so
+  // large models don't fall off a cliff.
+  if (iree_all_bits_set(
+          mode, IREE_HAL_COMMAND_BUFFER_MODE_ONE_SHOT |
+                    IREE_HAL_COMMAND_BUFFER_MODE_ALLOW_INLINE_EXECUTION) &&
+      binding_capacity == 0) {
+    iree_hal_command_buffer_t* command_buffer = NULL;
+    IREE_RETURN_IF_ERROR(iree_hal_inline_command_buffer_create(
+        base_device, mode, command_categories, queue_affinity, binding_capacity,
+        device->host_allocator, &command_buffer));
+    iree_hal_inline_dispatch_delegate_t delegate = {
+        .fn = iree_hal_task_device_delegate_dispatch,
+        .user_data = device->queues[queue_index].executor,
+        .workgroup_count_threshold = 0,  // use the default
+    };
+    iree_hal_inline_command_buffer_set_dispatch_delegate(command_buffer,
+                                                         delegate);
+    *out_command_buffer = command_buffer;
+    return iree_ok_status();
+  }
+
   return iree_hal_task_command_buffer_create(
       base_device, &device->queues[queue_index].scope, mode, command_categories,
       queue_affinity, binding_capacity, &device->large_block_pool,
@@ -473,6 +624,21 @@ static iree_status_t iree_hal_task_device_queue_execute(
   return iree_hal_task_queue_submit(&device->queues[queue_index], 1, &batch);
 }
 
+static iree_status_t iree_hal_task_device_queue_callback(
+    iree_hal_device_t* base_device, iree_hal_queue_affinity_t queue_affinity,
+    const iree_hal_semaphore_list_t wait_semaphore_list,
+    const iree_hal_semaphore_list_t signal_semaphore_list,
+    iree_hal_queue_callback_fn_t callback, void* user_data) {
+  iree_hal_task_device_t* device = iree_hal_task_device_cast(base_device);
+  // NOTE: today we are not discriminating queues based on command type.
+  iree_host_size_t queue_index = iree_hal_task_device_select_queue(
+      device, IREE_HAL_COMMAND_CATEGORY_ANY, queue_affinity);
+  return iree_hal_task_queue_submit_callback(&device->queues[queue_index],
+                                             wait_semaphore_list,
+                                             signal_semaphore_list, callback,
+                                             user_data);
+}
+
 static iree_status_t iree_hal_task_device_queue_flush(
     iree_hal_device_t* base_device, iree_hal_queue_affinity_t queue_affinity) {
   // Currently unused; we flush as submissions are made.
@@ -483,10 +649,15 @@ static iree_status_t iree_hal_task_device_wait_semaphores(
     iree_hal_device_t* base_device, iree_hal_wait_mode_t wait_mode,
     const iree_hal_semaphore_list_t semaphore_list, iree_timeout_t timeout) {
   iree_hal_task_device_t* device = iree_hal_task_device_cast(base_device);
-  return iree_hal_task_semaphore_multi_wait(
+  iree_time_t start_ns = iree_time_now();
+  iree_status_t status = iree_hal_task_semaphore_multi_wait(
       wait_mode, semaphore_list, timeout,
       iree_hal_task_device_shared_event_pool(device),
       &device->large_block_pool);
+  iree_atomic_fetch_add_int64(&device->semaphore_wait_ns,
+                              (int64_t)(iree_time_now() - start_ns),
+                              iree_memory_order_relaxed);
+  return status;
 }
 
 static iree_status_t iree_hal_task_device_profiling_begin(
@@ -540,6 +711,7 @@ static const iree_hal_device_vtable_t iree_hal_task_device_vtable = {
     .queue_read = iree_hal_task_device_queue_read,
     .queue_write = iree_hal_task_device_queue_write,
     .queue_execute = iree_hal_task_device_queue_execute,
+    .queue_callback = iree_hal_task_device_queue_callback,
     .queue_flush = iree_hal_task_device_queue_flush,
     .wait_semaphores = iree_hal_task_device_wait_semaphores,
     .profiling_begin = iree_hal_task_device_profiling_begin,
@@ -11,6 +11,7 @@
 
 #include "iree/hal/drivers/local_task/task_command_buffer.h"
 #include "iree/hal/drivers/local_task/task_semaphore.h"
+#include "iree/hal/local/inline_command_buffer.h"
 #include "iree/task/submission.h"
 
 // Each submission is turned into a DAG for execution:
@@ -89,6 +90,49 @@ static void iree_hal_semaphore_list_release(iree_hal_semaphore_list_t* list) {
   }
 }
 
+//===----------------------------------------------------------------------===//
+// Submission fence ring
+//===----------------------------------------------------------------------===//
+
+// Returns a ring fence slot to its queue once the fence retires.
+// Runs on an executor worker; release ordering publishes the retired fence
+// state to the next submitter that claims the slot.
+static void iree_hal_task_queue_fence_slot_cleanup(
+    iree_task_t* task, iree_status_code_t status_code) {
+  iree_hal_task_queue_fence_slot_t* slot =
+      (iree_hal_task_queue_fence_slot_t*)((uint8_t*)task -
+                                          offsetof(
+                                              iree_hal_task_queue_fence_slot_t,
+                                              fence));
+  iree_atomic_store_int32(&slot->busy, 0, iree_memory_order_release);
+}
+
+// Acquires a fence for a submission, preferring a pre-built slot from the
+// per-queue ring and only falling back to the executor transient task pool
+// when all ring slots have submissions still in flight.
+static iree_status_t iree_hal_task_queue_acquire_fence(
+    iree_hal_task_queue_t* queue, iree_task_fence_t** out_fence) {
+  *out_fence = NULL;
+  for (iree_host_size_t i = 0; i < IREE_HAL_TASK_QUEUE_FENCE_RING_SIZE; ++i) {
+    iree_hal_task_queue_fence_slot_t* slot = &queue->fence_ring[i];
+    int32_t expected = 0;
+    if (iree_atomic_compare_exchange_strong_int32(
+            &slot->busy, &expected, 1, iree_memory_order_acq_rel,
+            iree_memory_order_relaxed)) {
+      // NOTE: ring fences have no pool and are recycled by the cleanup
+      // releasing the slot after the task system is done with the task.
+      iree_task_fence_initialize(&queue->scope, iree_wait_primitive_immediate(),
+                                 &slot->fence);
+      iree_task_set_cleanup_fn(&slot->fence.header,
+                               iree_hal_task_queue_fence_slot_cleanup);
+      *out_fence = &slot->fence;
+      return iree_ok_status();
+    }
+  }
+  return iree_task_executor_acquire_fence(queue->executor, &queue->scope,
+                                          out_fence);
+}
+
 //===----------------------------------------------------------------------===//
 // iree_hal_task_queue_wait_cmd_t
 //===----------------------------------------------------------------------===//
@@ -208,6 +252,12 @@ static iree_status_t iree_hal_task_queue_issue_cmd(
           cmd->task.header.completion_task, cmd->arena, pending_submission);
       iree_hal_command_buffer_release(cmd->command_buffers[i]);
       cmd->command_buffers[i] = NULL;
+    } else if (iree_hal_inline_command_buffer_isa(cmd->command_buffers[i])) {
+      // Inline command buffers execute against the calling thread as they are
+      // recorded and have fully completed by the time they are submitted;
+      // there's no work left to issue here.
+      iree_hal_command_buffer_release(cmd->command_buffers[i]);
+      cmd->command_buffers[i] = NULL;
     } else {
       status = iree_make_status(
           IREE_STATUS_UNIMPLEMENTED,
@@ -268,6 +318,55 @@ static iree_status_t iree_hal_task_queue_issue_cmd_allocate(
   return iree_ok_status();
 }
 
+//===----------------------------------------------------------------------===//
+// iree_hal_task_queue_callback_cmd_t
+//===----------------------------------------------------------------------===//
+
+// Task to invoke a user-provided host callback in queue order.
+// The callback runs on a worker thread after all waits in the submission have
+// been satisfied and before the submission retires and signals.
+typedef struct iree_hal_task_queue_callback_cmd_t {
+  // Call to iree_hal_task_queue_callback_cmd.
+  iree_task_call_t task;
+
+  // User callback and data invoked when the task executes.
+  iree_hal_queue_callback_fn_t callback;
+  void* user_data;
+} iree_hal_task_queue_callback_cmd_t;
+
+// Invokes the user callback.
+static iree_status_t iree_hal_task_queue_callback_cmd(
+    void* user_context, iree_task_t* task,
+    iree_task_submission_t* pending_submission) {
+  iree_hal_task_queue_callback_cmd_t* cmd =
+      (iree_hal_task_queue_callback_cmd_t*)task;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  cmd->callback(cmd->user_data);
+
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
+// Allocates and initializes a iree_hal_task_queue_callback_cmd_t task.
+static iree_status_t iree_hal_task_queue_callback_cmd_allocate(
+    iree_task_scope_t* scope, iree_task_t* retire_task,
+    iree_hal_queue_callback_fn_t callback, void* user_data,
+    iree_arena_allocator_t* arena,
+    iree_hal_task_queue_callback_cmd_t** out_cmd) {
+  iree_hal_task_queue_callback_cmd_t* cmd = NULL;
+  IREE_RETURN_IF_ERROR(iree_arena_allocate(arena, sizeof(*cmd), (void**)&cmd));
+  iree_task_call_initialize(
+      scope, iree_task_make_call_closure(iree_hal_task_queue_callback_cmd, 0),
+      &cmd->task);
+  iree_task_set_completion_task(&cmd->task.header, retire_task);
+  cmd->callback = callback;
+  cmd->user_data = user_data;
+
+  *out_cmd = cmd;
+  return iree_ok_status();
+}
+
 //===----------------------------------------------------------------------===//
 // iree_hal_task_queue_retire_cmd_t
 //===----------------------------------------------------------------------===//
@@ -312,16 +411,13 @@ static iree_status_t iree_hal_task_queue_retire_cmd(
     cmd->resources[i] = NULL;
   }
 
-  // Signal all semaphores to their new values.
+  // Signal all semaphores to their new values in one batched pass; each
+  // semaphore lock is taken exactly once and timepoint notification happens
+  // after all values have been published.
   // Note that if any signal fails then the whole command will fail and all
   // semaphores will be signaled to the failure state.
-  iree_status_t status = iree_ok_status();
-  for (iree_host_size_t i = 0; i < cmd->signal_semaphores.count; ++i) {
-    status =
-        iree_hal_semaphore_signal(cmd->signal_semaphores.semaphores[i],
-                                  cmd->signal_semaphores.payload_values[i]);
-    if (IREE_UNLIKELY(!iree_status_is_ok(status))) break;
-  }
+  iree_status_t status =
+      iree_hal_task_semaphore_multi_signal(cmd->signal_semaphores);
 
   IREE_TRACE_ZONE_END(z0);
   return status;
@@ -476,8 +572,7 @@ static iree_status_t iree_hal_task_queue_submit_batch(
   // A fence we'll use to detect when the entire submission has completed.
   // TODO(benvanik): fold into the retire command.
   iree_task_fence_t* fence = NULL;
-  status =
-      iree_task_executor_acquire_fence(queue->executor, &queue->scope, &fence);
+  status = iree_hal_task_queue_acquire_fence(queue, &fence);
   iree_task_set_completion_task(&retire_cmd->task.header, &fence->header);
 
   // Task to fork and wait for unsatisfied semaphore dependencies.
@@ -527,6 +622,74 @@ static iree_status_t iree_hal_task_queue_submit_batch(
   return iree_ok_status();
 }
 
+iree_status_t iree_hal_task_queue_submit_callback(
+    iree_hal_task_queue_t* queue,
+    const iree_hal_semaphore_list_t wait_semaphores,
+    const iree_hal_semaphore_list_t signal_semaphores,
+    iree_hal_queue_callback_fn_t callback, void* user_data) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Task to retire the submission and free the transient memory allocated for
+  // it (including the command itself). We allocate this first so it can get an
+  // arena which we will use to allocate all other commands.
+  iree_hal_task_queue_retire_cmd_t* retire_cmd = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_hal_task_queue_retire_cmd_allocate(
+              &queue->scope, /*resource_count=*/0, /*resources=*/NULL,
+              &signal_semaphores, queue->block_pool, &retire_cmd));
+
+  // NOTE: if we fail from here on we must drop the retire_cmd arena.
+  iree_status_t status = iree_ok_status();
+
+  // A fence we'll use to detect when the entire submission has completed.
+  // TODO(benvanik): fold into the retire command.
+  iree_task_fence_t* fence = NULL;
+  status = iree_hal_task_queue_acquire_fence(queue, &fence);
+  iree_task_set_completion_task(&retire_cmd->task.header, &fence->header);
+
+  // Task to fork and wait for unsatisfied semaphore dependencies.
+  iree_hal_task_queue_wait_cmd_t* wait_cmd = NULL;
+  if (iree_status_is_ok(status) && wait_semaphores.count > 0) {
+    status = iree_hal_task_queue_wait_cmd_allocate(
+        &queue->scope, &wait_semaphores, &retire_cmd->arena, &wait_cmd);
+  }
+
+  // Task to invoke the user callback once all waits have been satisfied.
+  iree_hal_task_queue_callback_cmd_t* callback_cmd = NULL;
+  if (iree_status_is_ok(status)) {
+    status = iree_hal_task_queue_callback_cmd_allocate(
+        &queue->scope, &retire_cmd->task.header, callback, user_data,
+        &retire_cmd->arena, &callback_cmd);
+  }
+
+  // Last chance for failure - from here on we are submitting.
+  if (IREE_UNLIKELY(!iree_status_is_ok(status))) {
+    iree_arena_deinitialize(&retire_cmd->arena);
+    IREE_TRACE_ZONE_END(z0);
+    return status;
+  }
+
+  iree_task_submission_t submission;
+  iree_task_submission_initialize(&submission);
+
+  // Sequencing: wait on semaphores or go directly into the executor queue.
+  if (wait_cmd != NULL) {
+    // Ensure that we only run the callback after all waits have completed.
+    iree_task_set_completion_task(&wait_cmd->task.header,
+                                  &callback_cmd->task.header);
+    iree_task_submission_enqueue(&submission, &wait_cmd->task.header);
+  } else {
+    // No waits needed; directly enqueue.
+    iree_task_submission_enqueue(&submission, &callback_cmd->task.header);
+  }
+
+  iree_task_executor_submit(queue->executor, &submission);
+  iree_task_executor_flush(queue->executor);
+
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
 static iree_status_t iree_hal_task_queue_submit_batches(
     iree_hal_task_queue_t* queue, iree_host_size_t batch_count,
     const iree_hal_submission_batch_t* batches) {
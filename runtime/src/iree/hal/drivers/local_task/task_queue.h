@@ -22,6 +22,22 @@
 extern "C" {
 #endif  // __cplusplus
 
+// Number of pre-built submission fences recycled per queue.
+// Submissions beyond this many concurrently in-flight fall back to acquiring
+// transient fences from the shared executor task pool.
+#define IREE_HAL_TASK_QUEUE_FENCE_RING_SIZE 8
+
+// A recycled fence slot in the per-queue submission ring. Slots are claimed
+// during submission and returned by the fence cleanup once the submission
+// retires so that the steady-state submit path performs no task pool
+// operations.
+typedef struct iree_hal_task_queue_fence_slot_t {
+  // 1 while the fence is owned by an in-flight submission.
+  iree_atomic_int32_t busy;
+  // Fence task patched with the queue scope on each reuse.
+  iree_task_fence_t fence;
+} iree_hal_task_queue_fence_slot_t;
+
 typedef struct iree_hal_task_queue_t {
   // Shared executor that the queue submits tasks to.
   iree_task_executor_t* executor;
@@ -37,6 +53,10 @@ typedef struct iree_hal_task_queue_t {
   // The intra-queue synchronization (barriers/events) carries across command
   // buffers and this is used to rendezvous the tasks in each set.
   iree_hal_task_queue_state_t state;
+
+  // Ring of recycled submission fences; see
+  // iree_hal_task_queue_fence_slot_t.
+  iree_hal_task_queue_fence_slot_t fence_ring[IREE_HAL_TASK_QUEUE_FENCE_RING_SIZE];
 } iree_hal_task_queue_t;
 
 void iree_hal_task_queue_initialize(iree_string_view_t identifier,
@@ -53,6 +73,16 @@ iree_status_t iree_hal_task_queue_submit(
     iree_hal_task_queue_t* queue, iree_host_size_t batch_count,
     const iree_hal_submission_batch_t* batches);
 
+// Submits a queue-ordered host |callback| that runs after |wait_semaphores|
+// have been reached; |signal_semaphores| are signaled once it returns.
+// The callback executes on an executor worker as a task continuation and must
+// not block.
+iree_status_t iree_hal_task_queue_submit_callback(
+    iree_hal_task_queue_t* queue,
+    const iree_hal_semaphore_list_t wait_semaphores,
+    const iree_hal_semaphore_list_t signal_semaphores,
+    iree_hal_queue_callback_fn_t callback, void* user_data);
+
 iree_status_t iree_hal_task_queue_wait_idle(iree_hal_task_queue_t* queue,
                                             iree_timeout_t timeout);
 
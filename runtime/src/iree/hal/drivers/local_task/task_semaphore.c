@@ -11,6 +11,7 @@
 #include <stddef.h>
 #include <string.h>
 
+#include "iree/base/internal/atomics.h"
 #include "iree/base/internal/synchronization.h"
 #include "iree/base/internal/wait_handle.h"
 #include "iree/hal/utils/semaphore_base.h"
@@ -42,6 +43,15 @@ static iree_status_t iree_hal_task_semaphore_timepoint_callback(
   return iree_ok_status();
 }
 
+// A timepoint whose event has been exported as a native wait primitive for an
+// external reactor (epoll set, etc). The semaphore owns the record: the event
+// must stay allocated and open until the semaphore is destroyed as the reactor
+// may keep polling the handle long after the timepoint is reached.
+typedef struct iree_hal_task_semaphore_exported_timepoint_t {
+  struct iree_hal_task_semaphore_exported_timepoint_t* next;
+  iree_hal_task_timepoint_t timepoint;
+} iree_hal_task_semaphore_exported_timepoint_t;
+
 //===----------------------------------------------------------------------===//
 // iree_hal_task_semaphore_t
 //===----------------------------------------------------------------------===//
@@ -51,18 +61,30 @@ typedef struct iree_hal_task_semaphore_t {
   iree_allocator_t host_allocator;
   iree_event_pool_t* event_pool;
 
-  // Guards all mutable fields. We expect low contention on semaphores and since
+  // Guards value monotonicity checks, timepoint acquisition, and
+  // |failure_status|. We expect low contention on semaphores and since
   // iree_slim_mutex_t is (effectively) just a CAS this keeps things simpler
-  // than trying to make the entire structure lock-free.
+  // than trying to make the entire structure lock-free. |current_value| is
+  // additionally published atomically so that wait/query fast paths can avoid
+  // the lock entirely.
   iree_slim_mutex_t mutex;
 
   // Current signaled value. May be IREE_HAL_SEMAPHORE_FAILURE_VALUE to
   // indicate that the semaphore has been signaled for failure and
   // |failure_status| contains the error.
-  uint64_t current_value;
+  //
+  // Stored with release order while the mutex is held and loaded with acquire
+  // order on wait/query fast paths so that a wait on an already-signaled value
+  // is a single atomic load with no lock acquisition. The failure sentinel is
+  // only published after |failure_status| has been set.
+  iree_atomic_int64_t current_value;
 
   // OK or the status passed to iree_hal_semaphore_fail. Owned by the semaphore.
   iree_status_t failure_status;
+
+  // Timepoints exported as native wait primitives, kept live until the
+  // semaphore is destroyed. Guarded by |mutex|.
+  iree_hal_task_semaphore_exported_timepoint_t* exported_head;
 } iree_hal_task_semaphore_t;
 
 static const iree_hal_semaphore_vtable_t iree_hal_task_semaphore_vtable;
@@ -91,8 +113,10 @@ iree_status_t iree_hal_task_semaphore_create(
     semaphore->event_pool = event_pool;
 
     iree_slim_mutex_initialize(&semaphore->mutex);
-    semaphore->current_value = initial_value;
+    iree_atomic_store_int64(&semaphore->current_value, (int64_t)initial_value,
+                            iree_memory_order_release);
     semaphore->failure_status = iree_ok_status();
+    semaphore->exported_head = NULL;
 
     *out_semaphore = &semaphore->base;
   }
@@ -108,6 +132,21 @@ static void iree_hal_task_semaphore_destroy(
   iree_allocator_t host_allocator = semaphore->host_allocator;
   IREE_TRACE_ZONE_BEGIN(z0);
 
+  // Reclaim exported timepoint events; external reactors must have stopped
+  // polling the handles by now as they are documented to only remain valid for
+  // the lifetime of the semaphore.
+  iree_hal_task_semaphore_exported_timepoint_t* exported =
+      semaphore->exported_head;
+  while (exported) {
+    iree_hal_task_semaphore_exported_timepoint_t* next = exported->next;
+    iree_hal_semaphore_cancel_timepoint(&semaphore->base,
+                                        &exported->timepoint.base);
+    iree_event_pool_release(semaphore->event_pool, 1,
+                            &exported->timepoint.event);
+    iree_allocator_free(host_allocator, exported);
+    exported = next;
+  }
+
   iree_slim_mutex_deinitialize(&semaphore->mutex);
   iree_status_ignore(semaphore->failure_status);
 
@@ -127,14 +166,21 @@ static iree_status_t iree_hal_task_semaphore_query(
   iree_hal_task_semaphore_t* semaphore =
       iree_hal_task_semaphore_cast(base_semaphore);
 
-  iree_slim_mutex_lock(&semaphore->mutex);
+  // Fast path: valid values are published with release order and can be
+  // returned without taking the mutex.
+  uint64_t current_value = (uint64_t)iree_atomic_load_int64(
+      &semaphore->current_value, iree_memory_order_acquire);
+  if (current_value < IREE_HAL_SEMAPHORE_FAILURE_VALUE) {
+    *out_value = current_value;
+    return iree_ok_status();
+  }
 
-  *out_value = semaphore->current_value;
+  // Slow path: the mutex is required to clone the failure status.
+  iree_slim_mutex_lock(&semaphore->mutex);
 
-  iree_status_t status = iree_ok_status();
-  if (*out_value >= IREE_HAL_SEMAPHORE_FAILURE_VALUE) {
-    status = iree_status_clone(semaphore->failure_status);
-  }
+  *out_value = (uint64_t)iree_atomic_load_int64(&semaphore->current_value,
+                                                iree_memory_order_relaxed);
+  iree_status_t status = iree_status_clone(semaphore->failure_status);
 
   iree_slim_mutex_unlock(&semaphore->mutex);
 
@@ -148,8 +194,9 @@ static iree_status_t iree_hal_task_semaphore_signal(
 
   iree_slim_mutex_lock(&semaphore->mutex);
 
-  if (new_value <= semaphore->current_value) {
-    uint64_t current_value IREE_ATTRIBUTE_UNUSED = semaphore->current_value;
+  uint64_t current_value = (uint64_t)iree_atomic_load_int64(
+      &semaphore->current_value, iree_memory_order_relaxed);
+  if (new_value <= current_value) {
     iree_slim_mutex_unlock(&semaphore->mutex);
     return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
                             "semaphore values must be monotonically "
@@ -158,7 +205,8 @@ static iree_status_t iree_hal_task_semaphore_signal(
                             current_value, new_value);
   }
 
-  semaphore->current_value = new_value;
+  iree_atomic_store_int64(&semaphore->current_value, (int64_t)new_value,
+                          iree_memory_order_release);
 
   iree_slim_mutex_unlock(&semaphore->mutex);
 
@@ -168,6 +216,56 @@ static iree_status_t iree_hal_task_semaphore_signal(
   return iree_ok_status();
 }
 
+iree_status_t iree_hal_task_semaphore_multi_signal(
+    const iree_hal_semaphore_list_t semaphore_list) {
+  if (semaphore_list.count == 0) {
+    return iree_ok_status();
+  } else if (semaphore_list.count == 1) {
+    // Fast-path for a single semaphore.
+    return iree_hal_semaphore_signal(semaphore_list.semaphores[0],
+                                     semaphore_list.payload_values[0]);
+  }
+
+  // Publish all new payload values first, taking each semaphore lock exactly
+  // once. Waiters polling the atomic values observe the whole batch without
+  // interleaved notification work extending the lock hold times.
+  iree_status_t status = iree_ok_status();
+  iree_host_size_t signaled_count = 0;
+  for (iree_host_size_t i = 0; i < semaphore_list.count; ++i) {
+    iree_hal_task_semaphore_t* semaphore =
+        iree_hal_task_semaphore_cast(semaphore_list.semaphores[i]);
+    const uint64_t new_value = semaphore_list.payload_values[i];
+
+    iree_slim_mutex_lock(&semaphore->mutex);
+    uint64_t current_value = (uint64_t)iree_atomic_load_int64(
+        &semaphore->current_value, iree_memory_order_relaxed);
+    if (new_value <= current_value) {
+      iree_slim_mutex_unlock(&semaphore->mutex);
+      status = iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                                "semaphore values must be monotonically "
+                                "increasing; current_value=%" PRIu64
+                                ", new_value=%" PRIu64,
+                                current_value, new_value);
+      break;
+    }
+    iree_atomic_store_int64(&semaphore->current_value, (int64_t)new_value,
+                            iree_memory_order_release);
+    iree_slim_mutex_unlock(&semaphore->mutex);
+
+    ++signaled_count;
+  }
+
+  // One notification pass over everything that was signaled, outside all
+  // semaphore locks. Even on failure the values already published must be
+  // notified as waiters may otherwise never observe them.
+  for (iree_host_size_t i = 0; i < signaled_count; ++i) {
+    iree_hal_semaphore_notify(semaphore_list.semaphores[i],
+                              semaphore_list.payload_values[i], IREE_STATUS_OK);
+  }
+
+  return status;
+}
+
 static void iree_hal_task_semaphore_fail(iree_hal_semaphore_t* base_semaphore,
                                          iree_status_t status) {
   iree_hal_task_semaphore_t* semaphore =
@@ -185,9 +283,13 @@ static void iree_hal_task_semaphore_fail(iree_hal_semaphore_t* base_semaphore,
     return;
   }
 
-  // Signal to our failure sentinel value.
-  semaphore->current_value = IREE_HAL_SEMAPHORE_FAILURE_VALUE;
+  // Signal to our failure sentinel value. The status must be set before the
+  // sentinel is published so that acquire loads observing the sentinel can
+  // safely lock and clone it.
   semaphore->failure_status = status;
+  iree_atomic_store_int64(&semaphore->current_value,
+                          (int64_t)IREE_HAL_SEMAPHORE_FAILURE_VALUE,
+                          iree_memory_order_release);
 
   iree_slim_mutex_unlock(&semaphore->mutex);
 
@@ -247,7 +349,9 @@ iree_status_t iree_hal_task_semaphore_enqueue_timepoint(
   iree_slim_mutex_lock(&semaphore->mutex);
 
   iree_status_t status = iree_ok_status();
-  if (semaphore->current_value >= minimum_value) {
+  if ((uint64_t)iree_atomic_load_int64(&semaphore->current_value,
+                                       iree_memory_order_relaxed) >=
+      minimum_value) {
     // Fast path: already satisfied.
   } else if (!iree_status_is_ok(semaphore->failure_status)) {
     // Semaphore failed; can't enqueue timepoints (they'll reject immediately).
@@ -283,22 +387,35 @@ static iree_status_t iree_hal_task_semaphore_wait(
   iree_hal_task_semaphore_t* semaphore =
       iree_hal_task_semaphore_cast(base_semaphore);
 
-  iree_slim_mutex_lock(&semaphore->mutex);
-
-  if (!iree_status_is_ok(semaphore->failure_status)) {
+  // Try to see if we can return immediately; a wait on an already-signaled
+  // value is a single atomic load.
+  uint64_t current_value = (uint64_t)iree_atomic_load_int64(
+      &semaphore->current_value, iree_memory_order_acquire);
+  if (current_value >= IREE_HAL_SEMAPHORE_FAILURE_VALUE) {
     // Fastest path: failed; return an error to tell callers to query for it.
-    iree_slim_mutex_unlock(&semaphore->mutex);
     return iree_status_from_code(IREE_STATUS_ABORTED);
-  } else if (semaphore->current_value >= value) {
+  } else if (current_value >= value) {
     // Fast path: already satisfied.
-    iree_slim_mutex_unlock(&semaphore->mutex);
     return iree_ok_status();
   } else if (iree_timeout_is_immediate(timeout)) {
     // Not satisfied but a poll, so can avoid the expensive wait handle work.
-    iree_slim_mutex_unlock(&semaphore->mutex);
     return iree_status_from_code(IREE_STATUS_DEADLINE_EXCEEDED);
   }
 
+  iree_slim_mutex_lock(&semaphore->mutex);
+
+  // Re-check under the mutex: a signal may have raced with the fast path above
+  // and timepoints registered after its notification would never resolve.
+  current_value = (uint64_t)iree_atomic_load_int64(&semaphore->current_value,
+                                                   iree_memory_order_relaxed);
+  if (current_value >= IREE_HAL_SEMAPHORE_FAILURE_VALUE) {
+    iree_slim_mutex_unlock(&semaphore->mutex);
+    return iree_status_from_code(IREE_STATUS_ABORTED);
+  } else if (current_value >= value) {
+    iree_slim_mutex_unlock(&semaphore->mutex);
+    return iree_ok_status();
+  }
+
   iree_time_t deadline_ns = iree_timeout_as_deadline_ns(timeout);
 
   // Slow path: acquire a timepoint while we hold the lock.
@@ -312,7 +429,13 @@ static iree_status_t iree_hal_task_semaphore_wait(
   // Wait until the timepoint resolves.
   // If satisfied the timepoint is automatically cleaned up and we are done. If
   // the deadline is reached before satisfied then we have to clean it up.
+  // The dedicated zone makes host blocking attributable in captures: the
+  // blocked duration against the awaited payload value can be checked against
+  // the compiler's exported timepoint graph to find over-serialization.
+  IREE_TRACE_ZONE_BEGIN_NAMED(z0, "iree_hal_task_semaphore_wait_blocked");
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, (int64_t)value);
   status = iree_wait_one(&timepoint.event, deadline_ns);
+  IREE_TRACE_ZONE_END(z0);
   if (!iree_status_is_ok(status)) {
     iree_hal_semaphore_cancel_timepoint(&semaphore->base, &timepoint.base);
   }
@@ -344,24 +467,36 @@ iree_status_t iree_hal_task_semaphore_multi_wait(
   iree_status_t status = iree_wait_set_allocate(
       semaphore_list.count, iree_arena_allocator(&arena), &wait_set);
 
-  // Acquire a wait handle for each semaphore timepoint we are to wait on.
-  // TODO(benvanik): flip this API around so we can batch request events from
-  // the event pool. We should be acquiring all required time points in one
-  // call.
+  // Batch-acquire one event per semaphore from the pool up-front so the pool
+  // lock is only taken once. Not all events may be needed if some semaphores
+  // are already satisfied; they are all returned in a single release below.
+  iree_event_t* events = NULL;
+  iree_host_size_t event_count = 0;
+  status = iree_arena_allocate(
+      &arena, semaphore_list.count * sizeof(events[0]), (void**)&events);
+  if (iree_status_is_ok(status)) {
+    status = iree_event_pool_acquire(event_pool, semaphore_list.count, events);
+    if (iree_status_is_ok(status)) event_count = semaphore_list.count;
+  }
+
   iree_host_size_t timepoint_count = 0;
   iree_hal_task_timepoint_t* timepoints = NULL;
   iree_host_size_t total_timepoint_size =
       semaphore_list.count * sizeof(timepoints[0]);
   bool needs_wait = true;
-  status =
-      iree_arena_allocate(&arena, total_timepoint_size, (void**)&timepoints);
+  if (iree_status_is_ok(status)) {
+    status =
+        iree_arena_allocate(&arena, total_timepoint_size, (void**)&timepoints);
+  }
   if (iree_status_is_ok(status)) {
     memset(timepoints, 0, total_timepoint_size);
     for (iree_host_size_t i = 0; i < semaphore_list.count && needs_wait; ++i) {
       iree_hal_task_semaphore_t* semaphore =
           iree_hal_task_semaphore_cast(semaphore_list.semaphores[i]);
       iree_slim_mutex_lock(&semaphore->mutex);
-      if (semaphore->current_value >= semaphore_list.payload_values[i]) {
+      if ((uint64_t)iree_atomic_load_int64(&semaphore->current_value,
+                                           iree_memory_order_relaxed) >=
+          semaphore_list.payload_values[i]) {
         // Fast path: already satisfied.
         // If in ANY wait mode, this is sufficient and we don't actually need
         // to wait. This also skips acquiring timepoints for any remaining
@@ -371,13 +506,19 @@ iree_status_t iree_hal_task_semaphore_multi_wait(
           needs_wait = false;
         }
       } else {
-        // Slow path: get a native wait handle for the timepoint.
-        iree_hal_task_timepoint_t* timepoint = &timepoints[timepoint_count++];
-        status = iree_hal_task_semaphore_acquire_timepoint(
-            semaphore, semaphore_list.payload_values[i], timeout, timepoint);
-        if (iree_status_is_ok(status)) {
-          status = iree_wait_set_insert(wait_set, timepoint->event);
-        }
+        // Slow path: register a timepoint on one of the pre-acquired events.
+        iree_hal_task_timepoint_t* timepoint = &timepoints[timepoint_count];
+        timepoint->event = events[timepoint_count];
+        ++timepoint_count;
+        timepoint->semaphore = &semaphore->base;
+        iree_hal_semaphore_acquire_timepoint(
+            &semaphore->base, semaphore_list.payload_values[i], timeout,
+            (iree_hal_semaphore_callback_t){
+                .fn = iree_hal_task_semaphore_timepoint_callback,
+                .user_data = timepoint,
+            },
+            &timepoint->base);
+        status = iree_wait_set_insert(wait_set, timepoint->event);
       }
       iree_slim_mutex_unlock(&semaphore->mutex);
       if (!iree_status_is_ok(status)) break;
@@ -386,22 +527,32 @@ iree_status_t iree_hal_task_semaphore_multi_wait(
 
   // Perform the wait.
   if (iree_status_is_ok(status) && needs_wait) {
+    // A dedicated zone separates time spent actually blocked from the
+    // timepoint bookkeeping above so captures attribute serialization
+    // correctly; the count of unresolved semaphores is appended for checking
+    // against the parallelism expected by the compiler's timepoint graph.
+    IREE_TRACE_ZONE_BEGIN_NAMED(z1,
+                                "iree_hal_task_semaphore_multi_wait_blocked");
+    IREE_TRACE_ZONE_APPEND_VALUE_I64(z1, (int64_t)timepoint_count);
     if (wait_mode == IREE_HAL_WAIT_MODE_ANY) {
       status = iree_wait_any(wait_set, deadline_ns, /*out_wake_handle=*/NULL);
     } else {
       status = iree_wait_all(wait_set, deadline_ns);
     }
+    IREE_TRACE_ZONE_END(z1);
   }
 
-  // TODO(benvanik): if we flip the API to multi-acquire events from the pool
-  // above then we can multi-release here too.
   for (iree_host_size_t i = 0; i < timepoint_count; ++i) {
     iree_hal_semaphore_t* semaphore = timepoints[i].semaphore;
     if (semaphore) {
       iree_hal_semaphore_cancel_timepoint(semaphore, &timepoints[i].base);
-      iree_event_pool_release(event_pool, 1, &timepoints[i].event);
     }
   }
+  // Return all pre-acquired events - used by timepoints or not - to the pool
+  // in a single call.
+  if (event_count > 0) {
+    iree_event_pool_release(event_pool, event_count, events);
+  }
   iree_wait_set_free(wait_set);
   iree_arena_deinitialize(&arena);
 
@@ -409,10 +560,80 @@ iree_status_t iree_hal_task_semaphore_multi_wait(
   return status;
 }
 
+static iree_status_t iree_hal_task_semaphore_export_timepoint(
+    iree_hal_semaphore_t* base_semaphore, uint64_t value,
+    iree_wait_primitive_type_t target_type,
+    iree_wait_primitive_t* out_wait_primitive) {
+  iree_hal_task_semaphore_t* semaphore =
+      iree_hal_task_semaphore_cast(base_semaphore);
+
+  // Fast path: already reached (or failed, which waiters observe immediately).
+  uint64_t current_value = (uint64_t)iree_atomic_load_int64(
+      &semaphore->current_value, iree_memory_order_acquire);
+  if (current_value >= value) {
+    *out_wait_primitive = iree_wait_primitive_immediate();
+    return iree_ok_status();
+  }
+
+  iree_hal_task_semaphore_exported_timepoint_t* exported = NULL;
+  IREE_RETURN_IF_ERROR(iree_allocator_malloc(
+      semaphore->host_allocator, sizeof(*exported), (void**)&exported));
+
+  // Re-check and register under the mutex: signals publish the new value under
+  // the mutex but notify timepoints after unlocking, so a timepoint registered
+  // after a racing signal's notification would never resolve.
+  iree_slim_mutex_lock(&semaphore->mutex);
+  current_value = (uint64_t)iree_atomic_load_int64(&semaphore->current_value,
+                                                   iree_memory_order_relaxed);
+  if (current_value >= value) {
+    iree_slim_mutex_unlock(&semaphore->mutex);
+    iree_allocator_free(semaphore->host_allocator, exported);
+    *out_wait_primitive = iree_wait_primitive_immediate();
+    return iree_ok_status();
+  }
+  iree_status_t status = iree_hal_task_semaphore_acquire_timepoint(
+      semaphore, value, iree_infinite_timeout(), &exported->timepoint);
+  iree_slim_mutex_unlock(&semaphore->mutex);
+  if (!iree_status_is_ok(status)) {
+    iree_allocator_free(semaphore->host_allocator, exported);
+    return status;
+  }
+
+  // Events are whatever primitive the platform pool produces (eventfds on
+  // Linux); callers demanding a specific other type can't be satisfied here.
+  iree_wait_primitive_t wait_primitive = iree_make_wait_primitive(
+      exported->timepoint.event.type, exported->timepoint.event.value);
+  if (target_type != IREE_WAIT_PRIMITIVE_TYPE_ANY &&
+      target_type != wait_primitive.type) {
+    iree_hal_semaphore_cancel_timepoint(&semaphore->base,
+                                        &exported->timepoint.base);
+    iree_event_pool_release(semaphore->event_pool, 1,
+                            &exported->timepoint.event);
+    iree_allocator_free(semaphore->host_allocator, exported);
+    return iree_make_status(
+        IREE_STATUS_UNAVAILABLE,
+        "requested wait primitive type %d is unavailable; events are type %d",
+        (int)target_type, (int)wait_primitive.type);
+  }
+
+  // Track the export so the event stays valid until the semaphore is
+  // destroyed; the reactor holding the handle owns nothing. Reached timepoints
+  // fire regardless of the list linkage so registering after the acquire is
+  // safe.
+  iree_slim_mutex_lock(&semaphore->mutex);
+  exported->next = semaphore->exported_head;
+  semaphore->exported_head = exported;
+  iree_slim_mutex_unlock(&semaphore->mutex);
+
+  *out_wait_primitive = wait_primitive;
+  return iree_ok_status();
+}
+
 static const iree_hal_semaphore_vtable_t iree_hal_task_semaphore_vtable = {
     .destroy = iree_hal_task_semaphore_destroy,
     .query = iree_hal_task_semaphore_query,
     .signal = iree_hal_task_semaphore_signal,
     .fail = iree_hal_task_semaphore_fail,
     .wait = iree_hal_task_semaphore_wait,
+    .export_timepoint = iree_hal_task_semaphore_export_timepoint,
 };
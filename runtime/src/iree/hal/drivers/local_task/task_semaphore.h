@@ -39,6 +39,14 @@ iree_status_t iree_hal_task_semaphore_enqueue_timepoint(
     iree_task_t* issue_task, iree_arena_allocator_t* arena,
     iree_task_submission_t* submission);
 
+// Signals all semaphores in |semaphore_list| to their new payload values.
+// Each semaphore lock is taken exactly once to publish its value and a single
+// notification pass resolves timepoints afterward, keeping submission-path
+// lock hold times short when batches carry several semaphores.
+// All semaphores must be task system semaphores.
+iree_status_t iree_hal_task_semaphore_multi_signal(
+    const iree_hal_semaphore_list_t semaphore_list);
+
 // Performs a multi-wait on one or more semaphores.
 // Returns IREE_STATUS_DEADLINE_EXCEEDED if the wait does not complete before
 // |deadline_ns| elapses.
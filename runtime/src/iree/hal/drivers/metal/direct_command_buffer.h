@@ -20,7 +20,10 @@ extern "C" {
 #endif  // __cplusplus
 
 // Creates a Metal command buffer that directly records into a MTLCommandBuffer.
-// Such command buffers are one shot--they can only be submitted once.
+// One-shot command buffers can only be submitted once; reusable command
+// buffers retain their command segments and replay them into a fresh
+// MTLCommandBuffer on each subsequent submission (see
+// iree_hal_metal_direct_command_buffer_issue).
 //
 // The command buffer would have the given |mode| and be recorded and submitted
 // to the given |queue|.
@@ -57,6 +60,18 @@ bool iree_hal_metal_direct_command_buffer_isa(
 id<MTLCommandBuffer> iree_hal_metal_direct_command_buffer_handle(
     const iree_hal_command_buffer_t* command_buffer);
 
+// Acquires a MTLCommandBuffer handle ready for submission in |out_handle|.
+// The first submission returns the handle commands were directly recorded
+// into; subsequent submissions of reusable command buffers replay the
+// retained command segments into a fresh MTLCommandBuffer, skipping all HAL
+// level re-recording and argument buffer encoding. Submitting a one-shot
+// command buffer more than once fails.
+//
+// The returned handle must be committed by the caller and remains valid until
+// the next issue or the command buffer is destroyed.
+iree_status_t iree_hal_metal_direct_command_buffer_issue(
+    iree_hal_command_buffer_t* command_buffer, id<MTLCommandBuffer>* out_handle);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -90,6 +90,13 @@ typedef struct iree_hal_metal_dispatch_segment_t {
   iree_host_size_t push_constant_count;
   // The list of push constants, pointing to the end of the segment allocation.
   int32_t* push_constants;
+
+  // Staging buffer offsets of the encoded argument buffers for each descriptor set. Argument
+  // buffers are encoded into the staging buffer on first recording and reused verbatim when
+  // replaying reusable command buffers--bound buffers cannot change after recording so the
+  // contents stay valid for the lifetime of the command buffer.
+  uint32_t argument_buffer_offsets[IREE_HAL_METAL_PUSH_CONSTANT_BUFFER_INDEX];
+  bool arguments_encoded;
 } iree_hal_metal_dispatch_segment_t;
 // + Additional inline allocation for holding all bound descriptors.
 // + Additional inline allocation for holding all push constants.
@@ -187,6 +194,15 @@ typedef struct iree_hal_metal_command_buffer_t {
 
   id<MTLCommandBuffer> command_buffer;
 
+  // How the Metal command buffer references used resources; needed when creating fresh
+  // MTLCommandBuffers for replaying reusable command buffers.
+  iree_hal_metal_command_buffer_resource_reference_mode_t resource_reference_mode;
+
+  // True when the current |command_buffer| handle has been handed out for submission. Reusable
+  // command buffers must then replay the retained segments into a fresh handle for the next
+  // submission.
+  bool handle_issued;
+
   MTLDispatchType dispatch_type;
 
   struct {
@@ -244,6 +260,49 @@ id<MTLCommandBuffer> iree_hal_metal_direct_command_buffer_handle(
   return command_buffer->command_buffer;
 }
 
+static iree_status_t iree_hal_metal_command_segment_record(
+    iree_hal_metal_command_buffer_t* command_buffer);
+static void iree_hal_metal_command_buffer_create_handle(
+    iree_hal_metal_command_buffer_t* command_buffer);
+static void iree_hal_metal_end_compute_encoder(iree_hal_metal_command_buffer_t* command_buffer);
+static void iree_hal_metal_end_blit_encoder(iree_hal_metal_command_buffer_t* command_buffer);
+
+iree_status_t iree_hal_metal_direct_command_buffer_issue(
+    iree_hal_command_buffer_t* base_command_buffer, id<MTLCommandBuffer>* out_handle) {
+  iree_hal_metal_command_buffer_t* command_buffer =
+      iree_hal_metal_command_buffer_cast(base_command_buffer);
+  *out_handle = nil;
+
+  // The first submission uses the MTLCommandBuffer commands were directly recorded into.
+  if (!command_buffer->handle_issued) {
+    command_buffer->handle_issued = true;
+    *out_handle = command_buffer->command_buffer;
+    return iree_ok_status();
+  }
+
+  if (iree_all_bits_set(iree_hal_command_buffer_mode(base_command_buffer),
+                        IREE_HAL_COMMAND_BUFFER_MODE_ONE_SHOT)) {
+    return iree_make_status(IREE_STATUS_FAILED_PRECONDITION,
+                            "one-shot command buffer cannot be submitted multiple times");
+  }
+
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Replay the retained command segments into a fresh MTLCommandBuffer. This only pays for the
+  // Metal encoding--the segment list, staged argument buffers, and uploaded source data from the
+  // original recording are all reused as-is.
+  [command_buffer->command_buffer release];  // -1
+  command_buffer->command_buffer = nil;
+  iree_hal_metal_command_buffer_create_handle(command_buffer);
+  iree_status_t status = iree_hal_metal_command_segment_record(command_buffer);
+  iree_hal_metal_end_blit_encoder(command_buffer);
+  iree_hal_metal_end_compute_encoder(command_buffer);
+  if (iree_status_is_ok(status)) *out_handle = command_buffer->command_buffer;
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
 static void iree_hal_metal_end_compute_encoder(iree_hal_metal_command_buffer_t* command_buffer) {
   if (command_buffer->state.compute_encoder) {
     [command_buffer->state.compute_encoder endEncoding];
@@ -331,6 +390,23 @@ static id<MTLBlitCommandEncoder> iree_hal_metal_get_or_begin_blit_encoder(
 static void iree_hal_metal_command_buffer_destroy_internal(
     iree_hal_command_buffer_t* base_command_buffer);
 
+// Creates the backing MTLCommandBuffer handle commands are encoded into. Called again for
+// reusable command buffers each time the retained segments are replayed.
+static void iree_hal_metal_command_buffer_create_handle(
+    iree_hal_metal_command_buffer_t* command_buffer) {
+  @autoreleasepool {  // Use @autoreleasepool to trigger the autorelease within handle creation.
+    // We track resource lifetime by ourselves in IREE; so just do unretained references to
+    // resources in Metal command buffer, which avoids overhead and gives better performance.
+    MTLCommandBufferDescriptor* descriptor = [MTLCommandBufferDescriptor new];  // +1
+    descriptor.retainedReferences = command_buffer->resource_reference_mode ==
+                                    IREE_HAL_METAL_COMMAND_BUFFER_RESOURCE_REFERENCE_MODE_RETAINED;
+    descriptor.errorOptions = MTLCommandBufferErrorOptionNone;
+    command_buffer->command_buffer =
+        [[command_buffer->queue commandBufferWithDescriptor:descriptor] retain];  // +1
+    [descriptor release];                                                         // -1
+  }
+}
+
 iree_status_t iree_hal_metal_direct_command_buffer_create(
     iree_hal_device_t* device, iree_hal_command_buffer_mode_t mode,
     iree_hal_command_category_t command_categories, iree_host_size_t binding_capacity,
@@ -341,7 +417,6 @@ iree_status_t iree_hal_metal_direct_command_buffer_create(
     iree_hal_command_buffer_t** out_command_buffer) {
   IREE_ASSERT_ARGUMENT(device);
   IREE_ASSERT_ARGUMENT(out_command_buffer);
-  IREE_ASSERT_TRUE(iree_all_bits_set(mode, IREE_HAL_COMMAND_BUFFER_MODE_ONE_SHOT));
   IREE_ASSERT_TRUE(!iree_any_bit_set(mode, IREE_HAL_COMMAND_BUFFER_MODE_NESTED));
   *out_command_buffer = NULL;
 
@@ -368,17 +443,9 @@ iree_status_t iree_hal_metal_direct_command_buffer_create(
   iree_status_t status = iree_hal_resource_set_allocate(block_pool, &command_buffer->resource_set);
   if (iree_status_is_ok(status)) {
     iree_hal_metal_command_segment_list_reset(&command_buffer->segments);
-    @autoreleasepool {  // Use @autoreleasepool to trigger the autorelease within encoder creation.
-      // We track resource lifetime by ourselves in IREE; so just do unretained references to
-      // resources in Metal command buffer, which avoids overhead and gives better performance.
-      MTLCommandBufferDescriptor* descriptor = [MTLCommandBufferDescriptor new];  // +1
-      descriptor.retainedReferences =
-          resource_reference_mode == IREE_HAL_METAL_COMMAND_BUFFER_RESOURCE_REFERENCE_MODE_RETAINED;
-      descriptor.errorOptions = MTLCommandBufferErrorOptionNone;
-      command_buffer->command_buffer =
-          [[queue commandBufferWithDescriptor:descriptor] retain];  // +1
-      [descriptor release];                                         // -1
-    }
+    command_buffer->resource_reference_mode = resource_reference_mode;
+    command_buffer->handle_issued = false;
+    iree_hal_metal_command_buffer_create_handle(command_buffer);
     const iree_hal_metal_device_params_t* params = iree_hal_metal_device_params(device);
     command_buffer->dispatch_type =
         params->command_dispatch_type == IREE_HAL_METAL_COMMAND_DISPATCH_TYPE_CONCURRENT
@@ -1005,42 +1072,61 @@ static iree_status_t iree_hal_metal_command_segment_record_dispatch(
 
   // Record argument buffers for all descriptors and record buffer usages.
   iree_hal_metal_descriptor_t* descriptors = segment->descriptors;
-  for (iree_host_size_t i = 0; i < segment->descriptor_count;) {
-    uint32_t current_set = descriptors[i].set;
-
-    // Build argument encoder and argument buffer for the current descriptor set.
-    // TODO(antiagainst): Use a cache layer to cache and reuse argument buffers with the same
-    // content, to avoid duplicating overhead.
-    id<MTLBuffer> argument_buffer = command_buffer->staging_buffer->metal_buffer;
-    id<MTLArgumentEncoder> argument_encoder =
-        [segment->kernel_params.function newArgumentEncoderWithBufferIndex:current_set];  // +1
-    IREE_ASSERT(argument_encoder != nil);
-
-    // Reserve space for the argument buffer from shared staging buffer.
-    iree_byte_span_t reservation;
-    uint32_t argument_buffer_offset;
-    IREE_RETURN_AND_END_ZONE_IF_ERROR(
-        z0, iree_hal_metal_staging_buffer_reserve(
-                command_buffer->staging_buffer, argument_encoder.encodedLength,
-                argument_encoder.alignment, &reservation, &argument_buffer_offset));
-    [argument_encoder setArgumentBuffer:argument_buffer offset:argument_buffer_offset];
-
-    // Now record all bound buffers belonging to the current set into the argument buffer.
-    for (; i < segment->descriptor_count && descriptors[i].set == current_set; ++i) {
-      uint32_t current_binding = descriptors[i].binding;
-      id<MTLBuffer> current_buffer =
-          iree_hal_metal_buffer_handle(iree_hal_buffer_allocated_buffer(descriptors[i].buffer));
-      iree_host_size_t offset =
-          iree_hal_buffer_byte_offset(descriptors[i].buffer) + descriptors[i].offset;
-      [argument_encoder setBuffer:current_buffer offset:offset atIndex:current_binding];
-
-      // Also record buffer usages.
-      [compute_encoder useResource:current_buffer usage:descriptors[i].usage];
-    }
-    // Record the argument buffer.
-    [compute_encoder setBuffer:argument_buffer offset:argument_buffer_offset atIndex:current_set];
+  id<MTLBuffer> argument_buffer = command_buffer->staging_buffer->metal_buffer;
+  if (!segment->arguments_encoded) {
+    for (iree_host_size_t i = 0; i < segment->descriptor_count;) {
+      uint32_t current_set = descriptors[i].set;
+
+      // Build argument encoder and argument buffer for the current descriptor set.
+      id<MTLArgumentEncoder> argument_encoder =
+          [segment->kernel_params.function newArgumentEncoderWithBufferIndex:current_set];  // +1
+      IREE_ASSERT(argument_encoder != nil);
+
+      // Reserve space for the argument buffer from shared staging buffer.
+      iree_byte_span_t reservation;
+      uint32_t argument_buffer_offset;
+      IREE_RETURN_AND_END_ZONE_IF_ERROR(
+          z0, iree_hal_metal_staging_buffer_reserve(
+                  command_buffer->staging_buffer, argument_encoder.encodedLength,
+                  argument_encoder.alignment, &reservation, &argument_buffer_offset));
+      [argument_encoder setArgumentBuffer:argument_buffer offset:argument_buffer_offset];
+      segment->argument_buffer_offsets[current_set] = argument_buffer_offset;
+
+      // Now record all bound buffers belonging to the current set into the argument buffer.
+      for (; i < segment->descriptor_count && descriptors[i].set == current_set; ++i) {
+        uint32_t current_binding = descriptors[i].binding;
+        id<MTLBuffer> current_buffer =
+            iree_hal_metal_buffer_handle(iree_hal_buffer_allocated_buffer(descriptors[i].buffer));
+        iree_host_size_t offset =
+            iree_hal_buffer_byte_offset(descriptors[i].buffer) + descriptors[i].offset;
+        [argument_encoder setBuffer:current_buffer offset:offset atIndex:current_binding];
+
+        // Also record buffer usages.
+        [compute_encoder useResource:current_buffer usage:descriptors[i].usage];
+      }
+      // Record the argument buffer.
+      [compute_encoder setBuffer:argument_buffer
+                          offset:argument_buffer_offset
+                         atIndex:current_set];
 
-    [argument_encoder release];  // -1
+      [argument_encoder release];  // -1
+    }
+    segment->arguments_encoded = true;
+  } else {
+    // Replaying a reusable command buffer: the argument buffers were encoded into the staging
+    // buffer on first recording and their contents cannot change, so just rebind them and
+    // re-declare buffer usages for this pass.
+    for (iree_host_size_t i = 0; i < segment->descriptor_count;) {
+      uint32_t current_set = descriptors[i].set;
+      for (; i < segment->descriptor_count && descriptors[i].set == current_set; ++i) {
+        id<MTLBuffer> current_buffer =
+            iree_hal_metal_buffer_handle(iree_hal_buffer_allocated_buffer(descriptors[i].buffer));
+        [compute_encoder useResource:current_buffer usage:descriptors[i].usage];
+      }
+      [compute_encoder setBuffer:argument_buffer
+                          offset:segment->argument_buffer_offsets[current_set]
+                         atIndex:current_set];
+    }
   }
 
   // Record the dispatch, either direct or indirect.
@@ -249,9 +249,6 @@ static iree_status_t iree_hal_metal_device_create_command_buffer(
 
   if (iree_any_bit_set(mode, IREE_HAL_COMMAND_BUFFER_MODE_NESTED))
     return iree_make_status(IREE_STATUS_UNIMPLEMENTED, "nested command buffer not yet supported");
-  if (!iree_all_bits_set(mode, IREE_HAL_COMMAND_BUFFER_MODE_ONE_SHOT))
-    return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
-                            "multi-shot command buffer not yet supported");
 
   return iree_hal_metal_direct_command_buffer_create(
       base_device, mode, command_categories, binding_capacity,
@@ -430,41 +427,132 @@ static iree_status_t iree_hal_metal_device_queue_execute(
       }
 
       // Then commit all recorded compute command buffers, except the last one, which we will patch
-      // up with semaphore signaling.
+      // up with semaphore signaling. Reusable command buffers replay their retained command
+      // segments into fresh MTLCommandBuffers here.
       id<MTLCommandBuffer> signal_command_buffer = nil;
       for (iree_host_size_t i = 0; i < command_buffer_count; ++i) {
         iree_hal_command_buffer_t* command_buffer = command_buffers[i];
-        id<MTLCommandBuffer> handle = iree_hal_metal_direct_command_buffer_handle(command_buffer);
+        id<MTLCommandBuffer> handle = nil;
+        status = iree_hal_metal_direct_command_buffer_issue(command_buffer, &handle);
+        if (!iree_status_is_ok(status)) break;
         if (i + 1 != command_buffer_count) [handle commit];
         signal_command_buffer = handle;
       }
-      if (signal_command_buffer == nil) {
-        signal_command_buffer = [device->queue
-            commandBufferWithDescriptor:device->command_buffer_descriptor];  // autoreleased
+
+      if (iree_status_is_ok(status)) {
+        if (signal_command_buffer == nil) {
+          signal_command_buffer = [device->queue
+              commandBufferWithDescriptor:device->command_buffer_descriptor];  // autoreleased
+        }
+
+        // Finally encode signal commands for all signal semaphores.
+        for (iree_host_size_t i = 0; i < signal_semaphore_list.count; ++i) {
+          id<MTLSharedEvent> handle =
+              iree_hal_metal_shared_event_handle(signal_semaphore_list.semaphores[i]);
+          [signal_command_buffer encodeSignalEvent:handle
+                                             value:signal_semaphore_list.payload_values[i]];
+        }
+
+        // We use a resource set to keep track of resources in the above. So here we need to retain
+        // the device to make sure the block pool behind outlives the resource set.
+        iree_hal_device_retain(base_device);
+        [signal_command_buffer addCompletedHandler:^(id<MTLCommandBuffer> cb) {
+          // Now we can release all retained resources.
+          iree_hal_resource_set_free(resource_set);
+          // And then release the device handle. Note that this must happen separately--if we put
+          // the device itself in the resource set, we can destroy the block pool data structure
+          // inside the device prematurely, before the resource set free procedure done scanning it.
+          iree_hal_device_release(base_device);
+        }];
+        [signal_command_buffer commit];
       }
+    }
+  }
+  if (!iree_status_is_ok(status)) {
+    iree_hal_resource_set_free(resource_set);
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
 
-      // Finally encode signal commands for all signal semaphores.
-      for (iree_host_size_t i = 0; i < signal_semaphore_list.count; ++i) {
+static iree_status_t iree_hal_metal_device_queue_callback(
+    iree_hal_device_t* base_device, iree_hal_queue_affinity_t queue_affinity,
+    const iree_hal_semaphore_list_t wait_semaphore_list,
+    const iree_hal_semaphore_list_t signal_semaphore_list, iree_hal_queue_callback_fn_t callback,
+    void* user_data) {
+  iree_hal_metal_device_t* device = iree_hal_metal_device_cast(base_device);
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_hal_resource_set_t* resource_set = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_hal_resource_set_allocate(&device->block_pool, &resource_set));
+
+  // Put the full semaphore list into a resource set, which retains them--we will need to access
+  // them until the completed handler below runs.
+  iree_status_t status = iree_hal_resource_set_insert(resource_set, wait_semaphore_list.count,
+                                                      wait_semaphore_list.semaphores);
+  if (iree_status_is_ok(status)) {
+    status = iree_hal_resource_set_insert(resource_set, signal_semaphore_list.count,
+                                          signal_semaphore_list.semaphores);
+  }
+
+  // Copy the signal semaphore list; the completed handler runs after the caller returns so it
+  // cannot reference the caller-owned list storage.
+  __block iree_hal_semaphore_list_t signal_list;
+  memset(&signal_list, 0, sizeof(signal_list));
+  uint8_t* signal_storage = NULL;
+  if (iree_status_is_ok(status) && signal_semaphore_list.count > 0) {
+    iree_host_size_t semaphores_size =
+        signal_semaphore_list.count * sizeof(signal_semaphore_list.semaphores[0]);
+    iree_host_size_t values_size =
+        signal_semaphore_list.count * sizeof(signal_semaphore_list.payload_values[0]);
+    status = iree_allocator_malloc(device->host_allocator, semaphores_size + values_size,
+                                   (void**)&signal_storage);
+    if (iree_status_is_ok(status)) {
+      signal_list.count = signal_semaphore_list.count;
+      signal_list.semaphores = (iree_hal_semaphore_t**)signal_storage;
+      signal_list.payload_values = (uint64_t*)(signal_storage + semaphores_size);
+      memcpy(signal_list.semaphores, signal_semaphore_list.semaphores, semaphores_size);
+      memcpy(signal_list.payload_values, signal_semaphore_list.payload_values, values_size);
+    }
+  }
+
+  if (iree_status_is_ok(status)) {
+    @autoreleasepool {
+      // Create a command buffer that only encodes wait commands for all wait semaphores; its
+      // completed handler then fires in queue order once those waits are satisfied.
+      id<MTLCommandBuffer> wait_command_buffer = [device->queue
+          commandBufferWithDescriptor:device->command_buffer_descriptor];  // autoreleased
+      for (iree_host_size_t i = 0; i < wait_semaphore_list.count; ++i) {
         id<MTLSharedEvent> handle =
-            iree_hal_metal_shared_event_handle(signal_semaphore_list.semaphores[i]);
-        [signal_command_buffer encodeSignalEvent:handle
-                                           value:signal_semaphore_list.payload_values[i]];
+            iree_hal_metal_shared_event_handle(wait_semaphore_list.semaphores[i]);
+        [wait_command_buffer encodeWaitForEvent:handle
+                                          value:wait_semaphore_list.payload_values[i]];
       }
 
       // We use a resource set to keep track of resources in the above. So here we need to retain
       // the device to make sure the block pool behind outlives the resource set.
       iree_hal_device_retain(base_device);
-      [signal_command_buffer addCompletedHandler:^(id<MTLCommandBuffer> cb) {
+      iree_allocator_t host_allocator = device->host_allocator;
+      [wait_command_buffer addCompletedHandler:^(id<MTLCommandBuffer> cb) {
+        // Run the user callback before signaling so host logic ordered against the queue observes
+        // a fully satisfied wait list.
+        callback(user_data);
+        iree_status_ignore(iree_hal_semaphore_list_signal(signal_list));
         // Now we can release all retained resources.
+        iree_allocator_free(host_allocator, signal_list.semaphores);
         iree_hal_resource_set_free(resource_set);
-        // And then release the device handle. Note that this must happen separately--if we put the
-        // device itself in the resource set, we can destroy the block pool data structure inside
-        // the device prematurely, before the resource set free procedure done scanning it.
+        // And then release the device handle. Note that this must happen separately--if we put
+        // the device itself in the resource set, we can destroy the block pool data structure
+        // inside the device prematurely, before the resource set free procedure done scanning it.
         iree_hal_device_release(base_device);
       }];
-      [signal_command_buffer commit];
+      [wait_command_buffer commit];
     }
-  } else {
+  }
+  if (!iree_status_is_ok(status)) {
+    iree_allocator_free(device->host_allocator, signal_storage);
     iree_hal_resource_set_free(resource_set);
   }
 
@@ -573,6 +661,7 @@ static const iree_hal_device_vtable_t iree_hal_metal_device_vtable = {
     .queue_read = iree_hal_metal_device_queue_read,
     .queue_write = iree_hal_metal_device_queue_write,
     .queue_execute = iree_hal_metal_device_queue_execute,
+    .queue_callback = iree_hal_metal_device_queue_callback,
     .queue_flush = iree_hal_metal_device_queue_flush,
     .wait_semaphores = iree_hal_metal_device_wait_semaphores,
     .profiling_begin = iree_hal_metal_device_profiling_begin,
@@ -213,6 +213,17 @@ typedef uint32_t iree_hal_vulkan_device_flags_t;
 typedef struct iree_hal_vulkan_device_options_t {
   // Flags controlling device behavior.
   iree_hal_vulkan_device_flags_t flags;
+
+  // Optional path to a file used to persist the driver pipeline cache
+  // (VkPipelineCache) across runs. When non-empty executable caches created on
+  // the device seed a pipeline cache from the file contents on creation and
+  // write the accumulated data back on destruction so that pipeline
+  // compilation is only paid for on the first run. Empty disables persistence
+  // and executables are compiled from scratch each run.
+  //
+  // The string data is not copied and must remain live until devices have been
+  // created; created devices retain their own copy.
+  iree_string_view_t pipeline_cache_path;
 } iree_hal_vulkan_device_options_t;
 
 IREE_API_EXPORT void iree_hal_vulkan_device_options_initialize(
@@ -0,0 +1,213 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/hal/drivers/vulkan/pipeline_executable_cache.h"
+
+#include <cstddef>
+#include <cstring>
+
+#include "iree/base/api.h"
+#include "iree/base/internal/file_io.h"
+#include "iree/hal/drivers/vulkan/dynamic_symbol_tables.h"
+#include "iree/hal/drivers/vulkan/native_executable.h"
+#include "iree/hal/drivers/vulkan/status_util.h"
+
+using namespace iree::hal::vulkan;
+
+typedef struct iree_hal_vulkan_pipeline_executable_cache_t {
+  iree_hal_resource_t resource;
+  VkDeviceHandle* logical_device;
+  // Persistent pipeline cache passed to all pipeline creation calls.
+  VkPipelineCache pipeline_cache;
+  // NUL-terminated path the cache data is loaded from and stored to; points
+  // into the trailing allocation storage.
+  iree_string_view_t cache_file_path;
+} iree_hal_vulkan_pipeline_executable_cache_t;
+
+namespace {
+extern const iree_hal_executable_cache_vtable_t
+    iree_hal_vulkan_pipeline_executable_cache_vtable;
+}  // namespace
+
+static iree_hal_vulkan_pipeline_executable_cache_t*
+iree_hal_vulkan_pipeline_executable_cache_cast(
+    iree_hal_executable_cache_t* base_value) {
+  IREE_HAL_ASSERT_TYPE(base_value,
+                       &iree_hal_vulkan_pipeline_executable_cache_vtable);
+  return (iree_hal_vulkan_pipeline_executable_cache_t*)base_value;
+}
+
+// Creates the VkPipelineCache seeded with the contents of the cache file, if
+// any. A missing or unreadable file is not an error: the cache starts empty
+// and will be populated as pipelines are created. The Vulkan implementation
+// validates the blob header (including driver and device UUIDs) itself and
+// ignores incompatible data.
+static iree_status_t iree_hal_vulkan_pipeline_executable_cache_initialize(
+    iree_hal_vulkan_pipeline_executable_cache_t* executable_cache) {
+  VkDeviceHandle* logical_device = executable_cache->logical_device;
+
+  iree_file_contents_t* file_contents = NULL;
+  iree_status_t read_status = iree_file_read_contents(
+      executable_cache->cache_file_path.data, IREE_FILE_READ_FLAG_DEFAULT,
+      logical_device->host_allocator(), &file_contents);
+  if (!iree_status_is_ok(read_status)) {
+    // First run or inaccessible file; proceed with an empty cache.
+    iree_status_ignore(read_status);
+    file_contents = NULL;
+  }
+
+  VkPipelineCacheCreateInfo create_info;
+  create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+  create_info.pNext = NULL;
+  create_info.flags = 0;
+  create_info.initialDataSize =
+      file_contents ? file_contents->const_buffer.data_length : 0;
+  create_info.pInitialData =
+      file_contents ? file_contents->const_buffer.data : NULL;
+  iree_status_t status = VK_RESULT_TO_STATUS(
+      logical_device->syms()->vkCreatePipelineCache(
+          *logical_device, &create_info, logical_device->allocator(),
+          &executable_cache->pipeline_cache),
+      "vkCreatePipelineCache");
+
+  iree_file_contents_free(file_contents);
+  return status;
+}
+
+// Writes the current pipeline cache contents back to the cache file.
+// Best-effort: failures are ignored as losing the cache only costs
+// recompilation on the next run.
+static void iree_hal_vulkan_pipeline_executable_cache_save(
+    iree_hal_vulkan_pipeline_executable_cache_t* executable_cache) {
+  VkDeviceHandle* logical_device = executable_cache->logical_device;
+  size_t data_size = 0;
+  if (logical_device->syms()->vkGetPipelineCacheData(
+          *logical_device, executable_cache->pipeline_cache, &data_size,
+          NULL) != VK_SUCCESS ||
+      data_size == 0) {
+    return;
+  }
+  void* data = NULL;
+  if (!iree_status_is_ok(iree_allocator_malloc(
+          logical_device->host_allocator(), data_size, &data))) {
+    return;
+  }
+  if (logical_device->syms()->vkGetPipelineCacheData(
+          *logical_device, executable_cache->pipeline_cache, &data_size,
+          data) == VK_SUCCESS) {
+    iree_status_ignore(iree_file_write_contents(
+        executable_cache->cache_file_path.data,
+        iree_make_const_byte_span(data, data_size)));
+  }
+  iree_allocator_free(logical_device->host_allocator(), data);
+}
+
+iree_status_t iree_hal_vulkan_pipeline_executable_cache_create(
+    iree::hal::vulkan::VkDeviceHandle* logical_device,
+    iree_string_view_t identifier, iree_string_view_t cache_file_path,
+    iree_hal_executable_cache_t** out_executable_cache) {
+  IREE_ASSERT_ARGUMENT(out_executable_cache);
+  *out_executable_cache = NULL;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_hal_vulkan_pipeline_executable_cache_t* executable_cache = NULL;
+  iree_host_size_t total_size =
+      sizeof(*executable_cache) + cache_file_path.size + /*NUL*/ 1;
+  iree_status_t status = iree_allocator_malloc(logical_device->host_allocator(),
+                                               total_size,
+                                               (void**)&executable_cache);
+  if (iree_status_is_ok(status)) {
+    iree_hal_resource_initialize(
+        &iree_hal_vulkan_pipeline_executable_cache_vtable,
+        &executable_cache->resource);
+    executable_cache->logical_device = logical_device;
+    char* path_buffer = (char*)executable_cache + sizeof(*executable_cache);
+    iree_string_view_append_to_buffer(
+        cache_file_path, &executable_cache->cache_file_path, path_buffer);
+    path_buffer[cache_file_path.size] = '\0';
+
+    status =
+        iree_hal_vulkan_pipeline_executable_cache_initialize(executable_cache);
+  }
+
+  if (iree_status_is_ok(status)) {
+    *out_executable_cache = (iree_hal_executable_cache_t*)executable_cache;
+  } else if (executable_cache) {
+    iree_allocator_free(logical_device->host_allocator(), executable_cache);
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+static void iree_hal_vulkan_pipeline_executable_cache_destroy(
+    iree_hal_executable_cache_t* base_executable_cache) {
+  iree_hal_vulkan_pipeline_executable_cache_t* executable_cache =
+      iree_hal_vulkan_pipeline_executable_cache_cast(base_executable_cache);
+  VkDeviceHandle* logical_device = executable_cache->logical_device;
+  iree_allocator_t host_allocator = logical_device->host_allocator();
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_hal_vulkan_pipeline_executable_cache_save(executable_cache);
+  logical_device->syms()->vkDestroyPipelineCache(
+      *logical_device, executable_cache->pipeline_cache,
+      logical_device->allocator());
+
+  iree_allocator_free(host_allocator, executable_cache);
+
+  IREE_TRACE_ZONE_END(z0);
+}
+
+static bool iree_hal_vulkan_pipeline_executable_cache_can_prepare_format(
+    iree_hal_executable_cache_t* base_executable_cache,
+    iree_hal_executable_caching_mode_t caching_mode,
+    iree_string_view_t executable_format) {
+  iree_hal_vulkan_pipeline_executable_cache_t* executable_cache =
+      iree_hal_vulkan_pipeline_executable_cache_cast(base_executable_cache);
+  if (iree_string_view_equal(executable_format,
+                             iree_make_cstring_view("vulkan-spirv-fb"))) {
+    return true;
+  } else if (iree_string_view_equal(
+                 executable_format,
+                 iree_make_cstring_view("vulkan-spirv-fb-ptr"))) {
+    return iree_all_bits_set(
+        executable_cache->logical_device->enabled_features(),
+        IREE_HAL_VULKAN_FEATURE_ENABLE_BUFFER_DEVICE_ADDRESSES);
+  }
+  return false;
+}
+
+static iree_status_t
+iree_hal_vulkan_pipeline_executable_cache_prepare_executable(
+    iree_hal_executable_cache_t* base_executable_cache,
+    const iree_hal_executable_params_t* executable_params,
+    iree_hal_executable_t** out_executable) {
+  if (!iree_hal_vulkan_pipeline_executable_cache_can_prepare_format(
+          base_executable_cache, executable_params->caching_mode,
+          executable_params->executable_format)) {
+    return iree_make_status(IREE_STATUS_NOT_FOUND,
+                            "no Vulkan executable implementation registered "
+                            "for the given executable format '%.*s'",
+                            (int)executable_params->executable_format.size,
+                            executable_params->executable_format.data);
+  }
+  iree_hal_vulkan_pipeline_executable_cache_t* executable_cache =
+      iree_hal_vulkan_pipeline_executable_cache_cast(base_executable_cache);
+  return iree_hal_vulkan_native_executable_create(
+      executable_cache->logical_device, executable_cache->pipeline_cache,
+      executable_params, out_executable);
+}
+
+namespace {
+const iree_hal_executable_cache_vtable_t
+    iree_hal_vulkan_pipeline_executable_cache_vtable = {
+        /*.destroy=*/iree_hal_vulkan_pipeline_executable_cache_destroy,
+        /*.can_prepare_format=*/
+        iree_hal_vulkan_pipeline_executable_cache_can_prepare_format,
+        /*.prepare_executable=*/
+        iree_hal_vulkan_pipeline_executable_cache_prepare_executable,
+};
+}  // namespace
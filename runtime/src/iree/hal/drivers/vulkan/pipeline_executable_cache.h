@@ -0,0 +1,37 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_HAL_DRIVERS_VULKAN_PIPELINE_EXECUTABLE_CACHE_H_
+#define IREE_HAL_DRIVERS_VULKAN_PIPELINE_EXECUTABLE_CACHE_H_
+
+#include "iree/base/api.h"
+#include "iree/hal/api.h"
+#include "iree/hal/drivers/vulkan/handle_util.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+// Creates an executable cache backed by a VkPipelineCache that persists
+// compiled pipelines to |cache_file_path| across runs.
+//
+// On creation the pipeline cache is seeded with the file contents if present;
+// a missing or stale file (driver/device mismatch is detected by the Vulkan
+// implementation from the blob header) results in an empty cache. On
+// destruction the accumulated cache data is written back to the file on a
+// best-effort basis. Executables prepared through the cache still perform
+// vkCreateComputePipelines but the driver can skip the expensive SPIR-V to
+// ISA compilation when a cached pipeline matches.
+iree_status_t iree_hal_vulkan_pipeline_executable_cache_create(
+    iree::hal::vulkan::VkDeviceHandle* logical_device,
+    iree_string_view_t identifier, iree_string_view_t cache_file_path,
+    iree_hal_executable_cache_t** out_executable_cache);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // IREE_HAL_DRIVERS_VULKAN_PIPELINE_EXECUTABLE_CACHE_H_
@@ -46,6 +46,12 @@ IREE_FLAG(
     bool, vulkan_dedicated_compute_queue, false,
     "Use a dedicated queue with VK_QUEUE_COMPUTE_BIT for dispatch workloads.");
 
+IREE_FLAG(string, vulkan_pipeline_cache_path, "",
+          "File path used to persist the Vulkan pipeline cache "
+          "(VkPipelineCache) across runs so that pipeline compilation is only "
+          "performed the first time a program runs. The file is created if it "
+          "does not exist.");
+
 static iree_status_t iree_hal_vulkan_create_driver_with_flags(
     iree_string_view_t identifier, iree_allocator_t host_allocator,
     iree_hal_driver_t** out_driver) {
@@ -100,6 +106,9 @@ static iree_status_t iree_hal_vulkan_create_driver_with_flags(
         IREE_HAL_VULKAN_DEVICE_FLAG_DEDICATED_COMPUTE_QUEUE;
   }
 
+  driver_options.device_options.pipeline_cache_path =
+      iree_make_cstring_view(FLAG_vulkan_pipeline_cache_path);
+
   // Load the Vulkan library. This will fail if the library cannot be found or
   // does not have the expected functions.
   iree_hal_vulkan_syms_t* syms = NULL;
@@ -188,6 +188,23 @@ IREE_API_EXPORT iree_status_t iree_hal_executable_cache_prepare_executable(
     const iree_hal_executable_params_t* executable_params,
     iree_hal_executable_t** out_executable);
 
+// Prepares |executable_count| executables in a single batched call.
+// Equivalent to calling iree_hal_executable_cache_prepare_executable once per
+// entry of |executable_params_list| but gives implementations the whole set up
+// front: backends can share a linking/symbol-resolution context across the
+// batch, load into a single device library, and parallelize preparation on the
+// cache's loop. Implementations without batch support fall back to serial
+// preparation.
+//
+// On success |out_executables| receives one executable per params entry in the
+// same order. On failure all executables that were prepared before the error
+// are released and every entry of |out_executables| is NULL.
+IREE_API_EXPORT iree_status_t iree_hal_executable_cache_prepare_executables(
+    iree_hal_executable_cache_t* executable_cache,
+    iree_host_size_t executable_count,
+    const iree_hal_executable_params_t* executable_params_list,
+    iree_hal_executable_t** out_executables);
+
 //===----------------------------------------------------------------------===//
 // iree_hal_executable_cache_t implementation details
 //===----------------------------------------------------------------------===//
@@ -204,6 +221,14 @@ typedef struct iree_hal_executable_cache_vtable_t {
       iree_hal_executable_cache_t* executable_cache,
       const iree_hal_executable_params_t* executable_params,
       iree_hal_executable_t** out_executable);
+
+  // Optional; when NULL batched preparation falls back to serial
+  // prepare_executable calls.
+  iree_status_t(IREE_API_PTR* prepare_executables)(
+      iree_hal_executable_cache_t* executable_cache,
+      iree_host_size_t executable_count,
+      const iree_hal_executable_params_t* executable_params_list,
+      iree_hal_executable_t** out_executables);
 } iree_hal_executable_cache_vtable_t;
 IREE_HAL_ASSERT_VTABLE_LAYOUT(iree_hal_executable_cache_vtable_t);
 
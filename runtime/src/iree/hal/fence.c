@@ -254,6 +254,41 @@ IREE_API_EXPORT iree_status_t iree_hal_fence_wait(iree_hal_fence_t* fence,
   return status;
 }
 
+IREE_API_EXPORT iree_status_t iree_hal_fence_export_timepoint(
+    iree_hal_fence_t* fence, iree_wait_primitive_type_t target_type,
+    iree_wait_primitive_t* out_wait_primitive) {
+  IREE_ASSERT_ARGUMENT(out_wait_primitive);
+  memset(out_wait_primitive, 0, sizeof(*out_wait_primitive));
+
+  // Empty or already-reached fences resolve immediately; reactors check with
+  // iree_wait_primitive_is_immediate instead of polling a handle.
+  iree_status_t status = iree_hal_fence_query(fence);
+  if (iree_status_is_ok(status)) {
+    *out_wait_primitive = iree_wait_primitive_immediate();
+    return iree_ok_status();
+  } else if (!iree_status_is_deferred(status)) {
+    return status;  // failed fence
+  }
+  iree_status_ignore(status);
+
+  // Exporting a single handle for a multi-timepoint fence would require a
+  // merged primitive (a proxy eventfd signaled by a waiter) which defeats the
+  // purpose of threadless multiplexing; callers can export each timepoint via
+  // iree_hal_semaphore_export_timepoint and wait-all themselves.
+  iree_hal_semaphore_list_t semaphore_list =
+      iree_hal_fence_semaphore_list(fence);
+  if (semaphore_list.count != 1) {
+    return iree_make_status(
+        IREE_STATUS_UNAVAILABLE,
+        "only single-timepoint fences can export a wait primitive; fence has "
+        "%" PRIhsz " timepoints",
+        semaphore_list.count);
+  }
+  return iree_hal_semaphore_export_timepoint(
+      semaphore_list.semaphores[0], semaphore_list.payload_values[0],
+      target_type, out_wait_primitive);
+}
+
 iree_status_t iree_hal_fence_wait_source_ctl(iree_wait_source_t wait_source,
                                              iree_wait_source_command_t command,
                                              const void* params,
@@ -279,14 +314,10 @@ iree_status_t iree_hal_fence_wait_source_ctl(iree_wait_source_t wait_source,
     case IREE_WAIT_SOURCE_COMMAND_EXPORT: {
       const iree_wait_primitive_type_t target_type =
           ((const iree_wait_source_export_params_t*)params)->target_type;
-      // TODO(benvanik): support exporting fences to real wait handles.
       iree_wait_primitive_t* out_wait_primitive =
           (iree_wait_primitive_t*)inout_ptr;
-      memset(out_wait_primitive, 0, sizeof(*out_wait_primitive));
-      (void)target_type;
-      return iree_make_status(IREE_STATUS_UNAVAILABLE,
-                              "requested wait primitive type %d is unavailable",
-                              (int)target_type);
+      return iree_hal_fence_export_timepoint(fence, target_type,
+                                             out_wait_primitive);
     }
     default:
       return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
@@ -128,6 +128,25 @@ IREE_API_EXPORT iree_status_t iree_hal_fence_wait(iree_hal_fence_t* fence,
 IREE_API_EXPORT iree_wait_source_t
 iree_hal_fence_await(iree_hal_fence_t* fence);
 
+// Exports a native wait primitive that is signaled when |fence| is reached.
+// This allows external reactors (epoll/kqueue loops and the like) to multiplex
+// many inflight fences on one wait set without waiter threads. |target_type|
+// restricts the primitive type; use IREE_WAIT_PRIMITIVE_TYPE_ANY to accept
+// whatever the backing semaphore can produce.
+//
+// Empty and already-reached fences return an immediate primitive that callers
+// can check with iree_wait_primitive_is_immediate. The returned primitive is
+// owned by the backing semaphore and is valid until that semaphore is
+// destroyed; callers must not close it and must retain the fence (or its
+// semaphores) while the primitive is registered with a reactor.
+//
+// Returns IREE_STATUS_UNAVAILABLE if the fence spans multiple timepoints or
+// the backing semaphore implementation cannot export |target_type| primitives;
+// callers should fall back to iree_hal_fence_wait.
+IREE_API_EXPORT iree_status_t iree_hal_fence_export_timepoint(
+    iree_hal_fence_t* fence, iree_wait_primitive_type_t target_type,
+    iree_wait_primitive_t* out_wait_primitive);
+
 //===----------------------------------------------------------------------===//
 // iree_hal_fence_t implementation details
 //===----------------------------------------------------------------------===//
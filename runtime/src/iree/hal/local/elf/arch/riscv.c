@@ -41,8 +41,17 @@ enum {
 #if defined(IREE_ARCH_RISCV_32)
 static iree_status_t iree_elf_arch_riscv_apply_rela(
     iree_elf_relocation_state_t* state, iree_host_size_t rela_count,
-    const iree_elf_rela_t* rela_table) {
-  for (iree_host_size_t i = 0; i < rela_count; ++i) {
+    iree_host_size_t relative_count, const iree_elf_rela_t* rela_table) {
+  // Fast path for the sorted R_RISCV_RELATIVE prefix indicated by
+  // DT_RELACOUNT: no symbol lookups or type dispatch required.
+  if (relative_count > rela_count) relative_count = rela_count;
+  for (iree_host_size_t i = 0; i < relative_count; ++i) {
+    const iree_elf_rela_t* rela = &rela_table[i];
+    *(uint32_t*)(state->vaddr_bias + rela->r_offset) =
+        (uint32_t)(state->vaddr_bias + rela->r_addend);
+  }
+
+  for (iree_host_size_t i = relative_count; i < rela_count; ++i) {
     const iree_elf_rela_t* rela = &rela_table[i];
     uint32_t type = IREE_ELF_R_TYPE(rela->r_info);
     if (type == 0) continue;
@@ -84,8 +93,17 @@ static iree_status_t iree_elf_arch_riscv_apply_rela(
 #else   // IREE_ARCH_RISCV_64
 static iree_status_t iree_elf_arch_riscv_apply_rela(
     iree_elf_relocation_state_t* state, iree_host_size_t rela_count,
-    const iree_elf_rela_t* rela_table) {
-  for (iree_host_size_t i = 0; i < rela_count; ++i) {
+    iree_host_size_t relative_count, const iree_elf_rela_t* rela_table) {
+  // Fast path for the sorted R_RISCV_RELATIVE prefix indicated by
+  // DT_RELACOUNT: no symbol lookups or type dispatch required.
+  if (relative_count > rela_count) relative_count = rela_count;
+  for (iree_host_size_t i = 0; i < relative_count; ++i) {
+    const iree_elf_rela_t* rela = &rela_table[i];
+    *(uint64_t*)(state->vaddr_bias + rela->r_offset) =
+        (uint64_t)(state->vaddr_bias + rela->r_addend);
+  }
+
+  for (iree_host_size_t i = relative_count; i < rela_count; ++i) {
     const iree_elf_rela_t* rela = &rela_table[i];
     uint32_t type = IREE_ELF_R_TYPE(rela->r_info);
     if (type == 0) continue;
@@ -133,6 +151,7 @@ iree_status_t iree_elf_arch_apply_relocations(
     iree_elf_relocation_state_t* state) {
   // Gather the relevant relocation tables.
   iree_host_size_t rela_count = 0;
+  iree_host_size_t rela_relative_count = 0;
   const iree_elf_rela_t* rela_table = NULL;
   for (iree_host_size_t i = 0; i < state->dyn_table_count; ++i) {
     const iree_elf_dyn_t* dyn = &state->dyn_table[i];
@@ -144,6 +163,10 @@ iree_status_t iree_elf_arch_apply_relocations(
       case IREE_ELF_DT_RELASZ:
         rela_count = dyn->d_un.d_val / sizeof(iree_elf_rela_t);
         break;
+      case IREE_ELF_DT_RELACOUNT:
+        // Count of relative relocations sorted to the front of DT_RELA.
+        rela_relative_count = dyn->d_un.d_val;
+        break;
 
       case IREE_ELF_DT_REL:
       case IREE_ELF_DT_RELSZ:
@@ -157,8 +180,8 @@ iree_status_t iree_elf_arch_apply_relocations(
   if (!rela_table) rela_count = 0;
 
   if (rela_count > 0) {
-    IREE_RETURN_IF_ERROR(
-        iree_elf_arch_riscv_apply_rela(state, rela_count, rela_table));
+    IREE_RETURN_IF_ERROR(iree_elf_arch_riscv_apply_rela(
+        state, rela_count, rela_relative_count, rela_table));
   }
 
   return iree_ok_status();
@@ -240,11 +240,20 @@ static iree_status_t iree_elf_module_load_segments(
 
   // Reserve virtual address space in the host memory space. This memory is
   // uncommitted by default as the ELF may only sparsely use the address space.
+  // Modules spanning at least one large page request large page backing to
+  // reduce iTLB/dTLB pressure on their text and constant pools; platforms
+  // without support fall back to normal pages transparently.
   module->vaddr_size = iree_page_align_end(
       vaddr_range.length, load_state->memory_info.normal_page_size);
-  IREE_RETURN_IF_ERROR(iree_memory_view_reserve(
-      IREE_MEMORY_VIEW_FLAG_MAY_EXECUTE, module->vaddr_size,
-      module->host_allocator, (void**)&module->vaddr_base));
+  iree_memory_view_flags_t view_flags = IREE_MEMORY_VIEW_FLAG_MAY_EXECUTE;
+  if (load_state->memory_info.large_page_granularity > 0 &&
+      module->vaddr_size >= load_state->memory_info.large_page_granularity) {
+    view_flags |= IREE_MEMORY_VIEW_FLAG_LARGE_PAGES;
+  }
+  IREE_RETURN_IF_ERROR(
+      iree_memory_view_reserve(view_flags, module->vaddr_size,
+                               module->host_allocator,
+                               (void**)&module->vaddr_base));
   module->vaddr_bias = module->vaddr_base - vaddr_range.offset;
 
   // Commit and load all of the segments.
@@ -259,7 +268,7 @@ static iree_status_t iree_elf_module_load_segments(
         .length = phdr->p_memsz,
     };
     IREE_RETURN_IF_ERROR(iree_memory_view_commit_ranges(
-        module->vaddr_bias, 1, &byte_range,
+        view_flags, module->vaddr_bias, 1, &byte_range,
         IREE_MEMORY_ACCESS_READ | IREE_MEMORY_ACCESS_WRITE));
 
     // Copy data present in the file.
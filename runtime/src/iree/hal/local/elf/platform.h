@@ -48,6 +48,14 @@ enum iree_memory_view_flag_bits_t {
   // Indicates that the memory may be used to execute code.
   // May be used to ask for special privileges (like MAP_JIT on MacOS).
   IREE_MEMORY_VIEW_FLAG_MAY_EXECUTE = 1u << 10,
+
+  // Requests that the view be backed by large/huge pages (2MB on most
+  // platforms) to reduce TLB pressure on large text and constant data.
+  // Best-effort: platforms transparently fall back to normal pages when large
+  // pages are unavailable or the privilege is missing. Callers should check
+  // iree_memory_info_t::large_page_granularity and only request large pages
+  // for views at least that size.
+  IREE_MEMORY_VIEW_FLAG_LARGE_PAGES = 1u << 11,
 };
 typedef uint32_t iree_memory_view_flags_t;
 
@@ -72,11 +80,13 @@ void iree_memory_view_release(void* base_address, iree_host_size_t total_length,
 
 // Commits pages overlapping the byte ranges defined by |byte_ranges|.
 // Ranges will be adjusted to the page granularity of the view.
+// |flags| must match those used when reserving the view.
 //
 // Implemented by VirtualAlloc+MEM_COMMIT/mmap+!PROT_NONE.
 iree_status_t iree_memory_view_commit_ranges(
-    void* base_address, iree_host_size_t range_count,
-    const iree_byte_range_t* ranges, iree_memory_access_t initial_access);
+    iree_memory_view_flags_t flags, void* base_address,
+    iree_host_size_t range_count, const iree_byte_range_t* ranges,
+    iree_memory_access_t initial_access);
 
 // Changes the access protection of view byte ranges defined by |byte_ranges|.
 // Ranges will be adjusted to the page granularity of the view.
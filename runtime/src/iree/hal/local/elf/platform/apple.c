@@ -84,10 +84,15 @@ void iree_memory_view_release(void* base_address, iree_host_size_t total_length,
 }
 
 iree_status_t iree_memory_view_commit_ranges(
-    void* base_address, iree_host_size_t range_count,
-    const iree_byte_range_t* ranges, iree_memory_access_t initial_access) {
+    iree_memory_view_flags_t flags, void* base_address,
+    iree_host_size_t range_count, const iree_byte_range_t* ranges,
+    iree_memory_access_t initial_access) {
   IREE_TRACE_ZONE_BEGIN(z0);
 
+  // NOTE: IREE_MEMORY_VIEW_FLAG_LARGE_PAGES is ignored; superpages require
+  // dedicated mach allocations incompatible with the reserve+commit pattern
+  // used here and the default page size is already 16KB on arm64.
+
   int mmap_prot = iree_memory_access_to_prot(initial_access);
   int mmap_flags = MAP_PRIVATE | MAP_ANON | MAP_FIXED;
 
@@ -41,6 +41,17 @@ iree_status_t iree_memory_view_reserve(iree_memory_view_flags_t flags,
                               "mmap reservation failed");
   }
 
+#if defined(MADV_HUGEPAGE)
+  if (iree_status_is_ok(status) &&
+      (flags & IREE_MEMORY_VIEW_FLAG_LARGE_PAGES)) {
+    // Ask for transparent huge pages to reduce TLB pressure. We use THP
+    // instead of MAP_HUGETLB so that we don't require a preallocated hugetlbfs
+    // pool and fall back to normal pages transparently. Advisory-only:
+    // failures are ignored.
+    madvise(base_address, total_length, MADV_HUGEPAGE);
+  }
+#endif  // MADV_HUGEPAGE
+
   *out_base_address = base_address;
   IREE_TRACE_ZONE_END(z0);
   return status;
@@ -57,8 +68,9 @@ void iree_memory_view_release(void* base_address, iree_host_size_t total_length,
 }
 
 iree_status_t iree_memory_view_commit_ranges(
-    void* base_address, iree_host_size_t range_count,
-    const iree_byte_range_t* ranges, iree_memory_access_t initial_access) {
+    iree_memory_view_flags_t flags, void* base_address,
+    iree_host_size_t range_count, const iree_byte_range_t* ranges,
+    iree_memory_access_t initial_access) {
   IREE_TRACE_ZONE_BEGIN(z0);
 
   int mmap_prot = iree_memory_access_to_prot(initial_access);
@@ -77,6 +89,13 @@ iree_status_t iree_memory_view_commit_ranges(
                                 "mmap commit failed");
       break;
     }
+#if defined(MADV_HUGEPAGE)
+    if (flags & IREE_MEMORY_VIEW_FLAG_LARGE_PAGES) {
+      // The MAP_FIXED mmap above replaced the reservation VMA and dropped the
+      // advice set during reserve; re-apply it to the committed range.
+      madvise(range_start, aligned_length, MADV_HUGEPAGE);
+    }
+#endif  // MADV_HUGEPAGE
   }
 
   IREE_TRACE_ZONE_END(z0);
@@ -64,10 +64,15 @@ void iree_memory_view_release(void* base_address, iree_host_size_t total_length,
 }
 
 iree_status_t iree_memory_view_commit_ranges(
-    void* base_address, iree_host_size_t range_count,
-    const iree_byte_range_t* ranges, iree_memory_access_t initial_access) {
+    iree_memory_view_flags_t flags, void* base_address,
+    iree_host_size_t range_count, const iree_byte_range_t* ranges,
+    iree_memory_access_t initial_access) {
   IREE_TRACE_ZONE_BEGIN(z0);
 
+  // NOTE: IREE_MEMORY_VIEW_FLAG_LARGE_PAGES is ignored; MEM_LARGE_PAGES
+  // requires SeLockMemoryPrivilege and a single reserve+commit allocation so
+  // it cannot be applied to the sparse commit pattern used here.
+
   DWORD initial_protect =
       iree_memory_access_to_win32_page_flags(initial_access);
 
@@ -470,6 +470,74 @@ iree_status_t iree_hal_executable_plugin_manager_register_plugin(
       manager, iree_hal_executable_plugin_provider(plugin), plugin);
 }
 
+iree_status_t iree_hal_executable_plugin_manager_replace_plugin(
+    iree_hal_executable_plugin_manager_t* manager,
+    iree_hal_executable_plugin_t* plugin) {
+  IREE_ASSERT_ARGUMENT(manager);
+  IREE_ASSERT_ARGUMENT(plugin);
+
+  // Hold the mutex to block other writers; readers continue resolving against
+  // whatever version they observe.
+  iree_slim_mutex_lock(&manager->mutex);
+
+  // Find the most recently registered plugin with the same identifier.
+  iree_hal_executable_plugin_t* old_plugin = NULL;
+  for (int32_t i = manager->plugin_count - 1; i >= 0; --i) {
+    if (iree_string_view_equal(manager->plugins[i]->identifier,
+                               plugin->identifier)) {
+      old_plugin = manager->plugins[i];
+      break;
+    }
+  }
+
+  // Find the provider slot routing to the old version. A plugin may have been
+  // replaced already in which case only the newest version has a slot.
+  int32_t provider_slot = -1;
+  if (old_plugin) {
+    int32_t provider_count = iree_atomic_load_int32(&manager->provider_count,
+                                                    iree_memory_order_acquire);
+    for (int32_t i = provider_count - 1; i >= 0; --i) {
+      if (manager->providers[i].self == old_plugin &&
+          manager->providers[i].resolve == iree_hal_executable_plugin_resolve) {
+        provider_slot = i;
+        break;
+      }
+    }
+  }
+  if (provider_slot < 0) {
+    iree_slim_mutex_unlock(&manager->mutex);
+    return iree_make_status(
+        IREE_STATUS_NOT_FOUND,
+        "no registered plugin `%.*s` to replace; register the plugin instead",
+        (int)plugin->identifier.size, plugin->identifier.data);
+  }
+  if (manager->plugin_count >= manager->capacity) {
+    iree_slim_mutex_unlock(&manager->mutex);
+    return iree_make_status(IREE_STATUS_RESOURCE_EXHAUSTED,
+                            "import manager capacity of %d reached",
+                            manager->capacity);
+  }
+
+  // Keep the new version live for the manager lifetime. The old version stays
+  // in the plugin list as well: executables loaded before the swap hold
+  // resolved import pointers into its code and drain on it until the manager
+  // is destroyed.
+  iree_hal_executable_plugin_retain(plugin);
+  manager->plugins[manager->plugin_count++] = plugin;
+
+  // Swap resolution over to the new version. The resolve fn of the slot is
+  // unchanged so concurrent readers that copied the provider struct observe
+  // either the old or the new self pointer - never a torn provider. A release
+  // operation on provider_count publishes the store to readers that acquire
+  // the count after this point.
+  manager->providers[provider_slot].self = plugin;
+  iree_atomic_fetch_add_int32(&manager->provider_count, 0,
+                              iree_memory_order_release);
+
+  iree_slim_mutex_unlock(&manager->mutex);
+  return iree_ok_status();
+}
+
 // Resolves |count| imports given |symbol_names| and stores pointers to their
 // implementation in |out_fn_ptrs| and optional contexts in |out_fn_contexts|.
 //
@@ -110,6 +110,24 @@ iree_status_t iree_hal_executable_plugin_manager_register_plugin(
     iree_hal_executable_plugin_manager_t* manager,
     iree_hal_executable_plugin_t* plugin);
 
+// Replaces the most recently registered plugin sharing the identifier of
+// |plugin| with the new version without interrupting concurrent resolution.
+// The swap is atomic with respect to readers: executables created after the
+// call resolve imports against the new plugin while executables loaded before
+// it keep the import pointers they already resolved. Because those resolved
+// pointers reference code in the prior version the prior version remains
+// registered (but no longer resolves) until the manager is destroyed; callers
+// hot-reloading frequently should bound the number of live versions with the
+// manager capacity.
+//
+// The new plugin will be retained for the lifetime of the manager.
+// Returns NOT_FOUND if no plugin with a matching identifier was registered;
+// use iree_hal_executable_plugin_manager_register_plugin for first-time
+// registration.
+iree_status_t iree_hal_executable_plugin_manager_replace_plugin(
+    iree_hal_executable_plugin_manager_t* manager,
+    iree_hal_executable_plugin_t* plugin);
+
 // Returns an import provider using the manager to resolve imports.
 // Note that the provider reference does not keep the manager alive and the
 // caller must ensure the manager remains live for the duration of any provider
@@ -22,11 +22,21 @@
 // iree_hal_inline_command_buffer_t
 //===----------------------------------------------------------------------===//
 
+// Default total workgroup count at or above which dispatches are routed to an
+// attached delegate. Workgroups of dispatches worth parallelizing are
+// typically 10s of microseconds or more of work each and the fan-out overhead
+// amortizes quickly; below this the serial loop is usually faster.
+#define IREE_HAL_INLINE_DISPATCH_DELEGATE_DEFAULT_THRESHOLD 8
+
 // Inline synchronous one-shot command "buffer".
 typedef struct iree_hal_inline_command_buffer_t {
   iree_hal_command_buffer_t base;
   iree_allocator_t host_allocator;
 
+  // Optional delegate that large dispatches are routed to; when fn is NULL all
+  // dispatches execute serially on the calling thread.
+  iree_hal_inline_dispatch_delegate_t dispatch_delegate;
+
   struct {
     // A flattened list of all available descriptor set bindings.
     // As descriptor sets are pushed/bound the bindings will be updated to
@@ -195,6 +205,14 @@ bool iree_hal_inline_command_buffer_isa(
                               &iree_hal_inline_command_buffer_vtable);
 }
 
+void iree_hal_inline_command_buffer_set_dispatch_delegate(
+    iree_hal_command_buffer_t* base_command_buffer,
+    iree_hal_inline_dispatch_delegate_t delegate) {
+  iree_hal_inline_command_buffer_t* command_buffer =
+      iree_hal_inline_command_buffer_cast(base_command_buffer);
+  command_buffer->dispatch_delegate = delegate;
+}
+
 //===----------------------------------------------------------------------===//
 // iree_hal_inline_command_buffer_t recording
 //===----------------------------------------------------------------------===//
@@ -515,6 +533,24 @@ static iree_status_t iree_hal_inline_command_buffer_dispatch(
         command_buffer->state.full_binding_lengths[binding_ordinal];
   }
 
+  // Route wide dispatches to the attached delegate (if any) so they can fan
+  // out across a thread pool while narrow dispatches stay on the calling
+  // thread and keep the zero-overhead inline path.
+  if (command_buffer->dispatch_delegate.fn) {
+    uint32_t threshold =
+        command_buffer->dispatch_delegate.workgroup_count_threshold;
+    if (threshold == 0) {
+      threshold = IREE_HAL_INLINE_DISPATCH_DELEGATE_DEFAULT_THRESHOLD;
+    }
+    const uint64_t total_workgroup_count =
+        (uint64_t)workgroup_x * workgroup_y * workgroup_z;
+    if (total_workgroup_count >= threshold) {
+      return command_buffer->dispatch_delegate.fn(
+          command_buffer->dispatch_delegate.user_data, executable,
+          (iree_host_size_t)entry_point, dispatch_state);
+    }
+  }
+
   // TODO(benvanik): plumb through an arena or fixed-size reservation to use.
   // For now when deploying to devices where you want something like the
   // inline command buffer you probably don't want 256KB of transient memory
@@ -9,11 +9,36 @@
 
 #include "iree/base/api.h"
 #include "iree/hal/api.h"
+#include "iree/hal/local/executable_library.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif  // __cplusplus
 
+// Function called to execute a single dispatch on behalf of an inline command
+// buffer. |dispatch_state| is fully populated (workgroup counts, push
+// constants, and resolved binding pointers) and only valid for the duration of
+// the call; implementations must complete the dispatch before returning.
+typedef iree_status_t(IREE_API_PTR* iree_hal_inline_dispatch_delegate_fn_t)(
+    void* user_data, iree_hal_executable_t* executable,
+    iree_host_size_t entry_point,
+    const iree_hal_executable_dispatch_state_v0_t* dispatch_state);
+
+// An optional delegate that large dispatches are routed to instead of being
+// executed one workgroup at a time on the calling thread. This lets devices
+// with a thread pool (such as the task system) attach it for wide dispatches
+// while small dispatches keep the zero-overhead inline path.
+typedef struct iree_hal_inline_dispatch_delegate_t {
+  // Called with each dispatch whose total workgroup count meets the threshold.
+  iree_hal_inline_dispatch_delegate_fn_t fn;
+  // Opaque user data passed to |fn|. Must remain valid for the lifetime of the
+  // command buffer.
+  void* user_data;
+  // Total workgroup count (x*y*z) at or above which dispatches are routed to
+  // the delegate. 0 uses a reasonable default.
+  uint32_t workgroup_count_threshold;
+} iree_hal_inline_dispatch_delegate_t;
+
 // Returns the size, in bytes, of an inline command buffer.
 // This can be used for arena/stack allocations along with
 // iree_hal_inline_command_buffer_initialize/iree_hal_inline_command_buffer_deinitialize.
@@ -59,6 +84,13 @@ iree_status_t iree_hal_inline_command_buffer_create(
 bool iree_hal_inline_command_buffer_isa(
     iree_hal_command_buffer_t* command_buffer);
 
+// Sets the dispatch |delegate| that dispatches with large workgroup counts
+// are routed to. Pass a zero-initialized delegate to restore the default
+// behavior of executing all dispatches on the calling thread.
+void iree_hal_inline_command_buffer_set_dispatch_delegate(
+    iree_hal_command_buffer_t* command_buffer,
+    iree_hal_inline_dispatch_delegate_t delegate);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -40,6 +40,13 @@ typedef struct iree_hal_resource_t {
   // IREE_HAL_VTABLE_DISPATCH and not equality/direct dereferencing.
   const void* vtable;
 
+  // Generation stamp of the most recent resource set interning epoch that
+  // retained this resource. Resource sets use this to elide redundant
+  // insertions when command buffers are re-recorded against unchanged
+  // resources; see iree/hal/utils/resource_set.h. Epoch values are globally
+  // unique and never reused so a stale stamp can never match a live set.
+  iree_atomic_int64_t intern_epoch;
+
   // TODO(benvanik): debug string/logging utilities.
 } iree_hal_resource_t;
 
@@ -69,6 +76,8 @@ static inline void iree_hal_resource_initialize(
     const void* vtable, iree_hal_resource_t* out_resource) {
   iree_atomic_ref_count_init(&out_resource->ref_count);
   out_resource->vtable = vtable;
+  iree_atomic_store_int64(&out_resource->intern_epoch, 0,
+                          iree_memory_order_relaxed);
 }
 
 // Retains a resource for the caller.
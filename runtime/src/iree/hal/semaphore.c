@@ -79,6 +79,26 @@ IREE_API_EXPORT iree_status_t iree_hal_semaphore_wait(
   return status;
 }
 
+IREE_API_EXPORT iree_status_t iree_hal_semaphore_export_timepoint(
+    iree_hal_semaphore_t* semaphore, uint64_t value,
+    iree_wait_primitive_type_t target_type,
+    iree_wait_primitive_t* out_wait_primitive) {
+  IREE_ASSERT_ARGUMENT(semaphore);
+  IREE_ASSERT_ARGUMENT(out_wait_primitive);
+  memset(out_wait_primitive, 0, sizeof(*out_wait_primitive));
+  if (!_VTABLE_DISPATCH(semaphore, export_timepoint)) {
+    return iree_make_status(IREE_STATUS_UNAVAILABLE,
+                            "semaphore implementation does not support "
+                            "exporting timepoint wait primitives");
+  }
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, value);
+  iree_status_t status = _VTABLE_DISPATCH(semaphore, export_timepoint)(
+      semaphore, value, target_type, out_wait_primitive);
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
 iree_status_t iree_hal_semaphore_wait_source_ctl(
     iree_wait_source_t wait_source, iree_wait_source_command_t command,
     const void* params, void** inout_ptr) {
@@ -108,14 +128,10 @@ iree_status_t iree_hal_semaphore_wait_source_ctl(
     case IREE_WAIT_SOURCE_COMMAND_EXPORT: {
       const iree_wait_primitive_type_t target_type =
           ((const iree_wait_source_export_params_t*)params)->target_type;
-      // TODO(benvanik): support exporting semaphores to real wait handles.
       iree_wait_primitive_t* out_wait_primitive =
           (iree_wait_primitive_t*)inout_ptr;
-      memset(out_wait_primitive, 0, sizeof(*out_wait_primitive));
-      (void)target_type;
-      return iree_make_status(IREE_STATUS_UNAVAILABLE,
-                              "requested wait primitive type %d is unavailable",
-                              (int)target_type);
+      return iree_hal_semaphore_export_timepoint(
+          semaphore, target_value, target_type, out_wait_primitive);
     }
     default:
       return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
@@ -138,6 +138,28 @@ IREE_API_EXPORT iree_status_t iree_hal_semaphore_wait(
 IREE_API_EXPORT iree_wait_source_t
 iree_hal_semaphore_await(iree_hal_semaphore_t* semaphore, uint64_t value);
 
+// Exports a native wait primitive that is signaled when |semaphore| reaches or
+// exceeds the specified payload |value|. |target_type| restricts the primitive
+// type exported; use IREE_WAIT_PRIMITIVE_TYPE_ANY to accept whatever the
+// implementation can produce (eventfds on Linux, etc). This allows external
+// reactors (epoll/kqueue loops and the like) to multiplex many timepoints
+// without dedicating waiter threads.
+//
+// If the timepoint has already been reached an immediate primitive is returned
+// and callers can check it with iree_wait_primitive_is_immediate.
+//
+// The returned primitive remains owned by the semaphore and is valid until the
+// semaphore is destroyed; callers must not close it. Each call may allocate a
+// new primitive and callers multiplexing should export once per timepoint.
+//
+// Returns IREE_STATUS_UNAVAILABLE if the semaphore implementation cannot
+// export wait primitives (or not of |target_type|); callers should fall back
+// to iree_hal_semaphore_wait.
+IREE_API_EXPORT iree_status_t iree_hal_semaphore_export_timepoint(
+    iree_hal_semaphore_t* semaphore, uint64_t value,
+    iree_wait_primitive_type_t target_type,
+    iree_wait_primitive_t* out_wait_primitive);
+
 //===----------------------------------------------------------------------===//
 // iree_hal_semaphore_list_t
 //===----------------------------------------------------------------------===//
@@ -204,6 +226,13 @@ typedef struct iree_hal_semaphore_vtable_t {
 
   iree_status_t(IREE_API_PTR* wait)(iree_hal_semaphore_t* semaphore,
                                     uint64_t value, iree_timeout_t timeout);
+
+  // Optional; implementations that cannot export leave this NULL and callers
+  // receive IREE_STATUS_UNAVAILABLE.
+  iree_status_t(IREE_API_PTR* export_timepoint)(
+      iree_hal_semaphore_t* semaphore, uint64_t value,
+      iree_wait_primitive_type_t target_type,
+      iree_wait_primitive_t* out_wait_primitive);
 } iree_hal_semaphore_vtable_t;
 IREE_HAL_ASSERT_VTABLE_LAYOUT(iree_hal_semaphore_vtable_t);
 
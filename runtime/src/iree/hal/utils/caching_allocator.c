@@ -30,6 +30,14 @@ void iree_hal_caching_allocator_pool_params_initialize(
       IREE_HAL_CACHING_ALLOCATOR_DEFAULT_FREE_LIST_CAPACITY;
 }
 
+// An available buffer retained on a pool free list.
+typedef struct iree_hal_caching_allocator_free_entry_t {
+  // Buffer that is retained while on the free list.
+  iree_hal_buffer_t* buffer;
+  // Time the buffer was released to the pool; used for age-based trimming.
+  iree_time_t release_timestamp;
+} iree_hal_caching_allocator_free_entry_t;
+
 // Pool of arbitrarily-sized device allocations for a particular heap.
 // This maintains a free list of blocks available for use but does not track
 // outstanding allocations.
@@ -63,13 +71,22 @@ typedef iree_alignas(
   // Total size, in bytes, of all free buffers currently in this pool.
   iree_device_size_t free_allocated_size;
 
+  IREE_STATISTICS(struct {
+    // Peak of free_allocated_size over the pool lifetime.
+    iree_device_size_t free_bytes_peak;
+    // Total number of allocation requests serviced from the free list.
+    int64_t hit_count;
+    // Total number of allocation requests requiring a device allocation.
+    int64_t miss_count;
+  } statistics;)
+
   // Flat MRU list of available buffers with max_free_allocation_count slots.
   // Sorted by ascending recency (the higher the index the more recent).
   // If we really cared about optimizing the interior removal then we'd want
   // a linked/skip list or some bucketing but that's really for the higher
   // level allocators to do.
   iree_host_size_t free_count;
-  iree_hal_buffer_t* free_buffers[];
+  iree_hal_caching_allocator_free_entry_t free_entries[];
 } iree_hal_caching_allocator_pool_t;
 
 static void iree_hal_caching_allocator_pool_trim(
@@ -88,6 +105,8 @@ static void iree_hal_caching_allocator_pool_initialize(
   iree_slim_mutex_initialize(&out_pool->mutex);
   out_pool->total_allocated_size = 0;
   out_pool->free_allocated_size = 0;
+  IREE_STATISTICS(memset(&out_pool->statistics, 0,
+                         sizeof(out_pool->statistics)));
   out_pool->free_count = 0;
 
   IREE_TRACE_SET_PLOT_TYPE(IREE_HAL_CACHING_ALLOCATOR_ID,
@@ -133,10 +152,15 @@ static void iree_hal_caching_allocator_pool_push_buffer(
 
   // Add to the end of the list (the most recent).
   iree_host_size_t i = pool->free_count++;
-  pool->free_buffers[i] = buffer;
+  pool->free_entries[i].buffer = buffer;
+  pool->free_entries[i].release_timestamp = iree_time_now();
 
   // Track that we're now retaining unused memory.
   pool->free_allocated_size += buffer->allocation_size;
+  IREE_STATISTICS({
+    pool->statistics.free_bytes_peak = iree_max(
+        pool->statistics.free_bytes_peak, pool->free_allocated_size);
+  });
   IREE_TRACE_PLOT_VALUE_I64(IREE_HAL_CACHING_ALLOCATOR_ID,
                             pool->free_allocated_size);
 }
@@ -148,11 +172,11 @@ static void iree_hal_caching_allocator_pool_push_buffer(
 // Must be called with the pool mutex held.
 static iree_hal_buffer_t* iree_hal_caching_allocator_pool_take_buffer_at(
     iree_hal_caching_allocator_pool_t* pool, iree_host_size_t i) {
-  iree_hal_buffer_t* buffer = pool->free_buffers[i];
+  iree_hal_buffer_t* buffer = pool->free_entries[i].buffer;
   if (i < pool->free_count - 1) {
     // Shift the list down to keep it dense and in ascending recency order.
-    memmove(&pool->free_buffers[i], &pool->free_buffers[i + 1],
-            (pool->free_count - i - 1) * sizeof(pool->free_buffers[0]));
+    memmove(&pool->free_entries[i], &pool->free_entries[i + 1],
+            (pool->free_count - i - 1) * sizeof(pool->free_entries[0]));
   }
   --pool->free_count;
   pool->free_allocated_size -= buffer->allocation_size;
@@ -174,7 +198,7 @@ static iree_hal_buffer_t* iree_hal_caching_allocator_pool_find_and_take_buffer(
     // NOTE: we are not currently checking alignment as we don't really have it.
     // We assume programs will use consistent alignments for a particular heap
     // (as the heap has a min alignment).
-    iree_hal_buffer_t* buffer = pool->free_buffers[i];
+    iree_hal_buffer_t* buffer = pool->free_entries[i].buffer;
     if (iree_all_bits_set(iree_hal_buffer_memory_type(buffer), params->type) &&
         iree_all_bits_set(iree_hal_buffer_allowed_usage(buffer),
                           params->usage) &&
@@ -197,10 +221,9 @@ static void iree_hal_caching_allocator_pool_trim_to_size(
   iree_slim_mutex_lock(&pool->mutex);
 
   while (pool->free_count > 0 && pool->total_allocated_size > target_size) {
-    // Take the oldest buffer in the list.
+    // Take the least recently used buffer at the head of the list.
     iree_hal_buffer_t* dead_buffer =
-        iree_hal_caching_allocator_pool_take_buffer_at(pool,
-                                                       pool->free_count - 1);
+        iree_hal_caching_allocator_pool_take_buffer_at(pool, 0);
 
     // NOTE: we've removed the buffer but have not subtracted the size from
     // the total yet - we want to do that only after releasing the buffer.
@@ -224,6 +247,44 @@ static void iree_hal_caching_allocator_pool_trim_to_size(
   IREE_TRACE_ZONE_END(z0);
 }
 
+// Trims |pool| down to at most |target_free_size| bytes of retained free
+// buffers, releasing the least recently used first. Free buffers released to
+// the pool before |deadline_ns| are released regardless of the target; pass
+// IREE_TIME_INFINITE_PAST to trim on the size target alone.
+//
+// Thread-safe; multiple threads may concurrently access the |pool|.
+static void iree_hal_caching_allocator_pool_trim_free(
+    iree_hal_caching_allocator_pool_t* pool, iree_device_size_t target_free_size,
+    iree_time_t deadline_ns) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, (int64_t)target_free_size);
+
+  iree_slim_mutex_lock(&pool->mutex);
+
+  while (pool->free_count > 0 &&
+         (pool->free_allocated_size > target_free_size ||
+          pool->free_entries[0].release_timestamp < deadline_ns)) {
+    // Take the least recently used buffer at the head of the list.
+    iree_hal_buffer_t* dead_buffer =
+        iree_hal_caching_allocator_pool_take_buffer_at(pool, 0);
+    iree_device_size_t allocation_size =
+        iree_hal_buffer_allocation_size(dead_buffer);
+
+    // Release the buffer without holding the lock as deallocation can be slow.
+    iree_slim_mutex_unlock(&pool->mutex);
+    iree_hal_allocator_deallocate_buffer(pool->device_allocator, dead_buffer);
+    iree_slim_mutex_lock(&pool->mutex);
+
+    // Update accounting to represent that we've released the buffer.
+    IREE_ASSERT_GE(pool->total_allocated_size, allocation_size);
+    pool->total_allocated_size -= allocation_size;
+  }
+
+  iree_slim_mutex_unlock(&pool->mutex);
+
+  IREE_TRACE_ZONE_END(z0);
+}
+
 // Releases all unused buffers in |pool| to the underlying device allocator.
 //
 // The pool mutex must not be held by the caller.
@@ -254,6 +315,9 @@ static iree_status_t iree_hal_caching_allocator_pool_acquire(
     // We'll need to allocate so we add the size such that it'll be accounted
     // for by other threads allocating at the same time.
     pool->total_allocated_size += allocation_size;
+    IREE_STATISTICS(++pool->statistics.miss_count);
+  } else {
+    IREE_STATISTICS(++pool->statistics.hit_count);
   }
   iree_slim_mutex_unlock(&pool->mutex);
   if (existing_buffer) {
@@ -406,7 +470,7 @@ iree_status_t iree_hal_caching_allocator_create_with_pools(
   for (iree_host_size_t i = 0; i < pool_count; ++i) {
     iree_hal_caching_allocator_pool_t* pool = NULL;
     total_size += iree_host_align(
-        sizeof(*pool) + sizeof(pool->free_buffers[0]) *
+        sizeof(*pool) + sizeof(pool->free_entries[0]) *
                             pool_params[i].max_free_allocation_count,
         iree_max_align_t);
   }
@@ -428,7 +492,7 @@ iree_status_t iree_hal_caching_allocator_create_with_pools(
     iree_hal_caching_allocator_pool_t* pool =
         (iree_hal_caching_allocator_pool_t*)pool_ptr;
     pool_ptr += iree_host_align(
-        sizeof(*pool) + sizeof(pool->free_buffers[0]) *
+        sizeof(*pool) + sizeof(pool->free_entries[0]) *
                             pool_params[i].max_free_allocation_count,
         iree_max_align_t);
     allocator->pools[i] = pool;
@@ -616,6 +680,65 @@ static iree_allocator_t iree_hal_caching_allocator_host_allocator(
   return allocator->host_allocator;
 }
 
+iree_status_t iree_hal_caching_allocator_trim_to_watermark(
+    iree_hal_allocator_t* base_allocator, iree_device_size_t target_free_bytes,
+    iree_duration_t max_age_ns) {
+  iree_hal_caching_allocator_t* allocator =
+      iree_hal_caching_allocator_cast(base_allocator);
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, (int64_t)target_free_bytes);
+
+  // Entries released to a pool before this time are dropped regardless of the
+  // watermark; with an infinite age only the watermark applies.
+  iree_time_t deadline_ns = max_age_ns == IREE_DURATION_INFINITE
+                                ? IREE_TIME_INFINITE_PAST
+                                : iree_time_now() - max_age_ns;
+
+  // First pass: apply the age deadline to every pool and measure how much
+  // cached memory remains. Values may shift while we walk but this is a
+  // best-effort maintenance operation invoked from idle handlers.
+  iree_device_size_t total_free_bytes = 0;
+  for (iree_host_size_t i = 0; i < allocator->pool_count; ++i) {
+    iree_hal_caching_allocator_pool_t* pool = allocator->pools[i];
+    iree_hal_caching_allocator_pool_trim_free(pool, IREE_DEVICE_SIZE_MAX,
+                                              deadline_ns);
+    iree_slim_mutex_lock(&pool->mutex);
+    total_free_bytes += pool->free_allocated_size;
+    iree_slim_mutex_unlock(&pool->mutex);
+  }
+
+  // Second pass: while over the watermark release the least recently used
+  // entry across all pools.
+  while (total_free_bytes > target_free_bytes) {
+    iree_hal_caching_allocator_pool_t* oldest_pool = NULL;
+    iree_time_t oldest_timestamp = IREE_TIME_INFINITE_FUTURE;
+    for (iree_host_size_t i = 0; i < allocator->pool_count; ++i) {
+      iree_hal_caching_allocator_pool_t* pool = allocator->pools[i];
+      iree_slim_mutex_lock(&pool->mutex);
+      if (pool->free_count > 0 &&
+          pool->free_entries[0].release_timestamp < oldest_timestamp) {
+        oldest_timestamp = pool->free_entries[0].release_timestamp;
+        oldest_pool = pool;
+      }
+      iree_slim_mutex_unlock(&pool->mutex);
+    }
+    if (!oldest_pool) break;  // all pools empty (raced with another trim)
+    iree_device_size_t pool_free_bytes = 0;
+    iree_slim_mutex_lock(&oldest_pool->mutex);
+    pool_free_bytes = oldest_pool->free_allocated_size;
+    iree_slim_mutex_unlock(&oldest_pool->mutex);
+    iree_hal_caching_allocator_pool_trim_free(
+        oldest_pool, pool_free_bytes > 0 ? pool_free_bytes - 1 : 0,
+        IREE_TIME_INFINITE_PAST);
+    iree_slim_mutex_lock(&oldest_pool->mutex);
+    total_free_bytes -= pool_free_bytes - oldest_pool->free_allocated_size;
+    iree_slim_mutex_unlock(&oldest_pool->mutex);
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
 static iree_status_t iree_hal_caching_allocator_trim(
     iree_hal_allocator_t* IREE_RESTRICT base_allocator) {
   iree_hal_caching_allocator_t* allocator =
@@ -633,6 +756,20 @@ static void iree_hal_caching_allocator_query_statistics(
       iree_hal_caching_allocator_cast(base_allocator);
   iree_hal_allocator_query_statistics(allocator->device_allocator,
                                       out_statistics);
+  // Layer pool residency and hit/miss information on top of the underlying
+  // allocator statistics. Note that the peak is a sum of per-pool peaks and
+  // may slightly overestimate the true simultaneous peak.
+  IREE_STATISTICS({
+    for (iree_host_size_t i = 0; i < allocator->pool_count; ++i) {
+      iree_hal_caching_allocator_pool_t* pool = allocator->pools[i];
+      iree_slim_mutex_lock(&pool->mutex);
+      out_statistics->pool_bytes_resident += pool->free_allocated_size;
+      out_statistics->pool_bytes_peak += pool->statistics.free_bytes_peak;
+      out_statistics->pool_hit_count += pool->statistics.hit_count;
+      out_statistics->pool_miss_count += pool->statistics.miss_count;
+      iree_slim_mutex_unlock(&pool->mutex);
+    }
+  });
 }
 
 static iree_status_t iree_hal_caching_allocator_query_memory_heaps(
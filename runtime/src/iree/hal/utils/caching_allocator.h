@@ -109,6 +109,23 @@ iree_status_t iree_hal_caching_allocator_create_from_spec(
     iree_string_view_t config_pairs, iree_hal_allocator_t* device_allocator,
     iree_allocator_t host_allocator, iree_hal_allocator_t** out_allocator);
 
+// Trims cached memory retained by |allocator| down to at most
+// |target_free_bytes|, releasing the least recently used allocations first.
+// Cached allocations that have sat unused for longer than |max_age_ns| are
+// released regardless of the watermark; pass IREE_DURATION_INFINITE to trim
+// by the watermark alone. Passing 0 for |target_free_bytes| is equivalent to
+// iree_hal_allocator_trim but does not trim the underlying allocator.
+//
+// Intended to be called from application idle handlers or memory pressure
+// callbacks to reclaim memory stranded in pools after allocation bursts.
+// The |allocator| must have been created by one of the functions above.
+//
+// Thread-safe; may race in-flight allocations and frees and the resulting
+// residency is best-effort.
+iree_status_t iree_hal_caching_allocator_trim_to_watermark(
+    iree_hal_allocator_t* allocator, iree_device_size_t target_free_bytes,
+    iree_duration_t max_age_ns);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
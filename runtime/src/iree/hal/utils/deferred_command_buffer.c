@@ -42,14 +42,19 @@ typedef enum iree_hal_command_type_e {
 // call such that the target command buffer cannot tell they were deferred.
 //
 // As each command is variable sized we store pointers to the following command
-// to allow us to walk the list during replay. Storing just a size would be
+// to allow us to walk the list during recording. Storing just a size would be
 // insufficient as commands may be spread across many arena blocks from the
-// block pool.
+// block pool. Once recording completes reusable command buffers pack the
+// commands into a single contiguous storage range sized from the recording
+// and replay uses the size to bump a cursor linearly instead.
 typedef struct iree_hal_cmd_header_t {
   // Next command in the list or NULL if the end.
   struct iree_hal_cmd_header_t* next;
   // Type of the command that follows.
   iree_hal_cmd_type_t type;
+  // Total size of the command struct in bytes including this header and any
+  // trailing inline storage (but not out-of-line cloned data).
+  iree_host_size_t size;
 } iree_hal_cmd_header_t;
 
 typedef iree_status_t (*iree_hal_cmd_apply_fn_t)(
@@ -71,6 +76,14 @@ typedef struct iree_hal_cmd_list_t {
   iree_hal_cmd_header_t* head;
   // Tail of the command list (may be head).
   iree_hal_cmd_header_t* tail;
+
+  // Total bytes of command structs recorded with each command padded out to
+  // iree_max_align_t; this is the exact size of the packed storage.
+  iree_host_size_t total_packed_size;
+  // Contiguous storage holding copies of all recorded commands in order or
+  // NULL if the command list has not been packed. Allocated from the arena
+  // and reclaimed with it on reset.
+  uint8_t* packed_commands;
 } iree_hal_cmd_list_t;
 
 // Initializes a new command list that allocates from the given |block_pool|.
@@ -80,6 +93,8 @@ static void iree_hal_cmd_list_initialize(iree_arena_block_pool_t* block_pool,
   iree_arena_initialize(block_pool, &out_cmd_list->arena);
   out_cmd_list->head = NULL;
   out_cmd_list->tail = NULL;
+  out_cmd_list->total_packed_size = 0;
+  out_cmd_list->packed_commands = NULL;
 }
 
 // Returns true if the |cmd_list| is empty.
@@ -96,6 +111,8 @@ static void iree_hal_cmd_list_reset(iree_hal_cmd_list_t* cmd_list) {
   iree_arena_reset(&cmd_list->arena);
   cmd_list->head = NULL;
   cmd_list->tail = NULL;
+  cmd_list->total_packed_size = 0;
+  cmd_list->packed_commands = NULL;
 }
 
 // Deinitializes the command list, preparing for destruction.
@@ -113,12 +130,15 @@ static iree_status_t iree_hal_cmd_list_append_command(
       iree_arena_allocate(&cmd_list->arena, command_size, (void**)&header));
   header->next = NULL;
   header->type = command_type;
+  header->size = command_size;
   if (!cmd_list->head) {
     cmd_list->head = header;
   } else if (cmd_list->tail) {
     cmd_list->tail->next = header;
   }
   cmd_list->tail = header;
+  cmd_list->total_packed_size +=
+      iree_host_align(command_size, iree_max_align_t);
   *out_cmd = header;
   return iree_ok_status();
 }
@@ -136,6 +156,29 @@ static iree_status_t iree_hal_cmd_list_clone_data(iree_hal_cmd_list_t* cmd_list,
   return iree_ok_status();
 }
 
+// Packs the recorded commands into a single contiguous storage range so that
+// replay can bump a cursor linearly instead of chasing the linked list across
+// arena blocks. The storage is reserved in one allocation using the exact
+// size measured during recording. Only the command structs are copied; any
+// out-of-line cloned data (barriers, update sources, etc) stays where it was
+// recorded in the arena and remains valid until the next reset.
+static iree_status_t iree_hal_cmd_list_pack(iree_hal_cmd_list_t* cmd_list) {
+  if (iree_hal_cmd_list_is_empty(cmd_list) || cmd_list->packed_commands) {
+    return iree_ok_status();
+  }
+  uint8_t* storage = NULL;
+  IREE_RETURN_IF_ERROR(iree_arena_allocate(
+      &cmd_list->arena, cmd_list->total_packed_size, (void**)&storage));
+  uint8_t* cursor = storage;
+  for (iree_hal_cmd_header_t* cmd = cmd_list->head; cmd != NULL;
+       cmd = cmd->next) {
+    memcpy(cursor, cmd, cmd->size);
+    cursor += iree_host_align(cmd->size, iree_max_align_t);
+  }
+  cmd_list->packed_commands = storage;
+  return iree_ok_status();
+}
+
 //===----------------------------------------------------------------------===//
 // iree_hal_deferred_command_buffer_t implementation
 //===----------------------------------------------------------------------===//
@@ -231,6 +274,14 @@ static iree_status_t iree_hal_deferred_command_buffer_end(
     iree_hal_command_buffer_t* base_command_buffer) {
   iree_hal_deferred_command_buffer_t* command_buffer =
       iree_hal_deferred_command_buffer_cast(base_command_buffer);
+  // Reusable command buffers may be replayed many times and get their commands
+  // packed contiguously for cheaper iteration. One-shot command buffers are
+  // replayed at most once and drop their commands immediately after so the
+  // extra copy would be wasted on them.
+  if (!iree_all_bits_set(command_buffer->base.mode,
+                         IREE_HAL_COMMAND_BUFFER_MODE_ONE_SHOT)) {
+    IREE_RETURN_IF_ERROR(iree_hal_cmd_list_pack(&command_buffer->cmd_list));
+  }
   iree_hal_resource_set_freeze(command_buffer->resource_set);
   return iree_ok_status();
 }
@@ -917,11 +968,25 @@ IREE_API_EXPORT iree_status_t iree_hal_deferred_command_buffer_apply(
 
   iree_status_t status = iree_hal_command_buffer_begin(target_command_buffer);
   if (iree_status_is_ok(status)) {
-    for (iree_hal_cmd_header_t* cmd = cmd_list->head; cmd != NULL;
-         cmd = cmd->next) {
-      status = iree_hal_cmd_apply_table[cmd->type](target_command_buffer,
-                                                   binding_table, cmd);
-      if (!iree_status_is_ok(status)) break;
+    if (cmd_list->packed_commands) {
+      // Reusable command buffers iterate the packed contiguous storage.
+      uint8_t* cursor = cmd_list->packed_commands;
+      uint8_t* end = cursor + cmd_list->total_packed_size;
+      while (cursor < end) {
+        iree_hal_cmd_header_t* cmd = (iree_hal_cmd_header_t*)cursor;
+        status = iree_hal_cmd_apply_table[cmd->type](target_command_buffer,
+                                                     binding_table, cmd);
+        if (!iree_status_is_ok(status)) break;
+        cursor += iree_host_align(cmd->size, iree_max_align_t);
+      }
+    } else {
+      // One-shot command buffers walk the linked list as recorded.
+      for (iree_hal_cmd_header_t* cmd = cmd_list->head; cmd != NULL;
+           cmd = cmd->next) {
+        status = iree_hal_cmd_apply_table[cmd->type](target_command_buffer,
+                                                     binding_table, cmd);
+        if (!iree_status_is_ok(status)) break;
+      }
     }
   }
   if (iree_status_is_ok(status)) {
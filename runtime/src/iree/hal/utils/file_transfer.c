@@ -17,10 +17,14 @@
 // can prune code paths or flags (somehow).
 
 #if !defined(IREE_HAL_TRANSFER_WORKER_LIMIT)
-// Maximum number of workers that will be used. This is something we can derive
-// from the transfer size and the loop; small transfers or synchronous loops
-// should have 1 and we can measure to see how many others we need.
-#define IREE_HAL_TRANSFER_WORKER_LIMIT 1
+// Maximum number of workers that will be used. Each worker owns one staging
+// chunk and while one worker waits for its device copy to complete the others
+// can be reading ahead in the file, keeping the file source and the device
+// transfer path busy concurrently. Staging memory is bounded by
+// worker count * chunk size. This is something we could derive from the
+// transfer size and the loop; small transfers or synchronous loops naturally
+// collapse to 1 as workers are never allocated beyond the chunks available.
+#define IREE_HAL_TRANSFER_WORKER_LIMIT 4
 #endif  // !IREE_HAL_TRANSFER_WORKER_LIMIT
 
 #if !defined(IREE_HAL_TRANSFER_CHUNK_SIZE)
@@ -33,7 +37,7 @@
 // Estimated number of chunks each worker should process used to determine how
 // many workers are needed as part of a transfer operation. Larger numbers will
 // reduce memory overhead at the cost of latency reductions.
-#define IREE_HAL_TRANSFER_CHUNKS_PER_WORKER 8
+#define IREE_HAL_TRANSFER_CHUNKS_PER_WORKER 4
 #endif  // IREE_HAL_TRANSFER_CHUNKS_PER_WORKER
 
 //===----------------------------------------------------------------------===//
@@ -189,6 +193,11 @@ static iree_status_t iree_hal_transfer_operation_create(
   worker_count =
       iree_min(worker_count, iree_min(IREE_HAL_TRANSFER_WORKER_LIMIT,
                                       IREE_HAL_TRANSFER_WORKER_MAX_COUNT));
+  // Never allocate more workers (and thus staging chunks) than there are
+  // chunks to transfer; extra workers would just reserve staging memory and
+  // immediately exit.
+  worker_count =
+      iree_min(worker_count, (iree_host_size_t)total_chunk_count);
 
   // Calculate total size of the structure with all its associated data.
   iree_hal_transfer_operation_t* operation = NULL;
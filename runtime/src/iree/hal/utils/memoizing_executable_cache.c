@@ -0,0 +1,310 @@
+// Copyright 2023 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/hal/utils/memoizing_executable_cache.h"
+
+#include <string.h>
+
+#include "iree/base/internal/synchronization.h"
+
+// Number of independently-locked hash table shards.
+// Preparation of executables landing in distinct shards proceeds fully in
+// parallel; this only needs to be large enough to make collisions across
+// concurrently-loading modules unlikely.
+#define IREE_HAL_MEMOIZING_EXECUTABLE_CACHE_SHARD_COUNT 8
+
+// Caching mode bits that change the contents of the prepared executable and
+// must match for an entry to be reused. Ownership-related bits (data aliasing,
+// persistence hints) are excluded as they do not alter the result.
+#define IREE_HAL_MEMOIZING_EXECUTABLE_CACHE_MODE_MASK               \
+  (~(iree_hal_executable_caching_mode_t)(                           \
+      IREE_HAL_EXECUTABLE_CACHING_MODE_ALIAS_PROVIDED_DATA |        \
+      IREE_HAL_EXECUTABLE_CACHING_MODE_ALLOW_PERSISTENT_CACHING))
+
+typedef struct iree_hal_memoizing_executable_cache_entry_t {
+  struct iree_hal_memoizing_executable_cache_entry_t* next;
+  // FNV-1a hash over the format, executable data, and constants.
+  uint64_t content_hash;
+  // Caching mode masked to content-relevant bits.
+  iree_hal_executable_caching_mode_t caching_mode;
+  // Format string stored in the trailing entry storage.
+  iree_string_view_t executable_format;
+  // Size of the executable data the entry was prepared from; the data itself
+  // is identified by |content_hash| and not retained.
+  iree_host_size_t executable_data_size;
+  iree_host_size_t pipeline_layout_count;
+  // Specialization constants stored in the trailing entry storage.
+  iree_host_size_t constant_count;
+  const uint32_t* constants;
+  // Prepared executable, retained for the lifetime of the cache.
+  iree_hal_executable_t* executable;
+} iree_hal_memoizing_executable_cache_entry_t;
+
+typedef struct iree_hal_memoizing_executable_cache_shard_t {
+  iree_slim_mutex_t mutex;
+  iree_hal_memoizing_executable_cache_entry_t* head IREE_GUARDED_BY(mutex);
+} iree_hal_memoizing_executable_cache_shard_t;
+
+typedef struct iree_hal_memoizing_executable_cache_t {
+  iree_hal_resource_t resource;
+  iree_allocator_t host_allocator;
+  iree_hal_executable_cache_t* target_cache;
+  iree_hal_memoizing_executable_cache_shard_t
+      shards[IREE_HAL_MEMOIZING_EXECUTABLE_CACHE_SHARD_COUNT];
+} iree_hal_memoizing_executable_cache_t;
+
+static const iree_hal_executable_cache_vtable_t
+    iree_hal_memoizing_executable_cache_vtable;
+
+static iree_hal_memoizing_executable_cache_t*
+iree_hal_memoizing_executable_cache_cast(
+    iree_hal_executable_cache_t* base_value) {
+  IREE_HAL_ASSERT_TYPE(base_value, &iree_hal_memoizing_executable_cache_vtable);
+  return (iree_hal_memoizing_executable_cache_t*)base_value;
+}
+
+// Computes the content hash identifying an executable preparation request.
+// 64-bit FNV-1a over the format, executable data, and constants; with the
+// modest entry counts expected (thousands of executables) the collision
+// probability is negligible and entries additionally compare sizes exactly.
+static uint64_t iree_hal_memoizing_executable_cache_hash(
+    const iree_hal_executable_params_t* executable_params) {
+  uint64_t hash = 14695981039346656037ull;
+  const uint8_t* format_data =
+      (const uint8_t*)executable_params->executable_format.data;
+  for (iree_host_size_t i = 0;
+       i < executable_params->executable_format.size; ++i) {
+    hash = (hash ^ format_data[i]) * 1099511628211ull;
+  }
+  for (iree_host_size_t i = 0;
+       i < executable_params->executable_data.data_length; ++i) {
+    hash = (hash ^ executable_params->executable_data.data[i]) *
+           1099511628211ull;
+  }
+  const uint8_t* constant_data = (const uint8_t*)executable_params->constants;
+  for (iree_host_size_t i = 0;
+       i < executable_params->constant_count * sizeof(uint32_t); ++i) {
+    hash = (hash ^ constant_data[i]) * 1099511628211ull;
+  }
+  return hash;
+}
+
+// Returns true if |entry| matches the preparation request.
+// Callers must hold the owning shard mutex.
+static bool iree_hal_memoizing_executable_cache_entry_matches(
+    const iree_hal_memoizing_executable_cache_entry_t* entry,
+    uint64_t content_hash, iree_hal_executable_caching_mode_t caching_mode,
+    const iree_hal_executable_params_t* executable_params) {
+  return entry->content_hash == content_hash &&
+         entry->caching_mode == caching_mode &&
+         iree_string_view_equal(entry->executable_format,
+                                executable_params->executable_format) &&
+         entry->executable_data_size ==
+             executable_params->executable_data.data_length &&
+         entry->pipeline_layout_count ==
+             executable_params->pipeline_layout_count &&
+         entry->constant_count == executable_params->constant_count &&
+         (entry->constant_count == 0 ||
+          memcmp(entry->constants, executable_params->constants,
+                 entry->constant_count * sizeof(uint32_t)) == 0);
+}
+
+// Looks up a memoized executable in |shard|, retaining it for the caller.
+// Returns NULL if no matching entry has been inserted.
+static iree_hal_executable_t* iree_hal_memoizing_executable_cache_shard_lookup(
+    iree_hal_memoizing_executable_cache_shard_t* shard, uint64_t content_hash,
+    iree_hal_executable_caching_mode_t caching_mode,
+    const iree_hal_executable_params_t* executable_params) {
+  iree_hal_executable_t* executable = NULL;
+  iree_slim_mutex_lock(&shard->mutex);
+  for (iree_hal_memoizing_executable_cache_entry_t* entry = shard->head;
+       entry != NULL; entry = entry->next) {
+    if (iree_hal_memoizing_executable_cache_entry_matches(
+            entry, content_hash, caching_mode, executable_params)) {
+      executable = entry->executable;
+      iree_hal_executable_retain(executable);
+      break;
+    }
+  }
+  iree_slim_mutex_unlock(&shard->mutex);
+  return executable;
+}
+
+IREE_API_EXPORT iree_status_t iree_hal_memoizing_executable_cache_create(
+    iree_hal_executable_cache_t* target_cache, iree_allocator_t host_allocator,
+    iree_hal_executable_cache_t** out_executable_cache) {
+  IREE_ASSERT_ARGUMENT(target_cache);
+  IREE_ASSERT_ARGUMENT(out_executable_cache);
+  *out_executable_cache = NULL;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_hal_memoizing_executable_cache_t* executable_cache = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(host_allocator, sizeof(*executable_cache),
+                                (void**)&executable_cache));
+  iree_hal_resource_initialize(&iree_hal_memoizing_executable_cache_vtable,
+                               &executable_cache->resource);
+  executable_cache->host_allocator = host_allocator;
+  executable_cache->target_cache = target_cache;
+  iree_hal_executable_cache_retain(target_cache);
+  for (iree_host_size_t i = 0;
+       i < IREE_HAL_MEMOIZING_EXECUTABLE_CACHE_SHARD_COUNT; ++i) {
+    iree_slim_mutex_initialize(&executable_cache->shards[i].mutex);
+    executable_cache->shards[i].head = NULL;
+  }
+  *out_executable_cache = (iree_hal_executable_cache_t*)executable_cache;
+
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
+static void iree_hal_memoizing_executable_cache_destroy(
+    iree_hal_executable_cache_t* base_executable_cache) {
+  iree_hal_memoizing_executable_cache_t* executable_cache =
+      iree_hal_memoizing_executable_cache_cast(base_executable_cache);
+  iree_allocator_t host_allocator = executable_cache->host_allocator;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  for (iree_host_size_t i = 0;
+       i < IREE_HAL_MEMOIZING_EXECUTABLE_CACHE_SHARD_COUNT; ++i) {
+    iree_hal_memoizing_executable_cache_shard_t* shard =
+        &executable_cache->shards[i];
+    iree_hal_memoizing_executable_cache_entry_t* entry = shard->head;
+    while (entry != NULL) {
+      iree_hal_memoizing_executable_cache_entry_t* next = entry->next;
+      iree_hal_executable_release(entry->executable);
+      iree_allocator_free(host_allocator, entry);
+      entry = next;
+    }
+    iree_slim_mutex_deinitialize(&shard->mutex);
+  }
+  iree_hal_executable_cache_release(executable_cache->target_cache);
+  iree_allocator_free(host_allocator, executable_cache);
+
+  IREE_TRACE_ZONE_END(z0);
+}
+
+static bool iree_hal_memoizing_executable_cache_can_prepare_format(
+    iree_hal_executable_cache_t* base_executable_cache,
+    iree_hal_executable_caching_mode_t caching_mode,
+    iree_string_view_t executable_format) {
+  iree_hal_memoizing_executable_cache_t* executable_cache =
+      iree_hal_memoizing_executable_cache_cast(base_executable_cache);
+  return iree_hal_executable_cache_can_prepare_format(
+      executable_cache->target_cache, caching_mode, executable_format);
+}
+
+static iree_status_t iree_hal_memoizing_executable_cache_prepare_executable(
+    iree_hal_executable_cache_t* base_executable_cache,
+    const iree_hal_executable_params_t* executable_params,
+    iree_hal_executable_t** out_executable) {
+  iree_hal_memoizing_executable_cache_t* executable_cache =
+      iree_hal_memoizing_executable_cache_cast(base_executable_cache);
+
+  uint64_t content_hash =
+      iree_hal_memoizing_executable_cache_hash(executable_params);
+  iree_hal_executable_caching_mode_t caching_mode =
+      executable_params->caching_mode &
+      IREE_HAL_MEMOIZING_EXECUTABLE_CACHE_MODE_MASK;
+  iree_hal_memoizing_executable_cache_shard_t* shard =
+      &executable_cache
+           ->shards[content_hash %
+                    IREE_HAL_MEMOIZING_EXECUTABLE_CACHE_SHARD_COUNT];
+
+  // Fast path: an identical executable has already been prepared.
+  iree_hal_executable_t* executable =
+      iree_hal_memoizing_executable_cache_shard_lookup(
+          shard, content_hash, caching_mode, executable_params);
+  if (executable) {
+    *out_executable = executable;
+    return iree_ok_status();
+  }
+
+  // Miss: prepare in the target cache outside of any lock so that distinct
+  // executables hashing to the same shard can still prepare concurrently.
+  IREE_RETURN_IF_ERROR(iree_hal_executable_cache_prepare_executable(
+      executable_cache->target_cache, executable_params, &executable));
+
+  // Executables that may alias caller-owned data cannot outlive the caller's
+  // lifetime guarantee and are returned without insertion.
+  if (iree_all_bits_set(executable_params->caching_mode,
+                        IREE_HAL_EXECUTABLE_CACHING_MODE_ALIAS_PROVIDED_DATA)) {
+    *out_executable = executable;
+    return iree_ok_status();
+  }
+
+  // Build the entry before taking the lock; insertion is then just a link.
+  iree_hal_memoizing_executable_cache_entry_t* entry = NULL;
+  iree_host_size_t total_size =
+      sizeof(*entry) + executable_params->executable_format.size +
+      executable_params->constant_count * sizeof(uint32_t);
+  iree_status_t status = iree_allocator_malloc(
+      executable_cache->host_allocator, total_size, (void**)&entry);
+  if (!iree_status_is_ok(status)) {
+    // Failing to memoize is not fatal; return the prepared executable as-is.
+    iree_status_ignore(status);
+    *out_executable = executable;
+    return iree_ok_status();
+  }
+  entry->content_hash = content_hash;
+  entry->caching_mode = caching_mode;
+  char* format_storage = (char*)entry + sizeof(*entry);
+  memcpy(format_storage, executable_params->executable_format.data,
+         executable_params->executable_format.size);
+  entry->executable_format = iree_make_string_view(
+      format_storage, executable_params->executable_format.size);
+  entry->executable_data_size =
+      executable_params->executable_data.data_length;
+  entry->pipeline_layout_count = executable_params->pipeline_layout_count;
+  entry->constant_count = executable_params->constant_count;
+  uint32_t* constant_storage =
+      (uint32_t*)(format_storage + executable_params->executable_format.size);
+  if (executable_params->constant_count > 0) {
+    memcpy(constant_storage, executable_params->constants,
+           executable_params->constant_count * sizeof(uint32_t));
+  }
+  entry->constants = constant_storage;
+  entry->executable = executable;
+  iree_hal_executable_retain(executable);
+
+  iree_slim_mutex_lock(&shard->mutex);
+  // Re-check for a racing preparation of the same executable; prefer the
+  // already-inserted entry so all callers share a single executable.
+  iree_hal_executable_t* existing_executable = NULL;
+  for (iree_hal_memoizing_executable_cache_entry_t* existing = shard->head;
+       existing != NULL; existing = existing->next) {
+    if (iree_hal_memoizing_executable_cache_entry_matches(
+            existing, content_hash, caching_mode, executable_params)) {
+      existing_executable = existing->executable;
+      iree_hal_executable_retain(existing_executable);
+      break;
+    }
+  }
+  if (!existing_executable) {
+    entry->next = shard->head;
+    shard->head = entry;
+  }
+  iree_slim_mutex_unlock(&shard->mutex);
+
+  if (existing_executable) {
+    iree_hal_executable_release(entry->executable);
+    iree_allocator_free(executable_cache->host_allocator, entry);
+    iree_hal_executable_release(executable);
+    executable = existing_executable;
+  }
+
+  *out_executable = executable;
+  return iree_ok_status();
+}
+
+static const iree_hal_executable_cache_vtable_t
+    iree_hal_memoizing_executable_cache_vtable = {
+        .destroy = iree_hal_memoizing_executable_cache_destroy,
+        .can_prepare_format =
+            iree_hal_memoizing_executable_cache_can_prepare_format,
+        .prepare_executable =
+            iree_hal_memoizing_executable_cache_prepare_executable,
+};
@@ -0,0 +1,48 @@
+// Copyright 2023 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_HAL_UTILS_MEMOIZING_EXECUTABLE_CACHE_H_
+#define IREE_HAL_UTILS_MEMOIZING_EXECUTABLE_CACHE_H_
+
+#include "iree/base/api.h"
+#include "iree/hal/api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+// Creates an executable cache that memoizes executables prepared by
+// |target_cache| content-addressed on the executable format, executable data,
+// and specialization constants. Repeated preparation of identical executables
+// (module reloads, fleets hosting many models sharing dispatches, etc)
+// becomes a hash lookup plus a reference count bump instead of a full
+// ELF relocation/module load in the target cache.
+//
+// Memoized executables are retained until the cache is destroyed; callers
+// hosting highly dynamic programs should scope the cache lifetime accordingly.
+// Preparations with IREE_HAL_EXECUTABLE_CACHING_MODE_ALIAS_PROVIDED_DATA are
+// passed through without insertion as the returned executable may reference
+// caller-owned memory whose lifetime the cache cannot extend; such requests
+// may still be serviced by previously memoized (self-contained) entries.
+//
+// Entries are matched on executable contents and not pipeline layout object
+// identity: the cache must only be used with target caches whose executables
+// do not retain the provided pipeline layouts (such as the local CPU
+// backends) or shared across devices where layouts are interchangeable.
+//
+// Thread-safe - the lookup table is sharded by content hash so concurrent
+// preparation of distinct executables proceeds in parallel.
+//
+// |out_executable_cache| must be released by the caller.
+IREE_API_EXPORT iree_status_t iree_hal_memoizing_executable_cache_create(
+    iree_hal_executable_cache_t* target_cache, iree_allocator_t host_allocator,
+    iree_hal_executable_cache_t** out_executable_cache);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // IREE_HAL_UTILS_MEMOIZING_EXECUTABLE_CACHE_H_
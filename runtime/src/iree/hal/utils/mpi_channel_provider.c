@@ -42,8 +42,54 @@ typedef struct iree_hal_mpi_channel_provider_t {
   // that use MPI will depend on the channel provider lifespan.
   // It may be better to let the user be the owner of MPI's context.
   bool is_mpi_context_owner;
+
+  // True if the MPI library reports it can operate directly on device memory
+  // (GPU-aware MPI). Probed once at creation; see
+  // iree_hal_mpi_channel_provider_supports_device_buffers.
+  bool supports_device_buffers;
+
+  // Preferred maximum size of a single collective operation in bytes or 0 if
+  // operations should not be split. Sampled once at creation from the
+  // IREE_HAL_MPI_CHUNK_SIZE environment variable.
+  iree_device_size_t preferred_chunk_size;
 } iree_hal_mpi_channel_provider_t;
 
+// Probes the loaded MPI |library| for GPU-awareness. The MPI standard has no
+// portable query so we rely on the MPIX extension entry points shipped by
+// Open MPI (and UCX-backed derivatives); libraries without the symbols are
+// conservatively treated as host-only. The IREE_HAL_MPI_GPU_AWARE environment
+// variable overrides the probe in either direction for libraries that
+// misreport their support.
+static bool iree_hal_mpi_probe_device_buffer_support(
+    iree_dynamic_library_t* library) {
+  const char* override_value = getenv("IREE_HAL_MPI_GPU_AWARE");
+  if (override_value && strlen(override_value) > 0) {
+    return override_value[0] != '0';
+  }
+  static const char* kQuerySymbolNames[] = {
+      "MPIX_Query_cuda_support",
+      "MPIX_Query_rocm_support",
+  };
+  for (iree_host_size_t i = 0; i < IREE_ARRAYSIZE(kQuerySymbolNames); ++i) {
+    int (*query_fn)(void) = NULL;
+    iree_status_t status = iree_dynamic_library_lookup_symbol(
+        library, kQuerySymbolNames[i], (void**)&query_fn);
+    if (!iree_status_is_ok(status)) {
+      iree_status_ignore(status);
+      continue;
+    }
+    if (query_fn && query_fn() == 1) return true;
+  }
+  return false;
+}
+
+// Samples the preferred collective chunk size from the environment.
+static iree_device_size_t iree_hal_mpi_query_preferred_chunk_size(void) {
+  const char* var_value = getenv("IREE_HAL_MPI_CHUNK_SIZE");
+  if (!var_value || strlen(var_value) == 0) return 0;
+  return (iree_device_size_t)strtoull(var_value, NULL, 10);
+}
+
 static const iree_hal_channel_provider_vtable_t
     iree_hal_mpi_channel_provider_vtable;
 
@@ -92,6 +138,15 @@ IREE_API_EXPORT iree_status_t iree_hal_mpi_channel_provider_create(
     channel_provider->is_mpi_context_owner = !is_mpi_initialized_already;
   }
 
+  // Probe for GPU-awareness and chunking preferences now that the library is
+  // loaded; consumers query these when deciding how to issue collectives.
+  if (iree_status_is_ok(status)) {
+    channel_provider->supports_device_buffers =
+        iree_hal_mpi_probe_device_buffer_support(channel_provider->library);
+    channel_provider->preferred_chunk_size =
+        iree_hal_mpi_query_preferred_chunk_size();
+  }
+
   if (iree_status_is_ok(status)) {
     *out_channel_provider = (iree_hal_channel_provider_t*)channel_provider;
   } else {
@@ -154,6 +209,25 @@ iree_hal_mpi_channel_provider_symbols(
   return &channel_provider->symbols;
 }
 
+IREE_API_EXPORT bool iree_hal_mpi_channel_provider_supports_device_buffers(
+    iree_hal_channel_provider_t* base_channel_provider) {
+  IREE_ASSERT_ARGUMENT(base_channel_provider);
+  if (!iree_hal_mpi_channel_provider_isa(base_channel_provider)) return false;
+  iree_hal_mpi_channel_provider_t* channel_provider =
+      iree_hal_mpi_channel_provider_cast(base_channel_provider);
+  return channel_provider->supports_device_buffers;
+}
+
+IREE_API_EXPORT iree_device_size_t
+iree_hal_mpi_channel_provider_preferred_chunk_size(
+    iree_hal_channel_provider_t* base_channel_provider) {
+  IREE_ASSERT_ARGUMENT(base_channel_provider);
+  if (!iree_hal_mpi_channel_provider_isa(base_channel_provider)) return 0;
+  iree_hal_mpi_channel_provider_t* channel_provider =
+      iree_hal_mpi_channel_provider_cast(base_channel_provider);
+  return channel_provider->preferred_chunk_size;
+}
+
 static iree_status_t iree_hal_mpi_channel_provider_query_default_rank_and_count(
     iree_hal_channel_provider_t* base_channel_provider, int32_t* out_rank,
     int32_t* out_count) {
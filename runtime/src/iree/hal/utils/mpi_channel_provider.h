@@ -40,6 +40,29 @@ IREE_API_EXPORT iree_hal_mpi_dynamic_symbols_t*
 iree_hal_mpi_channel_provider_symbols(
     iree_hal_channel_provider_t* channel_provider);
 
+// Returns true if the loaded MPI library can operate directly on device
+// memory (GPU-aware/CUDA-aware MPI, commonly via UCX). Backends executing
+// collectives with the provider symbols can pass device pointers directly
+// when this returns true and otherwise must stage through host memory.
+//
+// Detection probes the optional MPIX_Query_cuda_support/MPIX_Query_rocm_support
+// extension symbols; the IREE_HAL_MPI_GPU_AWARE=0|1 environment variable
+// overrides the probe for libraries that misreport (or lack) the extension.
+// Returns false if |channel_provider| is not an MPI channel provider.
+IREE_API_EXPORT bool iree_hal_mpi_channel_provider_supports_device_buffers(
+    iree_hal_channel_provider_t* channel_provider);
+
+// Returns the preferred maximum size in bytes for a single collective
+// operation or 0 if operations should not be split. Backends can split larger
+// transmissions into chunks of this size with per-chunk completion signaling
+// so that chunk k's network transfer overlaps chunk k+1's staging copy.
+// Controlled by the IREE_HAL_MPI_CHUNK_SIZE environment variable (bytes,
+// default 0/unchunked). Returns 0 if |channel_provider| is not an MPI channel
+// provider.
+IREE_API_EXPORT iree_device_size_t
+iree_hal_mpi_channel_provider_preferred_chunk_size(
+    iree_hal_channel_provider_t* channel_provider);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -8,6 +8,17 @@
 
 #include "iree/base/internal/debugging.h"
 
+// Monotonically increasing counter handing out a globally unique interning
+// generation to each allocated set. Generation 0 is reserved so that
+// freshly-initialized resources never match a live set.
+static iree_atomic_int64_t iree_hal_resource_set_generation_counter =
+    IREE_ATOMIC_VAR_INIT(0);
+
+// Number of unique insertions gathered before being flushed to the chunk
+// storage in bulk. Sized to keep the pending list in registers/stack cache
+// while amortizing the chunk capacity checks across the whole batch.
+#define IREE_HAL_RESOURCE_SET_INSERT_BATCH_SIZE 16
+
 // Computes the total capacity in resources of a chunk allocated with a total
 // |storage_size| (including the header).
 static uint16_t iree_hal_resource_set_chunk_capacity(
@@ -33,6 +44,11 @@ IREE_API_EXPORT iree_status_t iree_hal_resource_set_allocate(
       z0, iree_arena_block_pool_acquire(block_pool, &block, (void**)&set));
   memset(set, 0, sizeof(*set));
   set->block_pool = block_pool;
+  set->generation =
+      (uint64_t)iree_atomic_fetch_add_int64(
+          &iree_hal_resource_set_generation_counter, 1,
+          iree_memory_order_relaxed) +
+      1;
 
   // Inline the first chunk into the block using all of the remaining space.
   // This is a special case chunk that is released back to the pool with the
@@ -139,32 +155,57 @@ IREE_API_EXPORT void iree_hal_resource_set_freeze(
 #endif  // IREE_SANITIZER_ADDRESS
 }
 
-// Retains |resource| and adds it to the main |set| list.
-static iree_status_t iree_hal_resource_set_insert_retain(
-    iree_hal_resource_set_t* set, iree_hal_resource_t* resource) {
-  iree_hal_resource_set_chunk_t* chunk = set->chunk_head;
-  if (IREE_UNLIKELY(chunk->count + 1 > chunk->capacity)) {
-    // Ran out of room in the current chunk - acquire a new one and link it into
-    // the list of chunks.
-    iree_arena_block_t* block = NULL;
-    IREE_RETURN_IF_ERROR(
-        iree_arena_block_pool_acquire(set->block_pool, &block, (void**)&chunk));
-    chunk->next_chunk = set->chunk_head;
-    set->chunk_head = chunk;
-    chunk->capacity = iree_hal_resource_set_chunk_capacity(
-        set->block_pool->usable_block_size);
-    chunk->count = 0;
-  }
+// Stamps |resource| as interned by the current generation of |set|.
+// Subsequent insertions of the resource into the set will be elided with a
+// single comparison. Racing stamps from other sets only ever lose the hint:
+// generations are globally unique so a mismatched or torn composite can never
+// equal the generation of a different live set.
+static inline void iree_hal_resource_set_stamp(iree_hal_resource_set_t* set,
+                                               iree_hal_resource_t* resource) {
+  iree_atomic_store_int64(&resource->intern_epoch, (int64_t)set->generation,
+                          iree_memory_order_relaxed);
+}
 
-  // Retain and insert into the chunk.
-  chunk->resources[chunk->count++] = resource;
-  iree_hal_resource_retain(resource);
+// Retains a batch of resources and appends them to the main |set| list,
+// amortizing the chunk capacity checks across the whole batch.
+static iree_status_t iree_hal_resource_set_insert_retain_bulk(
+    iree_hal_resource_set_t* set, iree_hal_resource_t* const* resources,
+    iree_host_size_t count) {
+  while (count > 0) {
+    iree_hal_resource_set_chunk_t* chunk = set->chunk_head;
+    if (IREE_UNLIKELY(chunk->count == chunk->capacity)) {
+      // Ran out of room in the current chunk - acquire a new one and link it
+      // into the list of chunks.
+      iree_arena_block_t* block = NULL;
+      IREE_RETURN_IF_ERROR(iree_arena_block_pool_acquire(set->block_pool,
+                                                         &block,
+                                                         (void**)&chunk));
+      chunk->next_chunk = set->chunk_head;
+      set->chunk_head = chunk;
+      chunk->capacity = iree_hal_resource_set_chunk_capacity(
+          set->block_pool->usable_block_size);
+      chunk->count = 0;
+    }
+
+    // Retain and insert as many resources as fit in the chunk.
+    iree_host_size_t span =
+        iree_min(count, (iree_host_size_t)(chunk->capacity - chunk->count));
+    memcpy(&chunk->resources[chunk->count], resources,
+           span * sizeof(*resources));
+    chunk->count += (uint16_t)span;
+    for (iree_host_size_t i = 0; i < span; ++i) {
+      iree_hal_resource_retain(resources[i]);
+    }
+    resources += span;
+    count -= span;
+  }
   return iree_ok_status();
 }
 
-// Scans the lookaside for the resource pointer and updates the order if found.
-// If the resource was not found then it will be inserted into the main list as
-// well as the MRU.
+// Returns true if inserting |resource| can be elided because the set already
+// retains it: either the resource carries the set's generation stamp or it is
+// present in the MRU lookaside. MRU hits are moved to the front of the list
+// and stamped so that subsequent insertions take the cheaper generation check.
 //
 // This performs a full scan over the MRU and if the resource is found will
 // move the resource to the front of the list before returning. Otherwise the
@@ -244,9 +285,19 @@ static iree_status_t iree_hal_resource_set_insert_retain(
 //
 //   We can use SIMDE as a rosetta stone for getting neon/avx/wasm/etc:
 //   https://github.com/simd-everywhere/simde/blob/master/simde/arm/neon/ceq.h#L591
-static iree_status_t iree_hal_resource_set_insert_1(
+static bool iree_hal_resource_set_try_elide_insert(
     iree_hal_resource_set_t* set, iree_hal_resource_t* resource) {
-  // Scan and hope for a hit.
+  // Generation check: if the resource was stamped by this set it's already
+  // retained and nothing else needs to happen. This is the common case when
+  // command buffers are re-recorded against unchanged resources and skips the
+  // MRU shuffling entirely.
+  if (iree_atomic_load_int64(&resource->intern_epoch,
+                             iree_memory_order_relaxed) ==
+      (int64_t)set->generation) {
+    return true;
+  }
+
+  // Scan the MRU and hope for a hit.
   for (iree_host_size_t i = 0; i < IREE_ARRAYSIZE(set->mru); ++i) {
     if (set->mru[i] != resource) continue;
     // Hit - keep the list sorted by most->least recently used.
@@ -256,35 +307,84 @@ static iree_status_t iree_hal_resource_set_insert_1(
       memmove(&set->mru[1], &set->mru[0], sizeof(set->mru[0]) * i);
       set->mru[0] = resource;
     }
-    return iree_ok_status();
+    // Reclaim the stamp (another set may have stolen it since we inserted).
+    iree_hal_resource_set_stamp(set, resource);
+    return true;
   }
 
-  // Miss - insert into the main list (slow path).
-  // Note that we do this before updating the MRU in case allocation fails - we
-  // don't want to keep the pointer around unless we've really retained it.
-  IREE_RETURN_IF_ERROR(iree_hal_resource_set_insert_retain(set, resource));
-
-  // Shift the MRU down and insert the new item at the head.
-  memmove(&set->mru[1], &set->mru[0],
-          sizeof(set->mru[0]) * (IREE_ARRAYSIZE(set->mru) - 1));
-  set->mru[0] = resource;
+  return false;
+}
 
+// Flushes a batch of unique MRU-missed resources: retains them in the chunk
+// list in bulk and then stamps and front-inserts each into the MRU.
+static iree_status_t iree_hal_resource_set_flush_pending(
+    iree_hal_resource_set_t* set, iree_hal_resource_t* const* pending,
+    iree_host_size_t pending_count) {
+  // Note that we retain before updating the MRU in case allocation fails - we
+  // don't want to keep the pointers around unless we've really retained them.
+  IREE_RETURN_IF_ERROR(
+      iree_hal_resource_set_insert_retain_bulk(set, pending, pending_count));
+  for (iree_host_size_t i = 0; i < pending_count; ++i) {
+    iree_hal_resource_set_stamp(set, pending[i]);
+    // Shift the MRU down and insert the new item at the head.
+    memmove(&set->mru[1], &set->mru[0],
+            sizeof(set->mru[0]) * (IREE_ARRAYSIZE(set->mru) - 1));
+    set->mru[0] = pending[i];
+  }
   return iree_ok_status();
 }
 
-IREE_API_EXPORT iree_status_t
-iree_hal_resource_set_insert(iree_hal_resource_set_t* set,
-                             iree_host_size_t count, const void* resources) {
-  // For now we process one at a time. We should have a stride that lets us
-  // amortize the cost of doing the MRU update and insertion allocation by
-  // say slicing off 4/8/16/32 resources at a time etc. Today each miss that
-  // requires a full insertion goes down the whole path of checking chunk
-  // capacity and such.
-  iree_hal_resource_t* const* typed_resources =
-      (iree_hal_resource_t* const*)resources;
+// Inserts resources read from |elements| at the given |offset|/|stride|.
+// Unique MRU misses are gathered into a small batch so that the chunk
+// capacity checks and allocations are amortized across the whole batch
+// instead of being paid per resource.
+static iree_status_t iree_hal_resource_set_insert_impl(
+    iree_hal_resource_set_t* set, iree_host_size_t count,
+    const uint8_t* elements, iree_host_size_t offset, iree_host_size_t stride) {
+  iree_hal_resource_t* pending[IREE_HAL_RESOURCE_SET_INSERT_BATCH_SIZE];
+  iree_host_size_t pending_count = 0;
   for (iree_host_size_t i = 0; i < count; ++i) {
+    iree_hal_resource_t* resource =
+        *(iree_hal_resource_t* const*)(elements + i * stride + offset);
+    if (!resource) continue;
+    if (iree_hal_resource_set_try_elide_insert(set, resource)) continue;
+    // Dedupe against the pending batch; the MRU is only updated when the
+    // batch is flushed and would otherwise miss repeats within the batch.
+    bool is_pending = false;
+    for (iree_host_size_t j = 0; j < pending_count; ++j) {
+      if (pending[j] == resource) {
+        is_pending = true;
+        break;
+      }
+    }
+    if (is_pending) continue;
+    pending[pending_count++] = resource;
+    if (pending_count == IREE_ARRAYSIZE(pending)) {
+      IREE_RETURN_IF_ERROR(
+          iree_hal_resource_set_flush_pending(set, pending, pending_count));
+      pending_count = 0;
+    }
+  }
+  if (pending_count > 0) {
     IREE_RETURN_IF_ERROR(
-        iree_hal_resource_set_insert_1(set, typed_resources[i]));
+        iree_hal_resource_set_flush_pending(set, pending, pending_count));
   }
   return iree_ok_status();
 }
+
+IREE_API_EXPORT iree_status_t
+iree_hal_resource_set_insert(iree_hal_resource_set_t* set,
+                             iree_host_size_t count, const void* resources) {
+  return iree_hal_resource_set_insert_impl(set, count,
+                                           (const uint8_t*)resources,
+                                           /*offset=*/0,
+                                           sizeof(iree_hal_resource_t*));
+}
+
+IREE_API_EXPORT iree_status_t iree_hal_resource_set_insert_strided(
+    iree_hal_resource_set_t* set, iree_host_size_t count, const void* elements,
+    iree_host_size_t offset, iree_host_size_t stride) {
+  return iree_hal_resource_set_insert_impl(set, count,
+                                           (const uint8_t*)elements, offset,
+                                           stride);
+}
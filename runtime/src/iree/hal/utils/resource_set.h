@@ -97,6 +97,14 @@ typedef struct iree_hal_resource_set_t {
   // Block pool used for allocating additional set storage slabs.
   iree_arena_block_pool_t* block_pool;
 
+  // Globally unique interning generation of this set. Resources retained by
+  // the set are stamped with this value so that redundant insertions - common
+  // when re-recording command buffers against unchanged resources - can be
+  // skipped with a single comparison before the MRU is even consulted.
+  // Generation values are never reused: sets recycled from the block pool
+  // draw a fresh generation so stale stamps can never match a live set.
+  uint64_t generation;
+
   // Linked list of storage chunks.
   iree_hal_resource_set_chunk_t* chunk_head;
 } iree_hal_resource_set_t;
@@ -122,10 +130,23 @@ IREE_API_EXPORT void iree_hal_resource_set_freeze(iree_hal_resource_set_t* set);
 
 // Inserts zero or more resources into the set.
 // Each resource will be retained for at least the lifetime of the set.
+// NULL resource pointers are ignored. Insertions are batched internally so
+// passing arrays is cheaper than inserting resources one at a time.
 IREE_API_EXPORT iree_status_t
 iree_hal_resource_set_insert(iree_hal_resource_set_t* set,
                              iree_host_size_t count, const void* resources);
 
+// Inserts zero or more resources into the set from a strided structure array.
+// |elements| points to the first of |count| structures of |stride| bytes each
+// containing a resource pointer at byte |offset|. This allows bulk insertion
+// directly from binding tables and similar structures without gathering the
+// pointers into a temporary array first.
+// Each resource will be retained for at least the lifetime of the set.
+// NULL resource pointers are ignored.
+IREE_API_EXPORT iree_status_t iree_hal_resource_set_insert_strided(
+    iree_hal_resource_set_t* set, iree_host_size_t count, const void* elements,
+    iree_host_size_t offset, iree_host_size_t stride);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
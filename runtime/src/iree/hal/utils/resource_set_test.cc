@@ -211,15 +211,26 @@ TEST_F(ResourceSetTest, RedundantInsertion) {
   EXPECT_EQ(resource_set->mru[3], resources[28]);
   EXPECT_EQ(resource_set->mru[4], resources[27]);
 
-  // Insert 31 again, MRU should remain the same as it's at the head.
+  // Insert 31 and 28 again: both carry the set's generation stamp from the
+  // initial insertion and are elided before the MRU is even consulted - the
+  // MRU must remain untouched.
   IREE_ASSERT_OK(
       iree_hal_resource_set_insert(resource_set.get(), 1, &resources[31]));
+  IREE_ASSERT_OK(
+      iree_hal_resource_set_insert(resource_set.get(), 1, &resources[28]));
   EXPECT_EQ(resource_set->mru[0], resources[31]);
   EXPECT_EQ(resource_set->mru[1], resources[30]);
   EXPECT_EQ(resource_set->mru[2], resources[29]);
   EXPECT_EQ(resource_set->mru[3], resources[28]);
   EXPECT_EQ(resource_set->mru[4], resources[27]);
 
+  // Steal the stamps of 28 and 0 by inserting them into another set (as if a
+  // concurrently-recorded command buffer shared the resources). The original
+  // set must then fall back to its MRU/chunk paths for them.
+  auto thief_set = make_resource_set(&block_pool);
+  iree_hal_resource_t* stolen[2] = {resources[28], resources[0]};
+  IREE_ASSERT_OK(iree_hal_resource_set_insert(thief_set.get(), 2, stolen));
+
   // Insert 28 again, MRU should be updated to move it to the front:
   //   28 31 30 29 27 ...
   IREE_ASSERT_OK(
@@ -247,7 +258,9 @@ TEST_F(ResourceSetTest, RedundantInsertion) {
   }
   EXPECT_EQ(live_bitmap, 0xFFFFFFFFu);
 
-  // Ensure the set releases the resources.
+  // Ensure the sets release the resources.
+  thief_set.reset();
+  EXPECT_EQ(live_bitmap, 0xFFFFFFFFu);
   resource_set.reset();
   EXPECT_EQ(live_bitmap, 0u);
 }
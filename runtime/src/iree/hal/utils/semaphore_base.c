@@ -32,6 +32,60 @@ static void iree_hal_semaphore_timepoint_list_push_back(
   list->tail = timepoint;
 }
 
+// Inserts |timepoint| into |list| keeping it sorted by ascending
+// minimum_value. Timelines are commonly waited on in increasing order so the
+// scan starts from the tail and is O(1) in the common case.
+static void iree_hal_semaphore_timepoint_list_insert_sorted(
+    iree_hal_semaphore_timepoint_list_t* list,
+    iree_hal_semaphore_timepoint_t* timepoint) {
+  iree_hal_semaphore_timepoint_t* prev = list->tail;
+  while (prev && prev->minimum_value > timepoint->minimum_value) {
+    prev = prev->prev;
+  }
+  if (!prev) {
+    timepoint->prev = NULL;
+    timepoint->next = list->head;
+    if (list->head) {
+      list->head->prev = timepoint;
+    } else {
+      list->tail = timepoint;
+    }
+    list->head = timepoint;
+  } else {
+    timepoint->prev = prev;
+    timepoint->next = prev->next;
+    if (prev->next) {
+      prev->next->prev = timepoint;
+    } else {
+      list->tail = timepoint;
+    }
+    prev->next = timepoint;
+  }
+}
+
+// Moves the prefix of |list| that has been reached at |new_value| into
+// |ready_list|. |list| must be sorted by ascending minimum_value.
+static void iree_hal_semaphore_timepoint_list_take_ready_prefix(
+    iree_hal_semaphore_timepoint_list_t* list, uint64_t new_value,
+    iree_hal_semaphore_timepoint_list_t* ready_list) {
+  iree_hal_semaphore_timepoint_t* last_ready = NULL;
+  for (iree_hal_semaphore_timepoint_t* timepoint = list->head;
+       timepoint && timepoint->minimum_value <= new_value;
+       timepoint = timepoint->next) {
+    last_ready = timepoint;
+  }
+  if (!last_ready) return;
+  ready_list->head = list->head;
+  ready_list->tail = last_ready;
+  list->head = last_ready->next;
+  if (list->head) {
+    list->head->prev = NULL;
+  } else {
+    list->tail = NULL;
+  }
+  last_ready->next = NULL;
+}
+
 // Erases |timepoint| from |list|.
 static void iree_hal_semaphore_timepoint_list_erase(
     iree_hal_semaphore_timepoint_list_t* list,
@@ -63,6 +117,21 @@ static void iree_hal_semaphore_timepoint_list_take_all(
   available_list->tail = NULL;
 }
 
+// Returns the shard of |semaphore| that |timepoint| maps to.
+// The mapping is a pure function of the timepoint storage address so that
+// cancellation can locate the shard without consulting any shared state.
+static inline iree_hal_semaphore_timepoint_shard_t*
+iree_hal_semaphore_timepoint_shard(
+    iree_hal_semaphore_t* semaphore,
+    const iree_hal_semaphore_timepoint_t* timepoint) {
+  // Drop the low bits as timepoints are commonly embedded in larger
+  // allocations sharing the same alignment.
+  const iree_host_size_t shard_index =
+      (iree_host_size_t)(((uintptr_t)timepoint >> 6) &
+                         (IREE_HAL_SEMAPHORE_TIMEPOINT_SHARD_COUNT - 1));
+  return &semaphore->timepoint_shards[shard_index];
+}
+
 // Issues the callback for the given |timepoint| and resets it.
 static void iree_hal_semaphore_issue_timepoint_callback(
     iree_hal_semaphore_t* semaphore, uint64_t new_value,
@@ -112,52 +181,58 @@ static void iree_hal_semaphore_resolve_timepoints(
     iree_hal_semaphore_t* semaphore, uint64_t new_value) {
   IREE_TRACE_ZONE_BEGIN(z0);
 
-  iree_hal_semaphore_timepoint_list_t pending_list = {NULL, NULL};
-  iree_hal_semaphore_timepoint_list_t ready_list = {NULL, NULL};
-  iree_hal_semaphore_timepoint_list_t expired_list = {NULL, NULL};
+  for (iree_host_size_t shard_index = 0;
+       shard_index < IREE_HAL_SEMAPHORE_TIMEPOINT_SHARD_COUNT; ++shard_index) {
+    iree_hal_semaphore_timepoint_shard_t* shard =
+        &semaphore->timepoint_shards[shard_index];
 
-  iree_slim_mutex_lock(&semaphore->timepoint_mutex);
+    iree_hal_semaphore_timepoint_list_t ready_list = {NULL, NULL};
+    iree_hal_semaphore_timepoint_list_t expired_list = {NULL, NULL};
 
-  if (iree_hal_semaphore_timepoint_list_is_empty(&semaphore->timepoint_list)) {
-    iree_slim_mutex_unlock(&semaphore->timepoint_mutex);
-    IREE_TRACE_ZONE_END(z0);
-    return;
-  }
+    iree_slim_mutex_lock(&shard->mutex);
 
-  // Scan through the list and divvy up timepoints into still-pending, ready to
-  // resolve, and expired buckets.
-  iree_time_t now_ns = iree_time_now();
-  for (iree_hal_semaphore_timepoint_t* timepoint =
-           semaphore->timepoint_list.head;
-       timepoint != NULL;) {
-    iree_hal_semaphore_timepoint_t* next_timepoint = timepoint->next;
-    timepoint->next = NULL;
-
-    if (timepoint->minimum_value <= new_value) {
-      // Reached the timepoint; even if the deadline has been reached we'll
-      // still consider this a hit.
-      iree_hal_semaphore_timepoint_list_push_back(&ready_list, timepoint);
-    } else if (timepoint->deadline_ns <= now_ns) {
-      // Deadline expired before the timepoint was reached.
-      iree_hal_semaphore_timepoint_list_push_back(&expired_list, timepoint);
-    } else {
-      // Still pending.
-      iree_hal_semaphore_timepoint_list_push_back(&pending_list, timepoint);
+    if (iree_hal_semaphore_timepoint_list_is_empty(&shard->list)) {
+      iree_slim_mutex_unlock(&shard->mutex);
+      continue;
     }
 
-    timepoint = next_timepoint;
-  }
-
-  // Preserve pending timepoints.
-  semaphore->timepoint_list = pending_list;
+    // Reached timepoints form a prefix of the sorted list; even if a deadline
+    // has also been reached we still consider such timepoints a hit.
+    iree_hal_semaphore_timepoint_list_take_ready_prefix(&shard->list, new_value,
+                                                        &ready_list);
+
+    // Only walk the remaining timepoints when the earliest outstanding
+    // deadline has actually passed; in the common case of far-future or
+    // infinite deadlines still-pending timepoints are left untouched.
+    if (shard->min_deadline_ns != IREE_TIME_INFINITE_FUTURE) {
+      iree_time_t now_ns = iree_time_now();
+      if (shard->min_deadline_ns <= now_ns) {
+        iree_time_t min_deadline_ns = IREE_TIME_INFINITE_FUTURE;
+        for (iree_hal_semaphore_timepoint_t* timepoint = shard->list.head;
+             timepoint != NULL;) {
+          iree_hal_semaphore_timepoint_t* next_timepoint = timepoint->next;
+          if (timepoint->deadline_ns <= now_ns) {
+            // Deadline expired before the timepoint was reached.
+            iree_hal_semaphore_timepoint_list_erase(&shard->list, timepoint);
+            iree_hal_semaphore_timepoint_list_push_back(&expired_list,
+                                                        timepoint);
+          } else if (timepoint->deadline_ns < min_deadline_ns) {
+            min_deadline_ns = timepoint->deadline_ns;
+          }
+          timepoint = next_timepoint;
+        }
+        shard->min_deadline_ns = min_deadline_ns;
+      }
+    }
 
-  // Issue callbacks for all successes and failures.
-  iree_hal_semaphore_issue_timepoint_callbacks(semaphore, new_value,
-                                               IREE_STATUS_OK, &ready_list);
-  iree_hal_semaphore_issue_timepoint_callbacks(
-      semaphore, new_value, IREE_STATUS_DEADLINE_EXCEEDED, &expired_list);
+    // Issue callbacks for all successes and failures.
+    iree_hal_semaphore_issue_timepoint_callbacks(semaphore, new_value,
+                                                 IREE_STATUS_OK, &ready_list);
+    iree_hal_semaphore_issue_timepoint_callbacks(
+        semaphore, new_value, IREE_STATUS_DEADLINE_EXCEEDED, &expired_list);
 
-  iree_slim_mutex_unlock(&semaphore->timepoint_mutex);
+    iree_slim_mutex_unlock(&shard->mutex);
+  }
 
   IREE_TRACE_ZONE_END(z0);
 }
@@ -167,18 +242,24 @@ static void iree_hal_semaphore_reject_timepoints(
     iree_hal_semaphore_t* semaphore, iree_status_code_t new_status_code) {
   IREE_TRACE_ZONE_BEGIN(z0);
 
-  iree_slim_mutex_lock(&semaphore->timepoint_mutex);
+  for (iree_host_size_t shard_index = 0;
+       shard_index < IREE_HAL_SEMAPHORE_TIMEPOINT_SHARD_COUNT; ++shard_index) {
+    iree_hal_semaphore_timepoint_shard_t* shard =
+        &semaphore->timepoint_shards[shard_index];
 
-  // Take the entire timepoint list from the semaphore.
-  iree_hal_semaphore_timepoint_list_t failed_list = {NULL, NULL};
-  iree_hal_semaphore_timepoint_list_take_all(&semaphore->timepoint_list,
-                                             &failed_list);
+    iree_slim_mutex_lock(&shard->mutex);
 
-  // Issue failure callbacks for all timepoints.
-  iree_hal_semaphore_issue_timepoint_callbacks(semaphore, UINT64_MAX,
-                                               new_status_code, &failed_list);
+    // Take the entire timepoint list from the shard.
+    iree_hal_semaphore_timepoint_list_t failed_list = {NULL, NULL};
+    iree_hal_semaphore_timepoint_list_take_all(&shard->list, &failed_list);
+    shard->min_deadline_ns = IREE_TIME_INFINITE_FUTURE;
 
-  iree_slim_mutex_unlock(&semaphore->timepoint_mutex);
+    // Issue failure callbacks for all timepoints.
+    iree_hal_semaphore_issue_timepoint_callbacks(semaphore, UINT64_MAX,
+                                                 new_status_code, &failed_list);
+
+    iree_slim_mutex_unlock(&shard->mutex);
+  }
 
   IREE_TRACE_ZONE_END(z0);
 }
@@ -192,15 +273,23 @@ IREE_API_EXPORT void iree_hal_semaphore_initialize(
     iree_hal_semaphore_t* out_semaphore) {
   IREE_ASSERT_ARGUMENT(out_semaphore);
   iree_hal_resource_initialize(vtable, &out_semaphore->resource);
-  iree_slim_mutex_initialize(&out_semaphore->timepoint_mutex);
-  memset(&out_semaphore->timepoint_list, 0,
-         sizeof(out_semaphore->timepoint_list));
+  for (iree_host_size_t i = 0; i < IREE_HAL_SEMAPHORE_TIMEPOINT_SHARD_COUNT;
+       ++i) {
+    iree_slim_mutex_initialize(&out_semaphore->timepoint_shards[i].mutex);
+    memset(&out_semaphore->timepoint_shards[i].list, 0,
+           sizeof(out_semaphore->timepoint_shards[i].list));
+    out_semaphore->timepoint_shards[i].min_deadline_ns =
+        IREE_TIME_INFINITE_FUTURE;
+  }
 }
 
 IREE_API_EXPORT void iree_hal_semaphore_deinitialize(
     iree_hal_semaphore_t* semaphore) {
   IREE_ASSERT_ARGUMENT(semaphore);
-  iree_slim_mutex_deinitialize(&semaphore->timepoint_mutex);
+  for (iree_host_size_t i = 0; i < IREE_HAL_SEMAPHORE_TIMEPOINT_SHARD_COUNT;
+       ++i) {
+    iree_slim_mutex_deinitialize(&semaphore->timepoint_shards[i].mutex);
+  }
 }
 
 IREE_API_EXPORT void iree_hal_semaphore_acquire_timepoint(
@@ -222,13 +311,17 @@ IREE_API_EXPORT void iree_hal_semaphore_acquire_timepoint(
   out_timepoint->deadline_ns = iree_timeout_as_deadline_ns(timeout);
   out_timepoint->callback = callback;
 
-  // Insert into timepoint list.
+  // Insert into the shard selected by the timepoint address.
   // After we release the lock the callback may be issued immediately as another
   // thread may be waiting to signal the timepoint.
-  iree_slim_mutex_lock(&semaphore->timepoint_mutex);
-  iree_hal_semaphore_timepoint_list_push_back(&semaphore->timepoint_list,
-                                              out_timepoint);
-  iree_slim_mutex_unlock(&semaphore->timepoint_mutex);
+  iree_hal_semaphore_timepoint_shard_t* shard =
+      iree_hal_semaphore_timepoint_shard(semaphore, out_timepoint);
+  iree_slim_mutex_lock(&shard->mutex);
+  iree_hal_semaphore_timepoint_list_insert_sorted(&shard->list, out_timepoint);
+  if (out_timepoint->deadline_ns < shard->min_deadline_ns) {
+    shard->min_deadline_ns = out_timepoint->deadline_ns;
+  }
+  iree_slim_mutex_unlock(&shard->mutex);
 
   IREE_TRACE_ZONE_END(z0);
 }
@@ -239,7 +332,11 @@ IREE_API_EXPORT void iree_hal_semaphore_cancel_timepoint(
   if (!semaphore || !timepoint) return;
   IREE_TRACE_ZONE_BEGIN(z0);
 
-  iree_slim_mutex_lock(&semaphore->timepoint_mutex);
+  // The timepoint always lives in the shard selected by its address so we
+  // can find the right lock even if it has already been issued and reset.
+  iree_hal_semaphore_timepoint_shard_t* shard =
+      iree_hal_semaphore_timepoint_shard(semaphore, timepoint);
+  iree_slim_mutex_lock(&shard->mutex);
 
   // NOTE: if the semaphore is NULL then the timepoint has already been issued.
   // The caller is expected to know it's safe to still use the timepoint struct
@@ -248,8 +345,7 @@ IREE_API_EXPORT void iree_hal_semaphore_cancel_timepoint(
   if (needs_release) {
     // Remove the timepoint from the list to ensure no other code can issue its
     // callback.
-    iree_hal_semaphore_timepoint_list_erase(&semaphore->timepoint_list,
-                                            timepoint);
+    iree_hal_semaphore_timepoint_list_erase(&shard->list, timepoint);
 
     // Neuter the timepoint so that it is never called.
     // Other threads may be sitting and waiting for the lock and we need to
@@ -258,7 +354,7 @@ IREE_API_EXPORT void iree_hal_semaphore_cancel_timepoint(
     memset(timepoint, 0, sizeof(*timepoint));
   }
 
-  iree_slim_mutex_unlock(&semaphore->timepoint_mutex);
+  iree_slim_mutex_unlock(&shard->mutex);
 
   // Release the semaphore outside of the lock as it may recursively release
   // resources.
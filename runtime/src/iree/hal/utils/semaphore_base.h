@@ -66,9 +66,9 @@ typedef struct iree_hal_semaphore_timepoint_t {
   iree_hal_semaphore_callback_t callback;
 } iree_hal_semaphore_timepoint_t;
 
-// A doubly-linked FIFO list of timepoints.
-// The order of the timepoints does *not* match increasing payload values but
-// instead the order they were added to the list.
+// A doubly-linked list of timepoints.
+// Shard lists are kept sorted by ascending minimum payload value; transient
+// lists built during notification preserve insertion order.
 //
 // Note that the timepoints are not owned by the list - this just nicely
 // stitches together timepoints for easier management.
@@ -89,20 +89,37 @@ typedef struct iree_hal_semaphore_timepoint_list_t {
 // failure events using the iree_hal_semaphore_notify method. Any satisfied
 // timepoints will have their callback made immediately from the notifying
 // thread.
+// Number of independently locked timepoint list shards per semaphore.
+// Timepoints are distributed across shards by their storage address so that
+// concurrent acquire/cancel/notify traffic on hot semaphores does not
+// serialize on a single lock (or bounce a single cache line between cores).
+// Must be a power of two.
+#define IREE_HAL_SEMAPHORE_TIMEPOINT_SHARD_COUNT 4
+
+// A single independently locked shard of the semaphore timepoint list.
+typedef struct iree_hal_semaphore_timepoint_shard_t {
+  // Non-recursive mutex guarding access to |list|.
+  iree_slim_mutex_t mutex;
+
+  // Timepoint list sorted by ascending minimum_value. Reached timepoints
+  // always form a prefix of the list so signal advances only touch the
+  // timepoints they resolve instead of walking all outstanding waiters.
+  iree_hal_semaphore_timepoint_list_t list IREE_GUARDED_BY(mutex);
+
+  // Minimum deadline_ns of all timepoints in |list| (conservative: may be
+  // earlier than the actual minimum after cancellation). Deadline expiry
+  // sweeps of the full list only run once this has passed.
+  iree_time_t min_deadline_ns IREE_GUARDED_BY(mutex);
+} iree_hal_semaphore_timepoint_shard_t;
+
 struct iree_hal_semaphore_t {
   iree_hal_resource_t resource;  // must be at 0
 
-  // Non-recursive mutex guarding access to the timepoint list.
-  iree_slim_mutex_t timepoint_mutex;
-
-  // Timepoint list in insertion order.
-  // There are probably better orderings we could use here that allow us to
-  // walk the entire list less frequently, though target payload value is not
-  // enough as deadlines still require the scan. We could sort by non-infinite
-  // deadlines first and then infinite ones last but given the common timepoint
-  // counts (0..1) it's not worth the complexity today.
-  iree_hal_semaphore_timepoint_list_t timepoint_list
-      IREE_GUARDED_BY(timepoint_mutex);
+  // Sharded timepoint lists; a timepoint always lives in the shard selected
+  // by its storage address so cancellation can find it without any shared
+  // state. Notification sweeps all shards.
+  iree_hal_semaphore_timepoint_shard_t
+      timepoint_shards[IREE_HAL_SEMAPHORE_TIMEPOINT_SHARD_COUNT];
 };
 
 // Initializes the base |out_semaphore| resource.
@@ -374,6 +374,59 @@ TEST_F(TrackingSemaphoreTest, CancelResolvedTimepoint) {
   iree_hal_semaphore_release(*semaphore);
 }
 
+// Tests that timepoints acquired out of order resolve exactly when their
+// minimum value is reached (the shard lists are kept sorted by value).
+TEST_F(TrackingSemaphoreTest, PartialResolutionOutOfOrder) {
+  auto* semaphore = TestSemaphore::Create(0ull, host_allocator);
+
+  CallbackState state_3, state_1, state_2;
+  iree_hal_semaphore_timepoint_t timepoint_3, timepoint_1, timepoint_2;
+  iree_hal_semaphore_acquire_timepoint(*semaphore, 3ull,
+                                       iree_infinite_timeout(),
+                                       MakeCallback(&state_3), &timepoint_3);
+  iree_hal_semaphore_acquire_timepoint(*semaphore, 1ull,
+                                       iree_infinite_timeout(),
+                                       MakeCallback(&state_1), &timepoint_1);
+  iree_hal_semaphore_acquire_timepoint(*semaphore, 2ull,
+                                       iree_infinite_timeout(),
+                                       MakeCallback(&state_2), &timepoint_2);
+
+  IREE_ASSERT_OK(iree_hal_semaphore_signal(*semaphore, 1ull));
+  ASSERT_EQ(state_1.callback_count, 1);
+  ASSERT_EQ(state_2.callback_count, 0);
+  ASSERT_EQ(state_3.callback_count, 0);
+
+  IREE_ASSERT_OK(iree_hal_semaphore_signal(*semaphore, 2ull));
+  ASSERT_EQ(state_2.callback_count, 1);
+  ASSERT_EQ(state_3.callback_count, 0);
+
+  IREE_ASSERT_OK(iree_hal_semaphore_signal(*semaphore, 3ull));
+  ASSERT_EQ(state_3.callback_count, 1);
+  ASSERT_EQ(state_3.value, 3ull);
+
+  iree_hal_semaphore_release(*semaphore);
+}
+
+// Tests that timepoints with expired deadlines are rejected on notification
+// even when the semaphore value never reaches their minimum.
+TEST_F(TrackingSemaphoreTest, ExpiredTimepointDeadline) {
+  auto* semaphore = TestSemaphore::Create(0ull, host_allocator);
+
+  CallbackState state;
+  iree_hal_semaphore_timepoint_t timepoint;
+  iree_hal_semaphore_acquire_timepoint(*semaphore, 1ull,
+                                       iree_immediate_timeout(),
+                                       MakeCallback(&state), &timepoint);
+
+  // Callback happens here with a deadline exceeded status:
+  iree_hal_semaphore_poll(*semaphore);
+
+  ASSERT_EQ(state.callback_count, 1);
+  ASSERT_EQ(state.status_code, IREE_STATUS_DEADLINE_EXCEEDED);
+
+  iree_hal_semaphore_release(*semaphore);
+}
+
 }  // namespace
 }  // namespace hal
 }  // namespace iree
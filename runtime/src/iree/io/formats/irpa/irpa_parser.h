@@ -19,6 +19,14 @@ extern "C" {
 IREE_API_EXPORT iree_status_t iree_io_parse_irpa_index(
     iree_io_file_handle_t* file_handle, iree_io_parameter_index_t* index);
 
+// Verifies the chunk checksums of all chunked data entries in the archive.
+// Entries without checksums (including all non-chunked entry types) are
+// skipped. This touches every checksummed byte in the file and is intended to
+// run off the load critical path such as from a background worker or a
+// tooling verification pass; parsing never verifies checksums.
+IREE_API_EXPORT iree_status_t iree_io_verify_irpa_checksums(
+    iree_io_file_handle_t* file_handle);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
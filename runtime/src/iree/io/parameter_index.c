@@ -9,6 +9,33 @@
 #include "iree/base/internal/atomics.h"
 #include "iree/base/internal/synchronization.h"
 
+// A slot in the lookup hash table.
+// Slots are published by storing the entry pointer with release ordering after
+// the hash has been written; readers that observe a non-NULL entry are
+// guaranteed to observe the matching hash. Empty slots terminate probing.
+typedef struct iree_io_parameter_index_slot_t {
+  // 64-bit FNV-1a hash of the entry key; only valid when entry is non-NULL.
+  uint64_t key_hash;
+  // iree_io_parameter_index_entry_t* or NULL (0) if the slot is empty.
+  iree_atomic_intptr_t entry;
+} iree_io_parameter_index_slot_t;
+
+// Open-addressing hash table over index entries with linear probing.
+// Tables are insert-only: entries are never removed or rehashed in place and
+// when the load factor is exceeded a larger table is built and atomically
+// published in its place. Replaced tables are retired rather than freed as
+// lock-free readers may still be probing them; the doubling growth policy
+// bounds retired storage to roughly the size of the live table.
+typedef struct iree_io_parameter_index_table_t {
+  // Previously published table awaiting teardown or NULL.
+  struct iree_io_parameter_index_table_t* retired_next;
+  // Total slot count; always a power of two.
+  iree_host_size_t slot_count;
+  // Currently occupied slot count; only used by the writer under the mutex.
+  iree_host_size_t used_count;
+  iree_io_parameter_index_slot_t slots[];
+} iree_io_parameter_index_table_t;
+
 struct iree_io_parameter_index_t {
   iree_atomic_ref_count_t ref_count;
   iree_allocator_t host_allocator;
@@ -24,8 +51,127 @@ struct iree_io_parameter_index_t {
   iree_host_size_t entry_count;
   // Dense list of entries in the index. Grows as needed.
   iree_io_parameter_index_entry_t** entries;
+
+  // Currently published lookup table (iree_io_parameter_index_table_t*) or 0
+  // before the first entry is added. Readers acquire-load this and probe
+  // without taking the mutex; the writer swaps it under the mutex.
+  iree_atomic_intptr_t table;
+  // Tables replaced by growth or updates, freed when the index is destroyed
+  // or trimmed after the caller quiesces. Guarded by the mutex.
+  iree_io_parameter_index_table_t* retired_tables;
+
+  // Entries replaced by applies, kept live (including their file handle
+  // references) until the index is destroyed or trimmed after the caller
+  // quiesces. Guarded by the mutex.
+  iree_host_size_t retired_entry_capacity;
+  iree_host_size_t retired_entry_count;
+  iree_io_parameter_index_entry_t** retired_entries;
 };
 
+// Computes the 64-bit FNV-1a hash of |key| used for table placement.
+// Hashed once at enrollment time and stored in the slot so lookups only
+// perform full string comparison on hash matches.
+static uint64_t iree_io_parameter_index_hash_key(iree_string_view_t key) {
+  uint64_t hash = 14695981039346656037ull;
+  for (iree_host_size_t i = 0; i < key.size; ++i) {
+    hash = (hash ^ (uint8_t)key.data[i]) * 1099511628211ull;
+  }
+  return hash;
+}
+
+// Inserts |entry| with |key_hash| into |table|.
+// The caller must hold the index mutex and have ensured free slots remain.
+// Safe with respect to concurrent lock-free readers: the entry pointer is
+// released last so a reader either sees an empty slot (transient miss, same
+// as racing the add itself) or a fully initialized one.
+static void iree_io_parameter_index_table_insert(
+    iree_io_parameter_index_table_t* table, uint64_t key_hash,
+    iree_io_parameter_index_entry_t* entry) {
+  iree_host_size_t mask = table->slot_count - 1;
+  for (iree_host_size_t i = key_hash & mask;; i = (i + 1) & mask) {
+    iree_io_parameter_index_slot_t* slot = &table->slots[i];
+    if (iree_atomic_load_intptr(&slot->entry, iree_memory_order_relaxed) == 0) {
+      slot->key_hash = key_hash;
+      iree_atomic_store_intptr(&slot->entry, (intptr_t)entry,
+                               iree_memory_order_release);
+      ++table->used_count;
+      return;
+    }
+  }
+}
+
+// Returns the smallest power-of-two slot count keeping |entry_count| entries
+// under a ~2/3 load factor; the slack ensures probes terminate on empty slots.
+static iree_host_size_t iree_io_parameter_index_calculate_slot_count(
+    iree_host_size_t entry_count) {
+  iree_host_size_t slot_count = 32;
+  while (entry_count * 3 > slot_count * 2) slot_count *= 2;
+  return slot_count;
+}
+
+// Allocates an empty lookup table with |slot_count| slots (a power of two).
+// The table is not visible to readers until published.
+static iree_status_t iree_io_parameter_index_allocate_table(
+    iree_io_parameter_index_t* index, iree_host_size_t slot_count,
+    iree_io_parameter_index_table_t** out_table) {
+  *out_table = NULL;
+  iree_io_parameter_index_table_t* table = NULL;
+  iree_host_size_t total_size =
+      sizeof(*table) + slot_count * sizeof(table->slots[0]);
+  IREE_RETURN_IF_ERROR(iree_allocator_malloc(index->host_allocator, total_size,
+                                             (void**)&table));
+  table->slot_count = slot_count;
+  *out_table = table;
+  return iree_ok_status();
+}
+
+// Rehashes all current index entries into |new_table| and publishes it,
+// retiring any previous table. Infallible so callers can perform all fallible
+// allocation before mutating the index. The caller must hold the index mutex.
+static void iree_io_parameter_index_publish_table(
+    iree_io_parameter_index_t* index,
+    iree_io_parameter_index_table_t* new_table) {
+  // Rehash all existing entries; stored hashes are recomputed here as entries
+  // are enrolled rarely (session setup) and looked up often.
+  for (iree_host_size_t i = 0; i < index->entry_count; ++i) {
+    iree_io_parameter_index_entry_t* entry = index->entries[i];
+    iree_io_parameter_index_table_insert(
+        new_table, iree_io_parameter_index_hash_key(entry->key), entry);
+  }
+
+  // Publish the new table and retire the old one; readers mid-probe may
+  // continue using the old table until they complete.
+  iree_io_parameter_index_table_t* old_table =
+      (iree_io_parameter_index_table_t*)iree_atomic_load_intptr(
+          &index->table, iree_memory_order_relaxed);
+  iree_atomic_store_intptr(&index->table, (intptr_t)new_table,
+                           iree_memory_order_release);
+  if (old_table) {
+    old_table->retired_next = index->retired_tables;
+    index->retired_tables = old_table;
+  }
+}
+
+// Grows the lookup table to |new_slot_count| slots (a power of two) and
+// publishes it, retiring any previous table. All current index entries are
+// rehashed into the new table before it becomes visible to readers.
+// The caller must hold the index mutex.
+static iree_status_t iree_io_parameter_index_grow_table(
+    iree_io_parameter_index_t* index, iree_host_size_t new_slot_count) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, new_slot_count);
+
+  iree_io_parameter_index_table_t* new_table = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0,
+      iree_io_parameter_index_allocate_table(index, new_slot_count,
+                                             &new_table));
+  iree_io_parameter_index_publish_table(index, new_table);
+
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
 IREE_API_EXPORT iree_status_t iree_io_parameter_index_create(
     iree_allocator_t host_allocator, iree_io_parameter_index_t** out_index) {
   IREE_ASSERT_ARGUMENT(out_index);
@@ -47,31 +193,66 @@ IREE_API_EXPORT iree_status_t iree_io_parameter_index_create(
   index->entry_count = 0;
   index->entries = NULL;
 
+  iree_atomic_store_intptr(&index->table, 0, iree_memory_order_relaxed);
+  index->retired_tables = NULL;
+
+  index->retired_entry_capacity = 0;
+  index->retired_entry_count = 0;
+  index->retired_entries = NULL;
+
   *out_index = index;
   IREE_TRACE_ZONE_END(z0);
   return iree_ok_status();
 }
 
+// Releases the backing storage referenced by |entry| and frees it.
+static void iree_io_parameter_index_free_entry(
+    iree_allocator_t host_allocator, iree_io_parameter_index_entry_t* entry) {
+  switch (entry->type) {
+    default:
+      break;
+    case IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_FILE:
+      iree_io_file_handle_release(entry->storage.file.handle);
+      break;
+  }
+  iree_allocator_free(host_allocator, entry);
+}
+
 static void iree_io_parameter_index_destroy(iree_io_parameter_index_t* index) {
   IREE_ASSERT_ARGUMENT(index);
   IREE_TRACE_ZONE_BEGIN(z0);
   iree_allocator_t host_allocator = index->host_allocator;
 
   for (iree_host_size_t i = 0; i < index->entry_count; ++i) {
-    iree_io_parameter_index_entry_t* entry = index->entries[i];
-    switch (entry->type) {
-      default:
-        break;
-      case IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_FILE:
-        iree_io_file_handle_release(entry->storage.file.handle);
-        break;
-    }
-    iree_allocator_free(host_allocator, entry);
+    iree_io_parameter_index_free_entry(host_allocator, index->entries[i]);
   }
   if (index->entries) {
     iree_allocator_free(host_allocator, index->entries);
   }
 
+  for (iree_host_size_t i = 0; i < index->retired_entry_count; ++i) {
+    iree_io_parameter_index_free_entry(host_allocator,
+                                       index->retired_entries[i]);
+  }
+  if (index->retired_entries) {
+    iree_allocator_free(host_allocator, index->retired_entries);
+  }
+
+  // No readers can remain by the time the last reference is dropped so both
+  // the live table and any retired ones can be freed directly.
+  iree_io_parameter_index_table_t* table =
+      (iree_io_parameter_index_table_t*)iree_atomic_load_intptr(
+          &index->table, iree_memory_order_relaxed);
+  if (table) {
+    iree_allocator_free(host_allocator, table);
+  }
+  iree_io_parameter_index_table_t* retired_table = index->retired_tables;
+  while (retired_table) {
+    iree_io_parameter_index_table_t* next = retired_table->retired_next;
+    iree_allocator_free(host_allocator, retired_table);
+    retired_table = next;
+  }
+
   iree_slim_mutex_deinitialize(&index->mutex);
 
   iree_allocator_free(host_allocator, index);
@@ -132,6 +313,47 @@ IREE_API_EXPORT iree_status_t iree_io_parameter_index_reserve(
   return status;
 }
 
+// Clones |entry| into storage owned by |index|. The clone is allocated as a
+// single slab with the key and metadata inline and is never reallocated so
+// the pointers are safe to embed. Referenced file handles are retained.
+static iree_status_t iree_io_parameter_index_clone_entry(
+    iree_io_parameter_index_t* index,
+    const iree_io_parameter_index_entry_t* entry,
+    iree_io_parameter_index_entry_t** out_entry) {
+  *out_entry = NULL;
+  iree_io_parameter_index_entry_t* cloned_entry = NULL;
+  iree_host_size_t total_size =
+      sizeof(*cloned_entry) + entry->key.size + entry->metadata.data_length;
+  IREE_RETURN_IF_ERROR(iree_allocator_malloc(index->host_allocator, total_size,
+                                             (void**)&cloned_entry));
+  cloned_entry->key = iree_make_string_view(
+      (char*)cloned_entry + sizeof(*cloned_entry), entry->key.size);
+  cloned_entry->metadata =
+      iree_const_byte_span_is_empty(entry->metadata)
+          ? iree_const_byte_span_empty()
+          : iree_make_const_byte_span(
+                (uint8_t*)cloned_entry->key.data + cloned_entry->key.size,
+                entry->metadata.data_length);
+  cloned_entry->length = entry->length;
+  cloned_entry->type = entry->type;
+  switch (entry->type) {
+    default:
+      break;
+    case IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_SPLAT:
+      cloned_entry->storage.splat = entry->storage.splat;
+      break;
+    case IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_FILE:
+      cloned_entry->storage.file = entry->storage.file;
+      iree_io_file_handle_retain(cloned_entry->storage.file.handle);
+      break;
+  }
+  memcpy((void*)cloned_entry->key.data, entry->key.data, entry->key.size);
+  memcpy((void*)cloned_entry->metadata.data, entry->metadata.data,
+         entry->metadata.data_length);
+  *out_entry = cloned_entry;
+  return iree_ok_status();
+}
+
 IREE_API_EXPORT iree_status_t
 iree_io_parameter_index_add(iree_io_parameter_index_t* index,
                             const iree_io_parameter_index_entry_t* entry) {
@@ -148,44 +370,33 @@ iree_io_parameter_index_add(iree_io_parameter_index_t* index,
         index, iree_max(16, index->entry_capacity * 2));
   }
 
-  // Clone the entry memory. We allocate it as a single slab and stash the
-  // pointers for easier access by callers. Entries themselves are never
-  // reallocated so the pointers are safe to embed.
+  // Grow the lookup table if adding an entry would exceed a ~2/3 load factor;
+  // keeping slack ensures probes always terminate on an empty slot.
+  iree_io_parameter_index_table_t* table = NULL;
+  if (iree_status_is_ok(status)) {
+    table = (iree_io_parameter_index_table_t*)iree_atomic_load_intptr(
+        &index->table, iree_memory_order_relaxed);
+    if (!table || (index->entry_count + 1) * 3 > table->slot_count * 2) {
+      status = iree_io_parameter_index_grow_table(
+          index, table ? table->slot_count * 2 : 32);
+      if (iree_status_is_ok(status)) {
+        table = (iree_io_parameter_index_table_t*)iree_atomic_load_intptr(
+            &index->table, iree_memory_order_relaxed);
+      }
+    }
+  }
+
+  // Clone the entry memory.
   iree_io_parameter_index_entry_t* cloned_entry = NULL;
   if (iree_status_is_ok(status)) {
-    iree_host_size_t total_size =
-        sizeof(*cloned_entry) + entry->key.size + entry->metadata.data_length;
-    status = iree_allocator_malloc(index->host_allocator, total_size,
-                                   (void**)&cloned_entry);
+    status = iree_io_parameter_index_clone_entry(index, entry, &cloned_entry);
   }
   if (iree_status_is_ok(status)) {
-    cloned_entry->key = iree_make_string_view(
-        (char*)cloned_entry + sizeof(*cloned_entry), entry->key.size);
-    cloned_entry->metadata =
-        iree_const_byte_span_is_empty(entry->metadata)
-            ? iree_const_byte_span_empty()
-            : iree_make_const_byte_span(
-                  (uint8_t*)cloned_entry->key.data + cloned_entry->key.size,
-                  entry->metadata.data_length);
-    cloned_entry->length = entry->length;
-    cloned_entry->type = entry->type;
-    switch (entry->type) {
-      default:
-        break;
-      case IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_SPLAT:
-        cloned_entry->storage.splat = entry->storage.splat;
-        break;
-      case IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_FILE:
-        cloned_entry->storage.file = entry->storage.file;
-        iree_io_file_handle_retain(cloned_entry->storage.file.handle);
-        break;
-    }
-    memcpy((void*)cloned_entry->key.data, entry->key.data, entry->key.size);
-    memcpy((void*)cloned_entry->metadata.data, entry->metadata.data,
-           entry->metadata.data_length);
-
-    // Append the entry to the file index.
+    // Append the entry to the file index and publish it for lock-free lookup.
     index->entries[index->entry_count++] = cloned_entry;
+    iree_io_parameter_index_table_insert(
+        table, iree_io_parameter_index_hash_key(cloned_entry->key),
+        cloned_entry);
   }
 
   iree_slim_mutex_unlock(&index->mutex);
@@ -223,14 +434,30 @@ IREE_API_EXPORT iree_status_t iree_io_parameter_index_lookup(
   *out_entry = NULL;
   IREE_TRACE_ZONE_BEGIN(z0);
   IREE_TRACE_ZONE_APPEND_TEXT(z0, key.data, key.size);
-  iree_slim_mutex_lock(&index->mutex);
 
+  // Lock-free probe of the currently published table; entries are immutable
+  // and tables are only replaced (never mutated destructively) so a snapshot
+  // of the table pointer remains valid for the duration of the probe. Lookups
+  // racing an add may miss the entry being added, exactly as they would have
+  // if they had taken the mutex first.
   iree_status_t status = iree_ok_status();
-  for (iree_host_size_t i = 0; i < index->entry_count; ++i) {
-    const iree_io_parameter_index_entry_t* entry = index->entries[i];
-    if (iree_string_view_equal(key, entry->key)) {
-      *out_entry = entry;
-      break;
+  iree_io_parameter_index_table_t* table =
+      (iree_io_parameter_index_table_t*)iree_atomic_load_intptr(
+          &index->table, iree_memory_order_acquire);
+  if (table) {
+    const uint64_t key_hash = iree_io_parameter_index_hash_key(key);
+    const iree_host_size_t mask = table->slot_count - 1;
+    for (iree_host_size_t i = key_hash & mask;; i = (i + 1) & mask) {
+      iree_io_parameter_index_slot_t* slot = &table->slots[i];
+      const iree_io_parameter_index_entry_t* entry =
+          (const iree_io_parameter_index_entry_t*)iree_atomic_load_intptr(
+              &slot->entry, iree_memory_order_acquire);
+      if (!entry) break;  // empty slot terminates the probe
+      if (slot->key_hash == key_hash &&
+          iree_string_view_equal(key, entry->key)) {
+        *out_entry = entry;
+        break;
+      }
     }
   }
   if (*out_entry == NULL) {
@@ -239,11 +466,149 @@ IREE_API_EXPORT iree_status_t iree_io_parameter_index_lookup(
                               (int)key.size, key.data);
   }
 
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+IREE_API_EXPORT iree_status_t iree_io_parameter_index_apply(
+    iree_io_parameter_index_t* index, iree_io_parameter_index_t* updates) {
+  IREE_ASSERT_ARGUMENT(index);
+  IREE_ASSERT_ARGUMENT(updates);
+  if (index == updates) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "cannot apply an index to itself");
+  }
+  IREE_TRACE_ZONE_BEGIN(z0);
+  iree_slim_mutex_lock(&index->mutex);
+
+  // |updates| is required to be quiescent for the duration of the call so its
+  // entries can be read without taking its mutex (and without inviting lock
+  // ordering issues between two indices).
+  iree_host_size_t update_count = updates->entry_count;
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, update_count);
+
+  // Stage clones of all update entries so that a failure below leaves |index|
+  // untouched.
+  iree_status_t status = iree_ok_status();
+  iree_io_parameter_index_entry_t** cloned_entries = NULL;
+  iree_host_size_t cloned_count = 0;
+  if (update_count > 0) {
+    status = iree_allocator_malloc(index->host_allocator,
+                                   update_count * sizeof(cloned_entries[0]),
+                                   (void**)&cloned_entries);
+  }
+  for (iree_host_size_t i = 0;
+       iree_status_is_ok(status) && i < update_count; ++i) {
+    status = iree_io_parameter_index_clone_entry(index, updates->entries[i],
+                                                 &cloned_entries[i]);
+    if (iree_status_is_ok(status)) ++cloned_count;
+  }
+
+  // Reserve worst-case dense list and retired list storage and allocate the
+  // replacement lookup table up front so the swap below cannot fail.
+  if (iree_status_is_ok(status)) {
+    status = iree_io_parameter_index_reserve_unsafe(
+        index, index->entry_count + update_count);
+  }
+  if (iree_status_is_ok(status) &&
+      index->retired_entry_count + update_count >
+          index->retired_entry_capacity) {
+    iree_host_size_t new_capacity = iree_max(
+        16, iree_max(index->retired_entry_capacity * 2,
+                     index->retired_entry_count + update_count));
+    iree_io_parameter_index_entry_t** new_retired_entries =
+        index->retired_entries;
+    status = iree_allocator_realloc(
+        index->host_allocator,
+        new_capacity * sizeof(index->retired_entries[0]),
+        (void**)&new_retired_entries);
+    if (iree_status_is_ok(status)) {
+      index->retired_entry_capacity = new_capacity;
+      index->retired_entries = new_retired_entries;
+    }
+  }
+  iree_io_parameter_index_table_t* new_table = NULL;
+  if (iree_status_is_ok(status)) {
+    status = iree_io_parameter_index_allocate_table(
+        index,
+        iree_io_parameter_index_calculate_slot_count(index->entry_count +
+                                                     update_count),
+        &new_table);
+  }
+
+  if (iree_status_is_ok(status)) {
+    // Swap or append each entry in the dense list. Replaced entries are
+    // retired (not freed) so outstanding readers keep valid pointers and the
+    // old extents stay mapped until the caller quiesces and trims.
+    for (iree_host_size_t i = 0; i < update_count; ++i) {
+      iree_io_parameter_index_entry_t* cloned_entry = cloned_entries[i];
+      iree_io_parameter_index_entry_t* old_entry = NULL;
+      for (iree_host_size_t j = 0; j < index->entry_count; ++j) {
+        if (iree_string_view_equal(index->entries[j]->key,
+                                   cloned_entry->key)) {
+          old_entry = index->entries[j];
+          index->entries[j] = cloned_entry;
+          break;
+        }
+      }
+      if (old_entry) {
+        index->retired_entries[index->retired_entry_count++] = old_entry;
+      } else {
+        index->entries[index->entry_count++] = cloned_entry;
+      }
+    }
+    // Publish the whole generation with a single table swap; lookups snapshot
+    // the table pointer so they observe either all of the updates or none.
+    iree_io_parameter_index_publish_table(index, new_table);
+  } else {
+    for (iree_host_size_t i = 0; i < cloned_count; ++i) {
+      iree_io_parameter_index_free_entry(index->host_allocator,
+                                         cloned_entries[i]);
+    }
+  }
+  if (cloned_entries) {
+    iree_allocator_free(index->host_allocator, cloned_entries);
+  }
+
   iree_slim_mutex_unlock(&index->mutex);
   IREE_TRACE_ZONE_END(z0);
   return status;
 }
 
+IREE_API_EXPORT void iree_io_parameter_index_trim(
+    iree_io_parameter_index_t* index) {
+  IREE_ASSERT_ARGUMENT(index);
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Detach the retired lists under the mutex and free outside of it; the
+  // caller has guaranteed no readers obtained before the corresponding apply
+  // remain so both old entries and old tables are unreachable.
+  iree_slim_mutex_lock(&index->mutex);
+  iree_io_parameter_index_entry_t** retired_entries = index->retired_entries;
+  iree_host_size_t retired_entry_count = index->retired_entry_count;
+  index->retired_entries = NULL;
+  index->retired_entry_count = 0;
+  index->retired_entry_capacity = 0;
+  iree_io_parameter_index_table_t* retired_tables = index->retired_tables;
+  index->retired_tables = NULL;
+  iree_slim_mutex_unlock(&index->mutex);
+
+  for (iree_host_size_t i = 0; i < retired_entry_count; ++i) {
+    iree_io_parameter_index_free_entry(index->host_allocator,
+                                       retired_entries[i]);
+  }
+  if (retired_entries) {
+    iree_allocator_free(index->host_allocator, retired_entries);
+  }
+  while (retired_tables) {
+    iree_io_parameter_index_table_t* next = retired_tables->retired_next;
+    iree_allocator_free(index->host_allocator, retired_tables);
+    retired_tables = next;
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+}
+
 IREE_API_EXPORT iree_status_t iree_io_parameter_index_dump(
     iree_string_view_t scope, iree_io_parameter_index_t* index,
     iree_string_builder_t* builder) {
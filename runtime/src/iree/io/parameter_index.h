@@ -71,10 +71,11 @@ typedef struct iree_io_parameter_index_entry_t {
 // A single index may contain entries from multiple files. Each parameter is
 // backed by a contiguous range in a single file.
 //
-// Thread-safe due to insert-only behavior. If we ever wanted to allow removal
-// from the index we would need to change callers to hold a mutex or design
-// a callback-based API to ensure that entries were live for as long as the
-// callers were using them.
+// Thread-safe: entries are only ever inserted or replaced wholesale via
+// iree_io_parameter_index_apply. Replaced entries are retired rather than
+// freed so that callers holding entry pointers from prior lookups remain
+// valid; storage is reclaimed with iree_io_parameter_index_trim once the
+// caller guarantees those readers have drained.
 typedef struct iree_io_parameter_index_t iree_io_parameter_index_t;
 
 // Creates an empty file index.
@@ -116,10 +117,37 @@ IREE_API_EXPORT iree_status_t iree_io_parameter_index_get(
 
 // Performs a file entry lookup of |key| in the index and returns it.
 // The returned |out_entry| is valid for the lifetime of the index.
+// Lookups are lock-free and may be issued concurrently with entries being
+// added; a lookup racing an add may not observe the new entry.
 IREE_API_EXPORT iree_status_t iree_io_parameter_index_lookup(
     iree_io_parameter_index_t* index, iree_string_view_t key,
     const iree_io_parameter_index_entry_t** out_entry);
 
+// Applies all entries of |updates| to |index| as a single transaction.
+// Entries whose keys already exist in |index| are replaced and new keys are
+// appended; this is how a new parameter generation (an updated IRPA file, a
+// swapped LoRA, etc) is hot-swapped under a live provider without tearing
+// down sessions. The swap is atomic with respect to lock-free lookups: a
+// lookup observes either the previous generation or the updated one for
+// every key in |updates|, never a mix. |updates| must not be mutated for the
+// duration of the call.
+//
+// Replaced entries are retired rather than freed as callers may still hold
+// pointers obtained from earlier lookups; their backing file handles remain
+// retained. Once all operations issued against the previous generation have
+// drained - typically after a fence covering inflight executions is reached -
+// callers release the old extents with iree_io_parameter_index_trim.
+IREE_API_EXPORT iree_status_t iree_io_parameter_index_apply(
+    iree_io_parameter_index_t* index, iree_io_parameter_index_t* updates);
+
+// Frees all entries retired by prior applies and releases their backing file
+// handles. Callers must guarantee that no entry pointers obtained before the
+// corresponding iree_io_parameter_index_apply are still in use and that no
+// lookups begun before the apply are still probing, typically by waiting on
+// a fence covering all operations inflight at swap time.
+IREE_API_EXPORT void iree_io_parameter_index_trim(
+    iree_io_parameter_index_t* index);
+
 // Formats a textual dump of the parameter |index| to |builder|.
 // An optional |scope| name can be provided to include in the dump.
 IREE_API_EXPORT iree_status_t iree_io_parameter_index_dump(
@@ -6,13 +6,44 @@
 
 #include "iree/io/parameter_index_provider.h"
 
+#include "iree/base/internal/synchronization.h"
 #include "iree/hal/utils/file_cache.h"
+#include "iree/hal/utils/memory_file.h"
 
 // Limit concurrent operations to avoid blowing the stack. This is arbitrary and
 // if we wanted to support more we could switch to using heap allocations or
 // a growable stack scratchpad.
 #define IREE_IO_PARAMETER_OP_BATCH_MAX_CONCURRENCY 8
 
+// A retained device-resident copy of a fully-loaded parameter.
+// Records are created for entries tagged `iree.residency=` once a budget has
+// been set and are handed back to subsequent loads of the same parameter on
+// the same device so that switching between multiplexed models only pays to
+// reload what was actually evicted.
+typedef struct iree_io_parameter_residency_record_t {
+  struct iree_io_parameter_residency_record_t* next;
+  // Unowned; index entries are stable while the provider retains the index.
+  const iree_io_parameter_index_entry_t* entry;
+  // Unowned; used only as a lookup key. The buffer keeps the originating
+  // allocator (and transitively the device) alive.
+  iree_hal_device_t* device;
+  // Retained resident copy of the (decoded) parameter contents.
+  iree_hal_buffer_t* buffer;
+  // Bytes accounted against the residency budget.
+  iree_device_size_t size;
+  // Retained semaphore/value pair from the originating load's signal list;
+  // released and NULLed once observed as reached. Records are not handed out
+  // before then as the requesting timeline may not be ordered after the
+  // producing one.
+  iree_hal_semaphore_t* ready_semaphore;
+  uint64_t ready_value;
+  // Monotonic use stamp; the lowest-stamped unpinned record is evicted first.
+  uint64_t last_use;
+  // True for `iree.residency=pinned` entries that are exempt from budget
+  // eviction and only dropped on a low-memory signal or teardown.
+  bool pinned;
+} iree_io_parameter_residency_record_t;
+
 typedef struct iree_io_parameter_index_provider_t {
   iree_io_parameter_provider_t base;
   iree_allocator_t host_allocator;
@@ -20,11 +51,26 @@ typedef struct iree_io_parameter_index_provider_t {
   iree_string_view_t scope;
   iree_io_parameter_index_t* index;
   iree_hal_file_cache_t* file_cache;
+
+  // Guards the residency cache state below.
+  iree_slim_mutex_t residency_mutex;
+  // Device-resident parameter copies retained across loads; LRU-evicted to
+  // stay under residency_budget. Empty while the budget is 0 (the default).
+  iree_io_parameter_residency_record_t* residency_head;
+  // Total bytes retained across all records.
+  iree_device_size_t residency_total_size;
+  // Byte budget for unpinned records; 0 disables the cache.
+  iree_device_size_t residency_budget;
+  // Monotonically increasing stamp source for LRU ordering.
+  uint64_t residency_clock;
 } iree_io_parameter_index_provider_t;
 
 static const iree_io_parameter_provider_vtable_t
     iree_io_parameter_index_provider_vtable;
 
+static void iree_io_parameter_index_provider_trim_residency(
+    iree_io_parameter_index_provider_t* provider, bool include_pinned);
+
 static iree_io_parameter_index_provider_t*
 iree_io_parameter_index_provider_cast(
     iree_io_parameter_provider_t* IREE_RESTRICT base_provider) {
@@ -61,6 +107,8 @@ IREE_API_EXPORT iree_status_t iree_io_parameter_index_provider_create(
   provider->index = index;
   iree_io_parameter_index_retain(index);
 
+  iree_slim_mutex_initialize(&provider->residency_mutex);
+
   iree_status_t status =
       iree_hal_file_cache_create(host_allocator, &provider->file_cache);
 
@@ -80,6 +128,10 @@ static void iree_io_parameter_index_provider_destroy(
   iree_allocator_t host_allocator = provider->host_allocator;
   IREE_TRACE_ZONE_BEGIN(z0);
 
+  iree_io_parameter_index_provider_trim_residency(provider,
+                                                  /*include_pinned=*/true);
+  iree_slim_mutex_deinitialize(&provider->residency_mutex);
+
   iree_hal_file_cache_release(provider->file_cache);
   iree_io_parameter_index_release(provider->index);
 
@@ -97,7 +149,13 @@ static iree_status_t iree_io_parameter_index_provider_notify(
 
   switch (signal) {
     case IREE_IO_PARAMETER_PROVIDER_SIGNAL_SUSPEND:
+      iree_io_parameter_index_provider_trim_residency(provider,
+                                                      /*include_pinned=*/false);
+      iree_hal_file_cache_trim(provider->file_cache);
+      break;
     case IREE_IO_PARAMETER_PROVIDER_SIGNAL_LOW_MEMORY:
+      iree_io_parameter_index_provider_trim_residency(provider,
+                                                      /*include_pinned=*/true);
       iree_hal_file_cache_trim(provider->file_cache);
       break;
     default:
@@ -154,6 +212,303 @@ static iree_status_t iree_io_parameter_index_provider_resolve(
   return iree_ok_status();
 }
 
+//===----------------------------------------------------------------------===//
+// Decode-on-load transforms
+//===----------------------------------------------------------------------===//
+
+// A decode transform declared in parameter metadata. Parameters carrying a
+// transform are stored packed in the archive (at true quantized size) and
+// expanded while being loaded so consumers observe the decoded bytes.
+typedef struct iree_io_parameter_decode_info_t {
+  // True when the entry metadata declares a decode transform.
+  bool enabled;
+  // Logical (decoded) bytes produced per packed storage byte.
+  uint64_t expansion;
+  // True when sub-byte values are sign-extended (i4), false for zero-extension
+  // (u4).
+  bool is_signed;
+} iree_io_parameter_decode_info_t;
+
+// Returns true when |haystack| contains |needle| as a substring.
+static bool iree_io_parameter_metadata_contains(iree_const_byte_span_t haystack,
+                                                iree_string_view_t needle) {
+  if (haystack.data_length < needle.size) return false;
+  for (iree_host_size_t i = 0; i <= haystack.data_length - needle.size; ++i) {
+    if (memcmp(haystack.data + i, needle.data, needle.size) == 0) return true;
+  }
+  return false;
+}
+
+// Returns the decode transform declared in |entry| metadata, if any.
+// Transforms are declared as `iree.decode=i4->i8` (sign-extending nibble
+// expansion) or `iree.decode=u4->u8` (zero-extending) tokens embedded in the
+// otherwise opaque metadata bytes.
+static iree_io_parameter_decode_info_t iree_io_parameter_entry_decode_info(
+    const iree_io_parameter_index_entry_t* entry) {
+  iree_io_parameter_decode_info_t info = {0};
+  if (!entry->metadata.data || entry->metadata.data_length == 0) return info;
+  if (iree_io_parameter_metadata_contains(entry->metadata,
+                                          IREE_SV("iree.decode=i4->i8"))) {
+    info.enabled = true;
+    info.expansion = 2;
+    info.is_signed = true;
+  } else if (iree_io_parameter_metadata_contains(
+                 entry->metadata, IREE_SV("iree.decode=u4->u8"))) {
+    info.enabled = true;
+    info.expansion = 2;
+    info.is_signed = false;
+  }
+  return info;
+}
+
+// Returns the logical (decoded) byte length of |entry| as observed by loads.
+// Matches the storage length for parameters without a decode transform.
+static uint64_t iree_io_parameter_entry_logical_length(
+    const iree_io_parameter_index_entry_t* entry) {
+  iree_io_parameter_decode_info_t info =
+      iree_io_parameter_entry_decode_info(entry);
+  return info.enabled ? entry->length * info.expansion : entry->length;
+}
+
+// Expands |packed_length| nibble-packed bytes into 2x as many bytes with each
+// nibble widened to a full byte. Nibbles are stored little-endian (low nibble
+// is the first logical element).
+static void iree_io_parameter_decode_nibbles(const uint8_t* packed,
+                                             iree_host_size_t packed_length,
+                                             uint8_t* unpacked,
+                                             bool is_signed) {
+  for (iree_host_size_t i = 0; i < packed_length; ++i) {
+    const uint8_t byte = packed[i];
+    const uint8_t lo = byte & 0x0F;
+    const uint8_t hi = byte >> 4;
+    if (is_signed) {
+      unpacked[2 * i + 0] = (uint8_t)((int8_t)(lo << 4) >> 4);
+      unpacked[2 * i + 1] = (uint8_t)((int8_t)(hi << 4) >> 4);
+    } else {
+      unpacked[2 * i + 0] = lo;
+      unpacked[2 * i + 1] = hi;
+    }
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Device residency cache
+//===----------------------------------------------------------------------===//
+
+// Returns true when |entry| opts in to residency caching via an
+// `iree.residency=pinned` or `iree.residency=lru` token in its metadata.
+// Tagging is a declaration that the loaded contents are immutable: cached
+// copies are shared by reference with every subsequent load of the parameter.
+// |out_pinned| receives whether the entry is exempt from budget eviction.
+static bool iree_io_parameter_entry_residency_info(
+    const iree_io_parameter_index_entry_t* entry, bool* out_pinned) {
+  *out_pinned = false;
+  if (!entry->metadata.data || entry->metadata.data_length == 0) return false;
+  if (iree_io_parameter_metadata_contains(entry->metadata,
+                                          IREE_SV("iree.residency=pinned"))) {
+    *out_pinned = true;
+    return true;
+  }
+  return iree_io_parameter_metadata_contains(entry->metadata,
+                                             IREE_SV("iree.residency=lru"));
+}
+
+// Frees |record| and releases the resources it retains.
+// Must be called outside of the residency mutex as buffer release may reenter
+// the device allocator.
+static void iree_io_parameter_residency_record_free(
+    iree_allocator_t host_allocator,
+    iree_io_parameter_residency_record_t* record) {
+  iree_hal_buffer_release(record->buffer);
+  iree_hal_semaphore_release(record->ready_semaphore);
+  iree_allocator_free(host_allocator, record);
+}
+
+// Drops residency records from |provider|, optionally including pinned ones.
+static void iree_io_parameter_index_provider_trim_residency(
+    iree_io_parameter_index_provider_t* provider, bool include_pinned) {
+  iree_io_parameter_residency_record_t* dropped_head = NULL;
+  iree_slim_mutex_lock(&provider->residency_mutex);
+  iree_io_parameter_residency_record_t** link = &provider->residency_head;
+  while (*link) {
+    iree_io_parameter_residency_record_t* record = *link;
+    if (record->pinned && !include_pinned) {
+      link = &record->next;
+      continue;
+    }
+    *link = record->next;
+    provider->residency_total_size -= record->size;
+    record->next = dropped_head;
+    dropped_head = record;
+  }
+  iree_slim_mutex_unlock(&provider->residency_mutex);
+  while (dropped_head) {
+    iree_io_parameter_residency_record_t* record = dropped_head;
+    dropped_head = record->next;
+    iree_io_parameter_residency_record_free(provider->host_allocator, record);
+  }
+}
+
+// Evicts the least-recently-used unpinned records until the retained total
+// fits the budget, appending them to |dropped_head| for release by the caller.
+// Must be called with the residency mutex held.
+static void iree_io_parameter_residency_evict_to_budget(
+    iree_io_parameter_index_provider_t* provider,
+    iree_io_parameter_residency_record_t** dropped_head) {
+  while (provider->residency_total_size > provider->residency_budget) {
+    iree_io_parameter_residency_record_t** victim_link = NULL;
+    uint64_t victim_last_use = UINT64_MAX;
+    for (iree_io_parameter_residency_record_t** link =
+             &provider->residency_head;
+         *link; link = &(*link)->next) {
+      iree_io_parameter_residency_record_t* record = *link;
+      if (!record->pinned && record->last_use < victim_last_use) {
+        victim_last_use = record->last_use;
+        victim_link = link;
+      }
+    }
+    if (!victim_link) break;  // only pinned records remain
+    iree_io_parameter_residency_record_t* victim = *victim_link;
+    *victim_link = victim->next;
+    provider->residency_total_size -= victim->size;
+    victim->next = *dropped_head;
+    *dropped_head = victim;
+  }
+}
+
+// Looks up a resident copy of |entry| previously loaded on |device| that is
+// compatible with |target_params| and at least |length| bytes. Returns a
+// retained buffer or NULL when no usable copy exists. Records whose producing
+// load has not yet signaled are skipped.
+static iree_hal_buffer_t* iree_io_parameter_residency_cache_lookup(
+    iree_io_parameter_index_provider_t* provider, iree_hal_device_t* device,
+    const iree_io_parameter_index_entry_t* entry,
+    iree_hal_buffer_params_t target_params, uint64_t length) {
+  iree_hal_buffer_t* buffer = NULL;
+  iree_hal_semaphore_t* reached_semaphore = NULL;
+  iree_slim_mutex_lock(&provider->residency_mutex);
+  for (iree_io_parameter_residency_record_t* record = provider->residency_head;
+       record; record = record->next) {
+    if (record->entry != entry || record->device != device) continue;
+    if (record->ready_semaphore) {
+      uint64_t current_value = 0;
+      iree_status_t query_status =
+          iree_hal_semaphore_query(record->ready_semaphore, &current_value);
+      if (!iree_status_is_ok(query_status) ||
+          current_value < record->ready_value) {
+        iree_status_ignore(query_status);
+        break;  // initial load still in flight; fall back to a fresh load
+      }
+      reached_semaphore = record->ready_semaphore;
+      record->ready_semaphore = NULL;
+    }
+    if (!iree_all_bits_set(iree_hal_buffer_memory_type(record->buffer),
+                           target_params.type) ||
+        !iree_all_bits_set(iree_hal_buffer_allowed_usage(record->buffer),
+                           target_params.usage) ||
+        iree_hal_buffer_byte_length(record->buffer) < length) {
+      break;  // resident copy is incompatible with the requested placement
+    }
+    record->last_use = ++provider->residency_clock;
+    buffer = record->buffer;
+    iree_hal_buffer_retain(buffer);
+    break;
+  }
+  iree_slim_mutex_unlock(&provider->residency_mutex);
+  iree_hal_semaphore_release(reached_semaphore);
+  return buffer;
+}
+
+// Inserts a resident copy of |entry| into the cache, evicting LRU records as
+// needed to stay under the budget. The record becomes servable once the first
+// semaphore of |signal_semaphore_list| reaches its payload (the producing
+// load has completed). No-op when the budget is zero or on races where a
+// record for the (entry, device) pair already exists.
+static void iree_io_parameter_residency_cache_insert(
+    iree_io_parameter_index_provider_t* provider, iree_hal_device_t* device,
+    const iree_io_parameter_index_entry_t* entry, iree_hal_buffer_t* buffer,
+    uint64_t length, bool pinned,
+    const iree_hal_semaphore_list_t signal_semaphore_list) {
+  if (!provider->residency_budget) return;
+  if (!pinned && (iree_device_size_t)length > provider->residency_budget) {
+    return;  // would be immediately evicted
+  }
+
+  iree_io_parameter_residency_record_t* record = NULL;
+  if (!iree_status_is_ok(iree_allocator_malloc(
+          provider->host_allocator, sizeof(*record), (void**)&record))) {
+    return;  // caching is best-effort
+  }
+  record->entry = entry;
+  record->device = device;
+  record->buffer = buffer;
+  iree_hal_buffer_retain(buffer);
+  record->size = (iree_device_size_t)length;
+  if (signal_semaphore_list.count > 0) {
+    record->ready_semaphore = signal_semaphore_list.semaphores[0];
+    record->ready_value = signal_semaphore_list.payload_values[0];
+    iree_hal_semaphore_retain(record->ready_semaphore);
+  }
+  record->pinned = pinned;
+
+  iree_io_parameter_residency_record_t* dropped_head = NULL;
+  iree_slim_mutex_lock(&provider->residency_mutex);
+  bool exists = false;
+  for (iree_io_parameter_residency_record_t* existing =
+           provider->residency_head;
+       existing; existing = existing->next) {
+    if (existing->entry == entry && existing->device == device) {
+      exists = true;
+      break;
+    }
+  }
+  if (exists) {
+    record->next = dropped_head;
+    dropped_head = record;
+  } else {
+    record->last_use = ++provider->residency_clock;
+    record->next = provider->residency_head;
+    provider->residency_head = record;
+    provider->residency_total_size += record->size;
+    iree_io_parameter_residency_evict_to_budget(provider, &dropped_head);
+  }
+  iree_slim_mutex_unlock(&provider->residency_mutex);
+  while (dropped_head) {
+    iree_io_parameter_residency_record_t* dropped = dropped_head;
+    dropped_head = dropped->next;
+    iree_io_parameter_residency_record_free(provider->host_allocator, dropped);
+  }
+}
+
+IREE_API_EXPORT iree_status_t
+iree_io_parameter_index_provider_set_residency_budget(
+    iree_io_parameter_provider_t* base_provider, iree_device_size_t budget) {
+  IREE_ASSERT_ARGUMENT(base_provider);
+  if (base_provider->vtable != &iree_io_parameter_index_provider_vtable) {
+    return iree_make_status(
+        IREE_STATUS_INVALID_ARGUMENT,
+        "provider was not created by iree_io_parameter_index_provider_create");
+  }
+  iree_io_parameter_index_provider_t* provider =
+      iree_io_parameter_index_provider_cast(base_provider);
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, (int64_t)budget);
+
+  iree_io_parameter_residency_record_t* dropped_head = NULL;
+  iree_slim_mutex_lock(&provider->residency_mutex);
+  provider->residency_budget = budget;
+  iree_io_parameter_residency_evict_to_budget(provider, &dropped_head);
+  iree_slim_mutex_unlock(&provider->residency_mutex);
+  while (dropped_head) {
+    iree_io_parameter_residency_record_t* record = dropped_head;
+    dropped_head = record->next;
+    iree_io_parameter_residency_record_free(provider->host_allocator, record);
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
 // Validates that the range specified by [offset, offset+length) is in bounds.
 static iree_status_t iree_io_validate_parameter_range(
     iree_hal_memory_access_t required_access,
@@ -203,12 +558,17 @@ static iree_status_t iree_io_validate_parameter_range(
 #endif  // IREE_STATUS_MODE
   }
 
-  if (offset + length > entry->length) {
+  // Ranges are validated against the logical length: parameters with a
+  // decode-on-load transform appear to consumers at their decoded size even
+  // though the archive stores them packed.
+  const uint64_t logical_length =
+      iree_io_parameter_entry_logical_length(entry);
+  if (offset + length > logical_length) {
     return iree_make_status(
         IREE_STATUS_OUT_OF_RANGE,
         "parameter `%.*s` range out of bounds (offset=%" PRIu64
         ", length=%" PRIu64 ", size=%" PRIu64 ")",
-        (int)entry->key.size, entry->key.data, offset, length, entry->length);
+        (int)entry->key.size, entry->key.data, offset, length, logical_length);
   }
 
   return iree_ok_status();
@@ -478,6 +838,18 @@ static iree_status_t iree_io_parameter_op_batch_enqueue_alloca(
   return iree_ok_status();
 }
 
+// Creates and begins recording the on-demand transfer command buffer used for
+// DMA operations (splats, copies) on first use.
+static iree_status_t iree_io_parameter_op_batch_acquire_transfer_command_buffer(
+    iree_io_parameter_op_batch_t* batch) {
+  if (batch->transfer_command_buffer) return iree_ok_status();
+  IREE_RETURN_IF_ERROR(iree_hal_command_buffer_create(
+      batch->device, IREE_HAL_COMMAND_BUFFER_MODE_ONE_SHOT,
+      IREE_HAL_COMMAND_CATEGORY_TRANSFER, batch->queue_affinity, 0,
+      &batch->transfer_command_buffer));
+  return iree_hal_command_buffer_begin(batch->transfer_command_buffer);
+}
+
 // Enqueues a splat operation in the batch into the |buffer| range.
 // Splats get routed to a transfer command buffer that we'll submit at the end
 // of the batch. This avoids the need for us to check all of the operations
@@ -494,15 +866,8 @@ static iree_status_t iree_io_parameter_op_batch_enqueue_splat(
   IREE_TRACE_ZONE_BEGIN(z0);
 
   // Create the transfer command buffer on first use.
-  if (!batch->transfer_command_buffer) {
-    IREE_RETURN_AND_END_ZONE_IF_ERROR(
-        z0, iree_hal_command_buffer_create(
-                batch->device, IREE_HAL_COMMAND_BUFFER_MODE_ONE_SHOT,
-                IREE_HAL_COMMAND_CATEGORY_TRANSFER, batch->queue_affinity, 0,
-                &batch->transfer_command_buffer));
-    IREE_RETURN_AND_END_ZONE_IF_ERROR(
-        z0, iree_hal_command_buffer_begin(batch->transfer_command_buffer));
-  }
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_io_parameter_op_batch_acquire_transfer_command_buffer(batch));
 
   // Add the splat fill to the command buffer.
   // Parameter ranges cannot overlap so there's no barrier required.
@@ -527,6 +892,25 @@ static iree_status_t iree_io_parameter_op_batch_enqueue_file_read(
   IREE_ASSERT_ARGUMENT(target_buffer);
   IREE_TRACE_ZONE_BEGIN(z0);
 
+  // Files whose storage was imported as a device-visible buffer can be read
+  // with plain DMA copies. Gather those into the shared transfer command
+  // buffer so that all fragments of a sharded/strided parameter go out as a
+  // single submission instead of one queue operation per fragment.
+  iree_hal_buffer_t* storage_buffer = iree_hal_file_storage_buffer(source_file);
+  if (storage_buffer) {
+    iree_status_t status =
+        iree_io_parameter_op_batch_acquire_transfer_command_buffer(batch);
+    if (iree_status_is_ok(status)) {
+      batch->transfer_bytes_outstanding += length;
+      status = iree_hal_command_buffer_copy_buffer(
+          batch->transfer_command_buffer, storage_buffer,
+          (iree_device_size_t)source_file_offset, target_buffer,
+          target_buffer_offset, length);
+    }
+    IREE_TRACE_ZONE_END(z0);
+    return status;
+  }
+
   iree_io_parameter_op_step_t step;
   IREE_RETURN_AND_END_ZONE_IF_ERROR(
       z0, iree_io_parameter_op_batch_advance_timeline(batch, length, &step));
@@ -550,6 +934,22 @@ static iree_status_t iree_io_parameter_op_batch_enqueue_file_write(
   IREE_ASSERT_ARGUMENT(target_file);
   IREE_TRACE_ZONE_BEGIN(z0);
 
+  // As with reads, writes to files backed by imported buffers are scattered
+  // through the shared transfer command buffer as DMA copies.
+  iree_hal_buffer_t* storage_buffer = iree_hal_file_storage_buffer(target_file);
+  if (storage_buffer) {
+    iree_status_t status =
+        iree_io_parameter_op_batch_acquire_transfer_command_buffer(batch);
+    if (iree_status_is_ok(status)) {
+      batch->transfer_bytes_outstanding += length;
+      status = iree_hal_command_buffer_copy_buffer(
+          batch->transfer_command_buffer, source_buffer, source_buffer_offset,
+          storage_buffer, (iree_device_size_t)target_file_offset, length);
+    }
+    IREE_TRACE_ZONE_END(z0);
+    return status;
+  }
+
   iree_io_parameter_op_step_t step;
   IREE_RETURN_AND_END_ZONE_IF_ERROR(
       z0, iree_io_parameter_op_batch_advance_timeline(batch, length, &step));
@@ -563,6 +963,66 @@ static iree_status_t iree_io_parameter_op_batch_enqueue_file_write(
   return status;
 }
 
+// A pending file range accumulated across sequential batch entries.
+// Parameter files are commonly laid out in enumeration order so adjacent
+// entries frequently form one contiguous range in both the file and the
+// target/source buffer; issuing the merged range as a single queue operation
+// replaces thousands of small reads with a few large ones that amortize the
+// fixed per-operation overhead.
+typedef struct iree_io_parameter_file_span_t {
+  // File being accessed; retained while a span is pending, NULL if none.
+  iree_hal_file_t* file;
+  // Offset into the file where the span begins.
+  uint64_t file_offset;
+  // Offset into the buffer where the span begins.
+  iree_device_size_t buffer_offset;
+  // Total length of the span in bytes.
+  iree_device_size_t length;
+} iree_io_parameter_file_span_t;
+
+// Tries to extend the pending |span| with a new range and returns true if the
+// range directly continues the span in both the file and the buffer. Ranges
+// with gaps are never merged as the bytes between them may belong to
+// parameters outside of the batch.
+static bool iree_io_parameter_file_span_try_extend(
+    iree_io_parameter_file_span_t* span, iree_hal_file_t* file,
+    uint64_t file_offset, iree_device_size_t buffer_offset,
+    iree_device_size_t length) {
+  if (span->file != file) return false;
+  if (file_offset != span->file_offset + span->length) return false;
+  if (buffer_offset != span->buffer_offset + span->length) return false;
+  span->length += length;
+  return true;
+}
+
+// Flushes the pending |span| (if any) as a single read from the span file
+// into |target_buffer| and resets the span for reuse.
+static iree_status_t iree_io_parameter_file_span_flush_read(
+    iree_io_parameter_op_batch_t* batch, iree_io_parameter_file_span_t* span,
+    iree_hal_buffer_t* target_buffer) {
+  if (!span->file) return iree_ok_status();
+  iree_status_t status = iree_io_parameter_op_batch_enqueue_file_read(
+      batch, span->file, span->file_offset, target_buffer, span->buffer_offset,
+      span->length, 0);
+  iree_hal_file_release(span->file);
+  memset(span, 0, sizeof(*span));
+  return status;
+}
+
+// Flushes the pending |span| (if any) as a single write from |source_buffer|
+// into the span file and resets the span for reuse.
+static iree_status_t iree_io_parameter_file_span_flush_write(
+    iree_io_parameter_op_batch_t* batch, iree_io_parameter_file_span_t* span,
+    iree_hal_buffer_t* source_buffer) {
+  if (!span->file) return iree_ok_status();
+  iree_status_t status = iree_io_parameter_op_batch_enqueue_file_write(
+      batch, source_buffer, span->buffer_offset, span->file, span->file_offset,
+      span->length, 0);
+  iree_hal_file_release(span->file);
+  memset(span, 0, sizeof(*span));
+  return status;
+}
+
 // Flushes any outstanding work in the |batch| and signals the user timeline.
 // Must only be called once at the end of the batch.
 static iree_status_t iree_io_parameter_op_batch_flush(
@@ -673,6 +1133,85 @@ static void iree_io_file_handle_buffer_release(void* user_data,
   iree_io_file_handle_release((iree_io_file_handle_t*)user_data);
 }
 
+// Loads a parameter carrying a decode-on-load transform by expanding the
+// packed archive bytes and uploading the decoded contents to a new target
+// buffer. The provider has no mechanism for issuing device dispatches so the
+// expansion runs on the host as part of upload staging; archives still ship
+// and page in at true quantized size.
+static iree_status_t iree_io_parameter_load_decoded(
+    iree_io_parameter_index_provider_t* provider, iree_hal_device_t* device,
+    const iree_io_parameter_index_entry_t* entry,
+    iree_io_parameter_decode_info_t decode_info, iree_io_parameter_span_t span,
+    iree_hal_buffer_params_t target_params,
+    iree_hal_buffer_t** IREE_RESTRICT out_buffer) {
+  IREE_ASSERT_ARGUMENT(out_buffer);
+  *out_buffer = NULL;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Only whole-parameter loads can be decoded; subranges would require
+  // sub-byte addressing into the packed storage.
+  const uint64_t logical_length = entry->length * decode_info.expansion;
+  if (span.parameter_offset != 0 || span.buffer_offset != 0 ||
+      span.length != logical_length) {
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(
+        IREE_STATUS_UNIMPLEMENTED,
+        "parameter `%.*s` has a decode-on-load transform and only supports "
+        "whole-parameter loads (offset=%" PRIu64 ", length=%" PRIu64
+        ", logical size=%" PRIu64 ")",
+        (int)entry->key.size, entry->key.data, span.parameter_offset,
+        span.length, logical_length);
+  }
+  if (entry->type != IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_FILE ||
+      iree_io_file_handle_type(entry->storage.file.handle) !=
+          IREE_IO_FILE_HANDLE_TYPE_HOST_ALLOCATION) {
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(
+        IREE_STATUS_UNIMPLEMENTED,
+        "parameter `%.*s` has a decode-on-load transform requiring a mapped "
+        "archive file",
+        (int)entry->key.size, entry->key.data);
+  }
+  const uint8_t* packed =
+      iree_io_file_handle_primitive(entry->storage.file.handle)
+          .value.host_allocation.data +
+      entry->storage.file.offset;
+
+  // Expand into transient host memory used as the upload source.
+  uint8_t* unpacked = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(provider->host_allocator,
+                                (iree_host_size_t)logical_length,
+                                (void**)&unpacked));
+  iree_io_parameter_decode_nibbles(packed, (iree_host_size_t)entry->length,
+                                   unpacked, decode_info.is_signed);
+
+  // Allocate the target and synchronously upload the decoded contents. The
+  // caller links the user timeline with a barrier so no queue operations are
+  // required here.
+  iree_hal_buffer_params_t buffer_params = target_params;
+  buffer_params.usage |= IREE_HAL_BUFFER_USAGE_TRANSFER_TARGET;
+  iree_hal_buffer_t* target_buffer = NULL;
+  iree_status_t status = iree_hal_allocator_allocate_buffer(
+      iree_hal_device_allocator(device), buffer_params,
+      (iree_device_size_t)logical_length, &target_buffer);
+  if (iree_status_is_ok(status)) {
+    status = iree_hal_device_transfer_h2d(
+        device, unpacked, target_buffer, 0,
+        (iree_device_size_t)logical_length,
+        IREE_HAL_TRANSFER_BUFFER_FLAG_DEFAULT, iree_infinite_timeout());
+  }
+  iree_allocator_free(provider->host_allocator, unpacked);
+
+  if (iree_status_is_ok(status)) {
+    *out_buffer = target_buffer;
+  } else {
+    iree_hal_buffer_release(target_buffer);
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
 static iree_status_t iree_io_parameter_index_provider_load(
     iree_io_parameter_provider_t* base_provider, iree_hal_device_t* device,
     iree_hal_queue_affinity_t queue_affinity,
@@ -728,8 +1267,43 @@ static iree_status_t iree_io_parameter_index_provider_load(
     // conditions in which we use this with some better file handle helpers that
     // allow us to map files that we already have open via other mechanisms
     // (FILE, fd, etc).
+    // Parameters with a decode-on-load transform are expanded while loading
+    // instead of being read or imported directly.
+    iree_io_parameter_decode_info_t decode_info = {0};
+    if (iree_status_is_ok(status)) {
+      decode_info = iree_io_parameter_entry_decode_info(source_entry);
+    }
+
+    // Serve whole-parameter loads of residency-tagged entries from the cache
+    // when a compatible copy is still resident on the device. On a hit no
+    // work is enqueued; the batch issues a barrier chaining the caller's
+    // timeline just like the import path below.
     iree_hal_buffer_t* target_buffer = NULL;
+    bool residency_cacheable = false;
+    bool residency_hit = false;
+    bool residency_pinned = false;
     if (iree_status_is_ok(status) &&
+        iree_io_parameter_entry_residency_info(source_entry,
+                                               &residency_pinned) &&
+        span.parameter_offset == 0 && span.buffer_offset == 0 &&
+        span.length ==
+            iree_io_parameter_entry_logical_length(source_entry)) {
+      residency_cacheable = true;
+      target_buffer = iree_io_parameter_residency_cache_lookup(
+          provider, device, source_entry, target_params, span.length);
+      if (target_buffer) {
+        residency_hit = true;
+        IREE_TRACE_ZONE_APPEND_TEXT(z_entry, "residency hit");
+      }
+    }
+
+    if (iree_status_is_ok(status) && !target_buffer && decode_info.enabled) {
+      IREE_TRACE_ZONE_APPEND_TEXT(z_entry, "decode-on-load");
+      status = iree_io_parameter_load_decoded(provider, device, source_entry,
+                                              decode_info, span, target_params,
+                                              &target_buffer);
+    }
+    if (iree_status_is_ok(status) && !target_buffer && !decode_info.enabled &&
         source_entry->type == IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_FILE &&
         iree_io_file_handle_type(source_entry->storage.file.handle) ==
             IREE_IO_FILE_HANDLE_TYPE_HOST_ALLOCATION) {
@@ -809,6 +1383,16 @@ static iree_status_t iree_io_parameter_index_provider_load(
 
     iree_hal_file_release(source_file);
 
+    // Retain freshly-loaded copies of residency-tagged parameters for reuse
+    // by later loads. The record is served once the signal semaphores reach
+    // their payloads (the contents are known valid).
+    if (iree_status_is_ok(status) && residency_cacheable && !residency_hit &&
+        target_buffer) {
+      iree_io_parameter_residency_cache_insert(
+          provider, device, source_entry, target_buffer, span.length,
+          residency_pinned, signal_semaphore_list);
+    }
+
     // Emit the target buffer so the caller can handle it. The callee must
     // retain it if they want to keep it live. We're allowed to emit out of
     // order but are currently always 1:1 with enumeration (which may be useful
@@ -847,6 +1431,12 @@ static iree_status_t iree_io_parameter_index_provider_gather(
                                    wait_semaphore_list, signal_semaphore_list,
                                    &batch);
 
+  // Range coalescing state; file reads from adjacent entries are merged into
+  // one operation when they are contiguous in both the file and the target
+  // buffer (the common case when parameters are stored in enumeration order).
+  iree_io_parameter_file_span_t pending_span;
+  memset(&pending_span, 0, sizeof(pending_span));
+
   // Process each entry by enqueuing the appropriate operation.
   iree_status_t status = iree_ok_status();
   for (iree_host_size_t i = 0; i < count; ++i) {
@@ -867,6 +1457,17 @@ static iree_status_t iree_io_parameter_index_provider_gather(
       IREE_TRACE_ZONE_APPEND_VALUE_I64(z_entry, span.length);
     }
 
+    // Decoded parameters can only be materialized by loads; gathers copy raw
+    // file ranges and would observe the packed bytes.
+    if (iree_status_is_ok(status) &&
+        iree_io_parameter_entry_decode_info(source_entry).enabled) {
+      status = iree_make_status(
+          IREE_STATUS_FAILED_PRECONDITION,
+          "parameter `%.*s` has a decode-on-load transform and cannot be "
+          "gathered; use a load instead",
+          (int)source_entry->key.size, source_entry->key.data);
+    }
+
     // Enqueue the transfer/file operation.
     if (iree_status_is_ok(status)) {
       switch (source_entry->type) {
@@ -880,10 +1481,23 @@ static iree_status_t iree_io_parameter_index_provider_gather(
         }
         case IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_FILE: {
           IREE_ASSERT(source_file);
-          status = iree_io_parameter_op_batch_enqueue_file_read(
-              &batch, source_file,
-              source_entry->storage.file.offset + span.parameter_offset,
-              target_buffer, span.buffer_offset, span.length, 0);
+          const uint64_t file_offset =
+              source_entry->storage.file.offset + span.parameter_offset;
+          if (!iree_io_parameter_file_span_try_extend(
+                  &pending_span, source_file, file_offset, span.buffer_offset,
+                  span.length)) {
+            // Range does not continue the pending span; flush it and begin a
+            // new span with this range.
+            status = iree_io_parameter_file_span_flush_read(
+                &batch, &pending_span, target_buffer);
+            if (iree_status_is_ok(status)) {
+              iree_hal_file_retain(source_file);
+              pending_span.file = source_file;
+              pending_span.file_offset = file_offset;
+              pending_span.buffer_offset = span.buffer_offset;
+              pending_span.length = span.length;
+            }
+          }
           break;
         }
         default: {
@@ -902,6 +1516,15 @@ static iree_status_t iree_io_parameter_index_provider_gather(
     if (!iree_status_is_ok(status)) break;
   }
 
+  // Flush any trailing coalesced read (or just drop the file reference if
+  // we're bailing due to an earlier failure).
+  if (iree_status_is_ok(status)) {
+    status = iree_io_parameter_file_span_flush_read(&batch, &pending_span,
+                                                    target_buffer);
+  } else {
+    iree_hal_file_release(pending_span.file);
+  }
+
   // Flush any outstanding batch operations and end the batch.
   status = iree_io_parameter_op_batch_end(&batch, status);
 
@@ -927,6 +1550,12 @@ static iree_status_t iree_io_parameter_index_provider_scatter(
                                    wait_semaphore_list, signal_semaphore_list,
                                    &batch);
 
+  // Range coalescing state; file writes to adjacent entries are merged into
+  // one operation when they are contiguous in both the file and the source
+  // buffer (the common case when parameters are stored in enumeration order).
+  iree_io_parameter_file_span_t pending_span;
+  memset(&pending_span, 0, sizeof(pending_span));
+
   // Process each entry by enqueuing the appropriate operation.
   iree_status_t status = iree_ok_status();
   for (iree_host_size_t i = 0; i < count; ++i) {
@@ -947,15 +1576,39 @@ static iree_status_t iree_io_parameter_index_provider_scatter(
       IREE_TRACE_ZONE_APPEND_VALUE_I64(z_entry, span.length);
     }
 
+    // Decoded parameters are read-only: the packed storage cannot accept the
+    // expanded bytes a scatter would write.
+    if (iree_status_is_ok(status) &&
+        iree_io_parameter_entry_decode_info(target_entry).enabled) {
+      status = iree_make_status(
+          IREE_STATUS_PERMISSION_DENIED,
+          "parameter `%.*s` has a decode-on-load transform and cannot be "
+          "scattered into",
+          (int)target_entry->key.size, target_entry->key.data);
+    }
+
     // Enqueue the transfer/file operation.
     if (iree_status_is_ok(status)) {
       switch (target_entry->type) {
         case IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_FILE: {
           IREE_ASSERT(target_file);
-          status = iree_io_parameter_op_batch_enqueue_file_write(
-              &batch, source_buffer, span.buffer_offset, target_file,
-              target_entry->storage.file.offset + span.parameter_offset,
-              span.length, 0);
+          const uint64_t file_offset =
+              target_entry->storage.file.offset + span.parameter_offset;
+          if (!iree_io_parameter_file_span_try_extend(
+                  &pending_span, target_file, file_offset, span.buffer_offset,
+                  span.length)) {
+            // Range does not continue the pending span; flush it and begin a
+            // new span with this range.
+            status = iree_io_parameter_file_span_flush_write(
+                &batch, &pending_span, source_buffer);
+            if (iree_status_is_ok(status)) {
+              iree_hal_file_retain(target_file);
+              pending_span.file = target_file;
+              pending_span.file_offset = file_offset;
+              pending_span.buffer_offset = span.buffer_offset;
+              pending_span.length = span.length;
+            }
+          }
           break;
         }
         default: {
@@ -974,6 +1627,15 @@ static iree_status_t iree_io_parameter_index_provider_scatter(
     if (!iree_status_is_ok(status)) break;
   }
 
+  // Flush any trailing coalesced write (or just drop the file reference if
+  // we're bailing due to an earlier failure).
+  if (iree_status_is_ok(status)) {
+    status = iree_io_parameter_file_span_flush_write(&batch, &pending_span,
+                                                     source_buffer);
+  } else {
+    iree_hal_file_release(pending_span.file);
+  }
+
   // Flush any outstanding batch operations and end the batch.
   status = iree_io_parameter_op_batch_end(&batch, status);
 
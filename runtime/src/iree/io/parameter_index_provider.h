@@ -35,6 +35,21 @@ IREE_API_EXPORT iree_status_t iree_io_parameter_index_provider_create(
     iree_host_size_t max_concurrent_operations, iree_allocator_t host_allocator,
     iree_io_parameter_provider_t** out_provider);
 
+// Sets the device residency budget of |provider| to |budget| bytes.
+// While non-zero, whole-parameter loads of index entries carrying an
+// `iree.residency=pinned` or `iree.residency=lru` metadata token retain their
+// device buffers and serve subsequent loads of the same parameter on the same
+// device by reference, so switching between multiplexed models only reloads
+// what was evicted in between. Tagged entries must be immutable. `lru` copies
+// are evicted least-recently-used-first to stay under the budget; `pinned`
+// copies only count against it and are dropped on a low-memory signal.
+// Lowering the budget evicts immediately; 0 (the default) disables caching
+// and drops all unpinned copies. |provider| must have been created with
+// iree_io_parameter_index_provider_create.
+IREE_API_EXPORT iree_status_t
+iree_io_parameter_index_provider_set_residency_budget(
+    iree_io_parameter_provider_t* provider, iree_device_size_t budget);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
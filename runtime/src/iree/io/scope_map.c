@@ -6,6 +6,10 @@
 
 #include "iree/io/scope_map.h"
 
+#include "iree/base/internal/atomics.h"
+#include "iree/base/internal/synchronization.h"
+#include "iree/base/internal/threading.h"
+
 IREE_API_EXPORT void iree_io_scope_map_initialize(
     iree_allocator_t host_allocator, iree_io_scope_map_t* out_scope_map) {
   IREE_TRACE_ZONE_BEGIN(z0);
@@ -76,6 +80,172 @@ IREE_API_EXPORT iree_status_t iree_io_scope_map_lookup(
   return status;
 }
 
+// State shared by enrollment workers. Heap-allocated and reference counted so
+// that the last worker to exit frees it even though the enrolling thread may
+// wake and return as soon as the final file has been parsed.
+typedef struct iree_io_scope_map_enroll_state_t {
+  iree_allocator_t host_allocator;
+  iree_atomic_ref_count_t ref_count;
+  iree_host_size_t file_count;
+  const iree_io_scope_map_file_t* files;
+  // Index each file's parameters are appended to; 1:1 with files, unowned.
+  // Indices are internally synchronized and support concurrent insertion.
+  iree_io_parameter_index_t** indices;
+  iree_io_scope_map_parser_t parser;
+  // Next file to be claimed by a worker.
+  iree_atomic_int32_t next_file;
+  // Number of workers (including the enrolling thread) still running.
+  iree_atomic_int32_t live_workers;
+  // Posted when live_workers reaches zero.
+  iree_notification_t notification;
+  // Guards status below; the first failure observed wins.
+  iree_slim_mutex_t status_mutex;
+  iree_status_t status;
+} iree_io_scope_map_enroll_state_t;
+
+static void iree_io_scope_map_enroll_state_release(
+    iree_io_scope_map_enroll_state_t* state) {
+  if (iree_atomic_ref_count_dec(&state->ref_count) == 1) {
+    iree_slim_mutex_deinitialize(&state->status_mutex);
+    iree_notification_deinitialize(&state->notification);
+    iree_status_ignore(state->status);
+    iree_allocator_free(state->host_allocator, state);
+  }
+}
+
+// Pulls files off the shared work list and parses them until none remain.
+// Runs on both spawned worker threads and the enrolling thread.
+static void iree_io_scope_map_enroll_worker(
+    iree_io_scope_map_enroll_state_t* state) {
+  while (true) {
+    int32_t i = iree_atomic_fetch_add_int32(&state->next_file, 1,
+                                            iree_memory_order_acq_rel);
+    if (i >= (int32_t)state->file_count) break;
+
+    // Skip remaining files once any has failed; entries parsed before the
+    // failure may remain in the map.
+    iree_slim_mutex_lock(&state->status_mutex);
+    bool has_failed = !iree_status_is_ok(state->status);
+    iree_slim_mutex_unlock(&state->status_mutex);
+    if (has_failed) continue;
+
+    const iree_io_scope_map_file_t* file = &state->files[i];
+    iree_status_t status = state->parser.fn(
+        state->parser.user_data, file->path, file->file_handle,
+        state->indices[i]);
+    if (!iree_status_is_ok(status)) {
+      iree_slim_mutex_lock(&state->status_mutex);
+      if (iree_status_is_ok(state->status)) {
+        state->status = status;
+      } else {
+        iree_status_ignore(status);
+      }
+      iree_slim_mutex_unlock(&state->status_mutex);
+    }
+  }
+  if (iree_atomic_fetch_sub_int32(&state->live_workers, 1,
+                                  iree_memory_order_acq_rel) == 1) {
+    iree_notification_post(&state->notification, IREE_ALL_WAITERS);
+  }
+}
+
+static int iree_io_scope_map_enroll_thread_main(void* entry_arg) {
+  iree_io_scope_map_enroll_state_t* state =
+      (iree_io_scope_map_enroll_state_t*)entry_arg;
+  iree_io_scope_map_enroll_worker(state);
+  iree_io_scope_map_enroll_state_release(state);
+  return 0;
+}
+
+static bool iree_io_scope_map_enroll_is_idle(void* arg) {
+  iree_io_scope_map_enroll_state_t* state =
+      (iree_io_scope_map_enroll_state_t*)arg;
+  return iree_atomic_load_int32(&state->live_workers,
+                                iree_memory_order_acquire) == 0;
+}
+
+IREE_API_EXPORT iree_status_t iree_io_scope_map_enroll_files(
+    iree_io_scope_map_t* scope_map, iree_host_size_t file_count,
+    const iree_io_scope_map_file_t* files, iree_io_scope_map_parser_t parser,
+    iree_host_size_t max_concurrency) {
+  if (!file_count) return iree_ok_status();
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, file_count);
+
+  if (!max_concurrency) {
+    max_concurrency = IREE_IO_SCOPE_MAP_DEFAULT_ENROLLMENT_CONCURRENCY;
+  }
+  iree_host_size_t worker_count = iree_min(max_concurrency, file_count);
+
+  iree_io_scope_map_enroll_state_t* state = NULL;
+  iree_host_size_t total_size =
+      sizeof(*state) + file_count * sizeof(state->indices[0]);
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(scope_map->host_allocator, total_size,
+                                (void**)&state));
+  state->host_allocator = scope_map->host_allocator;
+  iree_atomic_ref_count_init(&state->ref_count);  // enrolling thread reference
+  state->file_count = file_count;
+  state->files = files;
+  state->indices =
+      (iree_io_parameter_index_t**)((uint8_t*)state + sizeof(*state));
+  state->parser = parser;
+  iree_atomic_store_int32(&state->next_file, 0, iree_memory_order_relaxed);
+  iree_atomic_store_int32(&state->live_workers, 1, iree_memory_order_relaxed);
+  iree_notification_initialize(&state->notification);
+  iree_slim_mutex_initialize(&state->status_mutex);
+  state->status = iree_ok_status();
+
+  // Resolve the index of each file's scope up-front; the map itself is not
+  // internally synchronized and all mutation stays on the enrolling thread.
+  iree_status_t status = iree_ok_status();
+  for (iree_host_size_t i = 0; i < file_count; ++i) {
+    status =
+        iree_io_scope_map_lookup(scope_map, files[i].scope, &state->indices[i]);
+    if (!iree_status_is_ok(status)) break;
+  }
+
+  if (iree_status_is_ok(status)) {
+    // Spawn additional workers; the enrolling thread participates as one so we
+    // only need worker_count-1 threads and degrade gracefully to parsing
+    // everything inline if thread creation fails.
+    for (iree_host_size_t i = 1; i < worker_count; ++i) {
+      iree_thread_create_params_t params;
+      memset(&params, 0, sizeof(params));
+      params.name = IREE_SV("iree-io-enroll");
+      iree_atomic_ref_count_inc(&state->ref_count);
+      iree_atomic_fetch_add_int32(&state->live_workers, 1,
+                                  iree_memory_order_relaxed);
+      iree_thread_t* thread = NULL;
+      iree_status_t thread_status = iree_thread_create(
+          iree_io_scope_map_enroll_thread_main, state, params,
+          scope_map->host_allocator, &thread);
+      if (!iree_status_is_ok(thread_status)) {
+        iree_atomic_fetch_sub_int32(&state->live_workers, 1,
+                                    iree_memory_order_relaxed);
+        iree_io_scope_map_enroll_state_release(state);
+        iree_status_ignore(thread_status);
+        break;
+      }
+      iree_thread_release(thread);  // the thread holds its own reference
+    }
+
+    // Parse alongside the workers and then wait for any still running.
+    iree_io_scope_map_enroll_worker(state);
+    iree_notification_await(&state->notification,
+                            iree_io_scope_map_enroll_is_idle, state,
+                            iree_infinite_timeout());
+    iree_slim_mutex_lock(&state->status_mutex);
+    status = state->status;
+    state->status = iree_ok_status();
+    iree_slim_mutex_unlock(&state->status_mutex);
+  }
+
+  iree_io_scope_map_enroll_state_release(state);
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
 IREE_API_EXPORT iree_status_t iree_io_scope_map_dump(
     iree_io_scope_map_t* scope_map, iree_string_builder_t* builder) {
   for (iree_host_size_t i = 0; i < scope_map->count; ++i) {
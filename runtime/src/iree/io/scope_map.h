@@ -38,6 +38,43 @@ IREE_API_EXPORT iree_status_t iree_io_scope_map_lookup(
     iree_io_scope_map_t* scope_map, iree_string_view_t scope,
     iree_io_parameter_index_t** out_index);
 
+// Describes a parameter file to be enrolled into a scope map.
+typedef struct iree_io_scope_map_file_t {
+  // Scope the file's parameters are added to; empty for the anonymous scope.
+  iree_string_view_t scope;
+  // Path used for file format identification and logging. May either be the
+  // original file path or just an extension (such as `irpa`).
+  iree_string_view_t path;
+  // Opened file to parse; unowned but must remain live for the duration of
+  // the enrollment call. Parsed indices retain the handle as needed.
+  iree_io_file_handle_t* file_handle;
+} iree_io_scope_map_file_t;
+
+// Parses the parameters in |file_handle| and appends them to |index|.
+// Implementations must be thread-safe as independent files may be parsed
+// concurrently. Typically a thin wrapper around iree_io_parse_file_index.
+typedef struct iree_io_scope_map_parser_t {
+  iree_status_t(IREE_API_PTR* fn)(void* user_data, iree_string_view_t path,
+                                  iree_io_file_handle_t* file_handle,
+                                  iree_io_parameter_index_t* index);
+  void* user_data;
+} iree_io_scope_map_parser_t;
+
+// Default maximum number of files parsed concurrently during enrollment.
+#define IREE_IO_SCOPE_MAP_DEFAULT_ENROLLMENT_CONCURRENCY 8
+
+// Enrolls |file_count| parameter files into the |scope_map| by invoking
+// |parser| on each and appending the parsed entries to the index of the
+// file's scope. Files are independent and parsed concurrently on up to
+// |max_concurrency| workers (0 uses the default); parameter indices support
+// concurrent insertion so files sharing a scope still parse in parallel.
+// Returns the first failure observed; entries parsed before the failure may
+// remain in the map.
+IREE_API_EXPORT iree_status_t iree_io_scope_map_enroll_files(
+    iree_io_scope_map_t* scope_map, iree_host_size_t file_count,
+    const iree_io_scope_map_file_t* files, iree_io_scope_map_parser_t parser,
+    iree_host_size_t max_concurrency);
+
 IREE_API_EXPORT iree_status_t iree_io_scope_map_dump(
     iree_io_scope_map_t* scope_map, iree_string_builder_t* builder);
 
@@ -143,10 +143,41 @@ typedef struct iree_hal_inline_module_t {
   (iree_hal_inline_module_t*)((uint8_t*)(module) + \
                               iree_vm_native_module_size());
 
+// Number of recently created buffer views retained for reuse per context.
+#define IREE_HAL_INLINE_MODULE_VIEW_CACHE_CAPACITY 4
+// Maximum shape rank of a view eligible for caching; higher ranks bypass the
+// cache so key storage stays fixed-size.
+#define IREE_HAL_INLINE_MODULE_VIEW_CACHE_MAX_RANK 4
+
+// A recently created buffer view retained for reuse alongside the creation
+// parameters that act as its cache key. The source buffer pointer is safe to
+// compare by identity as the cached view keeps the buffer live and the
+// pointer cannot be recycled while the entry exists.
+typedef struct iree_hal_inline_cached_buffer_view_t {
+  // Retained view; NULL indicates an empty slot.
+  iree_hal_buffer_view_t* view;
+  iree_hal_buffer_t* source_buffer;
+  iree_device_size_t source_offset;
+  iree_device_size_t source_length;
+  iree_hal_element_type_t element_type;
+  iree_hal_encoding_type_t encoding_type;
+  iree_host_size_t shape_rank;
+  iree_hal_dim_t shape_dims[IREE_HAL_INLINE_MODULE_VIEW_CACHE_MAX_RANK];
+} iree_hal_inline_cached_buffer_view_t;
+
 typedef struct iree_hal_inline_module_state_t {
   iree_allocator_t host_allocator;
   iree_hal_allocator_t* device_allocator;
   iree_hal_inline_module_flags_t flags;
+
+  // Buffer views reused when identical ones are requested again, as happens
+  // when the same I/O buffers are bound each invocation. Replaced
+  // round-robin; module states are confined to a single context so no
+  // synchronization is required. Cached entries (and the buffers they keep
+  // live) are released with the state.
+  iree_host_size_t view_cache_next;
+  iree_hal_inline_cached_buffer_view_t
+      view_cache[IREE_HAL_INLINE_MODULE_VIEW_CACHE_CAPACITY];
 } iree_hal_inline_module_state_t;
 
 static void IREE_API_PTR iree_hal_inline_module_destroy(void* base_module) {
@@ -182,6 +213,9 @@ static void IREE_API_PTR iree_hal_inline_module_free_state(
 
   iree_hal_inline_module_state_t* state =
       (iree_hal_inline_module_state_t*)module_state;
+  for (iree_host_size_t i = 0; i < IREE_ARRAYSIZE(state->view_cache); ++i) {
+    iree_hal_buffer_view_release(state->view_cache[i].view);
+  }
   iree_hal_allocator_release(state->device_allocator);
   state->device_allocator = NULL;
   iree_allocator_free(state->host_allocator, state);
@@ -402,6 +436,26 @@ IREE_VM_ABI_EXPORT(iree_hal_inline_module_buffer_view_create,  //
   IREE_VM_ABI_VLA_STACK_CAST(args, a5_count, a5, iree_hal_dim_t, 128,
                              &shape_rank, &shape_dims);
 
+  // Reuse a recently created view when all parameters match; views are
+  // immutable metadata and any equivalent one is interchangeable.
+  for (iree_host_size_t i = 0; i < IREE_ARRAYSIZE(state->view_cache); ++i) {
+    iree_hal_inline_cached_buffer_view_t* entry = &state->view_cache[i];
+    if (entry->view == NULL || entry->source_buffer != source_buffer ||
+        entry->source_offset != source_offset ||
+        entry->source_length != source_length ||
+        entry->element_type != element_type ||
+        entry->encoding_type != encoding_type ||
+        entry->shape_rank != shape_rank) {
+      continue;
+    }
+    if (memcmp(entry->shape_dims, shape_dims,
+               shape_rank * sizeof(shape_dims[0])) != 0) {
+      continue;
+    }
+    rets->r0 = iree_hal_buffer_view_retain_ref(entry->view);
+    return iree_ok_status();
+  }
+
   iree_hal_buffer_t* subspan_buffer = NULL;
   if (source_offset != 0 ||
       source_length != iree_hal_buffer_byte_length(source_buffer)) {
@@ -420,6 +474,25 @@ IREE_VM_ABI_EXPORT(iree_hal_inline_module_buffer_view_create,  //
 
   iree_hal_buffer_release(subspan_buffer);
 
+  // Retain the new view in the cache so an identical request can reuse it.
+  if (shape_rank <= IREE_HAL_INLINE_MODULE_VIEW_CACHE_MAX_RANK) {
+    iree_hal_inline_cached_buffer_view_t* entry =
+        &state->view_cache[state->view_cache_next];
+    state->view_cache_next =
+        (state->view_cache_next + 1) % IREE_ARRAYSIZE(state->view_cache);
+    iree_hal_buffer_view_release(entry->view);
+    iree_hal_buffer_view_retain(buffer_view);
+    entry->view = buffer_view;
+    entry->source_buffer = source_buffer;
+    entry->source_offset = source_offset;
+    entry->source_length = source_length;
+    entry->element_type = element_type;
+    entry->encoding_type = encoding_type;
+    entry->shape_rank = shape_rank;
+    memcpy(entry->shape_dims, shape_dims,
+           shape_rank * sizeof(shape_dims[0]));
+  }
+
   rets->r0 = iree_hal_buffer_view_move_ref(buffer_view);
   return iree_ok_status();
 }
@@ -566,12 +639,19 @@ static_assert(IREE_ARRAYSIZE(iree_hal_inline_module_funcs_) ==
                   IREE_ARRAYSIZE(iree_hal_inline_module_exports_),
               "function pointer table must be 1:1 with exports");
 
+// Module state is immutable after initialization (allocator ref + flags) so
+// forked contexts can alias it.
+static const iree_string_pair_t iree_hal_inline_module_attrs_[] = {
+    {{iree_string_view_literal("vm.state.model")},
+     {iree_string_view_literal("shared")}},
+};
+
 static const iree_vm_native_module_descriptor_t
     iree_hal_inline_module_descriptor_ = {
         .name = iree_string_view_literal("hal_inline"),
         .version = IREE_HAL_INLINE_MODULE_VERSION_LATEST,
-        .attr_count = 0,
-        .attrs = NULL,
+        .attr_count = IREE_ARRAYSIZE(iree_hal_inline_module_attrs_),
+        .attrs = iree_hal_inline_module_attrs_,
         .dependency_count = 0,
         .dependencies = NULL,
         .import_count = 0,  // workaround for 0-length C struct
@@ -580,6 +660,8 @@ static const iree_vm_native_module_descriptor_t
         .exports = iree_hal_inline_module_exports_,
         .function_count = IREE_ARRAYSIZE(iree_hal_inline_module_funcs_),
         .functions = iree_hal_inline_module_funcs_,
+        // All exports complete synchronously without re-entering the VM.
+        .flags = IREE_VM_NATIVE_MODULE_FLAG_LEAF,
 };
 
 IREE_API_EXPORT iree_status_t iree_hal_inline_module_create(
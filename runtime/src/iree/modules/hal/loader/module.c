@@ -379,6 +379,8 @@ static const iree_vm_native_module_descriptor_t
         .exports = iree_hal_loader_module_exports_,
         .function_count = IREE_ARRAYSIZE(iree_hal_loader_module_funcs_),
         .functions = iree_hal_loader_module_funcs_,
+        // All exports complete synchronously without re-entering the VM.
+        .flags = IREE_VM_NATIVE_MODULE_FLAG_LEAF,
 };
 
 IREE_API_EXPORT iree_status_t iree_hal_loader_module_create(
@@ -52,6 +52,33 @@ static void IREE_API_PTR iree_hal_module_destroy(void* base_module) {
   }
 }
 
+// Number of recently imported external buffers cached per context.
+// Serving patterns round-trip a small fixed ring of pinned host buffers
+// through allocator.import on every request; caching the resulting wrapper
+// buffers makes re-import a table probe instead of a fresh allocation and
+// validation. Entries are evicted round-robin.
+#define IREE_HAL_MODULE_IMPORT_CACHE_CAPACITY 8
+
+// A cached external buffer import.
+// The wrapper buffer is retained by the cache - and transitively keeps the
+// backing iree_vm_buffer_t alive via its release callback - until evicted or
+// the module state is freed.
+typedef struct iree_hal_module_import_cache_entry_t {
+  // Allocator the import was performed against. Unretained; the wrapper
+  // buffer keeps the allocator alive so pointer comparison is safe.
+  iree_hal_allocator_t* allocator;
+  // Imported host span.
+  void* ptr;
+  iree_device_size_t length;
+  // Parameters the wrapper was imported with; must match exactly for reuse.
+  iree_hal_memory_type_t memory_types;
+  iree_hal_buffer_usage_t buffer_usage;
+  iree_hal_memory_access_t allowed_access;
+  iree_hal_queue_affinity_t queue_affinity;
+  // Retained wrapper buffer; NULL indicates an empty slot.
+  iree_hal_buffer_t* buffer;
+} iree_hal_module_import_cache_entry_t;
+
 typedef struct iree_hal_module_state_t {
   iree_allocator_t host_allocator;
 
@@ -71,6 +98,13 @@ typedef struct iree_hal_module_state_t {
   // instead be taking a loop upon creation and scheduling work against that.
   iree_status_t loop_status;
 
+  // Cache of recently imported external buffers; see allocator.import.
+  struct {
+    iree_host_size_t next_slot;  // round-robin eviction cursor
+    iree_hal_module_import_cache_entry_t
+        entries[IREE_HAL_MODULE_IMPORT_CACHE_CAPACITY];
+  } import_cache;
+
   // Shared executable cache for each device used to cache all executables
   // created in the context. We could have multiple to allow for modules to
   // create distinct sets of executables like ones for training vs inference in
@@ -123,6 +157,9 @@ iree_hal_module_free_state(void* self, iree_vm_module_state_t* module_state) {
   IREE_TRACE_ZONE_BEGIN(z0);
 
   iree_hal_module_state_t* state = (iree_hal_module_state_t*)module_state;
+  for (iree_host_size_t i = 0; i < IREE_HAL_MODULE_IMPORT_CACHE_CAPACITY; ++i) {
+    iree_hal_buffer_release(state->import_cache.entries[i].buffer);
+  }
   for (iree_host_size_t i = 0; i < state->device_count; ++i) {
     iree_hal_executable_cache_release(state->executable_caches[i]);
   }
@@ -345,6 +382,25 @@ IREE_VM_ABI_EXPORT(iree_hal_module_allocator_import,  //
     }
   }
 
+  // Probe the import cache: re-importing the same host span with the same
+  // parameters reuses the existing wrapper buffer instead of allocating and
+  // validating a new one. The cached wrapper retains the source vm buffer so
+  // the span cannot be recycled while the entry lives.
+  void* import_ptr = source->data.data + offset;
+  for (iree_host_size_t i = 0; i < IREE_HAL_MODULE_IMPORT_CACHE_CAPACITY; ++i) {
+    iree_hal_module_import_cache_entry_t* entry =
+        &state->import_cache.entries[i];
+    if (entry->buffer && entry->allocator == allocator &&
+        entry->ptr == import_ptr && entry->length == length &&
+        entry->memory_types == memory_types &&
+        entry->buffer_usage == buffer_usage &&
+        entry->allowed_access == allowed_access &&
+        entry->queue_affinity == queue_affinity) {
+      rets->r0 = iree_hal_buffer_retain_ref(entry->buffer);
+      return iree_ok_status();
+    }
+  }
+
   // Try mapping - note that this may fail if the target device cannot map the
   // memory into the given type (for example, mapping a host buffer into
   // device-local memory is only going to work on unified memory systems).
@@ -371,6 +427,23 @@ IREE_VM_ABI_EXPORT(iree_hal_module_allocator_import,  //
     // Import succeeded - retain the source buffer that'll be released by
     // iree_hal_module_map_data_ctl when the mapping is no longer used.
     iree_vm_buffer_retain(source);
+
+    // Insert into the import cache, evicting the oldest entry round-robin.
+    iree_hal_module_import_cache_entry_t* entry =
+        &state->import_cache.entries[state->import_cache.next_slot];
+    state->import_cache.next_slot = (state->import_cache.next_slot + 1) %
+                                    IREE_HAL_MODULE_IMPORT_CACHE_CAPACITY;
+    iree_hal_buffer_release(entry->buffer);
+    entry->allocator = allocator;
+    entry->ptr = import_ptr;
+    entry->length = length;
+    entry->memory_types = memory_types;
+    entry->buffer_usage = buffer_usage;
+    entry->allowed_access = allowed_access;
+    entry->queue_affinity = queue_affinity;
+    entry->buffer = buffer;
+    iree_hal_buffer_retain(buffer);
+
     rets->r0 = iree_hal_buffer_move_ref(buffer);
     return iree_ok_status();
   }
@@ -0,0 +1,400 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/modules/io/capsule/module.h"
+
+#include "iree/base/internal/atomics.h"
+#include "iree/base/internal/synchronization.h"
+#include "iree/hal/api.h"
+#include "iree/modules/hal/types.h"
+
+#define IREE_IO_CAPSULE_MODULE_VERSION_0_0 0x00000000u
+#define IREE_IO_CAPSULE_MODULE_VERSION_LATEST \
+  IREE_IO_CAPSULE_MODULE_VERSION_0_0
+
+//===----------------------------------------------------------------------===//
+// iree_io_capsule_registry_t
+//===----------------------------------------------------------------------===//
+
+// A registered capsule. Entries are heap-allocated with the key embedded and
+// transfer out of the registry when claimed: the entry then serves as the
+// release callback context of the wrapping buffer so the deleter can run when
+// the buffer is released.
+typedef struct iree_io_capsule_entry_t {
+  struct iree_io_capsule_entry_t* next;
+  iree_allocator_t host_allocator;
+  iree_io_capsule_type_t type;
+  void* ptr;
+  iree_device_size_t length;
+  iree_io_capsule_deleter_t deleter;
+  iree_string_view_t key;  // points into the trailing embedded storage
+} iree_io_capsule_entry_t;
+
+struct iree_io_capsule_registry_t {
+  iree_atomic_ref_count_t ref_count;
+  iree_allocator_t host_allocator;
+  iree_slim_mutex_t mutex;
+  iree_io_capsule_entry_t* head IREE_GUARDED_BY(mutex);
+};
+
+// Invokes the capsule deleter (if any) and frees the entry.
+static void iree_io_capsule_entry_destroy(iree_io_capsule_entry_t* entry) {
+  if (entry->deleter.fn) {
+    entry->deleter.fn(entry->deleter.user_data, entry->ptr);
+  }
+  iree_allocator_free(entry->host_allocator, entry);
+}
+
+IREE_API_EXPORT iree_status_t iree_io_capsule_registry_create(
+    iree_allocator_t host_allocator,
+    iree_io_capsule_registry_t** out_registry) {
+  IREE_ASSERT_ARGUMENT(out_registry);
+  *out_registry = NULL;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_io_capsule_registry_t* registry = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(host_allocator, sizeof(*registry),
+                                (void**)&registry));
+  iree_atomic_ref_count_init(&registry->ref_count);
+  registry->host_allocator = host_allocator;
+  iree_slim_mutex_initialize(&registry->mutex);
+  registry->head = NULL;
+
+  *out_registry = registry;
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
+static void iree_io_capsule_registry_destroy(
+    iree_io_capsule_registry_t* registry) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+  iree_allocator_t host_allocator = registry->host_allocator;
+
+  // Run deleters for anything the program never claimed so external memory is
+  // not leaked on teardown.
+  iree_io_capsule_entry_t* entry = registry->head;
+  while (entry) {
+    iree_io_capsule_entry_t* next = entry->next;
+    iree_io_capsule_entry_destroy(entry);
+    entry = next;
+  }
+
+  iree_slim_mutex_deinitialize(&registry->mutex);
+  iree_allocator_free(host_allocator, registry);
+  IREE_TRACE_ZONE_END(z0);
+}
+
+IREE_API_EXPORT void iree_io_capsule_registry_retain(
+    iree_io_capsule_registry_t* registry) {
+  if (IREE_LIKELY(registry)) {
+    iree_atomic_ref_count_inc(&registry->ref_count);
+  }
+}
+
+IREE_API_EXPORT void iree_io_capsule_registry_release(
+    iree_io_capsule_registry_t* registry) {
+  if (IREE_LIKELY(registry) &&
+      iree_atomic_ref_count_dec(&registry->ref_count) == 1) {
+    iree_io_capsule_registry_destroy(registry);
+  }
+}
+
+IREE_API_EXPORT iree_status_t iree_io_capsule_registry_insert(
+    iree_io_capsule_registry_t* registry, iree_string_view_t key,
+    iree_io_capsule_type_t type, void* ptr, iree_device_size_t length,
+    iree_io_capsule_deleter_t deleter) {
+  IREE_ASSERT_ARGUMENT(registry);
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_io_capsule_entry_t* entry = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(registry->host_allocator,
+                                sizeof(*entry) + key.size, (void**)&entry));
+  entry->host_allocator = registry->host_allocator;
+  entry->type = type;
+  entry->ptr = ptr;
+  entry->length = length;
+  entry->deleter = deleter;
+  char* key_storage = (char*)entry + sizeof(*entry);
+  memcpy(key_storage, key.data, key.size);
+  entry->key = iree_make_string_view(key_storage, key.size);
+
+  iree_status_t status = iree_ok_status();
+  iree_slim_mutex_lock(&registry->mutex);
+  for (iree_io_capsule_entry_t* existing = registry->head; existing;
+       existing = existing->next) {
+    if (iree_string_view_equal(existing->key, key)) {
+      status = iree_make_status(IREE_STATUS_ALREADY_EXISTS,
+                                "a capsule with key '%.*s' is already "
+                                "registered and has not been claimed",
+                                (int)key.size, key.data);
+      break;
+    }
+  }
+  if (iree_status_is_ok(status)) {
+    entry->next = registry->head;
+    registry->head = entry;
+  }
+  iree_slim_mutex_unlock(&registry->mutex);
+
+  if (!iree_status_is_ok(status)) {
+    // NOTE: the deleter is not run; the caller retains ownership on failure.
+    iree_allocator_free(registry->host_allocator, entry);
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+// Removes and returns the capsule registered under |key|, transferring
+// ownership to the caller.
+static iree_status_t iree_io_capsule_registry_claim(
+    iree_io_capsule_registry_t* registry, iree_string_view_t key,
+    iree_io_capsule_entry_t** out_entry) {
+  *out_entry = NULL;
+  iree_slim_mutex_lock(&registry->mutex);
+  iree_io_capsule_entry_t** link = &registry->head;
+  for (iree_io_capsule_entry_t* entry = registry->head; entry;
+       link = &entry->next, entry = entry->next) {
+    if (iree_string_view_equal(entry->key, key)) {
+      *link = entry->next;
+      entry->next = NULL;
+      *out_entry = entry;
+      break;
+    }
+  }
+  iree_slim_mutex_unlock(&registry->mutex);
+  if (!*out_entry) {
+    return iree_make_status(
+        IREE_STATUS_NOT_FOUND,
+        "no capsule registered with key '%.*s' (keys are single-use and may "
+        "have already been claimed)",
+        (int)key.size, key.data);
+  }
+  return iree_ok_status();
+}
+
+// Returns a claimed capsule to the registry (used when an import fails so the
+// external memory is neither leaked nor spuriously deleted).
+static void iree_io_capsule_registry_restore(
+    iree_io_capsule_registry_t* registry, iree_io_capsule_entry_t* entry) {
+  iree_slim_mutex_lock(&registry->mutex);
+  entry->next = registry->head;
+  registry->head = entry;
+  iree_slim_mutex_unlock(&registry->mutex);
+}
+
+// Release callback attached to wrapping buffers; runs the capsule deleter.
+static void iree_io_capsule_buffer_release(void* user_data,
+                                           iree_hal_buffer_t* buffer) {
+  iree_io_capsule_entry_destroy((iree_io_capsule_entry_t*)user_data);
+}
+
+//===----------------------------------------------------------------------===//
+// Module type definitions
+//===----------------------------------------------------------------------===//
+
+typedef struct iree_io_capsule_module_t {
+  iree_allocator_t host_allocator;
+  iree_io_capsule_registry_t* registry;
+} iree_io_capsule_module_t;
+
+#define IREE_IO_CAPSULE_MODULE_CAST(module) \
+  (iree_io_capsule_module_t*)((uint8_t*)(module) + iree_vm_native_module_size())
+
+typedef struct iree_io_capsule_module_state_t {
+  iree_allocator_t host_allocator;
+} iree_io_capsule_module_state_t;
+
+static void IREE_API_PTR iree_io_capsule_module_destroy(void* base_module) {
+  iree_io_capsule_module_t* module = IREE_IO_CAPSULE_MODULE_CAST(base_module);
+  iree_io_capsule_registry_release(module->registry);
+  module->registry = NULL;
+}
+
+static iree_status_t IREE_API_PTR iree_io_capsule_module_alloc_state(
+    void* self, iree_allocator_t host_allocator,
+    iree_vm_module_state_t** out_module_state) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_io_capsule_module_state_t* state = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0,
+      iree_allocator_malloc(host_allocator, sizeof(*state), (void**)&state));
+  memset(state, 0, sizeof(*state));
+  state->host_allocator = host_allocator;
+
+  *out_module_state = (iree_vm_module_state_t*)state;
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
+static void IREE_API_PTR iree_io_capsule_module_free_state(
+    void* self, iree_vm_module_state_t* module_state) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_io_capsule_module_state_t* state =
+      (iree_io_capsule_module_state_t*)module_state;
+  iree_allocator_free(state->host_allocator, state);
+
+  IREE_TRACE_ZONE_END(z0);
+}
+
+//===----------------------------------------------------------------------===//
+// Exported functions
+//===----------------------------------------------------------------------===//
+
+IREE_VM_ABI_EXPORT(iree_io_capsule_module_wrap,     //
+                   iree_io_capsule_module_state_t,  //
+                   rrii, r) {
+  iree_hal_device_t* device = NULL;
+  IREE_RETURN_IF_ERROR(iree_hal_device_check_deref(args->r0, &device));
+  iree_vm_buffer_t* key = NULL;
+  IREE_RETURN_IF_ERROR(iree_vm_buffer_check_deref(args->r1, &key));
+  iree_hal_memory_type_t memory_types = (iree_hal_memory_type_t)args->i2;
+  iree_hal_buffer_usage_t buffer_usage = (iree_hal_buffer_usage_t)args->i3;
+
+  iree_io_capsule_module_t* shared_state = IREE_IO_CAPSULE_MODULE_CAST(module);
+  iree_io_capsule_entry_t* entry = NULL;
+  IREE_RETURN_IF_ERROR(iree_io_capsule_registry_claim(
+      shared_state->registry, iree_vm_buffer_as_string(key), &entry));
+
+  iree_hal_external_buffer_t external_buffer = {
+      .flags = IREE_HAL_EXTERNAL_BUFFER_FLAG_NONE,
+      .size = entry->length,
+  };
+  switch (entry->type) {
+    case IREE_IO_CAPSULE_TYPE_HOST_POINTER:
+      external_buffer.type = IREE_HAL_EXTERNAL_BUFFER_TYPE_HOST_ALLOCATION;
+      external_buffer.handle.host_allocation.ptr = entry->ptr;
+      break;
+    case IREE_IO_CAPSULE_TYPE_DEVICE_POINTER:
+      external_buffer.type = IREE_HAL_EXTERNAL_BUFFER_TYPE_DEVICE_ALLOCATION;
+      external_buffer.handle.device_allocation.ptr = (uint64_t)entry->ptr;
+      break;
+  }
+  const iree_hal_buffer_params_t params = {
+      .type = memory_types,
+      .usage = buffer_usage,
+      .access = IREE_HAL_MEMORY_ACCESS_ALL,
+  };
+  const iree_hal_buffer_release_callback_t release_callback = {
+      .fn = iree_io_capsule_buffer_release,
+      .user_data = entry,
+  };
+
+  // NOTE: no-copy import only; if the device allocator cannot use the memory
+  // in-place we fail instead of silently staging so that callers relying on
+  // pointer passing notice. On failure the capsule returns to the registry
+  // with the caller retaining ownership of the memory.
+  iree_hal_buffer_t* buffer = NULL;
+  iree_status_t status =
+      iree_hal_allocator_import_buffer(iree_hal_device_allocator(device),
+                                       params, &external_buffer,
+                                       release_callback, &buffer);
+  if (iree_status_is_ok(status)) {
+    rets->r0 = iree_hal_buffer_move_ref(buffer);
+  } else {
+    iree_io_capsule_registry_restore(shared_state->registry, entry);
+  }
+  return status;
+}
+
+//===----------------------------------------------------------------------===//
+// VM module interface implementation
+//===----------------------------------------------------------------------===//
+
+// NOTE: this must match the ordering of the iree_io_capsule_module_exports_
+// table.
+static const iree_vm_native_function_ptr_t iree_io_capsule_module_funcs_[] = {
+#define EXPORT_FN(name, target_fn, arg_types, ret_types)       \
+  {                                                            \
+      .shim = (iree_vm_native_function_shim_t)                 \
+          iree_vm_shim_##arg_types##_##ret_types,              \
+      .target = (iree_vm_native_function_target_t)(target_fn), \
+  },
+#include "iree/modules/io/capsule/exports.inl"  // IWYU pragma: keep
+#undef EXPORT_FN
+};
+
+// NOTE: 0 length, but can't express that in C.
+static const iree_vm_native_import_descriptor_t
+    iree_io_capsule_module_imports_[1];
+
+static const iree_vm_native_export_descriptor_t
+    iree_io_capsule_module_exports_[] = {
+#define EXPORT_FN(name, target_fn, arg_types, ret_types)           \
+  {                                                                \
+      .local_name = iree_string_view_literal(name),                \
+      .calling_convention =                                        \
+          iree_string_view_literal("0" #arg_types "_" #ret_types), \
+      .attr_count = 0,                                             \
+      .attrs = NULL,                                               \
+  },
+#include "iree/modules/io/capsule/exports.inl"  // IWYU pragma: keep
+#undef EXPORT_FN
+};
+static_assert(IREE_ARRAYSIZE(iree_io_capsule_module_funcs_) ==
+                  IREE_ARRAYSIZE(iree_io_capsule_module_exports_),
+              "function pointer table must be 1:1 with exports");
+
+static const iree_vm_native_module_descriptor_t
+    iree_io_capsule_module_descriptor_ = {
+        .name = iree_string_view_literal("io_capsule"),
+        .version = IREE_IO_CAPSULE_MODULE_VERSION_LATEST,
+        .attr_count = 0,
+        .attrs = NULL,
+        .dependency_count = 0,
+        .dependencies = NULL,
+        .import_count = 0,  // workaround for 0-length C struct
+        .imports = iree_io_capsule_module_imports_,
+        .export_count = IREE_ARRAYSIZE(iree_io_capsule_module_exports_),
+        .exports = iree_io_capsule_module_exports_,
+        .function_count = IREE_ARRAYSIZE(iree_io_capsule_module_funcs_),
+        .functions = iree_io_capsule_module_funcs_,
+        // All exports complete synchronously without re-entering the VM.
+        .flags = IREE_VM_NATIVE_MODULE_FLAG_LEAF,
+};
+
+IREE_API_EXPORT iree_status_t iree_io_capsule_module_create(
+    iree_vm_instance_t* instance, iree_io_capsule_registry_t* registry,
+    iree_allocator_t host_allocator, iree_vm_module_t** out_module) {
+  IREE_ASSERT_ARGUMENT(instance);
+  IREE_ASSERT_ARGUMENT(registry);
+  IREE_ASSERT_ARGUMENT(out_module);
+  *out_module = NULL;
+
+  // Setup the interface with the functions we implement ourselves. Any function
+  // we omit will be handled by the base native module.
+  static const iree_vm_module_t interface = {
+      .destroy = iree_io_capsule_module_destroy,
+      .alloc_state = iree_io_capsule_module_alloc_state,
+      .free_state = iree_io_capsule_module_free_state,
+  };
+
+  // Allocate shared module state.
+  iree_host_size_t total_size =
+      iree_vm_native_module_size() + sizeof(iree_io_capsule_module_t);
+  iree_vm_module_t* base_module = NULL;
+  IREE_RETURN_IF_ERROR(
+      iree_allocator_malloc(host_allocator, total_size, (void**)&base_module));
+  memset(base_module, 0, total_size);
+  iree_status_t status = iree_vm_native_module_initialize(
+      &interface, &iree_io_capsule_module_descriptor_, instance, host_allocator,
+      base_module);
+  if (!iree_status_is_ok(status)) {
+    iree_allocator_free(host_allocator, base_module);
+    return status;
+  }
+
+  iree_io_capsule_module_t* module = IREE_IO_CAPSULE_MODULE_CAST(base_module);
+  module->host_allocator = host_allocator;
+  module->registry = registry;
+  iree_io_capsule_registry_retain(registry);
+
+  *out_module = base_module;
+  return iree_ok_status();
+}
@@ -0,0 +1,91 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+// io_capsule module
+//===----------------------------------------------------------------------===//
+// Zero-copy import of externally-owned memory ("capsules") into programs.
+// Embedders register pointers - host allocations such as arrow buffers or
+// device pointers - under string keys along with a deleter callback that
+// assumes lifetime management, dlpack-style. Compiled programs then claim a
+// capsule by key and receive a !hal.buffer wrapping the memory directly via
+// iree_hal_allocator_import_buffer with no staging copies; the deleter runs
+// when the last reference to the wrapping buffer is released.
+
+#ifndef IREE_MODULES_IO_CAPSULE_MODULE_H_
+#define IREE_MODULES_IO_CAPSULE_MODULE_H_
+
+#include "iree/base/api.h"
+#include "iree/vm/api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+typedef void(IREE_API_PTR* iree_io_capsule_deleter_fn_t)(void* user_data,
+                                                         void* ptr);
+
+// A deleter invoked exactly once when the memory referenced by a capsule is
+// no longer needed: either when the wrapping buffer is released or when the
+// registry is destroyed with the capsule still unclaimed.
+typedef struct iree_io_capsule_deleter_t {
+  // Callback function pointer; may be NULL for unowned memory whose lifetime
+  // is managed externally (the caller must then outlive all wrapping buffers).
+  iree_io_capsule_deleter_fn_t fn;
+  // User data passed to the callback function. Unowned.
+  void* user_data;
+} iree_io_capsule_deleter_t;
+
+// Kind of pointer a capsule references.
+typedef enum iree_io_capsule_type_e {
+  // Host memory pointer; imported as
+  // IREE_HAL_EXTERNAL_BUFFER_TYPE_HOST_ALLOCATION.
+  IREE_IO_CAPSULE_TYPE_HOST_POINTER = 0,
+  // Device memory pointer valid on the device the program wraps it with;
+  // imported as IREE_HAL_EXTERNAL_BUFFER_TYPE_DEVICE_ALLOCATION.
+  IREE_IO_CAPSULE_TYPE_DEVICE_POINTER = 1,
+} iree_io_capsule_type_t;
+
+// A thread-safe key-value registry of capsules shared between the embedder
+// (producing external memory) and the io_capsule module (consuming it).
+typedef struct iree_io_capsule_registry_t iree_io_capsule_registry_t;
+
+// Creates an empty capsule registry.
+IREE_API_EXPORT iree_status_t iree_io_capsule_registry_create(
+    iree_allocator_t host_allocator,
+    iree_io_capsule_registry_t** out_registry);
+
+// Retains the given |registry| for the caller.
+IREE_API_EXPORT void iree_io_capsule_registry_retain(
+    iree_io_capsule_registry_t* registry);
+
+// Releases the given |registry| from the caller.
+// Deleters of any still-unclaimed capsules are invoked.
+IREE_API_EXPORT void iree_io_capsule_registry_release(
+    iree_io_capsule_registry_t* registry);
+
+// Registers the externally-owned memory [|ptr|, |ptr|+|length|) under |key|.
+// Ownership transfers to the registry: the |deleter| is invoked when the
+// capsule is claimed and its wrapping buffer released or when the registry is
+// destroyed with the capsule unclaimed. Fails if |key| is already registered.
+IREE_API_EXPORT iree_status_t iree_io_capsule_registry_insert(
+    iree_io_capsule_registry_t* registry, iree_string_view_t key,
+    iree_io_capsule_type_t type, void* ptr, iree_device_size_t length,
+    iree_io_capsule_deleter_t deleter);
+
+// Creates the io_capsule module claiming capsules from |registry|.
+// The registry is retained for the lifetime of the module and may be shared
+// with other modules or contexts; each capsule can only be claimed once.
+IREE_API_EXPORT iree_status_t iree_io_capsule_module_create(
+    iree_vm_instance_t* instance, iree_io_capsule_registry_t* registry,
+    iree_allocator_t host_allocator,
+    iree_vm_module_t** IREE_RESTRICT out_module);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // IREE_MODULES_IO_CAPSULE_MODULE_H_
@@ -41,6 +41,8 @@ EXPORT_FN("fill.2d.x32", iree_vmvx_fill2d_x32, fill2d_x32, irIIII, v)
 EXPORT_FN("floor.2d.f32", iree_uk_x32u_floorf_2d, ukernel_x32u_2d, rIIIrIIIII, v)
 EXPORT_FN("log.2d.f32", iree_uk_x32u_logf_2d, ukernel_x32u_2d, rIIIrIIIII, v)
 EXPORT_FN("mmt4d", iree_vmvx_mmt4d, mmt4d, rIIrIIrIIIIIiiii, v)
+EXPORT_FN("mmt4d.call", iree_vmvx_mmt4d_call, mmt4d_call, rrIrIrI, v)
+EXPORT_FN("mmt4d.resolve", iree_vmvx_mmt4d_resolve, mmt4d_resolve, r, r)
 EXPORT_FN("mul.2d.f32", iree_uk_x32b_mulf_2d, ukernel_x32b_2d, rIIIrIIIrIIIII, v)
 EXPORT_FN("mul.2d.i32", iree_uk_x32b_muli_2d, ukernel_x32b_2d, rIIIrIIIrIIIII, v)
 EXPORT_FN("neg.2d.f32", iree_uk_x32u_negf_2d, ukernel_x32u_2d, rIIIrIIIII, v)
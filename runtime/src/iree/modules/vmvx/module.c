@@ -584,6 +584,230 @@ IREE_VMVX_ABI_EXPORT(iree_vmvx_mmt4d, mmt4d, v) {
   return iree_ok_status();
 }
 
+//===----------------------------------------------------------------------===//
+// Resolved mmt4d call descriptors
+//===----------------------------------------------------------------------===//
+// Repeated calls into the same mmt4d call site pay the full argument
+// unmarshaling cost (register decode, stride casts, overflow checks) per tile
+// even though everything but the buffer bindings is loop-invariant. The
+// compiler can instead emit the invariant portion once as a packed rodata
+// configuration, resolve it into an opaque descriptor buffer at initialization
+// time via mmt4d.resolve, and then issue mmt4d.call per tile with only the
+// descriptor and the per-call buffer bindings: one checked deref + map per
+// buffer and a direct ukernel call with precomputed strides/length bounds.
+
+// Packed call-site configuration emitted by the compiler as rodata.
+// All validation happens at resolve time; layout changes require a new magic.
+typedef struct iree_vmvx_mmt4d_config_t {
+  uint32_t magic;  // IREE_VMVX_MMT4D_CONFIG_MAGIC
+  uint32_t flags;
+  int64_t lhs_row_stride;
+  int64_t rhs_row_stride;
+  int64_t out_row_stride;
+  int64_t m;
+  int64_t n;
+  int64_t k;
+  int32_t m0;
+  int32_t n0;
+  int32_t k0;
+  uint32_t reserved;
+} iree_vmvx_mmt4d_config_t;
+#define IREE_VMVX_MMT4D_CONFIG_MAGIC 0x434D5844u  // 'DXMC'
+
+// Resolved descriptor produced by mmt4d.resolve and stored in a host-local
+// vm.buffer owned by the program. Contents are host-endian/host-sized and
+// never serialized; programs must treat the buffer as opaque.
+typedef struct iree_vmvx_mmt4d_descriptor_t {
+  uint32_t magic;  // IREE_VMVX_MMT4D_DESCRIPTOR_MAGIC
+  uint32_t flags;
+  int32_t in_elem_size;
+  int32_t out_elem_size;
+  iree_host_size_t lhs_stride0;
+  iree_host_size_t rhs_stride0;
+  iree_host_size_t out_stride0;
+  iree_host_size_t m;
+  iree_host_size_t n;
+  iree_host_size_t k;
+  iree_host_size_t m0;
+  iree_host_size_t n0;
+  iree_host_size_t k0;
+  // Precomputed mappable byte lengths from offset 0 of each binding.
+  iree_host_size_t lhs_length_bound;
+  iree_host_size_t rhs_length_bound;
+  iree_host_size_t out_length_bound;
+} iree_vmvx_mmt4d_descriptor_t;
+#define IREE_VMVX_MMT4D_DESCRIPTOR_MAGIC 0x52585844u  // 'DXXR'
+
+IREE_VMVX_ABI_FIXED_STRUCT(mmt4d_resolve, r, {
+  iree_vm_ref_t config_ref;
+});
+IREE_VMVX_ABI_DEFINE_SHIM(mmt4d_resolve, r);
+
+IREE_VMVX_ABI_EXPORT(iree_vmvx_mmt4d_resolve, mmt4d_resolve, r) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_vm_buffer_t* config_buffer = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_buffer_check_deref(args->config_ref, &config_buffer));
+  iree_const_byte_span_t config_span;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_buffer_map_ro(config_buffer, 0,
+                                sizeof(iree_vmvx_mmt4d_config_t),
+                                sizeof(uint64_t), &config_span));
+  const iree_vmvx_mmt4d_config_t* config =
+      (const iree_vmvx_mmt4d_config_t*)config_span.data;
+  if (config->magic != IREE_VMVX_MMT4D_CONFIG_MAGIC) {
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "bad mmt4d config magic %08X", config->magic);
+  }
+
+  int in_elem_size = 0;
+  int out_elem_size = 0;
+  switch (config->flags & IREE_UK_FLAG_MMT4D_TYPE_MASK) {
+    case IREE_UK_FLAG_MMT4D_TYPE_F32F32F32:
+      in_elem_size = 4;
+      out_elem_size = 4;
+      break;
+    case IREE_UK_FLAG_MMT4D_TYPE_S8S8S32:
+      in_elem_size = 1;
+      out_elem_size = 4;
+      break;
+    default:
+      IREE_TRACE_ZONE_END(z0);
+      return iree_make_status(IREE_STATUS_INVALID_ARGUMENT, "unhandled flags");
+  }
+
+  // All of the overflow checking normally repeated per call happens here once.
+  uint64_t overflow = 0;
+  iree_vmvx_mmt4d_descriptor_t desc;
+  memset(&desc, 0, sizeof(desc));
+  desc.magic = IREE_VMVX_MMT4D_DESCRIPTOR_MAGIC;
+  desc.flags = config->flags;
+  desc.in_elem_size = in_elem_size;
+  desc.out_elem_size = out_elem_size;
+  desc.lhs_stride0 = iree_vmvx_cast_host_size(config->lhs_row_stride, &overflow);
+  desc.rhs_stride0 = iree_vmvx_cast_host_size(config->rhs_row_stride, &overflow);
+  desc.out_stride0 = iree_vmvx_cast_host_size(config->out_row_stride, &overflow);
+  desc.m = iree_vmvx_cast_host_size(config->m, &overflow);
+  desc.n = iree_vmvx_cast_host_size(config->n, &overflow);
+  desc.k = iree_vmvx_cast_host_size(config->k, &overflow);
+  desc.m0 = iree_vmvx_cast_host_size(config->m0, &overflow);
+  desc.n0 = iree_vmvx_cast_host_size(config->n0, &overflow);
+  desc.k0 = iree_vmvx_cast_host_size(config->k0, &overflow);
+  // Same coalescing as iree_vmvx_mmt4d: inner 3 dims are contiguous row-major
+  // so each binding maps as 2D with only the outer stride nontrivial.
+  desc.lhs_length_bound = iree_vmvx_2d_length_bound(
+      in_elem_size, desc.m, desc.k * desc.m0 * desc.k0, desc.lhs_stride0, 1,
+      &overflow);
+  desc.rhs_length_bound = iree_vmvx_2d_length_bound(
+      in_elem_size, desc.n, desc.k * desc.n0 * desc.k0, desc.rhs_stride0, 1,
+      &overflow);
+  desc.out_length_bound = iree_vmvx_2d_length_bound(
+      out_elem_size, desc.m, desc.n * desc.m0 * desc.n0, desc.out_stride0, 1,
+      &overflow);
+  if (overflow) {
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "mmt4d config size/stride overflow");
+  }
+
+  iree_vm_buffer_t* descriptor_buffer = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_buffer_create(
+              IREE_VM_BUFFER_ACCESS_MUTABLE | IREE_VM_BUFFER_ACCESS_ORIGIN_HOST,
+              sizeof(desc), iree_max_align_t, state->host_allocator,
+              &descriptor_buffer));
+  iree_byte_span_t descriptor_span;
+  iree_status_t status = iree_vm_buffer_map_rw(
+      descriptor_buffer, 0, sizeof(desc), sizeof(uint64_t), &descriptor_span);
+  if (iree_status_is_ok(status)) {
+    memcpy(descriptor_span.data, &desc, sizeof(desc));
+    rets->r0 = iree_vm_buffer_move_ref(descriptor_buffer);
+  } else {
+    iree_vm_buffer_release(descriptor_buffer);
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+IREE_VMVX_ABI_FIXED_STRUCT(mmt4d_call, rrIrIrI, {
+  iree_vm_ref_t descriptor_ref;
+  iree_vm_ref_t lhs_ref;
+  int64_t lhs_offset;
+  iree_vm_ref_t rhs_ref;
+  int64_t rhs_offset;
+  iree_vm_ref_t out_ref;
+  int64_t out_offset;
+});
+IREE_VMVX_ABI_DEFINE_SHIM(mmt4d_call, v);
+
+IREE_VMVX_ABI_EXPORT(iree_vmvx_mmt4d_call, mmt4d_call, v) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_vm_buffer_t* descriptor_buffer = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_buffer_check_deref(args->descriptor_ref, &descriptor_buffer));
+  iree_const_byte_span_t descriptor_span;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_buffer_map_ro(descriptor_buffer, 0,
+                                sizeof(iree_vmvx_mmt4d_descriptor_t),
+                                sizeof(uint64_t), &descriptor_span));
+  const iree_vmvx_mmt4d_descriptor_t* desc =
+      (const iree_vmvx_mmt4d_descriptor_t*)descriptor_span.data;
+  if (IREE_UNLIKELY(desc->magic != IREE_VMVX_MMT4D_DESCRIPTOR_MAGIC)) {
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "buffer is not a resolved mmt4d descriptor");
+  }
+
+  // Only the per-call element offsets need validation; strides/sizes/length
+  // bounds were checked at resolve time.
+  uint64_t overflow = 0;
+  iree_host_size_t lhs_offset =
+      desc->in_elem_size * iree_vmvx_cast_host_size(args->lhs_offset, &overflow);
+  iree_host_size_t rhs_offset =
+      desc->in_elem_size * iree_vmvx_cast_host_size(args->rhs_offset, &overflow);
+  iree_host_size_t out_offset = desc->out_elem_size * iree_vmvx_cast_host_size(
+                                                          args->out_offset,
+                                                          &overflow);
+  if (IREE_UNLIKELY(overflow)) {
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "mmt4d call offset overflow");
+  }
+
+  iree_vm_buffer_t* lhs_buffer = NULL;
+  iree_vm_buffer_t* rhs_buffer = NULL;
+  iree_vm_buffer_t* out_buffer = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_buffer_check_deref(args->lhs_ref, &lhs_buffer));
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_buffer_check_deref(args->rhs_ref, &rhs_buffer));
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_buffer_check_deref(args->out_ref, &out_buffer));
+  iree_const_byte_span_t lhs_span;
+  iree_const_byte_span_t rhs_span;
+  iree_byte_span_t out_span;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_buffer_map_ro(lhs_buffer, lhs_offset, desc->lhs_length_bound,
+                                desc->in_elem_size, &lhs_span));
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_buffer_map_ro(rhs_buffer, rhs_offset, desc->rhs_length_bound,
+                                desc->in_elem_size, &rhs_span));
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_buffer_map_rw(out_buffer, out_offset, desc->out_length_bound,
+                                desc->out_elem_size, &out_span));
+
+  iree_uk_mmt4d(lhs_span.data, 0, desc->lhs_stride0, rhs_span.data, 0,
+                desc->rhs_stride0, out_span.data, 0, desc->out_stride0, desc->m,
+                desc->n, desc->k, desc->m0, desc->n0, desc->k0, desc->flags,
+                (const iree_uk_uint64_t*)iree_cpu_data_fields());
+
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
 //===----------------------------------------------------------------------===//
 // Exported pack function definitions
 //===----------------------------------------------------------------------===//
@@ -762,11 +986,18 @@ static_assert(IREE_ARRAYSIZE(iree_vmvx_module_funcs_) ==
                   IREE_ARRAYSIZE(iree_vmvx_module_exports_),
               "function pointer table must be 1:1 with exports");
 
+// Module state holds no mutable per-invocation data (invocations may already
+// run concurrently against one state) so forked contexts can alias it.
+static const iree_string_pair_t iree_vmvx_module_attrs_[] = {
+    {{iree_string_view_literal("vm.state.model")},
+     {iree_string_view_literal("shared")}},
+};
+
 static const iree_vm_native_module_descriptor_t iree_vmvx_module_descriptor_ = {
     .name = iree_string_view_literal("vmvx"),
     .version = IREE_VMVX_MODULE_VERSION_LATEST,
-    .attr_count = 0,
-    .attrs = NULL,
+    .attr_count = IREE_ARRAYSIZE(iree_vmvx_module_attrs_),
+    .attrs = iree_vmvx_module_attrs_,
     .dependency_count = 0,
     .dependencies = NULL,
     .import_count = 0,  // workaround for 0-length C struct
@@ -775,6 +1006,8 @@ static const iree_vm_native_module_descriptor_t iree_vmvx_module_descriptor_ = {
     .exports = iree_vmvx_module_exports_,
     .function_count = IREE_ARRAYSIZE(iree_vmvx_module_funcs_),
     .functions = iree_vmvx_module_funcs_,
+    // All exports are pure kernel launches that never re-enter the VM.
+    .flags = IREE_VM_NATIVE_MODULE_FLAG_LEAF,
 };
 
 IREE_API_EXPORT iree_status_t iree_vmvx_module_create(
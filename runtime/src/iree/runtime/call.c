@@ -98,6 +98,14 @@ IREE_API_EXPORT iree_status_t iree_runtime_call_invoke(
                                    call->outputs);
 }
 
+IREE_API_EXPORT iree_status_t iree_runtime_call_invoke_async(
+    iree_runtime_call_t* call, iree_runtime_call_flags_t flags,
+    iree_hal_fence_t* wait_fence, iree_hal_fence_t** out_signal_fence) {
+  return iree_runtime_session_call_async(call->session, &call->function,
+                                         call->inputs, call->outputs,
+                                         wait_fence, out_signal_fence);
+}
+
 //===----------------------------------------------------------------------===//
 // Helpers for defining call I/O
 //===----------------------------------------------------------------------===//
@@ -123,3 +131,26 @@ IREE_API_EXPORT iree_status_t iree_runtime_call_outputs_pop_front_buffer_view(
   IREE_RETURN_IF_ERROR(iree_vm_list_pop_front_ref_move(call->outputs, &value));
   return iree_hal_buffer_view_check_deref(value, out_buffer_view);
 }
+
+// Pushes a bare buffer to the call inputs list for raw ABI functions.
+IREE_API_EXPORT iree_status_t iree_runtime_call_inputs_push_back_buffer(
+    iree_runtime_call_t* call, iree_hal_buffer_t* buffer) {
+  IREE_ASSERT_ARGUMENT(call);
+  IREE_ASSERT_ARGUMENT(buffer);
+  iree_vm_ref_t value = {0};
+  IREE_RETURN_IF_ERROR(
+      iree_vm_ref_wrap_assign(buffer, iree_hal_buffer_type(), &value));
+  return iree_vm_list_push_ref_retain(call->inputs, &value);
+}
+
+// Pops a bare buffer from the front of the call outputs list.
+// Ownership of the buffer transfers to the caller.
+IREE_API_EXPORT iree_status_t iree_runtime_call_outputs_pop_front_buffer(
+    iree_runtime_call_t* call, iree_hal_buffer_t** out_buffer) {
+  IREE_ASSERT_ARGUMENT(call);
+  IREE_ASSERT_ARGUMENT(out_buffer);
+  *out_buffer = NULL;
+  iree_vm_ref_t value = {0};
+  IREE_RETURN_IF_ERROR(iree_vm_list_pop_front_ref_move(call->outputs, &value));
+  return iree_hal_buffer_check_deref(value, out_buffer);
+}
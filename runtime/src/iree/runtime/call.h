@@ -73,6 +73,11 @@ IREE_API_EXPORT void iree_runtime_call_deinitialize(iree_runtime_call_t* call);
 
 // Resets the input and output lists back to 0-length in preparation for
 // construction of another call.
+//
+// The lists retain their storage capacity: a call that is initialized once and
+// then cycled through populate inputs -> invoke -> consume outputs -> reset
+// performs no function lookups and no list allocations in steady state, making
+// reuse the preferred pattern for high-frequency invocations.
 IREE_API_EXPORT void iree_runtime_call_reset(iree_runtime_call_t* call);
 
 // Returns an initially-empty variant list for passing in function inputs.
@@ -92,6 +97,24 @@ IREE_API_EXPORT iree_vm_list_t* iree_runtime_call_outputs(
 IREE_API_EXPORT iree_status_t iree_runtime_call_invoke(
     iree_runtime_call_t* call, iree_runtime_call_flags_t flags);
 
+// Asynchronously invokes the call for device-side pipelining.
+//
+// The call function must use the coarse-fences ABI (compiled with the
+// `async-external` execution model) or IREE_STATUS_FAILED_PRECONDITION is
+// returned. Device-side execution begins once the optional |wait_fence| has
+// been signaled and the call returns as soon as the work has been enqueued.
+// |out_signal_fence| is signaled when that work completes and must be waited
+// on before consuming the outputs and released by the caller when no longer
+// needed.
+//
+// Repeated invocations on the same session pipeline in issue order: a single
+// thread can prepare and issue call N+1 while the device executes call N and
+// only wait on the fence of the last call. See
+// iree_runtime_session_call_async for more details.
+IREE_API_EXPORT iree_status_t iree_runtime_call_invoke_async(
+    iree_runtime_call_t* call, iree_runtime_call_flags_t flags,
+    iree_hal_fence_t* wait_fence, iree_hal_fence_t** out_signal_fence);
+
 //===----------------------------------------------------------------------===//
 // Helpers for defining call I/O
 //===----------------------------------------------------------------------===//
@@ -111,6 +134,24 @@ IREE_API_EXPORT iree_status_t iree_runtime_call_inputs_push_back_buffer_view(
 IREE_API_EXPORT iree_status_t iree_runtime_call_outputs_pop_front_buffer_view(
     iree_runtime_call_t* call, iree_hal_buffer_view_t** out_buffer_view);
 
+// Pushes |buffer| to the call inputs list without wrapping it in a view.
+// The value will be retained by the list.
+//
+// Only valid for functions exported with the raw buffer ABI (`iree.abi.raw`)
+// that take bare buffers with no shape/type metadata or validation; use
+// iree_hal_buffer_subspan to pass a range at an offset within a larger
+// buffer.
+IREE_API_EXPORT iree_status_t iree_runtime_call_inputs_push_back_buffer(
+    iree_runtime_call_t* call, iree_hal_buffer_t* buffer);
+
+// Pops a buffer from the front of the call outputs list.
+// Ownership of the buffer transfers to the caller.
+//
+// Only valid for functions exported with the raw buffer ABI (`iree.abi.raw`)
+// that return bare buffers with no shape/type metadata.
+IREE_API_EXPORT iree_status_t iree_runtime_call_outputs_pop_front_buffer(
+    iree_runtime_call_t* call, iree_hal_buffer_t** out_buffer);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
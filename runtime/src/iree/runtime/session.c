@@ -32,6 +32,26 @@ IREE_API_EXPORT void iree_runtime_session_options_initialize(
 // iree_runtime_session_t
 //===----------------------------------------------------------------------===//
 
+// Number of resolved function handles cached per session.
+// Most applications call only a handful of entry points repeatedly and a small
+// direct-mapped cache avoids the per-call module export table scans performed
+// by iree_vm_context_resolve_function. Sized to cover typical usage; lookups
+// beyond the capacity still resolve correctly and rotate through the cache.
+#define IREE_RUNTIME_SESSION_FUNCTION_CACHE_CAPACITY 8
+// Maximum fully-qualified function name length that can be cached.
+// Longer names bypass the cache and resolve each time.
+#define IREE_RUNTIME_SESSION_FUNCTION_CACHE_MAX_NAME_LENGTH 120
+
+// A cached function resolution; name_length == 0 indicates an empty slot.
+// Function handles remain valid for the lifetime of the context and the cache
+// is flushed whenever a module is appended as later modules may shadow the
+// exports of earlier ones.
+typedef struct iree_runtime_session_function_cache_entry_t {
+  iree_host_size_t name_length;
+  char name[IREE_RUNTIME_SESSION_FUNCTION_CACHE_MAX_NAME_LENGTH];
+  iree_vm_function_t function;
+} iree_runtime_session_function_cache_entry_t;
+
 struct iree_runtime_session_t {
   iree_atomic_ref_count_t ref_count;
 
@@ -60,6 +80,14 @@ struct iree_runtime_session_t {
   // lookup. An application directly using the API may never need this, or could
   // perform VM calls into HAL module exports to gain more portability.
   iree_vm_module_state_t* hal_module_state;
+
+  // Recently resolved functions keyed by fully-qualified name.
+  // Thread-compatible as with the rest of the session; no synchronization is
+  // performed as callers must already serialize access to the session.
+  iree_runtime_session_function_cache_entry_t
+      function_cache[IREE_RUNTIME_SESSION_FUNCTION_CACHE_CAPACITY];
+  // Next slot to evict when inserting into a full cache (round-robin).
+  iree_host_size_t function_cache_next_slot;
 };
 
 IREE_API_EXPORT iree_status_t iree_runtime_session_create_with_device(
@@ -117,6 +145,63 @@ IREE_API_EXPORT iree_status_t iree_runtime_session_create_with_device(
   return status;
 }
 
+// Resolves the cached HAL module state within the session's context.
+// The HAL module is registered under the name 'hal' during session creation
+// and shared by reference into forks.
+static iree_status_t iree_runtime_session_resolve_hal_module_state(
+    iree_runtime_session_t* session) {
+  for (iree_host_size_t i = 0;
+       i < iree_vm_context_module_count(session->context); ++i) {
+    iree_vm_module_t* module = iree_vm_context_module_at(session->context, i);
+    if (module && iree_string_view_equal(iree_vm_module_name(module),
+                                         IREE_SV("hal"))) {
+      return iree_vm_context_resolve_module_state(session->context, module,
+                                                  &session->hal_module_state);
+    }
+  }
+  return iree_make_status(IREE_STATUS_NOT_FOUND,
+                          "no HAL module registered in the source session");
+}
+
+IREE_API_EXPORT iree_status_t iree_runtime_session_fork(
+    iree_runtime_session_t* source_session, iree_allocator_t host_allocator,
+    iree_runtime_session_t** out_session) {
+  IREE_ASSERT_ARGUMENT(source_session);
+  IREE_ASSERT_ARGUMENT(out_session);
+  *out_session = NULL;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_runtime_session_t* session = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(host_allocator, sizeof(*session),
+                                (void**)&session));
+  session->host_allocator = host_allocator;
+  iree_atomic_ref_count_init(&session->ref_count);
+
+  session->instance = source_session->instance;
+  iree_runtime_instance_retain(session->instance);
+
+  // Fork the context: loaded modules are shared by reference and only their
+  // mutable per-context state is allocated and initialized.
+  iree_status_t status = iree_vm_context_fork(
+      source_session->context, host_allocator, &session->context);
+
+  // Re-resolve the cached HAL module state against the forked context.
+  // The function cache is deliberately left cold; resolved handles are cheap
+  // to rebuild and the source session may be in use on another thread.
+  if (iree_status_is_ok(status)) {
+    status = iree_runtime_session_resolve_hal_module_state(session);
+  }
+
+  if (iree_status_is_ok(status)) {
+    *out_session = session;
+  } else {
+    iree_runtime_session_release(session);
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
 static void iree_runtime_session_destroy(iree_runtime_session_t* session) {
   IREE_ASSERT_ARGUMENT(session);
   IREE_TRACE_ZONE_BEGIN(z0);
@@ -197,6 +282,11 @@ IREE_API_EXPORT iree_status_t iree_runtime_session_append_module(
       iree_vm_context_register_modules(iree_runtime_session_context(session),
                                        /*module_count=*/1, /*modules=*/&module);
 
+  // Later modules may shadow exports of earlier ones; drop any resolutions
+  // made before this module was registered.
+  memset(session->function_cache, 0, sizeof(session->function_cache));
+  session->function_cache_next_slot = 0;
+
   IREE_TRACE_ZONE_END(z0);
   return status;
 }
@@ -283,9 +373,87 @@ IREE_API_EXPORT iree_status_t iree_runtime_session_lookup_function(
   IREE_ASSERT_ARGUMENT(out_function);
   IREE_TRACE_ZONE_BEGIN(z0);
 
+  // Sessions are thread-compatible and callers must already serialize access;
+  // the cache mutation below is as safe as any other session state change.
+  iree_runtime_session_t* mutable_session = (iree_runtime_session_t*)session;
+
+  // Steady-state fast path: most applications resolve the same few entry
+  // points repeatedly and we can skip the module export table scans.
+  for (iree_host_size_t i = 0;
+       i < IREE_RUNTIME_SESSION_FUNCTION_CACHE_CAPACITY; ++i) {
+    const iree_runtime_session_function_cache_entry_t* entry =
+        &session->function_cache[i];
+    if (!entry->name_length) continue;  // empty slot
+    if (entry->name_length == full_name.size &&
+        memcmp(entry->name, full_name.data, full_name.size) == 0) {
+      *out_function = entry->function;
+      IREE_TRACE_ZONE_END(z0);
+      return iree_ok_status();
+    }
+  }
+
   iree_status_t status = iree_vm_context_resolve_function(
       iree_runtime_session_context(session), full_name, out_function);
 
+  // Insert into the cache for subsequent lookups. Oversized names are rare
+  // enough that they just take the resolution slow path each time.
+  if (iree_status_is_ok(status) &&
+      full_name.size <= IREE_RUNTIME_SESSION_FUNCTION_CACHE_MAX_NAME_LENGTH) {
+    iree_runtime_session_function_cache_entry_t* entry =
+        &mutable_session
+             ->function_cache[mutable_session->function_cache_next_slot];
+    mutable_session->function_cache_next_slot =
+        (mutable_session->function_cache_next_slot + 1) %
+        IREE_RUNTIME_SESSION_FUNCTION_CACHE_CAPACITY;
+    entry->name_length = full_name.size;
+    memcpy(entry->name, full_name.data, full_name.size);
+    entry->function = *out_function;
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+IREE_API_EXPORT iree_status_t iree_runtime_session_warm_up(
+    iree_runtime_session_t* session, iree_hal_fence_t** out_signal_fence) {
+  IREE_ASSERT_ARGUMENT(session);
+  IREE_ASSERT_ARGUMENT(out_signal_fence);
+  *out_signal_fence = NULL;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_hal_device_t* device = iree_runtime_session_device(session);
+  if (!device) {
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(IREE_STATUS_FAILED_PRECONDITION,
+                            "session has no HAL device to warm up");
+  }
+
+  // Create the signal fence as a 0->1 transition reached when the barrier
+  // submission retires.
+  iree_hal_semaphore_t* semaphore = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_hal_semaphore_create(device, 0ull, &semaphore));
+  iree_hal_fence_t* signal_fence = NULL;
+  iree_status_t status = iree_hal_fence_create_at(
+      semaphore, 1ull, iree_runtime_session_host_allocator(session),
+      &signal_fence);
+  iree_hal_semaphore_release(semaphore);
+
+  // An empty submission is enough to force the device through its lazy queue
+  // bring-up; there's no work to wait on so it signals as soon as the queue
+  // machinery is live.
+  if (iree_status_is_ok(status)) {
+    status = iree_hal_device_queue_barrier(
+        device, IREE_HAL_QUEUE_AFFINITY_ANY,
+        iree_hal_semaphore_list_empty(),
+        iree_hal_fence_semaphore_list(signal_fence));
+  }
+
+  if (iree_status_is_ok(status)) {
+    *out_signal_fence = signal_fence;
+  } else {
+    iree_hal_fence_release(signal_fence);
+  }
   IREE_TRACE_ZONE_END(z0);
   return status;
 }
@@ -307,6 +475,88 @@ IREE_API_EXPORT iree_status_t iree_runtime_session_call(
   return status;
 }
 
+IREE_API_EXPORT iree_status_t iree_runtime_session_call_async(
+    iree_runtime_session_t* session, const iree_vm_function_t* function,
+    iree_vm_list_t* input_list, iree_vm_list_t* output_list,
+    iree_hal_fence_t* wait_fence, iree_hal_fence_t** out_signal_fence) {
+  IREE_ASSERT_ARGUMENT(session);
+  IREE_ASSERT_ARGUMENT(function);
+  IREE_ASSERT_ARGUMENT(input_list);
+  IREE_ASSERT_ARGUMENT(out_signal_fence);
+  *out_signal_fence = NULL;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Only functions with the coarse-fences ABI take the trailing (wait, signal)
+  // fence arguments appended below. Synchronous functions would have completed
+  // all of their work before returning anyway and callers should use
+  // iree_runtime_session_call for those.
+  iree_string_view_t model = iree_vm_function_lookup_attr_by_name(
+      function, IREE_SV("iree.abi.model"));
+  if (!iree_string_view_equal(model, IREE_SV("coarse-fences"))) {
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(
+        IREE_STATUS_FAILED_PRECONDITION,
+        "function does not support asynchronous invocation; compile the module "
+        "with the `async-external` execution model to add the (wait, signal) "
+        "fence arguments required for pipelining");
+  }
+
+  iree_hal_device_t* device = iree_runtime_session_device(session);
+  if (!device) {
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(IREE_STATUS_FAILED_PRECONDITION,
+                            "no HAL device has been initialized in the session "
+                            "and one is required to create the signal fence");
+  }
+
+  // Create the signal fence as a 0->1 transition that the invocation will
+  // signal once all of the device work it enqueues has completed.
+  iree_hal_semaphore_t* semaphore = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_hal_semaphore_create(device, 0ull, &semaphore));
+  iree_hal_fence_t* signal_fence = NULL;
+  iree_status_t status = iree_hal_fence_create_at(
+      semaphore, 1ull, iree_runtime_session_host_allocator(session),
+      &signal_fence);
+  iree_hal_semaphore_release(semaphore);
+
+  // Temporarily append the (wait, signal) fences to the caller's input list.
+  // A NULL |wait_fence| becomes a null ref indicating immediate readiness.
+  iree_host_size_t original_input_count = iree_vm_list_size(input_list);
+  if (iree_status_is_ok(status)) {
+    iree_vm_ref_t wait_fence_ref = iree_hal_fence_retain_ref(wait_fence);
+    status = iree_vm_list_push_ref_move(input_list, &wait_fence_ref);
+    iree_vm_ref_release(&wait_fence_ref);
+  }
+  if (iree_status_is_ok(status)) {
+    iree_vm_ref_t signal_fence_ref = iree_hal_fence_retain_ref(signal_fence);
+    status = iree_vm_list_push_ref_move(input_list, &signal_fence_ref);
+    iree_vm_ref_release(&signal_fence_ref);
+  }
+
+  // The invocation returns once the function has enqueued its device work;
+  // output buffers will have their contents defined only after the signal
+  // fence has been reached. Invocations on the same session share the device
+  // timeline and pipeline in issue order.
+  if (iree_status_is_ok(status)) {
+    status = iree_vm_invoke(iree_runtime_session_context(session), *function,
+                            IREE_VM_INVOCATION_FLAG_NONE,
+                            /*policy=*/NULL, input_list, output_list,
+                            iree_runtime_session_host_allocator(session));
+  }
+
+  // Restore the input list so the caller can reuse it on subsequent calls.
+  iree_status_ignore(iree_vm_list_resize(input_list, original_input_count));
+
+  if (iree_status_is_ok(status)) {
+    *out_signal_fence = signal_fence;
+  } else {
+    iree_hal_fence_release(signal_fence);
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
 IREE_API_EXPORT iree_status_t iree_runtime_session_call_by_name(
     iree_runtime_session_t* session, iree_string_view_t full_name,
     iree_vm_list_t* input_list, iree_vm_list_t* output_list) {
@@ -322,18 +572,14 @@ IREE_API_EXPORT iree_status_t iree_runtime_session_call_direct(
   IREE_ASSERT_ARGUMENT(session);
   IREE_TRACE_ZONE_BEGIN(z0);
 
-  // Allocate a VM stack on the host stack and initialize it.
-  iree_vm_context_t* context = iree_runtime_session_context(session);
-  IREE_VM_INLINE_STACK_INITIALIZE(stack, IREE_VM_INVOCATION_FLAG_NONE,
-                                  iree_vm_context_state_resolver(context),
-                                  iree_runtime_session_host_allocator(session));
-
-  // Issue the call.
-  iree_status_t status =
-      call.function.module->begin_call(call.function.module->self, stack, call);
-
-  // Cleanup the stack.
-  iree_vm_stack_deinitialize(stack);
+  // Issue the call on the caller-provided packed storage. The packed
+  // invocation path allocates nothing on its own and services any waits the
+  // callee performs synchronously.
+  iree_status_t status = iree_vm_invoke_packed(
+      iree_runtime_session_context(session), call.function,
+      IREE_VM_INVOCATION_FLAG_NONE,
+      /*policy=*/NULL, call.arguments, call.results,
+      iree_runtime_session_host_allocator(session));
 
   IREE_TRACE_ZONE_END(z0);
   return status;
@@ -88,6 +88,20 @@ IREE_API_EXPORT iree_status_t iree_runtime_session_create_with_device(
     const iree_runtime_session_options_t* options, iree_hal_device_t* device,
     iree_allocator_t host_allocator, iree_runtime_session_t** out_session);
 
+// Forks |source_session| into a new session sharing its loaded modules.
+// The modules (HAL, bytecode, and any user modules) are shared by reference
+// and only their mutable per-session state is recreated, making forks
+// dramatically cheaper than building an equivalent session from scratch.
+// Both sessions target the same device and may execute concurrently; see
+// iree_vm_context_fork for the underlying behavior.
+//
+// The source session must have all of its modules appended before forking and
+// is commonly used as an immutable template that only ever services forks.
+// |out_session| must be released by the caller.
+IREE_API_EXPORT iree_status_t iree_runtime_session_fork(
+    iree_runtime_session_t* source_session, iree_allocator_t host_allocator,
+    iree_runtime_session_t** out_session);
+
 // Retains the given |session| for the caller.
 IREE_API_EXPORT void iree_runtime_session_retain(
     iree_runtime_session_t* session);
@@ -196,6 +210,28 @@ IREE_API_EXPORT iree_status_t iree_runtime_session_lookup_function(
     const iree_runtime_session_t* session, iree_string_view_t full_name,
     iree_vm_function_t* out_function);
 
+// Begins warming up the session for first-call traffic.
+//
+// Backend-specific executable preparation (PTX JIT, ELF loading, etc) is
+// performed eagerly by the module initializers when the session context is
+// created and does not need to be requested separately. What remains before
+// the first call executes at steady-state latency is the device queue
+// bring-up: stream/command pool creation, timeline bookkeeping, and similar
+// lazily-initialized submission machinery.
+//
+// This enqueues an empty barrier submission on the device and sets
+// |out_signal_fence| to a fence signaled once it retires, forcing the queue
+// machinery through a full round-trip. Callers routing traffic (such as load
+// balancers) should mark the session ready when the fence signals rather than
+// after their own first request completes. The returned fence must be released
+// by the caller.
+//
+// Warming transient allocator pools for a specific entry point still requires
+// invoking that function once with representative inputs; pool sizing depends
+// on the actual dispatch workloads and cannot be primed generically.
+IREE_API_EXPORT iree_status_t iree_runtime_session_warm_up(
+    iree_runtime_session_t* session, iree_hal_fence_t** out_signal_fence);
+
 // Synchronously issues a generic function call.
 //
 // |input_list| is used to pass values and objects into the target function and
@@ -212,6 +248,32 @@ IREE_API_EXPORT iree_status_t iree_runtime_session_call(
     iree_runtime_session_t* session, const iree_vm_function_t* function,
     iree_vm_list_t* input_list, iree_vm_list_t* output_list);
 
+// Asynchronously issues a generic function call for device-side pipelining.
+//
+// The target |function| must use the coarse-fences ABI (compiled with the
+// `async-external` execution model): the trailing (wait, signal) fence
+// arguments it expects are appended to |input_list| internally and the list is
+// restored to its original contents before returning so that it can be reused.
+// Functions without the async ABI fail with IREE_STATUS_FAILED_PRECONDITION
+// and should be routed to iree_runtime_session_call instead.
+//
+// Device-side execution will begin once the optional |wait_fence| has been
+// signaled. The call returns as soon as the function has enqueued its device
+// work and |out_signal_fence| is signaled when that work completes; outputs in
+// |output_list| must not be consumed until then. The returned fence must be
+// released by the caller.
+//
+// Calls issued against the same session execute in issue order on the device
+// timeline. A single thread can keep a device saturated by issuing call N+1
+// (and performing its host-side pre-processing) while the device executes call
+// N and only waiting on the last returned fence. Chaining the fence returned
+// from one call as the |wait_fence| of the next adds an explicit dependency
+// when ordering through the shared timeline is insufficient.
+IREE_API_EXPORT iree_status_t iree_runtime_session_call_async(
+    iree_runtime_session_t* session, const iree_vm_function_t* function,
+    iree_vm_list_t* input_list, iree_vm_list_t* output_list,
+    iree_hal_fence_t* wait_fence, iree_hal_fence_t** out_signal_fence);
+
 // Synchronously issues a generic function call by fully-qualified name.
 // This is equivalent to performing a iree_runtime_session_lookup_function
 // followed by a iree_runtime_session_call. When calling the same function
@@ -0,0 +1,149 @@
+// Copyright 2026 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/runtime/session_pool.h"
+
+#include <string.h>
+
+#include "iree/base/internal/atomics.h"
+#include "iree/base/internal/synchronization.h"
+
+//===----------------------------------------------------------------------===//
+// iree_runtime_session_pool_t
+//===----------------------------------------------------------------------===//
+
+struct iree_runtime_session_pool_t {
+  iree_atomic_ref_count_t ref_count;
+  iree_allocator_t host_allocator;
+
+  // Template session providing the shared immutable modules. Retained.
+  // Never handed out; all pooled sessions are forks of this.
+  iree_runtime_session_t* template_session;
+
+  // Guards the free-list below.
+  iree_slim_mutex_t mutex;
+  // Number of warm sessions currently available in |free_list|.
+  iree_host_size_t count;
+  // Maximum number of warm sessions retained; excess recycles release.
+  iree_host_size_t capacity;
+  iree_runtime_session_t* free_list[];
+};
+
+IREE_API_EXPORT iree_status_t iree_runtime_session_pool_create(
+    iree_runtime_session_t* template_session, iree_host_size_t capacity,
+    iree_allocator_t host_allocator, iree_runtime_session_pool_t** out_pool) {
+  IREE_ASSERT_ARGUMENT(template_session);
+  IREE_ASSERT_ARGUMENT(out_pool);
+  *out_pool = NULL;
+  if (!capacity) capacity = IREE_RUNTIME_SESSION_POOL_DEFAULT_CAPACITY;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_runtime_session_pool_t* pool = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(
+              host_allocator,
+              sizeof(*pool) + capacity * sizeof(pool->free_list[0]),
+              (void**)&pool));
+  iree_atomic_ref_count_init(&pool->ref_count);
+  pool->host_allocator = host_allocator;
+  pool->template_session = template_session;
+  iree_runtime_session_retain(pool->template_session);
+  iree_slim_mutex_initialize(&pool->mutex);
+  pool->count = 0;
+  pool->capacity = capacity;
+
+  *out_pool = pool;
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
+static void iree_runtime_session_pool_destroy(
+    iree_runtime_session_pool_t* pool) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+  for (iree_host_size_t i = 0; i < pool->count; ++i) {
+    iree_runtime_session_release(pool->free_list[i]);
+  }
+  iree_slim_mutex_deinitialize(&pool->mutex);
+  iree_runtime_session_release(pool->template_session);
+  iree_allocator_free(pool->host_allocator, pool);
+  IREE_TRACE_ZONE_END(z0);
+}
+
+IREE_API_EXPORT void iree_runtime_session_pool_retain(
+    iree_runtime_session_pool_t* pool) {
+  if (pool) {
+    iree_atomic_ref_count_inc(&pool->ref_count);
+  }
+}
+
+IREE_API_EXPORT void iree_runtime_session_pool_release(
+    iree_runtime_session_pool_t* pool) {
+  if (pool && iree_atomic_ref_count_dec(&pool->ref_count) == 1) {
+    iree_runtime_session_pool_destroy(pool);
+  }
+}
+
+IREE_API_EXPORT iree_status_t iree_runtime_session_pool_prewarm(
+    iree_runtime_session_pool_t* pool, iree_host_size_t session_count) {
+  IREE_ASSERT_ARGUMENT(pool);
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_status_t status = iree_ok_status();
+  for (iree_host_size_t i = 0; i < session_count; ++i) {
+    // Fork outside the lock; forks of the same template may run concurrently.
+    iree_runtime_session_t* session = NULL;
+    status = iree_runtime_session_fork(pool->template_session,
+                                       pool->host_allocator, &session);
+    if (!iree_status_is_ok(status)) break;
+
+    iree_slim_mutex_lock(&pool->mutex);
+    bool retained = pool->count < pool->capacity;
+    if (retained) pool->free_list[pool->count++] = session;
+    iree_slim_mutex_unlock(&pool->mutex);
+    if (!retained) {
+      // Raced with recycles (or asked for more than capacity); stop early.
+      iree_runtime_session_release(session);
+      break;
+    }
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+IREE_API_EXPORT iree_status_t iree_runtime_session_pool_acquire(
+    iree_runtime_session_pool_t* pool, iree_runtime_session_t** out_session) {
+  IREE_ASSERT_ARGUMENT(pool);
+  IREE_ASSERT_ARGUMENT(out_session);
+  *out_session = NULL;
+
+  // Fast path: hand out a warm session.
+  iree_slim_mutex_lock(&pool->mutex);
+  if (pool->count > 0) {
+    *out_session = pool->free_list[--pool->count];
+    iree_slim_mutex_unlock(&pool->mutex);
+    return iree_ok_status();
+  }
+  iree_slim_mutex_unlock(&pool->mutex);
+
+  // Pool exhausted; fork a fresh session from the template.
+  return iree_runtime_session_fork(pool->template_session,
+                                   pool->host_allocator, out_session);
+}
+
+IREE_API_EXPORT void iree_runtime_session_pool_recycle(
+    iree_runtime_session_pool_t* pool, iree_runtime_session_t* session) {
+  IREE_ASSERT_ARGUMENT(pool);
+  if (!session) return;
+
+  iree_slim_mutex_lock(&pool->mutex);
+  bool retained = pool->count < pool->capacity;
+  if (retained) pool->free_list[pool->count++] = session;
+  iree_slim_mutex_unlock(&pool->mutex);
+  if (!retained) {
+    iree_runtime_session_release(session);
+  }
+}
@@ -0,0 +1,85 @@
+// Copyright 2026 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_RUNTIME_SESSION_POOL_H_
+#define IREE_RUNTIME_SESSION_POOL_H_
+
+#include "iree/base/api.h"
+#include "iree/runtime/session.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+//===----------------------------------------------------------------------===//
+// iree_runtime_session_pool_t
+//===----------------------------------------------------------------------===//
+
+// Default number of warm sessions retained by a pool.
+#define IREE_RUNTIME_SESSION_POOL_DEFAULT_CAPACITY 8
+
+// A pool of forked sessions derived from a shared template session.
+//
+// The template session carries the expensive immutable state (loaded HAL and
+// bytecode modules, device bindings) and each pooled session is a cheap fork
+// containing only mutable module state; see iree_runtime_session_fork.
+// Sessions released back to the pool are kept warm on a free-list and handed
+// out again without re-running module initialization, absorbing request
+// bursts without per-request context construction cost.
+//
+// Recycled sessions retain their mutable module globals from prior use. For
+// the common serving case that is the point - caches and scratch allocations
+// stay warm - but callers that require pristine state per request should
+// release sessions with iree_runtime_session_release instead of recycling.
+//
+// Thread-safe; sessions may be acquired and recycled concurrently from
+// multiple threads though each acquired session remains thread-compatible as
+// usual.
+typedef struct iree_runtime_session_pool_t iree_runtime_session_pool_t;
+
+// Creates a session pool deriving sessions from |template_session|.
+// The template must have all of its modules appended before the pool is
+// created and should not be used for execution afterward. Up to |capacity|
+// warm sessions are retained (IREE_RUNTIME_SESSION_POOL_DEFAULT_CAPACITY if
+// 0); acquisitions beyond the warm set fork new sessions on demand.
+// |out_pool| must be released by the caller.
+IREE_API_EXPORT iree_status_t iree_runtime_session_pool_create(
+    iree_runtime_session_t* template_session, iree_host_size_t capacity,
+    iree_allocator_t host_allocator, iree_runtime_session_pool_t** out_pool);
+
+// Retains the given |pool| for the caller.
+IREE_API_EXPORT void iree_runtime_session_pool_retain(
+    iree_runtime_session_pool_t* pool);
+
+// Releases the given |pool| from the caller.
+// Warm sessions held by the pool are released; sessions currently acquired
+// remain valid until individually released.
+IREE_API_EXPORT void iree_runtime_session_pool_release(
+    iree_runtime_session_pool_t* pool);
+
+// Populates the pool with up to |session_count| warm sessions (clamped to the
+// pool capacity). Call ahead of anticipated bursts to move fork costs off the
+// request path.
+IREE_API_EXPORT iree_status_t iree_runtime_session_pool_prewarm(
+    iree_runtime_session_pool_t* pool, iree_host_size_t session_count);
+
+// Acquires a session from the pool, forking a new one if none are warm.
+// |out_session| must be returned with iree_runtime_session_pool_recycle or
+// released with iree_runtime_session_release.
+IREE_API_EXPORT iree_status_t iree_runtime_session_pool_acquire(
+    iree_runtime_session_pool_t* pool, iree_runtime_session_t** out_session);
+
+// Returns |session| to the pool for reuse.
+// The session is kept warm if the pool has capacity and released otherwise.
+// Ownership of the caller's reference transfers to the pool.
+IREE_API_EXPORT void iree_runtime_session_pool_recycle(
+    iree_runtime_session_pool_t* pool, iree_runtime_session_t* session);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // IREE_RUNTIME_SESSION_POOL_H_
@@ -160,6 +160,13 @@ enum iree_io_parameter_archive_entry_type_e {
   // Entry represents data stored in an external file.
   // See iree_io_parameter_archive_external_entry_t.
   IREE_IO_PARAMETER_ARCHIVE_ENTRY_TYPE_EXTERNAL = 3,
+  // Entry represents data embedded in the archive as a sequence of chunks that
+  // may be independently compressed and checksummed.
+  // See iree_io_parameter_archive_chunked_data_entry_t.
+  // Requires version 0.1+; writers emitting this entry type must declare a
+  // minor version of at least 1 so that older runtimes reject the archive
+  // instead of failing on the unknown entry type.
+  IREE_IO_PARAMETER_ARCHIVE_ENTRY_TYPE_CHUNKED_DATA = 4,
 };
 // Defines the type of an entry in the archive entry table.
 typedef uint32_t iree_io_parameter_archive_entry_type_t;
@@ -226,6 +233,61 @@ typedef struct iree_io_parameter_archive_data_entry_t {
   iree_io_parameter_archive_storage_ref_t storage;
 } iree_io_parameter_archive_data_entry_t;
 
+enum iree_io_parameter_archive_codec_e {
+  // Chunk bytes are stored verbatim. Chunks of a single entry must be
+  // contiguous in the storage segment so that readers can reference the entire
+  // entry zero-copy as with IREE_IO_PARAMETER_ARCHIVE_ENTRY_TYPE_DATA.
+  IREE_IO_PARAMETER_ARCHIVE_CODEC_NONE = 0,
+  // Each chunk is an independently decompressable zstd frame.
+  // Requires a runtime built with a zstd decoder.
+  IREE_IO_PARAMETER_ARCHIVE_CODEC_ZSTD = 1,
+};
+// Defines how the stored bytes of a chunk are transformed.
+typedef uint32_t iree_io_parameter_archive_codec_t;
+
+enum iree_io_parameter_archive_checksum_algorithm_e {
+  // Chunk checksum fields are zero and must be ignored.
+  IREE_IO_PARAMETER_ARCHIVE_CHECKSUM_ALGORITHM_NONE = 0,
+  // Chunk checksum fields contain a CRC-32 (ISO-HDLC polynomial 0xEDB88320)
+  // of the stored (post-codec) chunk bytes.
+  IREE_IO_PARAMETER_ARCHIVE_CHECKSUM_ALGORITHM_CRC32 = 1,
+};
+// Defines how chunk checksums are computed.
+typedef uint32_t iree_io_parameter_archive_checksum_algorithm_t;
+
+// A single chunk of a chunked data entry as stored in the metadata segment.
+typedef struct iree_io_parameter_archive_chunk_t {
+  // Stored (post-codec) bytes of the chunk in the data storage segment.
+  iree_io_parameter_archive_storage_ref_t storage;
+  // Length of the chunk in bytes once decoded. Matches storage.length when the
+  // entry codec is IREE_IO_PARAMETER_ARCHIVE_CODEC_NONE.
+  iree_io_physical_size_t uncompressed_length;
+  // Checksum of the stored bytes per the entry checksum algorithm.
+  uint32_t checksum;
+  // Reserved for future use; zero filled.
+  uint32_t reserved;
+} iree_io_parameter_archive_chunk_t;
+
+// An entry referencing a sequence of chunks in the data storage segment that
+// concatenate (after decoding) to form the parameter contents. Chunks decode
+// independently so that loaders can fan decompression and verification out
+// across workers. Verification is optional and may be deferred off the load
+// critical path.
+typedef struct iree_io_parameter_archive_chunked_data_entry_t {
+  // Entry header with type IREE_IO_PARAMETER_ARCHIVE_ENTRY_TYPE_CHUNKED_DATA.
+  iree_io_parameter_archive_entry_header_t header;
+  // Codec applied to each chunk independently.
+  iree_io_parameter_archive_codec_t codec;
+  // Checksum algorithm applied to the stored bytes of each chunk.
+  iree_io_parameter_archive_checksum_algorithm_t checksum_algorithm;
+  // Maximum decoded length of each chunk in bytes; all chunks but the last
+  // must decode to exactly this many bytes.
+  iree_io_physical_size_t chunk_size;
+  // Reference to an array of iree_io_parameter_archive_chunk_t in the metadata
+  // segment, in parameter order.
+  iree_io_parameter_archive_metadata_ref_t chunk_table;
+} iree_io_parameter_archive_chunked_data_entry_t;
+
 // An entry referencing data in an external file.
 typedef struct iree_io_parameter_archive_external_entry_t {
   // Entry header with type IREE_IO_PARAMETER_ARCHIVE_ENTRY_TYPE_EXTERNAL.
@@ -24,6 +24,13 @@ IREE_FLAG(
     "when latency is the #1 priority (vs. thermals, system-wide scheduling,\n"
     "etc).");
 
+IREE_FLAG(
+    int32_t, task_worker_stall_threshold_us, 0,
+    "Execution-time budget in microseconds for each task run by a worker.\n"
+    "Tasks exceeding the budget are counted as stalls in the executor\n"
+    "statistics and attributed to their scope so that tail-latency incidents\n"
+    "can be traced back to specific dispatches. 0 disables the watchdog.");
+
 IREE_FLAG(
     int32_t, task_worker_stack_size, 128 * 1024,
     "Minimum size in bytes of each worker thread stack.\n"
@@ -50,6 +57,8 @@ iree_status_t iree_task_executor_options_initialize_from_flags(
   iree_task_executor_options_initialize(out_options);
   out_options->worker_spin_ns =
       (iree_duration_t)FLAG_task_worker_spin_us * 1000;
+  out_options->worker_stall_threshold_ns =
+      (iree_duration_t)FLAG_task_worker_stall_threshold_us * 1000;
   out_options->worker_stack_size =
       (iree_host_size_t)FLAG_task_worker_stack_size;
   out_options->worker_local_memory_size =
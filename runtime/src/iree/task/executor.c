@@ -91,12 +91,17 @@ iree_status_t iree_task_executor_create(iree_task_executor_options_t options,
 
   iree_task_executor_t* executor = NULL;
   IREE_RETURN_AND_END_ZONE_IF_ERROR(
-      z0, iree_allocator_malloc(allocator, executor_size, (void**)&executor));
-  memset(executor, 0, executor_size);
+      z0, iree_allocator_malloc_uninitialized(allocator, executor_size,
+                                              (void**)&executor));
+  // NOTE: only the executor and worker structures are zeroed here; the worker
+  // local memory tail is deliberately left untouched so that each worker
+  // thread first-touches (and thus NUMA-places) its own pages on startup.
+  memset(executor, 0, executor_base_size + worker_list_size);
   iree_atomic_ref_count_init(&executor->ref_count);
   executor->allocator = allocator;
   executor->scheduling_mode = options.scheduling_mode;
   executor->worker_spin_ns = options.worker_spin_ns;
+  executor->worker_stall_threshold_ns = options.worker_stall_threshold_ns;
   iree_atomic_task_slist_initialize(&executor->incoming_ready_slist);
   iree_slim_mutex_initialize(&executor->coordinator_mutex);
 
@@ -280,6 +285,64 @@ iree_event_pool_t* iree_task_executor_event_pool(
   return executor->event_pool;
 }
 
+void iree_task_executor_query_statistics(
+    iree_task_executor_t* executor,
+    iree_task_executor_statistics_t* out_statistics) {
+  memset(out_statistics, 0, sizeof(*out_statistics));
+  IREE_STATISTICS({
+    for (iree_host_size_t i = 0; i < executor->worker_count; ++i) {
+      iree_task_worker_statistics_t* statistics =
+          &executor->workers[i].statistics;
+      out_statistics->task_count += iree_atomic_load_int64(
+          &statistics->task_count, iree_memory_order_relaxed);
+      out_statistics->steal_count += iree_atomic_load_int64(
+          &statistics->steal_count, iree_memory_order_relaxed);
+      out_statistics->park_count += iree_atomic_load_int64(
+          &statistics->park_count, iree_memory_order_relaxed);
+      out_statistics->max_queue_depth = iree_max(
+          out_statistics->max_queue_depth,
+          iree_atomic_load_int32(&statistics->max_queue_depth,
+                                 iree_memory_order_relaxed));
+      out_statistics->stall_count += iree_atomic_load_int64(
+          &statistics->stall_count, iree_memory_order_relaxed);
+      int64_t max_stall_ns = iree_atomic_load_int64(&statistics->max_stall_ns,
+                                                    iree_memory_order_relaxed);
+      if (max_stall_ns > out_statistics->max_stall_ns) {
+        out_statistics->max_stall_ns = max_stall_ns;
+        memcpy(out_statistics->max_stall_scope, statistics->max_stall_scope,
+               sizeof(out_statistics->max_stall_scope));
+        out_statistics
+            ->max_stall_scope[sizeof(out_statistics->max_stall_scope) - 1] =
+            '\0';
+      }
+    }
+  });
+}
+
+iree_status_t iree_task_executor_statistics_fprint(
+    FILE* file, iree_task_executor_t* executor) {
+#if IREE_STATISTICS_ENABLE
+  iree_task_executor_statistics_t statistics;
+  iree_task_executor_query_statistics(executor, &statistics);
+  fprintf(file,
+          "[[ iree_task_executor_t execution statistics ]]\n"
+          "        tasks executed: %" PRId64 "\n"
+          "          tasks stolen: %" PRId64 "\n"
+          "          worker parks: %" PRId64 "\n"
+          "       max queue depth: %" PRId32 "\n"
+          "           task stalls: %" PRId64 "\n"
+          "        max stall (ns): %" PRId64 " (scope: %s)\n",
+          statistics.task_count, statistics.steal_count, statistics.park_count,
+          statistics.max_queue_depth, statistics.stall_count,
+          statistics.max_stall_ns,
+          statistics.max_stall_scope[0] ? statistics.max_stall_scope : "-");
+  return iree_ok_status();
+#else
+  // No-op.
+  return iree_ok_status();
+#endif  // IREE_STATISTICS_ENABLE
+}
+
 iree_status_t iree_task_executor_acquire_fence(iree_task_executor_t* executor,
                                                iree_task_scope_t* scope,
                                                iree_task_fence_t** out_fence) {
@@ -324,69 +387,90 @@ void iree_task_executor_schedule_ready_tasks(
     iree_task_post_batch_t* post_batch) {
   IREE_TRACE_ZONE_BEGIN(z0);
   iree_task_t* task = NULL;
-  while ((task = iree_task_list_pop_front(&pending_submission->ready_list))) {
-    // If the scope has been marked as failing then we abort the task.
-    // This needs to happen as a poll here because one or more of the tasks we
-    // are joining may have failed.
-    if (IREE_UNLIKELY(!task->scope ||
-                      iree_task_scope_has_failed(task->scope))) {
-      iree_task_list_t discard_worklist;
-      iree_task_list_initialize(&discard_worklist);
-      iree_task_discard(task, &discard_worklist);
-      iree_task_list_discard(&discard_worklist);
-      continue;
+  do {
+    // Partition the ready list by the effective priority class of each task's
+    // scope so that higher classes are issued to workers first. Tasks within a
+    // class retain their submission order and in the common case of all scopes
+    // running at the default class this is a passthrough of the original list.
+    iree_task_list_t class_lists[IREE_TASK_PRIORITY_CLASS_COUNT];
+    for (iree_host_size_t i = 0; i < IREE_TASK_PRIORITY_CLASS_COUNT; ++i) {
+      iree_task_list_initialize(&class_lists[i]);
+    }
+    const iree_time_t now_ns = iree_time_now();
+    while ((task = iree_task_list_pop_front(&pending_submission->ready_list))) {
+      iree_task_priority_class_t priority_class =
+          task->scope
+              ? iree_task_scope_effective_priority_class(task->scope, now_ns)
+              : IREE_TASK_PRIORITY_CLASS_IDLE;
+      iree_task_list_push_back(&class_lists[priority_class], task);
     }
+    for (int class_i = IREE_TASK_PRIORITY_CLASS_COUNT - 1; class_i >= 0;
+         --class_i) {
+      while ((task = iree_task_list_pop_front(&class_lists[class_i]))) {
+        // If the scope has been marked as failing then we abort the task.
+        // This needs to happen as a poll here because one or more of the tasks we
+        // are joining may have failed.
+        if (IREE_UNLIKELY(!task->scope ||
+                          iree_task_scope_has_failed(task->scope))) {
+          iree_task_list_t discard_worklist;
+          iree_task_list_initialize(&discard_worklist);
+          iree_task_discard(task, &discard_worklist);
+          iree_task_list_discard(&discard_worklist);
+          continue;
+        }
 
-    switch (task->type) {
-      case IREE_TASK_TYPE_NOP:
-        // Doesn't do anything; just retire and continue on to any dependents.
-        iree_task_nop_retire((iree_task_nop_t*)task, pending_submission);
-        break;
-      case IREE_TASK_TYPE_CALL: {
-        // Generic routing to workers for tasks that should always run there.
-        iree_task_executor_relay_to_worker(executor, post_batch, task);
-        break;
-      }
-      case IREE_TASK_TYPE_BARRIER: {
-        // Retire the barrier to (possibly) ready up all dependent tasks.
-        // This acts as a fan-out in cases where the dependent task count >1.
-        iree_task_barrier_retire((iree_task_barrier_t*)task,
-                                 pending_submission);
-        break;
-      }
-      case IREE_TASK_TYPE_FENCE: {
-        // Scope fence hit; notifies the scope so that anyone waiting on the
-        // fence can be notified without us having to do so explicitly.
-        iree_task_fence_retire((iree_task_fence_t*)task, pending_submission);
-        break;
-      }
-      case IREE_TASK_TYPE_WAIT: {
-        // We should only ever see completed waits here; ones that have yet to
-        // resolve are sent to the poller.
-        iree_task_wait_retire(
-            (iree_task_wait_t*)task, pending_submission,
-            iree_all_bits_set(task->flags, IREE_TASK_FLAG_WAIT_COMPLETED)
-                ? iree_ok_status()
-                : iree_make_status(IREE_STATUS_INTERNAL,
-                                   "unresolved wait task ended up in the "
-                                   "executor run queue"));
-        break;
-      }
-      case IREE_TASK_TYPE_DISPATCH: {
-        // Dispatches may need to be issued (fanning out the tiles to workers)
-        // or retired (after all tiles have completed).
-        if (task->flags & IREE_TASK_FLAG_DISPATCH_RETIRE) {
-          iree_task_dispatch_retire((iree_task_dispatch_t*)task,
-                                    pending_submission);
-        } else {
-          iree_task_dispatch_issue((iree_task_dispatch_t*)task,
-                                   &executor->transient_task_pool,
-                                   pending_submission, post_batch);
+        switch (task->type) {
+          case IREE_TASK_TYPE_NOP:
+            // Doesn't do anything; just retire and continue on to any dependents.
+            iree_task_nop_retire((iree_task_nop_t*)task, pending_submission);
+            break;
+          case IREE_TASK_TYPE_CALL: {
+            // Generic routing to workers for tasks that should always run there.
+            iree_task_executor_relay_to_worker(executor, post_batch, task);
+            break;
+          }
+          case IREE_TASK_TYPE_BARRIER: {
+            // Retire the barrier to (possibly) ready up all dependent tasks.
+            // This acts as a fan-out in cases where the dependent task count >1.
+            iree_task_barrier_retire((iree_task_barrier_t*)task,
+                                     pending_submission);
+            break;
+          }
+          case IREE_TASK_TYPE_FENCE: {
+            // Scope fence hit; notifies the scope so that anyone waiting on the
+            // fence can be notified without us having to do so explicitly.
+            iree_task_fence_retire((iree_task_fence_t*)task, pending_submission);
+            break;
+          }
+          case IREE_TASK_TYPE_WAIT: {
+            // We should only ever see completed waits here; ones that have yet to
+            // resolve are sent to the poller.
+            iree_task_wait_retire(
+                (iree_task_wait_t*)task, pending_submission,
+                iree_all_bits_set(task->flags, IREE_TASK_FLAG_WAIT_COMPLETED)
+                    ? iree_ok_status()
+                    : iree_make_status(IREE_STATUS_INTERNAL,
+                                       "unresolved wait task ended up in the "
+                                       "executor run queue"));
+            break;
+          }
+          case IREE_TASK_TYPE_DISPATCH: {
+            // Dispatches may need to be issued (fanning out the tiles to workers)
+            // or retired (after all tiles have completed).
+            if (task->flags & IREE_TASK_FLAG_DISPATCH_RETIRE) {
+              iree_task_dispatch_retire((iree_task_dispatch_t*)task,
+                                        pending_submission);
+            } else {
+              iree_task_dispatch_issue((iree_task_dispatch_t*)task,
+                                       &executor->transient_task_pool,
+                                       pending_submission, post_batch);
+            }
+            break;
+          }
         }
-        break;
       }
     }
-  }
+  } while (!iree_task_list_is_empty(&pending_submission->ready_list));
   IREE_TRACE_ZONE_END(z0);
 }
 
@@ -562,6 +646,59 @@ static iree_task_t* iree_task_executor_try_steal_task_from_affinity_set(
   return NULL;
 }
 
+// Selects a uniformly random victim worker from |victim_mask|.
+// Returns -1 if the mask is empty.
+static int iree_task_executor_select_random_victim(
+    iree_task_executor_t* executor, iree_task_affinity_set_t victim_mask,
+    iree_prng_minilcg128_state_t* theft_prng) {
+  int victim_count = iree_task_affinity_set_count_ones(victim_mask);
+  if (!victim_count) return -1;
+  int target_ordinal =
+      iree_prng_minilcg128_next_uint8(theft_prng) % victim_count;
+  int victim_index = 0;
+  for (;;) {
+    int offset = iree_task_affinity_set_count_trailing_zeros(victim_mask);
+    victim_index += offset;
+    if (target_ordinal-- == 0) break;
+    victim_mask = iree_shr(victim_mask, offset + 1);
+    ++victim_index;
+  }
+  return victim_index % (int)executor->worker_count;
+}
+
+// Tries to steal from one of two randomly sampled victims, preferring the one
+// advertising the deeper local queue ("power of two choices"). This biases
+// theft toward the most-loaded workers without scanning every queue and avoids
+// the herding that the in-order rotation scan exhibits when many workers go
+// idle at the same time. Falls back to NULL on a miss so the caller can run
+// the exhaustive scan.
+static iree_task_t* iree_task_executor_try_steal_task_two_choice(
+    iree_task_executor_t* executor, iree_task_affinity_set_t victim_mask,
+    iree_prng_minilcg128_state_t* theft_prng,
+    iree_task_queue_t* local_task_queue) {
+  int victim_index = iree_task_executor_select_random_victim(
+      executor, victim_mask, theft_prng);
+  if (victim_index < 0) return NULL;
+  int other_index = iree_task_executor_select_random_victim(
+      executor, victim_mask, theft_prng);
+  if (other_index >= 0 && other_index != victim_index &&
+      iree_task_queue_approx_depth(
+          &executor->workers[other_index].local_task_queue) >
+          iree_task_queue_approx_depth(
+              &executor->workers[victim_index].local_task_queue)) {
+    victim_index = other_index;
+  }
+  iree_task_worker_t* victim_worker = &executor->workers[victim_index];
+  if (iree_atomic_load_int32(&victim_worker->state,
+                             iree_memory_order_acquire) !=
+      IREE_TASK_WORKER_STATE_RUNNING) {
+    return NULL;
+  }
+  return iree_task_worker_try_steal_task(
+      victim_worker, local_task_queue,
+      /*max_tasks=*/IREE_TASK_EXECUTOR_MAX_THEFT_TASK_COUNT);
+}
+
 // Tries to steal an entire task from a sibling worker (based on topology).
 // Returns a task that is available (has not yet begun processing at all).
 // May steal multiple tasks and add them to the |local_task_queue|.
@@ -602,11 +739,22 @@ iree_task_t* iree_task_executor_try_steal_task(
   int rotation_offset = iree_prng_minilcg128_next_uint8(theft_prng) &
                         (8 * sizeof(iree_task_affinity_set_t) - 1);
 
+  // Fast path: randomized two-choice selection across all live busy workers.
+  // When the depth hints are accurate this finds the richest victims in O(1);
+  // when they race we just fall through to the ordered scans below.
+  iree_task_t* task = iree_task_executor_try_steal_task_two_choice(
+      executor, victim_mask, theft_prng, local_task_queue);
+  if (task) {
+    IREE_TRACE_ZONE_APPEND_TEXT(z0, "two-choice");
+    IREE_TRACE_ZONE_END(z0);
+    return task;
+  }
+
   // Try first with the workers we may have some caches shared with. This
   // helps to prevent cache invalidations/availability updates as it's likely
   // that we won't need to go back to main memory (or higher cache tiers) in the
   // event that the thief and victim are running close to each other in time.
-  iree_task_t* task = iree_task_executor_try_steal_task_from_affinity_set(
+  task = iree_task_executor_try_steal_task_from_affinity_set(
       executor, victim_mask & constructive_sharing_mask, max_theft_attempts,
       rotation_offset, local_task_queue);
   if (task) {
@@ -632,6 +780,25 @@ iree_status_t iree_task_executor_donate_caller(iree_task_executor_t* executor,
   // Perform an immediate flush/coordination (in case the caller queued).
   iree_task_executor_flush(executor);
 
+  // Spin for the executor's configured budget before blocking: callers
+  // donating their thread are usually in latency-sensitive submit-and-wait
+  // loops and short waits will resolve within the spin window, avoiding a
+  // kernel wait and the wake latency that comes with it.
+  if (executor->worker_spin_ns > 0) {
+    const iree_time_t spin_deadline_ns =
+        iree_time_now() + executor->worker_spin_ns;
+    do {
+      iree_status_t poll_status =
+          iree_wait_source_wait_one(wait_source, iree_immediate_timeout());
+      if (!iree_status_is_deadline_exceeded(poll_status)) {
+        IREE_TRACE_ZONE_END(z0);
+        return poll_status;
+      }
+      iree_status_ignore(poll_status);
+      iree_thread_yield();
+    } while (iree_time_now() < spin_deadline_ns);
+  }
+
   // Wait until completed.
   // TODO(benvanik): make this steal tasks until wait_handle resolves?
   // Somewhat dangerous as we don't know what kind of thread we are running on;
@@ -8,6 +8,7 @@
 #define IREE_TASK_EXECUTOR_H_
 
 #include <stdint.h>
+#include <stdio.h>
 
 #include "iree/base/api.h"
 #include "iree/base/internal/atomics.h"
@@ -286,8 +287,22 @@ typedef struct iree_task_executor_options_t {
   // spinning is often extremely harmful to system health. Only set to non-zero
   // values when latency is the #1 priority (over thermals, system-wide
   // scheduling, and the environment).
+  //
+  // Workers treat this as a budget: the full duration is spent spinning only
+  // while work keeps arriving and each fruitless wake halves the spin so idle
+  // workers quickly decay to parking in the kernel. Callers donating their
+  // thread via iree_task_executor_donate_caller spin with the same budget
+  // before blocking.
   iree_duration_t worker_spin_ns;
 
+  // Execution-time budget in nanoseconds for each task run by a worker.
+  // Tasks exceeding the budget are counted as stalls in the worker telemetry
+  // and attributed to their scope so that tail-latency incidents (page faults
+  // on mapped memory, locks held in user code, etc) can be traced back to
+  // specific dispatches without kernel tracing. Costs two timestamp queries
+  // per task while enabled. IREE_DURATION_ZERO disables the watchdog.
+  iree_duration_t worker_stall_threshold_ns;
+
   // Minimum size in bytes of each worker thread stack.
   // The underlying platform may allocate more stack space but _should_
   // guarantee that the available stack space is near this amount. Note that the
@@ -343,6 +358,40 @@ iree_host_size_t iree_task_executor_worker_count(
 iree_event_pool_t* iree_task_executor_event_pool(
     iree_task_executor_t* executor);
 
+// Aggregated execution statistics for an executor.
+// Values are sampled with relaxed atomics and may tear relative to each other;
+// they are telemetry only and must not be used for control flow.
+typedef struct iree_task_executor_statistics_t {
+  // Total number of tasks executed across all workers.
+  int64_t task_count;
+  // Total number of tasks workers stole from other workers.
+  int64_t steal_count;
+  // Total number of times workers parked in the kernel waiting for work.
+  int64_t park_count;
+  // Maximum observed local task queue depth across all workers.
+  int32_t max_queue_depth;
+  // Total number of tasks whose execution exceeded the configured
+  // worker_stall_threshold_ns budget (always 0 if the watchdog is disabled).
+  int64_t stall_count;
+  // Longest observed task execution time in nanoseconds across all workers
+  // while the stall watchdog was enabled.
+  int64_t max_stall_ns;
+  // Name of the scope owning the longest observed stall (best-effort).
+  char max_stall_scope[16];
+} iree_task_executor_statistics_t;
+
+// Queries the aggregated execution statistics of |executor|.
+// Zeros |out_statistics| if statistics are not enabled
+// (IREE_STATISTICS_ENABLE).
+void iree_task_executor_query_statistics(
+    iree_task_executor_t* executor,
+    iree_task_executor_statistics_t* out_statistics);
+
+// Prints the current execution statistics of |executor| to |file|.
+// No-op if statistics are not enabled (IREE_STATISTICS_ENABLE).
+iree_status_t iree_task_executor_statistics_fprint(
+    FILE* file, iree_task_executor_t* executor);
+
 // Acquires a fence for the given |scope| from the executor fence pool.
 iree_status_t iree_task_executor_acquire_fence(iree_task_executor_t* executor,
                                                iree_task_scope_t* scope,
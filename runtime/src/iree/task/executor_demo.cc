@@ -164,6 +164,7 @@ extern "C" int main(int argc, char* argv[]) {
   IREE_CHECK_OK(iree_task_scope_wait_idle(&scope_a, IREE_TIME_INFINITE_FUTURE));
 
   iree_task_scope_deinitialize(&scope_a);
+  IREE_CHECK_OK(iree_task_executor_statistics_fprint(stdout, executor));
   iree_task_executor_release(executor);
   IREE_TRACE_APP_EXIT(0);
   return 0;
@@ -42,6 +42,10 @@ struct iree_task_executor_t {
   // IREE_DURATION_ZERO is used to disable spinning.
   iree_duration_t worker_spin_ns;
 
+  // Execution-time budget per task after which workers record a stall.
+  // IREE_DURATION_ZERO disables the stall watchdog.
+  iree_duration_t worker_stall_threshold_ns;
+
   // State used by the work-stealing operations performed by donated threads.
   // This is **NOT SYNCHRONIZED** and relies on the fact that we actually don't
   // much care about the precise selection of workers enough to mind any tears
@@ -412,14 +412,24 @@ static void iree_task_poller_wake_task(iree_task_poller_t* poller,
                                        iree_wait_handle_t wake_handle) {
   IREE_TRACE_ZONE_BEGIN(z0);
 
-  // TODO(benvanik): scan the list. We need a way to map wake_handle back to
-  // the zero or more tasks that match it but don't currently store the
-  // handle. Ideally we'd have the wait set tell us precisely which things
-  // woke - possibly by having a bitmap of original insertions that match the
-  // handle - but for now we just eat the extra query syscall.
+  // Scan the wait list and mark any task whose exported wait handle matches
+  // the woken handle as completed. The next prepare scan retires marked tasks
+  // via the IREE_TASK_FLAG_WAIT_COMPLETED fast path without needing a query
+  // syscall per task. Multiple tasks may be waiting on the same handle and all
+  // of them resolve together.
   int woken_tasks = 0;
-
-  (void)woken_tasks;
+  for (iree_task_t* task = iree_task_list_front(&poller->wait_list);
+       task != NULL; task = task->next_task) {
+    if (!iree_all_bits_set(task->flags, IREE_TASK_FLAG_WAIT_EXPORTED)) continue;
+    iree_wait_handle_t* wait_handle =
+        iree_wait_handle_from_source(&((iree_task_wait_t*)task)->wait_source);
+    if (wait_handle && wait_handle->type == wake_handle.type &&
+        memcmp(&wait_handle->value, &wake_handle.value,
+               sizeof(wake_handle.value)) == 0) {
+      task->flags |= IREE_TASK_FLAG_WAIT_COMPLETED;
+      ++woken_tasks;
+    }
+  }
   IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, woken_tasks);
   IREE_TRACE_ZONE_END(z0);
 }
@@ -437,30 +447,35 @@ static void iree_task_poller_commit_wait(iree_task_poller_t* poller,
 
   IREE_TRACE_ZONE_BEGIN(z0);
 
-  // Enter the system wait API.
-  iree_wait_handle_t wake_handle = iree_wait_handle_immediate();
+  // Enter the system wait API. We poll for the full batch of signaled handles
+  // so that a single system wait resolves every ready task; backends that only
+  // identify one woken handle per wait report a batch of one and the remaining
+  // tasks resolve on subsequent pumps.
+  iree_wait_handle_t wake_handles[16];
+  iree_host_size_t wake_count = 0;
   iree_status_t status =
-      iree_wait_any(poller->wait_set, deadline_ns, &wake_handle);
+      iree_wait_set_poll(poller->wait_set, deadline_ns,
+                         IREE_ARRAYSIZE(wake_handles), wake_handles,
+                         &wake_count);
   if (iree_status_is_ok(status)) {
-    // One or more waiters is ready. We don't support multi-wake right now so
-    // we'll just take the one we got back and try again.
-    //
-    // To avoid extra syscalls we scan the list and mark whatever tasks were
-    // using the handle the wait set reported waking as completed. On the next
-    // scan they'll be retired immediately. Ideally we'd have the wait set be
-    // able to tell us this precise list.
-    if (iree_wait_handle_is_immediate(wake_handle)) {
-      // No-op wait - ignore.
-      IREE_TRACE_ZONE_APPEND_TEXT(z0, "nop");
-    } else if (wake_handle.type == poller->wake_event.type &&
-               memcmp(&wake_handle.value, &poller->wake_event.value,
-                      sizeof(wake_handle.value)) == 0) {
-      // Woken on the wake_event used to exit the system wait early.
-      IREE_TRACE_ZONE_APPEND_TEXT(z0, "wake_event");
-    } else {
-      // Route to zero or more tasks using this handle.
-      IREE_TRACE_ZONE_APPEND_TEXT(z0, "task(s)");
-      iree_task_poller_wake_task(poller, wake_handle);
+    // One or more waiters is ready. To avoid extra syscalls we scan the list
+    // and mark whatever tasks were using the handles the wait set reported
+    // waking as completed. On the next scan they'll be retired immediately.
+    for (iree_host_size_t i = 0; i < wake_count; ++i) {
+      iree_wait_handle_t wake_handle = wake_handles[i];
+      if (iree_wait_handle_is_immediate(wake_handle)) {
+        // No-op wait - ignore.
+        IREE_TRACE_ZONE_APPEND_TEXT(z0, "nop");
+      } else if (wake_handle.type == poller->wake_event.type &&
+                 memcmp(&wake_handle.value, &poller->wake_event.value,
+                        sizeof(wake_handle.value)) == 0) {
+        // Woken on the wake_event used to exit the system wait early.
+        IREE_TRACE_ZONE_APPEND_TEXT(z0, "wake_event");
+      } else {
+        // Route to zero or more tasks using this handle.
+        IREE_TRACE_ZONE_APPEND_TEXT(z0, "task(s)");
+        iree_task_poller_wake_task(poller, wake_handle);
+      }
     }
   } else if (iree_status_is_deadline_exceeded(status)) {
     // Indicates nothing was woken within the deadline. We gracefully bail here
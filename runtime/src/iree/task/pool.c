@@ -21,6 +21,16 @@
 // wasting space in a larger bucket.
 #define IREE_TASK_POOL_BLOCK_ALIGNMENT (4 * 1024)
 
+// Returns the shard free list a released |task| should be pushed onto.
+// The shift keeps tasks allocated near each other (and thus likely to be
+// released near each other in time) on different shards while remaining a
+// stable mapping for any given task.
+static iree_atomic_task_slist_t* iree_task_pool_release_shard(
+    iree_task_pool_t* pool, iree_task_t* task) {
+  uintptr_t hash = (uintptr_t)task >> 8;
+  return &pool->available_slists[hash & (IREE_TASK_POOL_SHARD_COUNT - 1)];
+}
+
 // The minimum number of tasks that will be allocated when growth is needed.
 // The total number may be larger once rounded to meet block size and alignment
 // requirements. Note that we leave a bit of room here for the block header
@@ -105,7 +115,12 @@ static iree_status_t iree_task_pool_grow(iree_task_pool_t* pool,
   }
 
   // Concatenate the list of new free tasks into the pool.
-  iree_atomic_task_slist_concat(&pool->available_slist, head, tail);
+  // The whole block goes onto a single shard; it'll spread out across shards
+  // as tasks are released after use.
+  if (head) {
+    iree_atomic_task_slist_concat(iree_task_pool_release_shard(pool, head),
+                                  head, tail);
+  }
 
   IREE_TRACE_ZONE_END(z0);
   return iree_ok_status();
@@ -122,7 +137,11 @@ iree_status_t iree_task_pool_initialize(iree_allocator_t allocator,
   out_pool->allocator = allocator;
   out_pool->task_size = task_size;
   iree_atomic_task_allocation_slist_initialize(&out_pool->allocations_slist);
-  iree_atomic_task_slist_initialize(&out_pool->available_slist);
+  for (iree_host_size_t i = 0; i < IREE_TASK_POOL_SHARD_COUNT; ++i) {
+    iree_atomic_task_slist_initialize(&out_pool->available_slists[i]);
+  }
+  iree_atomic_store_int32(&out_pool->acquire_shard_cursor, 0,
+                          iree_memory_order_relaxed);
   iree_status_t status =
       iree_task_pool_grow(out_pool, initial_capacity, /*out_task=*/NULL);
 
@@ -145,7 +164,9 @@ void iree_task_pool_deinitialize(iree_task_pool_t* pool) {
     }
   }
   iree_atomic_task_allocation_slist_deinitialize(&pool->allocations_slist);
-  iree_atomic_task_slist_deinitialize(&pool->available_slist);
+  for (iree_host_size_t i = 0; i < IREE_TASK_POOL_SHARD_COUNT; ++i) {
+    iree_atomic_task_slist_deinitialize(&pool->available_slists[i]);
+  }
 
   IREE_TRACE_ZONE_END(z0);
 }
@@ -155,12 +176,14 @@ void iree_task_pool_trim(iree_task_pool_t* pool) {
   // NOTE: this is only safe if there are no outstanding tasks.
   // Hopefully the caller read the docstring!
 
-  // We only need to flush the list to empty it - these are just references into
-  // the allocations and don't need to be released.
-  iree_task_t* task_head = NULL;
-  iree_atomic_task_slist_flush(&pool->available_slist,
-                               IREE_ATOMIC_SLIST_FLUSH_ORDER_APPROXIMATE_LIFO,
-                               &task_head, /*tail=*/NULL);
+  // We only need to flush the lists to empty them - these are just references
+  // into the allocations and don't need to be released.
+  for (iree_host_size_t i = 0; i < IREE_TASK_POOL_SHARD_COUNT; ++i) {
+    iree_task_t* task_head = NULL;
+    iree_atomic_task_slist_flush(&pool->available_slists[i],
+                                 IREE_ATOMIC_SLIST_FLUSH_ORDER_APPROXIMATE_LIFO,
+                                 &task_head, /*tail=*/NULL);
+  }
 
   iree_task_allocation_header_t* allocation_head = NULL;
   if (iree_atomic_task_allocation_slist_flush(
@@ -182,11 +205,18 @@ iree_status_t iree_task_pool_acquire(iree_task_pool_t* pool,
                                      iree_task_t** out_task) {
   if (!pool) return iree_make_status(IREE_STATUS_RESOURCE_EXHAUSTED);
 
-  // Attempt to acquire a task from the available list.
-  iree_task_t* task = iree_atomic_task_slist_pop(&pool->available_slist);
-  if (task) {
-    *out_task = task;
-    return iree_ok_status();
+  // Attempt to acquire a task from one of the available shard lists, starting
+  // at a rotating cursor so concurrent acquirers spread out across shards.
+  uint32_t shard_base = (uint32_t)iree_atomic_fetch_add_int32(
+      &pool->acquire_shard_cursor, 1, iree_memory_order_relaxed);
+  for (iree_host_size_t i = 0; i < IREE_TASK_POOL_SHARD_COUNT; ++i) {
+    iree_task_t* task = iree_atomic_task_slist_pop(
+        &pool->available_slists[(shard_base + i) &
+                                (IREE_TASK_POOL_SHARD_COUNT - 1)]);
+    if (task) {
+      *out_task = task;
+      return iree_ok_status();
+    }
   }
 
   // No tasks were available when we tried; force growth now.
@@ -210,8 +240,9 @@ iree_status_t iree_task_pool_acquire_many(iree_task_pool_t* pool,
   iree_task_list_initialize(out_list);
 
   iree_status_t status = iree_ok_status();
+  iree_host_size_t flush_shard = 0;
   while (count) {
-    // Flush the entire available list so we can start operating on it.
+    // Flush an entire available shard list so we can start operating on it.
     // This is where the potential race comes in: if another thread goes to
     // acquire a task while we have the list local here it'll grow the list so
     // it can meet its demand. That's still correct behavior but will result in
@@ -221,8 +252,9 @@ iree_status_t iree_task_pool_acquire_many(iree_task_pool_t* pool,
     // not the end of the world.
     iree_task_list_t acquired_tasks;
     iree_task_list_initialize(&acquired_tasks);
-    if (iree_atomic_task_slist_flush(
-            &pool->available_slist,
+    if (flush_shard < IREE_TASK_POOL_SHARD_COUNT &&
+        iree_atomic_task_slist_flush(
+            &pool->available_slists[flush_shard],
             IREE_ATOMIC_SLIST_FLUSH_ORDER_APPROXIMATE_LIFO,
             &acquired_tasks.head,
             /*tail=*/NULL)) {
@@ -263,22 +295,29 @@ iree_status_t iree_task_pool_acquire_many(iree_task_pool_t* pool,
       iree_task_list_prepend(out_list, &acquired_tasks);
     }
 
-    // If we still need more tasks but ran out of ones in the flush list then we
-    // need to grow some more.
+    // If we still need more tasks try the next shard and, once all shards
+    // have been drained, grow some more.
     if (count > 0) {
+      if (++flush_shard < IREE_TASK_POOL_SHARD_COUNT) continue;
       status = iree_task_pool_grow(pool, count, /*out_task=*/NULL);
       if (IREE_UNLIKELY(!iree_status_is_ok(status))) break;
+      flush_shard = 0;
     }
   }
 
   // Return leftovers that we acquired but didn't need to the pool.
-  iree_atomic_task_slist_concat(&pool->available_slist, leftover_tasks.head,
-                                leftover_tasks.tail);
+  if (!iree_task_list_is_empty(&leftover_tasks)) {
+    iree_atomic_task_slist_concat(
+        iree_task_pool_release_shard(pool, leftover_tasks.head),
+        leftover_tasks.head, leftover_tasks.tail);
+  }
 
   // Upon failure return any tasks we may have already acquired from the pool.
-  if (IREE_UNLIKELY(!iree_status_is_ok(status))) {
-    iree_atomic_task_slist_concat(&pool->available_slist, out_list->head,
-                                  out_list->tail);
+  if (IREE_UNLIKELY(!iree_status_is_ok(status)) &&
+      !iree_task_list_is_empty(out_list)) {
+    iree_atomic_task_slist_concat(
+        iree_task_pool_release_shard(pool, out_list->head), out_list->head,
+        out_list->tail);
   }
 
   return status;
@@ -287,5 +326,5 @@ iree_status_t iree_task_pool_acquire_many(iree_task_pool_t* pool,
 void iree_task_pool_release(iree_task_pool_t* pool, iree_task_t* task) {
   if (!pool) return;
   IREE_ASSERT_EQ(task->pool, pool);
-  iree_atomic_task_slist_push(&pool->available_slist, task);
+  iree_atomic_task_slist_push(iree_task_pool_release_shard(pool, task), task);
 }
@@ -32,6 +32,12 @@ IREE_TYPED_ATOMIC_SLIST_WRAPPER(iree_atomic_task_allocation,
                                 iree_task_allocation_header_t,
                                 offsetof(iree_task_allocation_header_t, next));
 
+// Number of independent free lists the available tasks are spread across.
+// Workers releasing tasks hash to a shard so that concurrent releases from
+// many workers don't all contend on a single atomic slist head. Must be a
+// power of two.
+#define IREE_TASK_POOL_SHARD_COUNT 4
+
 // Shared thread-safe pool of iree_task_t structures of a particular size.
 // This can be used to quickly allocate blocks of tasks to be initialized by
 // task producers, enqueued, and then eventually recycled back to the pool.
@@ -59,15 +65,22 @@ typedef struct iree_task_pool_t {
   // Head of a linked list of all allocations made by the pool.
   iree_atomic_task_allocation_slist_t allocations_slist;
 
-  // Linked list of free tasks used as a stack (LIFO).
-  // This is not a great structure for this as over time the tasks will get out
-  // of order and walking the linked list will incur cache misses. We offset
-  // that cost a bit by knowing that the time between walking the list to
+  // Sharded linked lists of free tasks each used as a stack (LIFO).
+  // These are not great structures for this as over time the tasks will get
+  // out of order and walking the linked lists will incur cache misses. We
+  // offset that cost a bit by knowing that the time between walking a list to
   // acquire tasks and when we initialize the tasks is short and that we would
   // have triggered a cache miss anyway. In the future we can explore other
   // approaches (such as small chunked linear lists) that better exploit spatial
   // locality, if needed.
-  iree_atomic_task_slist_t available_slist;
+  //
+  // Releases hash the task address to a shard so that tasks from the same
+  // allocation block tend to cluster while concurrent releases from many
+  // workers spread across list heads instead of pounding on one.
+  iree_atomic_task_slist_t available_slists[IREE_TASK_POOL_SHARD_COUNT];
+
+  // Rotates the shard acquisition starts from so acquirers spread out too.
+  iree_atomic_int32_t acquire_shard_cursor;
 } iree_task_pool_t;
 
 // Initializes a task pool and optionally performs an initial task allocation.
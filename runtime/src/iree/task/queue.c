@@ -9,10 +9,21 @@
 #include <stddef.h>
 #include <string.h>
 
+// Adjusts the approximate depth hint by |delta| tasks.
+// Must be called with the queue lock held so the hint tracks the list; reads
+// may happen from any thread without the lock.
+static void iree_task_queue_adjust_depth(iree_task_queue_t* queue,
+                                         int32_t delta) {
+  iree_atomic_fetch_add_int32(&queue->approx_depth, delta,
+                              iree_memory_order_relaxed);
+}
+
 void iree_task_queue_initialize(iree_task_queue_t* out_queue) {
   memset(out_queue, 0, sizeof(*out_queue));
   iree_slim_mutex_initialize(&out_queue->mutex);
   iree_task_list_initialize(&out_queue->list);
+  iree_atomic_store_int32(&out_queue->approx_depth, 0,
+                          iree_memory_order_relaxed);
 }
 
 void iree_task_queue_deinitialize(iree_task_queue_t* queue) {
@@ -27,9 +38,16 @@ bool iree_task_queue_is_empty(iree_task_queue_t* queue) {
   return is_empty;
 }
 
+iree_host_size_t iree_task_queue_approx_depth(iree_task_queue_t* queue) {
+  int32_t depth =
+      iree_atomic_load_int32(&queue->approx_depth, iree_memory_order_relaxed);
+  return depth > 0 ? (iree_host_size_t)depth : 0;
+}
+
 void iree_task_queue_push_front(iree_task_queue_t* queue, iree_task_t* task) {
   iree_slim_mutex_lock(&queue->mutex);
   iree_task_list_push_front(&queue->list, task);
+  iree_task_queue_adjust_depth(queue, 1);
   iree_slim_mutex_unlock(&queue->mutex);
 }
 
@@ -37,8 +55,11 @@ void iree_task_queue_append_from_lifo_list_unsafe(iree_task_queue_t* queue,
                                                   iree_task_list_t* list) {
   // NOTE: reversing the list outside of the lock.
   iree_task_list_reverse(list);
+  // The list was just walked for the reversal and should be hot in cache.
+  iree_host_size_t list_size = iree_task_list_calculate_size(list);
   iree_slim_mutex_lock(&queue->mutex);
   iree_task_list_append(&queue->list, list);
+  iree_task_queue_adjust_depth(queue, (int32_t)list_size);
   iree_slim_mutex_unlock(&queue->mutex);
 }
 
@@ -52,10 +73,16 @@ iree_task_t* iree_task_queue_flush_from_lifo_slist(
       source_slist, IREE_ATOMIC_SLIST_FLUSH_ORDER_APPROXIMATE_FIFO,
       &suffix.head, &suffix.tail);
 
+  // Count outside of the lock; the flush just walked the list so it's hot.
+  iree_host_size_t suffix_size =
+      did_flush ? iree_task_list_calculate_size(&suffix) : 0;
+
   // Append the tasks and pop off the front for return.
   iree_slim_mutex_lock(&queue->mutex);
   if (did_flush) iree_task_list_append(&queue->list, &suffix);
   iree_task_t* next_task = iree_task_list_pop_front(&queue->list);
+  iree_task_queue_adjust_depth(
+      queue, (int32_t)suffix_size + (next_task ? -1 : 0));
   iree_slim_mutex_unlock(&queue->mutex);
 
   return next_task;
@@ -64,6 +91,7 @@ iree_task_t* iree_task_queue_flush_from_lifo_slist(
 iree_task_t* iree_task_queue_pop_front(iree_task_queue_t* queue) {
   iree_slim_mutex_lock(&queue->mutex);
   iree_task_t* next_task = iree_task_list_pop_front(&queue->list);
+  if (next_task) iree_task_queue_adjust_depth(queue, -1);
   iree_slim_mutex_unlock(&queue->mutex);
   return next_task;
 }
@@ -74,8 +102,12 @@ iree_task_t* iree_task_queue_try_steal(iree_task_queue_t* source_queue,
   // First attempt to steal up to max_tasks from the source queue.
   iree_task_list_t stolen_tasks;
   iree_task_list_initialize(&stolen_tasks);
+  iree_host_size_t stolen_count = 0;
   if (iree_slim_mutex_try_lock(&source_queue->mutex)) {
     iree_task_list_split(&source_queue->list, max_tasks, &stolen_tasks);
+    // Stolen chunks are bounded by max_tasks so the count walk is small.
+    stolen_count = iree_task_list_calculate_size(&stolen_tasks);
+    iree_task_queue_adjust_depth(source_queue, -(int32_t)stolen_count);
     iree_slim_mutex_unlock(&source_queue->mutex);
   }
 
@@ -85,6 +117,8 @@ iree_task_t* iree_task_queue_try_steal(iree_task_queue_t* source_queue,
     iree_slim_mutex_lock(&target_queue->mutex);
     iree_task_list_append(&target_queue->list, &stolen_tasks);
     next_task = iree_task_list_pop_front(&target_queue->list);
+    iree_task_queue_adjust_depth(
+        target_queue, (int32_t)stolen_count + (next_task ? -1 : 0));
     iree_slim_mutex_unlock(&target_queue->mutex);
   }
   return next_task;
@@ -108,6 +108,12 @@ typedef struct iree_task_queue_t {
 
   // FIFO task list.
   iree_task_list_t list IREE_GUARDED_BY(mutex);
+
+  // Approximate number of tasks in the queue maintained alongside the list.
+  // Readable from any thread without the lock held; used by thieves to pick
+  // richer victims. Always stale by the time anyone acts on it - treat it as
+  // a load-balancing hint only.
+  iree_atomic_int32_t approx_depth;
 } iree_task_queue_t;
 
 // Initializes a work-stealing task queue in-place.
@@ -121,6 +127,11 @@ void iree_task_queue_deinitialize(iree_task_queue_t* queue);
 // Note that due to races this may return both false-positives and -negatives.
 bool iree_task_queue_is_empty(iree_task_queue_t* queue);
 
+// Returns the approximate number of tasks in the queue without taking the
+// queue lock. The value may be stale the moment it is returned and must only
+// be used as a scheduling hint (such as when selecting theft victims).
+iree_host_size_t iree_task_queue_approx_depth(iree_task_queue_t* queue);
+
 // Pushes a task to the front of the queue.
 // Always prefer the multi-push variants (prepend/append) when adding more than
 // one task to the queue. This is mostly useful for exceptional cases such as
@@ -68,6 +68,27 @@ TEST(QueueTest, PushPop) {
   iree_task_queue_deinitialize(&queue);
 }
 
+TEST(QueueTest, ApproxDepth) {
+  iree_task_queue_t queue;
+  iree_task_queue_initialize(&queue);
+  EXPECT_EQ(0u, iree_task_queue_approx_depth(&queue));
+
+  iree_task_t task_a = {0};
+  iree_task_queue_push_front(&queue, &task_a);
+  EXPECT_EQ(1u, iree_task_queue_approx_depth(&queue));
+
+  iree_task_t task_b = {0};
+  iree_task_queue_push_front(&queue, &task_b);
+  EXPECT_EQ(2u, iree_task_queue_approx_depth(&queue));
+
+  EXPECT_EQ(&task_b, iree_task_queue_pop_front(&queue));
+  EXPECT_EQ(1u, iree_task_queue_approx_depth(&queue));
+  EXPECT_EQ(&task_a, iree_task_queue_pop_front(&queue));
+  EXPECT_EQ(0u, iree_task_queue_approx_depth(&queue));
+
+  iree_task_queue_deinitialize(&queue);
+}
+
 TEST(QueueTest, AppendListEmpty) {
   iree_task_queue_t queue;
   iree_task_queue_initialize(&queue);
@@ -11,6 +11,7 @@
 
 #include "iree/base/api.h"
 #include "iree/base/internal/threading.h"
+#include "iree/task/tuning.h"
 
 void iree_task_scope_initialize(iree_string_view_t name,
                                 iree_task_scope_flags_t flags,
@@ -26,6 +27,11 @@ void iree_task_scope_initialize(iree_string_view_t name,
   out_scope->name[name_length] = 0;
 
   out_scope->flags = flags;
+  iree_atomic_store_int32(&out_scope->priority_class,
+                          IREE_TASK_PRIORITY_CLASS_NORMAL,
+                          iree_memory_order_relaxed);
+  iree_atomic_store_int64(&out_scope->deadline_ns, IREE_TIME_INFINITE_FUTURE,
+                          iree_memory_order_relaxed);
 
   // TODO(benvanik): pick trace colors based on name hash.
   IREE_TRACE(out_scope->task_trace_color = 0xFFFF0000u);
@@ -66,6 +72,35 @@ iree_string_view_t iree_task_scope_name(iree_task_scope_t* scope) {
   return iree_make_cstring_view(scope->name);
 }
 
+void iree_task_scope_set_priority_class(
+    iree_task_scope_t* scope, iree_task_priority_class_t priority_class) {
+  iree_atomic_store_int32(&scope->priority_class, priority_class,
+                          iree_memory_order_relaxed);
+}
+
+void iree_task_scope_set_deadline(iree_task_scope_t* scope,
+                                  iree_time_t deadline_ns) {
+  iree_atomic_store_int64(&scope->deadline_ns, deadline_ns,
+                          iree_memory_order_relaxed);
+}
+
+iree_task_priority_class_t iree_task_scope_effective_priority_class(
+    iree_task_scope_t* scope, iree_time_t now_ns) {
+  iree_task_priority_class_t priority_class =
+      (iree_task_priority_class_t)iree_atomic_load_int32(
+          &scope->priority_class, iree_memory_order_relaxed);
+  if (priority_class >= IREE_TASK_PRIORITY_CLASS_HIGH) return priority_class;
+  iree_time_t deadline_ns = (iree_time_t)iree_atomic_load_int64(
+      &scope->deadline_ns, iree_memory_order_relaxed);
+  if (deadline_ns != IREE_TIME_INFINITE_FUTURE &&
+      now_ns + IREE_TASK_SCOPE_DEADLINE_BOOST_MARGIN_NS >= deadline_ns) {
+    // Nearing (or past) the deadline: boost so remaining work issues ahead of
+    // normal-class scopes.
+    return IREE_TASK_PRIORITY_CLASS_HIGH;
+  }
+  return priority_class;
+}
+
 iree_task_dispatch_statistics_t iree_task_scope_consume_statistics(
     iree_task_scope_t* scope) {
   iree_task_dispatch_statistics_t result = scope->dispatch_statistics;
@@ -147,7 +182,16 @@ void iree_task_scope_begin(iree_task_scope_t* scope) {
 void iree_task_scope_end(iree_task_scope_t* scope) {
   if (iree_atomic_ref_count_dec(&scope->pending_submissions) == 1) {
     // All submissions have completed in this scope - notify any waiters.
-    iree_notification_post(&scope->idle_notification, IREE_ALL_WAITERS);
+    // The fence pairs with the one in iree_task_scope_wait_idle: either we
+    // observe a registered waiter here and post or the waiter observes the
+    // counter hitting zero after its fence and never blocks. Skipping the
+    // post when unobserved keeps completing tasks wait-free as they never
+    // touch the shared notification state.
+    iree_atomic_thread_fence(iree_memory_order_seq_cst);
+    if (iree_atomic_load_int32(&scope->idle_waiter_count,
+                               iree_memory_order_relaxed) != 0) {
+      iree_notification_post(&scope->idle_notification, IREE_ALL_WAITERS);
+    }
     iree_atomic_store_int32(&scope->pending_idle_notification_posts, 0,
                             iree_memory_order_release);
   }
@@ -157,25 +201,43 @@ bool iree_task_scope_is_idle(iree_task_scope_t* scope) {
   return (iree_atomic_ref_count_load(&scope->pending_submissions) == 0);
 }
 
+iree_host_size_t iree_task_scope_pending_submission_count(
+    iree_task_scope_t* scope) {
+  return (iree_host_size_t)iree_atomic_ref_count_load(
+      &scope->pending_submissions);
+}
+
 iree_status_t iree_task_scope_wait_idle(iree_task_scope_t* scope,
                                         iree_time_t deadline_ns) {
   IREE_TRACE_ZONE_BEGIN(z0);
 
   iree_status_t status = iree_ok_status();
-  if (deadline_ns == IREE_TIME_INFINITE_PAST) {
-    // Polling for idle.
-    if (iree_task_scope_is_idle(scope)) {
-      status = iree_ok_status();
-    } else {
-      status = iree_status_from_code(IREE_STATUS_DEADLINE_EXCEEDED);
-    }
+  if (iree_task_scope_is_idle(scope)) {
+    // Fast path: already idle. The acquire load in the idle check pairs with
+    // the release decrement performed by the completing submission making all
+    // task effects visible without any further synchronization - common in
+    // submit-wait-submit patterns where the wait lands after completion.
+  } else if (deadline_ns == IREE_TIME_INFINITE_PAST) {
+    // Polling for idle and not idle yet.
+    status = iree_status_from_code(IREE_STATUS_DEADLINE_EXCEEDED);
   } else {
+    // Register as a waiter so completing submissions know a wake is required;
+    // see iree_task_scope_end for the pairing fence. The registration must
+    // land before the idle recheck inside the await or a concurrent
+    // transition to idle could miss us and leave us blocked forever.
+    iree_atomic_fetch_add_int32(&scope->idle_waiter_count, 1,
+                                iree_memory_order_relaxed);
+    iree_atomic_thread_fence(iree_memory_order_seq_cst);
+
     // Wait for the scope to enter the idle state.
     if (!iree_notification_await(&scope->idle_notification,
                                  (iree_condition_fn_t)iree_task_scope_is_idle,
                                  scope, iree_make_deadline(deadline_ns))) {
       status = iree_status_from_code(IREE_STATUS_DEADLINE_EXCEEDED);
     }
+
+    iree_atomic_fetch_sub_int32(&scope->idle_waiter_count, 1,
+                                iree_memory_order_relaxed);
   }
 
   IREE_TRACE_ZONE_END(z0);
@@ -19,6 +19,21 @@
 extern "C" {
 #endif  // __cplusplus
 
+// Scheduling class used to order ready tasks of competing scopes.
+// Coordinators issue ready tasks of higher classes to workers before lower
+// ones; tasks within a class retain their submission order. This is a
+// coarse knob: it does not preempt in-flight tasks and starvation of lower
+// classes is possible if higher classes keep the executor saturated.
+typedef enum iree_task_priority_class_e {
+  // Background work only scheduled when nothing else is ready.
+  IREE_TASK_PRIORITY_CLASS_IDLE = 0,
+  // Default class for all scopes.
+  IREE_TASK_PRIORITY_CLASS_NORMAL = 1,
+  // Latency-sensitive work issued ahead of normal work.
+  IREE_TASK_PRIORITY_CLASS_HIGH = 2,
+  IREE_TASK_PRIORITY_CLASS_COUNT = 3,
+} iree_task_priority_class_t;
+
 enum iree_task_scope_flag_bits_e {
   IREE_TASK_SCOPE_FLAG_NONE = 0u,
   // Calls iree_status_abort on the first failure within the scope.
@@ -64,6 +79,16 @@ typedef struct iree_task_scope_t {
   // The color will be modulated based on task type.
   IREE_TRACE(uint32_t task_trace_color;)
 
+  // Scheduling class (iree_task_priority_class_t) used to order ready tasks
+  // of this scope against those of other scopes.
+  iree_atomic_int32_t priority_class;
+
+  // Optional absolute deadline for pending work in the scope.
+  // Scopes nearing (or past) their deadline are temporarily boosted to the
+  // high priority class during scheduling. IREE_TIME_INFINITE_FUTURE when
+  // unset.
+  iree_atomic_int64_t deadline_ns;
+
   // A permanent status code set when a task within the scope fails. All pending
   // tasks will be aborted, though any in-flight tasks may continue executing
   // to completion.
@@ -84,6 +109,11 @@ typedef struct iree_task_scope_t {
   // tasks or completes all pending tasks after a failure.
   iree_notification_t idle_notification;
   iree_atomic_int32_t pending_idle_notification_posts;
+
+  // Number of threads currently blocked in iree_task_scope_wait_idle.
+  // Completing submissions only touch the idle notification when non-zero
+  // keeping the transition to idle wait-free in the common unobserved case.
+  iree_atomic_int32_t idle_waiter_count;
 } iree_task_scope_t;
 
 // Initializes a caller-allocated scope.
@@ -101,6 +131,25 @@ void iree_task_scope_deinitialize(iree_task_scope_t* scope);
 // string.
 iree_string_view_t iree_task_scope_name(iree_task_scope_t* scope);
 
+// Sets the scheduling class used to order ready tasks of this scope against
+// those of other scopes. Takes effect the next time the coordinator runs;
+// already-issued tasks are unaffected.
+void iree_task_scope_set_priority_class(
+    iree_task_scope_t* scope, iree_task_priority_class_t priority_class);
+
+// Sets an absolute deadline for pending work in the scope (or
+// IREE_TIME_INFINITE_FUTURE to clear). Scopes nearing or past their deadline
+// are boosted to IREE_TASK_PRIORITY_CLASS_HIGH during scheduling. This is a
+// best-effort hint: deadlines are not enforced and expired work is not
+// cancelled.
+void iree_task_scope_set_deadline(iree_task_scope_t* scope,
+                                  iree_time_t deadline_ns);
+
+// Returns the priority class that should be used for scheduling tasks of the
+// scope at time |now_ns|, including any deadline boost.
+iree_task_priority_class_t iree_task_scope_effective_priority_class(
+    iree_task_scope_t* scope, iree_time_t now_ns);
+
 // Returns and resets the statistics for the scope.
 // Statistics may experience tearing (non-atomic update across fields) if this
 // is performed while tasks are in-flight.
@@ -159,6 +208,12 @@ void iree_task_scope_end(iree_task_scope_t* scope);
 // iree_task_scope_is_idle has returned.
 bool iree_task_scope_is_idle(iree_task_scope_t* scope);
 
+// Returns the number of submissions still pending within the scope.
+// Intended for monitoring; the value may change concurrently and must not be
+// used for synchronization (see iree_task_scope_wait_idle for that).
+iree_host_size_t iree_task_scope_pending_submission_count(
+    iree_task_scope_t* scope);
+
 // Waits for the scope to become idle indicating that all pending and in-flight
 // tasks have completed. If the scope is aborted or marked for permanent failure
 // then the wait will only return after it is guaranteed no more tasks will ever
@@ -43,6 +43,21 @@ void iree_task_set_completion_task(iree_task_t* task,
                               iree_memory_order_acq_rel);
 }
 
+// Joins |count| completed dependency edges into |task| and returns true if
+// that satisfied the last outstanding dependency and the task is now ready.
+// The decrement uses release ordering with an acquire fence taken only by the
+// final joiner: wide fan-ins (all shards of a dispatch, all tasks feeding a
+// barrier) hammer the same counter from many workers at once and the non-final
+// joins don't need to pay for a full acq_rel RMW on weakly-ordered machines.
+static bool iree_task_complete_dependencies(iree_task_t* task, int32_t count) {
+  if (iree_atomic_fetch_sub_int32(&task->pending_dependency_count, count,
+                                  iree_memory_order_release) != count) {
+    return false;
+  }
+  iree_atomic_thread_fence(iree_memory_order_acquire);
+  return true;
+}
+
 bool iree_task_is_ready(iree_task_t* task) {
   if (iree_atomic_load_int32(&task->pending_dependency_count,
                              iree_memory_order_acquire) > 0) {
@@ -109,9 +124,7 @@ void iree_task_discard(iree_task_t* task, iree_task_list_t* discard_worklist) {
   // dependent tasks (like barriers) that will be handled below.
   const bool completion_task_ready =
       task->completion_task &&
-      iree_atomic_fetch_sub_int32(
-          &task->completion_task->pending_dependency_count, 1,
-          iree_memory_order_acq_rel) == 1;
+      iree_task_complete_dependencies(task->completion_task, 1);
   if (completion_task_ready) {
     iree_task_list_push_back(discard_worklist, task->completion_task);
   }
@@ -158,9 +171,7 @@ static void iree_task_retire(iree_task_t* task,
     // Task completed successfully.
     iree_task_cleanup(task, IREE_STATUS_OK);
     bool completion_task_ready =
-        completion_task &&
-        iree_atomic_fetch_sub_int32(&completion_task->pending_dependency_count,
-                                    1, iree_memory_order_acq_rel) == 1;
+        completion_task && iree_task_complete_dependencies(completion_task, 1);
     if (completion_task_ready) {
       // This was the last pending dependency and the completion task is ready
       // to run.
@@ -179,9 +190,7 @@ static void iree_task_retire(iree_task_t* task,
     iree_task_cleanup(task, IREE_STATUS_ABORTED);
 
     bool completion_task_ready =
-        completion_task &&
-        iree_atomic_fetch_sub_int32(&completion_task->pending_dependency_count,
-                                    1, iree_memory_order_acq_rel) == 1;
+        completion_task && iree_task_complete_dependencies(completion_task, 1);
     if (completion_task_ready) {
       // This was the last pending dependency and we know that we can safely
       // abort the completion task by discarding.
@@ -286,6 +295,23 @@ void iree_task_call_execute(iree_task_call_t* task,
 // IREE_TASK_TYPE_BARRIER
 //==============================================================================
 
+// Adds one pending dependency per barrier edge to each dependent task.
+// Runs of the same dependent are coalesced into a single increment to match
+// the coalesced decrements performed when the barrier retires.
+static void iree_task_barrier_add_dependency_counts(iree_task_barrier_t* task) {
+  for (iree_host_size_t i = 0; i < task->dependent_task_count;) {
+    iree_task_t* dependent_task = task->dependent_tasks[i];
+    int32_t edge_count = 1;
+    while (i + edge_count < task->dependent_task_count &&
+           task->dependent_tasks[i + edge_count] == dependent_task) {
+      ++edge_count;
+    }
+    i += edge_count;
+    iree_atomic_fetch_add_int32(&dependent_task->pending_dependency_count,
+                                edge_count, iree_memory_order_acq_rel);
+  }
+}
+
 void iree_task_barrier_initialize(iree_task_scope_t* scope,
                                   iree_host_size_t dependent_task_count,
                                   iree_task_t* const* dependent_tasks,
@@ -293,11 +319,7 @@ void iree_task_barrier_initialize(iree_task_scope_t* scope,
   iree_task_initialize(IREE_TASK_TYPE_BARRIER, scope, &out_task->header);
   out_task->dependent_task_count = dependent_task_count;
   out_task->dependent_tasks = dependent_tasks;
-  for (iree_host_size_t i = 0; i < out_task->dependent_task_count; ++i) {
-    iree_task_t* dependent_task = out_task->dependent_tasks[i];
-    iree_atomic_fetch_add_int32(&dependent_task->pending_dependency_count, 1,
-                                iree_memory_order_acq_rel);
-  }
+  iree_task_barrier_add_dependency_counts(out_task);
 }
 
 void iree_task_barrier_initialize_empty(iree_task_scope_t* scope,
@@ -312,11 +334,7 @@ void iree_task_barrier_set_dependent_tasks(
     iree_task_t* const* dependent_tasks) {
   task->dependent_task_count = dependent_task_count;
   task->dependent_tasks = dependent_tasks;
-  for (iree_host_size_t i = 0; i < task->dependent_task_count; ++i) {
-    iree_task_t* dependent_task = task->dependent_tasks[i];
-    iree_atomic_fetch_add_int32(&dependent_task->pending_dependency_count, 1,
-                                iree_memory_order_acq_rel);
-  }
+  iree_task_barrier_add_dependency_counts(task);
 }
 
 static void iree_task_barrier_discard(iree_task_barrier_t* task,
@@ -326,12 +344,17 @@ static void iree_task_barrier_discard(iree_task_barrier_t* task,
   // Discard all of the tasks after the barrier.
   // Note that we need to ensure we only enqueue them for discard after all of
   // their dependencies have been met - otherwise we'll double-discard.
-  for (iree_host_size_t i = 0; i < task->dependent_task_count; ++i) {
+  // Runs of the same dependent (multiple barrier edges to one task) are
+  // coalesced into a single decrement.
+  for (iree_host_size_t i = 0; i < task->dependent_task_count;) {
     iree_task_t* dependent_task = task->dependent_tasks[i];
-    const bool dependent_task_ready =
-        iree_atomic_fetch_sub_int32(&dependent_task->pending_dependency_count,
-                                    1, iree_memory_order_acq_rel) == 1;
-    if (dependent_task_ready) {
+    int32_t edge_count = 1;
+    while (i + edge_count < task->dependent_task_count &&
+           task->dependent_tasks[i + edge_count] == dependent_task) {
+      ++edge_count;
+    }
+    i += edge_count;
+    if (iree_task_complete_dependencies(dependent_task, edge_count)) {
       // The dependent task has retired and can now be discard.
       iree_task_list_push_back(discard_worklist, dependent_task);
     }
@@ -345,11 +368,18 @@ void iree_task_barrier_retire(iree_task_barrier_t* task,
   IREE_TRACE_ZONE_BEGIN(z0);
 
   // NOTE: we walk in reverse so that we enqueue in LIFO order.
-  for (iree_host_size_t i = 0; i < task->dependent_task_count; ++i) {
-    iree_task_t* dependent_task =
-        task->dependent_tasks[task->dependent_task_count - i - 1];
-    if (iree_atomic_fetch_sub_int32(&dependent_task->pending_dependency_count,
-                                    1, iree_memory_order_acq_rel) == 1) {
+  // Runs of the same dependent (multiple barrier edges to one task) are
+  // coalesced into a single decrement to keep wide fan-ins from turning into
+  // one atomic RMW per edge.
+  for (iree_host_size_t i = task->dependent_task_count; i > 0;) {
+    iree_task_t* dependent_task = task->dependent_tasks[i - 1];
+    int32_t edge_count = 1;
+    while (i - edge_count > 0 &&
+           task->dependent_tasks[i - edge_count - 1] == dependent_task) {
+      ++edge_count;
+    }
+    i -= edge_count;
+    if (iree_task_complete_dependencies(dependent_task, edge_count)) {
       // The dependent task has retired and can now be made ready.
       iree_task_submission_enqueue(pending_submission, dependent_task);
     }
@@ -426,6 +456,20 @@ void iree_task_wait_set_wait_any(iree_task_wait_t* task,
   task->cancellation_flag = cancellation_flag;
 }
 
+void iree_task_call_yield_until(iree_task_call_t* task,
+                                iree_wait_source_t wait_source,
+                                iree_time_t deadline_ns,
+                                iree_task_wait_t* wait_task,
+                                iree_task_submission_t* pending_submission) {
+  // The wait blocks the call from retiring; when the wait retires the call's
+  // dependency count returns to zero and it is posted back to a worker for
+  // another pass through its closure (the same mechanism nested tasks use).
+  iree_task_wait_initialize(task->header.scope, wait_source, deadline_ns,
+                            wait_task);
+  iree_task_set_completion_task(&wait_task->header, &task->header);
+  iree_task_submission_enqueue(pending_submission, &wait_task->header);
+}
+
 void iree_task_wait_retire(iree_task_wait_t* task,
                            iree_task_submission_t* pending_submission,
                            iree_status_t status) {
@@ -530,6 +574,10 @@ static void iree_task_dispatch_initialize_base(
   memcpy(out_task->workgroup_size, workgroup_size,
          sizeof(out_task->workgroup_size));
   out_task->local_memory_size = 0;
+  memset(&out_task->reduction_closure, 0, sizeof(out_task->reduction_closure));
+  out_task->reduction_accumulator_size = 0;
+  out_task->reduction_slot_count = 0;
+  out_task->reduction_storage = iree_byte_span_empty();
   iree_atomic_store_intptr(&out_task->status, 0, iree_memory_order_release);
   memset(&out_task->statistics, 0, sizeof(out_task->statistics));
 
@@ -559,6 +607,21 @@ void iree_task_dispatch_initialize_indirect(
   out_task->workgroup_count.ptr = workgroup_count_ptr;
 }
 
+void iree_task_dispatch_set_reduction(iree_task_dispatch_t* dispatch_task,
+                                      iree_task_reduction_closure_t closure,
+                                      iree_host_size_t accumulator_size,
+                                      iree_byte_span_t storage) {
+  dispatch_task->reduction_closure = closure;
+  dispatch_task->reduction_accumulator_size = (uint32_t)accumulator_size;
+  // Derive the slot count from the storage provided; shards verify at
+  // execution time that their worker has a slot available so that callers
+  // sizing for the wrong executor fail loudly instead of aliasing slots.
+  dispatch_task->reduction_slot_count =
+      (uint32_t)(storage.data_length /
+                 iree_task_reduction_slot_stride(accumulator_size));
+  dispatch_task->reduction_storage = storage;
+}
+
 void iree_task_dispatch_issue(iree_task_dispatch_t* dispatch_task,
                               iree_task_pool_t* shard_task_pool,
                               iree_task_submission_t* pending_submission,
@@ -619,6 +682,7 @@ void iree_task_dispatch_issue(iree_task_dispatch_t* dispatch_task,
     dispatch_task->tiles_per_reservation =
         IREE_TASK_DISPATCH_MAX_TILES_PER_SHARD_RESERVATION;
   }
+  dispatch_task->shard_count = (uint32_t)iree_max(1, shard_count);
 
   // Randomize starting worker.
   iree_host_size_t worker_offset = iree_task_post_batch_select_worker(
@@ -675,6 +739,27 @@ void iree_task_dispatch_retire(iree_task_dispatch_t* dispatch_task,
   iree_status_t status = (iree_status_t)iree_atomic_exchange_intptr(
       &dispatch_task->status, 0, iree_memory_order_acq_rel);
 
+  // Fold all per-worker reduction accumulator slots into slot 0 now that all
+  // shards have joined. The fold is linear as slot counts are bounded by the
+  // worker count and combiners are tiny; retire runs on a single worker so no
+  // synchronization is required. Slots of workers that stole no tiles still
+  // hold the caller-provided identity value and fold harmlessly.
+  if (iree_status_is_ok(status) && dispatch_task->reduction_closure.fn) {
+    const iree_host_size_t slot_stride = iree_task_reduction_slot_stride(
+        dispatch_task->reduction_accumulator_size);
+    iree_byte_span_t target_slot =
+        iree_make_byte_span(dispatch_task->reduction_storage.data,
+                            dispatch_task->reduction_accumulator_size);
+    for (uint32_t i = 1; i < dispatch_task->reduction_slot_count; ++i) {
+      status = dispatch_task->reduction_closure.fn(
+          dispatch_task->reduction_closure.user_context, target_slot,
+          iree_make_const_byte_span(
+              dispatch_task->reduction_storage.data + i * slot_stride,
+              dispatch_task->reduction_accumulator_size));
+      if (!iree_status_is_ok(status)) break;
+    }
+  }
+
   iree_task_retire(&dispatch_task->header, pending_submission, status);
   IREE_TRACE_ZONE_END(z0);
 }
@@ -709,6 +794,39 @@ iree_task_dispatch_shard_t* iree_task_dispatch_shard_allocate(
   return shard_task;
 }
 
+// Reserves the next slice of tiles from the dispatch grid for a shard.
+// Returns the base tile index of the slice and stores its length in
+// |out_slice_length| (0 when the grid has been exhausted).
+//
+// Slices are sized proportionally to the tiles remaining: while the grid is
+// full shards take tiles_per_reservation at a time for low overhead and good
+// locality and as it drains the slices shrink down to single tiles so that the
+// last few (potentially expensive) tiles can be spread across all shards
+// instead of being stuck behind whichever shard reserved them first.
+static uint32_t iree_task_dispatch_shard_reserve_tiles(
+    iree_task_dispatch_t* dispatch_task, uint32_t* out_slice_length) {
+  const uint32_t tile_count = dispatch_task->tile_count;
+  // relaxed order because we only care about atomic reservations, not about
+  // ordering of tile_index accesses w.r.t. other memory accesses.
+  uint32_t tile_base = iree_atomic_load_int32(&dispatch_task->tile_index,
+                                              iree_memory_order_relaxed);
+  uint32_t slice_length = 0;
+  do {
+    if (tile_base >= tile_count) {
+      *out_slice_length = 0;
+      return tile_count;
+    }
+    const uint32_t remaining_count = tile_count - tile_base;
+    slice_length = remaining_count / (dispatch_task->shard_count * 2);
+    slice_length = iree_min(slice_length, dispatch_task->tiles_per_reservation);
+    if (slice_length == 0) slice_length = 1;
+  } while (!iree_atomic_compare_exchange_weak_int32(
+      &dispatch_task->tile_index, &tile_base, tile_base + slice_length,
+      iree_memory_order_relaxed, iree_memory_order_relaxed));
+  *out_slice_length = slice_length;
+  return tile_base;
+}
+
 void iree_task_dispatch_shard_execute(
     iree_task_dispatch_shard_t* task, iree_cpu_processor_id_t processor_id,
     uint32_t worker_id, iree_byte_span_t worker_local_memory,
@@ -748,6 +866,29 @@ void iree_task_dispatch_shard_execute(
   tile_context.worker_id = worker_id;
   tile_context.local_memory = worker_local_memory;
 
+  // Hand the shard the private reduction accumulator slot for the worker it
+  // landed on. Slots are cache-line padded so that concurrent shards never
+  // write-share lines while accumulating.
+  tile_context.reduction_memory = iree_byte_span_empty();
+  if (dispatch_task->reduction_closure.fn) {
+    if (IREE_UNLIKELY(worker_id >= dispatch_task->reduction_slot_count)) {
+      iree_task_try_set_status(
+          &dispatch_task->status,
+          iree_make_status(IREE_STATUS_RESOURCE_EXHAUSTED,
+                           "dispatch reduction storage provides %u accumulator "
+                           "slots but worker %u may participate",
+                           dispatch_task->reduction_slot_count, worker_id));
+      iree_task_retire(&task->header, pending_submission, iree_ok_status());
+      IREE_TRACE_ZONE_END(z0);
+      return;
+    }
+    tile_context.reduction_memory = iree_make_byte_span(
+        dispatch_task->reduction_storage.data +
+            worker_id * iree_task_reduction_slot_stride(
+                            dispatch_task->reduction_accumulator_size),
+        dispatch_task->reduction_accumulator_size);
+  }
+
   // We perform all our shard statistics work locally here and only push back to
   // the dispatch at the end; this avoids contention from each shard trying to
   // update the statistics together.
@@ -759,16 +900,11 @@ void iree_task_dispatch_shard_execute(
   tile_context.processor_id = processor_id;
 
   // Loop over all tiles until they are all processed.
-  const uint32_t tile_count = dispatch_task->tile_count;
-  const uint32_t tiles_per_reservation = dispatch_task->tiles_per_reservation;
-  // relaxed order because we only care about atomic increments, not about
-  // ordering of tile_index accesses w.r.t. other memory accesses.
-  uint32_t tile_base = iree_atomic_fetch_add_int32(&dispatch_task->tile_index,
-                                                   tiles_per_reservation,
-                                                   iree_memory_order_relaxed);
-  while (tile_base < tile_count) {
-    const uint32_t tile_range =
-        iree_min(tile_base + tiles_per_reservation, tile_count);
+  uint32_t tile_slice_length = 0;
+  uint32_t tile_base = iree_task_dispatch_shard_reserve_tiles(
+      dispatch_task, &tile_slice_length);
+  while (tile_slice_length > 0) {
+    const uint32_t tile_range = tile_base + tile_slice_length;
     for (uint32_t tile_index = tile_base; tile_index < tile_range;
          ++tile_index) {
       // TODO(benvanik): faster math here, especially knowing we pull off N
@@ -780,24 +916,31 @@ void iree_task_dispatch_shard_execute(
       tile_i /= workgroup_count_y;
       tile_context.workgroup_xyz[2] = tile_i;
 
-      IREE_TRACE_ZONE_BEGIN_NAMED(z_tile,
-                                  "iree_task_dispatch_shard_execute_tile");
-      IREE_TRACE_ZONE_SET_COLOR(z_tile, iree_task_tile_to_color(&tile_context));
+      // Per-tile zones dominate tracing overhead on large grids; they are
+      // sampled so production traces can thin them while rare dispatches
+      // keep full fidelity.
+      IREE_TRACE_ZONE_BEGIN_NAMED_SAMPLED(
+          z_tile, "iree_task_dispatch_shard_execute_tile",
+          IREE_TRACING_CATEGORY_TASK);
+      if (z_tile) {
+        IREE_TRACE_ZONE_SET_COLOR(z_tile,
+                                  iree_task_tile_to_color(&tile_context));
 
 #ifndef NDEBUG
-      // NOTE: these are useful for debugging but dramatically increase our
-      // cost here; only enable if needed for tracking work distribution:
-      IREE_TRACE_ZONE_APPEND_VALUE_I64(z_tile, tile_context.workgroup_xyz[0]);
-      IREE_TRACE_ZONE_APPEND_VALUE_I64(z_tile, tile_context.workgroup_xyz[1]);
-      IREE_TRACE_ZONE_APPEND_VALUE_I64(z_tile, tile_context.workgroup_xyz[2]);
-      // IREE_TRACE_ZONE_APPEND_VALUE_I64(z_tile, (uint64_t)task->closure.fn);
+        // NOTE: these are useful for debugging but dramatically increase our
+        // cost here; only enable if needed for tracking work distribution:
+        IREE_TRACE_ZONE_APPEND_VALUE_I64(z_tile, tile_context.workgroup_xyz[0]);
+        IREE_TRACE_ZONE_APPEND_VALUE_I64(z_tile, tile_context.workgroup_xyz[1]);
+        IREE_TRACE_ZONE_APPEND_VALUE_I64(z_tile, tile_context.workgroup_xyz[2]);
+        // IREE_TRACE_ZONE_APPEND_VALUE_I64(z_tile, (uint64_t)task->closure.fn);
 #endif  // !NDEBUG
+      }
 
       iree_status_t status =
           dispatch_task->closure.fn(dispatch_task->closure.user_context,
                                     &tile_context, pending_submission);
 
-      IREE_TRACE_ZONE_END(z_tile);
+      IREE_TRACE_ZONE_END_SAMPLED(z_tile);
 
       // If any tile fails we bail early from the loop. This doesn't match
       // what an accelerator would do but saves some unneeded work.
@@ -813,9 +956,8 @@ void iree_task_dispatch_shard_execute(
     }
 
     // Try to grab the next slice of tiles.
-    tile_base = iree_atomic_fetch_add_int32(&dispatch_task->tile_index,
-                                            tiles_per_reservation,
-                                            iree_memory_order_relaxed);
+    tile_base = iree_task_dispatch_shard_reserve_tiles(dispatch_task,
+                                                       &tile_slice_length);
   }
 abort_shard:
 
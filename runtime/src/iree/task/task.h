@@ -474,6 +474,26 @@ void iree_task_wait_initialize_delay(iree_task_scope_t* scope,
 void iree_task_wait_set_wait_any(iree_task_wait_t* task,
                                  iree_atomic_int32_t* cancellation_flag);
 
+// Yields the currently-executing call |task| until |wait_source| resolves.
+// May only be called from within the call closure while it is executing.
+//
+// The caller-allocated |wait_task| is initialized as a wait on |wait_source|
+// blocking the call from retiring and enqueued on |pending_submission|; the
+// executor parks the wait with its poller and the worker is immediately freed
+// to run other tasks instead of blocking in the closure. When the wait
+// resolves (or |deadline_ns| is exceeded, failing the scope) the call is
+// posted back to a worker and its closure invoked again. As with any
+// re-issued call the closure must be written as a resumable state machine
+// keyed off its user_context.
+//
+// The wait task memory must remain live until the call is re-issued; it is
+// commonly embedded in the closure user_context.
+void iree_task_call_yield_until(iree_task_call_t* task,
+                                iree_wait_source_t wait_source,
+                                iree_time_t deadline_ns,
+                                iree_task_wait_t* wait_task,
+                                iree_task_submission_t* pending_submission);
+
 //==============================================================================
 // IREE_TASK_TYPE_DISPATCH_* structures
 //==============================================================================
@@ -546,6 +566,12 @@ typedef iree_alignas(iree_max_align_t) struct {
 
   // Shared statistics counters for the dispatch shard.
   iree_task_dispatch_statistics_t* statistics;
+
+  // Optional reduction accumulator slot assigned to the worker processing the
+  // tile. Empty unless a reduction was declared on the dispatch with
+  // iree_task_dispatch_set_reduction. All tiles processed on the same worker
+  // share the same slot and may update it without synchronization.
+  iree_byte_span_t reduction_memory;
 } iree_task_tile_context_t;
 
 typedef struct iree_task_dispatch_t iree_task_dispatch_t;
@@ -580,6 +606,40 @@ static inline iree_task_dispatch_closure_t iree_task_make_dispatch_closure(
   return closure;
 }
 
+typedef iree_status_t(IREE_API_PTR* iree_task_reduction_closure_fn_t)(
+    void* user_context, iree_byte_span_t target_slot,
+    iree_const_byte_span_t source_slot);
+
+// A function closure combining two reduction accumulator slots.
+// Called once per source slot as the dispatch retires to fold |source_slot|
+// into |target_slot|; must be associative as fold order is unspecified.
+typedef struct iree_task_reduction_closure_t {
+  // Function called per accumulator slot pair.
+  iree_task_reduction_closure_fn_t fn;
+
+  // User-defined argument passed to the combiner during invocation.
+  // Same lifetime requirements as iree_task_dispatch_closure_t::user_context.
+  void* user_context;
+} iree_task_reduction_closure_t;
+
+// Binds a combiner function pointer and the arguments it should be called
+// with. If the arguments represent pointers they must remain live until the
+// dispatch has completed execution.
+static inline iree_task_reduction_closure_t iree_task_make_reduction_closure(
+    iree_task_reduction_closure_fn_t fn, void* user_context) {
+  iree_task_reduction_closure_t closure = {fn, user_context};
+  return closure;
+}
+
+// Returns the stride in bytes between reduction accumulator slots of
+// |accumulator_size| bytes each. Slots are padded out to cache-line
+// granularity so that workers never write-share lines while accumulating.
+static inline iree_host_size_t iree_task_reduction_slot_stride(
+    iree_host_size_t accumulator_size) {
+  return iree_host_align(accumulator_size,
+                         iree_hardware_destructive_interference_size);
+}
+
 //==============================================================================
 // IREE_TASK_TYPE_DISPATCH
 //==============================================================================
@@ -628,6 +688,21 @@ typedef iree_alignas(iree_max_align_t) struct iree_task_dispatch_t {
   // dispatch closure.
   uint32_t local_memory_size;
 
+  // Optional combiner folding per-worker reduction accumulator slots as the
+  // dispatch retires. Unused (fn == NULL) for ordinary dispatches.
+  iree_task_reduction_closure_t reduction_closure;
+
+  // Size in bytes of a single reduction accumulator as seen by tiles.
+  // Slots are padded out to cache-line granularity within reduction_storage.
+  uint32_t reduction_accumulator_size;
+
+  // Total number of padded accumulator slots available in reduction_storage.
+  uint32_t reduction_slot_count;
+
+  // Caller-provided storage for the padded accumulator slots.
+  // Slot 0 holds the final reduced value once the dispatch has retired.
+  iree_byte_span_t reduction_storage;
+
   // Resulting status from the dispatch available once all workgroups have
   // completed (or would have completed). If multiple shards processing the
   // workgroups hit an error the first will be taken and the result ignored. A
@@ -643,9 +718,16 @@ typedef iree_alignas(iree_max_align_t) struct iree_task_dispatch_t {
 
   // Maximum number of tiles to fetch per tile reservation from the grid.
   // Bounded by IREE_TASK_DISPATCH_MAX_TILES_PER_SHARD_RESERVATION and a
-  // reasonable number chosen based on the tile and shard counts.
+  // reasonable number chosen based on the tile and shard counts. Reservations
+  // shrink below this as the grid drains so that the final tiles are handed
+  // out individually and dispatch tail latency tracks the slowest tile rather
+  // than the slowest reservation.
   uint32_t tiles_per_reservation;
 
+  // Total number of shards forked for the dispatch; used to scale reservation
+  // sizes to the available parallelism.
+  uint32_t shard_count;
+
   // The tail tile index; the next reservation will start from here.
   // This is used by shards to slice off the work to perform in their inner
   // loop. Ideally we'd have no destructive interference with other shared data
@@ -668,6 +750,27 @@ void iree_task_dispatch_initialize_indirect(
     const uint32_t workgroup_size[3], const uint32_t* workgroup_count_ptr,
     iree_task_dispatch_t* out_task);
 
+// Declares a reduction performed by the dispatch closure.
+//
+// Each worker that participates in the dispatch is handed a private
+// cache-line padded accumulator slot of |accumulator_size| bytes via
+// iree_task_tile_context_t::reduction_memory and as the dispatch retires the
+// |closure| combiner is invoked to fold all slots into slot 0 of |storage|.
+// This removes the memory round-trip and follow-up dispatch otherwise needed
+// to join partial reduction results.
+//
+// |storage| is caller-provided (usually from the same arena the dispatch task
+// was allocated from) and must provide one slot of
+// iree_task_reduction_slot_stride(accumulator_size) bytes for each worker in
+// the executor the dispatch may be scheduled on. The caller must initialize
+// every slot to the reduction identity value prior to submission as workers
+// that steal no tiles never touch their slot. The storage must remain live
+// until the dispatch has completed.
+void iree_task_dispatch_set_reduction(iree_task_dispatch_t* dispatch_task,
+                                      iree_task_reduction_closure_t closure,
+                                      iree_host_size_t accumulator_size,
+                                      iree_byte_span_t storage);
+
 //==============================================================================
 // IREE_TASK_TYPE_DISPATCH_SHARD
 //==============================================================================
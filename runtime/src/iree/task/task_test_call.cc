@@ -242,6 +242,47 @@ TEST_F(TaskCallTest, IssueNested) {
   IREE_EXPECT_OK(iree_task_scope_consume_status(&scope_));
 }
 
+// Issues a call that yields on a wait source mid-execution and resumes after
+// it resolves. The first pass through the closure yields on an already-set
+// event; the executor parks the wait with the poller and the closure is
+// invoked a second time once it resolves.
+TEST_F(TaskCallTest, IssueYield) {
+  IREE_TRACE_SCOPE();
+
+  struct TestCtx {
+    std::atomic<int> did_call = {0};
+    iree_event_t event;
+    iree_task_wait_t wait_task;
+  };
+  TestCtx ctx;
+  iree_event_initialize(/*initial_state=*/true, &ctx.event);
+
+  iree_task_call_t task;
+  iree_task_call_initialize(
+      &scope_,
+      iree_task_make_call_closure(
+          [](void* user_context, iree_task_t* task,
+             iree_task_submission_t* pending_submission) {
+            IREE_TRACE_SCOPE();
+            auto* ctx = (TestCtx*)user_context;
+            EXPECT_TRUE(NULL != ctx);
+            if (ctx->did_call++ == 0) {
+              iree_task_call_yield_until(
+                  (iree_task_call_t*)task, iree_event_await(&ctx->event),
+                  IREE_TIME_INFINITE_FUTURE, &ctx->wait_task,
+                  pending_submission);
+            }
+            return iree_ok_status();
+          },
+          (void*)&ctx),
+      &task);
+  IREE_ASSERT_OK(SubmitTasksAndWaitIdle(&task.header, &task.header));
+  EXPECT_EQ(2, ctx.did_call);
+  IREE_EXPECT_OK(iree_task_scope_consume_status(&scope_));
+
+  iree_event_deinitialize(&ctx.event);
+}
+
 // Issues task_a which then issues a nested task_b and task_c; task_b fails and
 // it's expected that task_c completes before failing task_a.
 // Sibling tasks don't abort each other and as such we are guaranteed that C
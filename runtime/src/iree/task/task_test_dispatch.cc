@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <cstdio>
 #include <memory>
+#include <vector>
 
 #include "iree/base/api.h"
 #include "iree/task/submission.h"
@@ -113,6 +114,59 @@ TEST_F(TaskDispatchTest, Issue345) {
   DispatchAndVerifyGrid(kWorkgroupSize, kWorkgroupCount, IREE_TASK_FLAG_NONE);
 }
 
+TEST_F(TaskDispatchTest, IssueReduction) {
+  IREE_TRACE_SCOPE();
+
+  // Sum the linearized workgroup index over the full grid; each tile adds its
+  // index to the private accumulator slot of whichever worker runs it and the
+  // combiner sums the slots as the dispatch retires.
+  static const uint32_t kWorkgroupSize[3] = {1, 1, 1};
+  static const uint32_t kWorkgroupCount[3] = {4, 4, 4};
+  constexpr uint32_t kTileCount =
+      kWorkgroupCount[0] * kWorkgroupCount[1] * kWorkgroupCount[2];
+
+  iree_task_dispatch_t task;
+  iree_task_dispatch_initialize(
+      &scope_,
+      iree_task_make_dispatch_closure(
+          [](void* user_context, const iree_task_tile_context_t* tile_context,
+             iree_task_submission_t* pending_submission) {
+            uint32_t tile_index =
+                tile_context->workgroup_xyz[2] *
+                    (tile_context->workgroup_count[1] *
+                     tile_context->workgroup_count[0]) +
+                tile_context->workgroup_xyz[1] *
+                    tile_context->workgroup_count[0] +
+                tile_context->workgroup_xyz[0];
+            *reinterpret_cast<uint32_t*>(
+                tile_context->reduction_memory.data) += tile_index;
+            return iree_ok_status();
+          },
+          nullptr),
+      kWorkgroupSize, kWorkgroupCount, &task);
+
+  // One identity-initialized cache-line padded slot per possible worker.
+  std::vector<uint8_t> storage(
+      iree_task_executor_worker_count(executor_) *
+          iree_task_reduction_slot_stride(sizeof(uint32_t)),
+      0);
+  iree_task_dispatch_set_reduction(
+      &task,
+      iree_task_make_reduction_closure(
+          [](void* user_context, iree_byte_span_t target_slot,
+             iree_const_byte_span_t source_slot) {
+            *reinterpret_cast<uint32_t*>(target_slot.data) +=
+                *reinterpret_cast<const uint32_t*>(source_slot.data);
+            return iree_ok_status();
+          },
+          nullptr),
+      sizeof(uint32_t), iree_make_byte_span(storage.data(), storage.size()));
+
+  IREE_ASSERT_OK(SubmitTasksAndWaitIdle(&task.header, &task.header));
+  EXPECT_EQ(kTileCount * (kTileCount - 1) / 2,
+            *reinterpret_cast<uint32_t*>(storage.data()));
+}
+
 TEST_F(TaskDispatchTest, IssueIndirect) {
   IREE_TRACE_SCOPE();
 
@@ -74,6 +74,12 @@ typedef struct iree_task_topology_group_t {
   // Logical processor index.
   uint32_t processor_index;
 
+  // NUMA node (or processor cluster) the group's processors reside on.
+  // 0 when the platform topology query does not expose node information.
+  // Executors and allocators can use this to keep memory touched by the
+  // group's worker on the local node.
+  iree_task_topology_node_id_t numa_node_id;
+
   // Total cache sizes (that we care about).
   iree_task_topology_caches_t caches;
 
@@ -188,6 +188,10 @@ static void iree_task_topology_group_initialize_from_processor(
       processor->cache.l2 ? processor->cache.l2->size : 0;
   out_group->caches.l3_data =
       processor->cache.l3 ? processor->cache.l3->size : 0;
+  // cpuinfo clusters are the closest thing to NUMA nodes we have; this matches
+  // what iree_task_topology_query_current_node reports.
+  out_group->numa_node_id =
+      (iree_task_topology_node_id_t)processor->cluster->cluster_id;
   iree_task_topology_set_affinity_from_processor(
       processor, &out_group->ideal_thread_affinity);
 }
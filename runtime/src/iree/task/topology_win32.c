@@ -118,8 +118,24 @@ static void iree_task_topology_assign_constructive_sharing(
   }
 }
 
+// Uses |group_mask| to assign |node_id| to all topology groups with
+// processors residing on the NUMA node.
+static void iree_task_topology_assign_numa_node(
+    iree_task_topology_t* topology, GROUP_AFFINITY group_mask, DWORD node_id) {
+  for (iree_host_size_t group_i = 0; group_i < topology->group_count;
+       ++group_i) {
+    iree_task_topology_group_t* group = &topology->groups[group_i];
+    if (group->ideal_thread_affinity.group == group_mask.Group &&
+        (group_mask.Mask & (1ull << group->ideal_thread_affinity.id))) {
+      group->numa_node_id = (iree_task_topology_node_id_t)node_id;
+    }
+  }
+}
+
 // Assigns constructive sharing masks to each topology group. These indicate
-// which other topology groups share L3 caches (if any).
+// which other topology groups share L3 caches (if any). NUMA node IDs are
+// assigned as well when the relationship set includes RelationNumaNode
+// entries (RelationAll queries); cache-only queries leave them unchanged.
 static void
 iree_task_topology_fixup_constructive_sharing_masks_from_relationships(
     SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX* relationships,
@@ -128,6 +144,11 @@ iree_task_topology_fixup_constructive_sharing_masks_from_relationships(
   for (SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX* p = relationships;
        p < relationships_end;
        p = (SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*)((uintptr_t)p + p->Size)) {
+    if (p->Relationship == RelationNumaNode ||
+        p->Relationship == RelationNumaNodeEx) {
+      iree_task_topology_assign_numa_node(topology, p->NumaNode.GroupMask,
+                                          p->NumaNode.NodeNumber);
+    }
     if (p->Relationship == RelationCache) {
       if (p->Cache.GroupCount == 0) {
         iree_task_topology_assign_cache_info(topology, p->Cache.GroupMask,
@@ -53,6 +53,12 @@ extern "C" {
 // 1ms may result in 10-15ms.
 #define IREE_TASK_EXECUTOR_DELAY_SLOP_NS (1 /*ms*/ * 1000000)
 
+// How far ahead of a scope deadline the deadline boost kicks in.
+// Scopes within this margin of (or past) their deadline are scheduled as if
+// they were in the high priority class. This should cover roughly the typical
+// queueing delay between coordination and worker execution.
+#define IREE_TASK_SCOPE_DEADLINE_BOOST_MARGIN_NS (1 /*ms*/ * 1000000)
+
 // Allows for dividing the total number of attempts that a worker will make to
 // steal tasks from other workers. By default all other workers will be
 // attempted while setting this to 2, for example, will try for only half of
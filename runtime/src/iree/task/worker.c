@@ -32,6 +32,7 @@ iree_status_t iree_task_worker_initialize(
   out_worker->worker_index = executor->worker_base_index + worker_index;
   out_worker->worker_bit = iree_task_affinity_for_worker(worker_index);
   out_worker->ideal_thread_affinity = topology_group->ideal_thread_affinity;
+  out_worker->numa_node_id = topology_group->numa_node_id;
   out_worker->constructive_sharing_mask =
       topology_group->constructive_sharing_mask;
   out_worker->max_theft_attempts =
@@ -39,6 +40,9 @@ iree_status_t iree_task_worker_initialize(
   iree_prng_minilcg128_initialize(iree_prng_splitmix64_next(seed_prng),
                                   &out_worker->theft_prng);
   out_worker->local_memory = local_memory;
+  out_worker->current_spin_ns = executor->worker_spin_ns;
+  IREE_STATISTICS(
+      memset(&out_worker->statistics, 0, sizeof(out_worker->statistics)));
   out_worker->processor_id = 0;
   out_worker->processor_tag = 0;
 
@@ -222,6 +226,20 @@ static bool iree_task_worker_pump_once(
     // complete tasks faster than others, etc).
     task = iree_task_queue_flush_from_lifo_slist(&worker->local_task_queue,
                                                  &worker->mailbox_slist);
+
+    // Track the high-water mark of the local queue; the flush above is the
+    // only place the queue grows from the worker's perspective.
+    IREE_STATISTICS({
+      int32_t depth =
+          (int32_t)iree_task_queue_approx_depth(&worker->local_task_queue);
+      int32_t max_depth = iree_atomic_load_int32(
+          &worker->statistics.max_queue_depth, iree_memory_order_relaxed);
+      while (depth > max_depth &&
+             !iree_atomic_compare_exchange_weak_int32(
+                 &worker->statistics.max_queue_depth, &max_depth, depth,
+                 iree_memory_order_relaxed, iree_memory_order_relaxed)) {
+      }
+    });
   }
 
 #if IREE_TASK_EXECUTOR_MAX_THEFT_ATTEMPTS_DIVISOR > 0
@@ -234,6 +252,12 @@ static bool iree_task_worker_pump_once(
         worker->executor, worker->constructive_sharing_mask,
         worker->max_theft_attempts, &worker->theft_prng,
         &worker->local_task_queue);
+    IREE_STATISTICS({
+      if (task) {
+        iree_atomic_fetch_add_int64(&worker->statistics.steal_count, 1,
+                                    iree_memory_order_relaxed);
+      }
+    });
   }
 #endif  // IREE_TASK_EXECUTOR_MAX_THEFT_ATTEMPTS_DIVISOR > 0
 
@@ -244,8 +268,47 @@ static bool iree_task_worker_pump_once(
   }
 
   // Execute the task (may call out to arbitrary user code and may submit more
-  // tasks for execution).
-  iree_task_worker_execute(worker, task, pending_submission);
+  // tasks for execution). When the executor has a stall threshold configured
+  // we bracket execution with timestamp queries so that tasks blocking the
+  // worker (page faults on mapped memory, locks held in user code, etc) can be
+  // attributed to the scope that issued them without kernel tracing.
+  iree_duration_t stall_threshold_ns =
+      worker->executor->worker_stall_threshold_ns;
+  if (IREE_UNLIKELY(stall_threshold_ns != IREE_DURATION_ZERO)) {
+    // NOTE: executing the task invalidates it and we must capture the
+    // attribution information before handing it off.
+    char scope_name[16] = {0};
+    if (task->scope) {
+      iree_string_view_t name = iree_task_scope_name(task->scope);
+      memcpy(scope_name, name.data,
+             iree_min(name.size, sizeof(scope_name) - 1));
+    }
+    iree_time_t start_ns = iree_time_now();
+    iree_task_worker_execute(worker, task, pending_submission);
+    iree_duration_t duration_ns = iree_time_now() - start_ns;
+    if (IREE_UNLIKELY(duration_ns >= stall_threshold_ns)) {
+      IREE_TRACE_ZONE_APPEND_TEXT(z0, "stalled");
+      IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, duration_ns);
+      IREE_STATISTICS({
+        iree_atomic_fetch_add_int64(&worker->statistics.stall_count, 1,
+                                    iree_memory_order_relaxed);
+        // The worker thread is the only writer of the stall maximum so a
+        // load/compare/store suffices; readers tolerate tearing.
+        int64_t max_stall_ns = iree_atomic_load_int64(
+            &worker->statistics.max_stall_ns, iree_memory_order_relaxed);
+        if (duration_ns > max_stall_ns) {
+          iree_atomic_store_int64(&worker->statistics.max_stall_ns,
+                                  duration_ns, iree_memory_order_relaxed);
+          memcpy(worker->statistics.max_stall_scope, scope_name,
+                 sizeof(worker->statistics.max_stall_scope));
+        }
+      });
+    }
+  } else {
+    iree_task_worker_execute(worker, task, pending_submission);
+  }
+  IREE_STATISTICS(iree_atomic_fetch_add_int64(&worker->statistics.task_count, 1,
+                                              iree_memory_order_relaxed));
 
   IREE_TRACE_ZONE_END(z0);
   return true;  // try again
@@ -304,8 +367,10 @@ static void iree_task_worker_pump_until_exit(iree_task_worker_t* worker) {
     iree_task_submission_t pending_submission;
     iree_task_submission_initialize(&pending_submission);
 
+    bool did_process = false;
     while (iree_task_worker_pump_once(worker, &pending_submission)) {
       // All work done ^, which will return false when the worker should wait.
+      did_process = true;
     }
 
     bool schedule_dirty = false;
@@ -346,13 +411,26 @@ static void iree_task_worker_pump_until_exit(iree_task_worker_t* worker) {
       // Have more work to do; loop around to try another pump.
       iree_notification_cancel_wait(&worker->wake_notification);
     } else {
+      // Adaptively size the spin before parking: spend the full budget only
+      // when the worker recently had work (hot serving loops where new waves
+      // arrive within the spin window) and back off exponentially on each
+      // fruitless wake so persistently-idle workers park immediately.
+      if (did_process) {
+        worker->current_spin_ns = worker->executor->worker_spin_ns;
+      } else {
+        worker->current_spin_ns /= 2;
+      }
+
+      IREE_STATISTICS(iree_atomic_fetch_add_int64(
+          &worker->statistics.park_count, 1, iree_memory_order_relaxed));
+
       // Spin/wait in the kernel. We don't care if the condition fails as we're
       // just using it as a pulse.
       IREE_TRACE_ZONE_BEGIN_NAMED(z_wait,
                                   "iree_task_worker_main_pump_wake_wait");
       iree_notification_commit_wait(
           &worker->wake_notification, wait_token,
-          /*spin_ns=*/worker->executor->worker_spin_ns,
+          /*spin_ns=*/worker->current_spin_ns,
           /*deadline_ns=*/IREE_TIME_INFINITE_FUTURE);
       IREE_TRACE_ZONE_END(z_wait);
 
@@ -379,6 +457,15 @@ static int iree_task_worker_main(iree_task_worker_t* worker) {
   // TODO(benvanik): call this after waking in case CPU hotplugging happens.
   iree_thread_request_affinity(worker->thread, worker->ideal_thread_affinity);
 
+  // First-touch the worker local memory from this thread now that we are
+  // running with our ideal affinity. The pages were left untouched when the
+  // executor storage was allocated so that under first-touch NUMA policies
+  // they are placed on the node executing this worker; dispatches then get
+  // node-local scratch without any allocator calls.
+  if (!iree_byte_span_is_empty(worker->local_memory)) {
+    memset(worker->local_memory.data, 0, worker->local_memory.data_length);
+  }
+
   // Enter the running state immediately. Note that we could have been requested
   // to exit while suspended/still starting up, so check that here before we
   // mess with any data structures.
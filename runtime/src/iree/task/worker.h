@@ -47,6 +47,31 @@ typedef enum iree_task_worker_state_e {
   IREE_TASK_WORKER_STATE_ZOMBIE = 2,
 } iree_task_worker_state_t;
 
+// Lightweight always-on execution statistics for a worker.
+// All counters are updated with relaxed atomics by the worker thread and may
+// be sampled from any thread; values may tear relative to each other and must
+// not be used for control flow - they exist purely for telemetry.
+typedef struct iree_task_worker_statistics_t {
+  // Total number of tasks executed by the worker.
+  iree_atomic_int64_t task_count;
+  // Total number of tasks stolen from other workers.
+  iree_atomic_int64_t steal_count;
+  // Total number of times the worker parked in the kernel waiting for work.
+  iree_atomic_int64_t park_count;
+  // Maximum observed depth of the worker local task queue.
+  iree_atomic_int32_t max_queue_depth;
+  // Total number of tasks whose execution exceeded the executor
+  // worker_stall_threshold_ns budget (0 when the watchdog is disabled).
+  iree_atomic_int64_t stall_count;
+  // Longest observed task execution time in nanoseconds while the stall
+  // watchdog was enabled. Only the worker thread writes this.
+  iree_atomic_int64_t max_stall_ns;
+  // Name of the scope owning the longest observed stall. Written by the
+  // worker thread without synchronization and may tear relative to
+  // max_stall_ns; attribution is best-effort telemetry only.
+  char max_stall_scope[16];
+} iree_task_worker_statistics_t;
+
 // A worker within the executor pool.
 //
 // NOTE: fields in here are touched from multiple threads with lock-free
@@ -91,6 +116,11 @@ typedef struct iree_task_worker_t {
   // Ideal thread affinity for the worker thread.
   iree_thread_affinity_t ideal_thread_affinity;
 
+  // NUMA node the worker's processors reside on (0 if unknown).
+  // Memory the worker will touch (local memory, transient allocations) should
+  // be placed on this node when the platform allows us to control placement.
+  iree_task_topology_node_id_t numa_node_id;
+
   // A bitmask of other group indices that share some level of the cache
   // hierarchy. Workers of this group are more likely to constructively share
   // some cache levels higher up with these other groups. For example, if the
@@ -111,6 +141,16 @@ typedef struct iree_task_worker_t {
   // remain valid so that the executor can query its state.
   iree_thread_t* thread;
 
+  // Current spin duration used before parking when the worker goes idle.
+  // Reset to the executor worker_spin_ns budget whenever the worker processes
+  // tasks and halved on each fruitless wake so persistently-idle workers decay
+  // to parking in the kernel immediately. Only touched by the worker thread.
+  iree_duration_t current_spin_ns;
+
+  // Execution statistics aggregated by the executor for telemetry queries.
+  // Only present when IREE_STATISTICS_ENABLE is set.
+  IREE_STATISTICS(iree_task_worker_statistics_t statistics;)
+
   // Guess at the current processor ID.
   // This is updated infrequently as it can be semi-expensive to determine
   // (on some platforms at least 1 syscall involved). We always update it upon
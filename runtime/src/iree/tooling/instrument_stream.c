@@ -0,0 +1,400 @@
+// Copyright 2026 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/tooling/instrument_stream.h"
+
+#include <string.h>
+
+#include "iree/base/internal/atomics.h"
+#include "iree/base/internal/synchronization.h"
+#include "iree/base/internal/threading.h"
+#include "iree/hal/buffer_transfer.h"
+#include "iree/modules/hal/types.h"
+#include "iree/schemas/instruments/dispatch.h"
+
+//===----------------------------------------------------------------------===//
+// Stream state
+//===----------------------------------------------------------------------===//
+
+// Size of the host scratch buffer used to shuttle ringbuffer contents.
+// Larger ranges are drained in multiple transfers; this bounds host memory
+// regardless of how large the device-resident ringbuffers are.
+#define IREE_TOOLING_INSTRUMENT_STREAM_SCRATCH_CAPACITY (256 * 1024)
+
+// A single dispatch instrumentation ringbuffer registered with the stream.
+typedef struct iree_tooling_instrument_stream_source_t {
+  // Device buffer containing the ringbuffer chunk payload. Retained.
+  iree_hal_buffer_t* buffer;
+  // Byte offset of the chunk payload within |buffer|.
+  iree_device_size_t buffer_offset;
+  // Power-of-two size of the ringbuffer data region in bytes.
+  uint64_t ring_size;
+  // Total chunk payload size including the trailing padding; the 8-byte
+  // monotonic write head lives at the end of the payload.
+  uint64_t data_size;
+  // Monotonic stream offset up to which bytes have been delivered.
+  uint64_t read_head;
+} iree_tooling_instrument_stream_source_t;
+
+struct iree_tooling_instrument_stream_t {
+  iree_allocator_t host_allocator;
+  iree_hal_device_t* device;  // retained
+  iree_tooling_instrument_sink_t sink;
+  iree_duration_t poll_interval_ns;
+
+  // Drain thread; NULL when the stream has no sources.
+  iree_thread_t* thread;
+  // 0-to-1 when the stream is being freed and the thread should exit.
+  iree_atomic_int32_t shutdown_flag;
+  // Posted when the shutdown flag is set to wake the drain thread early.
+  iree_notification_t shutdown_notification;
+  // 0-to-1 when the drain thread has exited and |thread_status| is valid.
+  iree_atomic_int32_t exited_flag;
+  // Posted by the drain thread after its final drain.
+  iree_notification_t exited_notification;
+  // Terminal status of the drain thread; owned by the stream until freed.
+  iree_status_t thread_status;
+
+  // Host scratch storage for device-to-host transfers.
+  iree_host_size_t scratch_capacity;
+  uint8_t* scratch;
+
+  iree_host_size_t source_count;
+  iree_tooling_instrument_stream_source_t sources[];
+};
+
+//===----------------------------------------------------------------------===//
+// Draining
+//===----------------------------------------------------------------------===//
+
+// Delivers all bytes written to |source| since the last drain to the sink.
+// Ranges that have already been overwritten by the device are dropped as the
+// producers never block on the consumer.
+static iree_status_t iree_tooling_instrument_stream_drain_source(
+    iree_tooling_instrument_stream_t* stream, iree_host_size_t source_ordinal,
+    iree_tooling_instrument_stream_source_t* source) {
+  // Snapshot the monotonic write head; the transfer is queue-ordered so all
+  // bytes below the head value read are visible to subsequent transfers.
+  uint64_t write_head = 0;
+  IREE_RETURN_IF_ERROR(iree_hal_device_transfer_d2h(
+      stream->device, source->buffer,
+      source->buffer_offset + source->data_size - sizeof(write_head),
+      &write_head, sizeof(write_head), IREE_HAL_TRANSFER_BUFFER_FLAG_DEFAULT,
+      iree_infinite_timeout()));
+
+  uint64_t read_head = source->read_head;
+  if (write_head <= read_head) return iree_ok_status();
+  if (write_head - read_head > source->ring_size) {
+    // The device lapped us and the oldest bytes are gone; skip forward to the
+    // oldest range still resident.
+    read_head = write_head - source->ring_size;
+  }
+
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, (int64_t)(write_head - read_head));
+  iree_status_t status = iree_ok_status();
+  while (read_head < write_head) {
+    // Clamp each transfer to the ringbuffer wrap point and scratch capacity.
+    uint64_t physical_offset = read_head & (source->ring_size - 1);
+    uint64_t length = write_head - read_head;
+    length = iree_min(length, source->ring_size - physical_offset);
+    length = iree_min(length, (uint64_t)stream->scratch_capacity);
+    status = iree_hal_device_transfer_d2h(
+        stream->device, source->buffer, source->buffer_offset + physical_offset,
+        stream->scratch, (iree_device_size_t)length,
+        IREE_HAL_TRANSFER_BUFFER_FLAG_DEFAULT, iree_infinite_timeout());
+    if (!iree_status_is_ok(status)) break;
+    status = stream->sink.fn(
+        stream->sink.user_data, source_ordinal, read_head,
+        iree_make_const_byte_span(stream->scratch, (iree_host_size_t)length));
+    if (!iree_status_is_ok(status)) break;
+    read_head += length;
+  }
+  source->read_head = read_head;
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+static iree_status_t iree_tooling_instrument_stream_drain_all(
+    iree_tooling_instrument_stream_t* stream) {
+  for (iree_host_size_t i = 0; i < stream->source_count; ++i) {
+    IREE_RETURN_IF_ERROR(iree_tooling_instrument_stream_drain_source(
+        stream, i, &stream->sources[i]));
+  }
+  return iree_ok_status();
+}
+
+static bool iree_tooling_instrument_stream_is_shutdown(void* arg) {
+  iree_tooling_instrument_stream_t* stream =
+      (iree_tooling_instrument_stream_t*)arg;
+  return iree_atomic_load_int32(&stream->shutdown_flag,
+                                iree_memory_order_acquire) != 0;
+}
+
+static int iree_tooling_instrument_stream_thread_main(void* entry_arg) {
+  iree_tooling_instrument_stream_t* stream =
+      (iree_tooling_instrument_stream_t*)entry_arg;
+
+  iree_status_t status = iree_ok_status();
+  while (iree_status_is_ok(status)) {
+    // Sleep until the next poll tick or an early shutdown wake.
+    bool is_shutdown = iree_notification_await(
+        &stream->shutdown_notification,
+        iree_tooling_instrument_stream_is_shutdown, stream,
+        iree_make_timeout_ns(stream->poll_interval_ns));
+    // Drain before exiting so bytes written prior to shutdown are delivered.
+    status = iree_tooling_instrument_stream_drain_all(stream);
+    if (is_shutdown) break;
+  }
+
+  stream->thread_status = status;
+  iree_atomic_store_int32(&stream->exited_flag, 1, iree_memory_order_release);
+  iree_notification_post(&stream->exited_notification, IREE_ALL_WAITERS);
+  return 0;
+}
+
+static bool iree_tooling_instrument_stream_has_exited(void* arg) {
+  iree_tooling_instrument_stream_t* stream =
+      (iree_tooling_instrument_stream_t*)arg;
+  return iree_atomic_load_int32(&stream->exited_flag,
+                                iree_memory_order_acquire) != 0;
+}
+
+//===----------------------------------------------------------------------===//
+// Ringbuffer discovery
+//===----------------------------------------------------------------------===//
+
+// Registers a ringbuffer chunk with |header| whose payload is the contents of
+// |buffer_view|. Layout emitted by the compiler: the chunk header lives in a
+// small host buffer iovec immediately preceding the device buffer view iovec
+// holding the payload.
+static iree_status_t iree_tooling_instrument_stream_add_source(
+    iree_tooling_instrument_stream_t* stream,
+    const iree_idbts_chunk_header_t* header,
+    iree_hal_buffer_view_t* buffer_view) {
+  if (header->content_length <= IREE_INSTRUMENT_DISPATCH_PADDING) {
+    return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                            "instrument ringbuffer chunk too small (%" PRIu64
+                            " bytes)",
+                            header->content_length);
+  }
+  uint64_t ring_size =
+      header->content_length - IREE_INSTRUMENT_DISPATCH_PADDING;
+  if (!iree_is_power_of_two_uint64(ring_size)) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "instrument ringbuffer size %" PRIu64
+                            " is not a power of two",
+                            ring_size);
+  }
+  iree_hal_buffer_t* buffer = iree_hal_buffer_view_buffer(buffer_view);
+  if (iree_hal_buffer_byte_length(buffer) < header->content_length) {
+    return iree_make_status(
+        IREE_STATUS_OUT_OF_RANGE,
+        "instrument ringbuffer storage smaller than its chunk declares");
+  }
+
+  iree_tooling_instrument_stream_source_t* source =
+      &stream->sources[stream->source_count++];
+  source->buffer = buffer;
+  iree_hal_buffer_retain(source->buffer);
+  source->buffer_offset = 0;
+  source->ring_size = ring_size;
+  source->data_size = header->content_length;
+  source->read_head = 0;
+  return iree_ok_status();
+}
+
+// Walks the iovec list produced by the `__query_instruments` functions and
+// registers a source for each dispatch ringbuffer chunk. Host-resident chunks
+// (metadata, padding) are skipped; they are only meaningful for the
+// post-mortem file format.
+static iree_status_t iree_tooling_instrument_stream_scan_iovecs(
+    iree_tooling_instrument_stream_t* stream, iree_vm_list_t* iovec_list) {
+  const iree_idbts_chunk_header_t* pending_header = NULL;
+  iree_idbts_chunk_header_t pending_header_storage;
+  for (iree_host_size_t i = 0; i < iree_vm_list_size(iovec_list); ++i) {
+    iree_vm_ref_t iovec = iree_vm_ref_null();
+    IREE_RETURN_IF_ERROR(iree_vm_list_get_ref_assign(iovec_list, i, &iovec));
+    if (iree_vm_buffer_isa(iovec)) {
+      iree_vm_buffer_t* buffer = iree_vm_buffer_deref(iovec);
+      if (iree_vm_buffer_length(buffer) >=
+          sizeof(iree_idbts_chunk_header_t)) {
+        iree_idbts_chunk_header_t header;
+        memcpy(&header, iree_vm_buffer_data(buffer), sizeof(header));
+        if (header.magic == IREE_IDBTS_CHUNK_MAGIC &&
+            header.type == IREE_IDBTS_CHUNK_TYPE_DISPATCH_RINGBUFFER) {
+          // Payload arrives as the next buffer view iovec.
+          pending_header_storage = header;
+          pending_header = &pending_header_storage;
+          continue;
+        }
+      }
+      pending_header = NULL;
+    } else if (iree_hal_buffer_view_isa(iovec)) {
+      iree_hal_buffer_view_t* buffer_view = iree_hal_buffer_view_deref(iovec);
+      if (pending_header) {
+        IREE_RETURN_IF_ERROR(iree_tooling_instrument_stream_add_source(
+            stream, pending_header, buffer_view));
+      }
+      pending_header = NULL;
+    }
+  }
+  return iree_ok_status();
+}
+
+// Queries all modules in |context| for instrument data iovecs as with
+// iree_tooling_process_instrument_data.
+static iree_status_t iree_tooling_instrument_stream_query_context(
+    iree_vm_context_t* context, iree_allocator_t host_allocator,
+    iree_vm_list_t** out_iovec_list) {
+  *out_iovec_list = NULL;
+
+  iree_vm_list_t* iovec_list = NULL;
+  IREE_RETURN_IF_ERROR(iree_vm_list_create(iree_vm_make_undefined_type_def(),
+                                           8, host_allocator, &iovec_list));
+
+  iree_vm_list_t* input_list = NULL;
+  iree_status_t status = iree_vm_list_create(iree_vm_make_undefined_type_def(),
+                                             8, host_allocator, &input_list);
+  if (iree_status_is_ok(status)) {
+    iree_vm_ref_t iovec_list_ref = iree_vm_list_retain_ref(iovec_list);
+    status = iree_vm_list_push_ref_move(input_list, &iovec_list_ref);
+  }
+
+  if (iree_status_is_ok(status)) {
+    for (iree_host_size_t i = 0; i < iree_vm_context_module_count(context);
+         ++i) {
+      iree_vm_module_t* module = iree_vm_context_module_at(context, i);
+      if (!module) continue;
+      iree_vm_function_t query_func;
+      iree_status_t lookup_status = iree_vm_module_lookup_function_by_name(
+          module, IREE_VM_FUNCTION_LINKAGE_EXPORT,
+          IREE_SV("__query_instruments"), &query_func);
+      if (!iree_status_is_ok(lookup_status)) {
+        iree_status_ignore(lookup_status);
+        continue;
+      }
+      status = iree_vm_invoke(context, query_func, IREE_VM_INVOCATION_FLAG_NONE,
+                              NULL, input_list, NULL, host_allocator);
+      if (!iree_status_is_ok(status)) break;
+    }
+  }
+
+  iree_vm_list_release(input_list);
+  if (iree_status_is_ok(status)) {
+    *out_iovec_list = iovec_list;
+  } else {
+    iree_vm_list_release(iovec_list);
+  }
+  return status;
+}
+
+//===----------------------------------------------------------------------===//
+// Lifetime
+//===----------------------------------------------------------------------===//
+
+static void iree_tooling_instrument_stream_destroy(
+    iree_tooling_instrument_stream_t* stream) {
+  for (iree_host_size_t i = 0; i < stream->source_count; ++i) {
+    iree_hal_buffer_release(stream->sources[i].buffer);
+  }
+  iree_notification_deinitialize(&stream->exited_notification);
+  iree_notification_deinitialize(&stream->shutdown_notification);
+  iree_hal_device_release(stream->device);
+  iree_allocator_free(stream->host_allocator, stream);
+}
+
+iree_status_t iree_tooling_instrument_stream_create(
+    iree_vm_context_t* context, iree_hal_device_t* device,
+    iree_duration_t poll_interval_ns, iree_tooling_instrument_sink_t sink,
+    iree_allocator_t host_allocator,
+    iree_tooling_instrument_stream_t** out_stream) {
+  IREE_ASSERT_ARGUMENT(context);
+  IREE_ASSERT_ARGUMENT(device);
+  IREE_ASSERT_ARGUMENT(sink.fn);
+  IREE_ASSERT_ARGUMENT(out_stream);
+  *out_stream = NULL;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Collect instrument iovecs from all modules up-front; the set of
+  // ringbuffers is fixed for the lifetime of the context.
+  iree_vm_list_t* iovec_list = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_tooling_instrument_stream_query_context(context, host_allocator,
+                                                       &iovec_list));
+
+  // Allocate the stream with capacity for the worst case of every iovec being
+  // a ringbuffer; the handful of wasted entries is not worth a second pass.
+  iree_host_size_t max_source_count = iree_vm_list_size(iovec_list);
+  iree_tooling_instrument_stream_t* stream = NULL;
+  iree_status_t status = iree_allocator_malloc(
+      host_allocator,
+      sizeof(*stream) + max_source_count * sizeof(stream->sources[0]) +
+          IREE_TOOLING_INSTRUMENT_STREAM_SCRATCH_CAPACITY,
+      (void**)&stream);
+  if (iree_status_is_ok(status)) {
+    stream->host_allocator = host_allocator;
+    stream->device = device;
+    iree_hal_device_retain(stream->device);
+    stream->sink = sink;
+    stream->poll_interval_ns = poll_interval_ns;
+    iree_atomic_store_int32(&stream->shutdown_flag, 0,
+                            iree_memory_order_relaxed);
+    iree_notification_initialize(&stream->shutdown_notification);
+    iree_atomic_store_int32(&stream->exited_flag, 0,
+                            iree_memory_order_relaxed);
+    iree_notification_initialize(&stream->exited_notification);
+    stream->thread_status = iree_ok_status();
+    stream->scratch_capacity = IREE_TOOLING_INSTRUMENT_STREAM_SCRATCH_CAPACITY;
+    stream->scratch = (uint8_t*)stream + sizeof(*stream) +
+                      max_source_count * sizeof(stream->sources[0]);
+    stream->source_count = 0;
+    status = iree_tooling_instrument_stream_scan_iovecs(stream, iovec_list);
+  }
+  iree_vm_list_release(iovec_list);
+
+  // Spawn the drain thread; uninstrumented programs get an inert stream.
+  if (iree_status_is_ok(status) && stream->source_count > 0) {
+    iree_thread_create_params_t thread_params;
+    memset(&thread_params, 0, sizeof(thread_params));
+    thread_params.name = IREE_SV("iree-instrument-drain");
+    status = iree_thread_create(iree_tooling_instrument_stream_thread_main,
+                                stream, thread_params, host_allocator,
+                                &stream->thread);
+  }
+
+  if (iree_status_is_ok(status)) {
+    *out_stream = stream;
+  } else if (stream) {
+    iree_tooling_instrument_stream_destroy(stream);
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+iree_status_t iree_tooling_instrument_stream_free(
+    iree_tooling_instrument_stream_t* stream) {
+  if (!stream) return iree_ok_status();
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_status_t status = iree_ok_status();
+  if (stream->thread) {
+    // Signal shutdown and wait for the final drain to complete.
+    iree_atomic_store_int32(&stream->shutdown_flag, 1,
+                            iree_memory_order_release);
+    iree_notification_post(&stream->shutdown_notification, IREE_ALL_WAITERS);
+    iree_notification_await(&stream->exited_notification,
+                            iree_tooling_instrument_stream_has_exited, stream,
+                            iree_infinite_timeout());
+    iree_thread_release(stream->thread);
+    status = stream->thread_status;
+    stream->thread_status = iree_ok_status();
+  }
+
+  iree_tooling_instrument_stream_destroy(stream);
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
@@ -0,0 +1,81 @@
+// Copyright 2026 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_TOOLING_INSTRUMENT_STREAM_H_
+#define IREE_TOOLING_INSTRUMENT_STREAM_H_
+
+#include "iree/base/api.h"
+#include "iree/hal/api.h"
+#include "iree/vm/api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+//===----------------------------------------------------------------------===//
+// Live instrument data streaming
+//===----------------------------------------------------------------------===//
+// iree_tooling_process_instrument_data reads instrument buffers once after the
+// program has finished; long-running services instead want to observe dispatch
+// instrumentation continuously. The stream polls the dispatch instrumentation
+// ringbuffers exported by instrumented programs (via their
+// `__query_instruments` functions), transfers newly written bytes to the host
+// on a dedicated drain thread, and hands them to a caller-provided sink.
+
+// Receives newly written instrument ringbuffer bytes.
+//
+// |source_ordinal| identifies the ringbuffer within the context (stable for
+// the lifetime of the stream) and |stream_offset| is the monotonically
+// increasing byte offset of |data| within that ringbuffer's logical stream.
+// The data storage is only valid for the duration of the call and must be
+// copied if retained. Contents follow the iree_instrument_dispatch_* record
+// layout from iree/schemas/instruments/dispatch.h.
+//
+// Called from the drain thread; returning an error stops the stream.
+typedef struct iree_tooling_instrument_sink_t {
+  iree_status_t(IREE_API_PTR* fn)(void* user_data,
+                                  iree_host_size_t source_ordinal,
+                                  uint64_t stream_offset,
+                                  iree_const_byte_span_t data);
+  void* user_data;
+} iree_tooling_instrument_sink_t;
+
+typedef struct iree_tooling_instrument_stream_t
+    iree_tooling_instrument_stream_t;
+
+// Creates a stream draining the instrument ringbuffers of |context|.
+//
+// All modules currently in |context| are queried for instrument buffers and
+// each dispatch ringbuffer found becomes a stream source drained through
+// |device| with queue-ordered transfers. The drain thread wakes every
+// |poll_interval_ns| to deliver newly written bytes to |sink|; note that
+// ranges overwritten by the device between polls are dropped (the producers
+// never block on the consumer) and that records spilling into the ringbuffer
+// padding region are truncated at the ringbuffer boundary as with the
+// post-mortem tooling.
+//
+// Programs without instrumentation yield a valid stream with no sources.
+// |out_stream| must be freed by the caller with
+// iree_tooling_instrument_stream_free.
+iree_status_t iree_tooling_instrument_stream_create(
+    iree_vm_context_t* context, iree_hal_device_t* device,
+    iree_duration_t poll_interval_ns, iree_tooling_instrument_sink_t sink,
+    iree_allocator_t host_allocator,
+    iree_tooling_instrument_stream_t** out_stream);
+
+// Stops the drain thread and frees |stream|.
+// Performs one final drain so that all bytes written before the call are
+// delivered to the sink. Returns the terminal status of the drain thread
+// (such as a transfer failure or an error returned by the sink); the stream
+// is freed regardless.
+iree_status_t iree_tooling_instrument_stream_free(
+    iree_tooling_instrument_stream_t* stream);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // IREE_TOOLING_INSTRUMENT_STREAM_H_
@@ -97,6 +97,19 @@ IREE_API_EXPORT iree_status_t iree_numpy_npy_save_ndarray(
     iree_io_stream_t* stream, iree_numpy_npy_save_options_t options,
     iree_hal_buffer_view_t* buffer_view, iree_allocator_t host_allocator);
 
+// Saves |buffer_view| to the .npy file at |path| by memory-mapping the
+// destination range and copying the array contents directly into the mapping.
+// This avoids the intermediate stream buffering of iree_numpy_npy_save_ndarray
+// and is preferred when dumping large tensors. When |append| is true the
+// ndarray is concatenated after any existing file contents, matching the
+// stream-based save behavior on an appending stream.
+//
+// Returns IREE_STATUS_UNIMPLEMENTED on platforms without memory mapping
+// support; callers should fall back to the stream-based save.
+IREE_API_EXPORT iree_status_t iree_numpy_npy_save_ndarray_mapped(
+    iree_string_view_t path, bool append, iree_numpy_npy_save_options_t options,
+    iree_hal_buffer_view_t* buffer_view, iree_allocator_t host_allocator);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -382,6 +382,63 @@ TEST_F(NumpyIOTest, RoundTripMultipleArrays) {
   CompareStreams(source_stream.get(), target_stream.get());
 }
 
+// Tests that the memory-mapped save produces byte-identical output to the
+// stream-based save, including when appending multiple arrays to one file.
+TEST_F(NumpyIOTest, MappedSaveMatchesStreamSave) {
+  auto source_stream = OpenInputFile("multiple.npy");
+  auto target_stream = OpenOutputFile("multiple_out.npy");
+
+  std::string path = ::testing::TempDir() + "/numpy_io_mapped_save.npy";
+  remove(path.c_str());
+  bool append = false;
+  while (!iree_io_stream_is_eos(source_stream.get())) {
+    iree_hal_buffer_params_t buffer_params = {};
+    buffer_params.usage = IREE_HAL_BUFFER_USAGE_TRANSFER;
+    buffer_params.access = IREE_HAL_MEMORY_ACCESS_READ;
+    buffer_params.type = IREE_HAL_MEMORY_TYPE_HOST_LOCAL;
+    iree_hal_buffer_view_t* buffer_view = NULL;
+    IREE_ASSERT_OK(iree_numpy_npy_load_ndarray(
+        source_stream.get(), IREE_NUMPY_NPY_LOAD_OPTION_DEFAULT, buffer_params,
+        device_, device_allocator_, &buffer_view));
+    IREE_ASSERT_OK(iree_numpy_npy_save_ndarray(
+        target_stream.get(), IREE_NUMPY_NPY_SAVE_OPTION_DEFAULT, buffer_view,
+        iree_allocator_system()));
+    iree_status_t status = iree_numpy_npy_save_ndarray_mapped(
+        iree_make_string_view(path.data(), path.size()), append,
+        IREE_NUMPY_NPY_SAVE_OPTION_DEFAULT, buffer_view,
+        iree_allocator_system());
+    iree_hal_buffer_view_release(buffer_view);
+    if (iree_status_is_unimplemented(status)) {
+      iree_status_free(status);
+      GTEST_SKIP() << "platform has no memory mapping support";
+    }
+    IREE_ASSERT_OK(status);
+    append = true;
+  }
+
+  // Read the mapped file back and compare against the stream-based bytes.
+  FILE* file = fopen(path.c_str(), "rb");
+  ASSERT_NE(file, nullptr);
+  fseek(file, 0, SEEK_END);
+  std::vector<uint8_t> mapped_data;
+  mapped_data.resize(ftell(file));
+  fseek(file, 0, SEEK_SET);
+  ASSERT_EQ(fread(mapped_data.data(), 1, mapped_data.size(), file),
+            mapped_data.size());
+  fclose(file);
+  remove(path.c_str());
+
+  iree_io_stream_pos_t target_size = iree_io_stream_length(target_stream.get());
+  ASSERT_EQ(mapped_data.size(), target_size);
+  IREE_ASSERT_OK(
+      iree_io_stream_seek(target_stream.get(), IREE_IO_STREAM_SEEK_SET, 0));
+  std::vector<uint8_t> target_data;
+  target_data.resize(target_size);
+  IREE_ASSERT_OK(iree_io_stream_read(target_stream.get(), target_data.size(),
+                                     target_data.data(), NULL));
+  ASSERT_THAT(mapped_data, ElementsAreArray(target_data));
+}
+
 // Tests round-tripping arrays with various shapes.
 TEST_F(NumpyIOTest, RoundTripArrayShapes) {
   auto source_stream = OpenInputFile("array_shapes.npy");
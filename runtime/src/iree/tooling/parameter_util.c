@@ -20,11 +20,16 @@
 
 IREE_FLAG(
     string, parameter_mode, "mmap",
-    "A parameter I/O mode of ['preload', 'mmap'].\n"
+    "A parameter I/O mode of ['preload', 'mmap', 'mmap-random'].\n"
     "  preload: read entire parameter files into wired memory on startup.\n"
     "  mmap: maps the parameter files into discardable memory - can increase\n"
     "        warm-up time and variance as mapped pages are swapped\n"
-    "        by the OS.");
+    "        by the OS.\n"
+    "  mmap-random: as with mmap but advises the OS that access will be\n"
+    "        sparse and in arbitrary order, disabling readahead; use when\n"
+    "        serving many large parameter files of which only a subset is\n"
+    "        expected to be touched so resident memory stays proportional\n"
+    "        to use.");
 
 static void iree_file_contents_release_callback(
     void* user_data, iree_io_file_handle_primitive_t handle_primitive) {
@@ -47,6 +52,8 @@ static iree_status_t iree_io_open_parameter_file(
   iree_file_read_flags_t read_flags = 0;
   if (strcmp(FLAG_parameter_mode, "mmap") == 0) {
     read_flags |= IREE_FILE_READ_FLAG_MMAP;
+  } else if (strcmp(FLAG_parameter_mode, "mmap-random") == 0) {
+    read_flags |= IREE_FILE_READ_FLAG_MMAP | IREE_FILE_READ_FLAG_RANDOM_ACCESS;
   } else if (strcmp(FLAG_parameter_mode, "preload") == 0) {
     read_flags |= IREE_FILE_READ_FLAG_PRELOAD;
   } else {
@@ -93,57 +100,61 @@ IREE_FLAG_LIST(
     "- .gguf (https://github.com/ggerganov/ggml/blob/master/docs/gguf.md)\n"
     "- .safetensors (https://github.com/huggingface/safetensors)");
 
-// Appends the parameter file located at |path| to |index|.
-static iree_status_t iree_io_append_parameter_file_to_index(
-    iree_string_view_t path, iree_io_parameter_index_t* index,
-    iree_allocator_t host_allocator) {
-  IREE_ASSERT_ARGUMENT(index);
-  IREE_TRACE_ZONE_BEGIN(z0);
-
-  // Open the file.
-  iree_io_file_handle_t* file_handle = NULL;
-  IREE_RETURN_AND_END_ZONE_IF_ERROR(
-      z0, iree_io_open_parameter_file(path, host_allocator, &file_handle));
-
-  // Index the file based on its (inferred) format.
-  iree_status_t status = iree_io_parse_file_index(path, file_handle, index);
-
-  // Release our file reference - it's still retained by the index if it had any
-  // parameters in it.
-  iree_io_file_handle_release(file_handle);
-
-  IREE_TRACE_ZONE_END(z0);
-  return status;
+// Parses the parameter file in |file_handle| and appends it to |index|.
+// Called concurrently for independent files during enrollment.
+static iree_status_t iree_tooling_parse_parameter_file(
+    void* user_data, iree_string_view_t path,
+    iree_io_file_handle_t* file_handle, iree_io_parameter_index_t* index) {
+  return iree_io_parse_file_index(path, file_handle, index);
 }
 
 iree_status_t iree_tooling_build_parameter_indices_from_flags(
     iree_io_scope_map_t* scope_map) {
+  iree_host_size_t file_count = FLAG_parameters_list().count;
+  if (!file_count) return iree_ok_status();
   IREE_TRACE_ZONE_BEGIN(z0);
 
-  // Create one index per scope and add parameters to each.
-  for (iree_host_size_t i = 0; i < FLAG_parameters_list().count; ++i) {
+  // Open all parameter files up-front; enrollment will parse the independent
+  // files concurrently.
+  iree_io_scope_map_file_t* files = (iree_io_scope_map_file_t*)iree_alloca(
+      file_count * sizeof(iree_io_scope_map_file_t));
+  iree_status_t status = iree_ok_status();
+  iree_host_size_t open_count = 0;
+  for (; open_count < file_count; ++open_count) {
     // Parse the `scope=path` flag. Note that the scope is optional.
-    iree_string_view_t flag = FLAG_parameters_list().values[i];
+    iree_string_view_t flag = FLAG_parameters_list().values[open_count];
     iree_string_view_t scope, path;
     if (iree_string_view_split(flag, '=', &scope, &path) == -1) {
       // No scope provided (that's ok).
       path = scope;
       scope = iree_string_view_empty();
     }
+    files[open_count].scope = scope;
+    files[open_count].path = path;
+    status = iree_io_open_parameter_file(path, scope_map->host_allocator,
+                                         &files[open_count].file_handle);
+    if (!iree_status_is_ok(status)) break;
+  }
 
-    // Lookup (or create) the index for the given scope.
-    iree_io_parameter_index_t* index = NULL;  // unowned
-    IREE_RETURN_AND_END_ZONE_IF_ERROR(
-        z0, iree_io_scope_map_lookup(scope_map, scope, &index));
+  // Create one index per scope and parse each file's parameters into the
+  // index of its scope.
+  if (iree_status_is_ok(status)) {
+    iree_io_scope_map_parser_t parser = {
+        .fn = iree_tooling_parse_parameter_file,
+        .user_data = NULL,
+    };
+    status = iree_io_scope_map_enroll_files(scope_map, file_count, files,
+                                            parser, /*max_concurrency=*/0);
+  }
 
-    // Index the file.
-    IREE_RETURN_AND_END_ZONE_IF_ERROR(
-        z0, iree_io_append_parameter_file_to_index(path, index,
-                                                   scope_map->host_allocator));
+  // Release our file references - they're still retained by the indices that
+  // had any parameters in them.
+  for (iree_host_size_t i = 0; i < open_count; ++i) {
+    iree_io_file_handle_release(files[i].file_handle);
   }
 
   IREE_TRACE_ZONE_END(z0);
-  return iree_ok_status();
+  return status;
 }
 
 iree_status_t iree_tooling_create_parameters_module_from_flags(
@@ -6,6 +6,13 @@
 
 #include "iree/tooling/run_module.h"
 
+#if !defined(IREE_PLATFORM_WINDOWS)
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif  // !IREE_PLATFORM_WINDOWS
+
 #include "iree/base/api.h"
 #include "iree/base/internal/flags.h"
 #include "iree/hal/api.h"
@@ -91,6 +98,25 @@ IREE_FLAG(
 IREE_FLAG(bool, print_statistics, false,
           "Prints runtime statistics to stderr on exit.");
 
+IREE_FLAG(
+    string, serve, "",
+    "Runs as a persistent server instead of performing a single invocation.\n"
+    "Modules are loaded and the device/context created once and then\n"
+    "invocation requests are accepted over a unix domain socket at the given\n"
+    "path. Each request is a sequence of `--function=`/`--input=` lines using\n"
+    "the same syntax as the command line flags, terminated by an empty line:\n"
+    "  $ printf -- '--function=abs\\n--input=f32=-5\\n\\n' | nc -U /tmp/run.sock\n"
+    "Results are written back over the socket followed by a trailer line\n"
+    "`OK <exit_code> invoke_ms=<t> request_ms=<t>` (or `ERROR` on failure)\n"
+    "so per-invocation timing can be tracked separately from setup cost.\n"
+    "A request consisting of the single line `quit` shuts the server down.");
+
+IREE_FLAG(
+    int32_t, serve_pool_size, 1,
+    "Number of warm contexts to preload when running with --serve=. Requests\n"
+    "are assigned round-robin so stateful programs (mutable globals, etc)\n"
+    "rotate across contexts instead of accumulating in one.");
+
 static iree_status_t iree_tooling_process_results(
     iree_hal_device_t* device, iree_string_view_t results_cconv,
     iree_vm_list_t* results, iree_io_stream_t* stream,
@@ -198,8 +224,12 @@ static iree_status_t iree_tooling_annotate_status_with_function_decl(
 
 static iree_status_t iree_tooling_run_function(
     iree_vm_context_t* context, iree_vm_function_t function,
+    const iree_flag_string_list_t input_list, FILE* output_file,
     iree_hal_device_t* device, iree_hal_allocator_t* device_allocator,
-    iree_allocator_t host_allocator, int* out_exit_code) {
+    iree_allocator_t host_allocator, iree_time_t* out_invoke_duration_ns,
+    int* out_exit_code) {
+  if (out_invoke_duration_ns) *out_invoke_duration_ns = 0;
+
   iree_string_view_t function_name = iree_vm_function_name(&function);
   (void)function_name;
 
@@ -213,7 +243,7 @@ static iree_status_t iree_tooling_run_function(
   iree_vm_list_t* inputs = NULL;
   if (iree_status_is_ok(status)) {
     status = iree_status_annotate_f(
-        iree_tooling_parse_variants(arguments_cconv, FLAG_input_list(), device,
+        iree_tooling_parse_variants(arguments_cconv, input_list, device,
                                     device_allocator, host_allocator, &inputs),
         "parsing function inputs");
   }
@@ -236,9 +266,9 @@ static iree_status_t iree_tooling_run_function(
 
   // TODO(benvanik): move behind a --verbose flag and add more logging.
   if (iree_status_is_ok(status)) {
-    fprintf(stdout, "EXEC @%.*s\n", (int)function_name.size,
+    fprintf(output_file, "EXEC @%.*s\n", (int)function_name.size,
             function_name.data);
-    fflush(stdout);
+    fflush(output_file);
   }
 
   // Begin profiling immediate prior to invocation.
@@ -248,6 +278,7 @@ static iree_status_t iree_tooling_run_function(
   }
 
   // Invoke the function with the provided inputs.
+  iree_time_t invoke_start_ns = iree_time_now();
   if (iree_status_is_ok(status)) {
     status = iree_status_annotate_f(
         iree_vm_invoke(context, function, IREE_VM_INVOCATION_FLAG_NONE,
@@ -264,6 +295,9 @@ static iree_status_t iree_tooling_run_function(
         "waiting on finish fence");
   }
   iree_hal_fence_release(finish_fence);
+  if (iree_status_is_ok(status) && out_invoke_duration_ns) {
+    *out_invoke_duration_ns = iree_time_now() - invoke_start_ns;
+  }
 
   // End profiling after waiting for the invocation to finish.
   if (iree_status_is_ok(status)) {
@@ -294,14 +328,14 @@ static iree_status_t iree_tooling_run_function(
         /*wait_fence=*/NULL, /*signal_fence=*/NULL);
   }
 
-  // Wrap stdout for printing results.
-  iree_io_stream_t* stdout_stream = NULL;
+  // Wrap the output file (stdout or a server connection) for printing results.
+  iree_io_stream_t* output_stream = NULL;
   if (iree_status_is_ok(status)) {
     status = iree_status_annotate_f(
-        iree_io_stdio_stream_wrap(IREE_IO_STREAM_MODE_WRITABLE, stdout,
+        iree_io_stdio_stream_wrap(IREE_IO_STREAM_MODE_WRITABLE, output_file,
                                   /*owns_handle=*/false, host_allocator,
-                                  &stdout_stream),
-        "opening stdout stream");
+                                  &output_stream),
+        "opening output stream");
   }
 
   // Handle either printing/writing the outputs or checking them against
@@ -309,14 +343,14 @@ static iree_status_t iree_tooling_run_function(
   if (iree_status_is_ok(status)) {
     status = iree_status_annotate_f(
         iree_tooling_process_results(device, results_cconv, outputs,
-                                     stdout_stream, host_allocator,
+                                     output_stream, host_allocator,
                                      out_exit_code),
         "processing function outputs");
   }
   iree_vm_list_release(outputs);
 
-  iree_io_stream_release(stdout_stream);
-  fflush(stdout);
+  iree_io_stream_release(output_stream);
+  fflush(output_file);
 
   return status;
 }
@@ -381,6 +415,315 @@ static iree_status_t iree_tooling_process_results(
   return status;
 }
 
+//===----------------------------------------------------------------------===//
+// Warm server mode (--serve=)
+//===----------------------------------------------------------------------===//
+// Amortizes module loading and device/context creation across many
+// invocations: a pool of contexts is created once at startup and invocation
+// requests are then served over a unix domain socket. Batch harnesses that
+// would otherwise launch the tool per invocation pay the cold start exactly
+// once and get per-invocation timing in each response trailer.
+
+#if defined(IREE_PLATFORM_WINDOWS)
+
+static iree_status_t iree_tooling_serve_module_with_data(
+    iree_vm_instance_t* instance, iree_string_view_t default_device_uri,
+    iree_const_byte_span_t module_contents, iree_allocator_t host_allocator,
+    int* out_exit_code) {
+  return iree_make_status(
+      IREE_STATUS_UNIMPLEMENTED,
+      "--serve= requires a platform with unix domain socket support");
+}
+
+#else
+
+// One warm entry in the serving pool. Each entry owns a full context (and
+// device) so that per-context state from one request cannot alias another
+// entry's state.
+typedef struct iree_tooling_serve_context_t {
+  iree_vm_context_t* context;
+  iree_vm_function_t default_function;
+  iree_hal_device_t* device;
+  iree_hal_allocator_t* device_allocator;
+} iree_tooling_serve_context_t;
+
+// Reads one request from |fd|: a sequence of non-empty lines terminated by an
+// empty line. |out_have_request| is false if the peer closed the connection
+// before completing a request. The returned buffer (always allocated) retains
+// the '\n' separators between lines and must be freed by the caller.
+static iree_status_t iree_tooling_serve_read_request(
+    int fd, iree_allocator_t host_allocator, char** out_buffer,
+    iree_host_size_t* out_length, bool* out_have_request) {
+  *out_buffer = NULL;
+  *out_length = 0;
+  *out_have_request = false;
+  iree_host_size_t capacity = 512;
+  char* buffer = NULL;
+  IREE_RETURN_IF_ERROR(
+      iree_allocator_malloc(host_allocator, capacity, (void**)&buffer));
+  iree_host_size_t length = 0;
+  for (;;) {
+    if (length + 1 > capacity) {
+      capacity *= 2;
+      iree_status_t status =
+          iree_allocator_realloc(host_allocator, capacity, (void**)&buffer);
+      if (!iree_status_is_ok(status)) {
+        iree_allocator_free(host_allocator, buffer);
+        return status;
+      }
+    }
+    // Requests are tiny control-plane traffic so a byte-at-a-time read keeps
+    // the framing trivial without a connection-local read buffer.
+    char c = 0;
+    ssize_t bytes_read = read(fd, &c, 1);
+    if (bytes_read <= 0) break;  // EOF/reset: drop any partial request.
+    if (c == '\r') continue;
+    if (c == '\n') {
+      if (length == 0) continue;  // Ignore leading empty lines.
+      if (buffer[length - 1] == '\n') {
+        // Empty line: end of request.
+        *out_have_request = true;
+        break;
+      }
+    }
+    buffer[length++] = c;
+  }
+  *out_buffer = buffer;
+  *out_length = length;
+  return iree_ok_status();
+}
+
+// Parses request lines into the function name override (if any) and input
+// values. |input_values| must have capacity for one value per request line.
+static iree_status_t iree_tooling_serve_parse_request(
+    iree_string_view_t request, iree_string_view_t* out_function_name,
+    iree_string_view_t* input_values, iree_host_size_t* out_input_count,
+    bool* out_quit) {
+  *out_function_name = iree_string_view_empty();
+  *out_input_count = 0;
+  *out_quit = false;
+  iree_string_view_t remaining = request;
+  while (!iree_string_view_is_empty(remaining)) {
+    iree_string_view_t line = iree_string_view_empty();
+    iree_string_view_split(remaining, '\n', &line, &remaining);
+    if (iree_string_view_is_empty(line)) continue;
+    if (iree_string_view_equal(line, IREE_SV("quit"))) {
+      *out_quit = true;
+      return iree_ok_status();
+    } else if (iree_string_view_consume_prefix(&line, IREE_SV("--function="))) {
+      *out_function_name = line;
+    } else if (iree_string_view_consume_prefix(&line, IREE_SV("--input="))) {
+      input_values[(*out_input_count)++] = line;
+    } else {
+      return iree_make_status(
+          IREE_STATUS_INVALID_ARGUMENT,
+          "unrecognized request line `%.*s`; expected --function=/--input=",
+          (int)line.size, line.data);
+    }
+  }
+  return iree_ok_status();
+}
+
+// Serves requests on |client_fd| until the peer disconnects or requests
+// shutdown. Request failures are reported to the client and do not take down
+// the server; only transport/allocation failures propagate.
+static iree_status_t iree_tooling_serve_handle_connection(
+    int client_fd, iree_tooling_serve_context_t* pool,
+    iree_host_size_t pool_size, iree_host_size_t* next_entry,
+    iree_allocator_t host_allocator, bool* out_quit) {
+  FILE* stream = fdopen(dup(client_fd), "w");
+  if (!stream) {
+    return iree_make_status(IREE_STATUS_INTERNAL,
+                            "opening connection stream (errno=%d)", errno);
+  }
+
+  iree_status_t status = iree_ok_status();
+  while (iree_status_is_ok(status) && !*out_quit) {
+    char* request_buffer = NULL;
+    iree_host_size_t request_length = 0;
+    bool have_request = false;
+    status = iree_tooling_serve_read_request(
+        client_fd, host_allocator, &request_buffer, &request_length,
+        &have_request);
+    if (!iree_status_is_ok(status) || !have_request) {
+      iree_allocator_free(host_allocator, request_buffer);
+      break;
+    }
+    iree_string_view_t request =
+        iree_make_string_view(request_buffer, request_length);
+
+    // Parse the request into a function override and input values. At most
+    // one value per line so the line count bounds the required capacity.
+    iree_host_size_t line_capacity = 1;
+    for (iree_host_size_t i = 0; i < request_length; ++i) {
+      if (request_buffer[i] == '\n') ++line_capacity;
+    }
+    iree_string_view_t* input_values = NULL;
+    status = iree_allocator_malloc(host_allocator,
+                                   line_capacity * sizeof(*input_values),
+                                   (void**)&input_values);
+    if (!iree_status_is_ok(status)) {
+      iree_allocator_free(host_allocator, request_buffer);
+      break;
+    }
+    iree_string_view_t function_name = iree_string_view_empty();
+    iree_host_size_t input_count = 0;
+    iree_status_t request_status = iree_tooling_serve_parse_request(
+        request, &function_name, input_values, &input_count, out_quit);
+    if (*out_quit) {
+      fprintf(stream, "OK quitting\n");
+      iree_allocator_free(host_allocator, input_values);
+      iree_allocator_free(host_allocator, request_buffer);
+      break;
+    }
+
+    // Take the next warm context round-robin and resolve the function to
+    // invoke (the setup-time --function= unless overridden per-request).
+    iree_tooling_serve_context_t* entry = &pool[*next_entry];
+    *next_entry = (*next_entry + 1) % pool_size;
+    iree_vm_function_t function = entry->default_function;
+    if (iree_status_is_ok(request_status) &&
+        !iree_string_view_is_empty(function_name)) {
+      request_status = iree_status_annotate_f(
+          iree_vm_module_lookup_function_by_name(
+              entry->default_function.module, IREE_VM_FUNCTION_LINKAGE_EXPORT,
+              function_name, &function),
+          "looking up function '%.*s'", (int)function_name.size,
+          function_name.data);
+    }
+
+    // Run the invocation against the warm context, timing the request end to
+    // end and the invocation alone.
+    int exit_code = EXIT_SUCCESS;
+    iree_time_t invoke_duration_ns = 0;
+    iree_time_t request_start_ns = iree_time_now();
+    if (iree_status_is_ok(request_status)) {
+      const iree_flag_string_list_t input_list = {input_count, input_values};
+      request_status = iree_tooling_run_function(
+          entry->context, function, input_list, stream, entry->device,
+          entry->device_allocator, host_allocator, &invoke_duration_ns,
+          &exit_code);
+    }
+    iree_time_t request_duration_ns = iree_time_now() - request_start_ns;
+    if (iree_status_is_ok(request_status)) {
+      fprintf(stream, "OK %d invoke_ms=%.3f request_ms=%.3f\n", exit_code,
+              invoke_duration_ns / 1.0e6, request_duration_ns / 1.0e6);
+    } else {
+      request_status = iree_tooling_annotate_status_with_function_decl(
+          request_status, function);
+      iree_status_fprint(stream, request_status);
+      iree_status_free(request_status);
+      fprintf(stream, "ERROR\n");
+    }
+    fflush(stream);
+
+    iree_allocator_free(host_allocator, input_values);
+    iree_allocator_free(host_allocator, request_buffer);
+  }
+
+  fclose(stream);
+  return status;
+}
+
+static iree_status_t iree_tooling_serve_module_with_data(
+    iree_vm_instance_t* instance, iree_string_view_t default_device_uri,
+    iree_const_byte_span_t module_contents, iree_allocator_t host_allocator,
+    int* out_exit_code) {
+  if (FLAG_serve_pool_size < 1) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "--serve_pool_size= must be at least 1");
+  }
+  iree_host_size_t pool_size = (iree_host_size_t)FLAG_serve_pool_size;
+
+  // Preload the pool of warm contexts; this is the cold start cost that
+  // server mode amortizes across all subsequent requests.
+  iree_time_t setup_start_ns = iree_time_now();
+  iree_tooling_serve_context_t* pool = NULL;
+  IREE_RETURN_IF_ERROR(iree_allocator_malloc(
+      host_allocator, pool_size * sizeof(*pool), (void**)&pool));
+  iree_status_t status = iree_ok_status();
+  iree_host_size_t initialized_count = 0;
+  for (iree_host_size_t i = 0; i < pool_size; ++i) {
+    status = iree_status_annotate_f(
+        iree_tooling_create_run_context(
+            instance, default_device_uri, module_contents, host_allocator,
+            &pool[i].context, &pool[i].default_function, &pool[i].device,
+            &pool[i].device_allocator),
+        "creating warm context %" PRIhsz, i);
+    if (!iree_status_is_ok(status)) break;
+    ++initialized_count;
+  }
+
+  // Bind the unix domain socket, replacing any stale file at the path.
+  int listen_fd = -1;
+  if (iree_status_is_ok(status)) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(FLAG_serve) >= sizeof(address.sun_path)) {
+      status = iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                                "--serve= socket path `%s` exceeds the "
+                                "platform path limit of %" PRIhsz " chars",
+                                FLAG_serve,
+                                (iree_host_size_t)sizeof(address.sun_path) - 1);
+    } else {
+      memcpy(address.sun_path, FLAG_serve, strlen(FLAG_serve));
+      unlink(FLAG_serve);
+      listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+      if (listen_fd < 0 ||
+          bind(listen_fd, (struct sockaddr*)&address, sizeof(address)) != 0 ||
+          listen(listen_fd, /*backlog=*/4) != 0) {
+        status = iree_make_status(IREE_STATUS_INTERNAL,
+                                  "binding server socket `%s` (errno=%d)",
+                                  FLAG_serve, errno);
+      }
+    }
+  }
+
+  // Report readiness with the setup cost so harnesses can subtract it from
+  // any end-to-end measurements (and know when to start connecting).
+  if (iree_status_is_ok(status)) {
+    fprintf(stdout, "SERVE %s contexts=%" PRIhsz " setup_ms=%.3f\n", FLAG_serve,
+            pool_size, (iree_time_now() - setup_start_ns) / 1.0e6);
+    fflush(stdout);
+  }
+
+  // Serve connections one at a time until a `quit` request arrives.
+  iree_host_size_t next_entry = 0;
+  bool quit = false;
+  while (iree_status_is_ok(status) && !quit) {
+    int client_fd = accept(listen_fd, NULL, NULL);
+    if (client_fd < 0) {
+      if (errno == EINTR) continue;
+      status = iree_make_status(IREE_STATUS_INTERNAL,
+                                "accepting connection (errno=%d)", errno);
+      break;
+    }
+    status = iree_tooling_serve_handle_connection(
+        client_fd, pool, pool_size, &next_entry, host_allocator, &quit);
+    close(client_fd);
+  }
+
+  if (listen_fd >= 0) close(listen_fd);
+  unlink(FLAG_serve);
+  for (iree_host_size_t i = 0; i < initialized_count; ++i) {
+    iree_vm_context_release(pool[i].context);
+    if (pool[i].device_allocator && FLAG_print_statistics) {
+      IREE_IGNORE_ERROR(
+          iree_hal_allocator_statistics_fprint(stderr,
+                                               pool[i].device_allocator));
+    }
+    iree_hal_allocator_release(pool[i].device_allocator);
+    iree_hal_device_release(pool[i].device);
+  }
+  iree_allocator_free(host_allocator, pool);
+
+  *out_exit_code = EXIT_SUCCESS;
+  return status;
+}
+
+#endif  // IREE_PLATFORM_WINDOWS
+
 iree_status_t iree_tooling_run_module_from_flags(
     iree_vm_instance_t* instance, iree_allocator_t host_allocator,
     int* out_exit_code) {
@@ -393,6 +736,13 @@ iree_status_t iree_tooling_run_module_with_data(
     iree_vm_instance_t* instance, iree_string_view_t default_device_uri,
     iree_const_byte_span_t module_contents, iree_allocator_t host_allocator,
     int* out_exit_code) {
+  // Persistent server mode: load once, then serve invocations over a socket.
+  if (strlen(FLAG_serve) != 0) {
+    return iree_tooling_serve_module_with_data(instance, default_device_uri,
+                                               module_contents, host_allocator,
+                                               out_exit_code);
+  }
+
   IREE_TRACE_ZONE_BEGIN(z0);
 
   // Setup the VM context with all required modules and get the function to run.
@@ -409,9 +759,9 @@ iree_status_t iree_tooling_run_module_with_data(
       "creating run context");
 
   // Parse inputs, run the function, and process outputs.
-  iree_status_t status =
-      iree_tooling_run_function(context, function, device, device_allocator,
-                                host_allocator, out_exit_code);
+  iree_status_t status = iree_tooling_run_function(
+      context, function, FLAG_input_list(), stdout, device, device_allocator,
+      host_allocator, /*out_invoke_duration_ns=*/NULL, out_exit_code);
 
   // Annotate errors with the function description.
   if (!iree_status_is_ok(status)) {
@@ -52,12 +52,12 @@ IREE_API_EXPORT iree_status_t
 iree_vm_buffer_map_rw(const iree_vm_buffer_t* buffer, iree_host_size_t offset,
                       iree_host_size_t length, iree_host_size_t alignment,
                       iree_byte_span_t* out_span) {
-  // Buffer requires mutable access.
+  // Buffer requires mutable access; copy-on-write buffers materialize their
+  // private storage here before the caller observes the mapping.
   if (IREE_UNLIKELY(
           !iree_all_bits_set(buffer->access, IREE_VM_BUFFER_ACCESS_MUTABLE))) {
-    return iree_make_status(
-        IREE_STATUS_PERMISSION_DENIED,
-        "buffer is read-only and cannot be mapped for mutation");
+    IREE_RETURN_IF_ERROR(
+        iree_vm_buffer_prepare_write((iree_vm_buffer_t*)buffer));
   }
   return iree_vm_buffer_map(buffer, offset, length, alignment, &out_span->data,
                             &out_span->data_length);
@@ -72,6 +72,7 @@ IREE_API_EXPORT void iree_vm_buffer_initialize(iree_vm_buffer_access_t access,
   out_buffer->access = access;
   out_buffer->data = data;
   out_buffer->allocator = allocator;
+  out_buffer->source = NULL;
 }
 
 IREE_API_EXPORT void iree_vm_buffer_deinitialize(iree_vm_buffer_t* buffer) {
@@ -111,17 +112,75 @@ iree_vm_buffer_create(iree_vm_buffer_access_t access, iree_host_size_t length,
   return iree_ok_status();
 }
 
+// Returns true if |buffer| owns data storage allocated separately from the
+// handle (as materialized by iree_vm_buffer_prepare_write) instead of the
+// usual co-allocated [prefix | data] layout.
+static bool iree_vm_buffer_has_detached_storage(
+    const iree_vm_buffer_t* buffer) {
+  return buffer->data.data !=
+         (uint8_t*)buffer + iree_sizeof_struct(*buffer);
+}
+
 static void iree_vm_buffer_destroy(void* ptr) {
   IREE_TRACE_ZONE_BEGIN(z0);
 
   // Buffers are stored as [prefix | data]; freeing the prefix is all we need
-  // to do to free it all.
+  // to do to free it all. Copy-on-write clones either still alias their
+  // retained source storage or have materialized a detached private copy.
   iree_vm_buffer_t* buffer = (iree_vm_buffer_t*)ptr;
+  iree_vm_buffer_t* source = buffer->source;
+  if (!source && buffer->data.data &&
+      iree_vm_buffer_has_detached_storage(buffer)) {
+    iree_allocator_free_aligned(buffer->allocator, buffer->data.data);
+  }
   iree_allocator_free_aligned(buffer->allocator, buffer);
+  if (source) iree_vm_buffer_release(source);
 
   IREE_TRACE_ZONE_END(z0);
 }
 
+IREE_API_EXPORT iree_status_t
+iree_vm_buffer_prepare_write(iree_vm_buffer_t* buffer) {
+  IREE_ASSERT_ARGUMENT(buffer);
+  if (iree_all_bits_set(buffer->access, IREE_VM_BUFFER_ACCESS_MUTABLE)) {
+    return iree_ok_status();  // already mutable with private storage
+  }
+  if (!iree_all_bits_set(buffer->access,
+                         IREE_VM_BUFFER_ACCESS_COPY_ON_WRITE)) {
+    return iree_make_status(
+        IREE_STATUS_PERMISSION_DENIED,
+        "buffer is read-only and cannot be mapped for mutation");
+  }
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Materialize a private copy of the shared storage. Note that VM buffers
+  // (like all mutation of them) are not thread-safe and we assume the caller
+  // is not concurrently accessing the buffer.
+  uint8_t* data_ptr = NULL;
+  if (buffer->data.data_length > 0) {
+    iree_status_t status = iree_allocator_malloc_aligned(
+        buffer->allocator, buffer->data.data_length, iree_max_align_t, 0,
+        (void**)&data_ptr);
+    if (!iree_status_is_ok(status)) {
+      IREE_TRACE_ZONE_END(z0);
+      return status;
+    }
+    memcpy(data_ptr, buffer->data.data, buffer->data.data_length);
+  }
+
+  // Swap in the private storage and drop the reference keeping the shared
+  // source alive.
+  iree_vm_buffer_t* source = buffer->source;
+  buffer->source = NULL;
+  buffer->data.data = data_ptr;
+  buffer->access = (buffer->access & ~IREE_VM_BUFFER_ACCESS_COPY_ON_WRITE) |
+                   IREE_VM_BUFFER_ACCESS_MUTABLE;
+  if (source) iree_vm_buffer_release(source);
+
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
 IREE_API_EXPORT void iree_vm_buffer_retain(iree_vm_buffer_t* buffer) {
   iree_vm_ref_object_retain(buffer, iree_vm_buffer_type());
 }
@@ -151,6 +210,47 @@ IREE_API_EXPORT iree_status_t iree_vm_buffer_clone(
   // a single allocation.
   iree_host_size_t prefix_size =
       iree_host_align(sizeof(iree_vm_buffer_t), iree_max_align_t);
+
+  // Clones of immutable sources (such as module rodata) can share the source
+  // storage copy-on-write: only the handle is allocated, the source is
+  // retained, and a private copy is materialized if and when the clone is
+  // first written. Mutable sources must be snapshotted now as their contents
+  // may change after the clone returns.
+  const iree_host_size_t required_alignment =
+      alignment ? alignment : iree_max_align_t;
+  if (!iree_all_bits_set(source_buffer->access,
+                         IREE_VM_BUFFER_ACCESS_MUTABLE) &&
+      iree_host_size_has_alignment((iree_host_size_t)(uintptr_t)
+                                       source_span.data,
+                                   required_alignment)) {
+    uint8_t* data_ptr = NULL;
+    IREE_RETURN_AND_END_ZONE_IF_ERROR(
+        z0, iree_allocator_malloc_aligned(allocator, prefix_size,
+                                          iree_max_align_t, 0,
+                                          (void**)&data_ptr));
+    iree_vm_buffer_t* buffer = (iree_vm_buffer_t*)data_ptr;
+    iree_vm_buffer_access_t alias_access =
+        (access & ~IREE_VM_BUFFER_ACCESS_MUTABLE) |
+        (iree_all_bits_set(access, IREE_VM_BUFFER_ACCESS_MUTABLE)
+             ? IREE_VM_BUFFER_ACCESS_COPY_ON_WRITE
+             : 0);
+    iree_vm_buffer_initialize(
+        alias_access,
+        iree_make_byte_span((void*)source_span.data, source_span.data_length),
+        allocator, buffer);
+
+    // Retain whoever owns the storage; if the source is itself an unrealized
+    // clone we share its source directly to keep chains flat.
+    iree_vm_buffer_t* storage_owner = source_buffer->source
+                                          ? source_buffer->source
+                                          : (iree_vm_buffer_t*)source_buffer;
+    iree_vm_buffer_retain(storage_owner);
+    buffer->source = storage_owner;
+
+    *out_buffer = buffer;
+    IREE_TRACE_ZONE_END(z0);
+    return iree_ok_status();
+  }
   iree_host_size_t total_size = prefix_size + source_span.data_length;
 
   // Allocate combined [prefix | buffer] memory.
@@ -188,10 +288,16 @@ IREE_API_EXPORT uint8_t* iree_vm_buffer_data(const iree_vm_buffer_t* buffer) {
 
 IREE_API_EXPORT iree_byte_span_t
 iree_vm_buffer_contents(const iree_vm_buffer_t* buffer) {
-  // Buffer requires mutable access.
-  if (!buffer ||
-      !iree_all_bits_set(buffer->access, IREE_VM_BUFFER_ACCESS_MUTABLE)) {
-    return iree_byte_span_empty();
+  // Buffer requires mutable access; copy-on-write buffers materialize their
+  // private storage first.
+  if (!buffer) return iree_byte_span_empty();
+  if (!iree_all_bits_set(buffer->access, IREE_VM_BUFFER_ACCESS_MUTABLE)) {
+    iree_status_t status =
+        iree_vm_buffer_prepare_write((iree_vm_buffer_t*)buffer);
+    if (!iree_status_is_ok(status)) {
+      iree_status_ignore(status);
+      return iree_byte_span_empty();
+    }
   }
   return iree_make_byte_span(iree_vm_buffer_data(buffer),
                              iree_vm_buffer_length(buffer));
@@ -34,6 +34,13 @@ enum iree_vm_buffer_access_bits_t {
   IREE_VM_BUFFER_ACCESS_ORIGIN_GUEST = 1u << 2,
   // Buffer references external host memory with an unknown lifetime.
   IREE_VM_BUFFER_ACCESS_ORIGIN_HOST = 1u << 3,
+
+  // Buffer shares the storage of another buffer copy-on-write.
+  // The buffer is read-only until the first write materializes a private copy
+  // of the storage, upon which this bit is cleared and
+  // IREE_VM_BUFFER_ACCESS_MUTABLE is set. Managed internally by
+  // iree_vm_buffer_clone; not to be set by callers.
+  IREE_VM_BUFFER_ACCESS_COPY_ON_WRITE = 1u << 4,
 };
 typedef uint32_t iree_vm_buffer_access_t;
 
@@ -63,6 +70,9 @@ typedef struct iree_vm_buffer_t {
   iree_vm_buffer_access_t access;
   iree_byte_span_t data;
   iree_allocator_t allocator;
+  // Retained source buffer when this buffer shares storage copy-on-write
+  // (see IREE_VM_BUFFER_ACCESS_COPY_ON_WRITE); NULL otherwise.
+  struct iree_vm_buffer_t* source;
 } iree_vm_buffer_t;
 
 // Initializes a buffer in-place with the given byte contents.
@@ -114,6 +124,11 @@ IREE_API_EXPORT void iree_vm_buffer_release(iree_vm_buffer_t* buffer);
 // |access| can be used to control who (guest, host, etc) and how (read/write)
 // the buffer may be accessed. As this returns a newly allocated buffer the
 // new access may be more permissive than the source buffer.
+//
+// Clones of immutable source buffers share the source storage copy-on-write
+// instead of eagerly copying: only the handle is allocated and the source is
+// retained until the clone is either destroyed or first written (upon which a
+// private copy of the storage is materialized).
 IREE_API_EXPORT iree_status_t iree_vm_buffer_clone(
     iree_vm_buffer_access_t access, const iree_vm_buffer_t* source_buffer,
     iree_host_size_t source_offset, iree_host_size_t length,
@@ -126,8 +141,10 @@ iree_vm_buffer_length(const iree_vm_buffer_t* buffer);
 
 // Returns the underlying data storage for the buffer.
 // WARNING: this performs no validation of the access allowance on the buffer
-// and the caller is responsible for all range checking. Use with caution and
-// prefer the utility methods instead.
+// and the caller is responsible for all range checking. The storage may be
+// shared copy-on-write with other buffers; callers that intend to write must
+// use iree_vm_buffer_prepare_write first. Use with caution and prefer the
+// utility methods instead.
 IREE_API_EXPORT uint8_t* iree_vm_buffer_data(const iree_vm_buffer_t* buffer);
 
 // Returns the contents of the buffer in mutable form.
@@ -181,6 +198,15 @@ iree_vm_buffer_map_rw(const iree_vm_buffer_t* buffer, iree_host_size_t offset,
                       iree_host_size_t length, iree_host_size_t alignment,
                       iree_byte_span_t* out_span);
 
+// Prepares |buffer| for mutation, materializing a private copy of storage
+// shared copy-on-write with another buffer. No-op if the buffer is already
+// mutable with private storage. Returns IREE_STATUS_PERMISSION_DENIED if the
+// buffer is read-only. Mutation paths (iree_vm_buffer_map_rw and friends) call
+// this automatically; it need only be used with raw iree_vm_buffer_data-style
+// access.
+IREE_API_EXPORT iree_status_t
+iree_vm_buffer_prepare_write(iree_vm_buffer_t* buffer);
+
 // Reads |element_count| elements each of |element_length| bytes from the
 // |source_buffer| into |out_target_ptr|. The |source_offset|, in bytes, must be
 // aligned to at least the |element_length|.
@@ -244,9 +270,9 @@ IREE_API_EXPORT iree_status_t iree_vm_buffer_hash(
   {                                                                         \
     if (IREE_UNLIKELY(!iree_all_bits_set(buffer->access,                    \
                                          IREE_VM_BUFFER_ACCESS_MUTABLE))) { \
-      return iree_make_status(                                              \
-          IREE_STATUS_PERMISSION_DENIED,                                    \
-          "buffer is read-only and cannot be mapped for mutation");         \
+      /* Read-only or a copy-on-write clone that needs materialization. */  \
+      IREE_RETURN_IF_ERROR(                                                 \
+          iree_vm_buffer_prepare_write((iree_vm_buffer_t*)(buffer)));       \
     }                                                                       \
     const iree_host_size_t end =                                            \
         ((element_offset) + (element_length)) * sizeof(element_type);       \
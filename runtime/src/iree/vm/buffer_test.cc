@@ -50,4 +50,65 @@ TEST_F(VMBufferTest, Initialize) {
   ASSERT_TRUE(did_free);
 }
 
+// Tests that clones of immutable buffers share storage until written.
+TEST_F(VMBufferTest, CloneCopyOnWrite) {
+  uint32_t data[] = {0, 1, 2, 3};
+  iree_vm_buffer_t source;
+  iree_vm_buffer_initialize(IREE_VM_BUFFER_ACCESS_ORIGIN_HOST,
+                            iree_make_byte_span(data, sizeof(data)),
+                            iree_allocator_null(), &source);
+
+  // A mutable clone of the immutable source aliases the source storage until
+  // the first write.
+  iree_vm_buffer_t* clone = NULL;
+  IREE_ASSERT_OK(iree_vm_buffer_clone(
+      IREE_VM_BUFFER_ACCESS_MUTABLE | IREE_VM_BUFFER_ACCESS_ORIGIN_HOST,
+      &source, 0, sizeof(data), /*alignment=*/sizeof(uint32_t),
+      iree_allocator_system(), &clone));
+  EXPECT_EQ((uint8_t*)data, iree_vm_buffer_data(clone));
+
+  // Reads go straight to the shared storage.
+  uint32_t value = 0;
+  IREE_ASSERT_OK(iree_vm_buffer_read_elements(clone, 0, &value, 1, 4));
+  EXPECT_EQ(0u, value);
+
+  // The first write materializes a private copy and leaves the source alone.
+  value = 100;
+  IREE_ASSERT_OK(iree_vm_buffer_write_elements(&value, clone, 0, 1, 4));
+  EXPECT_NE((uint8_t*)data, iree_vm_buffer_data(clone));
+  EXPECT_EQ(0u, data[0]);
+  IREE_ASSERT_OK(iree_vm_buffer_read_elements(clone, 0, &value, 1, 4));
+  EXPECT_EQ(100u, value);
+  IREE_ASSERT_OK(iree_vm_buffer_read_elements(clone, 3, &value, 1, 4));
+  EXPECT_EQ(3u, value);
+
+  iree_vm_buffer_release(clone);
+  iree_vm_buffer_deinitialize(&source);
+}
+
+// Tests that read-only clones of immutable buffers stay aliased and deny
+// writes.
+TEST_F(VMBufferTest, CloneImmutableAlias) {
+  uint32_t data[] = {0, 1, 2, 3};
+  iree_vm_buffer_t source;
+  iree_vm_buffer_initialize(IREE_VM_BUFFER_ACCESS_ORIGIN_HOST,
+                            iree_make_byte_span(data, sizeof(data)),
+                            iree_allocator_null(), &source);
+
+  iree_vm_buffer_t* clone = NULL;
+  IREE_ASSERT_OK(iree_vm_buffer_clone(
+      IREE_VM_BUFFER_ACCESS_ORIGIN_HOST, &source, 0, sizeof(data),
+      /*alignment=*/sizeof(uint32_t), iree_allocator_system(), &clone));
+  EXPECT_EQ((uint8_t*)data, iree_vm_buffer_data(clone));
+
+  uint32_t value = 100;
+  iree_status_t status = iree_vm_buffer_write_elements(&value, clone, 0, 1, 4);
+  EXPECT_TRUE(iree_status_is_permission_denied(status));
+  iree_status_free(status);
+  EXPECT_EQ((uint8_t*)data, iree_vm_buffer_data(clone));
+
+  iree_vm_buffer_release(clone);
+  iree_vm_buffer_deinitialize(&source);
+}
+
 }  // namespace
@@ -14,9 +14,13 @@
 extern "C" {
 #endif  // __cplusplus
 
-// Alignment applied to each segment of the archive.
+// Minimum alignment applied to each segment of the archive.
 // All embedded file contents (FlatBuffers, rodata, etc) are aligned to this
-// boundary.
+// boundary. Producers may over-align individual segments - such as
+// page-aligning large rodata so that modules mapped from disk reference the
+// data zero-copy and share clean pages across processes - by padding the
+// FlatBuffer size prefix; the segment base derived from it remains valid
+// either way.
 #define IREE_VM_ARCHIVE_SEGMENT_ALIGNMENT 64
 
 // Parses the module archive header in |archive_contents|.
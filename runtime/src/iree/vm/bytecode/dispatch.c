@@ -105,6 +105,13 @@ static iree_status_t iree_vm_bytecode_function_enter(
   const iree_vm_FunctionDescriptor_t* target_descriptor =
       &module->function_descriptor_table[function.ordinal];
 
+  // Modules created with deferred verification verify each function on first
+  // entry instead of at load time.
+  if (IREE_UNLIKELY(module->verified_bitmap != NULL)) {
+    IREE_RETURN_IF_ERROR(iree_vm_bytecode_module_ensure_function_verified(
+        module, function.ordinal));
+  }
+
   // We first compute the frame size of the callee and the masks we'll use to
   // bounds check register access. This lets us allocate the entire frame
   // (header, frame, and register storage) as a single pointer bump below.
@@ -502,6 +509,9 @@ static iree_status_t iree_vm_bytecode_issue_import_call(
 }
 
 // Verifies that the requested import is valid and returns its table entry.
+// The import table acts as a per-context call-site cache: targets and their
+// marshaling info are resolved once when the module state is created so steady
+// state calls are an index plus a NULL check with no name/ordinal lookups.
 static iree_status_t iree_vm_bytecode_verify_import(
     iree_vm_stack_t* stack, const iree_vm_bytecode_module_state_t* module_state,
     uint32_t import_ordinal, const iree_vm_bytecode_import_t** out_import) {
@@ -513,7 +523,7 @@ static iree_status_t iree_vm_bytecode_verify_import(
 
   const iree_vm_bytecode_import_t* import =
       &module_state->import_table[import_ordinal];
-  if (!import->function.module) {
+  if (IREE_UNLIKELY(!import->function.module)) {
 #if IREE_STATUS_MODE
     iree_vm_function_t decl_function;
     IREE_RETURN_IF_ERROR(iree_vm_module_lookup_function_by_ordinal(
@@ -1390,6 +1400,60 @@ static iree_status_t iree_vm_bytecode_dispatch(
       }
     });
 
+    DISPATCH_OP(CORE, SelectEQI32, {
+      int32_t lhs = VM_DecOperandRegI32("lhs");
+      int32_t rhs = VM_DecOperandRegI32("rhs");
+      int32_t true_value = VM_DecOperandRegI32("true_value");
+      int32_t false_value = VM_DecOperandRegI32("false_value");
+      int32_t* result = VM_DecResultRegI32("result");
+      *result = vm_select_i32(vm_cmp_eq_i32(lhs, rhs), true_value, false_value);
+    });
+
+    DISPATCH_OP(CORE, SelectEQI64, {
+      int64_t lhs = VM_DecOperandRegI64("lhs");
+      int64_t rhs = VM_DecOperandRegI64("rhs");
+      int64_t true_value = VM_DecOperandRegI64("true_value");
+      int64_t false_value = VM_DecOperandRegI64("false_value");
+      int64_t* result = VM_DecResultRegI64("result");
+      *result = vm_select_i64(vm_cmp_eq_i64(lhs, rhs), true_value, false_value);
+    });
+
+    DISPATCH_OP(CORE, SelectLTI32S, {
+      int32_t lhs = VM_DecOperandRegI32("lhs");
+      int32_t rhs = VM_DecOperandRegI32("rhs");
+      int32_t true_value = VM_DecOperandRegI32("true_value");
+      int32_t false_value = VM_DecOperandRegI32("false_value");
+      int32_t* result = VM_DecResultRegI32("result");
+      *result = vm_select_i32(vm_cmp_lt_i32s(lhs, rhs), true_value, false_value);
+    });
+
+    DISPATCH_OP(CORE, SelectLTI64S, {
+      int64_t lhs = VM_DecOperandRegI64("lhs");
+      int64_t rhs = VM_DecOperandRegI64("rhs");
+      int64_t true_value = VM_DecOperandRegI64("true_value");
+      int64_t false_value = VM_DecOperandRegI64("false_value");
+      int64_t* result = VM_DecResultRegI64("result");
+      *result = vm_select_i64(vm_cmp_lt_i64s(lhs, rhs), true_value, false_value);
+    });
+
+    DISPATCH_OP(CORE, SelectLTI32U, {
+      int32_t lhs = VM_DecOperandRegI32("lhs");
+      int32_t rhs = VM_DecOperandRegI32("rhs");
+      int32_t true_value = VM_DecOperandRegI32("true_value");
+      int32_t false_value = VM_DecOperandRegI32("false_value");
+      int32_t* result = VM_DecResultRegI32("result");
+      *result = vm_select_i32(vm_cmp_lt_i32u(lhs, rhs), true_value, false_value);
+    });
+
+    DISPATCH_OP(CORE, SelectLTI64U, {
+      int64_t lhs = VM_DecOperandRegI64("lhs");
+      int64_t rhs = VM_DecOperandRegI64("rhs");
+      int64_t true_value = VM_DecOperandRegI64("true_value");
+      int64_t false_value = VM_DecOperandRegI64("false_value");
+      int64_t* result = VM_DecResultRegI64("result");
+      *result = vm_select_i64(vm_cmp_lt_i64u(lhs, rhs), true_value, false_value);
+    });
+
     DISPATCH_OP(CORE, SwitchI32, {
       int32_t index = VM_DecOperandRegI32("index");
       int32_t default_value = VM_DecOperandRegI32("default_value");
@@ -1616,6 +1680,13 @@ static iree_status_t iree_vm_bytecode_dispatch(
       int32_t block_pc = VM_DecBranchTarget("dest");
       const iree_vm_register_remap_list_t* remap_list =
           VM_DecBranchOperands("operands");
+      // Loop back-edges are the deterministic cancellation poll points: any
+      // non-terminating bytecode program must take one.
+      if (IREE_UNLIKELY((iree_vm_source_offset_t)block_pc < pc) &&
+          IREE_UNLIKELY(iree_vm_stack_is_cancelled(stack))) {
+        return iree_make_status(IREE_STATUS_CANCELLED,
+                                "invocation cancelled by request");
+      }
       pc = block_pc + IREE_VM_BLOCK_MARKER_SIZE;  // skip block marker
       if (IREE_UNLIKELY(remap_list->size > 0)) {
         iree_vm_bytecode_dispatch_remap_branch_registers(regs_i32, regs_ref,
@@ -1631,6 +1702,13 @@ static iree_status_t iree_vm_bytecode_dispatch(
       int32_t false_block_pc = VM_DecBranchTarget("false_dest");
       const iree_vm_register_remap_list_t* false_remap_list =
           VM_DecBranchOperands("false_operands");
+      int32_t taken_block_pc = condition ? true_block_pc : false_block_pc;
+      // As with Branch above only taken back-edges poll for cancellation.
+      if (IREE_UNLIKELY((iree_vm_source_offset_t)taken_block_pc < pc) &&
+          IREE_UNLIKELY(iree_vm_stack_is_cancelled(stack))) {
+        return iree_make_status(IREE_STATUS_CANCELLED,
+                                "invocation cancelled by request");
+      }
       if (condition) {
         pc = true_block_pc + IREE_VM_BLOCK_MARKER_SIZE;  // skip block marker
         if (IREE_UNLIKELY(true_remap_list->size > 0)) {
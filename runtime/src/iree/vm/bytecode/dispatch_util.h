@@ -87,9 +87,13 @@ typedef struct iree_vm_bytecode_frame_storage_t {
 } iree_vm_bytecode_frame_storage_t;
 
 // Maps a type ID to a type def with clamping for out of bounds values.
+// The type table is resolved against the instance type registry once at module
+// load time so this is a single load with no registry lookups or locks on the
+// dispatch hot path; checked ref ops then reduce to one compare against the
+// resolved type.
 static inline iree_vm_type_def_t iree_vm_map_type(
     iree_vm_bytecode_module_t* module, int32_t type_id) {
-  type_id = type_id >= module->type_count ? 0 : type_id;
+  type_id = IREE_UNLIKELY(type_id >= module->type_count) ? 0 : type_id;
   return module->type_table[type_id];
 }
 
@@ -116,7 +120,7 @@ static inline iree_vm_type_def_t iree_vm_map_type(
 #define IREE_DISPATCH_TRACE_INSTRUCTION(...)
 #endif  // IREE_VM_EXECUTION_TRACING_ENABLE
 
-#if defined(IREE_COMPILER_CLANG) && \
+#if (defined(IREE_COMPILER_CLANG) || defined(IREE_COMPILER_GCC)) && \
     IREE_VM_BYTECODE_DISPATCH_COMPUTED_GOTO_ENABLE
 #define IREE_DISPATCH_MODE_COMPUTED_GOTO 1
 #else
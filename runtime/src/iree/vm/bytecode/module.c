@@ -12,6 +12,7 @@
 
 #include "iree/vm/bytecode/archive.h"
 #include "iree/vm/bytecode/module_impl.h"
+#include "iree/vm/bytecode/utils/lz77.h"
 #include "iree/vm/bytecode/verifier.h"
 
 // Perform an strcmp between a FlatBuffers string and an IREE string view.
@@ -153,6 +154,8 @@ static void iree_vm_bytecode_module_destroy(void* self) {
   }
 
   module->def = NULL;
+  iree_allocator_free(module->allocator, module->rodata_storage.data);
+  module->rodata_storage = iree_byte_span_empty();
   iree_allocator_free(module->archive_allocator,
                       (void*)module->archive_contents.data);
   module->archive_contents = iree_const_byte_span_empty();
@@ -792,6 +795,16 @@ IREE_API_EXPORT iree_status_t iree_vm_bytecode_module_create(
     iree_vm_instance_t* instance, iree_const_byte_span_t archive_contents,
     iree_allocator_t archive_allocator, iree_allocator_t allocator,
     iree_vm_module_t** out_module) {
+  return iree_vm_bytecode_module_create_with_flags(
+      instance, IREE_VM_BYTECODE_MODULE_FLAG_NONE, archive_contents,
+      archive_allocator, allocator, out_module);
+}
+
+IREE_API_EXPORT iree_status_t iree_vm_bytecode_module_create_with_flags(
+    iree_vm_instance_t* instance, iree_vm_bytecode_module_flags_t flags,
+    iree_const_byte_span_t archive_contents,
+    iree_allocator_t archive_allocator, iree_allocator_t allocator,
+    iree_vm_module_t** out_module) {
   IREE_TRACE_ZONE_BEGIN(z0);
   IREE_ASSERT_ARGUMENT(out_module);
   *out_module = NULL;
@@ -827,17 +840,67 @@ IREE_API_EXPORT iree_status_t iree_vm_bytecode_module_create(
   size_t type_table_size = iree_host_align(
       iree_vm_TypeDef_vec_len(type_defs) * sizeof(iree_vm_type_def_t), 16);
 
-  iree_host_size_t rodata_ref_count = iree_vm_RodataSegmentDef_vec_len(
-      iree_vm_BytecodeModuleDef_rodata_segments(module_def));
+  iree_vm_RodataSegmentDef_vec_t rodata_segments =
+      iree_vm_BytecodeModuleDef_rodata_segments(module_def);
+  iree_host_size_t rodata_ref_count =
+      iree_vm_RodataSegmentDef_vec_len(rodata_segments);
   size_t rodata_ref_table_size =
       iree_host_align(rodata_ref_count * sizeof(iree_vm_buffer_t), 16);
 
+  // Compressed rodata segments are decompressed into a combined heap
+  // allocation at load time; walk the segment table to size it with each
+  // segment placed at the guaranteed storage alignment.
+  iree_host_size_t rodata_storage_size = 0;
+  for (iree_host_size_t i = 0; i < rodata_ref_count; ++i) {
+    iree_vm_RodataSegmentDef_table_t segment =
+        iree_vm_RodataSegmentDef_vec_at(rodata_segments, i);
+    if (iree_vm_RodataSegmentDef_compression_type_type(segment) !=
+        iree_vm_CompressionTypeDef_LZ77DataDef) {
+      continue;
+    }
+    iree_vm_LZ77DataDef_table_t lz77_def =
+        (iree_vm_LZ77DataDef_table_t)iree_vm_RodataSegmentDef_compression_type(
+            segment);
+    uint64_t uncompressed_length =
+        iree_vm_LZ77DataDef_uncompressed_length(lz77_def);
+    if (uncompressed_length > (uint64_t)IREE_HOST_SIZE_MAX - 64 ||
+        rodata_storage_size >
+            (iree_host_size_t)(IREE_HOST_SIZE_MAX - 64 - uncompressed_length)) {
+      IREE_TRACE_ZONE_END(z0);
+      return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                              "rodata[%" PRIhsz "] uncompressed length %" PRIu64
+                              " exceeds host size range",
+                              i, uncompressed_length);
+    }
+    rodata_storage_size = iree_host_align(
+        rodata_storage_size + (iree_host_size_t)uncompressed_length,
+        IREE_VM_BYTECODE_LZ77_STORAGE_ALIGNMENT);
+  }
+  if (rodata_storage_size > 0) {
+    // Slack so the base pointer can be rounded up to the storage alignment.
+    rodata_storage_size += IREE_VM_BYTECODE_LZ77_STORAGE_ALIGNMENT - 1;
+  }
+
+  // When verification is deferred we need a bitmap tracking which functions
+  // have been verified; zero-initialized by the allocation below.
+  size_t verified_bitmap_size = 0;
+#if IREE_VM_BYTECODE_VERIFICATION_ENABLE
+  if (iree_all_bits_set(flags,
+                        IREE_VM_BYTECODE_MODULE_FLAG_DEFERRED_VERIFICATION)) {
+    iree_host_size_t function_count = iree_vm_FunctionDescriptor_vec_len(
+        iree_vm_BytecodeModuleDef_function_descriptors(module_def));
+    verified_bitmap_size = iree_host_align(
+        (function_count + 31) / 32 * sizeof(iree_atomic_int32_t), 16);
+  }
+#endif  // IREE_VM_BYTECODE_VERIFICATION_ENABLE
+
   iree_vm_bytecode_module_t* module = NULL;
   IREE_RETURN_AND_END_ZONE_IF_ERROR(
-      z0,
-      iree_allocator_malloc(
-          allocator, sizeof(*module) + type_table_size + rodata_ref_table_size,
-          (void**)&module));
+      z0, iree_allocator_malloc(allocator,
+                                sizeof(*module) + type_table_size +
+                                    rodata_ref_table_size +
+                                    verified_bitmap_size,
+                                (void**)&module));
   module->allocator = allocator;
 
   iree_vm_FunctionDescriptor_vec_t function_descriptors =
@@ -886,17 +949,63 @@ IREE_API_EXPORT iree_status_t iree_vm_bytecode_module_create(
   module->interface.begin_call = iree_vm_bytecode_module_begin_call;
   module->interface.resume_call = iree_vm_bytecode_module_resume_call;
 
-  // Setup rodata segments to point directly at the FlatBuffer memory.
+  // Setup rodata segments to point directly at the FlatBuffer memory or, for
+  // compressed segments, at heap storage they are decompressed into here.
   module->rodata_ref_count = rodata_ref_count;
   module->rodata_ref_table =
       (iree_vm_buffer_t*)((uint8_t*)module + sizeof(*module) + type_table_size);
-  iree_vm_RodataSegmentDef_vec_t rodata_segments =
-      iree_vm_BytecodeModuleDef_rodata_segments(module_def);
+  module->verified_bitmap =
+      verified_bitmap_size
+          ? (iree_atomic_int32_t*)((uint8_t*)module + sizeof(*module) +
+                                   type_table_size + rodata_ref_table_size)
+          : NULL;
+  module->rodata_storage = iree_byte_span_empty();
+  if (rodata_storage_size > 0) {
+    uint8_t* rodata_storage_data = NULL;
+    iree_status_t storage_status = iree_allocator_malloc(
+        allocator, rodata_storage_size, (void**)&rodata_storage_data);
+    if (!iree_status_is_ok(storage_status)) {
+      iree_allocator_free(allocator, module);
+      IREE_TRACE_ZONE_END(z0);
+      return storage_status;
+    }
+    module->rodata_storage =
+        iree_make_byte_span(rodata_storage_data, rodata_storage_size);
+  }
+  uint8_t* rodata_storage_ptr =
+      module->rodata_storage.data
+          ? (uint8_t*)iree_host_align((uintptr_t)module->rodata_storage.data,
+                                      IREE_VM_BYTECODE_LZ77_STORAGE_ALIGNMENT)
+          : NULL;
   for (int i = 0; i < module->rodata_ref_count; ++i) {
     iree_vm_RodataSegmentDef_table_t segment =
         iree_vm_RodataSegmentDef_vec_at(rodata_segments, i);
     iree_byte_span_t byte_span = iree_byte_span_empty();
-    if (iree_vm_RodataSegmentDef_embedded_data_is_present(segment)) {
+    if (iree_vm_RodataSegmentDef_compression_type_type(segment) ==
+        iree_vm_CompressionTypeDef_LZ77DataDef) {
+      // Data is compressed; decompress into the combined heap storage.
+      iree_vm_LZ77DataDef_table_t lz77_def =
+          (iree_vm_LZ77DataDef_table_t)
+              iree_vm_RodataSegmentDef_compression_type(segment);
+      flatbuffers_uint8_vec_t compressed_data =
+          iree_vm_RodataSegmentDef_embedded_data(segment);
+      byte_span = iree_make_byte_span(
+          rodata_storage_ptr,
+          (iree_host_size_t)iree_vm_LZ77DataDef_uncompressed_length(lz77_def));
+      rodata_storage_ptr +=
+          iree_host_align(byte_span.data_length,
+                          IREE_VM_BYTECODE_LZ77_STORAGE_ALIGNMENT);
+      iree_status_t decompress_status = iree_vm_bytecode_lz77_decompress(
+          iree_make_const_byte_span(compressed_data,
+                                    flatbuffers_uint8_vec_len(compressed_data)),
+          byte_span);
+      if (!iree_status_is_ok(decompress_status)) {
+        iree_allocator_free(allocator, module->rodata_storage.data);
+        iree_allocator_free(allocator, module);
+        IREE_TRACE_ZONE_END(z0);
+        return decompress_status;
+      }
+    } else if (iree_vm_RodataSegmentDef_embedded_data_is_present(segment)) {
       // Data is embedded in the FlatBuffer.
       byte_span = iree_make_byte_span(
           (uint8_t*)iree_vm_RodataSegmentDef_embedded_data(segment),
@@ -919,19 +1028,60 @@ IREE_API_EXPORT iree_status_t iree_vm_bytecode_module_create(
   // need to do so.
   iree_status_t verify_status = iree_ok_status();
 #if IREE_VM_BYTECODE_VERIFICATION_ENABLE
-  for (uint16_t i = 0; i < module->function_descriptor_count; ++i) {
-    IREE_TRACE_ZONE_BEGIN_NAMED(z1, "iree_vm_bytecode_function_verify");
-    verify_status = iree_vm_bytecode_function_verify(module, i, allocator);
-    IREE_TRACE_ZONE_END(z1);
-    if (!iree_status_is_ok(verify_status)) break;
+  if (!module->verified_bitmap) {
+    for (uint16_t i = 0; i < module->function_descriptor_count; ++i) {
+      IREE_TRACE_ZONE_BEGIN_NAMED(z1, "iree_vm_bytecode_function_verify");
+      verify_status = iree_vm_bytecode_function_verify(module, i, allocator);
+      IREE_TRACE_ZONE_END(z1);
+      if (!iree_status_is_ok(verify_status)) break;
+    }
   }
 #endif  // IREE_VM_BYTECODE_VERIFICATION_ENABLE
   if (iree_status_is_ok(verify_status)) {
     *out_module = &module->interface;
   } else {
+    iree_allocator_free(allocator, module->rodata_storage.data);
     iree_allocator_free(allocator, module);
   }
 
   IREE_TRACE_ZONE_END(z0);
   return verify_status;
 }
+
+iree_status_t iree_vm_bytecode_module_ensure_function_verified(
+    iree_vm_bytecode_module_t* module, iree_host_size_t ordinal) {
+  iree_atomic_int32_t* word = &module->verified_bitmap[ordinal / 32];
+  const int32_t bit = (int32_t)(1u << (ordinal % 32));
+  if (IREE_LIKELY(iree_atomic_load_int32(word, iree_memory_order_acquire) &
+                  bit)) {
+    return iree_ok_status();
+  }
+  IREE_TRACE_ZONE_BEGIN_NAMED(z0, "iree_vm_bytecode_function_verify");
+  iree_status_t status =
+      iree_vm_bytecode_function_verify(module, (uint16_t)ordinal,
+                                       module->allocator);
+  if (iree_status_is_ok(status)) {
+    iree_atomic_fetch_or_int32(word, bit, iree_memory_order_release);
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+IREE_API_EXPORT iree_status_t
+iree_vm_bytecode_module_verify(iree_vm_module_t* base_module) {
+  IREE_ASSERT_ARGUMENT(base_module);
+  iree_vm_bytecode_module_t* module =
+      (iree_vm_bytecode_module_t*)base_module->self;
+  if (!module->verified_bitmap) {
+    // Eagerly-verified modules have nothing left to do.
+    return iree_ok_status();
+  }
+  IREE_TRACE_ZONE_BEGIN(z0);
+  iree_status_t status = iree_ok_status();
+  for (iree_host_size_t i = 0; i < module->function_descriptor_count; ++i) {
+    status = iree_vm_bytecode_module_ensure_function_verified(module, i);
+    if (!iree_status_is_ok(status)) break;
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
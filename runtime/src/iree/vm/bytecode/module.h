@@ -14,6 +14,21 @@
 extern "C" {
 #endif  // __cplusplus
 
+// Flags controlling bytecode module creation behavior.
+enum iree_vm_bytecode_module_flag_bits_t {
+  IREE_VM_BYTECODE_MODULE_FLAG_NONE = 0u,
+  // Defers bytecode verification until each function is first called instead
+  // of verifying all functions during creation. This reduces module load
+  // latency when many functions may never execute in a given session at the
+  // cost of a small first-call overhead per function. Verification failures
+  // are reported from the first call instead of from creation.
+  //
+  // Only use this with trusted modules: eager verification (the default)
+  // ensures a malformed module is rejected before any of it executes.
+  IREE_VM_BYTECODE_MODULE_FLAG_DEFERRED_VERIFICATION = 1u << 0,
+};
+typedef uint32_t iree_vm_bytecode_module_flags_t;
+
 // Creates a VM module from an in-memory ModuleDef FlatBuffer archive.
 // If a |archive_allocator| is provided then it will be used to free the
 // |archive_contents| when the module is destroyed and otherwise the ownership
@@ -23,6 +38,23 @@ IREE_API_EXPORT iree_status_t iree_vm_bytecode_module_create(
     iree_allocator_t archive_allocator, iree_allocator_t allocator,
     iree_vm_module_t** out_module);
 
+// Creates a VM module from an in-memory ModuleDef FlatBuffer archive with the
+// given |flags| controlling creation behavior.
+// See iree_vm_bytecode_module_create for ownership semantics.
+IREE_API_EXPORT iree_status_t iree_vm_bytecode_module_create_with_flags(
+    iree_vm_instance_t* instance, iree_vm_bytecode_module_flags_t flags,
+    iree_const_byte_span_t archive_contents,
+    iree_allocator_t archive_allocator, iree_allocator_t allocator,
+    iree_vm_module_t** out_module);
+
+// Verifies all not-yet-verified functions in |module|.
+// No-op for modules created without deferred verification (they are fully
+// verified at creation). May be called from any thread - including a
+// background worker warming the module while other threads execute it - as
+// verification is read-only and completion is tracked atomically.
+IREE_API_EXPORT iree_status_t
+iree_vm_bytecode_module_verify(iree_vm_module_t* module);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -11,6 +11,7 @@
 #include <string.h>
 
 #include "iree/base/api.h"
+#include "iree/base/internal/atomics.h"
 #include "iree/vm/api.h"
 #include "iree/vm/bytecode/utils/isa.h"
 
@@ -48,11 +49,29 @@ typedef struct iree_vm_bytecode_module_t {
   iree_host_size_t rodata_ref_count;
   iree_vm_buffer_t* rodata_ref_table;
 
+  // Combined heap storage for decompressed rodata segments.
+  // Empty when all segments reference the archive memory directly.
+  iree_byte_span_t rodata_storage;
+
+  // One bit per internal function set once its bytecode has been verified.
+  // NULL when the module was eagerly verified during creation; non-NULL
+  // indicates deferred verification and that functions must be verified
+  // before entry.
+  iree_atomic_int32_t* verified_bitmap;
+
   // Type table mapping module type IDs to registered VM types.
   iree_host_size_t type_count;
   iree_vm_type_def_t type_table[];
 } iree_vm_bytecode_module_t;
 
+// Verifies the function with the given internal |ordinal| if it has not yet
+// been verified and marks it verified on success. Only used when the module
+// was created with deferred verification (verified_bitmap != NULL).
+// Safe to call concurrently: verification is read-only and racing callers
+// will both verify and reach the same result.
+iree_status_t iree_vm_bytecode_module_ensure_function_verified(
+    iree_vm_bytecode_module_t* module, iree_host_size_t ordinal);
+
 // A resolved and split import in the module state table.
 //
 // NOTE: a table of these are stored per module per context so ideally we'd
@@ -0,0 +1,235 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Benchmarks the bytecode module load path in isolation: archive header
+// parsing, FlatBuffer/function verification, module creation, and context
+// creation. The embedded module (module_load_benchmark.mlir) is shaped to
+// stress size-dependent costs; real artifacts can be measured by passing one
+// or more --module_file= flags, which registers the same phase benchmarks per
+// file. All benchmarks report bytes processed so results can be read as load
+// bandwidth and compared across artifact sizes.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "iree/base/api.h"
+#include "iree/base/internal/file_io.h"
+#include "iree/base/internal/flags.h"
+#include "iree/base/internal/path.h"
+#include "iree/testing/benchmark.h"
+#include "iree/vm/api.h"
+#include "iree/vm/bytecode/archive.h"
+#include "iree/vm/bytecode/module.h"
+#include "iree/vm/bytecode/module_load_benchmark_module_c.h"
+
+IREE_FLAG_LIST(
+    string, module_file,
+    "Additional bytecode module (.vmfb) to register load benchmarks for.\n"
+    "May be repeated to benchmark a corpus of production artifacts.");
+
+//===----------------------------------------------------------------------===//
+// Phase benchmarks
+//===----------------------------------------------------------------------===//
+
+// Parses the archive header to locate the FlatBuffer; this is the fixed
+// per-load cost paid before any verification begins.
+static iree_status_t BM_ParseArchiveHeader(
+    const iree_benchmark_def_t* benchmark_def,
+    iree_benchmark_state_t* benchmark_state) {
+  iree_const_byte_span_t archive_contents =
+      *(const iree_const_byte_span_t*)benchmark_def->user_data;
+  int64_t iteration_count = 0;
+  while (iree_benchmark_keep_running(benchmark_state, 1)) {
+    iree_const_byte_span_t flatbuffer_contents = iree_const_byte_span_empty();
+    iree_host_size_t rodata_offset = 0;
+    IREE_CHECK_OK(iree_vm_bytecode_archive_parse_header(
+        archive_contents, &flatbuffer_contents, &rodata_offset));
+    iree_optimization_barrier(flatbuffer_contents);
+    ++iteration_count;
+  }
+  iree_benchmark_set_bytes_processed(
+      benchmark_state,
+      iteration_count * (int64_t)archive_contents.data_length);
+  return iree_ok_status();
+}
+
+// Creates and releases a module with verification deferred; this isolates the
+// structural FlatBuffer verification and module setup from bytecode function
+// verification (measured by BM_ModuleCreateAndVerify below).
+static iree_status_t BM_ModuleCreateDeferred(
+    const iree_benchmark_def_t* benchmark_def,
+    iree_benchmark_state_t* benchmark_state) {
+  iree_const_byte_span_t archive_contents =
+      *(const iree_const_byte_span_t*)benchmark_def->user_data;
+  iree_vm_instance_t* instance = NULL;
+  IREE_CHECK_OK(iree_vm_instance_create(IREE_VM_TYPE_CAPACITY_DEFAULT,
+                                        iree_allocator_system(), &instance));
+  int64_t iteration_count = 0;
+  while (iree_benchmark_keep_running(benchmark_state, 1)) {
+    iree_vm_module_t* module = NULL;
+    IREE_CHECK_OK(iree_vm_bytecode_module_create_with_flags(
+        instance, IREE_VM_BYTECODE_MODULE_FLAG_DEFERRED_VERIFICATION,
+        archive_contents, iree_allocator_null(), iree_allocator_system(),
+        &module));
+    iree_optimization_barrier(module);
+    iree_vm_module_release(module);
+    ++iteration_count;
+  }
+  iree_benchmark_set_bytes_processed(
+      benchmark_state,
+      iteration_count * (int64_t)archive_contents.data_length);
+  iree_vm_instance_release(instance);
+  return iree_ok_status();
+}
+
+// Creates, fully verifies, and releases a module each iteration; subtracting
+// BM_ModuleCreateDeferred gives the cost of bytecode function verification
+// alone. Note that verification results are cached per-module so it must be
+// paired with creation in the timed region.
+static iree_status_t BM_ModuleCreateAndVerify(
+    const iree_benchmark_def_t* benchmark_def,
+    iree_benchmark_state_t* benchmark_state) {
+  iree_const_byte_span_t archive_contents =
+      *(const iree_const_byte_span_t*)benchmark_def->user_data;
+  iree_vm_instance_t* instance = NULL;
+  IREE_CHECK_OK(iree_vm_instance_create(IREE_VM_TYPE_CAPACITY_DEFAULT,
+                                        iree_allocator_system(), &instance));
+  int64_t iteration_count = 0;
+  while (iree_benchmark_keep_running(benchmark_state, 1)) {
+    iree_vm_module_t* module = NULL;
+    IREE_CHECK_OK(iree_vm_bytecode_module_create_with_flags(
+        instance, IREE_VM_BYTECODE_MODULE_FLAG_DEFERRED_VERIFICATION,
+        archive_contents, iree_allocator_null(), iree_allocator_system(),
+        &module));
+    IREE_CHECK_OK(iree_vm_bytecode_module_verify(module));
+    iree_optimization_barrier(module);
+    iree_vm_module_release(module);
+    ++iteration_count;
+  }
+  iree_benchmark_set_bytes_processed(
+      benchmark_state,
+      iteration_count * (int64_t)archive_contents.data_length);
+  iree_vm_instance_release(instance);
+  return iree_ok_status();
+}
+
+// Creates and releases a context with the module each iteration; the module
+// itself is created once so this measures import resolution and per-context
+// state allocation only.
+static iree_status_t BM_ContextCreate(
+    const iree_benchmark_def_t* benchmark_def,
+    iree_benchmark_state_t* benchmark_state) {
+  iree_const_byte_span_t archive_contents =
+      *(const iree_const_byte_span_t*)benchmark_def->user_data;
+  iree_vm_instance_t* instance = NULL;
+  IREE_CHECK_OK(iree_vm_instance_create(IREE_VM_TYPE_CAPACITY_DEFAULT,
+                                        iree_allocator_system(), &instance));
+  iree_vm_module_t* module = NULL;
+  IREE_CHECK_OK(iree_vm_bytecode_module_create(
+      instance, archive_contents, iree_allocator_null(),
+      iree_allocator_system(), &module));
+  while (iree_benchmark_keep_running(benchmark_state, 1)) {
+    iree_vm_context_t* context = NULL;
+    IREE_CHECK_OK(iree_vm_context_create_with_modules(
+        instance, IREE_VM_CONTEXT_FLAG_NONE, /*module_count=*/1, &module,
+        iree_allocator_system(), &context));
+    iree_optimization_barrier(context);
+    iree_vm_context_release(context);
+  }
+  iree_vm_module_release(module);
+  iree_vm_instance_release(instance);
+  return iree_ok_status();
+}
+
+//===----------------------------------------------------------------------===//
+// Registration
+//===----------------------------------------------------------------------===//
+
+static void iree_vm_register_load_benchmarks(
+    iree_string_view_t artifact_name,
+    const iree_const_byte_span_t* archive_contents) {
+  static const struct {
+    const char* phase_name;
+    iree_benchmark_fn_t fn;
+  } phases[] = {
+      {"parse_archive_header", BM_ParseArchiveHeader},
+      {"module_create_deferred", BM_ModuleCreateDeferred},
+      {"module_create_and_verify", BM_ModuleCreateAndVerify},
+      {"context_create", BM_ContextCreate},
+  };
+  for (iree_host_size_t i = 0; i < IREE_ARRAYSIZE(phases); ++i) {
+    iree_benchmark_def_t benchmark_def = {
+        /*.flags=*/IREE_BENCHMARK_FLAG_MEASURE_PROCESS_CPU_TIME |
+            IREE_BENCHMARK_FLAG_USE_REAL_TIME,
+        /*.time_unit=*/IREE_BENCHMARK_UNIT_MICROSECOND,
+        /*.minimum_duration_ns=*/0,
+        /*.iteration_count=*/0,
+        /*.run=*/phases[i].fn,
+        /*.user_data=*/archive_contents,
+    };
+    char benchmark_name[512];
+    snprintf(benchmark_name, sizeof(benchmark_name) - 1, "%.*s/%s",
+             (int)artifact_name.size, artifact_name.data,
+             phases[i].phase_name);
+    iree_benchmark_register(iree_make_cstring_view(benchmark_name),
+                            &benchmark_def);
+  }
+}
+
+int main(int argc, char** argv) {
+  iree_flags_set_usage(
+      "module_load_benchmark",
+      "Benchmarks each phase of the bytecode module load path (archive\n"
+      "parsing, verification, module and context creation) against an\n"
+      "embedded synthetic module and, optionally, a corpus of production\n"
+      "artifacts passed via repeated --module_file= flags. Combine with\n"
+      "--benchmark_format=csv|json and --benchmark_repetitions=N for\n"
+      "regression tracking.\n");
+  iree_flags_parse_checked(IREE_FLAGS_PARSE_MODE_UNDEFINED_OK, &argc, &argv);
+  iree_benchmark_initialize(&argc, argv);
+
+  // Embedded synthetic module sweeping rodata size and function/import count.
+  const iree_file_toc_t* module_file_toc =
+      iree_vm_bytecode_module_load_benchmark_module_create();
+  iree_const_byte_span_t embedded_contents = iree_make_const_byte_span(
+      module_file_toc->data, module_file_toc->size);
+  iree_vm_register_load_benchmarks(IREE_SV("synthetic"), &embedded_contents);
+
+  // Corpus artifacts loaded from disk; contents must outlive the benchmark
+  // run so they are freed after all registered benchmarks complete.
+  iree_file_contents_t* corpus_contents[64] = {NULL};
+  iree_const_byte_span_t corpus_spans[64];
+  iree_host_size_t corpus_count = 0;
+  int exit_code = EXIT_SUCCESS;
+  for (iree_host_size_t i = 0;
+       i < FLAG_module_file_list().count && i < IREE_ARRAYSIZE(corpus_spans);
+       ++i) {
+    iree_string_view_t path = FLAG_module_file_list().values[i];
+    char path_str[2048] = {0};
+    iree_string_view_to_cstring(path, path_str, sizeof(path_str));
+    iree_status_t status =
+        iree_file_read_contents(path_str, IREE_FILE_READ_FLAG_PRELOAD,
+                                iree_allocator_system(), &corpus_contents[i]);
+    if (!iree_status_is_ok(status)) {
+      iree_status_fprint(stderr, status);
+      iree_status_free(status);
+      exit_code = EXIT_FAILURE;
+      break;
+    }
+    corpus_spans[i] = corpus_contents[i]->const_buffer;
+    iree_vm_register_load_benchmarks(iree_file_path_basename(path),
+                                     &corpus_spans[i]);
+    ++corpus_count;
+  }
+
+  if (exit_code == EXIT_SUCCESS) iree_benchmark_run_specified();
+
+  for (iree_host_size_t i = 0; i < corpus_count; ++i) {
+    iree_file_contents_free(corpus_contents[i]);
+  }
+  fflush(stderr);
+  return exit_code;
+}
@@ -0,0 +1,144 @@
+// Module exercising the bytecode load path: FlatBuffer verification, module
+// creation, and context creation. Unlike module_benchmark.mlir this is shaped
+// to stress the costs that scale with module size - rodata segment count/size,
+// function count, and import count - rather than dispatch overhead. The splat
+// rodata constants keep the source text small while producing multi-megabyte
+// archives once serialized.
+
+vm.module @bytecode_module_load_benchmark {
+  // Rodata size sweep: segments from 16KB to 1MB. Embedded data dominates the
+  // archive size and lets byte-throughput counters approximate mmap/verify
+  // bandwidth on realistically-sized artifacts.
+  vm.rodata private @rodata_16k dense<1> : vector<16384xi8>
+  vm.rodata private @rodata_64k dense<2> : vector<65536xi8>
+  vm.rodata private @rodata_256k dense<3> : vector<262144xi8>
+  vm.rodata private @rodata_1m dense<4> : vector<1048576xi8>
+
+  // References each blob so none are stripped as unused.
+  vm.export @rodata_total_length
+  vm.func @rodata_total_length() -> i64 {
+    %r0 = vm.const.ref.rodata @rodata_16k : !vm.buffer
+    %r1 = vm.const.ref.rodata @rodata_64k : !vm.buffer
+    %r2 = vm.const.ref.rodata @rodata_256k : !vm.buffer
+    %r3 = vm.const.ref.rodata @rodata_1m : !vm.buffer
+    %l0 = vm.buffer.length %r0 : !vm.buffer -> i64
+    %l1 = vm.buffer.length %r1 : !vm.buffer -> i64
+    %l2 = vm.buffer.length %r2 : !vm.buffer -> i64
+    %l3 = vm.buffer.length %r3 : !vm.buffer -> i64
+    %s0 = vm.add.i64 %l0, %l1 : i64
+    %s1 = vm.add.i64 %s0, %l2 : i64
+    %s2 = vm.add.i64 %s1, %l3 : i64
+    vm.return %s2 : i64
+  }
+
+  // Import count coverage: optional imports exercise the per-import resolution
+  // performed during context creation without requiring a provider module.
+  vm.import private optional @unavailable.import_0(%arg0 : i32) -> i32
+  vm.import private optional @unavailable.import_1(%arg0 : i32) -> i32
+  vm.import private optional @unavailable.import_2(%arg0 : i32) -> i32
+  vm.import private optional @unavailable.import_3(%arg0 : i32) -> i32
+  vm.import private optional @unavailable.import_4(%arg0 : i32) -> i32
+  vm.import private optional @unavailable.import_5(%arg0 : i32) -> i32
+  vm.import private optional @unavailable.import_6(%arg0 : i32) -> i32
+  vm.import private optional @unavailable.import_7(%arg0 : i32) -> i32
+
+  // Function count coverage: a batch of small exported functions so the
+  // per-function verification and export table costs are visible. Each is
+  // kept distinct enough to defeat deduplication.
+  vm.export @func_00
+  vm.func @func_00(%arg0 : i32) -> i32 {
+    %c = vm.const.i32 0
+    %0 = vm.add.i32 %arg0, %c : i32
+    vm.return %0 : i32
+  }
+  vm.export @func_01
+  vm.func @func_01(%arg0 : i32) -> i32 {
+    %c = vm.const.i32 1
+    %0 = vm.add.i32 %arg0, %c : i32
+    vm.return %0 : i32
+  }
+  vm.export @func_02
+  vm.func @func_02(%arg0 : i32) -> i32 {
+    %c = vm.const.i32 2
+    %0 = vm.add.i32 %arg0, %c : i32
+    vm.return %0 : i32
+  }
+  vm.export @func_03
+  vm.func @func_03(%arg0 : i32) -> i32 {
+    %c = vm.const.i32 3
+    %0 = vm.add.i32 %arg0, %c : i32
+    vm.return %0 : i32
+  }
+  vm.export @func_04
+  vm.func @func_04(%arg0 : i32) -> i32 {
+    %c = vm.const.i32 4
+    %0 = vm.add.i32 %arg0, %c : i32
+    vm.return %0 : i32
+  }
+  vm.export @func_05
+  vm.func @func_05(%arg0 : i32) -> i32 {
+    %c = vm.const.i32 5
+    %0 = vm.add.i32 %arg0, %c : i32
+    vm.return %0 : i32
+  }
+  vm.export @func_06
+  vm.func @func_06(%arg0 : i32) -> i32 {
+    %c = vm.const.i32 6
+    %0 = vm.add.i32 %arg0, %c : i32
+    vm.return %0 : i32
+  }
+  vm.export @func_07
+  vm.func @func_07(%arg0 : i32) -> i32 {
+    %c = vm.const.i32 7
+    %0 = vm.add.i32 %arg0, %c : i32
+    vm.return %0 : i32
+  }
+  vm.export @func_08
+  vm.func @func_08(%arg0 : i32) -> i32 {
+    %c = vm.const.i32 8
+    %0 = vm.add.i32 %arg0, %c : i32
+    vm.return %0 : i32
+  }
+  vm.export @func_09
+  vm.func @func_09(%arg0 : i32) -> i32 {
+    %c = vm.const.i32 9
+    %0 = vm.add.i32 %arg0, %c : i32
+    vm.return %0 : i32
+  }
+  vm.export @func_10
+  vm.func @func_10(%arg0 : i32) -> i32 {
+    %c = vm.const.i32 10
+    %0 = vm.add.i32 %arg0, %c : i32
+    vm.return %0 : i32
+  }
+  vm.export @func_11
+  vm.func @func_11(%arg0 : i32) -> i32 {
+    %c = vm.const.i32 11
+    %0 = vm.add.i32 %arg0, %c : i32
+    vm.return %0 : i32
+  }
+  vm.export @func_12
+  vm.func @func_12(%arg0 : i32) -> i32 {
+    %c = vm.const.i32 12
+    %0 = vm.add.i32 %arg0, %c : i32
+    vm.return %0 : i32
+  }
+  vm.export @func_13
+  vm.func @func_13(%arg0 : i32) -> i32 {
+    %c = vm.const.i32 13
+    %0 = vm.add.i32 %arg0, %c : i32
+    vm.return %0 : i32
+  }
+  vm.export @func_14
+  vm.func @func_14(%arg0 : i32) -> i32 {
+    %c = vm.const.i32 14
+    %0 = vm.add.i32 %arg0, %c : i32
+    vm.return %0 : i32
+  }
+  vm.export @func_15
+  vm.func @func_15(%arg0 : i32) -> i32 {
+    %c = vm.const.i32 15
+    %0 = vm.add.i32 %arg0, %c : i32
+    vm.return %0 : i32
+  }
+}
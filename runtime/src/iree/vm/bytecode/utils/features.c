@@ -10,6 +10,7 @@
 static const iree_bitfield_string_mapping_t iree_vm_bytecode_feature_mappings[] = {
   {iree_vm_FeatureBits_EXT_F32, IREE_SVL("EXT_F32")},
   {iree_vm_FeatureBits_EXT_F64, IREE_SVL("EXT_F64")},
+  {iree_vm_FeatureBits_FUSED_OPS, IREE_SVL("FUSED_OPS")},
 };
 // clang-format on
 
@@ -28,6 +29,10 @@ iree_vm_FeatureBits_enum_t iree_vm_bytecode_available_features(void) {
 #if IREE_VM_EXT_F64_ENABLE
   result |= iree_vm_FeatureBits_EXT_F64;
 #endif  // IREE_VM_EXT_F64_ENABLE
+  // Fused superinstructions are part of the core opcode set and are always
+  // compiled in; the bit only exists so that modules using them fail cleanly
+  // on older runtimes.
+  result |= iree_vm_FeatureBits_FUSED_OPS;
   return result;
 }
 
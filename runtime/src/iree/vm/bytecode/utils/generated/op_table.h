@@ -140,12 +140,12 @@ typedef enum {
   IREE_VM_OP_CORE_CastAnyRef = 0x82,
   IREE_VM_OP_CORE_BranchTable = 0x83,
   IREE_VM_OP_CORE_BufferHash = 0x84,
-  IREE_VM_OP_CORE_RSV_0x85,
-  IREE_VM_OP_CORE_RSV_0x86,
-  IREE_VM_OP_CORE_RSV_0x87,
-  IREE_VM_OP_CORE_RSV_0x88,
-  IREE_VM_OP_CORE_RSV_0x89,
-  IREE_VM_OP_CORE_RSV_0x8A,
+  IREE_VM_OP_CORE_SelectEQI32 = 0x85,
+  IREE_VM_OP_CORE_SelectEQI64 = 0x86,
+  IREE_VM_OP_CORE_SelectLTI32S = 0x87,
+  IREE_VM_OP_CORE_SelectLTI64S = 0x88,
+  IREE_VM_OP_CORE_SelectLTI32U = 0x89,
+  IREE_VM_OP_CORE_SelectLTI64U = 0x8A,
   IREE_VM_OP_CORE_RSV_0x8B,
   IREE_VM_OP_CORE_RSV_0x8C,
   IREE_VM_OP_CORE_RSV_0x8D,
@@ -399,12 +399,12 @@ typedef enum {
     OPC(0x82, CastAnyRef) \
     OPC(0x83, BranchTable) \
     OPC(0x84, BufferHash) \
-    RSV(0x85) \
-    RSV(0x86) \
-    RSV(0x87) \
-    RSV(0x88) \
-    RSV(0x89) \
-    RSV(0x8A) \
+    OPC(0x85, SelectEQI32) \
+    OPC(0x86, SelectEQI64) \
+    OPC(0x87, SelectLTI32S) \
+    OPC(0x88, SelectLTI64S) \
+    OPC(0x89, SelectLTI32U) \
+    OPC(0x8A, SelectLTI64U) \
     RSV(0x8B) \
     RSV(0x8C) \
     RSV(0x8D) \
@@ -0,0 +1,93 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/vm/bytecode/utils/lz77.h"
+
+// Reads a 4-bit length nibble extension: each extension byte adds 0-255 and
+// any value < 255 terminates the run.
+static iree_status_t iree_vm_bytecode_lz77_read_length(
+    const uint8_t* src, iree_host_size_t src_length,
+    iree_host_size_t* src_offset, iree_host_size_t nibble,
+    iree_host_size_t* out_length) {
+  iree_host_size_t length = nibble;
+  if (nibble == 15) {
+    uint8_t extension = 0;
+    do {
+      if (IREE_UNLIKELY(*src_offset >= src_length)) {
+        return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                                "truncated length extension in LZ77 stream");
+      }
+      extension = src[(*src_offset)++];
+      length += extension;
+    } while (extension == 255);
+  }
+  *out_length = length;
+  return iree_ok_status();
+}
+
+iree_status_t iree_vm_bytecode_lz77_decompress(
+    iree_const_byte_span_t compressed_data, iree_byte_span_t output) {
+  const uint8_t* src = compressed_data.data;
+  const iree_host_size_t src_length = compressed_data.data_length;
+  uint8_t* dst = output.data;
+  const iree_host_size_t dst_length = output.data_length;
+  iree_host_size_t src_offset = 0;
+  iree_host_size_t dst_offset = 0;
+  while (src_offset < src_length) {
+    const uint8_t token = src[src_offset++];
+
+    // Copy the literal run preceding the match (if any).
+    iree_host_size_t literal_length = 0;
+    IREE_RETURN_IF_ERROR(iree_vm_bytecode_lz77_read_length(
+        src, src_length, &src_offset, token >> 4, &literal_length));
+    if (IREE_UNLIKELY(literal_length > src_length - src_offset) ||
+        IREE_UNLIKELY(literal_length > dst_length - dst_offset)) {
+      return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                              "literal run out of bounds in LZ77 stream");
+    }
+    memcpy(dst + dst_offset, src + src_offset, literal_length);
+    src_offset += literal_length;
+    dst_offset += literal_length;
+
+    // The final packet carries only literals and ends the stream.
+    if (src_offset == src_length) break;
+
+    // Decode the match offset/length and copy from the output window.
+    // Matches may overlap their own output (offset < length) to encode runs
+    // so the copy must proceed byte-by-byte in order.
+    if (IREE_UNLIKELY(src_length - src_offset < 2)) {
+      return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                              "truncated match offset in LZ77 stream");
+    }
+    const iree_host_size_t match_offset =
+        (iree_host_size_t)src[src_offset] |
+        ((iree_host_size_t)src[src_offset + 1] << 8);
+    src_offset += 2;
+    iree_host_size_t match_length = 0;
+    IREE_RETURN_IF_ERROR(iree_vm_bytecode_lz77_read_length(
+        src, src_length, &src_offset, token & 0xF, &match_length));
+    match_length += 4;  // minimum match length
+    if (IREE_UNLIKELY(match_offset == 0) ||
+        IREE_UNLIKELY(match_offset > dst_offset) ||
+        IREE_UNLIKELY(match_length > dst_length - dst_offset)) {
+      return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                              "match out of bounds in LZ77 stream");
+    }
+    const uint8_t* match_src = dst + dst_offset - match_offset;
+    for (iree_host_size_t i = 0; i < match_length; ++i) {
+      dst[dst_offset + i] = match_src[i];
+    }
+    dst_offset += match_length;
+  }
+  if (IREE_UNLIKELY(dst_offset != dst_length)) {
+    return iree_make_status(
+        IREE_STATUS_INVALID_ARGUMENT,
+        "LZ77 stream decompressed to %" PRIhsz
+        " bytes but the segment declared %" PRIhsz,
+        dst_offset, dst_length);
+  }
+  return iree_ok_status();
+}
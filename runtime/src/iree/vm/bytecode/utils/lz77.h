@@ -0,0 +1,36 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_VM_BYTECODE_UTILS_LZ77_H_
+#define IREE_VM_BYTECODE_UTILS_LZ77_H_
+
+#include "iree/base/api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+// Alignment guaranteed for decompressed rodata segment storage.
+// The compiler must not compress segments requiring stronger alignment.
+#define IREE_VM_BYTECODE_LZ77_STORAGE_ALIGNMENT 64
+
+// Decompresses an LZ77DataDef-formatted |compressed_data| stream into
+// |output|, which must be sized to exactly the uncompressed length recorded
+// in the segment. The stream format is documented on LZ77DataDef in
+// iree/schemas/bytecode_module_def.fbs.
+//
+// All reads and writes are bounds-checked; malformed streams (truncated
+// packets, out-of-window match offsets, or a length mismatch against
+// |output|) fail with IREE_STATUS_INVALID_ARGUMENT without writing outside
+// of |output|.
+iree_status_t iree_vm_bytecode_lz77_decompress(
+    iree_const_byte_span_t compressed_data, iree_byte_span_t output);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // IREE_VM_BYTECODE_UTILS_LZ77_H_
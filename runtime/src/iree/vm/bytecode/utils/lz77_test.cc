@@ -0,0 +1,112 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/vm/bytecode/utils/lz77.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "iree/base/api.h"
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+
+namespace {
+
+using iree::Status;
+using iree::StatusCode;
+using iree::testing::status::StatusIs;
+
+// Decompresses |compressed| expecting |expected_length| output bytes.
+Status Decompress(const std::vector<uint8_t>& compressed,
+                  size_t expected_length, std::string* out_data) {
+  out_data->resize(expected_length);
+  Status status(iree_vm_bytecode_lz77_decompress(
+      iree_make_const_byte_span(compressed.data(), compressed.size()),
+      iree_make_byte_span(out_data->empty() ? nullptr : &(*out_data)[0],
+                          out_data->size())));
+  return status;
+}
+
+// Empty streams decompress to empty outputs.
+TEST(Lz77Test, Empty) {
+  std::string data;
+  IREE_EXPECT_OK(Decompress({}, 0, &data));
+  EXPECT_TRUE(data.empty());
+}
+
+// A final packet carrying only literals (low nibble ignored, no offset).
+TEST(Lz77Test, LiteralsOnly) {
+  std::vector<uint8_t> compressed = {
+      0x40, 'a', 'b', 'c', 'd',  // 4 literals, final packet
+  };
+  std::string data;
+  IREE_EXPECT_OK(Decompress(compressed, 4, &data));
+  EXPECT_EQ(data, "abcd");
+}
+
+// Literal runs >= 15 spill into extension bytes.
+TEST(Lz77Test, LiteralLengthExtension) {
+  std::vector<uint8_t> compressed = {0xF0, 0x01};  // 15 + 1 literals
+  for (int i = 0; i < 16; ++i) compressed.push_back('x');
+  std::string data;
+  IREE_EXPECT_OK(Decompress(compressed, 16, &data));
+  EXPECT_EQ(data, std::string(16, 'x'));
+}
+
+// A match copies previously decompressed bytes from the output window.
+TEST(Lz77Test, Match) {
+  std::vector<uint8_t> compressed = {
+      0x40, 'a', 'b', 'c', 'd',  // 4 literals
+      0x00, 0x04, 0x00,          // match: offset 4, length 4+0=4
+  };
+  std::string data;
+  IREE_EXPECT_OK(Decompress(compressed, 8, &data));
+  EXPECT_EQ(data, "abcdabcd");
+}
+
+// Matches may overlap their own output to encode runs (offset < length).
+TEST(Lz77Test, OverlappingMatch) {
+  std::vector<uint8_t> compressed = {
+      0x10, 'z',         // 1 literal
+      0x03, 0x01, 0x00,  // match: offset 1, length 4+3=7
+  };
+  std::string data;
+  IREE_EXPECT_OK(Decompress(compressed, 8, &data));
+  EXPECT_EQ(data, std::string(8, 'z'));
+}
+
+// Match offsets beyond the decompressed prefix must be rejected.
+TEST(Lz77Test, MatchOffsetOutOfRange) {
+  std::vector<uint8_t> compressed = {
+      0x10, 'a',         // 1 literal
+      0x00, 0x08, 0x00,  // match: offset 8 > 1 byte decompressed
+  };
+  std::string data;
+  EXPECT_THAT(Decompress(compressed, 5, &data),
+              StatusIs(StatusCode::kInvalidArgument));
+}
+
+// Truncated packets (missing offset bytes/literals) must be rejected.
+TEST(Lz77Test, TruncatedStream) {
+  std::string data;
+  EXPECT_THAT(Decompress({0x40, 'a', 'b'}, 4, &data),
+              StatusIs(StatusCode::kInvalidArgument));
+  EXPECT_THAT(Decompress({0x10, 'a', 0x00, 0x01}, 5, &data),
+              StatusIs(StatusCode::kInvalidArgument));
+}
+
+// Streams must decompress to exactly the declared segment length.
+TEST(Lz77Test, LengthMismatch) {
+  std::vector<uint8_t> compressed = {0x20, 'a', 'b'};
+  std::string data;
+  EXPECT_THAT(Decompress(compressed, 3, &data),
+              StatusIs(StatusCode::kInvalidArgument));
+  EXPECT_THAT(Decompress(compressed, 1, &data),
+              StatusIs(StatusCode::kInvalidArgument));
+}
+
+}  // namespace
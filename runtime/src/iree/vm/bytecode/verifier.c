@@ -65,6 +65,24 @@ iree_status_t iree_vm_bytecode_module_flatbuffer_verify(
        ++i) {
     iree_vm_RodataSegmentDef_table_t segment =
         iree_vm_RodataSegmentDef_vec_at(rodata_segments, i);
+    iree_vm_CompressionTypeDef_union_type_t compression_type =
+        iree_vm_RodataSegmentDef_compression_type_type(segment);
+    if (compression_type == iree_vm_CompressionTypeDef_LZ77DataDef) {
+      // Compressed segments must carry their stream inline; the external
+      // data path is reserved for zero-copy mapping and stays uncompressed.
+      if (!iree_vm_RodataSegmentDef_embedded_data_is_present(segment)) {
+        return iree_make_status(
+            IREE_STATUS_INVALID_ARGUMENT,
+            "rodata[%zu] compressed segments must use embedded data", i);
+      }
+    } else if (compression_type != iree_vm_CompressionTypeDef_NONE &&
+               compression_type !=
+                   iree_vm_CompressionTypeDef_UncompressedDataDef) {
+      return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
+                              "rodata[%zu] uses an unsupported compression "
+                              "type %d",
+                              i, (int)compression_type);
+    }
     if (iree_vm_RodataSegmentDef_embedded_data_is_present(segment)) {
       continue;  // embedded data is verified by FlatBuffers
     }
@@ -1367,6 +1385,54 @@ static iree_status_t iree_vm_bytecode_function_verify_bytecode_op(
       VM_VerifyResultRegRef(result);
     });
 
+    VERIFY_OP(CORE, SelectEQI32, {
+      VM_VerifyOperandRegI32(lhs);
+      VM_VerifyOperandRegI32(rhs);
+      VM_VerifyOperandRegI32(true_value);
+      VM_VerifyOperandRegI32(false_value);
+      VM_VerifyResultRegI32(result);
+    });
+
+    VERIFY_OP(CORE, SelectEQI64, {
+      VM_VerifyOperandRegI64(lhs);
+      VM_VerifyOperandRegI64(rhs);
+      VM_VerifyOperandRegI64(true_value);
+      VM_VerifyOperandRegI64(false_value);
+      VM_VerifyResultRegI64(result);
+    });
+
+    VERIFY_OP(CORE, SelectLTI32S, {
+      VM_VerifyOperandRegI32(lhs);
+      VM_VerifyOperandRegI32(rhs);
+      VM_VerifyOperandRegI32(true_value);
+      VM_VerifyOperandRegI32(false_value);
+      VM_VerifyResultRegI32(result);
+    });
+
+    VERIFY_OP(CORE, SelectLTI64S, {
+      VM_VerifyOperandRegI64(lhs);
+      VM_VerifyOperandRegI64(rhs);
+      VM_VerifyOperandRegI64(true_value);
+      VM_VerifyOperandRegI64(false_value);
+      VM_VerifyResultRegI64(result);
+    });
+
+    VERIFY_OP(CORE, SelectLTI32U, {
+      VM_VerifyOperandRegI32(lhs);
+      VM_VerifyOperandRegI32(rhs);
+      VM_VerifyOperandRegI32(true_value);
+      VM_VerifyOperandRegI32(false_value);
+      VM_VerifyResultRegI32(result);
+    });
+
+    VERIFY_OP(CORE, SelectLTI64U, {
+      VM_VerifyOperandRegI64(lhs);
+      VM_VerifyOperandRegI64(rhs);
+      VM_VerifyOperandRegI64(true_value);
+      VM_VerifyOperandRegI64(false_value);
+      VM_VerifyResultRegI64(result);
+    });
+
     VERIFY_OP(CORE, SwitchI32, {
       VM_VerifyOperandRegI32(index);
       VM_VerifyOperandRegI32(default_value);
@@ -10,14 +10,33 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "iree/base/internal/arena.h"
 #include "iree/base/internal/atomics.h"
 #include "iree/base/internal/debugging.h"
 
+// Block size used by the fork block pool feeding per-fork state arenas.
+// Most module states (rwdata + globals + import tables) fit in a block or two.
+#define IREE_VM_CONTEXT_FORK_BLOCK_SIZE (32 * 1024)
+
 struct iree_vm_context_t {
   iree_atomic_ref_count_t ref_count;
   iree_vm_instance_t* instance;
   iree_allocator_t allocator;
 
+  // Allocator used for per-module state allocations; the context allocator
+  // for normal contexts and an arena-backed allocator for forks.
+  iree_allocator_t state_allocator;
+
+  // Context this context was forked from, if any; retained to keep the shared
+  // modules and the fork block pool alive.
+  iree_vm_context_t* source_context;
+  // Block pool shared by all forks of this context for their state arenas.
+  // Thread-safe; forks may be created and released concurrently.
+  iree_arena_block_pool_t fork_block_pool;
+  // Arena backing module state allocations when this context is a fork.
+  // Deinitializing returns all blocks to the source context pool.
+  iree_arena_allocator_t state_arena;
+
   // An opaque ID unique for the entire process lifetime.
   // If tracing then this points at a NUL-terminated string with process
   // lifetime.
@@ -266,6 +285,10 @@ static void iree_vm_context_release_modules(iree_vm_context_t* context,
       // Partially initialized; skip.
       continue;
     }
+    if (context->source_context && iree_vm_module_has_shared_state(module)) {
+      // State is aliased from the source context which deinitializes it.
+      continue;
+    }
     IREE_IGNORE_ERROR(iree_vm_context_run_function(
         context, stack, module, iree_make_cstring_view("__deinit")));
   }
@@ -276,6 +299,12 @@ static void iree_vm_context_release_modules(iree_vm_context_t* context,
     iree_vm_module_t* module = context->list.modules[i];
     // It is possible in error states to have partially initialized.
     if (context->list.module_states[i]) {
+      if (context->source_context &&
+          iree_vm_module_has_shared_state(module)) {
+        // Aliased shared state owned by the source context; just unlink it.
+        context->list.module_states[i] = NULL;
+        continue;
+      }
       module->free_state(module->self, context->list.module_states[i]);
       context->list.module_states[i] = NULL;
     }
@@ -319,6 +348,9 @@ IREE_API_EXPORT iree_status_t iree_vm_context_create_with_modules(
   context->instance = instance;
   iree_vm_instance_retain(context->instance);
   context->allocator = allocator;
+  context->state_allocator = allocator;
+  iree_arena_block_pool_initialize(IREE_VM_CONTEXT_FORK_BLOCK_SIZE, allocator,
+                                   &context->fork_block_pool);
 
   context->context_id = iree_vm_context_allocate_id();
 
@@ -348,6 +380,68 @@ IREE_API_EXPORT iree_status_t iree_vm_context_create_with_modules(
   return iree_ok_status();
 }
 
+IREE_API_EXPORT iree_status_t iree_vm_context_fork(
+    iree_vm_context_t* source_context, iree_allocator_t allocator,
+    iree_vm_context_t** out_context) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_ASSERT_ARGUMENT(source_context);
+  IREE_ASSERT_ARGUMENT(out_context);
+  *out_context = NULL;
+
+  iree_host_size_t module_count = source_context->list.count;
+  iree_host_size_t context_size =
+      sizeof(iree_vm_context_t) + sizeof(iree_vm_module_t*) * module_count +
+      sizeof(iree_vm_module_state_t*) * module_count;
+
+  iree_vm_context_t* context = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(allocator, context_size, (void**)&context));
+  iree_atomic_ref_count_init(&context->ref_count);
+  context->instance = source_context->instance;
+  iree_vm_instance_retain(context->instance);
+  context->allocator = allocator;
+  iree_arena_block_pool_initialize(IREE_VM_CONTEXT_FORK_BLOCK_SIZE, allocator,
+                                   &context->fork_block_pool);
+
+  context->context_id = iree_vm_context_allocate_id();
+
+  // Forks are immutable snapshots of the source module list.
+  context->is_frozen = 1;
+  context->is_static = 1;
+  context->flags = source_context->flags;
+
+  // All per-module state is allocated from an arena fed by the block pool on
+  // the source context; releasing the fork returns the blocks for reuse by
+  // the next fork without touching the system allocator.
+  context->source_context = source_context;
+  iree_vm_context_retain(source_context);
+  iree_arena_initialize(&source_context->fork_block_pool,
+                        &context->state_arena);
+  context->state_allocator = iree_arena_allocator(&context->state_arena);
+
+  uint8_t* p = (uint8_t*)context + sizeof(iree_vm_context_t);
+  context->list.modules = (iree_vm_module_t**)p;
+  p += sizeof(iree_vm_module_t*) * module_count;
+  context->list.module_states = (iree_vm_module_state_t**)p;
+  p += sizeof(iree_vm_module_state_t*) * module_count;
+  context->list.count = 0;
+  context->list.capacity = module_count;
+
+  // Modules are shared by reference: no reloading or reverification happens
+  // here - only state allocation, import resolution, and __init calls.
+  iree_status_t register_status = iree_vm_context_register_modules(
+      context, module_count, source_context->list.modules);
+  if (!iree_status_is_ok(register_status)) {
+    iree_vm_context_destroy(context);
+    IREE_TRACE_ZONE_END(z0);
+    return register_status;
+  }
+
+  *out_context = context;
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
 static void iree_vm_context_destroy(iree_vm_context_t* context) {
   if (!context) return;
 
@@ -366,6 +460,15 @@ static void iree_vm_context_destroy(iree_vm_context_t* context) {
     context->list.module_states = NULL;
   }
 
+  // Return per-fork state blocks to the shared pool and drop the pool itself.
+  // Forks retain their source context so the source pool always outlives them.
+  if (context->source_context) {
+    iree_arena_deinitialize(&context->state_arena);
+    iree_vm_context_release(context->source_context);
+    context->source_context = NULL;
+  }
+  iree_arena_block_pool_deinitialize(&context->fork_block_pool);
+
   iree_vm_instance_release(context->instance);
   context->instance = NULL;
 
@@ -494,10 +597,23 @@ IREE_API_EXPORT iree_status_t iree_vm_context_register_modules(
 
     iree_vm_module_retain(module);
 
+    // Forks alias the state instance of modules declaring the shared state
+    // model instead of allocating and reinitializing a private copy; the fork
+    // retains its source context so the shared state always outlives it.
+    if (context->source_context && iree_vm_module_has_shared_state(module)) {
+      iree_vm_module_state_t* shared_state = NULL;
+      status = iree_vm_context_resolve_module_state(context->source_context,
+                                                    module, &shared_state);
+      if (!iree_status_is_ok(status)) break;
+      context->list.module_states[original_count + i] = shared_state;
+      ++context->list.count;
+      continue;  // imports and __init already ran on the source state
+    }
+
     // Allocate module state.
     iree_vm_module_state_t* module_state = NULL;
-    status =
-        module->alloc_state(module->self, context->allocator, &module_state);
+    status = module->alloc_state(module->self, context->state_allocator,
+                                 &module_state);
     if (!iree_status_is_ok(status)) {
       // Cleanup handled below.
       break;
@@ -69,6 +69,29 @@ IREE_API_EXPORT iree_status_t iree_vm_context_create_with_modules(
     iree_host_size_t module_count, iree_vm_module_t** modules,
     iree_allocator_t allocator, iree_vm_context_t** out_context);
 
+// Forks |source_context| into a new context sharing its registered modules.
+// The loaded modules are shared by reference and are not reloaded or
+// reverified; only per-module state allocation, import resolution, and module
+// initializers run, making forks dramatically cheaper than recreating a
+// context from scratch. Each fork carries its own mutable module state and may
+// execute concurrently with the source context and other forks. Modules
+// declaring the `vm.state.model`=`shared` reflection attribute (see
+// iree_vm_module_has_shared_state) skip even that: their state instance is
+// aliased from the source context so forks carry no copy at all.
+//
+// Module state is allocated from an arena backed by a block pool shared with
+// |source_context| so that steady-state fork create/release cycles (such as
+// per-request isolation in servers) recycle memory without returning to the
+// system allocator.
+//
+// The fork retains |source_context| until released. Forks may be created and
+// released concurrently from multiple threads though each forked context must
+// only be used by one thread at a time.
+// |out_context| must be released by the caller.
+IREE_API_EXPORT iree_status_t iree_vm_context_fork(
+    iree_vm_context_t* source_context, iree_allocator_t allocator,
+    iree_vm_context_t** out_context);
+
 // Retains the given |context| for the caller.
 IREE_API_EXPORT void iree_vm_context_retain(iree_vm_context_t* context);
 
@@ -35,19 +35,32 @@ iree_vm_resolve_builtin_types(iree_vm_instance_t* instance) {
 
 typedef struct {
   // Pointer to the externally-defined/unowned descriptor.
-  const iree_vm_ref_type_descriptor_t* descriptor;
+  // Published with release semantics by writers and read with acquire
+  // semantics by lock-free lookups; NULL indicates an empty or tombstoned
+  // slot that readers must skip.
+  iree_atomic_intptr_t descriptor;
   // Number of times the type has been registered. Only to be used by the
   // instance and while holding the instance lock.
   uint32_t registration_count;
 } iree_vm_registered_type_t;
 
+// The type registry is append-only from the perspective of readers: lookups
+// and ref type checks happen on every module load and in bindings and must not
+// contend on the instance. Writers (register/unregister) serialize on the
+// type mutex while readers scan the slot array locklessly - the slot count is
+// published with release semantics after the slot contents so that a reader
+// observing the count sees fully initialized slots. Unregistering tombstones
+// the slot (descriptor = NULL) rather than compacting the array so concurrent
+// readers never observe entries shifting underneath them; tombstoned slots are
+// reused by later registrations.
 struct iree_vm_instance_t {
   iree_atomic_ref_count_t ref_count;
   iree_allocator_t allocator;
 
   iree_slim_mutex_t type_mutex;
   uint16_t type_capacity;
-  uint16_t type_count;
+  // High-water slot count; readers acquire-load this bound before scanning.
+  iree_atomic_int32_t type_count;
   iree_vm_registered_type_t types[];
 };
 
@@ -128,11 +141,20 @@ iree_vm_instance_register_type(iree_vm_instance_t* instance,
 
   iree_slim_mutex_lock(&instance->type_mutex);
 
+  // NOTE: only writers mutate slots and they are serialized on the mutex so
+  // relaxed loads of slot contents are safe here.
+  int32_t type_count =
+      iree_atomic_load_int32(&instance->type_count, iree_memory_order_relaxed);
+
   // Scan to see if there are any existing types registered with this
-  // descriptor.
-  for (iree_host_size_t i = 0; i < instance->type_count; ++i) {
+  // descriptor, tracking the first tombstoned slot for reuse.
+  iree_vm_registered_type_t* empty_type = NULL;
+  for (int32_t i = 0; i < type_count; ++i) {
     iree_vm_registered_type_t* type = &instance->types[i];
-    if (type->descriptor == descriptor) {
+    const iree_vm_ref_type_descriptor_t* slot_descriptor =
+        (const iree_vm_ref_type_descriptor_t*)iree_atomic_load_intptr(
+            &type->descriptor, iree_memory_order_relaxed);
+    if (slot_descriptor == descriptor) {
       // Already registered - increment count so that we have a balanced
       // register/unregister set.
       ++type->registration_count;
@@ -140,11 +162,25 @@ iree_vm_instance_register_type(iree_vm_instance_t* instance,
       *out_registration = (iree_vm_ref_type_t)descriptor |
                           (iree_vm_ref_type_t)descriptor->offsetof_counter;
       return iree_ok_status();
+    } else if (!slot_descriptor && !empty_type) {
+      empty_type = type;
     }
   }
 
+  if (empty_type) {
+    // Reuse a tombstoned slot; the release store publishes the slot to
+    // lock-free readers already scanning within the current count.
+    empty_type->registration_count = 1;
+    iree_atomic_store_intptr(&empty_type->descriptor, (intptr_t)descriptor,
+                             iree_memory_order_release);
+    iree_slim_mutex_unlock(&instance->type_mutex);
+    *out_registration = (iree_vm_ref_type_t)descriptor |
+                        (iree_vm_ref_type_t)descriptor->offsetof_counter;
+    return iree_ok_status();
+  }
+
   // Ensure there's capacity.
-  if (instance->type_count + 1 > instance->type_capacity) {
+  if (type_count + 1 > instance->type_capacity) {
     iree_slim_mutex_unlock(&instance->type_mutex);
     return iree_make_status(IREE_STATUS_RESOURCE_EXHAUSTED,
                             "too many user-defined types registered; new type "
@@ -154,11 +190,15 @@ iree_vm_instance_register_type(iree_vm_instance_t* instance,
                             instance->type_capacity);
   }
 
-  // Append to the list.
-  instance->types[instance->type_count++] = (iree_vm_registered_type_t){
-      .descriptor = descriptor,
-      .registration_count = 1,
-  };
+  // Append to the list: populate the slot and then publish it by bumping the
+  // count with release semantics so that readers acquiring the new count see
+  // the initialized slot.
+  iree_vm_registered_type_t* type = &instance->types[type_count];
+  type->registration_count = 1;
+  iree_atomic_store_intptr(&type->descriptor, (intptr_t)descriptor,
+                           iree_memory_order_relaxed);
+  iree_atomic_store_int32(&instance->type_count, type_count + 1,
+                          iree_memory_order_release);
 
   iree_slim_mutex_unlock(&instance->type_mutex);
 
@@ -171,19 +211,20 @@ IREE_API_EXPORT void iree_vm_instance_unregister_type(
     iree_vm_instance_t* instance,
     const iree_vm_ref_type_descriptor_t* descriptor) {
   iree_slim_mutex_lock(&instance->type_mutex);
-  for (iree_host_size_t i = 0; i < instance->type_count; ++i) {
+  int32_t type_count =
+      iree_atomic_load_int32(&instance->type_count, iree_memory_order_relaxed);
+  for (int32_t i = 0; i < type_count; ++i) {
     // NOTE: descriptor pointers must be stable so we can just compare that
     // instead of each field.
     iree_vm_registered_type_t* type = &instance->types[i];
-    if (type->descriptor == descriptor) {
+    if ((const iree_vm_ref_type_descriptor_t*)iree_atomic_load_intptr(
+            &type->descriptor, iree_memory_order_relaxed) == descriptor) {
       if (--type->registration_count == 0) {
-        // Last registration reference, remove from the list.
-        memmove(&instance->types[i], &instance->types[i + 1],
-                instance->type_count - i - 1);
-        instance->types[--instance->type_count] = (iree_vm_registered_type_t){
-            .descriptor = NULL,
-            .registration_count = 0,
-        };
+        // Last registration reference: tombstone the slot rather than
+        // compacting so lock-free readers never observe entries moving.
+        // The slot is reused by subsequent registrations.
+        iree_atomic_store_intptr(&type->descriptor, (intptr_t)NULL,
+                                 iree_memory_order_release);
       }
       break;
     }
@@ -194,19 +235,24 @@ IREE_API_EXPORT void iree_vm_instance_unregister_type(
 // NOTE: this does a linear scan over the type descriptors even though they are
 // likely in a random order. Type lookup should be done once and reused so this
 // shouldn't really matter.
+//
+// Lock-free: registration publishes slots with release stores (paired with
+// the acquire loads here) and unregistration only tombstones. Descriptors are
+// externally owned with static storage in practice so dereferencing one read
+// from a slot is safe even if it is concurrently unregistered.
 IREE_API_EXPORT iree_vm_ref_type_t iree_vm_instance_lookup_type(
     iree_vm_instance_t* instance, iree_string_view_t full_name) {
-  const iree_vm_ref_type_descriptor_t* descriptor = NULL;
-  iree_slim_mutex_lock(&instance->type_mutex);
-  for (iree_host_size_t i = 0; i < instance->type_count; ++i) {
-    const iree_vm_registered_type_t* type = &instance->types[i];
-    if (iree_string_view_equal(type->descriptor->type_name, full_name)) {
-      descriptor = type->descriptor;
-      break;
+  int32_t type_count =
+      iree_atomic_load_int32(&instance->type_count, iree_memory_order_acquire);
+  for (int32_t i = 0; i < type_count; ++i) {
+    const iree_vm_ref_type_descriptor_t* descriptor =
+        (const iree_vm_ref_type_descriptor_t*)iree_atomic_load_intptr(
+            &instance->types[i].descriptor, iree_memory_order_acquire);
+    if (!descriptor) continue;  // tombstoned slot
+    if (iree_string_view_equal(descriptor->type_name, full_name)) {
+      return (iree_vm_ref_type_t)descriptor |
+             (iree_vm_ref_type_t)descriptor->offsetof_counter;
     }
   }
-  iree_slim_mutex_unlock(&instance->type_mutex);
-  if (!descriptor) return 0;
-  return (iree_vm_ref_type_t)descriptor |
-         (iree_vm_ref_type_t)descriptor->offsetof_counter;
+  return 0;
 }
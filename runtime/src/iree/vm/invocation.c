@@ -269,6 +269,53 @@ static void iree_vm_invoke_fiber_leave(iree_vm_invocation_id_t invocation_id,
 // Synchronous invocation
 //===----------------------------------------------------------------------===//
 
+// Services wait frames and resumes the invocation in |state| until it
+// completes or the invoke process itself fails. Called with the tick zone
+// |zi| open and the fiber entered; returns with a (possibly different) tick
+// zone open in |zi| and the fiber still entered.
+static iree_status_t iree_vm_invoke_drive(iree_vm_invoke_state_t* state,
+                                          iree_vm_invocation_id_t invocation_id,
+                                          iree_time_t deadline_ns,
+                                          iree_status_t status,
+                                          iree_zone_id_t* zi) {
+  (void)invocation_id;  // unused when tracing is disabled
+  while (iree_status_is_deferred(status)) {
+    // Grab the wait frame from the stack holding the wait parameters.
+    // This is optional: if an invocation yields for cooperative scheduling
+    // purposes there will not be a wait frame on the stack and we'll just
+    // resume it below.
+    iree_vm_stack_frame_t* current_frame =
+        iree_vm_stack_current_frame(state->stack);
+    if (IREE_UNLIKELY(!current_frame)) {
+      // Unbalanced stack.
+      return iree_make_status(IREE_STATUS_FAILED_PRECONDITION,
+                              "unbalanced stack after yield");
+    } else if (current_frame->type == IREE_VM_STACK_FRAME_WAIT) {
+      // Perform the wait operation synchronously.
+      // We do this outside of the fiber to match accounting with async
+      // executors.
+      IREE_TRACE(iree_vm_invoke_fiber_leave(invocation_id, state->stack));
+      IREE_TRACE_ZONE_END(*zi);
+
+      iree_vm_wait_frame_t* wait_frame =
+          (iree_vm_wait_frame_t*)iree_vm_stack_frame_storage(current_frame);
+      status = iree_vm_wait_invoke(state, wait_frame, deadline_ns);
+
+      // Restore tick zone and re-enter the fiber for the resume.
+      IREE_TRACE_ZONE_BEGIN_NAMED(zi_next, "iree_vm_invoke_tick");
+      *zi = zi_next;
+      IREE_TRACE(iree_vm_invoke_fiber_reenter(invocation_id, state->stack));
+      if (!iree_status_is_ok(status)) break;
+    }
+
+    // Resume the invocation after its wait completes (if it wasn't just a
+    // simple yield for cooperation). This may yield again and require another
+    // tick or complete with OK (or an error).
+    status = iree_vm_resume_invoke(state);
+  }
+  return status;
+}
+
 IREE_API_EXPORT iree_status_t iree_vm_invoke(
     iree_vm_context_t* context, iree_vm_function_t function,
     iree_vm_invocation_flags_t flags, const iree_vm_invocation_policy_t* policy,
@@ -301,41 +348,8 @@ IREE_API_EXPORT iree_status_t iree_vm_invoke(
   iree_vm_invoke_state_t state = {0};
   iree_status_t status = iree_vm_begin_invoke(&state, context, function, flags,
                                               policy, inputs, host_allocator);
-  while (iree_status_is_deferred(status)) {
-    // Grab the wait frame from the stack holding the wait parameters.
-    // This is optional: if an invocation yields for cooperative scheduling
-    // purposes there will not be a wait frame on the stack and we'll just
-    // resume it below.
-    iree_vm_stack_frame_t* current_frame =
-        iree_vm_stack_current_frame(state.stack);
-    if (IREE_UNLIKELY(!current_frame)) {
-      // Unbalanced stack.
-      status = iree_make_status(IREE_STATUS_FAILED_PRECONDITION,
-                                "unbalanced stack after yield");
-      break;  // bail and don't attempt a resume
-    } else if (current_frame->type == IREE_VM_STACK_FRAME_WAIT) {
-      // Perform the wait operation synchronously.
-      // We do this outside of the fiber to match accounting with async
-      // executors.
-      IREE_TRACE(iree_vm_invoke_fiber_leave(invocation_id, state.stack));
-      IREE_TRACE_ZONE_END(zi);
-
-      iree_vm_wait_frame_t* wait_frame =
-          (iree_vm_wait_frame_t*)iree_vm_stack_frame_storage(current_frame);
-      status = iree_vm_wait_invoke(&state, wait_frame, deadline_ns);
-
-      // Restore tick zone and re-enter the fiber for the resume.
-      IREE_TRACE_ZONE_BEGIN_NAMED(zi_next, "iree_vm_invoke_tick");
-      zi = zi_next;
-      IREE_TRACE(iree_vm_invoke_fiber_reenter(invocation_id, state.stack));
-      if (!iree_status_is_ok(status)) break;
-    }
-
-    // Resume the invocation after its wait completes (if it wasn't just a
-    // simple yield for cooperation). This may yield again and require another
-    // tick or complete with OK (or an error).
-    status = iree_vm_resume_invoke(&state);
-  }
+  status = iree_vm_invoke_drive(&state, invocation_id, deadline_ns, status,
+                                &zi);
 
   // If the invoke process itself was successful we can end the invocation
   // cleanly and get the invocation status as returned by the target function.
@@ -368,6 +382,67 @@ IREE_API_EXPORT iree_status_t iree_vm_invoke(
   return status;
 }
 
+IREE_API_EXPORT iree_status_t iree_vm_invoke_packed(
+    iree_vm_context_t* context, iree_vm_function_t function,
+    iree_vm_invocation_flags_t flags, const iree_vm_invocation_policy_t* policy,
+    iree_byte_span_t arguments, iree_byte_span_t results,
+    iree_allocator_t host_allocator) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // As with iree_vm_invoke we only bound the invocation by the timeouts on the
+  // wait operations it performs.
+  iree_timeout_t timeout = iree_infinite_timeout();
+  iree_time_t deadline_ns = iree_timeout_as_deadline_ns(timeout);
+
+  // Allocate an invocation ID for tracing.
+  iree_vm_invocation_id_t invocation_id =
+      iree_any_bit_set(flags, IREE_VM_INVOCATION_FLAG_TRACE_INLINE)
+          ? 0
+          : iree_vm_invoke_allocate_id(context, &function);
+  (void)invocation_id;  // unused when tracing is disabled
+
+  // Begin a zone outside the fiber to represent one tick of the loop.
+  IREE_TRACE_ZONE_BEGIN_NAMED(zi, "iree_vm_invoke_tick");
+  // Enter the fiber to start attributing zones to the context.
+  IREE_TRACE(iree_vm_invoke_fiber_enter(invocation_id));
+
+  // Perform the initial invocation step directly on the caller-provided
+  // storage and then service waits/resumes until completion.
+  iree_vm_invoke_state_t state = {0};
+  iree_status_t status = iree_vm_begin_invoke_packed(
+      &state, context, function, flags, policy, arguments, results,
+      host_allocator);
+  status = iree_vm_invoke_drive(&state, invocation_id, deadline_ns, status,
+                                &zi);
+
+  // If the invoke process itself was successful we can end the invocation
+  // cleanly and get the invocation status as returned by the target function.
+  iree_status_t invoke_status = iree_ok_status();
+  if (iree_status_is_ok(status)) {
+    status = iree_vm_end_invoke_packed(&state, &invoke_status);
+  }
+
+  // Otherwise if we failed to invoke we need to tear down the state to release
+  // all resources retained by the stack.
+  if (!iree_status_is_ok(status)) {
+    iree_vm_abort_invoke(&state);
+  }
+
+  // Leave the fiber context now that execution has completed.
+  IREE_TRACE(iree_vm_invoke_fiber_leave(invocation_id, state.stack));
+  IREE_TRACE_ZONE_END(zi);
+
+  // If we succeeded at invoking the status will be OK and the invoke_status
+  // will hold the status returned by the invokee. If we failed at invoking
+  // the invoke_status won't be set.
+  IREE_ASSERT(iree_status_is_ok(status) ||
+              (!iree_status_is_ok(status) && iree_status_is_ok(invoke_status)));
+  status = !iree_status_is_ok(invoke_status) ? invoke_status : status;
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
 //===----------------------------------------------------------------------===//
 // Asynchronous invocation
 //===----------------------------------------------------------------------===//
@@ -485,6 +560,7 @@ IREE_API_EXPORT iree_status_t iree_vm_begin_invoke(
   state->context = context;
   state->cconv_results = cconv_results;
   state->results = results;
+  state->caller_owned_results = false;
   iree_vm_context_retain(context);
   state->stack = stack;
 
@@ -519,6 +595,99 @@ IREE_API_EXPORT iree_status_t iree_vm_begin_invoke(
   return iree_ok_status();
 }
 
+// WARNING: this function cannot have any trace markers that span the begin
+// call; the begin may yield with zones still open.
+IREE_API_EXPORT iree_status_t iree_vm_begin_invoke_packed(
+    iree_vm_invoke_state_t* state, iree_vm_context_t* context,
+    iree_vm_function_t function, iree_vm_invocation_flags_t flags,
+    const iree_vm_invocation_policy_t* policy, iree_byte_span_t arguments,
+    iree_byte_span_t results, iree_allocator_t host_allocator) {
+  IREE_ASSERT_ARGUMENT(context);
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Force tracing if specified on the context.
+  if (iree_vm_context_flags(context) & IREE_VM_CONTEXT_FLAG_TRACE_EXECUTION) {
+    flags |= IREE_VM_INVOCATION_FLAG_TRACE_EXECUTION;
+  }
+
+  // Verify the caller-provided storage matches the function calling
+  // convention; a mismatch here would otherwise corrupt memory as the callee
+  // walks the buffers by cconv type.
+  iree_vm_function_signature_t signature =
+      iree_vm_function_signature(&function);
+  iree_string_view_t cconv_arguments = iree_string_view_empty();
+  iree_string_view_t cconv_results = iree_string_view_empty();
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_function_call_get_cconv_fragments(
+              &signature, &cconv_arguments, &cconv_results));
+  iree_host_size_t expected_argument_size = 0;
+  iree_host_size_t expected_result_size = 0;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_function_call_compute_cconv_fragment_size(
+              cconv_arguments, /*segment_size_list=*/NULL,
+              &expected_argument_size));
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_function_call_compute_cconv_fragment_size(
+              cconv_results, /*segment_size_list=*/NULL,
+              &expected_result_size));
+  if (IREE_UNLIKELY(arguments.data_length != expected_argument_size ||
+                    results.data_length != expected_result_size)) {
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(
+        IREE_STATUS_INVALID_ARGUMENT,
+        "packed argument/result storage mismatch; expected %" PRIhsz
+        "/%" PRIhsz " bytes but provided %" PRIhsz "/%" PRIhsz,
+        expected_argument_size, expected_result_size, arguments.data_length,
+        results.data_length);
+  }
+
+  // Initialize the stack with the inline storage. Unlike the list-based path
+  // the results live in caller storage and we don't carve any off for them.
+  iree_vm_stack_t* stack = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_stack_initialize(
+              iree_make_byte_span(state->stack_storage,
+                                  sizeof(state->stack_storage)),
+              flags, iree_vm_context_state_resolver(context), host_allocator,
+              &stack));
+
+  // NOTE: at this point the stack must be properly deinitialized if we bail.
+
+  // Initialize state now that we are confident we're returning OK.
+  state->context = context;
+  state->cconv_results = cconv_results;
+  state->results = results;
+  state->caller_owned_results = true;
+  iree_vm_context_retain(context);
+  state->stack = stack;
+
+  // NOTE: we must end the zone here as the begin_call will return with
+  // unbalanced zones if we yield.
+  IREE_TRACE_ZONE_END(z0);
+
+  // Execute the target function until the first yield point is reached or it
+  // completes. The caller retains ownership of the argument storage and any
+  // refs within it; the callee retains what it needs as it marshals them into
+  // registers.
+  iree_vm_function_call_t call = {
+      .function = function,
+      .arguments = arguments,
+      .results = results,
+  };
+  state->status =
+      function.module->begin_call(function.module->self, stack, call);
+
+  // The call may have yielded, either for cooperative scheduling purposes or
+  // for a wait operation (in which case the top of the stack will have a wait
+  // frame).
+  if (iree_status_is_deferred(state->status)) {
+    return iree_status_from_code(IREE_STATUS_DEFERRED);
+  }
+
+  // NOTE: the begin-invoke was ok, but the operation itself may have failed.
+  return iree_ok_status();
+}
+
 // WARNING: this function cannot have any trace markers that span the resume
 // call; the resume may yield with zones still open.
 IREE_API_EXPORT iree_status_t
@@ -664,6 +833,46 @@ IREE_API_EXPORT iree_status_t iree_vm_end_invoke(iree_vm_invoke_state_t* state,
   return iree_ok_status();
 }
 
+IREE_API_EXPORT iree_status_t iree_vm_end_invoke_packed(
+    iree_vm_invoke_state_t* state, iree_status_t* out_status) {
+  IREE_ASSERT_ARGUMENT(state);
+  IREE_ASSERT_ARGUMENT(out_status);
+  *out_status = iree_ok_status();
+
+  // Suspend stack frame tracing zones; see iree_vm_end_invoke.
+  iree_vm_stack_suspend_trace_zones(state->stack);
+
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Grab operation status. If this is not OK it's because the operation failed
+  // or the user is calling this with a wait frame on the stack.
+  iree_status_t invoke_status = state->status;
+  if (IREE_UNLIKELY(iree_status_is_deferred(invoke_status))) {
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(IREE_STATUS_FAILED_PRECONDITION,
+                            "end-invoke attempted on a waiting invocation");
+  } else if (IREE_UNLIKELY(!iree_status_is_ok(invoke_status))) {
+    // Annotate failures with the stack trace (if compiled in).
+    invoke_status = IREE_VM_STACK_ANNOTATE_BACKTRACE_IF_ENABLED(state->stack,
+                                                                invoke_status);
+  }
+
+  // Results were written directly into the caller-provided storage; on
+  // success ownership of any refs within transfers to the caller and we must
+  // not release them during cleanup below.
+  if (iree_status_is_ok(invoke_status)) {
+    state->results = iree_byte_span_empty();
+  }
+
+  // Cleanup the invocation resources.
+  *out_status = invoke_status;  // takes ownership
+  state->status = iree_ok_status();
+  iree_vm_abort_invoke(state);
+
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
 IREE_API_EXPORT void iree_vm_abort_invoke(iree_vm_invoke_state_t* state) {
   // We expect that the caller has already suspended the stack tracing zones,
   // but in failure cases we can end up here and want to ensure that things are
@@ -683,8 +892,16 @@ IREE_API_EXPORT void iree_vm_abort_invoke(iree_vm_invoke_state_t* state) {
   }
 
   if (!iree_byte_span_is_empty(state->results)) {
-    iree_vm_invoke_release_result_storage(state->cconv_results, state->results,
-                                          state->stack_storage, host_allocator);
+    if (state->caller_owned_results) {
+      // Failed before result ownership transferred to the caller; drop any
+      // refs the callee may have written but leave the storage itself alone.
+      iree_vm_invoke_release_io_refs(state->cconv_results, state->results);
+    } else {
+      iree_vm_invoke_release_result_storage(state->cconv_results,
+                                            state->results,
+                                            state->stack_storage,
+                                            host_allocator);
+    }
     state->results = iree_byte_span_empty();
   }
 
@@ -699,6 +916,13 @@ IREE_API_EXPORT void iree_vm_abort_invoke(iree_vm_invoke_state_t* state) {
   IREE_TRACE_ZONE_END(z0);
 }
 
+IREE_API_EXPORT void iree_vm_invoke_cancel(iree_vm_invoke_state_t* state) {
+  // The stack outlives all resume/wait steps so flagging it is sufficient;
+  // bytecode dispatch polls the flag at loop back-edges. If the invocation has
+  // already ended the stack is NULL and the request is a no-op.
+  if (state && state->stack) iree_vm_stack_cancel(state->stack);
+}
+
 //===----------------------------------------------------------------------===//
 // Loop-based asynchronous invocation
 //===----------------------------------------------------------------------===//
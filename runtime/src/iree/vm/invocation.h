@@ -48,6 +48,27 @@ IREE_API_EXPORT iree_status_t iree_vm_invoke(
     const iree_vm_list_t* inputs, iree_vm_list_t* outputs,
     iree_allocator_t host_allocator);
 
+// Synchronously invokes a function in the VM with caller-provided packed
+// argument and result storage.
+//
+// This is the zero-allocation variant of iree_vm_invoke: instead of marshaling
+// I/O through iree_vm_list_t the caller provides |arguments| and |results|
+// buffers in the calling convention layout of the target function (sized via
+// iree_vm_function_call_compute_cconv_fragment_size). Steady-state serving
+// loops can reuse the same buffers across calls to avoid the per-call list
+// resize and ref churn of the list-based API.
+//
+// |arguments| must be fully populated by the caller; any refs within are
+// borrowed for the duration of the call and remain owned by the caller.
+// |results| must be zero-initialized by the caller and upon successful return
+// will contain the function results; ownership of any refs within transfers
+// to the caller who must release them.
+IREE_API_EXPORT iree_status_t iree_vm_invoke_packed(
+    iree_vm_context_t* context, iree_vm_function_t function,
+    iree_vm_invocation_flags_t flags, const iree_vm_invocation_policy_t* policy,
+    iree_byte_span_t arguments, iree_byte_span_t results,
+    iree_allocator_t host_allocator);
+
 //===----------------------------------------------------------------------===//
 // Asynchronous invocation
 //===----------------------------------------------------------------------===//
@@ -87,6 +108,10 @@ typedef struct iree_vm_invoke_state_t {
   iree_string_view_t cconv_results;
   // Pointer into stack storage containing the results.
   iree_byte_span_t results;
+  // True if |results| is caller-provided packed storage that must survive the
+  // invocation (iree_vm_begin_invoke_packed) instead of being carved from the
+  // stack storage or heap.
+  bool caller_owned_results;
   // VM stack used during the invocation. Will retain required resources
   // across invocation stages.
   iree_vm_stack_t* stack;
@@ -120,6 +145,25 @@ IREE_API_EXPORT iree_status_t iree_vm_begin_invoke(
     const iree_vm_invocation_policy_t* policy, const iree_vm_list_t* inputs,
     iree_allocator_t host_allocator);
 
+// Begins an invocation of |function| in |context| with packed |arguments|.
+//
+// This is the packed-storage equivalent of iree_vm_begin_invoke: |arguments|
+// and |results| are caller-provided buffers in the calling convention layout
+// of |function|. |arguments| is only required to survive until this returns
+// while |results| must remain valid until the invocation ends. See
+// iree_vm_invoke_packed for the storage ownership rules.
+//
+// Returns OK if the invocation began regardless of the invocation result.
+// When OK iree_vm_end_invoke_packed is used to retrieve the invocation result.
+// If IREE_STATUS_DEFERRED is returned one of iree_vm_resume_invoke or
+// iree_vm_wait_invoke (or other wait frame handling) must be performed by the
+// caller.
+IREE_API_EXPORT iree_status_t iree_vm_begin_invoke_packed(
+    iree_vm_invoke_state_t* state, iree_vm_context_t* context,
+    iree_vm_function_t function, iree_vm_invocation_flags_t flags,
+    const iree_vm_invocation_policy_t* policy, iree_byte_span_t arguments,
+    iree_byte_span_t results, iree_allocator_t host_allocator);
+
 // Resumes an invocation previously began with iree_vm_begin_invoke.
 // Only valid to call if a prior call to iree_vm_begin_invoke or
 // iree_vm_resume_invoke returned IREE_STATUS_DEFERRED.
@@ -162,6 +206,13 @@ IREE_API_EXPORT iree_status_t iree_vm_end_invoke(iree_vm_invoke_state_t* state,
                                                  iree_vm_list_t* outputs,
                                                  iree_status_t* out_status);
 
+// Ends an invocation sequence began with iree_vm_begin_invoke_packed.
+// The results were written directly into the caller-provided storage; if the
+// invocation succeeded ownership of any refs within transfers to the caller.
+// Otherwise behaves as iree_vm_end_invoke.
+IREE_API_EXPORT iree_status_t iree_vm_end_invoke_packed(
+    iree_vm_invoke_state_t* state, iree_status_t* out_status);
+
 // Aborts an invocation sequence prior to it having successfully ended.
 // Invocation resources in |state| will be released and upon return the storage
 // can be reused for another invocation. Note that the context the invocation is
@@ -178,6 +229,16 @@ IREE_API_EXPORT iree_status_t iree_vm_end_invoke(iree_vm_invoke_state_t* state,
 // succeeded then iree_vm_end_invoke must be used instead.
 IREE_API_EXPORT void iree_vm_abort_invoke(iree_vm_invoke_state_t* state);
 
+// Requests cooperative cancellation of an in-flight invocation sequence.
+// May be called from any thread between a successful iree_vm_begin_invoke and
+// the matching iree_vm_end_invoke/iree_vm_abort_invoke; the invocation will
+// observe the request at the next bytecode loop back-edge and complete with
+// IREE_STATUS_CANCELLED, after which the normal end/abort sequence applies.
+// Device-side work already queued is not interrupted; callers that need the
+// device to unwind should fail the relevant semaphores with the CANCELLED
+// status (iree_hal_semaphore_fail).
+IREE_API_EXPORT void iree_vm_invoke_cancel(iree_vm_invoke_state_t* state);
+
 //===----------------------------------------------------------------------===//
 // Loop-based asynchronous invocation
 //===----------------------------------------------------------------------===//
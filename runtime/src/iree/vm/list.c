@@ -195,6 +195,21 @@ IREE_API_EXPORT void iree_vm_list_deinitialize(iree_vm_list_t* list) {
   IREE_TRACE_ZONE_END(z0);
 }
 
+// The inline storage reserves a fixed prefix for the list bookkeeping; keep
+// the public bound honest as fields are added to iree_vm_list_t.
+// NOTE: the reservation is 8-byte aligned so comparing the raw size is
+// equivalent to comparing the aligned bookkeeping prefix.
+static_assert(sizeof(iree_vm_list_t) <= IREE_VM_LIST_INLINE_STORAGE_RESERVED,
+              "iree_vm_list_t grew beyond the inline storage reservation");
+
+IREE_API_EXPORT iree_status_t iree_vm_list_initialize_inline(
+    iree_vm_list_inline_storage_t* storage,
+    const iree_vm_type_def_t* element_type, iree_vm_list_t** out_list) {
+  return iree_vm_list_initialize(
+      iree_make_byte_span(storage->data, sizeof(storage->data)), element_type,
+      IREE_VM_LIST_INLINE_STORAGE_CAPACITY, out_list);
+}
+
 IREE_API_EXPORT iree_status_t iree_vm_list_create(
     const iree_vm_type_def_t element_type, iree_host_size_t initial_capacity,
     iree_allocator_t allocator, iree_vm_list_t** out_list) {
@@ -55,6 +55,37 @@ IREE_API_EXPORT iree_status_t iree_vm_list_initialize(
 // iree_vm_list_initialize. Aborts if there are still references remaining.
 IREE_API_EXPORT void iree_vm_list_deinitialize(iree_vm_list_t* list);
 
+// Number of elements an inline-storage list can hold.
+// Sized to cover typical invocation marshaling (a handful of arguments and
+// results); larger lists should use iree_vm_list_storage_size with dedicated
+// storage or a heap-allocated iree_vm_list_create.
+#define IREE_VM_LIST_INLINE_STORAGE_CAPACITY 8
+
+// Conservative bound on the list bookkeeping prefix within the storage.
+// Statically asserted against the actual (private) list size in list.c.
+#define IREE_VM_LIST_INLINE_STORAGE_RESERVED 128
+
+// Stack-allocatable storage for a small list of any element type.
+// Sized for the worst case of variant elements so the same storage works for
+// value, ref, and variant lists.
+typedef struct iree_vm_list_inline_storage_t {
+  iree_alignas(iree_max_align_t) uint8_t
+      data[IREE_VM_LIST_INLINE_STORAGE_RESERVED +
+           IREE_VM_LIST_INLINE_STORAGE_CAPACITY * sizeof(iree_vm_variant_t)];
+} iree_vm_list_inline_storage_t;
+
+// Initializes a list of up to IREE_VM_LIST_INLINE_STORAGE_CAPACITY elements
+// living entirely within caller-provided |storage| (usually a stack frame).
+// Marshaling a typical invocation through such a list touches no allocator
+// paths. The list cannot grow beyond the inline capacity.
+//
+// As with iree_vm_list_initialize the lifetime is controlled by the caller:
+// the storage must remain valid until iree_vm_list_deinitialize is called and
+// no other references to the list remain.
+IREE_API_EXPORT iree_status_t iree_vm_list_initialize_inline(
+    iree_vm_list_inline_storage_t* storage,
+    const iree_vm_type_def_t* element_type, iree_vm_list_t** out_list);
+
 // Creates a growable list containing the given |element_type|, which may either
 // be a primitive iree_vm_value_type_t value (like i32) or a ref type. When
 // storing ref types the list may either store a specific iree_vm_ref_type_t
@@ -255,6 +255,14 @@ IREE_API_EXPORT iree_string_view_t iree_vm_module_lookup_attr_by_name(
   return iree_string_view_empty();
 }
 
+IREE_API_EXPORT bool iree_vm_module_has_shared_state(
+    const iree_vm_module_t* module) {
+  return iree_string_view_equal(
+      iree_vm_module_lookup_attr_by_name(module,
+                                         IREE_SV("vm.state.model")),
+      IREE_SV("shared"));
+}
+
 IREE_API_EXPORT iree_status_t
 iree_vm_module_get_attr(const iree_vm_module_t* module, iree_host_size_t index,
                         iree_string_pair_t* out_attr) {
@@ -492,6 +492,16 @@ IREE_API_EXPORT iree_status_t
 iree_vm_module_get_attr(const iree_vm_module_t* module, iree_host_size_t index,
                         iree_string_pair_t* out_attr);
 
+// Returns true if |module| declares its per-context state may be shared.
+// Modules declare this with the `vm.state.model`=`shared` module-level
+// reflection attribute, promising that their state is immutable after
+// initialization or internally synchronized and thus safe to reference from
+// multiple contexts (and threads) concurrently. Contexts forked from one
+// another use this to alias a single state instance instead of allocating and
+// initializing a private copy per fork.
+IREE_API_EXPORT bool iree_vm_module_has_shared_state(
+    const iree_vm_module_t* module);
+
 // Enumerates all modules that |module| depends on, calling the provided
 // |callback| once per module.
 // Failures from the callback will be propagated to the caller.
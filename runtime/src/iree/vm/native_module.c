@@ -366,6 +366,56 @@ static iree_status_t iree_vm_native_module_issue_call(
   return iree_vm_stack_function_leave(stack);
 }
 
+// Calls a leaf function without materializing a stack frame.
+// Modules declaring IREE_VM_NATIVE_MODULE_FLAG_LEAF promise their exports
+// never re-enter the VM or suspend so no frame needs to be preserved across
+// the call; the per-call cost reduces to a module state query and the shim
+// dispatch. The function will not appear in stack traces captured while it
+// executes.
+static iree_status_t iree_vm_native_module_issue_leaf_call(
+    iree_vm_native_module_t* module, iree_vm_stack_t* stack,
+    iree_vm_function_call_t call) {
+  // Resolve module state directly; with no callee frame there's no cached
+  // per-frame copy for subsequent calls to reuse.
+  iree_vm_module_state_t* module_state = NULL;
+  IREE_RETURN_IF_ERROR(iree_vm_stack_query_module_state(
+      stack, call.function.module, &module_state));
+
+  // Call the target function using the shim.
+  const uint16_t function_ordinal = call.function.ordinal;
+  const iree_vm_native_function_ptr_t* function_ptr =
+      &module->descriptor->functions[function_ordinal];
+  iree_status_t status = function_ptr->shim(
+      stack, IREE_VM_NATIVE_FUNCTION_CALL_BEGIN, call.arguments, call.results,
+      function_ptr->target, module->self, module_state);
+  if (IREE_LIKELY(iree_status_is_ok(status))) return status;
+
+  if (IREE_UNLIKELY(iree_status_is_deferred(status))) {
+    // Deferral requires a preserved frame to resume and leaf modules declared
+    // they would never do it; this is a bug in the module implementation.
+    iree_status_ignore(status);
+    return iree_make_status(
+        IREE_STATUS_FAILED_PRECONDITION,
+        "native module declared IREE_VM_NATIVE_MODULE_FLAG_LEAF but attempted "
+        "to defer a call; leaf functions must complete synchronously");
+  }
+
+#if IREE_STATUS_FEATURES & IREE_STATUS_FEATURE_ANNOTATIONS
+  iree_string_view_t module_name IREE_ATTRIBUTE_UNUSED =
+      iree_vm_native_module_name(module);
+  iree_string_view_t function_name IREE_ATTRIBUTE_UNUSED =
+      iree_string_view_empty();
+  iree_status_ignore(iree_vm_native_module_get_export_function(
+      module, function_ordinal, NULL, &function_name, NULL));
+  return iree_status_annotate_f(status,
+                                "while invoking native function %.*s.%.*s",
+                                (int)module_name.size, module_name.data,
+                                (int)function_name.size, function_name.data);
+#else
+  return status;
+#endif  // IREE_STATUS_FEATURES & IREE_STATUS_FEATURE_ANNOTATIONS
+}
+
 static iree_status_t IREE_API_PTR iree_vm_native_module_begin_call(
     void* self, iree_vm_stack_t* stack, iree_vm_function_call_t call) {
   iree_vm_native_module_t* module = (iree_vm_native_module_t*)self;
@@ -381,6 +431,12 @@ static iree_status_t IREE_API_PTR iree_vm_native_module_begin_call(
     return module->user_interface.begin_call(module->self, stack, call);
   }
 
+  // Leaf modules skip the stack frame protocol entirely.
+  if (iree_all_bits_set(module->descriptor->flags,
+                        IREE_VM_NATIVE_MODULE_FLAG_LEAF)) {
+    return iree_vm_native_module_issue_leaf_call(module, stack, call);  // tail
+  }
+
   // NOTE: VM stack is currently unused. We could stash things here for the
   // debugger or use it for coroutine state.
   iree_host_size_t frame_size = 0;
@@ -74,6 +74,18 @@ typedef struct iree_vm_native_function_ptr_t {
   iree_vm_native_function_target_t target;
 } iree_vm_native_function_ptr_t;
 
+enum iree_vm_native_module_flag_bits_t {
+  IREE_VM_NATIVE_MODULE_FLAG_NONE = 0u,
+  // All exported functions are leaf calls: they never call back into the VM,
+  // never suspend by returning a deferred status, and never push wait frames.
+  // The default begin_call implementation uses this to skip stack frame
+  // materialization entirely and dispatch straight to the function shim,
+  // shaving the per-call frame setup/teardown off hot native calls. Leaf
+  // calls do not appear in stack traces as no frame is ever allocated.
+  IREE_VM_NATIVE_MODULE_FLAG_LEAF = 1u << 0,
+};
+typedef uint32_t iree_vm_native_module_flags_t;
+
 // Describes a native module implementation by way of descriptor tables.
 // All of this information is assumed read-only and will be referenced for the
 // lifetime of any module created with the descriptor.
@@ -116,6 +128,11 @@ typedef struct iree_vm_native_module_descriptor_t {
   // implementation and are optional if overriding begin_call.
   iree_host_size_t function_count;
   const iree_vm_native_function_ptr_t* functions;
+
+  // Flags controlling how calls into the module are made.
+  // NOTE: kept at the end of the struct so that descriptors initialized
+  // positionally (such as generated C sources) default to no flags.
+  iree_vm_native_module_flags_t flags;
 } iree_vm_native_module_descriptor_t;
 
 // Returns the size, in bytes, of the allocation required for native modules.
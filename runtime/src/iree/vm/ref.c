@@ -144,6 +144,13 @@ IREE_API_EXPORT void iree_vm_ref_retain(iree_vm_ref_t* ref,
   IREE_VM_REF_ASSERT(ref);
   IREE_VM_REF_ASSERT(out_ref);
   iree_vm_ref_t temp_ref = *ref;
+  if (out_ref->ptr == temp_ref.ptr) {
+    // Retaining into a ref already holding the same object (including into
+    // itself): the retain and release cancel out and we can skip both counter
+    // operations.
+    *out_ref = temp_ref;
+    return;
+  }
   if (ref->ptr) {
     volatile iree_atomic_ref_count_t* counter =
         iree_vm_get_ref_counter_ptr(ref);
@@ -204,6 +204,20 @@ TEST(VMRefTest, RetainIntoSelf) {
   iree_vm_ref_release(&a_ref);
 }
 
+// Tests that retaining over a ref already holding the same object keeps the
+// counter balanced without requiring a retain/release pair.
+TEST(VMRefTest, RetainIntoSameObject) {
+  auto instance = MakeInstance();
+  iree_vm_ref_t a_ref = MakeRef<A>(instance, "AType");
+  iree_vm_ref_t b_ref = {0};
+  iree_vm_ref_retain(&a_ref, &b_ref);
+  EXPECT_EQ(2, ReadCounter(&a_ref));
+  iree_vm_ref_retain(&a_ref, &b_ref);
+  EXPECT_EQ(2, ReadCounter(&a_ref));
+  iree_vm_ref_release(&a_ref);
+  iree_vm_ref_release(&b_ref);
+}
+
 // Tests that retaining into out_ref releases the existing contents.
 TEST(VMRefTest, RetainReleasesExisting) {
   auto instance = MakeInstance();
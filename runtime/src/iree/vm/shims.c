@@ -58,6 +58,7 @@ IREE_VM_ABI_DEFINE_SHIM(rrCrIID, v);
 IREE_VM_ABI_DEFINE_SHIM(rriCiD, v);
 IREE_VM_ABI_DEFINE_SHIM(rriiCID, v);
 IREE_VM_ABI_DEFINE_SHIM(rriCiirIID, v);
+IREE_VM_ABI_DEFINE_SHIM(rrii, r);
 IREE_VM_ABI_DEFINE_SHIM(rriiii, v);
 IREE_VM_ABI_DEFINE_SHIM(rrIIii, v);
 IREE_VM_ABI_DEFINE_SHIM(rrirCID, v);
@@ -361,6 +361,13 @@ IREE_VM_ABI_FIXED_STRUCT(rriirIIrIII, {
   int64_t i10;
 });
 
+IREE_VM_ABI_FIXED_STRUCT(rrii, {
+  iree_vm_ref_t r0;
+  iree_vm_ref_t r1;
+  int32_t i2;
+  int32_t i3;
+});
+
 IREE_VM_ABI_FIXED_STRUCT(rriiii, {
   iree_vm_ref_t r0;
   iree_vm_ref_t r1;
@@ -665,6 +672,7 @@ IREE_VM_ABI_DECLARE_SHIM(rrCrIID, v);
 IREE_VM_ABI_DECLARE_SHIM(rriCiD, v);
 IREE_VM_ABI_DECLARE_SHIM(rriiCID, v);
 IREE_VM_ABI_DECLARE_SHIM(rriCiirIID, v);
+IREE_VM_ABI_DECLARE_SHIM(rrii, r);
 IREE_VM_ABI_DECLARE_SHIM(rriiii, v);
 IREE_VM_ABI_DECLARE_SHIM(rrIIii, v);
 IREE_VM_ABI_DECLARE_SHIM(rrirCID, v);
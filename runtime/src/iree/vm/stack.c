@@ -12,6 +12,7 @@
 #include <string.h>
 
 #include "iree/base/api.h"
+#include "iree/base/internal/atomics.h"
 #include "iree/vm/module.h"
 
 //===----------------------------------------------------------------------===//
@@ -63,13 +64,14 @@
 // expand the required register count for a function from 30 to 3000.
 //
 // To support these cases the stack can optionally be provided an allocator to
-// enable it to grow the stack when the initial storage is exhausted. As we
-// store pointers to the stack storage within the storage itself (such as the
-// iree_vm_registers_t pointers) this means we need to perform a fixup step
-// during reallocation to ensure they are all updated. This also means that the
-// pointers to the stack frames are possibly invalidated on every function
-// entry and that users of the stack cannot rely on pointer stability during
-// execution.
+// enable it to grow the stack when the initial storage is exhausted. Frame
+// storage is segmented: when the current segment is exhausted a new
+// geometrically-larger segment is linked in and frames continue to be
+// bump-allocated from it. Existing frames are never moved and pointers into
+// them remain stable for the lifetime of the frame. As frames pop in LIFO
+// order emptied segments are retired back to a single-entry reuse cache so
+// that invocations oscillating around a segment boundary don't allocate on
+// every call; steady-state execution performs no allocations at all.
 //
 // Calling convention
 // ------------------
@@ -107,12 +109,36 @@
 // code paths which are likely still in instruction cache the bulk of the work
 // amounts to some small memcpys.
 
-// Multiplier on the capacity of the stack frame storage when growing.
+// Multiplier on the capacity of the previous segment when growing.
 // Since we never shrink stacks it's nice to keep this relative low. If we
 // measure a lot of growth happening in normal models we should increase this
 // but otherwise leave as small as we can to avoid overallocation.
 #define IREE_VM_STACK_GROWTH_FACTOR 2
 
+// A segment of frame storage within the stack.
+// Segments form a singly-linked list from the most recently allocated segment
+// back to the initial (often caller-provided) storage. Frames are always
+// bump-allocated from the newest segment and as they pop in LIFO order an
+// emptied segment is unlinked and retired. Because segments are never moved
+// or resized in place frame pointers remain stable for the lifetime of the
+// frame; growing the stack is O(1) with no fixup pass over live frames.
+typedef struct iree_vm_stack_segment_t {
+  // Previous (older) segment in the stack; NULL if this is the initial
+  // segment embedded in the stack storage.
+  struct iree_vm_stack_segment_t* parent;
+  // Total capacity, in bytes, of the storage following this header.
+  iree_host_size_t capacity;
+  // Bytes of storage currently in use by live frames.
+  iree_host_size_t size;
+  // Frame storage follows the (aligned) header in memory.
+} iree_vm_stack_segment_t;
+
+// Returns the base pointer of the frame storage within |segment|.
+static inline uint8_t* iree_vm_stack_segment_storage(
+    iree_vm_stack_segment_t* segment) {
+  return (uint8_t*)segment + iree_host_align(sizeof(*segment), 16);
+}
+
 // A private stack frame header that allows us to walk the linked list of
 // frames without exposing their exact structure through the API. This makes it
 // easier for us to add/version additional information or hide implementation
@@ -120,8 +146,7 @@
 typedef struct iree_vm_stack_frame_header_t {
   // Size, in bytes, of the frame header and frame payload including registers.
   // Adding this value to the base header pointer will yield the next available
-  // memory location. Ensure that it does not exceed the total
-  // frame_storage_capacity.
+  // memory location within the owning segment.
   iree_host_size_t frame_size;
 
   // Pointer to the parent stack frame, usually immediately preceding this one
@@ -145,33 +170,40 @@ typedef struct iree_vm_stack_frame_header_t {
 
 // Core stack storage. This will be mapped either into dynamic memory allocated
 // by the member allocator or static memory allocated externally. Static stacks
-// cannot grow when storage runs out while dynamic ones will resize their stack.
+// cannot grow when storage runs out while dynamic ones will link in additional
+// storage segments.
 struct iree_vm_stack_t {
   // NOTE: to get better cache hit rates we put the most frequently accessed
   // members first.
 
   // Pointer to the current top of the stack.
   // This can be used to walk the stack from top to bottom by following the
-  // |parent| pointers. Note that these pointers are invalidated each time the
-  // stack grows (if dynamic growth is enabled) and all of the frames will need
-  // updating.
+  // |parent| pointers.
   iree_vm_stack_frame_header_t* top;
 
-  // Base pointer to stack storage.
-  // For statically-allocated stacks this will (likely) point to immediately
-  // after the iree_vm_stack_t in memory. For dynamically-allocated stacks this
-  // will (likely) point to heap memory.
-  iree_host_size_t frame_storage_capacity;
-  iree_host_size_t frame_storage_size;
-  void* frame_storage;
+  // Newest frame storage segment; frames are bump-allocated from it.
+  // The initial segment is embedded in the stack storage (likely immediately
+  // after the iree_vm_stack_t in memory) while segments linked in by dynamic
+  // growth live on the heap and are owned by the stack.
+  iree_vm_stack_segment_t* current_segment;
+
+  // Total capacity, in bytes, across all live segments. Used to enforce
+  // IREE_VM_STACK_MAX_SIZE as segments are linked in.
+  iree_host_size_t total_capacity;
+
+  // Single-entry cache of the last heap segment emptied by frames popping.
+  // Reused on the next growth so invocations bouncing across a segment
+  // boundary don't hit the allocator each time. NULL if empty.
+  iree_vm_stack_segment_t* segment_cache;
 
   // Flags controlling the behavior of the invocation owning this stack.
   iree_vm_invocation_flags_t flags;
 
-  // True if the stack owns the frame_storage and should free it when it is no
-  // longer required. Host stack-allocated stacks don't own their storage but
-  // may transition to owning it on dynamic growth.
-  bool owns_frame_storage;
+  // Non-zero when cancellation of the owning invocation has been requested.
+  // Set from any thread via iree_vm_stack_cancel and polled by dispatchers at
+  // deterministic points (bytecode loop back-edges). Sticky until the stack is
+  // reset or deinitialized.
+  iree_atomic_int32_t cancellation_pending;
 
   // Resolves a module to a module state within a context.
   // This will be called on function entry whenever module transitions occur.
@@ -203,16 +235,25 @@ IREE_API_EXPORT iree_status_t iree_vm_stack_initialize(
 
   iree_vm_stack_t* stack = (iree_vm_stack_t*)storage.data;
   memset(stack, 0, sizeof(iree_vm_stack_t));
-  stack->owns_frame_storage = false;
   stack->flags = flags;
   stack->state_resolver = state_resolver;
   stack->allocator = allocator;
+  iree_atomic_store_int32(&stack->cancellation_pending, 0,
+                          iree_memory_order_relaxed);
 
+  // Embed the initial segment in the remaining storage; its frame storage
+  // begins after the (aligned) segment header.
   iree_host_size_t storage_offset =
       iree_host_align(sizeof(iree_vm_stack_t), 16);
-  stack->frame_storage_capacity = storage.data_length - storage_offset;
-  stack->frame_storage_size = 0;
-  stack->frame_storage = storage.data + storage_offset;
+  iree_vm_stack_segment_t* segment =
+      (iree_vm_stack_segment_t*)(storage.data + storage_offset);
+  segment->parent = NULL;
+  segment->capacity = storage.data_length - storage_offset -
+                      iree_host_align(sizeof(iree_vm_stack_segment_t), 16);
+  segment->size = 0;
+  stack->current_segment = segment;
+  stack->total_capacity = segment->capacity;
+  stack->segment_cache = NULL;
 
   stack->top = NULL;
 
@@ -230,18 +271,22 @@ IREE_API_EXPORT void iree_vm_stack_reset(iree_vm_stack_t* stack) {
     iree_status_ignore(iree_vm_stack_function_leave(stack));
   }
 
+  // Clear any pending cancellation so reused stack storage starts fresh.
+  iree_atomic_store_int32(&stack->cancellation_pending, 0,
+                          iree_memory_order_relaxed);
+
   IREE_TRACE_ZONE_END(z0);
 }
 
 IREE_API_EXPORT void iree_vm_stack_deinitialize(iree_vm_stack_t* stack) {
   IREE_TRACE_ZONE_BEGIN(z0);
 
-  // Release stack frame resources.
+  // Release stack frame resources. All heap segments are retired as their
+  // frames pop so after this only the reuse cache may hold one.
   iree_vm_stack_reset(stack);
-
-  // Drop allocated frame storage.
-  if (stack->owns_frame_storage) {
-    iree_allocator_free(stack->allocator, stack->frame_storage);
+  if (stack->segment_cache) {
+    iree_allocator_free(stack->allocator, stack->segment_cache);
+    stack->segment_cache = NULL;
   }
 
   IREE_TRACE_ZONE_END(z0);
@@ -291,6 +336,17 @@ iree_vm_stack_invocation_flags(const iree_vm_stack_t* stack) {
   return stack->flags;
 }
 
+IREE_API_EXPORT void iree_vm_stack_cancel(iree_vm_stack_t* stack) {
+  iree_atomic_store_int32(&stack->cancellation_pending, 1,
+                          iree_memory_order_release);
+}
+
+IREE_API_EXPORT bool iree_vm_stack_is_cancelled(const iree_vm_stack_t* stack) {
+  return iree_atomic_load_int32(
+             &((iree_vm_stack_t*)stack)->cancellation_pending,
+             iree_memory_order_acquire) != 0;
+}
+
 IREE_API_EXPORT iree_vm_stack_frame_t* iree_vm_stack_top(
     iree_vm_stack_t* stack) {
   if (!stack->top) {
@@ -327,10 +383,10 @@ IREE_API_EXPORT iree_status_t iree_vm_stack_query_module_state(
                                                   module, out_module_state);
 }
 
-// Attempts to grow the stack store to hold at least |minimum_capacity|.
-// Pointers to existing stack frames will be invalidated and any pointers
-// embedded in the stack frame data structures will be updated.
-// Fails if dynamic stack growth is disabled or the allocator is OOM.
+// Attempts to grow the stack by linking in a new segment able to hold at
+// least |minimum_capacity| bytes. Existing frames are not moved and pointers
+// to them remain valid. Fails if dynamic stack growth is disabled or the
+// allocator is OOM.
 static iree_status_t iree_vm_stack_grow(iree_vm_stack_t* stack,
                                         iree_host_size_t minimum_capacity) {
   if (IREE_UNLIKELY(stack->allocator.ctl == NULL)) {
@@ -339,67 +395,73 @@ static iree_status_t iree_vm_stack_grow(iree_vm_stack_t* stack,
         "stack initialized on the host stack and cannot grow");
   }
 
-  // Ensure we grow at least as much as required.
-  iree_host_size_t new_capacity = stack->frame_storage_capacity;
+  // Size the new segment geometrically off the previous one so deep stacks
+  // only need O(log n) segments while still covering single frames larger
+  // than anything seen so far.
+  iree_host_size_t new_capacity = stack->current_segment->capacity;
   do {
     new_capacity *= IREE_VM_STACK_GROWTH_FACTOR;
   } while (new_capacity < minimum_capacity);
-  if (new_capacity > IREE_VM_STACK_MAX_SIZE) {
+
+  // Reuse the cached segment if it's big enough; otherwise allocate anew.
+  iree_vm_stack_segment_t* segment = NULL;
+  if (stack->segment_cache &&
+      stack->segment_cache->capacity >= minimum_capacity) {
+    segment = stack->segment_cache;
+    stack->segment_cache = NULL;
+    new_capacity = segment->capacity;
+  }
+
+  if (stack->total_capacity + new_capacity > IREE_VM_STACK_MAX_SIZE) {
+    if (segment) stack->segment_cache = segment;  // put it back
     return iree_make_status(IREE_STATUS_RESOURCE_EXHAUSTED,
                             "new stack size would exceed maximum size: %" PRIhsz
                             " > %d",
-                            new_capacity, IREE_VM_STACK_MAX_SIZE);
+                            stack->total_capacity + new_capacity,
+                            IREE_VM_STACK_MAX_SIZE);
   }
 
   IREE_TRACE_ZONE_BEGIN(z0);
 
-  // Reallocate the frame storage. 99.9999% chance the new storage pointer will
-  // differ and we'll need to fix up pointers so we just always do that.
-  void* old_storage = stack->frame_storage;
-  void* new_storage = stack->frame_storage;
-  iree_status_t status;
-  if (stack->owns_frame_storage) {
-    // We own the storage already likely from a previous growth operation.
-    status =
-        iree_allocator_realloc(stack->allocator, new_capacity, &new_storage);
-  } else {
-    // We don't own the original storage so we are going to switch to our own
-    // newly-allocated storage instead. We need to make sure we copy over the
-    // existing stack contents.
-    status =
-        iree_allocator_malloc(stack->allocator, new_capacity, &new_storage);
-    if (iree_status_is_ok(status)) {
-      memcpy(new_storage, old_storage, stack->frame_storage_capacity);
+  if (!segment) {
+    iree_status_t status = iree_allocator_malloc(
+        stack->allocator,
+        iree_host_align(sizeof(iree_vm_stack_segment_t), 16) + new_capacity,
+        (void**)&segment);
+    if (!iree_status_is_ok(status)) {
+      IREE_TRACE_ZONE_END(z0);
+      return status;
     }
-  }
-  if (!iree_status_is_ok(status)) {
-    IREE_TRACE_ZONE_END(z0);
-    return status;
-  }
-  stack->frame_storage = new_storage;
-  stack->frame_storage_capacity = new_capacity;
-  stack->owns_frame_storage = true;
-
-#define REBASE_POINTER(type, ptr, old_base, new_base)           \
-  if (ptr) {                                                    \
-    (ptr) = (type)(((uintptr_t)(ptr) - (uintptr_t)(old_base)) + \
-                   (uintptr_t)(new_base));                      \
+    segment->capacity = new_capacity;
   }
 
-  // Fixup embedded stack frame pointers.
-  REBASE_POINTER(iree_vm_stack_frame_header_t*, stack->top, old_storage,
-                 new_storage);
-  iree_vm_stack_frame_header_t* frame_header = stack->top;
-  while (frame_header != NULL) {
-    REBASE_POINTER(iree_vm_stack_frame_header_t*, frame_header->parent,
-                   old_storage, new_storage);
-    frame_header = frame_header->parent;
-  }
+  segment->parent = stack->current_segment;
+  segment->size = 0;
+  stack->current_segment = segment;
+  stack->total_capacity += segment->capacity;
 
   IREE_TRACE_ZONE_END(z0);
   return iree_ok_status();
 }
 
+// Retires an emptied heap |segment| after its last frame has popped.
+// The segment is parked in the single-entry reuse cache (displacing any
+// smaller occupant) so the next growth along the same path is allocation-free.
+static void iree_vm_stack_segment_retire(iree_vm_stack_t* stack,
+                                         iree_vm_stack_segment_t* segment) {
+  stack->current_segment = segment->parent;
+  stack->total_capacity -= segment->capacity;
+  segment->parent = NULL;
+  if (!stack->segment_cache) {
+    stack->segment_cache = segment;
+  } else if (stack->segment_cache->capacity < segment->capacity) {
+    iree_allocator_free(stack->allocator, stack->segment_cache);
+    stack->segment_cache = segment;
+  } else {
+    iree_allocator_free(stack->allocator, segment);
+  }
+}
+
 #if IREE_TRACING_FEATURES & IREE_TRACING_FEATURE_INSTRUMENTATION
 static iree_zone_id_t iree_vm_stack_trace_wait_zone_begin(
     iree_vm_wait_type_t wait_type, iree_host_size_t wait_count) {
@@ -436,10 +498,11 @@ IREE_API_EXPORT iree_status_t iree_vm_stack_wait_enter(
 
   // Allocate stack space and grow stack, if required.
   iree_host_size_t header_size = sizeof(iree_vm_stack_frame_header_t);
-  iree_host_size_t new_top =
-      stack->frame_storage_size + header_size + frame_size;
-  if (IREE_UNLIKELY(new_top > stack->frame_storage_capacity)) {
-    IREE_RETURN_IF_ERROR(iree_vm_stack_grow(stack, new_top));
+  iree_host_size_t total_size = header_size + frame_size;
+  iree_vm_stack_segment_t* segment = stack->current_segment;
+  if (IREE_UNLIKELY(segment->size + total_size > segment->capacity)) {
+    IREE_RETURN_IF_ERROR(iree_vm_stack_grow(stack, total_size));
+    segment = stack->current_segment;
   }
 
   // Try to reuse the same module state if the caller and callee are from the
@@ -448,13 +511,13 @@ IREE_API_EXPORT iree_status_t iree_vm_stack_wait_enter(
   iree_vm_stack_frame_t* caller_frame =
       caller_frame_header ? &caller_frame_header->frame : NULL;
 
-  // Bump pointer and get real stack pointer offsets.
+  // Bump-allocate the frame from the current segment.
   iree_vm_stack_frame_header_t* frame_header =
-      (iree_vm_stack_frame_header_t*)((uintptr_t)stack->frame_storage +
-                                      stack->frame_storage_size);
-  memset(frame_header, 0, header_size + frame_size);
+      (iree_vm_stack_frame_header_t*)(iree_vm_stack_segment_storage(segment) +
+                                      segment->size);
+  memset(frame_header, 0, total_size);
 
-  frame_header->frame_size = header_size + frame_size;
+  frame_header->frame_size = total_size;
   frame_header->parent = stack->top;
   frame_header->data_size = frame_size;
   // TODO(benvanik): allow a custom cleanup function so callers can be notified
@@ -466,7 +529,7 @@ IREE_API_EXPORT iree_status_t iree_vm_stack_wait_enter(
   callee_frame->type = IREE_VM_STACK_FRAME_WAIT;
   callee_frame->depth = caller_frame ? caller_frame->depth + 1 : 0;
 
-  stack->frame_storage_size = new_top;
+  segment->size += total_size;
   stack->top = frame_header;
 
   IREE_TRACE({
@@ -514,9 +577,14 @@ IREE_API_EXPORT iree_status_t iree_vm_stack_wait_leave(
     out_wait_result->trace_zone = wait_frame->trace_zone;
   });
 
-  // Restore the frame pointer to the caller.
-  stack->frame_storage_size -= stack->top->frame_size;
+  // Restore the frame pointer to the caller; the top frame always lives in
+  // the newest segment and popping it may leave that segment empty.
+  iree_vm_stack_segment_t* segment = stack->current_segment;
+  segment->size -= stack->top->frame_size;
   stack->top = stack->top->parent;
+  if (segment->size == 0 && segment->parent != NULL) {
+    iree_vm_stack_segment_retire(stack, segment);
+  }
 
   return iree_ok_status();
 }
@@ -545,10 +613,11 @@ IREE_API_EXPORT iree_status_t iree_vm_stack_function_enter(
 
   // Allocate stack space and grow stack, if required.
   iree_host_size_t header_size = sizeof(iree_vm_stack_frame_header_t);
-  iree_host_size_t new_top =
-      stack->frame_storage_size + header_size + frame_size;
-  if (IREE_UNLIKELY(new_top > stack->frame_storage_capacity)) {
-    IREE_RETURN_IF_ERROR(iree_vm_stack_grow(stack, new_top));
+  iree_host_size_t total_size = header_size + frame_size;
+  iree_vm_stack_segment_t* segment = stack->current_segment;
+  if (IREE_UNLIKELY(segment->size + total_size > segment->capacity)) {
+    IREE_RETURN_IF_ERROR(iree_vm_stack_grow(stack, total_size));
+    segment = stack->current_segment;
   }
 
   // Try to reuse the same module state if the caller and callee are from the
@@ -564,13 +633,13 @@ IREE_API_EXPORT iree_status_t iree_vm_stack_function_enter(
         stack->state_resolver.self, function->module, &module_state));
   }
 
-  // Bump pointer and get real stack pointer offsets.
+  // Bump-allocate the frame from the current segment.
   iree_vm_stack_frame_header_t* frame_header =
-      (iree_vm_stack_frame_header_t*)((uintptr_t)stack->frame_storage +
-                                      stack->frame_storage_size);
-  memset(frame_header, 0, header_size + frame_size);
+      (iree_vm_stack_frame_header_t*)(iree_vm_stack_segment_storage(segment) +
+                                      segment->size);
+  memset(frame_header, 0, total_size);
 
-  frame_header->frame_size = header_size + frame_size;
+  frame_header->frame_size = total_size;
   frame_header->parent = stack->top;
   frame_header->data_size = frame_size;
   frame_header->frame_cleanup_fn = frame_cleanup_fn;
@@ -582,7 +651,7 @@ IREE_API_EXPORT iree_status_t iree_vm_stack_function_enter(
   callee_frame->pc = 0;
   callee_frame->depth = caller_frame ? caller_frame->depth + 1 : 0;
 
-  stack->frame_storage_size = new_top;
+  segment->size += total_size;
   stack->top = frame_header;
 
   IREE_TRACE({
@@ -616,9 +685,14 @@ iree_vm_stack_function_leave(iree_vm_stack_t* stack) {
     }
   });
 
-  // Restore the frame pointer to the caller.
-  stack->frame_storage_size -= stack->top->frame_size;
+  // Restore the frame pointer to the caller; the top frame always lives in
+  // the newest segment and popping it may leave that segment empty.
+  iree_vm_stack_segment_t* segment = stack->current_segment;
+  segment->size -= stack->top->frame_size;
   stack->top = stack->top->parent;
+  if (segment->size == 0 && segment->parent != NULL) {
+    iree_vm_stack_segment_retire(stack, segment);
+  }
 
   return iree_ok_status();
 }
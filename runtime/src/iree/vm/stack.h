@@ -247,6 +247,18 @@ iree_vm_stack_allocator(const iree_vm_stack_t* stack);
 IREE_API_EXPORT iree_vm_invocation_flags_t
 iree_vm_stack_invocation_flags(const iree_vm_stack_t* stack);
 
+// Requests cooperative cancellation of the invocation running on |stack|.
+// Thread-safe and sticky: may be called from any thread while the stack is
+// live and remains set until the stack is reset or deinitialized.
+// Dispatchers poll the flag at deterministic points (bytecode loop back-edges)
+// and complete the invocation with IREE_STATUS_CANCELLED; straight-line code
+// runs to its next back-edge or return before observing the request.
+IREE_API_EXPORT void iree_vm_stack_cancel(iree_vm_stack_t* stack);
+
+// Returns true if cancellation has been requested on |stack|.
+// Polled by dispatchers; most callers want iree_vm_invoke_cancel instead.
+IREE_API_EXPORT bool iree_vm_stack_is_cancelled(const iree_vm_stack_t* stack);
+
 // Returns the top stack execution frame, ignore wait frames.
 IREE_API_EXPORT iree_vm_stack_frame_t* iree_vm_stack_top(
     iree_vm_stack_t* stack);
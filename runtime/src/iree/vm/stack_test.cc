@@ -120,6 +120,55 @@ TEST(VMStackTest, StackOverflow) {
   iree_vm_stack_deinitialize(stack);
 }
 
+// Tests dynamic growth beyond the inline storage capacity.
+// Growth links in new storage segments without moving existing frames so
+// pointers captured before growth must remain valid afterward.
+TEST(VMStackTest, DynamicGrowth) {
+  iree_vm_state_resolver_t state_resolver = {nullptr, SentinelStateResolver};
+  IREE_VM_INLINE_STACK_INITIALIZE(stack, IREE_VM_INVOCATION_FLAG_NONE,
+                                  state_resolver, iree_allocator_system());
+
+  // Push frames with payloads until we've exceeded the inline storage several
+  // times over, tagging each payload so we can verify it later.
+  iree_vm_function_t function_a = {MODULE_A_SENTINEL,
+                                   IREE_VM_FUNCTION_LINKAGE_INTERNAL, 0};
+  static constexpr int kFrameCount = 32;
+  static constexpr iree_host_size_t kFrameSize = 1 * 1024;
+  iree_vm_stack_frame_t* frames[kFrameCount] = {nullptr};
+  for (int i = 0; i < kFrameCount; ++i) {
+    IREE_ASSERT_OK(iree_vm_stack_function_enter(stack, &function_a,
+                                                IREE_VM_STACK_FRAME_NATIVE,
+                                                kFrameSize, NULL, &frames[i]));
+    memset(iree_vm_stack_frame_storage(frames[i]), i, kFrameSize);
+  }
+
+  // All frames (including those pushed before growth occurred) must still be
+  // linked and hold their original storage contents.
+  for (int i = kFrameCount - 1; i >= 0; --i) {
+    iree_vm_stack_frame_t* frame = iree_vm_stack_current_frame(stack);
+    EXPECT_EQ(frames[i], frame);
+    EXPECT_EQ(i, frame->depth);
+    uint8_t* data = (uint8_t*)iree_vm_stack_frame_storage(frame);
+    EXPECT_EQ(i, data[0]);
+    EXPECT_EQ(i, data[kFrameSize - 1]);
+    IREE_EXPECT_OK(iree_vm_stack_function_leave(stack));
+  }
+  EXPECT_EQ(nullptr, iree_vm_stack_current_frame(stack));
+
+  // Push/pop once more to exercise reuse of retired growth segments.
+  iree_vm_stack_frame_t* frame = nullptr;
+  for (int i = 0; i < kFrameCount; ++i) {
+    IREE_ASSERT_OK(iree_vm_stack_function_enter(stack, &function_a,
+                                                IREE_VM_STACK_FRAME_NATIVE,
+                                                kFrameSize, NULL, &frame));
+  }
+  for (int i = 0; i < kFrameCount; ++i) {
+    IREE_EXPECT_OK(iree_vm_stack_function_leave(stack));
+  }
+
+  iree_vm_stack_deinitialize(stack);
+}
+
 // Tests unbalanced stack popping.
 TEST(VMStackTest, UnbalancedPop) {
   iree_vm_state_resolver_t state_resolver = {nullptr, SentinelStateResolver};
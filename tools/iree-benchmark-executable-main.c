@@ -70,14 +70,29 @@ struct {
     uint32_t ui32;
   } push_constants[IREE_HAL_MAX_PUSH_CONSTANT_COUNT];
 
+  // Sets of push constant values to sweep; each set runs as its own benchmark
+  // using the same loaded executable and bindings. When empty the base
+  // --push_constant values are used for all benchmarks.
+  int32_t push_constant_set_count;
+  struct {
+    int32_t count;
+    union {
+      uint32_t ui32;
+    } values[IREE_HAL_MAX_PUSH_CONSTANT_COUNT];
+  } push_constant_sets[IREE_HAL_MAX_PUSH_CONSTANT_COUNT];
+
   int32_t binding_count;
   iree_string_view_t binding_specs[IREE_HAL_MAX_TOTAL_BINDING_COUNT];
+  // Index of the binding whose buffer this binding aliases or -1 when the
+  // binding has its own storage parsed from its spec.
+  int32_t binding_aliases[IREE_HAL_MAX_TOTAL_BINDING_COUNT];
   char binding_cconv[IREE_HAL_MAX_TOTAL_BINDING_COUNT];
   iree_hal_descriptor_set_layout_binding_t
       binding_layouts[IREE_HAL_MAX_TOTAL_BINDING_COUNT];
 } parsed_params = {
     .executable_constant_count = 0,
     .push_constant_count = 0,
+    .push_constant_set_count = 0,
     .binding_count = 0,
 };
 
@@ -152,6 +167,57 @@ static void print_push_constant(iree_string_view_t flag_name, void* storage,
 IREE_FLAG_CALLBACK(parse_push_constant, print_push_constant, &parsed_params,
                    push_constant, "Appends a uint32_t push constant value.\n");
 
+static iree_status_t parse_push_constant_set(iree_string_view_t flag_name,
+                                             void* storage,
+                                             iree_string_view_t value) {
+  IREE_ASSERT_LE(parsed_params.push_constant_set_count + 1,
+                 IREE_ARRAYSIZE(parsed_params.push_constant_sets),
+                 "too many push constant sets");
+  int32_t set_index = parsed_params.push_constant_set_count++;
+  int32_t count = 0;
+  while (!iree_string_view_is_empty(value)) {
+    IREE_ASSERT_LE(count + 1,
+                   IREE_ARRAYSIZE(parsed_params.push_constant_sets[0].values),
+                   "too many push constants in set");
+    iree_string_view_t value_str;
+    iree_string_view_split(value, ',', &value_str, &value);
+    uint32_t value_ui32 = 0;
+    if (!iree_string_view_atoi_uint32(value_str, &value_ui32)) {
+      return iree_make_status(
+          IREE_STATUS_INVALID_ARGUMENT,
+          "invalid push constant value `%.*s`; expects uint32_t",
+          (int)value_str.size, value_str.data);
+    }
+    parsed_params.push_constant_sets[set_index].values[count++].ui32 =
+        value_ui32;
+  }
+  parsed_params.push_constant_sets[set_index].count = count;
+  return iree_ok_status();
+}
+static void print_push_constant_set(iree_string_view_t flag_name,
+                                    void* storage, FILE* file) {
+  if (parsed_params.push_constant_set_count == 0) {
+    fprintf(file, "# --%.*s=[value,value,...]\n", (int)flag_name.size,
+            flag_name.data);
+    return;
+  }
+  for (int32_t i = 0; i < parsed_params.push_constant_set_count; ++i) {
+    fprintf(file, "--%.*s=", (int)flag_name.size, flag_name.data);
+    for (int32_t j = 0; j < parsed_params.push_constant_sets[i].count; ++j) {
+      fprintf(file, j > 0 ? ",%u" : "%u",
+              parsed_params.push_constant_sets[i].values[j].ui32);
+    }
+    fprintf(file, "\n");
+  }
+}
+IREE_FLAG_CALLBACK(
+    parse_push_constant_set, print_push_constant_set, &parsed_params,
+    push_constant_set,
+    "Appends a comma-separated set of uint32_t push constant values to the\n"
+    "sweep. Each occurrence of the flag runs every --workgroup_count\n"
+    "benchmark once with that set, reusing the loaded executable across the\n"
+    "entire sweep. When omitted the base --push_constant values are used.\n");
+
 static iree_status_t parse_binding(iree_string_view_t flag_name, void* storage,
                                    iree_string_view_t value) {
   IREE_ASSERT_LE(parsed_params.binding_count + 1,
@@ -159,6 +225,21 @@ static iree_status_t parse_binding(iree_string_view_t flag_name, void* storage,
                  "too many bindings");
   int32_t i = parsed_params.binding_count++;
   parsed_params.binding_specs[i] = value;
+  parsed_params.binding_aliases[i] = -1;
+  if (iree_string_view_consume_prefix(&value, IREE_SV("&"))) {
+    // Alias of an earlier binding's buffer used to benchmark in-place and
+    // gather/scatter-style aliasing configurations.
+    uint32_t alias_index = 0;
+    if (!iree_string_view_atoi_uint32(value, &alias_index) ||
+        alias_index >= (uint32_t)i) {
+      return iree_make_status(
+          IREE_STATUS_INVALID_ARGUMENT,
+          "invalid binding alias `%.*s`; expects the ordinal of an earlier "
+          "binding (&0, &1, ...)",
+          (int)value.size, value.data);
+    }
+    parsed_params.binding_aliases[i] = (int32_t)alias_index;
+  }
   parsed_params.binding_cconv[i] = 'r';
   // TODO(benvanik): allow for a specification of type/immutability.
   parsed_params.binding_layouts[i] = (iree_hal_descriptor_set_layout_binding_t){
@@ -200,13 +281,19 @@ IREE_FLAG_CALLBACK(
     "  --binding=*file.npy\n"
     "  # Binary tensor<2x2xf32> and tensor<4xf32> read from a single file\n"
     "  --binding=2x2xf32=@file.ext\n"
-    "  --binding=4xf32=+file.ext");
+    "  --binding=4xf32=+file.ext\n"
+    "  # Alias of binding 0's buffer (in-place/aliased configurations):\n"
+    "  --binding=&0");
 
 typedef struct iree_benchmark_executable_args_t {
   iree_hal_device_t* device;
   iree_hal_executable_t* executable;
   iree_hal_pipeline_layout_t* pipeline_layout;
   const iree_hal_descriptor_set_binding_t* bindings;
+  // Total bytes across all bindings used to derive achieved bandwidth.
+  iree_device_size_t total_binding_bytes;
+  const uint32_t* push_constants;
+  int32_t push_constant_count;
   uint32_t workgroup_count[3];
 } iree_benchmark_executable_args_t;
 
@@ -267,9 +354,8 @@ static iree_status_t iree_benchmark_executable_run(
     IREE_RETURN_IF_ERROR(iree_hal_command_buffer_begin(command_buffer));
     IREE_RETURN_IF_ERROR(iree_hal_command_buffer_push_constants(
         command_buffer, args->pipeline_layout, /*offset=*/0,
-        &parsed_params.push_constants[0].ui32,
-        parsed_params.push_constant_count *
-            sizeof(parsed_params.push_constants[0])));
+        args->push_constants,
+        args->push_constant_count * sizeof(args->push_constants[0])));
     IREE_RETURN_IF_ERROR(iree_hal_command_buffer_push_descriptor_set(
         command_buffer, args->pipeline_layout, /*set=*/0,
         parsed_params.binding_count, args->bindings));
@@ -324,6 +410,13 @@ static iree_status_t iree_benchmark_executable_run(
                               args->workgroup_count[2];
   iree_benchmark_set_items_processed(benchmark_state, total_invocations);
 
+  // Derive achieved bandwidth from the declared binding sizes; this assumes
+  // each dispatch touches each binding once which holds for streaming kernels
+  // and gives an upper bound for others. Reported as bytes_per_second in the
+  // console/CSV/JSON output.
+  iree_benchmark_set_bytes_processed(
+      benchmark_state, dispatch_count * (int64_t)args->total_binding_bytes);
+
   iree_hal_semaphore_release(fence_semaphore);
 
   return iree_ok_status();
@@ -381,29 +474,48 @@ static iree_status_t iree_benchmark_executable_from_flags(
   // Note that we do this parsing first so that we can reflect on the I/O to
   // infer the pipeline layout.
   iree_hal_allocator_t* device_allocator = iree_hal_device_allocator(device);
+
+  // Split binding specs into those carrying their own storage and aliases of
+  // earlier bindings; only the former are parsed into buffers.
+  iree_string_view_t storage_specs[IREE_HAL_MAX_TOTAL_BINDING_COUNT];
+  char storage_cconv[IREE_HAL_MAX_TOTAL_BINDING_COUNT];
+  iree_host_size_t storage_spec_count = 0;
+  for (int32_t i = 0; i < parsed_params.binding_count; ++i) {
+    if (parsed_params.binding_aliases[i] != -1) continue;
+    storage_cconv[storage_spec_count] = parsed_params.binding_cconv[i];
+    storage_specs[storage_spec_count++] = parsed_params.binding_specs[i];
+  }
+
   iree_vm_list_t* binding_list = NULL;
   IREE_RETURN_IF_ERROR(iree_tooling_parse_variants(
-      iree_make_string_view(parsed_params.binding_cconv,
-                            parsed_params.binding_count),
-      (iree_string_view_list_t){parsed_params.binding_count,
-                                parsed_params.binding_specs},
-      device, device_allocator, host_allocator, &binding_list));
+      iree_make_string_view(storage_cconv, storage_spec_count),
+      (iree_string_view_list_t){storage_spec_count, storage_specs}, device,
+      device_allocator, host_allocator, &binding_list));
   iree_hal_descriptor_set_binding_t bindings[IREE_HAL_MAX_TOTAL_BINDING_COUNT];
+  iree_device_size_t total_binding_bytes = 0;
+  iree_host_size_t storage_spec_index = 0;
   for (iree_host_size_t i = 0; i < parsed_params.binding_count; ++i) {
-    iree_vm_ref_t value = iree_vm_ref_null();
-    IREE_RETURN_IF_ERROR(iree_vm_list_get_ref_assign(binding_list, i, &value));
     iree_hal_buffer_t* buffer = NULL;
-    if (iree_hal_buffer_isa(value)) {
-      buffer = iree_hal_buffer_deref(value);
-    } else if (iree_hal_buffer_view_isa(value)) {
-      buffer = iree_hal_buffer_view_buffer(iree_hal_buffer_view_deref(value));
+    if (parsed_params.binding_aliases[i] != -1) {
+      buffer = bindings[parsed_params.binding_aliases[i]].buffer;
     } else {
-      return iree_make_status(
-          IREE_STATUS_INVALID_ARGUMENT,
-          "bindings must be shaped types (4xf32, etc), binding %" PRIhsz
-          " is not",
-          i);
+      iree_vm_ref_t value = iree_vm_ref_null();
+      IREE_RETURN_IF_ERROR(
+          iree_vm_list_get_ref_assign(binding_list, storage_spec_index++,
+                                      &value));
+      if (iree_hal_buffer_isa(value)) {
+        buffer = iree_hal_buffer_deref(value);
+      } else if (iree_hal_buffer_view_isa(value)) {
+        buffer = iree_hal_buffer_view_buffer(iree_hal_buffer_view_deref(value));
+      } else {
+        return iree_make_status(
+            IREE_STATUS_INVALID_ARGUMENT,
+            "bindings must be shaped types (4xf32, etc), binding %" PRIhsz
+            " is not",
+            i);
+      }
     }
+    total_binding_bytes += iree_hal_buffer_byte_length(buffer);
     bindings[i] = (iree_hal_descriptor_set_binding_t){
         .binding = i,
         .buffer_slot = 0,
@@ -463,36 +575,65 @@ static iree_status_t iree_benchmark_executable_from_flags(
   IREE_RETURN_IF_ERROR(iree_hal_executable_cache_prepare_executable(
       executable_cache, &executable_params, &executable));
 
-  // Register one benchmark per workgroup count specified.
+  // Register one benchmark per workgroup count x push constant set combination
+  // so that an entire tuning sweep shares the loaded executable and buffers.
+  const iree_host_size_t push_constant_set_count =
+      parsed_params.push_constant_set_count > 0
+          ? parsed_params.push_constant_set_count
+          : 1;
+  const iree_host_size_t benchmark_count =
+      FLAG_workgroup_count_list().count * push_constant_set_count;
   iree_benchmark_executable_args_t* args = NULL;
   IREE_RETURN_IF_ERROR(iree_allocator_malloc(
-      host_allocator, sizeof(*args) * FLAG_workgroup_count_list().count,
-      (void**)&args));
+      host_allocator, sizeof(*args) * benchmark_count, (void**)&args));
   for (iree_host_size_t i = 0; i < FLAG_workgroup_count_list().count; ++i) {
-    args[i] = (iree_benchmark_executable_args_t){
-        .device = device,
-        .executable = executable,
-        .pipeline_layout = pipeline_layout,
-        .bindings = bindings,
-        .workgroup_count = {1, 1, 1},
-    };
-    IREE_RETURN_IF_ERROR(iree_parse_workgroup_count(
-        FLAG_workgroup_count_list().values[i], args[i].workgroup_count));
-    iree_benchmark_def_t benchmark_def = {
-        .flags = IREE_BENCHMARK_FLAG_MEASURE_PROCESS_CPU_TIME |
-                 IREE_BENCHMARK_FLAG_USE_REAL_TIME,
-        .time_unit = IREE_BENCHMARK_UNIT_NANOSECOND,
-        .minimum_duration_ns = 0,
-        .iteration_count = 0,
-        .run = iree_benchmark_executable_run,
-        .user_data = &args[i],
-    };
-    char benchmark_name[512];
-    snprintf(benchmark_name, sizeof(benchmark_name) - 1, "dispatch_%ux%ux%u",
-             args[i].workgroup_count[0], args[i].workgroup_count[1],
-             args[i].workgroup_count[2]);
-    iree_benchmark_register(iree_make_cstring_view(benchmark_name),
-                            &benchmark_def);
+    for (iree_host_size_t j = 0; j < push_constant_set_count; ++j) {
+      iree_benchmark_executable_args_t* benchmark_args =
+          &args[i * push_constant_set_count + j];
+      *benchmark_args = (iree_benchmark_executable_args_t){
+          .device = device,
+          .executable = executable,
+          .pipeline_layout = pipeline_layout,
+          .bindings = bindings,
+          .total_binding_bytes = total_binding_bytes,
+          .push_constants = &parsed_params.push_constants[0].ui32,
+          .push_constant_count = parsed_params.push_constant_count,
+          .workgroup_count = {1, 1, 1},
+      };
+      if (parsed_params.push_constant_set_count > 0) {
+        benchmark_args->push_constants =
+            &parsed_params.push_constant_sets[j].values[0].ui32;
+        benchmark_args->push_constant_count =
+            parsed_params.push_constant_sets[j].count;
+      }
+      IREE_RETURN_IF_ERROR(iree_parse_workgroup_count(
+          FLAG_workgroup_count_list().values[i],
+          benchmark_args->workgroup_count));
+      iree_benchmark_def_t benchmark_def = {
+          .flags = IREE_BENCHMARK_FLAG_MEASURE_PROCESS_CPU_TIME |
+                   IREE_BENCHMARK_FLAG_USE_REAL_TIME,
+          .time_unit = IREE_BENCHMARK_UNIT_NANOSECOND,
+          .minimum_duration_ns = 0,
+          .iteration_count = 0,
+          .run = iree_benchmark_executable_run,
+          .user_data = benchmark_args,
+      };
+      char benchmark_name[512];
+      if (parsed_params.push_constant_set_count > 0) {
+        snprintf(benchmark_name, sizeof(benchmark_name) - 1,
+                 "dispatch_%ux%ux%u_pc%" PRIhsz,
+                 benchmark_args->workgroup_count[0],
+                 benchmark_args->workgroup_count[1],
+                 benchmark_args->workgroup_count[2], j);
+      } else {
+        snprintf(benchmark_name, sizeof(benchmark_name) - 1,
+                 "dispatch_%ux%ux%u", benchmark_args->workgroup_count[0],
+                 benchmark_args->workgroup_count[1],
+                 benchmark_args->workgroup_count[2]);
+      }
+      iree_benchmark_register(iree_make_cstring_view(benchmark_name),
+                              &benchmark_def);
+    }
   }
   iree_benchmark_run_specified();
   iree_allocator_free(host_allocator, args);
@@ -551,6 +692,13 @@ int main(int argc, char** argv) {
       "executables (bypassing all of the IREE VM, HAL APIs, task system,\n"
       "etc).\n"
       "\n"
+      "A tuning sweep can be expressed in a single invocation by repeating\n"
+      "--workgroup_count and --push_constant_set flags; every combination\n"
+      "runs against the same loaded executable and buffers. Pass\n"
+      "--benchmark_format=csv (or json) for machine-readable reports and\n"
+      "--benchmark_repetitions=N for aggregate statistics per\n"
+      "configuration.\n"
+      "\n"
       "Example --flagfile:\n"
       "  --device=local-sync\n"
       "  --executable_format=embedded-elf-x86_64\n"
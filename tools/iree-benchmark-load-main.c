@@ -0,0 +1,474 @@
+// Copyright 2024 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Benchmarks the module load-to-first-inference pipeline.
+//
+// Where iree-benchmark-module measures steady-state invocation latency this
+// tool measures how long it takes to get there: reading the module file off
+// disk, verifying and loading the bytecode module, creating the VM context
+// (which runs module initializers, prepares the device executable cache, and
+// enrolls any --parameters= files), and performing the first invocation.
+// Each phase is measured in isolation and the full pipeline is measured
+// end-to-end against cold, warm, and hot starting states:
+//   cold: the module file is evicted from the OS page cache before each run
+//   warm: the module file remains in the page cache but all runtime state
+//         (module, context, device executables) is recreated per run
+//   hot:  the module is loaded once and only repeat invocations are timed
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "iree/base/api.h"
+#include "iree/base/internal/file_io.h"
+#include "iree/base/internal/flags.h"
+#include "iree/hal/api.h"
+#include "iree/modules/hal/types.h"
+#include "iree/testing/benchmark.h"
+#include "iree/tooling/context_util.h"
+#include "iree/tooling/device_util.h"
+#include "iree/tooling/function_io.h"
+#include "iree/tooling/function_util.h"
+#include "iree/vm/api.h"
+#include "iree/vm/bytecode/module.h"
+
+#if defined(IREE_PLATFORM_ANDROID) || defined(IREE_PLATFORM_LINUX)
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif  // IREE_PLATFORM_ANDROID || IREE_PLATFORM_LINUX
+
+// NOTE: we deliberately do not reuse the --module= flag from context_util:
+// this tool needs to own the file read so that it can control the page cache
+// state and time the read as its own phase.
+IREE_FLAG(string, module_file, "",
+          "Path to the bytecode module file (.vmfb) to load.");
+
+IREE_FLAG(string, function, "",
+          "Name of a function contained in the module specified by "
+          "--module_file= to invoke. If omitted the single exported function "
+          "is used.");
+
+IREE_FLAG_LIST(
+    string, input,
+    "An input (a) value or (b) buffer of the format:\n"
+    "  (a) scalar value\n"
+    "     value\n"
+    "     e.g.: --input=\"3.14\"\n"
+    "  (b) buffer:\n"
+    "     [shape]xtype=[value]\n"
+    "     e.g.: --input=\"2x2xi32=1 2 3 4\"\n"
+    "Optionally, brackets may be used to separate the element values:\n"
+    "  2x2xi32=[[1 2][3 4]]\n"
+    "Each occurrence of the flag indicates an input in the order they were\n"
+    "specified.\n"
+    "Raw binary files can be read to provide buffer contents:\n"
+    "  2x2xi32=@some/file.bin");
+
+//===----------------------------------------------------------------------===//
+// Page cache control
+//===----------------------------------------------------------------------===//
+
+// Asks the OS to evict |path| from the page cache so that the next read hits
+// the underlying storage. Best-effort: returns UNAVAILABLE on platforms where
+// we have no way to do this and the cold-start benchmarks will be skipped.
+static iree_status_t iree_benchmark_load_evict_file(const char* path) {
+#if defined(IREE_PLATFORM_ANDROID) || defined(IREE_PLATFORM_LINUX)
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return iree_make_status(iree_status_code_from_errno(errno),
+                            "failed to open '%s' for page cache eviction",
+                            path);
+  }
+  int ret = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+  close(fd);
+  if (ret != 0) {
+    return iree_make_status(iree_status_code_from_errno(ret),
+                            "posix_fadvise failed for '%s'", path);
+  }
+  return iree_ok_status();
+#else
+  return iree_make_status(
+      IREE_STATUS_UNAVAILABLE,
+      "page cache eviction is not supported on this platform");
+#endif  // IREE_PLATFORM_ANDROID || IREE_PLATFORM_LINUX
+}
+
+//===----------------------------------------------------------------------===//
+// Load pipeline
+//===----------------------------------------------------------------------===//
+
+// Phases of the load pipeline that can be independently timed.
+enum iree_benchmark_load_phase_bits_t {
+  IREE_BENCHMARK_LOAD_PHASE_FILE_READ = 1u << 0,
+  IREE_BENCHMARK_LOAD_PHASE_MODULE_CREATE = 1u << 1,
+  IREE_BENCHMARK_LOAD_PHASE_CONTEXT_CREATE = 1u << 2,
+  IREE_BENCHMARK_LOAD_PHASE_FIRST_INVOCATION = 1u << 3,
+  IREE_BENCHMARK_LOAD_PHASE_ALL = IREE_BENCHMARK_LOAD_PHASE_FILE_READ |
+                                  IREE_BENCHMARK_LOAD_PHASE_MODULE_CREATE |
+                                  IREE_BENCHMARK_LOAD_PHASE_CONTEXT_CREATE |
+                                  IREE_BENCHMARK_LOAD_PHASE_FIRST_INVOCATION,
+};
+typedef uint32_t iree_benchmark_load_phases_t;
+
+typedef struct iree_benchmark_load_args_t {
+  iree_allocator_t host_allocator;
+  // Which phases contribute to the reported time; all others run with the
+  // benchmark timer paused.
+  iree_benchmark_load_phases_t timed_phases;
+  // Evicts the module file from the page cache before each run.
+  bool evict_file;
+} iree_benchmark_load_args_t;
+
+// Pauses or resumes the benchmark timer to match |timed|, tracking the
+// current state in |current_timed| so redundant transitions (which have
+// non-trivial overhead) are elided.
+static void iree_benchmark_load_set_timing(iree_benchmark_state_t* state,
+                                           bool* current_timed, bool timed) {
+  if (*current_timed == timed) return;
+  if (timed) {
+    iree_benchmark_resume_timing(state);
+  } else {
+    iree_benchmark_pause_timing(state);
+  }
+  *current_timed = timed;
+}
+
+// Resolves the function to invoke from --function= (or the single export).
+static iree_status_t iree_benchmark_load_resolve_function(
+    iree_vm_module_t* module, iree_vm_function_t* out_function) {
+  if (strlen(FLAG_function) == 0) {
+    return iree_tooling_find_single_exported_function(module, out_function);
+  }
+  return iree_status_annotate_f(
+      iree_vm_module_lookup_function_by_name(
+          module, IREE_VM_FUNCTION_LINKAGE_EXPORT,
+          iree_make_cstring_view(FLAG_function), out_function),
+      "looking up function '%s'", FLAG_function);
+}
+
+// Parses --input= values and invokes |function| once, blocking until any
+// asynchronously-signaled fence completes so device execution is included.
+static iree_status_t iree_benchmark_load_invoke_once(
+    iree_vm_context_t* context, iree_vm_function_t function,
+    iree_hal_device_t* device, iree_hal_allocator_t* device_allocator,
+    iree_allocator_t host_allocator) {
+  iree_vm_function_signature_t signature =
+      iree_vm_function_signature(&function);
+  iree_string_view_t arguments_cconv, results_cconv;
+  IREE_RETURN_IF_ERROR(iree_vm_function_call_get_cconv_fragments(
+      &signature, &arguments_cconv, &results_cconv));
+
+  iree_vm_list_t* inputs = NULL;
+  IREE_RETURN_IF_ERROR(
+      iree_tooling_parse_variants(arguments_cconv, FLAG_input_list(), device,
+                                  device_allocator, host_allocator, &inputs),
+      "parsing function inputs");
+
+  // If the function is async add fences so we can invoke it synchronously.
+  iree_hal_fence_t* finish_fence = NULL;
+  iree_status_t status = iree_tooling_append_async_fences(
+      inputs, function, device, /*wait_fence=*/NULL, &finish_fence);
+
+  iree_vm_list_t* outputs = NULL;
+  if (iree_status_is_ok(status)) {
+    status = iree_vm_list_create(iree_vm_make_undefined_type_def(), 16,
+                                 host_allocator, &outputs);
+  }
+
+  if (iree_status_is_ok(status)) {
+    status = iree_vm_invoke(context, function, IREE_VM_INVOCATION_FLAG_NONE,
+                            /*policy=*/NULL, inputs, outputs, host_allocator);
+  }
+  if (iree_status_is_ok(status) && finish_fence) {
+    status = iree_hal_fence_wait(finish_fence, iree_infinite_timeout());
+  }
+
+  iree_hal_fence_release(finish_fence);
+  iree_vm_list_release(outputs);
+  iree_vm_list_release(inputs);
+  return status;
+}
+
+// Runs the full load pipeline once with the benchmark timer enabled only for
+// the phases selected in |args->timed_phases|.
+static iree_status_t iree_benchmark_load_pipeline_step(
+    const iree_benchmark_load_args_t* args, iree_benchmark_state_t* state,
+    bool* timing) {
+  iree_allocator_t host_allocator = args->host_allocator;
+
+  // Instance setup is process bring-up rather than model load and is never
+  // counted.
+  iree_benchmark_load_set_timing(state, timing, false);
+  if (args->evict_file) {
+    IREE_RETURN_IF_ERROR(iree_benchmark_load_evict_file(FLAG_module_file));
+  }
+  iree_vm_instance_t* instance = NULL;
+  IREE_RETURN_IF_ERROR(iree_tooling_create_instance(host_allocator, &instance));
+
+  // Phase 1: read the module file into memory.
+  iree_benchmark_load_set_timing(
+      state, timing,
+      iree_all_bits_set(args->timed_phases,
+                        IREE_BENCHMARK_LOAD_PHASE_FILE_READ));
+  iree_file_contents_t* file_contents = NULL;
+  iree_status_t status =
+      iree_file_read_contents(FLAG_module_file, IREE_FILE_READ_FLAG_PRELOAD,
+                              host_allocator, &file_contents);
+
+  // Phase 2: verify and load the bytecode module.
+  iree_vm_module_t* module = NULL;
+  if (iree_status_is_ok(status)) {
+    iree_benchmark_load_set_timing(
+        state, timing,
+        iree_all_bits_set(args->timed_phases,
+                          IREE_BENCHMARK_LOAD_PHASE_MODULE_CREATE));
+    status = iree_vm_bytecode_module_create(instance,
+                                            file_contents->const_buffer,
+                                            iree_allocator_null(),
+                                            host_allocator, &module);
+  }
+
+  // Phase 3: create the context; this runs module initializers, prepares the
+  // device executable cache, and enrolls any --parameters= files.
+  iree_vm_context_t* context = NULL;
+  iree_hal_device_t* device = NULL;
+  iree_hal_allocator_t* device_allocator = NULL;
+  if (iree_status_is_ok(status)) {
+    iree_benchmark_load_set_timing(
+        state, timing,
+        iree_all_bits_set(args->timed_phases,
+                          IREE_BENCHMARK_LOAD_PHASE_CONTEXT_CREATE));
+    status = iree_tooling_create_context_from_flags(
+        instance, /*user_module_count=*/1, &module,
+        iree_hal_default_device_uri(), host_allocator, &context, &device,
+        &device_allocator);
+  }
+
+  // Phase 4: first invocation, including --input= parsing and upload.
+  if (iree_status_is_ok(status)) {
+    iree_benchmark_load_set_timing(
+        state, timing,
+        iree_all_bits_set(args->timed_phases,
+                          IREE_BENCHMARK_LOAD_PHASE_FIRST_INVOCATION));
+    iree_vm_function_t function = {0};
+    status = iree_benchmark_load_resolve_function(module, &function);
+    if (iree_status_is_ok(status)) {
+      status = iree_benchmark_load_invoke_once(
+          context, function, device, device_allocator, host_allocator);
+    }
+  }
+
+  // Teardown is never counted.
+  iree_benchmark_load_set_timing(state, timing, false);
+  iree_hal_allocator_release(device_allocator);
+  iree_hal_device_release(device);
+  iree_vm_context_release(context);
+  iree_vm_module_release(module);
+  iree_file_contents_free(file_contents);
+  iree_vm_instance_release(instance);
+  return status;
+}
+
+static iree_status_t iree_benchmark_load_pipeline_run(
+    const iree_benchmark_def_t* benchmark_def,
+    iree_benchmark_state_t* benchmark_state) {
+  const iree_benchmark_load_args_t* args =
+      (const iree_benchmark_load_args_t*)benchmark_def->user_data;
+
+  // Probe page cache eviction support up front so unsupported platforms skip
+  // instead of failing mid-run.
+  if (args->evict_file) {
+    iree_status_t evict_status =
+        iree_benchmark_load_evict_file(FLAG_module_file);
+    if (iree_status_is_unavailable(evict_status)) {
+      iree_status_ignore(evict_status);
+      iree_benchmark_skip(benchmark_state,
+                          "page cache eviction unavailable on this platform");
+      return iree_ok_status();
+    }
+    IREE_RETURN_IF_ERROR(evict_status);
+  }
+
+  while (iree_benchmark_keep_running(benchmark_state, /*batch_count=*/1)) {
+    bool timing = true;
+    iree_status_t status = iree_benchmark_load_pipeline_step(
+        args, benchmark_state, &timing);
+    iree_benchmark_load_set_timing(benchmark_state, &timing, true);
+    IREE_RETURN_IF_ERROR(status);
+  }
+  return iree_ok_status();
+}
+
+// Hot start: the module is loaded and the context created once outside the
+// step loop; only repeat invocations are timed. This is the steady-state
+// floor the cold/warm numbers should be compared against.
+static iree_status_t iree_benchmark_load_hot_run(
+    const iree_benchmark_def_t* benchmark_def,
+    iree_benchmark_state_t* benchmark_state) {
+  const iree_benchmark_load_args_t* args =
+      (const iree_benchmark_load_args_t*)benchmark_def->user_data;
+  iree_allocator_t host_allocator = args->host_allocator;
+
+  iree_vm_instance_t* instance = NULL;
+  IREE_RETURN_IF_ERROR(iree_tooling_create_instance(host_allocator, &instance));
+  iree_file_contents_t* file_contents = NULL;
+  IREE_RETURN_IF_ERROR(
+      iree_file_read_contents(FLAG_module_file, IREE_FILE_READ_FLAG_PRELOAD,
+                              host_allocator, &file_contents));
+  iree_vm_module_t* module = NULL;
+  IREE_RETURN_IF_ERROR(iree_vm_bytecode_module_create(
+      instance, file_contents->const_buffer, iree_allocator_null(),
+      host_allocator, &module));
+  iree_vm_context_t* context = NULL;
+  iree_hal_device_t* device = NULL;
+  iree_hal_allocator_t* device_allocator = NULL;
+  IREE_RETURN_IF_ERROR(iree_tooling_create_context_from_flags(
+      instance, /*user_module_count=*/1, &module,
+      iree_hal_default_device_uri(), host_allocator, &context, &device,
+      &device_allocator));
+  iree_vm_function_t function = {0};
+  IREE_RETURN_IF_ERROR(
+      iree_benchmark_load_resolve_function(module, &function));
+
+  // Warm the device executable cache with one untimed invocation so the step
+  // loop measures repeat-call latency only.
+  IREE_RETURN_IF_ERROR(iree_benchmark_load_invoke_once(
+      context, function, device, device_allocator, host_allocator));
+
+  iree_status_t status = iree_ok_status();
+  while (iree_status_is_ok(status) &&
+         iree_benchmark_keep_running(benchmark_state, /*batch_count=*/1)) {
+    status = iree_benchmark_load_invoke_once(context, function, device,
+                                             device_allocator, host_allocator);
+  }
+
+  iree_hal_allocator_release(device_allocator);
+  iree_hal_device_release(device);
+  iree_vm_context_release(context);
+  iree_vm_module_release(module);
+  iree_file_contents_free(file_contents);
+  iree_vm_instance_release(instance);
+  return status;
+}
+
+//===----------------------------------------------------------------------===//
+// Benchmark registration
+//===----------------------------------------------------------------------===//
+
+typedef struct iree_benchmark_load_case_t {
+  const char* name;
+  iree_benchmark_fn_t run;
+  iree_benchmark_load_phases_t timed_phases;
+  bool evict_file;
+} iree_benchmark_load_case_t;
+
+static const iree_benchmark_load_case_t iree_benchmark_load_cases[] = {
+    // Individual phases, all against a warm page cache.
+    {"file_read_cold", iree_benchmark_load_pipeline_run,
+     IREE_BENCHMARK_LOAD_PHASE_FILE_READ, /*evict_file=*/true},
+    {"file_read_warm", iree_benchmark_load_pipeline_run,
+     IREE_BENCHMARK_LOAD_PHASE_FILE_READ, /*evict_file=*/false},
+    {"module_create", iree_benchmark_load_pipeline_run,
+     IREE_BENCHMARK_LOAD_PHASE_MODULE_CREATE, /*evict_file=*/false},
+    {"context_create", iree_benchmark_load_pipeline_run,
+     IREE_BENCHMARK_LOAD_PHASE_CONTEXT_CREATE, /*evict_file=*/false},
+    {"first_invocation", iree_benchmark_load_pipeline_run,
+     IREE_BENCHMARK_LOAD_PHASE_FIRST_INVOCATION, /*evict_file=*/false},
+    // End-to-end time-to-first-inference.
+    {"load_cold", iree_benchmark_load_pipeline_run,
+     IREE_BENCHMARK_LOAD_PHASE_ALL, /*evict_file=*/true},
+    {"load_warm", iree_benchmark_load_pipeline_run,
+     IREE_BENCHMARK_LOAD_PHASE_ALL, /*evict_file=*/false},
+    {"load_hot", iree_benchmark_load_hot_run,
+     /*timed_phases=*/0, /*evict_file=*/false},
+};
+
+static iree_status_t iree_benchmark_load_from_flags(
+    iree_allocator_t host_allocator) {
+  if (strlen(FLAG_module_file) == 0) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "no module specified; use --module_file=file.vmfb");
+  }
+
+  static iree_benchmark_load_args_t
+      args[IREE_ARRAYSIZE(iree_benchmark_load_cases)];
+  for (iree_host_size_t i = 0; i < IREE_ARRAYSIZE(iree_benchmark_load_cases);
+       ++i) {
+    const iree_benchmark_load_case_t* benchmark_case =
+        &iree_benchmark_load_cases[i];
+    args[i] = (iree_benchmark_load_args_t){
+        .host_allocator = host_allocator,
+        .timed_phases = benchmark_case->timed_phases,
+        .evict_file = benchmark_case->evict_file,
+    };
+    iree_benchmark_def_t benchmark_def = {
+        .flags = IREE_BENCHMARK_FLAG_MEASURE_PROCESS_CPU_TIME |
+                 IREE_BENCHMARK_FLAG_USE_REAL_TIME,
+        .time_unit = IREE_BENCHMARK_UNIT_MILLISECOND,
+        .minimum_duration_ns = 0,
+        .iteration_count = 0,
+        .run = benchmark_case->run,
+        .user_data = &args[i],
+    };
+    iree_benchmark_register(iree_make_cstring_view(benchmark_case->name),
+                            &benchmark_def);
+  }
+  iree_benchmark_run_specified();
+  return iree_ok_status();
+}
+
+int main(int argc, char** argv) {
+  IREE_TRACE_APP_ENTER();
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_allocator_t host_allocator = iree_allocator_system();
+  int exit_code = EXIT_SUCCESS;
+
+  iree_flags_set_usage(
+      "iree-benchmark-load",
+      "Benchmarks the load-to-first-inference pipeline of a compiled module\n"
+      "against cold, warm, and hot starting states.\n"
+      "\n"
+      "Phases measured in isolation:\n"
+      "  file_read_cold/file_read_warm: module file read with the OS page\n"
+      "      cache evicted/populated\n"
+      "  module_create: bytecode module verification and load\n"
+      "  context_create: VM context creation including module initializers,\n"
+      "      device executable cache preparation, and --parameters= loading\n"
+      "  first_invocation: input parsing, upload, and first call\n"
+      "End-to-end:\n"
+      "  load_cold: full pipeline with the page cache evicted\n"
+      "  load_warm: full pipeline with the page cache populated\n"
+      "  load_hot: repeat invocations with all state resident (steady state)\n"
+      "\n"
+      "Page cache eviction requires posix_fadvise and the cold benchmarks\n"
+      "are skipped on platforms without it.\n"
+      "\n"
+      "Example:\n"
+      "  iree-benchmark-load \\\n"
+      "    --device=local-task \\\n"
+      "    --module_file=module.vmfb \\\n"
+      "    --function=predict \\\n"
+      "    --input=1x224x224x3xf32=0\n"
+      "\n");
+
+  iree_flags_parse_checked(IREE_FLAGS_PARSE_MODE_UNDEFINED_OK, &argc, &argv);
+  iree_benchmark_initialize(&argc, argv);
+
+  iree_status_t status = iree_benchmark_load_from_flags(host_allocator);
+  if (!iree_status_is_ok(status)) {
+    iree_status_fprint(stderr, status);
+    iree_status_free(status);
+    exit_code = EXIT_FAILURE;
+  }
+  fflush(stderr);
+
+  IREE_TRACE_ZONE_END(z0);
+  IREE_TRACE_APP_EXIT(exit_code);
+  return exit_code;
+}
@@ -52,6 +52,7 @@
 // an appropriate device-specific tool before trusting the more generic and
 // higher-level numbers from this tool.
 
+#include <algorithm>
 #include <array>
 #include <cstdio>
 #include <iterator>
@@ -62,6 +63,7 @@
 
 #include "benchmark/benchmark.h"
 #include "iree/base/api.h"
+#include "iree/base/internal/file_io.h"
 #include "iree/base/internal/flags.h"
 #include "iree/hal/api.h"
 #include "iree/modules/hal/types.h"
@@ -105,6 +107,23 @@ IREE_FLAG_LIST(
     "Each occurrence of the flag indicates an input in the order they were\n"
     "specified on the command line.");
 
+IREE_FLAG(
+    string, trace_file, "",
+    "Replays a recorded invocation trace instead of benchmarking a single\n"
+    "function. The trace is a text file with one directive per line:\n"
+    "  # comment\n"
+    "  call <function_name> [delay_ns=<n>]\n"
+    "  input <value or buffer, same syntax as --input=>\n"
+    "Each `call` invokes the named exported function with the `input` lines\n"
+    "that follow it; `delay_ns` is the recorded gap since the previous call\n"
+    "in the live session (see --trace_pacing=). One benchmark iteration\n"
+    "replays the full trace in order and per-call latency percentiles are\n"
+    "reported as counters alongside the aggregate timings.");
+
+IREE_FLAG(bool, trace_pacing, false,
+          "Honors the recorded delay_ns gaps between trace calls (waiting\n"
+          "with timing paused) instead of replaying as fast as possible.");
+
 static iree_status_t parse_time_unit(iree_string_view_t flag_name,
                                      void* storage, iree_string_view_t value) {
   auto* unit = (std::pair<bool, benchmark::TimeUnit>*)storage;
@@ -370,6 +389,127 @@ void RegisterAsyncBenchmark(const std::string& function_name,
                                   : benchmark::kMillisecond);
 }
 
+// A single recorded invocation from a replay trace.
+struct ReplayCall {
+  iree_vm_function_t function;
+  // True if the function uses the coarse-fences ABI and takes a fence pair.
+  bool async = false;
+  // Recorded delay since the prior call in the live session; honored when
+  // --trace_pacing= is set.
+  int64_t delay_ns = 0;
+  vm::ref<iree_vm_list_t> inputs;
+};
+
+// Replays the full trace once per batch iteration, timing each call
+// individually so that tail latency is visible in addition to the aggregate
+// rates - a decode loop that is fast on average but stalls every N calls
+// looks fine in mean-only reporting.
+static void BenchmarkTraceReplay(const std::string& benchmark_name,
+                                 bool pacing, iree_hal_device_t* device,
+                                 iree_vm_context_t* context,
+                                 const std::vector<ReplayCall>* calls,
+                                 benchmark::State& state) {
+  IREE_TRACE_ZONE_BEGIN_NAMED_DYNAMIC(z0, benchmark_name.data(),
+                                      benchmark_name.size());
+  IREE_TRACE_FRAME_MARK();
+  iree_allocator_t host_allocator = iree_allocator_system();
+
+  vm::ref<iree_vm_list_t> outputs;
+  IREE_CHECK_OK(iree_vm_list_create(iree_vm_make_undefined_type_def(), 16,
+                                    host_allocator, &outputs));
+
+  std::vector<double> call_latencies_ns;
+  while (state.KeepRunningBatch((int64_t)calls->size())) {
+    IREE_TRACE_ZONE_BEGIN_NAMED(z1, "ReplayIteration");
+    IREE_TRACE_FRAME_MARK_NAMED("Iteration");
+    for (const auto& call : *calls) {
+      if (pacing && call.delay_ns > 0) {
+        // Recorded think-time between calls; excluded from measurement.
+        state.PauseTiming();
+        iree_wait_until(iree_time_now() + call.delay_ns);
+        state.ResumeTiming();
+      }
+      const iree_time_t start_ns = iree_time_now();
+      if (call.async) {
+        // Coarse-fences ABI: pass a (wait, signal) fence pair and block until
+        // the signal fence is reached so device completion is included in the
+        // per-call latency, matching what a live caller observes.
+        vm::ref<iree_hal_semaphore_t> semaphore;
+        IREE_CHECK_OK(iree_hal_semaphore_create(device, 0ull, &semaphore));
+        vm::ref<iree_hal_fence_t> signal_fence;
+        IREE_CHECK_OK(iree_hal_fence_create_at(semaphore.get(), 1ull,
+                                               host_allocator, &signal_fence));
+        vm::ref<iree_hal_fence_t> completion_fence =
+            vm::retain_ref(signal_fence);
+        vm::ref<iree_vm_list_t> inputs;
+        IREE_CHECK_OK(
+            iree_vm_list_clone(call.inputs.get(), host_allocator, &inputs));
+        IREE_CHECK_OK(iree_vm_list_push_ref_move(
+            inputs.get(), vm::ref<iree_hal_fence_t>()));
+        IREE_CHECK_OK(iree_vm_list_push_ref_move(inputs.get(), signal_fence));
+        IREE_CHECK_OK(iree_vm_invoke(
+            context, call.function, IREE_VM_INVOCATION_FLAG_NONE,
+            /*policy=*/nullptr, inputs.get(), outputs.get(), host_allocator));
+        IREE_CHECK_OK(iree_hal_fence_wait(completion_fence.get(),
+                                          iree_infinite_timeout()));
+      } else {
+        IREE_CHECK_OK(iree_vm_invoke(context, call.function,
+                                     IREE_VM_INVOCATION_FLAG_NONE,
+                                     /*policy=*/nullptr, call.inputs.get(),
+                                     outputs.get(), host_allocator));
+      }
+      call_latencies_ns.push_back((double)(iree_time_now() - start_ns));
+      IREE_CHECK_OK(iree_vm_list_resize(outputs.get(), 0));
+    }
+    IREE_TRACE_ZONE_END(z1);
+    if (device) {
+      state.PauseTiming();
+      IREE_CHECK_OK(iree_hal_device_profiling_flush(device));
+      state.ResumeTiming();
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  // Per-call latency percentiles across every call of every replay pass.
+  if (!call_latencies_ns.empty()) {
+    std::sort(call_latencies_ns.begin(), call_latencies_ns.end());
+    auto percentile = [&](double p) {
+      size_t index =
+          (size_t)(p * (double)(call_latencies_ns.size() - 1) + 0.5);
+      return call_latencies_ns[index];
+    };
+    state.counters["p50_call_ns"] = benchmark::Counter(percentile(0.50));
+    state.counters["p90_call_ns"] = benchmark::Counter(percentile(0.90));
+    state.counters["p99_call_ns"] = benchmark::Counter(percentile(0.99));
+    state.counters["max_call_ns"] = benchmark::Counter(call_latencies_ns.back());
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+}
+
+void RegisterTraceReplayBenchmark(const std::string& trace_path,
+                                  iree_hal_device_t* device,
+                                  iree_vm_context_t* context,
+                                  const std::vector<ReplayCall>* calls) {
+  auto benchmark_name = "BM_replay[" + trace_path + "]";
+  bool pacing = FLAG_trace_pacing;
+  benchmark::RegisterBenchmark(benchmark_name.c_str(),
+                               [=](benchmark::State& state) -> void {
+                                 BenchmarkTraceReplay(benchmark_name, pacing,
+                                                      device, context, calls,
+                                                      state);
+                               })
+      // By default only the main thread is included in CPU time. Include all
+      // the threads instead.
+      ->MeasureProcessCPUTime()
+      // To make single and multi-threaded benchmarks more comparable, use the
+      // wall time to determine how many iterations to run. See
+      // https://github.com/google/benchmark#cpu-timers,
+      ->UseRealTime()
+      ->Unit(FLAG_time_unit.first ? FLAG_time_unit.second
+                                  : benchmark::kMillisecond);
+}
+
 static void BenchmarkDispatchFunction(const std::string& benchmark_name,
                                       iree_vm_context_t* context,
                                       iree_vm_function_t function,
@@ -434,6 +574,7 @@ class IREEBenchmark {
     IREE_TRACE_SCOPE_NAMED("IREEBenchmark::dtor");
 
     // Order matters. Tear down modules first to release resources.
+    replay_calls_.clear();
     inputs_.reset();
     context_.reset();
     iree_tooling_module_list_reset(&module_list_);
@@ -458,7 +599,9 @@ class IREEBenchmark {
     }
 
     auto function_name = std::string(FLAG_function);
-    if (!function_name.empty()) {
+    if (strlen(FLAG_trace_file) != 0) {
+      IREE_RETURN_IF_ERROR(RegisterTraceReplay());
+    } else if (!function_name.empty()) {
       IREE_RETURN_IF_ERROR(RegisterSpecificFunction(function_name));
     } else {
       IREE_RETURN_IF_ERROR(RegisterAllExportedFunctions());
@@ -523,6 +666,118 @@ class IREEBenchmark {
     return iree_ok_status();
   }
 
+  iree_status_t RegisterTraceReplay() {
+    IREE_TRACE_SCOPE_NAMED("IREEBenchmark::RegisterTraceReplay");
+
+    iree_file_contents_t* file_contents = NULL;
+    IREE_RETURN_IF_ERROR(
+        iree_file_read_contents(FLAG_trace_file, IREE_FILE_READ_FLAG_PRELOAD,
+                                iree_allocator_system(), &file_contents));
+
+    // First pass: gather the raw call/input directives so that malformed
+    // traces fail before any expensive input parsing happens.
+    struct PendingCall {
+      std::string function_name;
+      int64_t delay_ns = 0;
+      std::vector<std::string> inputs;
+    };
+    std::vector<PendingCall> pending_calls;
+    iree_status_t status = iree_ok_status();
+    iree_string_view_t remaining = iree_make_string_view(
+        (const char*)file_contents->const_buffer.data,
+        file_contents->const_buffer.data_length);
+    while (iree_status_is_ok(status) && remaining.size > 0) {
+      iree_string_view_t line = iree_string_view_empty();
+      iree_string_view_split(remaining, '\n', &line, &remaining);
+      line = iree_string_view_trim(line);
+      if (line.size == 0 || iree_string_view_starts_with(line, IREE_SV("#"))) {
+        continue;
+      }
+      iree_string_view_t directive = iree_string_view_empty();
+      iree_string_view_t rest = iree_string_view_empty();
+      iree_string_view_split(line, ' ', &directive, &rest);
+      rest = iree_string_view_trim(rest);
+      if (iree_string_view_equal(directive, IREE_SV("call"))) {
+        iree_string_view_t name = iree_string_view_empty();
+        iree_string_view_t params = iree_string_view_empty();
+        iree_string_view_split(rest, ' ', &name, &params);
+        PendingCall pending_call;
+        pending_call.function_name.assign(name.data, name.size);
+        params = iree_string_view_trim(params);
+        if (iree_string_view_consume_prefix(&params, IREE_SV("delay_ns="))) {
+          if (!iree_string_view_atoi_int64(params, &pending_call.delay_ns)) {
+            status = iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                                      "invalid trace delay_ns value '%.*s'",
+                                      (int)params.size, params.data);
+            break;
+          }
+        }
+        pending_calls.push_back(std::move(pending_call));
+      } else if (iree_string_view_equal(directive, IREE_SV("input"))) {
+        if (pending_calls.empty()) {
+          status = iree_make_status(
+              IREE_STATUS_INVALID_ARGUMENT,
+              "trace input directive found before any call directive");
+          break;
+        }
+        pending_calls.back().inputs.emplace_back(rest.data, rest.size);
+      } else {
+        status = iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                                  "unrecognized trace directive '%.*s'",
+                                  (int)directive.size, directive.data);
+        break;
+      }
+    }
+    iree_file_contents_free(file_contents);
+    IREE_RETURN_IF_ERROR(status);
+    if (pending_calls.empty()) {
+      return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                              "trace file '%s' contains no calls",
+                              FLAG_trace_file);
+    }
+
+    // Second pass: resolve functions and parse the recorded inputs up front
+    // so that the replay loop measures invocation only.
+    iree_vm_module_t* main_module =
+        iree_tooling_module_list_back(&module_list_);
+    for (auto& pending_call : pending_calls) {
+      ReplayCall call;
+      call.delay_ns = pending_call.delay_ns;
+      IREE_RETURN_IF_ERROR(iree_vm_module_lookup_function_by_name(
+          main_module, IREE_VM_FUNCTION_LINKAGE_EXPORT,
+          iree_string_view_t{
+              pending_call.function_name.data(),
+              (iree_host_size_t)pending_call.function_name.size()},
+          &call.function));
+      iree_vm_function_signature_t signature =
+          iree_vm_function_signature(&call.function);
+      iree_string_view_t arguments_cconv, results_cconv;
+      IREE_RETURN_IF_ERROR(iree_vm_function_call_get_cconv_fragments(
+          &signature, &arguments_cconv, &results_cconv));
+      call.async = iree_string_view_equal(
+          iree_vm_function_lookup_attr_by_name(&call.function,
+                                               IREE_SV("iree.abi.model")),
+          IREE_SV("coarse-fences"));
+      std::vector<iree_string_view_t> input_views;
+      input_views.reserve(pending_call.inputs.size());
+      for (const auto& input : pending_call.inputs) {
+        input_views.push_back(
+            iree_make_string_view(input.data(), input.size()));
+      }
+      const iree_flag_string_list_t input_list = {
+          input_views.size(),
+          input_views.empty() ? nullptr : input_views.data()};
+      IREE_RETURN_IF_ERROR(iree_tooling_parse_variants(
+          arguments_cconv, input_list, device_.get(), device_allocator_.get(),
+          iree_vm_instance_allocator(instance_.get()), &call.inputs));
+      replay_calls_.push_back(std::move(call));
+    }
+
+    iree::RegisterTraceReplayBenchmark(FLAG_trace_file, device_.get(),
+                                       context_.get(), &replay_calls_);
+    return iree_ok_status();
+  }
+
   iree_status_t RegisterAllExportedFunctions() {
     IREE_TRACE_SCOPE_NAMED("IREEBenchmark::RegisterAllExportedFunctions");
     iree_vm_module_t* main_module =
@@ -600,6 +855,7 @@ class IREEBenchmark {
   iree::vm::ref<iree_hal_allocator_t> device_allocator_;
   iree_tooling_module_list_t module_list_;
   iree::vm::ref<iree_vm_list_t> inputs_;
+  std::vector<ReplayCall> replay_calls_;
 };
 }  // namespace
 }  // namespace iree
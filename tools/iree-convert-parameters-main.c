@@ -196,6 +196,146 @@ static iree_status_t iree_tooling_open_output_parameter_file(
   return status;
 }
 
+//===----------------------------------------------------------------------===//
+// Sharding
+//===----------------------------------------------------------------------===//
+
+IREE_FLAG(int32_t, shards, 0,
+          "Splits the output into the given number of archive shards with\n"
+          "parameters balanced by total data size. Shards are written to\n"
+          "`<output>.shard-N.irpa` and can be loaded together by passing all\n"
+          "shards as `--parameters=` flags; each shard gets its own file\n"
+          "handle so loads proceed concurrently.");
+IREE_FLAG(int64_t, shard_size, 0,
+          "Splits the output into as many shards as needed to keep each under\n"
+          "the given byte size. Ignored when --shards= is set.");
+
+// Returns the total byte size of data stored for |entry| in an archive.
+// Splat entries are encoded entirely in the index and take no storage.
+static uint64_t iree_tooling_parameter_storage_size(
+    const iree_io_parameter_index_entry_t* entry) {
+  return entry->type == IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_SPLAT
+             ? 0
+             : entry->length;
+}
+
+// Returns the shard count requested by flags for an index with |total_size|
+// bytes of parameter data or 1 when sharding is disabled.
+static iree_host_size_t iree_tooling_calculate_shard_count(
+    uint64_t total_size) {
+  if (FLAG_shards > 1) return (iree_host_size_t)FLAG_shards;
+  if (FLAG_shard_size > 0) {
+    return (iree_host_size_t)((total_size + FLAG_shard_size - 1) /
+                              FLAG_shard_size);
+  }
+  return 1;
+}
+
+// Partitions the entries of |source_index| across |shard_count| new indices,
+// assigning each entry to the currently smallest shard so total data size
+// stays balanced. Each of |shard_indices| is retained on return.
+static iree_status_t iree_tooling_partition_parameter_index(
+    iree_io_parameter_index_t* source_index, iree_host_size_t shard_count,
+    iree_io_parameter_index_t** shard_indices,
+    iree_allocator_t host_allocator) {
+  uint64_t* shard_sizes = NULL;
+  IREE_RETURN_IF_ERROR(iree_allocator_malloc(
+      host_allocator, shard_count * sizeof(*shard_sizes),
+      (void**)&shard_sizes));
+  iree_status_t status = iree_ok_status();
+  for (iree_host_size_t i = 0; i < shard_count && iree_status_is_ok(status);
+       ++i) {
+    status = iree_io_parameter_index_create(host_allocator, &shard_indices[i]);
+  }
+  for (iree_host_size_t i = 0;
+       i < iree_io_parameter_index_count(source_index) &&
+       iree_status_is_ok(status);
+       ++i) {
+    const iree_io_parameter_index_entry_t* entry = NULL;
+    status = iree_io_parameter_index_get(source_index, i, &entry);
+    if (!iree_status_is_ok(status)) break;
+    iree_host_size_t target_shard = 0;
+    for (iree_host_size_t j = 1; j < shard_count; ++j) {
+      if (shard_sizes[j] < shard_sizes[target_shard]) target_shard = j;
+    }
+    status = iree_io_parameter_index_add(shard_indices[target_shard], entry);
+    shard_sizes[target_shard] += iree_tooling_parameter_storage_size(entry);
+  }
+  iree_allocator_free(host_allocator, shard_sizes);
+  return status;
+}
+
+// Builds the path for shard |shard_index| as `<output>.shard-N.irpa` with any
+// trailing `.irpa` extension on |base_path| stripped first. The returned path
+// must be freed with |host_allocator|.
+static iree_status_t iree_tooling_build_shard_path(
+    const char* base_path, iree_host_size_t shard_index,
+    iree_allocator_t host_allocator, char** out_path) {
+  iree_string_view_t base = iree_make_cstring_view(base_path);
+  iree_string_view_t irpa_suffix = iree_make_cstring_view(".irpa");
+  if (iree_string_view_ends_with(base, irpa_suffix)) {
+    base = iree_string_view_substr(base, 0, base.size - irpa_suffix.size);
+  }
+  int path_length = snprintf(NULL, 0, "%.*s.shard-%" PRIhsz ".irpa",
+                             (int)base.size, base.data, shard_index);
+  char* path = NULL;
+  IREE_RETURN_IF_ERROR(
+      iree_allocator_malloc(host_allocator, path_length + 1, (void**)&path));
+  snprintf(path, path_length + 1, "%.*s.shard-%" PRIhsz ".irpa",
+           (int)base.size, base.data, shard_index);
+  *out_path = path;
+  return iree_ok_status();
+}
+
+// Writes one archive per shard of |source_index|, each containing a balanced
+// partition of the parameters. Loading all shards together reconstructs the
+// full index while giving each shard an independent file handle.
+static iree_status_t iree_tooling_write_sharded_parameter_archives(
+    iree_io_parameter_index_t* source_index, iree_host_size_t shard_count,
+    iree_allocator_t host_allocator) {
+  iree_io_parameter_index_t** shard_indices = NULL;
+  IREE_RETURN_IF_ERROR(iree_allocator_malloc(
+      host_allocator, shard_count * sizeof(*shard_indices),
+      (void**)&shard_indices));
+  iree_status_t status = iree_tooling_partition_parameter_index(
+      source_index, shard_count, shard_indices, host_allocator);
+  for (iree_host_size_t i = 0; i < shard_count && iree_status_is_ok(status);
+       ++i) {
+    char* shard_path = NULL;
+    status = iree_tooling_build_shard_path(FLAG_output, i, host_allocator,
+                                           &shard_path);
+    if (!iree_status_is_ok(status)) break;
+    iree_io_parameter_index_t* built_index = NULL;
+    status = iree_io_parameter_index_create(host_allocator, &built_index);
+    if (iree_status_is_ok(status)) {
+      iree_tooling_open_params_t open_params = {
+          .host_allocator = host_allocator,
+          .path = shard_path,
+      };
+      iree_io_parameter_archive_file_open_callback_t open_callback = {
+          .fn = iree_tooling_open_output_parameter_file,
+          .user_data = &open_params,
+      };
+      status = iree_io_build_parameter_archive(
+          shard_indices[i], built_index, open_callback,
+          /*target_file_offset=*/0, host_allocator);
+    }
+    if (iree_status_is_ok(status) && !FLAG_quiet) {
+      fprintf(stdout, "Shard %" PRIhsz ": %s\n", i, shard_path);
+      status = iree_io_parameter_index_fprint(stdout, iree_string_view_empty(),
+                                              built_index);
+    }
+    iree_io_parameter_index_release(built_index);
+    iree_allocator_free(host_allocator, shard_path);
+  }
+  for (iree_host_size_t i = 0; i < shard_count; ++i) {
+    iree_io_parameter_index_release(shard_indices[i]);
+  }
+  iree_allocator_free(host_allocator, shard_indices);
+  return status;
+}
+
+
 int main(int argc, char** argv) {
   IREE_TRACE_APP_ENTER();
   IREE_TRACE_ZONE_BEGIN(z0);
@@ -231,6 +371,14 @@ int main(int argc, char** argv) {
       "    --parameters=input.irpa \\\n"
       "    --strip \\\n"
       "    --splat=special_param=f32=1.0 \\\n"
+      "    --output=output.irpa\n"
+      "\n"
+      "Example sharding a large model into 8 size-balanced archives\n"
+      "(output.shard-0.irpa ... output.shard-7.irpa) that can be loaded\n"
+      "concurrently by passing all of them as --parameters= flags:\n"
+      "  iree-convert-parameters \\\n"
+      "    --parameters=input.safetensors \\\n"
+      "    --shards=8 \\\n"
       "    --output=output.irpa\n");
   iree_flags_parse_checked(IREE_FLAGS_PARSE_MODE_DEFAULT, &argc, &argv);
 
@@ -251,34 +399,62 @@ int main(int argc, char** argv) {
   }
   iree_io_scope_map_deinitialize(&scope_map);
 
-  iree_io_parameter_index_t* built_index = NULL;
+  // Decide on the shard count based on flags and total parameter data size.
+  iree_host_size_t shard_count = 1;
   if (iree_status_is_ok(status)) {
-    status = iree_io_parameter_index_create(host_allocator, &built_index);
+    uint64_t total_size = 0;
+    for (iree_host_size_t i = 0;
+         i < iree_io_parameter_index_count(new_index) &&
+         iree_status_is_ok(status);
+         ++i) {
+      const iree_io_parameter_index_entry_t* entry = NULL;
+      status = iree_io_parameter_index_get(new_index, i, &entry);
+      if (iree_status_is_ok(status)) {
+        total_size += iree_tooling_parameter_storage_size(entry);
+      }
+    }
+    if (iree_status_is_ok(status)) {
+      shard_count = iree_tooling_calculate_shard_count(total_size);
+    }
   }
 
-  // Write out the new archive.
-  if (iree_status_is_ok(status)) {
-    iree_tooling_open_params_t open_params = {
-        .host_allocator = host_allocator,
-        .path = FLAG_output,
-    };
-    iree_io_parameter_archive_file_open_callback_t open_callback = {
-        .fn = iree_tooling_open_output_parameter_file,
-        .user_data = &open_params,
-    };
-    status = iree_io_build_parameter_archive(
-        new_index, built_index, open_callback,
-        /*target_file_offset=*/0, host_allocator);
-  }
+  if (shard_count > 1) {
+    // Write one archive per shard.
+    if (iree_status_is_ok(status)) {
+      status = iree_tooling_write_sharded_parameter_archives(
+          new_index, shard_count, host_allocator);
+    }
+    iree_io_parameter_index_release(new_index);
+  } else {
+    iree_io_parameter_index_t* built_index = NULL;
+    if (iree_status_is_ok(status)) {
+      status = iree_io_parameter_index_create(host_allocator, &built_index);
+    }
 
-  // Dump the new index ala iree-dump-parameters to show the final file.
-  if (iree_status_is_ok(status) && !FLAG_quiet) {
-    status = iree_io_parameter_index_fprint(stdout, iree_string_view_empty(),
-                                            built_index);
-  }
+    // Write out the new archive.
+    if (iree_status_is_ok(status)) {
+      iree_tooling_open_params_t open_params = {
+          .host_allocator = host_allocator,
+          .path = FLAG_output,
+      };
+      iree_io_parameter_archive_file_open_callback_t open_callback = {
+          .fn = iree_tooling_open_output_parameter_file,
+          .user_data = &open_params,
+      };
+      status = iree_io_build_parameter_archive(
+          new_index, built_index, open_callback,
+          /*target_file_offset=*/0, host_allocator);
+    }
 
-  iree_io_parameter_index_release(built_index);
-  iree_io_parameter_index_release(new_index);
+    // Dump the new index ala iree-dump-parameters to show the final file.
+    if (iree_status_is_ok(status) && !FLAG_quiet) {
+      status = iree_io_parameter_index_fprint(stdout, iree_string_view_empty(),
+                                              built_index);
+    }
+
+    iree_io_parameter_index_release(built_index);
+    iree_io_parameter_index_release(new_index);
+  }
 
   fflush(stdout);
   if (!iree_status_is_ok(status)) {
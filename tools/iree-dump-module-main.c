@@ -11,6 +11,11 @@
 //   --output=metadata: module metadata and size breakdown.
 //   --output=flatbuffer-binary: module flatbuffer in binary format.
 //   --output=flatbuffer-json: module flatbuffer in JSON format.
+//   --output=ndjson: newline-delimited JSON records, one per entity,
+//                    filterable with --section=.
+//
+// The module file is mapped into memory by default so only the inspected
+// sections are paged in; pass --mmap=false to preload the whole file.
 
 #include <ctype.h>
 #include <stdio.h>
@@ -538,6 +543,272 @@ static iree_status_t iree_tooling_dump_module_flatbuffer_json(
   return iree_ok_status();
 }
 
+//===----------------------------------------------------------------------===//
+// --output=ndjson
+//===----------------------------------------------------------------------===//
+
+IREE_FLAG(
+    string, section, "",
+    "Comma-separated list of sections to emit in ndjson output mode.\n"
+    "Available: module, dependencies, imports, exports, rodata-summary,\n"
+    "rwdata-summary, bytecode-summary. An empty value emits all sections.");
+
+// Returns true if |name| is listed in --section= (or no filter is set).
+static bool iree_tooling_section_enabled(const char* name) {
+  iree_string_view_t remaining = iree_make_cstring_view(FLAG_section);
+  if (iree_string_view_is_empty(remaining)) return true;
+  iree_string_view_t name_view = iree_make_cstring_view(name);
+  while (!iree_string_view_is_empty(remaining)) {
+    iree_string_view_t entry = iree_string_view_empty();
+    iree_string_view_split(remaining, ',', &entry, &remaining);
+    if (iree_string_view_equal(iree_string_view_trim(entry), name_view)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void iree_tooling_print_json_string(const char* value) {
+  fputc('"', stdout);
+  for (const char* p = value ? value : ""; *p; ++p) {
+    char c = *p;
+    switch (c) {
+      case '"':
+        fputs("\\\"", stdout);
+        break;
+      case '\\':
+        fputs("\\\\", stdout);
+        break;
+      case '\n':
+        fputs("\\n", stdout);
+        break;
+      case '\r':
+        fputs("\\r", stdout);
+        break;
+      case '\t':
+        fputs("\\t", stdout);
+        break;
+      default:
+        if ((unsigned char)c < 0x20) {
+          fprintf(stdout, "\\u%04x", c);
+        } else {
+          fputc(c, stdout);
+        }
+        break;
+    }
+  }
+  fputc('"', stdout);
+}
+
+static void iree_tooling_print_json_attr_defs(iree_vm_AttrDef_vec_t attr_defs) {
+  fputc('{', stdout);
+  for (size_t i = 0; i < iree_vm_AttrDef_vec_len(attr_defs); ++i) {
+    iree_vm_AttrDef_table_t attr_def = iree_vm_AttrDef_vec_at(attr_defs, i);
+    if (i > 0) fputc(',', stdout);
+    iree_tooling_print_json_string(iree_vm_AttrDef_key(attr_def));
+    fputc(':', stdout);
+    iree_tooling_print_json_string(iree_vm_AttrDef_value(attr_def));
+  }
+  fputc('}', stdout);
+}
+
+static void iree_tooling_dump_ndjson_module(
+    iree_vm_BytecodeModuleDef_table_t module_def) {
+  fprintf(stdout, "{\"section\":\"module\",\"name\":");
+  iree_tooling_print_json_string(iree_vm_BytecodeModuleDef_name(module_def));
+  fprintf(stdout, ",\"version\":%u",
+          iree_vm_BytecodeModuleDef_version(module_def));
+  if (iree_vm_BytecodeModuleDef_requirements_is_present(module_def)) {
+    fprintf(stdout, ",\"requirements\":%u",
+            (unsigned)iree_vm_BytecodeModuleDef_requirements(module_def));
+  }
+  if (iree_vm_BytecodeModuleDef_attrs_is_present(module_def)) {
+    fprintf(stdout, ",\"attrs\":");
+    iree_tooling_print_json_attr_defs(
+        iree_vm_BytecodeModuleDef_attrs(module_def));
+  }
+  fprintf(stdout, "}\n");
+}
+
+static void iree_tooling_dump_ndjson_dependencies(
+    iree_vm_BytecodeModuleDef_table_t module_def) {
+  if (!iree_vm_BytecodeModuleDef_dependencies_is_present(module_def)) return;
+  iree_vm_ModuleDependencyDef_vec_t dependency_defs =
+      iree_vm_BytecodeModuleDef_dependencies(module_def);
+  for (size_t i = 0; i < iree_vm_ModuleDependencyDef_vec_len(dependency_defs);
+       ++i) {
+    iree_vm_ModuleDependencyDef_table_t dependency_def =
+        iree_vm_ModuleDependencyDef_vec_at(dependency_defs, i);
+    fprintf(stdout, "{\"section\":\"dependencies\",\"name\":");
+    iree_tooling_print_json_string(
+        iree_vm_ModuleDependencyDef_name(dependency_def));
+    fprintf(stdout, ",\"minimum_version\":%u,\"optional\":%s}\n",
+            iree_vm_ModuleDependencyDef_minimum_version(dependency_def),
+            (iree_vm_ModuleDependencyDef_flags(dependency_def) &
+             iree_vm_ModuleDependencyFlagBits_OPTIONAL)
+                ? "true"
+                : "false");
+  }
+}
+
+static void iree_tooling_dump_ndjson_imports(
+    iree_vm_BytecodeModuleDef_table_t module_def) {
+  if (!iree_vm_BytecodeModuleDef_imported_functions_is_present(module_def)) {
+    return;
+  }
+  iree_vm_ImportFunctionDef_vec_t function_defs =
+      iree_vm_BytecodeModuleDef_imported_functions(module_def);
+  for (size_t i = 0; i < iree_vm_ImportFunctionDef_vec_len(function_defs);
+       ++i) {
+    iree_vm_ImportFunctionDef_table_t function_def =
+        iree_vm_ImportFunctionDef_vec_at(function_defs, i);
+    fprintf(stdout, "{\"section\":\"imports\",\"ordinal\":%zu,\"name\":", i);
+    iree_tooling_print_json_string(
+        iree_vm_ImportFunctionDef_full_name(function_def));
+    fprintf(stdout, ",\"optional\":%s",
+            (iree_vm_ImportFunctionDef_flags(function_def) &
+             iree_vm_ImportFlagBits_OPTIONAL)
+                ? "true"
+                : "false");
+    iree_vm_FunctionSignatureDef_table_t signature_def =
+        iree_vm_ImportFunctionDef_signature(function_def);
+    if (iree_vm_FunctionSignatureDef_calling_convention_is_present(
+            signature_def)) {
+      fprintf(stdout, ",\"cconv\":");
+      iree_tooling_print_json_string(
+          iree_vm_FunctionSignatureDef_calling_convention(signature_def));
+    }
+    fprintf(stdout, "}\n");
+  }
+}
+
+static void iree_tooling_dump_ndjson_exports(
+    iree_vm_BytecodeModuleDef_table_t module_def) {
+  if (!iree_vm_BytecodeModuleDef_exported_functions_is_present(module_def)) {
+    return;
+  }
+  iree_vm_ExportFunctionDef_vec_t function_defs =
+      iree_vm_BytecodeModuleDef_exported_functions(module_def);
+  iree_vm_FunctionSignatureDef_vec_t signature_defs =
+      iree_vm_BytecodeModuleDef_function_signatures(module_def);
+  for (size_t i = 0; i < iree_vm_ExportFunctionDef_vec_len(function_defs);
+       ++i) {
+    iree_vm_ExportFunctionDef_table_t function_def =
+        iree_vm_ExportFunctionDef_vec_at(function_defs, i);
+    fprintf(stdout, "{\"section\":\"exports\",\"ordinal\":%zu,\"name\":", i);
+    iree_tooling_print_json_string(
+        iree_vm_ExportFunctionDef_local_name(function_def));
+    fprintf(stdout, ",\"internal_ordinal\":%u",
+            iree_vm_ExportFunctionDef_internal_ordinal(function_def));
+    iree_vm_FunctionSignatureDef_table_t signature_def =
+        iree_vm_FunctionSignatureDef_vec_at(
+            signature_defs,
+            iree_vm_ExportFunctionDef_internal_ordinal(function_def));
+    if (iree_vm_FunctionSignatureDef_calling_convention_is_present(
+            signature_def)) {
+      fprintf(stdout, ",\"cconv\":");
+      iree_tooling_print_json_string(
+          iree_vm_FunctionSignatureDef_calling_convention(signature_def));
+    }
+    fprintf(stdout, "}\n");
+  }
+}
+
+static void iree_tooling_dump_ndjson_rodata_summary(
+    iree_vm_BytecodeModuleDef_table_t module_def) {
+  if (!iree_vm_BytecodeModuleDef_rodata_segments_is_present(module_def)) {
+    return;
+  }
+  iree_vm_RodataSegmentDef_vec_t segment_defs =
+      iree_vm_BytecodeModuleDef_rodata_segments(module_def);
+  for (size_t i = 0; i < iree_vm_RodataSegmentDef_vec_len(segment_defs); ++i) {
+    iree_vm_RodataSegmentDef_table_t segment_def =
+        iree_vm_RodataSegmentDef_vec_at(segment_defs, i);
+    if (iree_vm_RodataSegmentDef_embedded_data_is_present(segment_def)) {
+      // NOTE: only the vector length is touched; the contents stay unmapped.
+      fprintf(stdout,
+              "{\"section\":\"rodata-summary\",\"index\":%zu,"
+              "\"storage\":\"embedded\",\"bytes\":%zu}\n",
+              i,
+              flatbuffers_uint8_vec_len(
+                  iree_vm_RodataSegmentDef_embedded_data(segment_def)));
+    } else {
+      fprintf(stdout,
+              "{\"section\":\"rodata-summary\",\"index\":%zu,"
+              "\"storage\":\"external\",\"bytes\":%" PRIu64
+              ",\"offset\":%" PRIu64 "}\n",
+              i, iree_vm_RodataSegmentDef_external_data_length(segment_def),
+              iree_vm_RodataSegmentDef_external_data_offset(segment_def));
+    }
+  }
+}
+
+static void iree_tooling_dump_ndjson_rwdata_summary(
+    iree_vm_BytecodeModuleDef_table_t module_def) {
+  if (!iree_vm_BytecodeModuleDef_rwdata_segments_is_present(module_def)) {
+    return;
+  }
+  iree_vm_RwdataSegmentDef_vec_t segment_defs =
+      iree_vm_BytecodeModuleDef_rwdata_segments(module_def);
+  for (size_t i = 0; i < iree_vm_RwdataSegmentDef_vec_len(segment_defs); ++i) {
+    fprintf(stdout,
+            "{\"section\":\"rwdata-summary\",\"index\":%zu,\"bytes\":%d}\n", i,
+            iree_vm_RwdataSegmentDef_byte_size(
+                iree_vm_RwdataSegmentDef_vec_at(segment_defs, i)));
+  }
+}
+
+static void iree_tooling_dump_ndjson_bytecode_summary(
+    iree_vm_BytecodeModuleDef_table_t module_def) {
+  size_t bytecode_length = 0;
+  if (iree_vm_BytecodeModuleDef_bytecode_data_is_present(module_def)) {
+    bytecode_length = flatbuffers_uint8_vec_len(
+        iree_vm_BytecodeModuleDef_bytecode_data(module_def));
+  }
+  size_t function_count = 0;
+  if (iree_vm_BytecodeModuleDef_function_descriptors_is_present(module_def)) {
+    function_count = iree_vm_FunctionDescriptor_vec_len(
+        iree_vm_BytecodeModuleDef_function_descriptors(module_def));
+  }
+  fprintf(stdout,
+          "{\"section\":\"bytecode-summary\",\"version\":%u,\"bytes\":%zu,"
+          "\"functions\":%zu}\n",
+          iree_vm_BytecodeModuleDef_version(module_def), bytecode_length,
+          function_count);
+}
+
+// Emits newline-delimited JSON records for the requested sections. Each
+// section only touches the FlatBuffer fields it reports so that when the
+// module is memory-mapped the untouched pages (bytecode, embedded rodata)
+// never become resident.
+static iree_status_t iree_tooling_dump_module_ndjson(
+    iree_const_byte_span_t flatbuffer_contents) {
+  iree_vm_BytecodeModuleDef_table_t module_def =
+      iree_vm_BytecodeModuleDef_as_root(flatbuffer_contents.data);
+  if (iree_tooling_section_enabled("module")) {
+    iree_tooling_dump_ndjson_module(module_def);
+  }
+  if (iree_tooling_section_enabled("dependencies")) {
+    iree_tooling_dump_ndjson_dependencies(module_def);
+  }
+  if (iree_tooling_section_enabled("imports")) {
+    iree_tooling_dump_ndjson_imports(module_def);
+  }
+  if (iree_tooling_section_enabled("exports")) {
+    iree_tooling_dump_ndjson_exports(module_def);
+  }
+  if (iree_tooling_section_enabled("rodata-summary")) {
+    iree_tooling_dump_ndjson_rodata_summary(module_def);
+  }
+  if (iree_tooling_section_enabled("rwdata-summary")) {
+    iree_tooling_dump_ndjson_rwdata_summary(module_def);
+  }
+  if (iree_tooling_section_enabled("bytecode-summary")) {
+    iree_tooling_dump_ndjson_bytecode_summary(module_def);
+  }
+  return iree_ok_status();
+}
+
 //===----------------------------------------------------------------------===//
 // main
 //===----------------------------------------------------------------------===//
@@ -546,7 +817,13 @@ IREE_FLAG(string, output, "metadata",
           "Output mode:\n"
           "  'metadata': module metadata and size breakdown.\n"
           "  'flatbuffer-binary': module flatbuffer in binary format.\n"
-          "  'flatbuffer-json': module flatbuffer in JSON format.\n");
+          "  'flatbuffer-json': module flatbuffer in JSON format.\n"
+          "  'ndjson': newline-delimited JSON records (see --section=).\n");
+
+IREE_FLAG(bool, mmap, true,
+          "Maps the module file into memory instead of preloading it so only\n"
+          "the inspected sections are paged in. Falls back to preloading when\n"
+          "mapping is unavailable.");
 
 int main(int argc, char** argv) {
   IREE_TRACE_APP_ENTER();
@@ -567,8 +844,17 @@ int main(int argc, char** argv) {
   }
 
   iree_file_contents_t* file_contents = NULL;
-  iree_status_t status = iree_file_read_contents(
-      argv[1], IREE_FILE_READ_FLAG_DEFAULT, host_allocator, &file_contents);
+  iree_status_t status = iree_status_from_code(IREE_STATUS_UNAVAILABLE);
+  if (FLAG_mmap) {
+    status = iree_file_read_contents(
+        argv[1], IREE_FILE_READ_FLAG_MMAP | IREE_FILE_READ_FLAG_RANDOM_ACCESS,
+        host_allocator, &file_contents);
+  }
+  if (!iree_status_is_ok(status)) {
+    iree_status_ignore(status);
+    status = iree_file_read_contents(argv[1], IREE_FILE_READ_FLAG_PRELOAD,
+                                     host_allocator, &file_contents);
+  }
 
   iree_const_byte_span_t flatbuffer_contents = iree_const_byte_span_empty();
   iree_const_byte_span_t rodata_contents = iree_const_byte_span_empty();
@@ -597,6 +883,8 @@ int main(int argc, char** argv) {
       status = iree_tooling_dump_module_flatbuffer_binary(flatbuffer_contents);
     } else if (strcmp(FLAG_output, "flatbuffer-json") == 0) {
       status = iree_tooling_dump_module_flatbuffer_json(flatbuffer_contents);
+    } else if (strcmp(FLAG_output, "ndjson") == 0) {
+      status = iree_tooling_dump_module_ndjson(flatbuffer_contents);
     } else {
       status = iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
                                 "unrecognized --output= flag value '%s'",